@@ -0,0 +1,90 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Merge of the detections of overlapping image tiles through a spatial hash.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_TILE_MERGER_H
+#define MXBASE_TILE_MERGER_H
+
+#include <cstdint>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxBase/CV/Core/DataType.h"
+#include "MxBase/PostProcessBases/PostProcessDataType.h"
+
+namespace MxBase {
+enum TileMergePolicy {
+    TILE_MERGE_NMS_BY_AREA = 0,       // keep the largest box of a group, the same as NmsSortByArea
+    TILE_MERGE_MAX_SCORE = 1,         // keep the most confident box of a group, the same as NmsSort
+    TILE_MERGE_WEIGHTED_FUSION = 2    // replace a group by its confidence weighted mean box and its highest score
+};
+
+struct SDK_AVAILABLE_FOR_OUT TileMergeConfig {
+    TileMergePolicy policy = TILE_MERGE_NMS_BY_AREA;
+    float iouThresh = 0.45f;
+    IOUMethod iouMethod = IOUMethod::MIN;
+    // boxes of one tile are never merged, and only pairs with a box reaching out of its tile area are compared
+    bool crossTileOnly = false;
+};
+
+class SDK_AVAILABLE_FOR_OUT TileMerger {
+public:
+    /**
+     * @description: Greedy grouping of the boxes of each class in policy order, a box joining the group of the first
+     * kept box it overlaps by more than iouThresh. Only boxes sharing a cell of a uniform grid are compared, so the
+     * cost grows with the number of overlapping boxes instead of the square of the box number. The result equals
+     * NmsSortByArea or NmsSort for the matching policy, up to the order of boxes with equal keys.
+     * The buffers are kept by the merger and reused by the next call.
+     * @param boxes: detections in image coordinates.
+     * @param tileIds: tile of every box, may be empty when crossTileOnly is false.
+     * @param tileAreas: area each tile is responsible for, indexed by tile id.
+     * @param merged: the kept or fused boxes, class by class in ascending class id.
+     */
+    APP_ERROR Merge(const std::vector<DetectBox>& boxes, const std::vector<uint32_t>& tileIds,
+                    const std::vector<CropRoiBox>& tileAreas, const TileMergeConfig& config,
+                    std::vector<DetectBox>& merged);
+
+private:
+    void SortBoxes(const std::vector<DetectBox>& boxes, TileMergePolicy policy);
+
+    void MarkBandBoxes(const std::vector<DetectBox>& boxes, const std::vector<uint32_t>& tileIds,
+                       const std::vector<CropRoiBox>& tileAreas);
+
+    void BuildGrid(const std::vector<DetectBox>& boxes);
+
+    void CellRange(const DetectBox& box, uint32_t& col0, uint32_t& row0, uint32_t& col1, uint32_t& row1) const;
+
+private:
+    std::vector<uint32_t> order_;
+    std::vector<uint32_t> rank_;
+    std::vector<uint8_t> inBand_;
+    std::vector<uint8_t> suppressed_;
+    std::vector<uint32_t> visitStamp_;
+    std::vector<uint32_t> cellOffsets_;
+    std::vector<uint32_t> cellBoxes_;
+    float originX_ = 0;
+    float originY_ = 0;
+    float cellSize_ = 1;
+    uint32_t gridWidth_ = 0;
+    uint32_t gridHeight_ = 0;
+};
+}
+#endif
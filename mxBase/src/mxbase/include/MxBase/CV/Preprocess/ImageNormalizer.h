@@ -0,0 +1,88 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Fused normalization of interleaved images into model inputs.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_IMAGE_NORMALIZER_H
+#define MXBASE_IMAGE_NORMALIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxBase/Tensor/TensorBase/TensorDataType.h"
+#include "MxBase/PostProcessBases/PostProcessDataType.h"
+
+namespace MxBase {
+/**
+ * Interleaved image in host memory, TENSOR_DTYPE_UINT8 or TENSOR_DTYPE_FLOAT32 with 1 to 4 channels. rowStride is
+ * the number of bytes between two rows, 0 for packed rows.
+ */
+struct SDK_AVAILABLE_FOR_OUT NormalizeImage {
+    const void* data = nullptr;
+    TensorDataType dataType = TENSOR_DTYPE_UINT8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channelNum = 3;
+    uint32_t rowStride = 0;
+};
+
+/**
+ * Output channel c is input channel channelOrder[c] times scale[c] plus bias[c]. An empty channelOrder keeps the
+ * order, an empty scale or bias is 1 or 0. INT8 and UINT8 outputs are rounded to nearest even and saturated as
+ * cv::Mat::convertTo, so a quantized input is written by folding the quantization scale and offset into scale and
+ * bias. FLOAT16 is rounded to nearest even.
+ */
+struct SDK_AVAILABLE_FOR_OUT NormalizeParam {
+    std::vector<uint32_t> channelOrder;
+    std::vector<float> scale;
+    std::vector<float> bias;
+    TensorArrangementType layout = TYPE_NHWC;
+    TensorDataType dataType = TENSOR_DTYPE_FLOAT32;
+};
+
+class SDK_AVAILABLE_FOR_OUT ImageNormalizer {
+public:
+    /**
+     * @description: Scale and bias of (x - mean) / std, per channel.
+     * @return: APP_ERR_COMM_INVALID_PARAM when the sizes differ or a std is 0.
+     */
+    static APP_ERROR MeanStdToScaleBias(const std::vector<double>& mean, const std::vector<double>& std,
+                                        std::vector<float>& scale, std::vector<float>& bias);
+
+    /**
+     * @description: Size in bytes of the output of Normalize, 0 when the output data type is not supported.
+     */
+    static size_t GetOutputSize(const NormalizeImage& src, const NormalizeParam& param);
+
+    /**
+     * @description: Channel reorder, scale and bias, layout change to TYPE_NCHW when asked and conversion to the
+     * output data type in one pass over the image. The rows are handled in chunks of pixels converted to planar
+     * floats in a small buffer, then stored into dst in the output layout and type.
+     * @param dst: at least GetOutputSize bytes.
+     * @param threadNum: number of row bands processed in parallel.
+     * @return: Error code.
+     */
+    static APP_ERROR Normalize(const NormalizeImage& src, const NormalizeParam& param, void* dst, size_t dstSize,
+                               uint32_t threadNum = 1);
+};
+}
+#endif
@@ -0,0 +1,123 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Letterbox resize of host images, resampled in place into the padded output.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_LETTERBOX_RESIZER_H
+#define MXBASE_LETTERBOX_RESIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxBase/Tensor/TensorBase/TensorDataType.h"
+
+namespace MxBase {
+enum class LetterboxSourceFormat {
+    PACKED_3 = 0,   // 3 interleaved channels, written in the same order
+    NV12,           // Y plane and interleaved UV plane, written as RGB or BGR
+    NV21,           // Y plane and interleaved VU plane, written as RGB or BGR
+};
+
+enum class LetterboxInterpolation {
+    NEAREST = 0,
+    BILINEAR,
+    AREA,
+};
+
+enum class LetterboxPadding {
+    NONE = 0,
+    RIGHT_DOWN,
+    AROUND,
+};
+
+/**
+ * Source image in host memory. rowStride is the number of bytes between two rows, 0 for packed rows, and is shared
+ * by the two planes of NV12 and NV21. TENSOR_DTYPE_FLOAT32 is only supported for PACKED_3.
+ */
+struct SDK_AVAILABLE_FOR_OUT LetterboxImage {
+    const void* data = nullptr;
+    const uint8_t* uvData = nullptr;
+    LetterboxSourceFormat format = LetterboxSourceFormat::PACKED_3;
+    TensorDataType dataType = TENSOR_DTYPE_UINT8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t rowStride = 0;
+};
+
+/**
+ * The source is resampled to resizeWidth x resizeHeight at (left, top) of a packed width x height output.
+ */
+struct SDK_AVAILABLE_FOR_OUT LetterboxGeometry {
+    uint32_t resizeWidth = 0;
+    uint32_t resizeHeight = 0;
+    uint32_t left = 0;
+    uint32_t top = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * padValue is in the output channel order and is rounded and saturated for TENSOR_DTYPE_UINT8 outputs, as the
+ * cv::Scalar of cv::copyMakeBorder. bgrOutput selects the channel order written for NV12 and NV21 sources.
+ */
+struct SDK_AVAILABLE_FOR_OUT LetterboxParam {
+    LetterboxGeometry geometry;
+    LetterboxInterpolation interpolation = LetterboxInterpolation::BILINEAR;
+    float padValue[3] = {0.f, 0.f, 0.f};
+    bool bgrOutput = false;
+};
+
+class SDK_AVAILABLE_FOR_OUT LetterboxResizer {
+public:
+    /**
+     * @description: Places a resizeWidth x resizeHeight image in a paddingWidth x paddingHeight output, at the top
+     * left corner for RIGHT_DOWN or centered with the odd pixel on the right and bottom for AROUND. NONE ignores the
+     * padding size and the output is the resized image.
+     * @return: APP_ERR_COMM_INVALID_PARAM when a size is 0 or the resized image is larger than the padding size.
+     */
+    static APP_ERROR MakeGeometry(uint32_t resizeWidth, uint32_t resizeHeight, uint32_t paddingWidth,
+                                  uint32_t paddingHeight, LetterboxPadding padding, LetterboxGeometry& geometry);
+
+    /**
+     * @description: Size in bytes of the packed 3 channel output, 0 when the data type is not supported.
+     */
+    static size_t GetOutputSize(TensorDataType dataType, const LetterboxGeometry& geometry);
+
+    /**
+     * @description: Resamples the source into the resized area of dst and fills the rest with padValue, so every
+     * output pixel is written once. The source rows are resampled horizontally once into fixed-point rows held by
+     * each band, NV12 and NV21 rows are converted as cv::cvtColor when they are loaded. The results are within 1 of
+     * cv::resize with INTER_NEAREST, INTER_LINEAR and INTER_AREA.
+     * @param dst: at least GetOutputSize bytes, of the source data type.
+     * @param threadNum: number of row bands processed in parallel.
+     * @return: Error code.
+     */
+    static APP_ERROR Resize(const LetterboxImage& src, const LetterboxParam& param, void* dst, size_t dstSize,
+                            uint32_t threadNum = 1);
+
+    /**
+     * @description: Fills the output outside of the resized area with padValue, for a resized area written by
+     * another resampler.
+     */
+    static APP_ERROR FillBorder(const LetterboxParam& param, TensorDataType dataType, void* dst, size_t dstSize);
+};
+}
+#endif
@@ -31,11 +31,26 @@
 
 namespace MxBase {
 const uint32_t LANDMARK_LEN = 10;
+const uint32_t AFFINE_MATRIX_LEN = 6;
 
 struct KeyPointInfo {
     float kPBefore[LANDMARK_LEN];
 };
 
+/**
+ * NV12 picture in host memory, of which only the rows [top, top + rows) of the luma plane are held, with the chroma
+ * rows they use. top is even.
+ */
+struct Nv12HostPlanes {
+    const uint8_t* yPlane = nullptr;    // luma row top
+    const uint8_t* uvPlane = nullptr;   // chroma row top / 2
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;
+    uint32_t top = 0;
+    uint32_t rows = 0;
+};
+
 class WarpAffine {
 public:
     // Constructor
@@ -43,32 +58,60 @@ public:
     // Destructor
     ~WarpAffine();
 
-    // Processing function of warp affine operation
+    /**
+     * Processing function of warp affine operation. All faces are aligned in one pass: only the source rows a face
+     * maps to are copied to the host and the aligned BGR pictures are computed from the NV12 planes directly. An
+     * output which already holds a device buffer of the BGR size is written in place, otherwise a buffer is
+     * allocated and destory is set.
+     */
     APP_ERROR Process(std::vector<MxBase::DvppDataInfo> &warpAffineDataInfoInputVec,
                       std::vector<DvppDataInfo> &warpAffineDataInfoOutputVec,
                       std::vector<KeyPointInfo> &keyPointInfoVec, int picHeight, int picWidth);
 
+    /**
+     * @description: Fused similarity warp of an NV12 picture into a packed BGR picture, the same as cv::cvtColor
+     * with COLOR_YUV2BGR_NV12 followed by cv::warpAffine with INTER_LINEAR and a zero border. Only the output
+     * pixels are computed, each is mapped back into the planes and blended from the BGR of its four neighbours with
+     * the fixed-point weights of OpenCV. Neighbours out of the held rows are taken as border.
+     * @param matrix: row major 2x3 transform from the source to the output, as given to cv::warpAffine
+     */
+    static APP_ERROR WarpNv12ToBgr(const Nv12HostPlanes &src, const double matrix[AFFINE_MATRIX_LEN], uint8_t *dst,
+                                   uint32_t dstWidth, uint32_t dstHeight);
+
+    /**
+     * @description: Rows of a source picture of srcHeight rows that the output pixels map to, with a margin for the
+     * interpolation. top is even, rows is 0 when the output maps out of the picture.
+     */
+    static void GetSourceRows(const double matrix[AFFINE_MATRIX_LEN], uint32_t srcHeight, uint32_t dstWidth,
+                              uint32_t dstHeight, uint32_t &top, uint32_t &rows);
+
 private:
-    // Perform warp affine operations
-    APP_ERROR ApplyWarpAffine(DvppDataInfo &warpAffineDataInfoInput,
-                              DvppDataInfo &warpAffineDataInfoOutput,
-                              KeyPointInfo &keyPointInfo);
+    struct FaceWarpTask {
+        double matrix[AFFINE_MATRIX_LEN];
+        Nv12HostPlanes planes;
+        size_t hostOffset;
+        size_t ySize;
+        size_t uvSize;
+        size_t uvOffset;
+    };
+    // Compute the transform and the source rows of a face
+    APP_ERROR PrepareFaceWarp(const DvppDataInfo &warpAffineDataInfoInput, KeyPointInfo &keyPointInfo,
+                              FaceWarpTask &task);
     // Get standard key points information
     void GetSrcLandmark(std::vector<cv::Point2f> &points);
-    // Relative transformation of key points coordinates, from 96*96 to 112*112
-    void GetDstLandmark(std::vector<cv::Point2f> &points, float kPBefore[]);
-    // Crop the input picture
-    APP_ERROR GetCropImage(DvppDataInfo &warpAffineDataInfoInput, cv::Mat &image);
-    // Calculate the transformation matrix and perform affine transformation
-    void CalWarpImage(const std::vector<cv::Point2f> &srcPoints,
-                      const std::vector<cv::Point2f> &dstPoints,
-                      cv::Mat &warpImage, cv::Mat &srcImageNv21);
+    // Relative transformation of key points coordinates, from 96*96 to the input picture
+    void GetDstLandmark(std::vector<cv::Point2f> &points, float kPBefore[], uint32_t width, uint32_t height);
+    // Copy the source rows of every face to the host
+    APP_ERROR CopySourceRows(const std::vector<DvppDataInfo> &warpAffineDataInfoInputVec,
+                             std::vector<FaceWarpTask> &tasks, size_t hostSize);
     // Save the aligned picture
-    APP_ERROR SetWarpImage(DvppDataInfo &warpAffineDataInfoOutput,
-                           const cv::Mat &imageWarp);
+    APP_ERROR SetWarpImage(DvppDataInfo &warpAffineDataInfoOutput, const uint8_t *imageWarp);
 private:
     int picWidth_ = 0;
     int picHeight_ = 0;
+    // host buffers reused by the faces of every call
+    std::vector<uint8_t> hostRows_;
+    std::vector<uint8_t> hostBgr_;
 };
 }
 #endif
@@ -58,6 +58,8 @@ public:
     APP_ERROR LoadLabels(const std::string &labelPath);
     // Get the class name by class id
     std::string GetClassName(const size_t classId);
+    // Get all the class names in class id order
+    const std::vector<std::string> &GetClassNames() const;
     // Get file value by key
     template<typename T> APP_ERROR GetFileValue(const std::string &key, T &value) const
     {
@@ -23,13 +23,16 @@
 #ifndef DEVICE_MANAGER_H
 #define DEVICE_MANAGER_H
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <mutex>
 #include <memory>
+#include <vector>
 #include "MxBase/ErrorCode/ErrorCode.h"
 namespace MxBase {
 const unsigned int DEFAULT_VALUE = 0;
+const uint32_t MAX_DEVICE_NUM = 64;
 struct DeviceContext {
     enum DeviceStatus {
         IDLE = 0,  // idle status
@@ -48,8 +51,14 @@ public:
     APP_ERROR GetDevicesCount(uint32_t& deviceCount);
     // get current running device
     APP_ERROR GetCurrentDevice(DeviceContext& device);
-    // set one device for running
+    // set one device for running, a thread already bound to the device by an earlier call returns at once
     APP_ERROR SetDevice(DeviceContext device);
+    // forget the device bound to the calling thread, for threads that also set the acl context by themselves
+    void InvalidateThreadBinding();
+    // cpus of the threads bound to the device afterwards, an empty list keeps the affinity of the threads
+    APP_ERROR SetDeviceAffinity(int32_t deviceId, const std::vector<uint32_t>& cpuIds);
+    // cpus of a numa node as listed by /sys/devices/system/node
+    static APP_ERROR GetNumaNodeCpus(uint32_t numaNode, std::vector<uint32_t>& cpuIds);
     // release all devices
     APP_ERROR DestroyDevices();
     bool IsInitDevices() const;
@@ -61,10 +70,16 @@ public:
     static std::string GetSocName();
 private:
     DeviceManager() = default;
+    APP_ERROR BindThread(int32_t deviceId);
+    void SetThreadAffinity(int32_t deviceId);
     std::mutex mtx_ = {};
-    std::map<int32_t, std::shared_ptr<void>> contexts_ = {};
+    // written under mtx_, read without lock
+    std::atomic<void*> contexts_[MAX_DEVICE_NUM] = {};
+    // bumped when the contexts are destroyed, the thread bindings of older generations are stale
+    std::atomic<uint64_t> generation_ = {1};
+    std::map<int32_t, std::vector<uint32_t>> affinities_ = {};
     uint32_t deviceCount_ = 0;
-    uint32_t initCounter_ = 0;
+    std::atomic<uint32_t> initCounter_ = {0};
     bool destroyFlag_ = false;
 };
 }  // namespace MxBase
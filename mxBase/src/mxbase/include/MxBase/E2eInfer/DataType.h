@@ -153,6 +153,8 @@ struct ModelLoadOptV2 {
     size_t modelSize = 0;
     size_t workSize = 0;
     size_t weightSize = 0;
+    // share weights with the same model on the device, model loaded from file without modelWeightPtr only
+    bool shareWeights = false;
 };
 
 static const std::map<ImageFormat, std::string> IMAGE_FORMAT_STRING = {
@@ -32,6 +32,8 @@ namespace {
     constexpr uint32_t DEFAULT_JPEGD_CHN_NUM = 24;
     constexpr uint32_t DEFAULT_JPEGE_CHN_NUM = 24;
     constexpr uint32_t DEFAULT_PNGD_CHN_NUM = 24;
+    constexpr uint32_t DEFAULT_MAX_CHN_NUM = 0;
+    constexpr uint32_t DEFAULT_CHN_IDLE_TIMEOUT_MS = 30000;
 }
 
 struct AppGlobalCfg {
@@ -43,6 +45,14 @@ struct AppGlobalCfgExtra {
     uint32_t jpegdChnNum = DEFAULT_JPEGD_CHN_NUM;
     uint32_t pngdChnNum = DEFAULT_PNGD_CHN_NUM;
     uint32_t jpegeChnNum = DEFAULT_JPEGE_CHN_NUM;
+    // channels created on demand when the pools run out, 0 or a max no greater than the pool size means the same
+    // as the pool size, so the pools are fixed unless a larger max is given
+    uint32_t vpcMaxChnNum = DEFAULT_MAX_CHN_NUM;
+    uint32_t jpegdMaxChnNum = DEFAULT_MAX_CHN_NUM;
+    uint32_t pngdMaxChnNum = DEFAULT_MAX_CHN_NUM;
+    uint32_t jpegeMaxChnNum = DEFAULT_MAX_CHN_NUM;
+    // channels above the pool size idle for longer than this are destroyed
+    uint32_t chnIdleTimeoutMs = DEFAULT_CHN_IDLE_TIMEOUT_MS;
     virtual ~AppGlobalCfgExtra() = default;
 };
 
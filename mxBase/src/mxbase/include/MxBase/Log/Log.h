@@ -25,11 +25,14 @@
 
 #define GLOG_USE_GLOG_EXPORT
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <streambuf>
 #include <glog/logging.h>
 #include <execinfo.h>
 #include "MxBase/ErrorCode/ErrorCode.h"
@@ -47,6 +50,84 @@ enum LogLevels {
 };
 
 const std::string DEFAULT_LOGGER = "DEFAULT_LOGGER";
+
+/**
+ * State of one LogXxx call site, the flow control counter and the rate limit window.
+ */
+struct LogSite {
+    std::atomic<uint32_t> occurrences{0};
+    std::atomic<int64_t> window{0};
+    std::atomic<uint32_t> windowCount{0};
+    std::atomic<uint32_t> suppressed{0};
+
+    /**
+     * Only called by LogLine once the level check passed, so a filtered line costs neither the counters nor the
+     * formatting.
+     * @return false when the line is skipped by the flow control frequency or the rate limit of the site
+     */
+    bool Pass();
+};
+
+class LogStreamBuf : public std::streambuf {
+public:
+    void Reset(char* data, size_t len)
+    {
+        setp(data, data + len);
+    }
+
+    size_t Size() const
+    {
+        return static_cast<size_t>(pptr() - pbase());
+    }
+
+protected:
+    // the line is truncated when it is longer than the buffer, as glog does
+    int_type overflow(int_type ch) override
+    {
+        return ch;
+    }
+};
+
+/**
+ * One formatted log line. With the asynchronous mode the line is staged in the buffer of the thread and written by
+ * the log writer, otherwise it is written through glog. A line skipped by its site keeps a bad stream, so nothing is
+ * formatted into it.
+ */
+class LogLine {
+public:
+    LogLine(LogLevels level, const char* file, int line, LogSite* site = nullptr);
+    ~LogLine();
+
+    std::ostream& stream()
+    {
+        return stream_;
+    }
+
+private:
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    LogLevels level_;
+    const char* file_;
+    int line_;
+    int64_t timeUs_ = 0;
+    bool async_ = false;
+    bool localStorage_ = false;
+    uint32_t suppressed_ = 0;
+    size_t prefixLen_ = 0;
+    char* data_ = nullptr;
+    std::unique_ptr<char[]> heapData_;
+    LogStreamBuf buf_;
+    std::ostream stream_;
+};
+
+// turns the stream of MX_LOG into void, the type of the other branch of the conditional, as glog does
+class LogLineVoidify {
+public:
+    // lower precedence than << and higher than ?:
+    void operator&(std::ostream&) {}
+};
+
 class Log {
 public:
     static Log& getLogger(const std::string loggerName = DEFAULT_LOGGER);
@@ -70,11 +151,22 @@ public:
     static void LogRotateByNumbers(int fileNumbers);
     static void UpdateFileMode();
 
+    static bool IsLevelEnabled(LogLevels level)
+    {
+        return (level == LOG_LEVEL_DEBUG) ? (FLAGS_v >= LOG_LEVEL_DEBUG) : (level >= FLAGS_minloglevel);
+    }
+
+    /**
+     * Number of lines dropped by the asynchronous mode because the staging buffer of the thread was full.
+     */
+    static uint64_t GetDroppedMessageNumber();
+
 public:
     static int rotateDay_;
     static int rotateFileNumber_;
     static std::string logConfigPath_;
     static int logFlowControlFrequency_;
+    static int logRateLimit_;
     static bool showLog_;
 
 private:
@@ -110,13 +202,20 @@ private:
     std::string loggerName_;
     static std::string pId_;
     static std::string pName_;
+    static void StartAsyncWriter();
 };
 }  // namespace MxBase
 
 #define FILELINE __FILE__, __FUNCTION__, __LINE__
-#define LogDebug VLOG_EVERY_N(MxBase::LOG_LEVEL_DEBUG, MxBase::Log::logFlowControlFrequency_)
-#define LogInfo LOG_EVERY_N(INFO, MxBase::Log::logFlowControlFrequency_)
-#define LogWarn LOG_EVERY_N(WARNING, MxBase::Log::logFlowControlFrequency_)
-#define LogError LOG_EVERY_N(ERROR, MxBase::Log::logFlowControlFrequency_)
-#define LogFatal LOG_EVERY_N(FATAL, MxBase::Log::logFlowControlFrequency_)
+// the arguments of the stream are only evaluated when the level is enabled, and only formatted when the line also
+// passes its call site. The lambda gives every call site its own static LogSite inside one expression, so LogXxx can
+// be used as a single statement, in an if without braces for example.
+#define MX_LOG(level) \
+    !MxBase::Log::IsLevelEnabled(level) ? (void)0 : MxBase::LogLineVoidify() & \
+        MxBase::LogLine(level, __FILE__, __LINE__, []() { static MxBase::LogSite site; return &site; }()).stream()
+#define LogDebug MX_LOG(MxBase::LOG_LEVEL_DEBUG)
+#define LogInfo MX_LOG(MxBase::LOG_LEVEL_INFO)
+#define LogWarn MX_LOG(MxBase::LOG_LEVEL_WARN)
+#define LogError MX_LOG(MxBase::LOG_LEVEL_ERROR)
+#define LogFatal MX_LOG(MxBase::LOG_LEVEL_FATAL)
 #endif  // CORE_LOG_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Caching allocator for the device and dvpp memory of MemoryHelper.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MEMORY_CACHE_H
+#define MEMORY_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "MxBase/MemoryHelper/MemoryHelper.h"
+
+namespace MxBase {
+struct MemoryCacheConfig {
+    // 512 MiB and 256 MiB by default
+    MemoryCacheConfig();
+    // bytes of free memory kept by the cache over all devices, the whole free segments above it go back to the driver
+    size_t maxCachedSize;
+    // larger requests are allocated and freed by the driver directly
+    size_t maxBlockSize;
+};
+
+struct MemoryCacheStats {
+    uint64_t mallocCount = 0;         // requests served by the cache
+    uint64_t hitCount = 0;            // requests served without a driver allocation
+    uint64_t directMallocCount = 0;   // requests passed to the driver directly
+    uint64_t driverMallocCount = 0;   // segments allocated from the driver
+    uint64_t driverFreeCount = 0;     // segments returned to the driver
+    size_t allocatedSize = 0;         // bytes of the blocks in use
+    size_t reservedSize = 0;          // bytes of the segments held by the cache
+    size_t peakReservedSize = 0;
+};
+
+/**
+ * Size classed caching allocator installed with the malloc and free hooks of MemoryHelper, so that the device and
+ * dvpp memory of MemoryHelper::MxbsMalloc is reused instead of allocated from the driver for every frame. Requests up
+ * to 1 MiB are rounded to 512 bytes and split from 2 MiB segments, larger ones are rounded to a quarter of their power
+ * of two and split from cached blocks when the rest is over 1 MiB. Free blocks are merged with their free neighbours
+ * and cached per device. The hooks carry no stream, so as with the driver free a block must be freed after the tasks
+ * using it completed. The dvpp hooks are only used on the devices allocating dvpp memory by hi_mpi_dvpp_malloc.
+ */
+class SDK_AVAILABLE_FOR_OUT MemoryCache {
+public:
+    /**
+     * @description: Register the caching malloc and free functions of MEMORY_DEVICE or MEMORY_DVPP, replacing the
+     * registered customized functions. Enabling an enabled cache only changes its config.
+     */
+    static APP_ERROR Enable(MemoryData::MemoryType type, const MemoryCacheConfig& config = MemoryCacheConfig());
+
+    /**
+     * @description: Return the cached memory to the driver and register the default functions again.
+     * @return: APP_ERR_COMM_BUSY when blocks of the cache are still in use.
+     */
+    static APP_ERROR Disable(MemoryData::MemoryType type);
+
+    /**
+     * @description: Return the free segments to the driver, for example when another allocator runs out of memory.
+     */
+    static APP_ERROR Trim(MemoryData::MemoryType type);
+
+    static APP_ERROR GetStats(MemoryData::MemoryType type, MemoryCacheStats& stats);
+};
+}  // namespace MxBase
+#endif
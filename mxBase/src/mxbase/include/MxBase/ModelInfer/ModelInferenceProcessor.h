@@ -74,6 +74,14 @@ public:
      */
     APP_ERROR Init(const std::string& modelPath);
 
+    /**
+     * @description Init
+     * 1.Loading  Model, weights are shared by all instances of the same model on the device if shareWeights is set
+     * 2.Get input sizes and output sizes
+     * @return APP_ERROR error code
+     */
+    APP_ERROR Init(const std::string& modelPath, bool shareWeights);
+
     /**
      * @description Unload Model
      * @return APP_ERROR error code
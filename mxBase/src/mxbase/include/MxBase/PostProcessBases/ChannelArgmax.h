@@ -0,0 +1,68 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Argmax and top k over the class channels of segmentation outputs.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_CHANNEL_ARGMAX_H
+#define MXBASE_CHANNEL_ARGMAX_H
+
+#include <cstdint>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Tensor/TensorBase/TensorDataType.h"
+#include "MxBase/PostProcessBases/PostProcessDataType.h"
+
+namespace MxBase {
+/**
+ * Scores of one image. With TYPE_NCHW the classes are planes of width x height scores, with TYPE_NHWC the classNum
+ * scores of a pixel are adjacent. Only TENSOR_DTYPE_FLOAT32 and TENSOR_DTYPE_FLOAT16 are supported.
+ */
+struct SDK_AVAILABLE_FOR_OUT ChannelScores {
+    const void* data = nullptr;
+    TensorDataType dataType = TENSOR_DTYPE_FLOAT32;
+    TensorArrangementType layout = TYPE_NCHW;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t classNum = 0;
+};
+
+class SDK_AVAILABLE_FOR_OUT ChannelArgmax {
+public:
+    /**
+     * @description: Class of the highest score of every pixel, the first one on ties like std::max_element.
+     * NCHW is done plane by plane with a vectorized compare and select, so the scores are never transposed.
+     * @param scores: scores of one image.
+     * @param labels: reset to width x height.
+     * @param confidence: when not null, filled with the softmax probability of the label of every pixel.
+     * @param threadNum: number of row bands processed in parallel.
+     * @return: Error code.
+     */
+    static APP_ERROR Argmax(const ChannelScores& scores, SegLabelMap& labels,
+                           std::vector<float>* confidence = nullptr, uint32_t threadNum = 1);
+
+    /**
+     * @description: The k highest scoring classes of every pixel in descending order, stored at pixel * k.
+     * @return: Error code.
+     */
+    static APP_ERROR TopK(const ChannelScores& scores, uint32_t k, std::vector<uint32_t>& classIds,
+                          std::vector<float>& classScores, uint32_t threadNum = 1);
+};
+}
+#endif
@@ -0,0 +1,122 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: CTC decoding of text recognition outputs, greedy or with a prefix beam search.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_CTC_DECODER_H
+#define MXBASE_CTC_DECODER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxBase/Tensor/TensorBase/TensorDataType.h"
+
+namespace MxBase {
+/**
+ * Logits of a batch, batchSize x timeStep x classNum values with the classes of a time step adjacent.
+ * Only TENSOR_DTYPE_FLOAT32 and TENSOR_DTYPE_FLOAT16 are supported.
+ */
+struct SDK_AVAILABLE_FOR_OUT CtcLogits {
+    const void* data = nullptr;
+    TensorDataType dataType = TENSOR_DTYPE_FLOAT32;
+    uint32_t batchSize = 1;
+    uint32_t timeStep = 0;
+    uint32_t classNum = 0;
+};
+
+struct SDK_AVAILABLE_FOR_OUT CtcBeamConfig {
+    uint32_t beamWidth = 10;        // 1 without a lexicon is the best path
+    float pruneThresh = 0.001f;     // classes less probable than this at a time step do not extend the beams
+    bool applySoftmax = true;       // false when the model already outputs probabilities
+};
+
+class SDK_AVAILABLE_FOR_OUT CtcDecoder {
+public:
+    /**
+     * @description: Packs the UTF-8 names of the classes into one table. Class ids out of the table decode to
+     * nothing, as ConfigData::GetClassName returns an empty name for them.
+     */
+    APP_ERROR Init(const std::vector<std::string>& classNames, uint32_t blankIdx);
+
+    /**
+     * @description: Restricts the beam search to the words, which are split into classes by longest match on the
+     * class names. Words that can not be split are skipped. An empty list removes the lexicon.
+     */
+    APP_ERROR SetLexicon(const std::vector<std::string>& words);
+
+    /**
+     * @description: SetLexicon with the words of a file, one word per line.
+     */
+    APP_ERROR LoadLexicon(const std::string& lexiconPath);
+
+    bool HasLexicon() const
+    {
+        return !lexiconWordEnds_.empty();
+    }
+
+    /**
+     * @description: Best path decoding, the argmax class of every time step with repeats and blanks removed.
+     * The logits are read in place, float16 time steps are converted one at a time.
+     * @param texts: resized to batchSize.
+     */
+    APP_ERROR GreedyDecode(const CtcLogits& logits, std::vector<std::string>& texts) const;
+
+    /**
+     * @description: Best path decoding of class ids already reduced by an argmax layer, timeStep ids per image.
+     */
+    APP_ERROR GreedyDecode(const int64_t* classIds, uint32_t batchSize, uint32_t timeStep,
+                           std::vector<std::string>& texts) const;
+
+    /**
+     * @description: Prefix beam search. With a lexicon only prefixes of its words are kept and the best complete
+     * word is returned, an image without any complete word falls back to the best path.
+     * @param texts: resized to batchSize.
+     */
+    APP_ERROR BeamSearchDecode(const CtcLogits& logits, const CtcBeamConfig& config,
+                               std::vector<std::string>& texts) const;
+
+private:
+    void AppendClass(uint32_t classId, std::string& text) const;
+
+    std::string DecodeBestPath(const CtcLogits& logits, uint32_t batchIdx, std::vector<float>& buffer) const;
+
+    void ScoreTimeStep(const float* row, uint32_t classNum, const CtcBeamConfig& config, std::vector<float>& logProbs,
+                       std::vector<uint32_t>& candidates) const;
+
+    std::string DecodeBeams(const CtcLogits& logits, uint32_t batchIdx, const CtcBeamConfig& config,
+                            std::vector<float>& buffer) const;
+
+    int32_t NextLexiconNode(int32_t node, uint32_t classId) const;
+
+private:
+    uint32_t blankIdx_ = 0;
+    std::string classText_;
+    std::vector<uint32_t> classOffsets_ = {0};    // class c is classText_[classOffsets_[c], classOffsets_[c + 1])
+    std::unordered_map<std::string, uint32_t> classIds_;
+    size_t maxClassLength_ = 0;
+    // lexicon trie, node 0 is the root, an edge is keyed by (node << 32) | classId
+    std::unordered_map<uint64_t, int32_t> lexiconEdges_;
+    std::vector<uint8_t> lexiconWordEnds_;
+};
+}
+#endif
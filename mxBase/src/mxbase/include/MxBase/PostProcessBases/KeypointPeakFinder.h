@@ -0,0 +1,108 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Peak finding and sampling on keypoint heatmaps, shared by the pose postprocessors.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_KEYPOINT_PEAK_FINDER_H
+#define MXBASE_KEYPOINT_PEAK_FINDER_H
+
+#include <cstdint>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+
+namespace MxBase {
+/**
+ * One channel of a heatmap. The values of adjacent pixels are pixelStride floats apart, so a plane of NCHW data has
+ * pixelStride 1 and a channel of NHWC data has pixelStride equal to the channel number.
+ */
+struct SDK_AVAILABLE_FOR_OUT HeatmapPlane {
+    const float* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t pixelStride = 1;
+};
+
+struct SDK_AVAILABLE_FOR_OUT HeatmapPeak {
+    float x = 0;            // refined position on the heatmap grid, pixel centers at integers
+    float y = 0;
+    float score = 0;        // heatmap value at the integer peak
+    uint32_t index = 0;     // row major index of the integer peak
+};
+
+struct SDK_AVAILABLE_FOR_OUT LimbScore {
+    float score = 0;        // mean of the projections of the sampled vectors on the limb direction
+    uint32_t hitNum = 0;    // number of samples whose projection is above the threshold
+};
+
+class SDK_AVAILABLE_FOR_OUT KeypointPeakFinder {
+public:
+    /**
+     * @description: 1-D factor of the OpenPose smoothing kernel, the normalized square root of the gaussian cdf
+     * differences, whose outer product is the size x size 2-D kernel. The kernel is area averaged onto a grid scale
+     * times coarser, so that smoothing a map at model resolution matches smoothing it after upsampling by scale.
+     * The returned kernel always has an odd size.
+     * @return: APP_ERR_COMM_OUT_OF_RANGE when size is 0, scale is not positive or the kernel sums to 0.
+     */
+    static APP_ERROR MakeGaussianKernel(uint32_t size, float sigma, float scale, std::vector<float>& kernel);
+
+    /**
+     * @description: Separable convolution with zeros out of the map, the same as cv::filter2D with BORDER_CONSTANT
+     * and the outer product of kernelY and kernelX. Both kernels must have an odd size.
+     * @param dst: resized to width x height, planar.
+     */
+    static APP_ERROR GaussianBlur(const HeatmapPlane& src, const std::vector<float>& kernelX,
+                                  const std::vector<float>& kernelY, std::vector<float>& dst);
+
+    /**
+     * @description: In place non-maximum suppression of a planar map, keeps the positive values equal to the maximum
+     * of their window x window neighbourhood and zeroes the others. The maximum filter is separable and vectorized.
+     */
+    static APP_ERROR SuppressNonMaximum(float* plane, uint32_t width, uint32_t height, uint32_t window);
+
+    /**
+     * @description: Local maxima of a planar map over a window x window neighbourhood that are above threshold, in
+     * row major order. With refine the position is moved to the vertex of the parabola through the peak and its
+     * two neighbours, separately in x and y, by at most half a pixel.
+     */
+    static APP_ERROR FindPeaks(const float* plane, uint32_t width, uint32_t height, float threshold, uint32_t window,
+                               bool refine, std::vector<HeatmapPeak>& peaks);
+
+    /**
+     * @description: Bilinear resize of a planar map with pixel centers aligned, the same as cv::INTER_LINEAR.
+     */
+    static APP_ERROR ResizeBilinear(const float* src, uint32_t srcWidth, uint32_t srcHeight, float* dst,
+                                    uint32_t dstWidth, uint32_t dstHeight);
+
+    /**
+     * @description: Bilinear sample at (x, y), clamped to the map.
+     */
+    static float SampleBilinear(const HeatmapPlane& plane, float x, float y);
+
+    /**
+     * @description: Line integral of a vector field from (x0, y0) towards (x1, y1) with sampleNum bilinear samples
+     * at i / sampleNum of the segment, as the part affinity field score of OpenPose. Only the samples on the limb
+     * are read, the field is never resampled as a whole.
+     */
+    static LimbScore ScoreLimb(const HeatmapPlane& fieldX, const HeatmapPlane& fieldY, float x0, float y0,
+                               float x1, float y1, uint32_t sampleNum, float hitThresh);
+};
+}
+#endif
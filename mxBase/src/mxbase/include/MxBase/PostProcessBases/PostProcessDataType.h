@@ -23,6 +23,7 @@
 #ifndef POST_PROCESS_DATA_TYPE
 #define POST_PROCESS_DATA_TYPE
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -192,10 +193,71 @@ public:
 };
 
 // 3.Class for semantic segmentation
+/**
+ * Class id of every pixel in one contiguous buffer, one byte per pixel when the class ids fit in uint8 and two bytes
+ * otherwise. The buffer is a std::string so that it can be moved into a protobuf bytes field without a copy.
+ */
+class SDK_AVAILABLE_FOR_OUT SegLabelMap {
+public:
+    SegLabelMap() = default;
+    SegLabelMap(uint32_t width, uint32_t height, uint32_t classNum);
+
+    void Reset(uint32_t width, uint32_t height, uint32_t classNum);
+
+    bool Empty() const
+    {
+        return data.empty();
+    }
+
+    uint32_t At(uint32_t x, uint32_t y) const
+    {
+        size_t index = static_cast<size_t>(y) * stride + x;
+        return elemSize == 1 ? reinterpret_cast<const uint8_t*>(data.data())[index] :
+            reinterpret_cast<const uint16_t*>(data.data())[index];
+    }
+
+    void Set(uint32_t x, uint32_t y, uint32_t label)
+    {
+        size_t index = static_cast<size_t>(y) * stride + x;
+        if (elemSize == 1) {
+            reinterpret_cast<uint8_t*>(&data[0])[index] = static_cast<uint8_t>(label);
+        } else {
+            reinterpret_cast<uint16_t*>(&data[0])[index] = static_cast<uint16_t>(label);
+        }
+    }
+
+    /**
+     * @description: Nearest neighbour resize of the top left srcWidth x srcHeight region to dstWidth x dstHeight,
+     * done in one pass with a precomputed column table. Source pixels out of the map are written as class 0.
+     */
+    SegLabelMap ResizeNearest(uint32_t dstWidth, uint32_t dstHeight, uint32_t srcWidth, uint32_t srcHeight) const;
+
+    std::vector<std::vector<int>> ToPixels() const;
+
+    /**
+     * @description: Run length encoding in row major order, as (label, run length) pairs.
+     */
+    std::vector<uint32_t> EncodeRle() const;
+
+    /**
+     * @description: COCO compressed RLE string of the binary mask of one class, in column major order and starting
+     * with a run of background, the same as the counts string produced by pycocotools.
+     */
+    std::string EncodeCocoRle(uint32_t classId) const;
+
+public:
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t stride = 0;        // in elements
+    uint32_t elemSize = 1;      // 1: uint8, 2: uint16
+    std::string data;
+};
+
 class SDK_AVAILABLE_FOR_OUT SemanticSegInfo {
 public:
-    std::vector<std::vector<int>> pixels;
+    std::vector<std::vector<int>> pixels;   // empty when OUTPUT_PIXELS of the postprocess config is false
     std::vector<std::string> labelMap;
+    SegLabelMap labels;
 };
 
 // 4.Class for attribute tasks
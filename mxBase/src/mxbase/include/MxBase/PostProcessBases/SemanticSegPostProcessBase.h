@@ -46,12 +46,20 @@ public:
 protected:
     void CoordinatesReduction(const ResizedImageInfo& resizedImageInfo,
                               SemanticSegInfo& semanticSegInfos);
-                        
+
+    /**
+     * @description: Attach the class names and, when OUTPUT_PIXELS is true, the nested pixels built from the
+     * label map. Called once the label map is at its final size.
+     */
+    void FillSemanticSegInfo(SemanticSegInfo& semanticSegInfo) const;
+
     APP_ERROR GetSemanticSegConfigData();
 
 protected:
     uint32_t classNum_ = 0;
     int modelType_ = TYPE_NHWC;
+    bool outputPixels_ = true;
+    uint32_t argmaxThreadNum_ = 1;
     std::vector<std::string> labelMap_;
 };
 
@@ -22,6 +22,8 @@
 
 #ifndef MX_DATATYPEUTILS_H
 #define MX_DATATYPEUTILS_H
+#include <cstddef>
+#include <cstdint>
 #include <sys/stat.h>
 
 namespace MxBase {
@@ -33,6 +35,23 @@ namespace MxBase {
          * @return
          */
         static void Float32ToFloat16(uint16_t *__restrict out, float &in);
+
+        /** Convert num float32 values to float16 stored as uint16_t, rounded to nearest even, with a vector
+         * conversion where available
+         * @param out converted float16 values
+         * @param in float32 values to be converted
+         * @param num number of values
+         * @return
+         */
+        static void Float32ToFloat16(uint16_t *__restrict out, const float *__restrict in, size_t num);
+
+        /** Convert num float16 values stored as uint16_t to float32, with a vector conversion where available
+         * @param out converted float32 values
+         * @param in float16 values to be converted
+         * @param num number of values
+         * @return
+         */
+        static void Float16ToFloat32(float *__restrict out, const uint16_t *__restrict in, size_t num);
     };
 }
 #endif // MX_MX_DATATYPEUTILS_H
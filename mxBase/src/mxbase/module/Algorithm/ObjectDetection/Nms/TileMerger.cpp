@@ -0,0 +1,265 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Merge of the detections of overlapping image tiles through a spatial hash.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/CV/ObjectDetection/Nms/TileMerger.h"
+#include <algorithm>
+#include <cmath>
+#include "MxBase/CV/ObjectDetection/Nms/Nms.h"
+#include "MxBase/Log/Log.h"
+
+namespace {
+using namespace MxBase;
+
+const float HALF = 0.5f;
+const float MIN_CELL_SIZE = 1.f;
+const float EPSILON = 1e-6f;
+// bounds the cell number, huge images with tiny boxes get coarser cells
+const uint32_t MAX_GRID_EDGE = 256;
+
+inline float Left(const DetectBox& box)
+{
+    return box.x - box.width * HALF;
+}
+
+inline float Top(const DetectBox& box)
+{
+    return box.y - box.height * HALF;
+}
+
+inline float Right(const DetectBox& box)
+{
+    return box.x + box.width * HALF;
+}
+
+inline float Bottom(const DetectBox& box)
+{
+    return box.y + box.height * HALF;
+}
+
+inline uint32_t ToCell(float value, float origin, float cellSize, uint32_t cellNum)
+{
+    float cell = (value - origin) / cellSize;
+    if (!(cell > 0)) {
+        return 0;
+    }
+    return cell >= static_cast<float>(cellNum - 1) ? cellNum - 1 : static_cast<uint32_t>(cell);
+}
+
+// sums of a weighted fusion group
+struct FusionSum {
+    float weight = 0;
+    float x0 = 0;
+    float y0 = 0;
+    float x1 = 0;
+    float y1 = 0;
+
+    void Add(const DetectBox& box)
+    {
+        weight += box.prob;
+        x0 += box.prob * Left(box);
+        y0 += box.prob * Top(box);
+        x1 += box.prob * Right(box);
+        y1 += box.prob * Bottom(box);
+    }
+};
+}
+
+namespace MxBase {
+void TileMerger::SortBoxes(const std::vector<DetectBox>& boxes, TileMergePolicy policy)
+{
+    order_.resize(boxes.size());
+    for (uint32_t i = 0; i < order_.size(); i++) {
+        order_[i] = i;
+    }
+    if (policy == TILE_MERGE_NMS_BY_AREA) {
+        std::stable_sort(order_.begin(), order_.end(), [&boxes](uint32_t a, uint32_t b) {
+            if (boxes[a].classID != boxes[b].classID) {
+                return boxes[a].classID < boxes[b].classID;
+            }
+            return boxes[a].width * boxes[a].height > boxes[b].width * boxes[b].height;
+        });
+    } else {
+        std::stable_sort(order_.begin(), order_.end(), [&boxes](uint32_t a, uint32_t b) {
+            if (boxes[a].classID != boxes[b].classID) {
+                return boxes[a].classID < boxes[b].classID;
+            }
+            return boxes[a].prob > boxes[b].prob;
+        });
+    }
+    rank_.resize(boxes.size());
+    for (uint32_t i = 0; i < order_.size(); i++) {
+        rank_[order_[i]] = i;
+    }
+}
+
+void TileMerger::MarkBandBoxes(const std::vector<DetectBox>& boxes, const std::vector<uint32_t>& tileIds,
+                               const std::vector<CropRoiBox>& tileAreas)
+{
+    // a box inside the area of its tile can only overlap a box of another tile that reaches out of its own area
+    inBand_.assign(boxes.size(), 1);
+    for (size_t i = 0; i < boxes.size(); i++) {
+        if (tileIds[i] >= tileAreas.size()) {
+            continue;
+        }
+        const CropRoiBox& area = tileAreas[tileIds[i]];
+        inBand_[i] = !(Left(boxes[i]) >= area.x0 && Top(boxes[i]) >= area.y0 && Right(boxes[i]) <= area.x1 &&
+                       Bottom(boxes[i]) <= area.y1);
+    }
+}
+
+void TileMerger::CellRange(const DetectBox& box, uint32_t& col0, uint32_t& row0, uint32_t& col1,
+                           uint32_t& row1) const
+{
+    col0 = ToCell(std::min(Left(box), Right(box)), originX_, cellSize_, gridWidth_);
+    col1 = ToCell(std::max(Left(box), Right(box)), originX_, cellSize_, gridWidth_);
+    row0 = ToCell(std::min(Top(box), Bottom(box)), originY_, cellSize_, gridHeight_);
+    row1 = ToCell(std::max(Top(box), Bottom(box)), originY_, cellSize_, gridHeight_);
+}
+
+void TileMerger::BuildGrid(const std::vector<DetectBox>& boxes)
+{
+    float minX = Left(boxes[0]);
+    float minY = Top(boxes[0]);
+    float maxX = minX;
+    float maxY = minY;
+    float extentSum = 0;
+    for (const auto& box : boxes) {
+        minX = std::min({minX, Left(box), Right(box)});
+        minY = std::min({minY, Top(box), Bottom(box)});
+        maxX = std::max({maxX, Left(box), Right(box)});
+        maxY = std::max({maxY, Top(box), Bottom(box)});
+        extentSum += std::max(std::fabs(box.width), std::fabs(box.height));
+    }
+    // cells about the mean box size keep a box in a few cells and a cell holding a few boxes
+    const float spanX = std::isfinite(maxX - minX) ? maxX - minX : 0;
+    const float spanY = std::isfinite(maxY - minY) ? maxY - minY : 0;
+    float cellSize = std::isfinite(extentSum) ? extentSum / boxes.size() : MIN_CELL_SIZE;
+    cellSize = std::max({cellSize, spanX / MAX_GRID_EDGE, spanY / MAX_GRID_EDGE, MIN_CELL_SIZE});
+    originX_ = std::isfinite(minX) ? minX : 0;
+    originY_ = std::isfinite(minY) ? minY : 0;
+    cellSize_ = cellSize;
+    gridWidth_ = std::min(static_cast<uint32_t>(spanX / cellSize) + 1, MAX_GRID_EDGE);
+    gridHeight_ = std::min(static_cast<uint32_t>(spanY / cellSize) + 1, MAX_GRID_EDGE);
+
+    // counting sort of the boxes into the cells they cover
+    cellOffsets_.assign(static_cast<size_t>(gridWidth_) * gridHeight_ + 1, 0);
+    uint32_t col0 = 0;
+    uint32_t row0 = 0;
+    uint32_t col1 = 0;
+    uint32_t row1 = 0;
+    for (const auto& box : boxes) {
+        CellRange(box, col0, row0, col1, row1);
+        for (uint32_t row = row0; row <= row1; row++) {
+            for (uint32_t col = col0; col <= col1; col++) {
+                cellOffsets_[row * gridWidth_ + col + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < cellOffsets_.size(); i++) {
+        cellOffsets_[i] += cellOffsets_[i - 1];
+    }
+    cellBoxes_.resize(cellOffsets_.back());
+    for (uint32_t i = 0; i < boxes.size(); i++) {
+        CellRange(boxes[i], col0, row0, col1, row1);
+        for (uint32_t row = row0; row <= row1; row++) {
+            for (uint32_t col = col0; col <= col1; col++) {
+                cellBoxes_[cellOffsets_[row * gridWidth_ + col]++] = i;
+            }
+        }
+    }
+    // the fill advanced every offset to the start of the next cell
+    for (size_t i = cellOffsets_.size() - 1; i > 0; i--) {
+        cellOffsets_[i] = cellOffsets_[i - 1];
+    }
+    cellOffsets_[0] = 0;
+}
+
+APP_ERROR TileMerger::Merge(const std::vector<DetectBox>& boxes, const std::vector<uint32_t>& tileIds,
+                            const std::vector<CropRoiBox>& tileAreas, const TileMergeConfig& config,
+                            std::vector<DetectBox>& merged)
+{
+    merged.clear();
+    if (config.crossTileOnly && tileIds.size() != boxes.size()) {
+        LogError << "The tile id number(" << tileIds.size() << ") is not equal to the box number(" << boxes.size()
+                 << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (boxes.empty()) {
+        return APP_ERR_OK;
+    }
+    SortBoxes(boxes, config.policy);
+    if (config.crossTileOnly) {
+        MarkBandBoxes(boxes, tileIds, tileAreas);
+    }
+    BuildGrid(boxes);
+    suppressed_.assign(boxes.size(), 0);
+    visitStamp_.assign(boxes.size(), 0);
+    const bool fusion = config.policy == TILE_MERGE_WEIGHTED_FUSION;
+    uint32_t col0 = 0;
+    uint32_t row0 = 0;
+    uint32_t col1 = 0;
+    uint32_t row1 = 0;
+    for (uint32_t r = 0; r < order_.size(); r++) {
+        const uint32_t head = order_[r];
+        if (suppressed_[head] != 0) {
+            continue;
+        }
+        const DetectBox& headBox = boxes[head];
+        FusionSum sum;
+        sum.Add(headBox);
+        CellRange(headBox, col0, row0, col1, row1);
+        for (uint32_t row = row0; row <= row1; row++) {
+            for (uint32_t col = col0; col <= col1; col++) {
+                const uint32_t cell = row * gridWidth_ + col;
+                for (uint32_t k = cellOffsets_[cell]; k < cellOffsets_[cell + 1]; k++) {
+                    const uint32_t other = cellBoxes_[k];
+                    // a box covering several cells is met once per cell
+                    if (rank_[other] <= r || suppressed_[other] != 0 || visitStamp_[other] == r + 1) {
+                        continue;
+                    }
+                    visitStamp_[other] = r + 1;
+                    if (boxes[other].classID != headBox.classID) {
+                        continue;
+                    }
+                    if (config.crossTileOnly &&
+                        (tileIds[other] == tileIds[head] || (inBand_[other] == 0 && inBand_[head] == 0))) {
+                        continue;
+                    }
+                    if (CalcIou(headBox, boxes[other], config.iouMethod) > config.iouThresh) {
+                        suppressed_[other] = 1;
+                        sum.Add(boxes[other]);
+                    }
+                }
+            }
+        }
+        merged.push_back(headBox);
+        if (fusion && sum.weight > EPSILON) {
+            DetectBox& fused = merged.back();
+            fused.width = (sum.x1 - sum.x0) / sum.weight;
+            fused.height = (sum.y1 - sum.y0) / sum.weight;
+            fused.x = (sum.x0 + sum.x1) * HALF / sum.weight;
+            fused.y = (sum.y0 + sum.y1) * HALF / sum.weight;
+        }
+    }
+    return APP_ERR_OK;
+}
+}
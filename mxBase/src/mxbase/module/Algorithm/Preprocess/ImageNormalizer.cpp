@@ -0,0 +1,384 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Fused normalization of interleaved images into model inputs.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/CV/Preprocess/ImageNormalizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "MxBase/Log/Log.h"
+#include "MxBase/Utils/DataTypeUtils.h"
+
+namespace {
+using namespace MxBase;
+
+const uint32_t MAX_CHANNEL_NUM = 4;
+const uint32_t RGB_CHANNEL_NUM = 3;
+// pixels converted together, the planar buffer of a chunk stays in L1
+const size_t CHUNK_PIXELS = 256;
+const uint32_t MIN_BAND_ROWS = 16;
+const uint32_t MAX_THREAD_NUM = 64;
+const double DOUBLE_PRECISION_DEVIATION = 1e-15;
+
+struct NormalizeCoeffs {
+    uint32_t channelNum = 0;
+    uint32_t order[MAX_CHANNEL_NUM] = {};
+    float scale[MAX_CHANNEL_NUM] = {};
+    float bias[MAX_CHANNEL_NUM] = {};
+};
+
+size_t GetElementSize(TensorDataType dataType)
+{
+    switch (dataType) {
+        case TENSOR_DTYPE_FLOAT32:
+            return sizeof(float);
+        case TENSOR_DTYPE_FLOAT16:
+            return sizeof(uint16_t);
+        case TENSOR_DTYPE_INT8:
+        case TENSOR_DTYPE_UINT8:
+            return sizeof(uint8_t);
+        default:
+            return 0;
+    }
+}
+
+APP_ERROR GetCoeffs(const NormalizeImage& src, const NormalizeParam& param, NormalizeCoeffs& coeffs)
+{
+    const uint32_t channelNum = src.channelNum;
+    if ((!param.channelOrder.empty() && param.channelOrder.size() != channelNum) ||
+        (!param.scale.empty() && param.scale.size() != channelNum) ||
+        (!param.bias.empty() && param.bias.size() != channelNum)) {
+        LogError << "The channel order, scale and bias must have " << channelNum << " values."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    coeffs.channelNum = channelNum;
+    for (uint32_t c = 0; c < channelNum; c++) {
+        coeffs.order[c] = param.channelOrder.empty() ? c : param.channelOrder[c];
+        coeffs.scale[c] = param.scale.empty() ? 1.f : param.scale[c];
+        coeffs.bias[c] = param.bias.empty() ? 0.f : param.bias[c];
+        if (coeffs.order[c] >= channelNum) {
+            LogError << "The channel order " << coeffs.order[c] << " is out of the " << channelNum << " channels."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+    }
+    return APP_ERR_OK;
+}
+
+template<typename S>
+void ComputeChunk(const S* src, const NormalizeCoeffs& coeffs, size_t begin, size_t num, float* planes[])
+{
+    const uint32_t channelNum = coeffs.channelNum;
+    for (uint32_t c = 0; c < channelNum; c++) {
+        const S* in = src + coeffs.order[c];
+        float* out = planes[c];
+        const float scale = coeffs.scale[c];
+        const float bias = coeffs.bias[c];
+        for (size_t i = begin; i < num; i++) {
+            out[i] = static_cast<float>(in[i * channelNum]) * scale + bias;
+        }
+    }
+}
+
+#if defined(__aarch64__)
+inline void StoreScaled(uint16x8_t value, float32x4_t scale, float32x4_t bias, float* out)
+{
+    vst1q_f32(out, vfmaq_f32(bias, vcvtq_f32_u32(vmovl_u16(vget_low_u16(value))), scale));
+    vst1q_f32(out + 4, vfmaq_f32(bias, vcvtq_f32_u32(vmovl_high_u16(value)), scale));
+}
+
+// 16 pixels of 3 channels are deinterleaved by one load
+size_t ComputeChunkU8C3(const uint8_t* src, const NormalizeCoeffs& coeffs, size_t num, float* planes[])
+{
+    const size_t lanes = 16;
+    const size_t half = 8;
+    size_t i = 0;
+    for (; i + lanes <= num; i += lanes) {
+        uint8x16x3_t pixels = vld3q_u8(src + i * RGB_CHANNEL_NUM);
+        for (uint32_t c = 0; c < RGB_CHANNEL_NUM; c++) {
+            uint8x16_t value = pixels.val[coeffs.order[c]];
+            float32x4_t scale = vdupq_n_f32(coeffs.scale[c]);
+            float32x4_t bias = vdupq_n_f32(coeffs.bias[c]);
+            StoreScaled(vmovl_u8(vget_low_u8(value)), scale, bias, planes[c] + i);
+            StoreScaled(vmovl_high_u8(value), scale, bias, planes[c] + i + half);
+        }
+    }
+    return i;
+}
+#endif
+
+void ComputeChunk(const NormalizeImage& src, const NormalizeCoeffs& coeffs, const uint8_t* row, size_t num,
+                  float* planes[])
+{
+    if (src.dataType == TENSOR_DTYPE_FLOAT32) {
+        ComputeChunk(reinterpret_cast<const float*>(row), coeffs, 0, num, planes);
+        return;
+    }
+    size_t begin = 0;
+#if defined(__aarch64__)
+    if (coeffs.channelNum == RGB_CHANNEL_NUM) {
+        begin = ComputeChunkU8C3(row, coeffs, num, planes);
+    }
+#endif
+    ComputeChunk(row, coeffs, begin, num, planes);
+}
+
+inline void StoreValues(const float* in, float* out, size_t num)
+{
+    std::copy(in, in + num, out);
+}
+
+inline void StoreValues(const float* in, uint16_t* out, size_t num)
+{
+    DataTypeUtils::Float32ToFloat16(out, in, num);
+}
+
+template<typename T>
+inline T SaturateRound(float value)
+{
+    float rounded = std::nearbyint(value);
+    rounded = std::min(std::max(rounded, static_cast<float>(std::numeric_limits<T>::min())),
+                       static_cast<float>(std::numeric_limits<T>::max()));
+    return static_cast<T>(rounded);
+}
+
+template<typename T>
+void StoreRounded(const float* in, T* out, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__)
+    const size_t lanes = 8;
+    for (; i + lanes <= num; i += lanes) {
+        int16x8_t value = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(in + i))),
+                                       vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(in + i + lanes / 2))));
+        if (std::is_signed<T>::value) {
+            vst1_s8(reinterpret_cast<int8_t*>(out + i), vqmovn_s16(value));
+        } else {
+            vst1_u8(reinterpret_cast<uint8_t*>(out + i), vqmovun_s16(value));
+        }
+    }
+#elif defined(__SSE2__)
+    const size_t lanes = 8;
+    for (; i + lanes <= num; i += lanes) {
+        __m128i value = _mm_packs_epi32(_mm_cvtps_epi32(_mm_loadu_ps(in + i)),
+                                        _mm_cvtps_epi32(_mm_loadu_ps(in + i + lanes / 2)));
+        value = std::is_signed<T>::value ? _mm_packs_epi16(value, value) : _mm_packus_epi16(value, value);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), value);
+    }
+#endif
+    for (; i < num; i++) {
+        out[i] = SaturateRound<T>(in[i]);
+    }
+}
+
+inline void StoreValues(const float* in, int8_t* out, size_t num)
+{
+    StoreRounded(in, out, num);
+}
+
+inline void StoreValues(const float* in, uint8_t* out, size_t num)
+{
+    StoreRounded(in, out, num);
+}
+
+void Interleave(float* const planes[], uint32_t channelNum, size_t num, float* out)
+{
+    size_t i = 0;
+#if defined(__aarch64__)
+    if (channelNum == RGB_CHANNEL_NUM) {
+        const size_t lanes = 4;
+        for (; i + lanes <= num; i += lanes) {
+            float32x4x3_t pixels = {{vld1q_f32(planes[0] + i), vld1q_f32(planes[1] + i), vld1q_f32(planes[2] + i)}};
+            vst3q_f32(out + i * RGB_CHANNEL_NUM, pixels);
+        }
+    }
+#endif
+    for (; i < num; i++) {
+        for (uint32_t c = 0; c < channelNum; c++) {
+            out[i * channelNum + c] = planes[c][i];
+        }
+    }
+}
+
+/**
+ * Rows [rowBegin, rowEnd) in chunks of pixels. A chunk is computed into planar floats, then either each plane is
+ * stored into its output plane, or the planes are interleaved, in place for float32 outputs, and stored.
+ */
+template<typename T>
+void NormalizeBand(const NormalizeImage& src, const NormalizeCoeffs& coeffs, TensorArrangementType layout, T* dst,
+                   uint32_t rowBegin, uint32_t rowEnd)
+{
+    const uint32_t channelNum = coeffs.channelNum;
+    const size_t srcElemSize = GetElementSize(src.dataType);
+    const size_t rowStride = src.rowStride != 0 ? src.rowStride : src.width * channelNum * srcElemSize;
+    const size_t planeSize = static_cast<size_t>(src.width) * src.height;
+    const bool interleaveInPlace = std::is_same<T, float>::value;
+    std::vector<float> buffer(CHUNK_PIXELS * channelNum);
+    std::vector<float> interleaved(layout == TYPE_NHWC && !interleaveInPlace ? CHUNK_PIXELS * channelNum : 0);
+    float* planes[MAX_CHANNEL_NUM] = {};
+    for (uint32_t c = 0; c < channelNum; c++) {
+        planes[c] = buffer.data() + c * CHUNK_PIXELS;
+    }
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        const uint8_t* row = static_cast<const uint8_t*>(src.data) + y * rowStride;
+        for (size_t x = 0; x < src.width; x += CHUNK_PIXELS) {
+            size_t num = std::min(CHUNK_PIXELS, src.width - x);
+            ComputeChunk(src, coeffs, row + x * channelNum * srcElemSize, num, planes);
+            size_t pixel = static_cast<size_t>(y) * src.width + x;
+            if (layout == TYPE_NCHW) {
+                for (uint32_t c = 0; c < channelNum; c++) {
+                    StoreValues(planes[c], dst + c * planeSize + pixel, num);
+                }
+            } else if (interleaveInPlace) {
+                Interleave(planes, channelNum, num, reinterpret_cast<float*>(dst + pixel * channelNum));
+            } else {
+                Interleave(planes, channelNum, num, interleaved.data());
+                StoreValues(interleaved.data(), dst + pixel * channelNum, num * channelNum);
+            }
+        }
+    }
+}
+
+/**
+ * Splits the rows into at most threadNum bands of at least MIN_BAND_ROWS rows, the calling thread takes the first.
+ */
+void RunInBands(uint32_t height, uint32_t threadNum, const std::function<void(uint32_t, uint32_t)>& func)
+{
+    uint32_t bandNum = std::max(1u, std::min({threadNum, MAX_THREAD_NUM, height / MIN_BAND_ROWS}));
+    uint32_t bandRows = (height + bandNum - 1) / bandNum;
+    std::vector<std::thread> threads;
+    uint32_t begin = bandRows;
+    for (; begin < height; begin += bandRows) {
+        try {
+            threads.emplace_back(func, begin, std::min(height, begin + bandRows));
+        } catch (const std::system_error&) {
+            LogWarn << "Create band thread failed, the bands left run in the calling thread.";
+            break;
+        }
+    }
+    func(0, std::min(height, bandRows));
+    for (; begin < height; begin += bandRows) {
+        func(begin, std::min(height, begin + bandRows));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template<typename T>
+void RunNormalize(const NormalizeImage& src, const NormalizeCoeffs& coeffs, TensorArrangementType layout, void* dst,
+                  uint32_t threadNum)
+{
+    T* out = static_cast<T*>(dst);
+    RunInBands(src.height, threadNum, [&src, &coeffs, layout, out](uint32_t rowBegin, uint32_t rowEnd) {
+        NormalizeBand(src, coeffs, layout, out, rowBegin, rowEnd);
+    });
+}
+}
+
+namespace MxBase {
+APP_ERROR ImageNormalizer::MeanStdToScaleBias(const std::vector<double>& mean, const std::vector<double>& std,
+                                              std::vector<float>& scale, std::vector<float>& bias)
+{
+    if (mean.size() != std.size()) {
+        LogError << "The mean has " << mean.size() << " values but the std has " << std.size() << "."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    scale.resize(std.size());
+    bias.resize(std.size());
+    for (size_t i = 0; i < std.size(); i++) {
+        if (std::fabs(std[i]) < DOUBLE_PRECISION_DEVIATION) {
+            LogError << "The value of std[" << i << "] must not equal to zero."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+        // the same rounding as cv::Mat::convertTo(dst, type, 1 / std, -mean / std)
+        scale[i] = static_cast<float>(1 / std[i]);
+        bias[i] = static_cast<float>(-mean[i] / std[i]);
+    }
+    return APP_ERR_OK;
+}
+
+size_t ImageNormalizer::GetOutputSize(const NormalizeImage& src, const NormalizeParam& param)
+{
+    return static_cast<size_t>(src.width) * src.height * src.channelNum * GetElementSize(param.dataType);
+}
+
+APP_ERROR ImageNormalizer::Normalize(const NormalizeImage& src, const NormalizeParam& param, void* dst,
+                                     size_t dstSize, uint32_t threadNum)
+{
+    if (src.data == nullptr || dst == nullptr) {
+        LogError << "The input or output of the normalization is nullptr."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (src.width == 0 || src.height == 0 || src.channelNum == 0 || src.channelNum > MAX_CHANNEL_NUM ||
+        (src.dataType != TENSOR_DTYPE_UINT8 && src.dataType != TENSOR_DTYPE_FLOAT32) ||
+        (src.rowStride != 0 && src.rowStride < src.width * src.channelNum * GetElementSize(src.dataType))) {
+        LogError << "The input image is invalid, width(" << src.width << "), height(" << src.height << "), channel("
+                 << src.channelNum << "), data type(" << src.dataType << "), row stride(" << src.rowStride << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if ((param.layout != TYPE_NHWC && param.layout != TYPE_NCHW) || GetElementSize(param.dataType) == 0) {
+        LogError << "Only support the NHWC and NCHW layouts and the FLOAT32, FLOAT16, INT8 and UINT8 outputs."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (dstSize < GetOutputSize(src, param)) {
+        LogError << "The output size(" << dstSize << ") is smaller than " << GetOutputSize(src, param) << "."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    NormalizeCoeffs coeffs;
+    APP_ERROR ret = GetCoeffs(src, param, coeffs);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    switch (param.dataType) {
+        case TENSOR_DTYPE_FLOAT32:
+            RunNormalize<float>(src, coeffs, param.layout, dst, threadNum);
+            break;
+        case TENSOR_DTYPE_FLOAT16:
+            RunNormalize<uint16_t>(src, coeffs, param.layout, dst, threadNum);
+            break;
+        case TENSOR_DTYPE_INT8:
+            RunNormalize<int8_t>(src, coeffs, param.layout, dst, threadNum);
+            break;
+        default:
+            RunNormalize<uint8_t>(src, coeffs, param.layout, dst, threadNum);
+            break;
+    }
+    return APP_ERR_OK;
+}
+}
@@ -0,0 +1,743 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Letterbox resize of host images, resampled in place into the padded output.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/CV/Preprocess/LetterboxResizer.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "MxBase/Log/Log.h"
+
+namespace {
+using namespace MxBase;
+
+const uint32_t CHANNEL_NUM = 3;
+const uint32_t UV_ROW_RATIO = 2;
+const uint32_t MIN_BAND_ROWS = 16;
+const uint32_t MAX_THREAD_NUM = 64;
+const uint32_t AREA_FAST_2X2 = 4;
+const int MAX_PIXEL = 255;
+// fixed-point of cv::resize with INTER_LINEAR, the vertical pass drops 4 bits of the rows before the 16 bits
+// multiplication and rounds the last 2 bits, as the vectorized pass of OpenCV
+const int INTER_RESIZE_COEF_BITS = 11;
+const int INTER_RESIZE_COEF_SCALE = 1 << INTER_RESIZE_COEF_BITS;
+const int VERTICAL_ROW_SHIFT = 4;
+const int MUL_HI_SHIFT = 16;
+const int VERTICAL_ROUND_SHIFT = 2;
+const int VERTICAL_ROUND_DELTA = 1 << (VERTICAL_ROUND_SHIFT - 1);
+const double AREA_WEIGHT_EPS = 1e-3;
+// ITU-R BT.601 coefficients of cv::cvtColor, 20 bits fixed-point
+const int YUV_SHIFT = 20;
+const int YUV_CY = 1220542;
+const int YUV_CUB = 2116026;
+const int YUV_CUG = -409993;
+const int YUV_CVG = -852492;
+const int YUV_CVR = 1673527;
+const int YUV_Y_OFFSET = 16;
+const int YUV_UV_OFFSET = 128;
+
+// source index pair and weights of each output index, the second index repeats the first at the last source pixel
+struct LinearTab {
+    std::vector<uint32_t> ofs0;
+    std::vector<uint32_t> ofs1;
+    std::vector<short> fixedCoeffs;
+    std::vector<float> coeffs;
+};
+
+// weights of the source indexes covered by each output index, the entries of index d are [begin[d], begin[d + 1])
+struct AreaTab {
+    std::vector<size_t> begin;
+    std::vector<uint32_t> dst;
+    std::vector<uint32_t> src;
+    std::vector<float> alpha;
+};
+
+template<typename T>
+struct PixelTraits;
+
+template<>
+struct PixelTraits<uint8_t> {
+    using Work = int;
+    static uint8_t Cast(float value)
+    {
+        return static_cast<uint8_t>(std::min(std::max(std::lrint(value), 0L), static_cast<long>(MAX_PIXEL)));
+    }
+};
+
+template<>
+struct PixelTraits<float> {
+    using Work = float;
+    static float Cast(float value)
+    {
+        return value;
+    }
+};
+
+size_t GetElementSize(TensorDataType dataType)
+{
+    switch (dataType) {
+        case TENSOR_DTYPE_UINT8:
+            return sizeof(uint8_t);
+        case TENSOR_DTYPE_FLOAT32:
+            return sizeof(float);
+        default:
+            return 0;
+    }
+}
+
+size_t GetRowStride(const LetterboxImage& src)
+{
+    if (src.rowStride != 0) {
+        return src.rowStride;
+    }
+    return src.format == LetterboxSourceFormat::PACKED_3 ?
+        static_cast<size_t>(src.width) * CHANNEL_NUM * GetElementSize(src.dataType) : src.width;
+}
+
+bool CheckGeometry(const LetterboxGeometry& geometry)
+{
+    return geometry.resizeWidth != 0 && geometry.resizeHeight != 0 &&
+        static_cast<uint64_t>(geometry.left) + geometry.resizeWidth <= geometry.width &&
+        static_cast<uint64_t>(geometry.top) + geometry.resizeHeight <= geometry.height;
+}
+
+// the same coordinates as cv::resize, areaCoeffs for the upscaling of INTER_AREA
+void MakeLinearTab(uint32_t srcSize, uint32_t dstSize, bool areaCoeffs, uint32_t step, LinearTab& tab)
+{
+    const double invScale = static_cast<double>(dstSize) / srcSize;
+    const double scale = 1. / invScale;
+    tab.ofs0.resize(dstSize);
+    tab.ofs1.resize(dstSize);
+    tab.fixedCoeffs.resize(dstSize * 2);
+    tab.coeffs.resize(dstSize * 2);
+    for (uint32_t d = 0; d < dstSize; d++) {
+        int s = 0;
+        float f = 0.f;
+        if (areaCoeffs) {
+            s = static_cast<int>(std::floor(d * scale));
+            f = static_cast<float>((d + 1) - (s + 1) * invScale);
+            f = f <= 0 ? 0.f : f - std::floor(f);
+        } else {
+            f = static_cast<float>((d + 0.5) * scale - 0.5);
+            s = static_cast<int>(std::floor(f));
+            f -= s;
+        }
+        if (s < 0) {
+            s = 0;
+            f = 0.f;
+        }
+        if (s >= static_cast<int>(srcSize) - 1) {
+            s = static_cast<int>(srcSize) - 1;
+            f = 0.f;
+        }
+        tab.ofs0[d] = static_cast<uint32_t>(s) * step;
+        tab.ofs1[d] = std::min(static_cast<uint32_t>(s) + 1, srcSize - 1) * step;
+        tab.coeffs[d * 2] = 1.f - f;
+        tab.coeffs[d * 2 + 1] = f;
+        tab.fixedCoeffs[d * 2] = static_cast<short>(std::lrint((1.f - f) * INTER_RESIZE_COEF_SCALE));
+        tab.fixedCoeffs[d * 2 + 1] = static_cast<short>(std::lrint(f * INTER_RESIZE_COEF_SCALE));
+    }
+}
+
+// the same weights as the downscaling of cv::resize with INTER_AREA
+void MakeAreaTab(uint32_t srcSize, uint32_t dstSize, AreaTab& tab)
+{
+    const double scale = 1. / (static_cast<double>(dstSize) / srcSize);
+    tab.begin.assign(1, 0);
+    for (uint32_t d = 0; d < dstSize; d++) {
+        double fs1 = d * scale;
+        double fs2 = fs1 + scale;
+        double cellWidth = std::min(scale, srcSize - fs1);
+        int s1 = static_cast<int>(std::ceil(fs1));
+        int s2 = std::min(static_cast<int>(std::floor(fs2)), static_cast<int>(srcSize) - 1);
+        s1 = std::min(s1, s2);
+        auto add = [&tab, d](int s, double alpha) {
+            tab.dst.push_back(d);
+            tab.src.push_back(static_cast<uint32_t>(s));
+            tab.alpha.push_back(static_cast<float>(alpha));
+        };
+        if (s1 - fs1 > AREA_WEIGHT_EPS) {
+            add(s1 - 1, (s1 - fs1) / cellWidth);
+        }
+        for (int s = s1; s < s2; s++) {
+            add(s, 1. / cellWidth);
+        }
+        if (fs2 - s2 > AREA_WEIGHT_EPS) {
+            add(s2, std::min(std::min(fs2 - s2, 1.), cellWidth) / cellWidth);
+        }
+        tab.begin.push_back(tab.src.size());
+    }
+}
+
+// integer scale of both edges, as the fast INTER_AREA path of cv::resize
+bool GetIntegerScale(uint32_t srcSize, uint32_t dstSize, uint32_t& scale)
+{
+    double realScale = 1. / (static_cast<double>(dstSize) / srcSize);
+    scale = static_cast<uint32_t>(std::lrint(realScale));
+    return std::fabs(realScale - scale) < DBL_EPSILON;
+}
+
+/**
+ * Rows of the source as packed 3 channel pixels. NV12 and NV21 rows are converted into a held row as cv::cvtColor,
+ * so the rows of a band are only converted when they are sampled.
+ */
+class SourceRows {
+public:
+    SourceRows(const LetterboxImage& src, bool bgrOutput)
+        : src_(src), rowStride_(GetRowStride(src)), bgrOutput_(bgrOutput)
+    {
+        if (src.format != LetterboxSourceFormat::PACKED_3) {
+            converted_.resize(static_cast<size_t>(src.width) * CHANNEL_NUM);
+        }
+    }
+
+    const void* Get(uint32_t row)
+    {
+        if (src_.format == LetterboxSourceFormat::PACKED_3) {
+            return static_cast<const uint8_t*>(src_.data) + row * rowStride_;
+        }
+        ConvertYuv(row, converted_.data());
+        return converted_.data();
+    }
+
+    void CopyTo(uint32_t row, void* out)
+    {
+        if (src_.format == LetterboxSourceFormat::PACKED_3) {
+            std::copy_n(static_cast<const uint8_t*>(src_.data) + row * rowStride_,
+                        static_cast<size_t>(src_.width) * CHANNEL_NUM * GetElementSize(src_.dataType),
+                        static_cast<uint8_t*>(out));
+            return;
+        }
+        ConvertYuv(row, static_cast<uint8_t*>(out));
+    }
+
+private:
+    static uint8_t ClampPixel(int value)
+    {
+        return static_cast<uint8_t>(std::min(std::max(value, 0), MAX_PIXEL));
+    }
+
+    void ConvertYuv(uint32_t row, uint8_t* out) const
+    {
+        const uint8_t* luma = static_cast<const uint8_t*>(src_.data) + row * rowStride_;
+        const uint8_t* chroma = src_.uvData + (row / UV_ROW_RATIO) * rowStride_;
+        const uint32_t uIndex = src_.format == LetterboxSourceFormat::NV12 ? 0 : 1;
+        const uint32_t rIndex = bgrOutput_ ? 2 : 0;
+        for (uint32_t x = 0; x < src_.width; x++, out += CHANNEL_NUM) {
+            const uint8_t* uv = chroma + (x & ~1u);
+            int u = uv[uIndex] - YUV_UV_OFFSET;
+            int v = uv[1 - uIndex] - YUV_UV_OFFSET;
+            int yy = std::max(0, luma[x] - YUV_Y_OFFSET) * YUV_CY + (1 << (YUV_SHIFT - 1));
+            out[rIndex] = ClampPixel((yy + YUV_CVR * v) >> YUV_SHIFT);
+            out[1] = ClampPixel((yy + YUV_CVG * v + YUV_CUG * u) >> YUV_SHIFT);
+            out[2 - rIndex] = ClampPixel((yy + YUV_CUB * u) >> YUV_SHIFT);
+        }
+    }
+
+    const LetterboxImage& src_;
+    size_t rowStride_;
+    bool bgrOutput_;
+    std::vector<uint8_t> converted_;
+};
+
+template<typename T>
+class Target {
+public:
+    Target(const LetterboxParam& param, T* dst) : geometry_(param.geometry), dst_(dst)
+    {
+        for (uint32_t c = 0; c < CHANNEL_NUM; c++) {
+            pad_[c] = PixelTraits<T>::Cast(param.padValue[c]);
+        }
+    }
+
+    // first pixel of row y of the resized area
+    T* Row(uint32_t y) const
+    {
+        return dst_ + (static_cast<size_t>(geometry_.top + y) * geometry_.width + geometry_.left) * CHANNEL_NUM;
+    }
+
+    void FillPixels(T* out, size_t num) const
+    {
+        for (size_t i = 0; i < num; i++, out += CHANNEL_NUM) {
+            std::copy_n(pad_, CHANNEL_NUM, out);
+        }
+    }
+
+    void FillSides(uint32_t y) const
+    {
+        T* row = Row(y);
+        FillPixels(row - static_cast<size_t>(geometry_.left) * CHANNEL_NUM, geometry_.left);
+        FillPixels(row + static_cast<size_t>(geometry_.resizeWidth) * CHANNEL_NUM,
+                   geometry_.width - geometry_.left - geometry_.resizeWidth);
+    }
+
+    // the rows above and below the resized area, the first one is filled and copied to the others
+    void FillRows() const
+    {
+        const size_t rowLen = static_cast<size_t>(geometry_.width) * CHANNEL_NUM;
+        const T* filled = nullptr;
+        auto fill = [this, rowLen, &filled](uint32_t rowBegin, uint32_t rowEnd) {
+            for (uint32_t y = rowBegin; y < rowEnd; y++) {
+                T* row = dst_ + y * rowLen;
+                if (filled == nullptr) {
+                    FillPixels(row, geometry_.width);
+                    filled = row;
+                } else {
+                    std::copy_n(filled, rowLen, row);
+                }
+            }
+        };
+        fill(0, geometry_.top);
+        fill(geometry_.top + geometry_.resizeHeight, geometry_.height);
+    }
+
+    const LetterboxGeometry& Geometry() const
+    {
+        return geometry_;
+    }
+
+private:
+    LetterboxGeometry geometry_;
+    T* dst_;
+    T pad_[CHANNEL_NUM] = {};
+};
+
+void HResize(const uint8_t* src, const LinearTab& tab, uint32_t width, int* dst)
+{
+    for (uint32_t x = 0; x < width; x++, dst += CHANNEL_NUM) {
+        const uint8_t* s0 = src + tab.ofs0[x];
+        const uint8_t* s1 = src + tab.ofs1[x];
+        int a0 = tab.fixedCoeffs[x * 2];
+        int a1 = tab.fixedCoeffs[x * 2 + 1];
+        dst[0] = s0[0] * a0 + s1[0] * a1;
+        dst[1] = s0[1] * a0 + s1[1] * a1;
+        dst[2] = s0[2] * a0 + s1[2] * a1;
+    }
+}
+
+void HResize(const float* src, const LinearTab& tab, uint32_t width, float* dst)
+{
+    for (uint32_t x = 0; x < width; x++, dst += CHANNEL_NUM) {
+        const float* s0 = src + tab.ofs0[x];
+        const float* s1 = src + tab.ofs1[x];
+        float a0 = tab.coeffs[x * 2];
+        float a1 = tab.coeffs[x * 2 + 1];
+        dst[0] = s0[0] * a0 + s1[0] * a1;
+        dst[1] = s0[1] * a0 + s1[1] * a1;
+        dst[2] = s0[2] * a0 + s1[2] * a1;
+    }
+}
+
+void VResize(const int* s0, const int* s1, const LinearTab& tab, uint32_t y, size_t num, uint8_t* dst)
+{
+    const int b0 = tab.fixedCoeffs[y * 2];
+    const int b1 = tab.fixedCoeffs[y * 2 + 1];
+    size_t i = 0;
+#if defined(__aarch64__)
+    const int16x8_t vb0 = vdupq_n_s16(static_cast<int16_t>(b0));
+    const int16x8_t vb1 = vdupq_n_s16(static_cast<int16_t>(b1));
+    for (; i + 8 <= num; i += 8) {
+        int16x8_t r0 = vcombine_s16(vmovn_s32(vshrq_n_s32(vld1q_s32(s0 + i), VERTICAL_ROW_SHIFT)),
+                                    vmovn_s32(vshrq_n_s32(vld1q_s32(s0 + i + 4), VERTICAL_ROW_SHIFT)));
+        int16x8_t r1 = vcombine_s16(vmovn_s32(vshrq_n_s32(vld1q_s32(s1 + i), VERTICAL_ROW_SHIFT)),
+                                    vmovn_s32(vshrq_n_s32(vld1q_s32(s1 + i + 4), VERTICAL_ROW_SHIFT)));
+        int16x8_t h0 = vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(r0), vget_low_s16(vb0)), MUL_HI_SHIFT),
+                                    vshrn_n_s32(vmull_high_s16(r0, vb0), MUL_HI_SHIFT));
+        int16x8_t h1 = vcombine_s16(vshrn_n_s32(vmull_s16(vget_low_s16(r1), vget_low_s16(vb1)), MUL_HI_SHIFT),
+                                    vshrn_n_s32(vmull_high_s16(r1, vb1), MUL_HI_SHIFT));
+        vst1_u8(dst + i, vqrshrun_n_s16(vaddq_s16(h0, h1), VERTICAL_ROUND_SHIFT));
+    }
+#elif defined(__SSE2__)
+    const __m128i vb0 = _mm_set1_epi16(static_cast<short>(b0));
+    const __m128i vb1 = _mm_set1_epi16(static_cast<short>(b1));
+    const __m128i delta = _mm_set1_epi16(VERTICAL_ROUND_DELTA);
+    for (; i + 8 <= num; i += 8) {
+        __m128i r0 = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s0 + i)), VERTICAL_ROW_SHIFT),
+            _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s0 + i + 4)), VERTICAL_ROW_SHIFT));
+        __m128i r1 = _mm_packs_epi32(
+            _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i)), VERTICAL_ROW_SHIFT),
+            _mm_srai_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i + 4)), VERTICAL_ROW_SHIFT));
+        __m128i sum = _mm_add_epi16(_mm_mulhi_epi16(r0, vb0), _mm_mulhi_epi16(r1, vb1));
+        sum = _mm_srai_epi16(_mm_add_epi16(sum, delta), VERTICAL_ROUND_SHIFT);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(sum, sum));
+    }
+#endif
+    for (; i < num; i++) {
+        int value = (((s0[i] >> VERTICAL_ROW_SHIFT) * b0) >> MUL_HI_SHIFT) +
+            (((s1[i] >> VERTICAL_ROW_SHIFT) * b1) >> MUL_HI_SHIFT);
+        dst[i] = static_cast<uint8_t>(std::min(std::max((value + VERTICAL_ROUND_DELTA) >> VERTICAL_ROUND_SHIFT, 0),
+                                               MAX_PIXEL));
+    }
+}
+
+void VResize(const float* s0, const float* s1, const LinearTab& tab, uint32_t y, size_t num, float* dst)
+{
+    const float b0 = tab.coeffs[y * 2];
+    const float b1 = tab.coeffs[y * 2 + 1];
+    for (size_t i = 0; i < num; i++) {
+        dst[i] = s0[i] * b0 + s1[i] * b1;
+    }
+}
+
+template<typename T>
+void CopyBand(SourceRows& rows, const Target<T>& target, uint32_t rowBegin, uint32_t rowEnd)
+{
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        target.FillSides(y);
+        rows.CopyTo(y, target.Row(y));
+    }
+}
+
+template<typename T>
+void NearestBand(SourceRows& rows, const Target<T>& target, const std::vector<uint32_t>& xOfs, uint32_t srcHeight,
+                 uint32_t rowBegin, uint32_t rowEnd)
+{
+    const LetterboxGeometry& geometry = target.Geometry();
+    const double yScale = 1. / (static_cast<double>(geometry.resizeHeight) / srcHeight);
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        target.FillSides(y);
+        uint32_t sy = std::min(static_cast<uint32_t>(std::floor(y * yScale)), srcHeight - 1);
+        const T* src = static_cast<const T*>(rows.Get(sy));
+        T* out = target.Row(y);
+        for (uint32_t x = 0; x < geometry.resizeWidth; x++, out += CHANNEL_NUM) {
+            std::copy_n(src + xOfs[x], CHANNEL_NUM, out);
+        }
+    }
+}
+
+/**
+ * Each source row is resampled horizontally once into one of two held rows, the output row is the vertical blend
+ * of the held rows of its two source rows.
+ */
+template<typename T>
+void BilinearBand(SourceRows& rows, const Target<T>& target, const LinearTab& xTab, const LinearTab& yTab,
+                  uint32_t rowBegin, uint32_t rowEnd)
+{
+    using Work = typename PixelTraits<T>::Work;
+    const uint32_t width = target.Geometry().resizeWidth;
+    const size_t rowLen = static_cast<size_t>(width) * CHANNEL_NUM;
+    std::vector<Work> held[2] = {std::vector<Work>(rowLen), std::vector<Work>(rowLen)};
+    int64_t heldRow[2] = {-1, -1};
+    auto fetch = [&](uint32_t row, uint32_t keepRow) -> const Work* {
+        for (size_t i = 0; i < 2; i++) {
+            if (heldRow[i] == row) {
+                return held[i].data();
+            }
+        }
+        size_t slot = heldRow[0] == keepRow ? 1 : 0;
+        HResize(static_cast<const T*>(rows.Get(row)), xTab, width, held[slot].data());
+        heldRow[slot] = row;
+        return held[slot].data();
+    };
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        target.FillSides(y);
+        const Work* s0 = fetch(yTab.ofs0[y], yTab.ofs1[y]);
+        const Work* s1 = fetch(yTab.ofs1[y], yTab.ofs0[y]);
+        VResize(s0, s1, yTab, y, rowLen, target.Row(y));
+    }
+}
+
+// block average of integer scales, the 2x2 blocks of uint8 are rounded half up as the fast path of cv::resize
+inline uint8_t CastAverage(int sum, uint32_t area, float scale)
+{
+    return area == AREA_FAST_2X2 ? static_cast<uint8_t>((sum + 2) >> 2) : PixelTraits<uint8_t>::Cast(sum * scale);
+}
+
+inline float CastAverage(float sum, uint32_t, float scale)
+{
+    return sum * scale;
+}
+
+template<typename T>
+void AreaFastBand(SourceRows& rows, const Target<T>& target, uint32_t xScale, uint32_t yScale, uint32_t rowBegin,
+                  uint32_t rowEnd)
+{
+    using Work = typename PixelTraits<T>::Work;
+    const uint32_t width = target.Geometry().resizeWidth;
+    const uint32_t area = xScale * yScale;
+    const float scale = 1.f / area;
+    std::vector<Work> sum(static_cast<size_t>(width) * CHANNEL_NUM);
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        target.FillSides(y);
+        std::fill(sum.begin(), sum.end(), Work(0));
+        for (uint32_t j = 0; j < yScale; j++) {
+            const T* src = static_cast<const T*>(rows.Get(y * yScale + j));
+            Work* acc = sum.data();
+            for (uint32_t x = 0; x < width; x++, acc += CHANNEL_NUM) {
+                const T* block = src + static_cast<size_t>(x) * xScale * CHANNEL_NUM;
+                for (uint32_t i = 0; i < xScale * CHANNEL_NUM; i += CHANNEL_NUM) {
+                    acc[0] += block[i];
+                    acc[1] += block[i + 1];
+                    acc[2] += block[i + 2];
+                }
+            }
+        }
+        T* out = target.Row(y);
+        for (size_t i = 0; i < sum.size(); i++) {
+            out[i] = CastAverage(sum[i], area, scale);
+        }
+    }
+}
+
+template<typename T>
+void AreaBand(SourceRows& rows, const Target<T>& target, const AreaTab& xTab, const AreaTab& yTab,
+              uint32_t rowBegin, uint32_t rowEnd)
+{
+    const size_t rowLen = static_cast<size_t>(target.Geometry().resizeWidth) * CHANNEL_NUM;
+    std::vector<float> rowSum(rowLen);
+    std::vector<float> sum(rowLen);
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        target.FillSides(y);
+        std::fill(sum.begin(), sum.end(), 0.f);
+        for (size_t k = yTab.begin[y]; k < yTab.begin[y + 1]; k++) {
+            const T* src = static_cast<const T*>(rows.Get(yTab.src[k]));
+            std::fill(rowSum.begin(), rowSum.end(), 0.f);
+            for (size_t j = 0; j < xTab.src.size(); j++) {
+                float* acc = rowSum.data() + static_cast<size_t>(xTab.dst[j]) * CHANNEL_NUM;
+                const T* pixel = src + static_cast<size_t>(xTab.src[j]) * CHANNEL_NUM;
+                acc[0] += xTab.alpha[j] * pixel[0];
+                acc[1] += xTab.alpha[j] * pixel[1];
+                acc[2] += xTab.alpha[j] * pixel[2];
+            }
+            for (size_t i = 0; i < rowLen; i++) {
+                sum[i] += yTab.alpha[k] * rowSum[i];
+            }
+        }
+        T* out = target.Row(y);
+        for (size_t i = 0; i < rowLen; i++) {
+            out[i] = PixelTraits<T>::Cast(sum[i]);
+        }
+    }
+}
+
+/**
+ * Splits the rows into at most threadNum bands of at least MIN_BAND_ROWS rows, the calling thread takes the first.
+ */
+void RunInBands(uint32_t height, uint32_t threadNum, const std::function<void(uint32_t, uint32_t)>& func)
+{
+    uint32_t bandNum = std::max(1u, std::min({threadNum, MAX_THREAD_NUM, height / MIN_BAND_ROWS}));
+    uint32_t bandRows = (height + bandNum - 1) / bandNum;
+    std::vector<std::thread> threads;
+    uint32_t begin = bandRows;
+    for (; begin < height; begin += bandRows) {
+        try {
+            threads.emplace_back(func, begin, std::min(height, begin + bandRows));
+        } catch (const std::system_error&) {
+            LogWarn << "Create band thread failed, the bands left run in the calling thread.";
+            break;
+        }
+    }
+    func(0, std::min(height, bandRows));
+    for (; begin < height; begin += bandRows) {
+        func(begin, std::min(height, begin + bandRows));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+APP_ERROR CheckOutput(const LetterboxGeometry& geometry, TensorDataType dataType, const void* dst, size_t dstSize)
+{
+    if (dst == nullptr) {
+        LogError << "The output of the letterbox resize is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (!CheckGeometry(geometry) || GetElementSize(dataType) == 0) {
+        LogError << "The letterbox geometry is invalid, resized size(" << geometry.resizeWidth << ", "
+                 << geometry.resizeHeight << ") at (" << geometry.left << ", " << geometry.top << ") of ("
+                 << geometry.width << ", " << geometry.height << "), data type(" << dataType << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (dstSize < LetterboxResizer::GetOutputSize(dataType, geometry)) {
+        LogError << "The output size(" << dstSize << ") is smaller than "
+                 << LetterboxResizer::GetOutputSize(dataType, geometry) << "."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    return APP_ERR_OK;
+}
+
+template<typename T>
+void FillTarget(const LetterboxParam& param, T* dst)
+{
+    const Target<T> target(param, dst);
+    target.FillRows();
+    for (uint32_t y = 0; y < param.geometry.resizeHeight; y++) {
+        target.FillSides(y);
+    }
+}
+
+template<typename T>
+void RunResize(const LetterboxImage& src, const LetterboxParam& param, T* dst, uint32_t threadNum)
+{
+    const Target<T> target(param, dst);
+    target.FillRows();
+    const uint32_t width = param.geometry.resizeWidth;
+    const uint32_t height = param.geometry.resizeHeight;
+    auto run = [&src, &param, threadNum, height](const std::function<void(SourceRows&, uint32_t, uint32_t)>& band) {
+        RunInBands(height, threadNum, [&src, &param, &band](uint32_t rowBegin, uint32_t rowEnd) {
+            SourceRows rows(src, param.bgrOutput);
+            band(rows, rowBegin, rowEnd);
+        });
+    };
+    if (width == src.width && height == src.height) {
+        run([&target](SourceRows& rows, uint32_t begin, uint32_t end) { CopyBand(rows, target, begin, end); });
+        return;
+    }
+    if (param.interpolation == LetterboxInterpolation::NEAREST) {
+        const double xScale = 1. / (static_cast<double>(width) / src.width);
+        std::vector<uint32_t> xOfs(width);
+        for (uint32_t x = 0; x < width; x++) {
+            xOfs[x] = std::min(static_cast<uint32_t>(std::floor(x * xScale)), src.width - 1) * CHANNEL_NUM;
+        }
+        run([&target, &xOfs, &src](SourceRows& rows, uint32_t begin, uint32_t end) {
+            NearestBand(rows, target, xOfs, src.height, begin, end);
+        });
+        return;
+    }
+    uint32_t xScale = 0;
+    uint32_t yScale = 0;
+    const bool integerScale = GetIntegerScale(src.width, width, xScale) && GetIntegerScale(src.height, height, yScale);
+    const bool downscale = src.width >= width && src.height >= height;
+    // cv::resize takes the halving with INTER_LINEAR as INTER_AREA
+    const bool halving = integerScale && xScale == 2 && yScale == 2;
+    if ((param.interpolation == LetterboxInterpolation::AREA && downscale && integerScale) || halving) {
+        run([&target, xScale, yScale](SourceRows& rows, uint32_t begin, uint32_t end) {
+            AreaFastBand(rows, target, xScale, yScale, begin, end);
+        });
+        return;
+    }
+    if (param.interpolation == LetterboxInterpolation::AREA && downscale) {
+        AreaTab xTab;
+        AreaTab yTab;
+        MakeAreaTab(src.width, width, xTab);
+        MakeAreaTab(src.height, height, yTab);
+        run([&target, &xTab, &yTab](SourceRows& rows, uint32_t begin, uint32_t end) {
+            AreaBand(rows, target, xTab, yTab, begin, end);
+        });
+        return;
+    }
+    const bool areaCoeffs = param.interpolation == LetterboxInterpolation::AREA;
+    LinearTab xTab;
+    LinearTab yTab;
+    MakeLinearTab(src.width, width, areaCoeffs, CHANNEL_NUM, xTab);
+    MakeLinearTab(src.height, height, areaCoeffs, 1, yTab);
+    run([&target, &xTab, &yTab](SourceRows& rows, uint32_t begin, uint32_t end) {
+        BilinearBand(rows, target, xTab, yTab, begin, end);
+    });
+}
+}
+
+namespace MxBase {
+APP_ERROR LetterboxResizer::MakeGeometry(uint32_t resizeWidth, uint32_t resizeHeight, uint32_t paddingWidth,
+                                         uint32_t paddingHeight, LetterboxPadding padding,
+                                         LetterboxGeometry& geometry)
+{
+    if (resizeWidth == 0 || resizeHeight == 0) {
+        LogError << "The resized size(" << resizeWidth << ", " << resizeHeight << ") must not be zero."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    geometry.resizeWidth = resizeWidth;
+    geometry.resizeHeight = resizeHeight;
+    geometry.left = 0;
+    geometry.top = 0;
+    if (padding == LetterboxPadding::NONE) {
+        geometry.width = resizeWidth;
+        geometry.height = resizeHeight;
+        return APP_ERR_OK;
+    }
+    if (resizeWidth > paddingWidth || resizeHeight > paddingHeight) {
+        LogError << "The resized size(" << resizeWidth << ", " << resizeHeight << ") is bigger than the padding size("
+                 << paddingWidth << ", " << paddingHeight << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (padding == LetterboxPadding::AROUND) {
+        geometry.left = (paddingWidth - resizeWidth) / 2;
+        geometry.top = (paddingHeight - resizeHeight) / 2;
+    }
+    geometry.width = paddingWidth;
+    geometry.height = paddingHeight;
+    return APP_ERR_OK;
+}
+
+size_t LetterboxResizer::GetOutputSize(TensorDataType dataType, const LetterboxGeometry& geometry)
+{
+    return static_cast<size_t>(geometry.width) * geometry.height * CHANNEL_NUM * GetElementSize(dataType);
+}
+
+APP_ERROR LetterboxResizer::Resize(const LetterboxImage& src, const LetterboxParam& param, void* dst, size_t dstSize,
+                                   uint32_t threadNum)
+{
+    const bool packed = src.format == LetterboxSourceFormat::PACKED_3;
+    if (src.data == nullptr || (!packed && src.uvData == nullptr)) {
+        LogError << "The input of the letterbox resize is nullptr."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    const size_t minRowStride = packed ? static_cast<size_t>(src.width) * CHANNEL_NUM * GetElementSize(src.dataType) :
+        src.width;
+    if (src.width == 0 || src.height == 0 || GetElementSize(src.dataType) == 0 ||
+        (!packed && src.dataType != TENSOR_DTYPE_UINT8) || (src.rowStride != 0 && src.rowStride < minRowStride)) {
+        LogError << "The input image is invalid, width(" << src.width << "), height(" << src.height << "), format("
+                 << static_cast<int>(src.format) << "), data type(" << src.dataType << "), row stride("
+                 << src.rowStride << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    APP_ERROR ret = CheckOutput(param.geometry, src.dataType, dst, dstSize);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    if (src.dataType == TENSOR_DTYPE_FLOAT32) {
+        RunResize(src, param, static_cast<float*>(dst), threadNum);
+    } else {
+        RunResize(src, param, static_cast<uint8_t*>(dst), threadNum);
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR LetterboxResizer::FillBorder(const LetterboxParam& param, TensorDataType dataType, void* dst,
+                                       size_t dstSize)
+{
+    APP_ERROR ret = CheckOutput(param.geometry, dataType, dst, dstSize);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    if (dataType == TENSOR_DTYPE_FLOAT32) {
+        FillTarget(param, static_cast<float*>(dst));
+    } else {
+        FillTarget(param, static_cast<uint8_t*>(dst));
+    }
+    return APP_ERR_OK;
+}
+}
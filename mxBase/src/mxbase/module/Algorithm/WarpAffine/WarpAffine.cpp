@@ -20,6 +20,9 @@
  * History: NA
  */
 
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include "acl/acl.h"
 #include "MxBase/Log/Log.h"
 #include "MxBase/CV/WarpAffine/SimilarityTransform.h"
@@ -27,8 +30,6 @@
 #include "MxBase/CV/WarpAffine/WarpAffine.h"
 
 namespace {
-const uint32_t YUV_BYTES_NU = 3;      // Numerator of yuv image, H x W x 3 / 2
-const uint32_t YUV_BYTES_DE = 2;      // Denominator of yuv image, H x W x 3 / 2
 const float HEIGHT_WEIGHT = 0.05f;
 const float WIDTH_WEIGHT = 1.2f;
 const float FACE_OBJECT_WEIGHT = 1.3f;
@@ -36,10 +37,77 @@ const int KPAFTER_WEIGHT = 112;
 const float KPAFTER_OFFSET = 8.0f;
 const uint32_t LANDMARK_PAIR_LEN = 2;
 const uint32_t BGR_CHANNEL_NUM = 3;
-const uint32_t IMAGE_NV12_FORMAT = 3;
-const uint32_t AFFINE_LEN = 10;
+const uint32_t UV_ROW_RATIO = 2;
 const int MAX_EDGE = 8192;
 const int MIN_EDGE = 32;
+// fixed-point of cv::warpAffine with INTER_LINEAR
+const int AB_BITS = 10;
+const int AB_SCALE = 1 << AB_BITS;
+const int INTER_BITS = 5;
+const int INTER_TAB_SIZE = 1 << INTER_BITS;
+const int INTER_MASK = INTER_TAB_SIZE - 1;
+const int ROUND_DELTA = AB_SCALE / INTER_TAB_SIZE / 2;
+const int WEIGHT_BITS = INTER_BITS * 2;
+// ITU-R BT.601 coefficients of cv::cvtColor, 20 bits fixed-point
+const int YUV_SHIFT = 20;
+const int YUV_CY = 1220542;
+const int YUV_CUB = 2116026;
+const int YUV_CUG = -409993;
+const int YUV_CVG = -852492;
+const int YUV_CVR = 1673527;
+const int YUV_Y_OFFSET = 16;
+const int YUV_UV_OFFSET = 128;
+const int MAX_PIXEL = 255;
+// source rows kept around the mapped output for the interpolation and the rounding of the transform
+const int SOURCE_ROW_MARGIN = 2;
+
+inline int RoundToInt(double value)
+{
+    return static_cast<int>(std::lrint(std::min(std::max(value, static_cast<double>(INT_MIN)),
+                                                static_cast<double>(INT_MAX))));
+}
+
+inline int ClampPixel(int value)
+{
+    return std::min(std::max(value, 0), MAX_PIXEL);
+}
+
+// inverse of a 2x3 transform, as cv::invertAffineTransform
+void InvertAffine(const double matrix[], double inverse[])
+{
+    double det = matrix[0] * matrix[4] - matrix[1] * matrix[3];
+    det = det != 0 ? 1. / det : 0.;
+    double a11 = matrix[4] * det;
+    double a22 = matrix[0] * det;
+    double a12 = -matrix[1] * det;
+    double a21 = -matrix[3] * det;
+    inverse[0] = a11;
+    inverse[1] = a12;
+    inverse[2] = -a11 * matrix[2] - a12 * matrix[5];
+    inverse[3] = a21;
+    inverse[4] = a22;
+    inverse[5] = -a21 * matrix[2] - a22 * matrix[5];
+}
+
+// BGR of a source pixel, zero out of the held rows as the constant border of cv::warpAffine
+inline void SamplePixel(const MxBase::Nv12HostPlanes &src, int x, int y, int bgr[])
+{
+    if (x < 0 || y < 0 || x >= static_cast<int>(src.width) || y < static_cast<int>(src.top) ||
+        y >= static_cast<int>(src.top + src.rows)) {
+        bgr[0] = bgr[1] = bgr[2] = 0;
+        return;
+    }
+    int row = y - static_cast<int>(src.top);
+    int luma = src.yPlane[static_cast<size_t>(row) * src.stride + x];
+    const uint8_t *uv = src.uvPlane + static_cast<size_t>(row / static_cast<int>(UV_ROW_RATIO)) * src.stride +
+        (x & ~1);
+    int u = uv[0] - YUV_UV_OFFSET;
+    int v = uv[1] - YUV_UV_OFFSET;
+    int yy = std::max(0, luma - YUV_Y_OFFSET) * YUV_CY + (1 << (YUV_SHIFT - 1));
+    bgr[0] = ClampPixel((yy + YUV_CUB * u) >> YUV_SHIFT);
+    bgr[1] = ClampPixel((yy + YUV_CVG * v + YUV_CUG * u) >> YUV_SHIFT);
+    bgr[2] = ClampPixel((yy + YUV_CVR * v) >> YUV_SHIFT);
+}
 }
 
 namespace MxBase {
@@ -50,7 +118,6 @@ WarpAffine::~WarpAffine() {}
  * @description: Processing function of warp affine operation
  * @param: warpAffineDataInfoInputVec: vector of face pictures information before warp affine
  *         warpAffineDataInfoOutputVec: vector of face pictures information after warp affine
- *         faceObjectDataInfoVec: vector of faces information
  *         keyPointInfoVec: vector of key points of faces information
  *         picHeight: height of the picture
  *         picWidth: width of the picture
@@ -72,49 +139,96 @@ APP_ERROR WarpAffine::Process(std::vector<DvppDataInfo> &warpAffineDataInfoInput
         LogError << "Input and Output information not matched." << GetErrorInfo(APP_ERR_COMM_FAILURE) ;
         return APP_ERR_COMM_FAILURE;
     }
+    std::vector<FaceWarpTask> tasks(warpAffineDataInfoInputVec.size());
+    size_t hostSize = 0;
     for (size_t i = 0; i < warpAffineDataInfoInputVec.size(); i++) {
         if (warpAffineDataInfoInputVec[i].data == nullptr) {
             LogError << "Failed to get the input picture." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER) ;
             return APP_ERR_COMM_INVALID_POINTER;
         }
-        APP_ERROR ret = ApplyWarpAffine(warpAffineDataInfoInputVec[i], warpAffineDataInfoOutputVec[i],
-                                        keyPointInfoVec[i]);
+        APP_ERROR ret = PrepareFaceWarp(warpAffineDataInfoInputVec[i], keyPointInfoVec[i], tasks[i]);
         if (ret != APP_ERR_OK) {
             LogError << "Apply WarpAffine error." << GetErrorInfo(ret);
             return ret;
         }
+        tasks[i].hostOffset = hostSize;
+        hostSize += tasks[i].ySize + tasks[i].uvSize;
+    }
+    APP_ERROR ret = CopySourceRows(warpAffineDataInfoInputVec, tasks, hostSize);
+    if (ret != APP_ERR_OK) {
+        LogError << "Get crop image failed." << GetErrorInfo(ret);
+        return ret;
+    }
+    size_t imageSize = static_cast<size_t>(picWidth_) * static_cast<size_t>(picHeight_) * BGR_CHANNEL_NUM;
+    try {
+        hostBgr_.resize(imageSize * tasks.size());
+    } catch (const std::bad_alloc&) {
+        LogError << "Failed to allocate the aligned pictures." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    for (size_t i = 0; i < tasks.size(); i++) {
+        ret = WarpNv12ToBgr(tasks[i].planes, tasks[i].matrix, hostBgr_.data() + i * imageSize, picWidth_,
+                            picHeight_);
+        if (ret != APP_ERR_OK) {
+            LogError << "Apply WarpAffine error." << GetErrorInfo(ret);
+            return ret;
+        }
+        ret = SetWarpImage(warpAffineDataInfoOutputVec[i], hostBgr_.data() + i * imageSize);
+        if (ret != APP_ERR_OK) {
+            LogError << "Set warp image failed." << GetErrorInfo(ret);
+            return ret;
+        }
     }
     return APP_ERR_OK;
 }
 
 /**
- * @description: Perform warp affine operations
+ * @description: Compute the transform of a face and the source rows it maps to. The geometry of the input is taken
+ * from the input itself, picture and stride, or is the output size when it is not set.
  * @param: warpAffineDataInfoInput: picture information before warp affine
- *         warpAffineDataInfoOutput: picture information after warp affine
  *         keyPointInfo: save key points of face information
+ *         task: transform and source rows of the face
  * @return: APP_ERROR
  */
-APP_ERROR WarpAffine::ApplyWarpAffine(DvppDataInfo &warpAffineDataInfoInput,
-                                      DvppDataInfo &warpAffineDataInfoOutput,
-                                      KeyPointInfo &keyPointInfo)
+APP_ERROR WarpAffine::PrepareFaceWarp(const DvppDataInfo &warpAffineDataInfoInput, KeyPointInfo &keyPointInfo,
+                                      FaceWarpTask &task)
 {
+    uint32_t width = warpAffineDataInfoInput.width != 0 ? warpAffineDataInfoInput.width :
+        static_cast<uint32_t>(picWidth_);
+    uint32_t height = warpAffineDataInfoInput.height != 0 ? warpAffineDataInfoInput.height :
+        static_cast<uint32_t>(picHeight_);
+    uint32_t stride = std::max(warpAffineDataInfoInput.widthStride, width);
+    uint32_t heightStride = std::max(warpAffineDataInfoInput.heightStride, height);
+    uint64_t uvOffset = static_cast<uint64_t>(stride) * heightStride;
+    if (width > MAX_EDGE || height > MAX_EDGE ||
+        uvOffset + static_cast<uint64_t>(stride) * ((height + 1) / UV_ROW_RATIO) > warpAffineDataInfoInput.dataSize) {
+        LogError << "The input picture(" << width << "x" << height << ", stride " << stride << "x" << heightStride
+                 << ") does not match its data size(" << warpAffineDataInfoInput.dataSize << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
     std::vector<cv::Point2f> srcPoints = {};
     std::vector<cv::Point2f> destPoints = {};
     GetSrcLandmark(srcPoints);
-    GetDstLandmark(destPoints, keyPointInfo.kPBefore);
-    cv::Mat imageN12;
-    cv::Mat warpDst;
-    APP_ERROR ret = GetCropImage(warpAffineDataInfoInput, imageN12);
-    if (ret != APP_ERR_OK) {
-        LogError << "Get crop image failed." << GetErrorInfo(ret);
-        return ret;
-    }
-    CalWarpImage(srcPoints, destPoints, warpDst, imageN12);
-    ret = SetWarpImage(warpAffineDataInfoOutput, warpDst);
-    if (ret != APP_ERR_OK) {
-        LogError << "Set warp image failed." << GetErrorInfo(ret);
-        return ret;
+    GetDstLandmark(destPoints, keyPointInfo.kPBefore, width, height);
+    cv::Mat warpMat = SimilarityTransform().Transform(destPoints, srcPoints);
+    if (warpMat.rows != 2 || warpMat.cols != 3) {
+        LogError << "Failed to calculate the transform of the face." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
     }
+    cv::Mat matrix;
+    warpMat.convertTo(matrix, CV_64F);
+    std::copy(matrix.ptr<double>(0), matrix.ptr<double>(0) + AFFINE_MATRIX_LEN, task.matrix);
+
+    Nv12HostPlanes &planes = task.planes;
+    planes.width = width;
+    planes.height = height;
+    planes.stride = stride;
+    GetSourceRows(task.matrix, height, static_cast<uint32_t>(picWidth_), static_cast<uint32_t>(picHeight_),
+                  planes.top, planes.rows);
+    task.ySize = static_cast<size_t>(planes.rows) * stride;
+    task.uvSize = static_cast<size_t>((planes.rows + 1) / UV_ROW_RATIO) * stride;
+    task.uvOffset = static_cast<size_t>(uvOffset) + static_cast<size_t>(planes.top / UV_ROW_RATIO) * stride;
     return APP_ERR_OK;
 }
 
@@ -144,97 +258,207 @@ void WarpAffine::GetSrcLandmark(std::vector<cv::Point2f> &points)
 }
 
 /**
- * @description: Relative transformation of key points coordinates, from 96*96 to 112*112
+ * @description: Relative transformation of key points coordinates, from 96*96 to the input picture
  * @param: points: key points information of relative coordinate transformation
  *         kPBefore: save key points of face information
+ *         width: width of the input picture
+ *         height: height of the input picture
  * @return: void
  */
-void WarpAffine::GetDstLandmark(std::vector<cv::Point2f> &points, float kPBefore[])
+void WarpAffine::GetDstLandmark(std::vector<cv::Point2f> &points, float kPBefore[], uint32_t width, uint32_t height)
 {
     for (uint32_t i = 0; i < LANDMARK_LEN / LANDMARK_PAIR_LEN; i++) {
         float x = ((HEIGHT_WEIGHT + WIDTH_WEIGHT * kPBefore[i * LANDMARK_PAIR_LEN]) /
-            FACE_OBJECT_WEIGHT) * picWidth_;
+            FACE_OBJECT_WEIGHT) * width;
         float y = ((HEIGHT_WEIGHT + WIDTH_WEIGHT  * kPBefore[i * LANDMARK_PAIR_LEN + 1]) /
-            FACE_OBJECT_WEIGHT) * picHeight_;
+            FACE_OBJECT_WEIGHT) * height;
         points.push_back(cv::Point2f(x, y));
     }
 }
 
 /**
- * @description: Crop the input picture
- * @param: warpAffineDataInfoInput: picture information before warp affine
- *         image: image after format processing
+ * @description: Rows of the source picture the output pixels map to
+ * @param: matrix: transform from the source to the output
+ *         srcHeight: height of the source picture
+ *         dstWidth, dstHeight: size of the output picture
+ *         top: first row, even
+ *         rows: number of rows, 0 when the output maps out of the picture
+ * @return: void
+ */
+void WarpAffine::GetSourceRows(const double matrix[AFFINE_MATRIX_LEN], uint32_t srcHeight, uint32_t dstWidth,
+                               uint32_t dstHeight, uint32_t &top, uint32_t &rows)
+{
+    top = 0;
+    rows = 0;
+    if (srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+        return;
+    }
+    double inverse[AFFINE_MATRIX_LEN];
+    InvertAffine(matrix, inverse);
+    // the mapping is affine, so the rows of the output corners bound the rows of every output pixel
+    const double cornerX[] = {0., static_cast<double>(dstWidth - 1)};
+    const double cornerY[] = {0., static_cast<double>(dstHeight - 1)};
+    double minY = HUGE_VAL;
+    double maxY = -HUGE_VAL;
+    for (double x : cornerX) {
+        for (double y : cornerY) {
+            double sy = inverse[3] * x + inverse[4] * y + inverse[5];
+            minY = std::min(minY, sy);
+            maxY = std::max(maxY, sy);
+        }
+    }
+    if (!std::isfinite(minY) || !std::isfinite(maxY)) {
+        top = 0;
+        rows = srcHeight;
+        return;
+    }
+    double first = std::max(std::floor(minY) - SOURCE_ROW_MARGIN, 0.);
+    double last = std::min(std::ceil(maxY) + SOURCE_ROW_MARGIN, static_cast<double>(srcHeight - 1));
+    if (first > last) {
+        return;
+    }
+    top = static_cast<uint32_t>(first) & ~1u;
+    rows = static_cast<uint32_t>(last) + 1 - top;
+}
+
+/**
+ * @description: Copy the source rows of every face into one host buffer
+ * @param: warpAffineDataInfoInputVec: vector of face pictures information before warp affine
+ *         tasks: source rows of the faces, the planes are set to the host rows
+ *         hostSize: size of the rows of all faces
  * @return: APP_ERROR
  */
-APP_ERROR WarpAffine::GetCropImage(DvppDataInfo &warpAffineDataInfoInput,
-                                   cv::Mat &image)
+APP_ERROR WarpAffine::CopySourceRows(const std::vector<DvppDataInfo> &warpAffineDataInfoInputVec,
+                                     std::vector<FaceWarpTask> &tasks, size_t hostSize)
 {
-    uint32_t size = static_cast<uint32_t>(picHeight_) * YUV_BYTES_NU / YUV_BYTES_DE * static_cast<uint32_t>(picWidth_);
-    std::unique_ptr<uint8_t[]> hostData(new(std::nothrow) uint8_t[size]);
-    if (hostData == nullptr) {
+    try {
+        if (hostRows_.size() < hostSize) {
+            hostRows_.resize(hostSize);
+        }
+    } catch (const std::bad_alloc&) {
+        LogError << "Failed to allocate the source rows." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
         return APP_ERR_COMM_ALLOC_MEM;
     }
-    APP_ERROR ret = aclrtMemcpy(hostData.get(), size, warpAffineDataInfoInput.data, warpAffineDataInfoInput.dataSize,
-                                ACL_MEMCPY_DEVICE_TO_HOST);
-    if (ret != APP_ERR_OK) {
-        LogError << "WarpAffine aclrtMemcpy failed." << GetErrorInfo(ret, "aclrtMemcpy");
-        return APP_ERR_ACL_BAD_COPY;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        FaceWarpTask &task = tasks[i];
+        uint8_t *yRows = hostRows_.data() + task.hostOffset;
+        uint8_t *uvRows = yRows + task.ySize;
+        task.planes.yPlane = yRows;
+        task.planes.uvPlane = uvRows;
+        if (task.planes.rows == 0) {
+            continue;
+        }
+        const uint8_t *input = warpAffineDataInfoInputVec[i].data;
+        APP_ERROR ret = aclrtMemcpy(yRows, task.ySize, input + static_cast<size_t>(task.planes.top) *
+                                    task.planes.stride, task.ySize, ACL_MEMCPY_DEVICE_TO_HOST);
+        if (ret == APP_ERR_OK) {
+            ret = aclrtMemcpy(uvRows, task.uvSize, input + task.uvOffset, task.uvSize, ACL_MEMCPY_DEVICE_TO_HOST);
+        }
+        if (ret != APP_ERR_OK) {
+            LogError << "WarpAffine aclrtMemcpy failed." << GetErrorInfo(ret, "aclrtMemcpy");
+            return APP_ERR_ACL_BAD_COPY;
+        }
     }
-
-    cv::Mat srcImageNv21(picHeight_ * YUV_BYTES_NU / YUV_BYTES_DE, picWidth_, CV_8UC1, hostData.get(), picWidth_);
-    image = srcImageNv21.clone();
     return APP_ERR_OK;
 }
 
 /**
- * @description: Calculate the transformation matrix and perform affine transformation
- * @param: srcPoints: standard key points information
- *         dstPoints: key points information in the actual picture
- *         warpImage: save information after affine transformation
- *         srcImageNv21: save information before affine transformation
- * @return: void
+ * @description: Fused color conversion and affine transformation
+ * @param: src: NV12 rows of the source picture
+ *         matrix: transform from the source to the output
+ *         dst: packed BGR output of dstWidth x dstHeight
+ * @return: APP_ERROR
  */
-void WarpAffine::CalWarpImage(const std::vector<cv::Point2f> &srcPoints, const std::vector<cv::Point2f> &dstPoints,
-    cv::Mat &warpImage, cv::Mat &srcImageNv21)
+APP_ERROR WarpAffine::WarpNv12ToBgr(const Nv12HostPlanes &src, const double matrix[AFFINE_MATRIX_LEN], uint8_t *dst,
+                                    uint32_t dstWidth, uint32_t dstHeight)
 {
-    cv::Mat warpMat = SimilarityTransform().Transform(dstPoints, srcPoints);
-    cv::Mat imgBGR888;
-    cv::cvtColor(srcImageNv21, imgBGR888, cv::COLOR_YUV2BGR_NV12);
-    cv::Mat warpDst = cv::Mat::zeros(picHeight_, picWidth_, CV_8UC3);
-    cv::warpAffine(imgBGR888, warpImage, warpMat, warpDst.size());
+    if (matrix == nullptr || dst == nullptr || (src.rows != 0 && (src.yPlane == nullptr || src.uvPlane == nullptr))) {
+        LogError << "The input or output of the warp is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (dstWidth == 0 || dstHeight == 0 || src.stride < src.width || (src.top & 1u) != 0 ||
+        src.top + src.rows > src.height) {
+        LogError << "The geometry of the warp is invalid." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    double inverse[AFFINE_MATRIX_LEN];
+    InvertAffine(matrix, inverse);
+    std::vector<int> adelta(dstWidth);
+    std::vector<int> bdelta(dstWidth);
+    for (uint32_t x = 0; x < dstWidth; x++) {
+        adelta[x] = RoundToInt(inverse[0] * x * AB_SCALE);
+        bdelta[x] = RoundToInt(inverse[3] * x * AB_SCALE);
+    }
+    int p00[BGR_CHANNEL_NUM];
+    int p01[BGR_CHANNEL_NUM];
+    int p10[BGR_CHANNEL_NUM];
+    int p11[BGR_CHANNEL_NUM];
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        int x0 = RoundToInt((inverse[1] * y + inverse[2]) * AB_SCALE) + ROUND_DELTA;
+        int y0 = RoundToInt((inverse[4] * y + inverse[5]) * AB_SCALE) + ROUND_DELTA;
+        uint8_t *row = dst + static_cast<size_t>(y) * dstWidth * BGR_CHANNEL_NUM;
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            int sx = (x0 + adelta[x]) >> (AB_BITS - INTER_BITS);
+            int sy = (y0 + bdelta[x]) >> (AB_BITS - INTER_BITS);
+            int fx = sx & INTER_MASK;
+            int fy = sy & INTER_MASK;
+            sx >>= INTER_BITS;
+            sy >>= INTER_BITS;
+            SamplePixel(src, sx, sy, p00);
+            SamplePixel(src, sx + 1, sy, p01);
+            SamplePixel(src, sx, sy + 1, p10);
+            SamplePixel(src, sx + 1, sy + 1, p11);
+            int w00 = (INTER_TAB_SIZE - fx) * (INTER_TAB_SIZE - fy);
+            int w01 = fx * (INTER_TAB_SIZE - fy);
+            int w10 = (INTER_TAB_SIZE - fx) * fy;
+            int w11 = fx * fy;
+            for (uint32_t c = 0; c < BGR_CHANNEL_NUM; c++) {
+                int value = p00[c] * w00 + p01[c] * w01 + p10[c] * w10 + p11[c] * w11;
+                row[x * BGR_CHANNEL_NUM + c] = static_cast<uint8_t>(
+                    ClampPixel((value + (1 << (WEIGHT_BITS - 1))) >> WEIGHT_BITS));
+            }
+        }
+    }
+    return APP_ERR_OK;
 }
 
 /**
- * @description: Save the aligned picture
+ * @description: Save the aligned picture, into the device buffer of the output when it is large enough
  * @param: warpAffineDataInfoOutput: picture information after warp affine
- *         imageWarp: save picture information after affine transformation
+ *         imageWarp: packed BGR picture after affine transformation
  * @return: APP_ERROR
  */
-APP_ERROR WarpAffine::SetWarpImage(DvppDataInfo &warpAffineDataInfoOutput, const cv::Mat &imageWarp)
+APP_ERROR WarpAffine::SetWarpImage(DvppDataInfo &warpAffineDataInfoOutput, const uint8_t *imageWarp)
 {
-    /* use new to allocate memory */
-    uint32_t dataSize = imageWarp.cols * imageWarp.rows * BGR_CHANNEL_NUM;
-    void *deviceBuffer = nullptr;
-    APP_ERROR ret = DeviceMemoryMallocFunc(&deviceBuffer, dataSize, MX_MEM_MALLOC_HUGE_FIRST);
-    if (ret != APP_ERR_OK) {
-        LogError << "WarpAffine device memory allocate failed." << GetErrorInfo(ret);
-        return APP_ERR_ACL_BAD_ALLOC;
+    uint32_t dataSize = static_cast<uint32_t>(picWidth_) * static_cast<uint32_t>(picHeight_) * BGR_CHANNEL_NUM;
+    void *deviceBuffer = warpAffineDataInfoOutput.data;
+    bool ownBuffer = deviceBuffer == nullptr || warpAffineDataInfoOutput.dataSize < dataSize;
+    if (ownBuffer) {
+        deviceBuffer = nullptr;
+        APP_ERROR ret = DeviceMemoryMallocFunc(&deviceBuffer, dataSize, MX_MEM_MALLOC_HUGE_FIRST);
+        if (ret != APP_ERR_OK) {
+            LogError << "WarpAffine device memory allocate failed." << GetErrorInfo(ret);
+            return APP_ERR_ACL_BAD_ALLOC;
+        }
     }
-    ret = aclrtMemcpy(deviceBuffer, dataSize, imageWarp.data, dataSize, ACL_MEMCPY_HOST_TO_DEVICE);
+    APP_ERROR ret = aclrtMemcpy(deviceBuffer, dataSize, imageWarp, dataSize, ACL_MEMCPY_HOST_TO_DEVICE);
     if (ret != APP_ERR_OK) {
-        DeviceMemoryFreeFunc(deviceBuffer);
+        if (ownBuffer) {
+            DeviceMemoryFreeFunc(deviceBuffer);
+        }
         LogError << "WarpAffine aclrtMemcpy failed." << GetErrorInfo(ret, "aclrtMemcpy");
         return APP_ERR_ACL_BAD_COPY;
     }
     warpAffineDataInfoOutput.format = MXBASE_PIXEL_FORMAT_BGR_888;
-    warpAffineDataInfoOutput.width = imageWarp.cols;
-    warpAffineDataInfoOutput.height = imageWarp.rows;
-    warpAffineDataInfoOutput.widthStride = DVPP_ALIGN_UP(imageWarp.cols, VPC_STRIDE_WIDTH);
-    warpAffineDataInfoOutput.heightStride = DVPP_ALIGN_UP(imageWarp.rows, VPC_STRIDE_HEIGHT);
-    warpAffineDataInfoOutput.data = (uint8_t *)deviceBuffer;
+    warpAffineDataInfoOutput.width = static_cast<uint32_t>(picWidth_);
+    warpAffineDataInfoOutput.height = static_cast<uint32_t>(picHeight_);
+    warpAffineDataInfoOutput.widthStride = DVPP_ALIGN_UP(static_cast<uint32_t>(picWidth_), VPC_STRIDE_WIDTH);
+    warpAffineDataInfoOutput.heightStride = DVPP_ALIGN_UP(static_cast<uint32_t>(picHeight_), VPC_STRIDE_HEIGHT);
     warpAffineDataInfoOutput.dataSize = dataSize;
-    warpAffineDataInfoOutput.destory = [](void* data) { DeviceMemoryFreeFunc(data); };
+    if (ownBuffer) {
+        warpAffineDataInfoOutput.data = static_cast<uint8_t *>(deviceBuffer);
+        warpAffineDataInfoOutput.destory = [](void* data) { DeviceMemoryFreeFunc(data); };
+    }
     return APP_ERR_OK;
 }
 }
-
@@ -382,6 +382,7 @@ APP_ERROR MxOmModelDesc::DeInit(void)
         LogError << "Failed to unload model." << GetErrorInfo(ret, "aclmdlUnload");
         subRet = APP_ERR_ACL_FAILURE;
     }
+    sharedWeight_ = nullptr;
     if (aclModelDesc_ != nullptr) {
         ret = aclmdlDestroyDesc(static_cast<aclmdlDesc*>(aclModelDesc_));
         if (ret != APP_ERR_OK) {
@@ -923,6 +924,11 @@ APP_ERROR MxOmModelDesc::ModelInference(std::vector<Tensor>& outputTensors,
         return APP_ERR_COMM_FAILURE;
     }
     APP_ERROR subRet = APP_ERR_OK;
+    // the shared weights are not reloaded by another instance until the stream is synchronized
+    std::shared_lock<std::shared_timed_mutex> weightLock;
+    if (sharedWeight_ != nullptr) {
+        weightLock = std::shared_lock<std::shared_timed_mutex>(sharedWeight_->inferMutex);
+    }
     // Execute model infer
     {
         std::lock_guard<std::mutex> lock(g_mtx);
@@ -1404,6 +1410,46 @@ APP_ERROR MxOmModelDesc::SetModelMemOpt(aclmdlConfigHandle* handle, const ModelL
 }
 
 APP_ERROR MxOmModelDesc::LoadModel(ModelLoadOptV2 &mdlLoadOpt)
+{
+    bool fromFile = mdlLoadOpt.loadType == ModelLoadOptV2::LOAD_MODEL_FROM_FILE ||
+        mdlLoadOpt.loadType == ModelLoadOptV2::LOAD_MODEL_FROM_FILE_WITH_MEM;
+    if (mdlLoadOpt.shareWeights && fromFile && mdlLoadOpt.modelWeightPtr == nullptr) {
+        APP_ERROR ret = LoadModelWithSharedWeight(mdlLoadOpt);
+        if (ret == APP_ERR_OK) {
+            return APP_ERR_OK;
+        }
+        LogWarn << "Failed to load model with shared weight, load a private copy instead.";
+        sharedWeight_ = nullptr;
+    }
+    return LoadModelWithConfig(mdlLoadOpt);
+}
+
+APP_ERROR MxOmModelDesc::LoadModelWithSharedWeight(const ModelLoadOptV2 &mdlLoadOpt)
+{
+    std::shared_ptr<SharedModelWeight> weight = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().AcquireWeight(mdlLoadOpt.modelPath, deviceId_, weight);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    // load from the mapped model file into the shared weights, the other options of the caller are kept
+    ModelLoadOptV2 sharedOpt = mdlLoadOpt;
+    sharedOpt.loadType = ModelLoadOptV2::LOAD_MODEL_FROM_MEM_WITH_MEM;
+    sharedOpt.modelPtr = weight->modelData;
+    sharedOpt.modelSize = weight->modelSize;
+    sharedOpt.modelWeightPtr = weight->weightPtr;
+    sharedOpt.weightSize = weight->weightSize;
+    {
+        std::unique_lock<std::shared_timed_mutex> loadLock(weight->inferMutex);
+        ret = LoadModelWithConfig(sharedOpt);
+    }
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    sharedWeight_ = weight;
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxOmModelDesc::LoadModelWithConfig(const ModelLoadOptV2 &mdlLoadOpt)
 {
     auto configHandle = aclmdlCreateConfigHandle();
     if (configHandle == nullptr) {
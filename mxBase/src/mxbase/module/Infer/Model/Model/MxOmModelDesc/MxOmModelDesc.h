@@ -25,6 +25,7 @@
 #include "acl/acl.h"
 #include "MxBase/DeviceManager/DeviceManager.h"
 #include "../MxModelDesc/MxModelDesc.h"
+#include "../../ModelInfer/ModelWeightRegistry.h"
 
 namespace MxBase {
 class MxOmModelDesc : public MxModelDesc {
@@ -147,6 +148,10 @@ public:
 
     APP_ERROR LoadModel(ModelLoadOptV2 &mdlLoadOpt);
 
+    APP_ERROR LoadModelWithConfig(const ModelLoadOptV2 &mdlLoadOpt);
+
+    APP_ERROR LoadModelWithSharedWeight(const ModelLoadOptV2 &mdlLoadOpt);
+
 private:
     APP_ERROR SyncAndFree(aclmdlDataset *inputDataset, aclmdlDataset *outputDataset,
                           AscendStream &stream = AscendStream::DefaultStream());
@@ -162,6 +167,7 @@ private:
     std::vector<VisionTensorDesc> curOutputTensorDesc_ = {};
     std::vector<VisionTensorBase> outputTensor_ = {};
     VisionDynamicInfo dynamicInfo_ = {};
+    std::shared_ptr<SharedModelWeight> sharedWeight_ = nullptr;
 };
 } // MxBase namespace end
 #endif
\ No newline at end of file
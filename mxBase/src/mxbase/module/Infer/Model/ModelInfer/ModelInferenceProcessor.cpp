@@ -51,7 +51,7 @@ APP_ERROR ModelInferenceProcessor::Init(std::string modelPath, ModelDesc& modelD
         LogError << "Model path is invalidate." << GetErrorInfo(ret);
         return ret;
     }
-    ret = dPtr_->InitModel(modelPath);
+    ret = dPtr_->InitModel(modelPath, dPtr_->shareWeights_);
     if (ret != APP_ERR_OK) {
         LogError << "Failed to init model, the model path is invalidate." << GetErrorInfo(ret);
         return ret;
@@ -73,6 +73,13 @@ APP_ERROR ModelInferenceProcessor::Init(const std::string& modelPath)
     return Init(modelPath, dPtr_->modelDesc_);
 }
 
+APP_ERROR ModelInferenceProcessor::Init(const std::string& modelPath, bool shareWeights)
+{
+    dPtr_->shareWeights_ = shareWeights;
+    dPtr_->modelDesc_ = {};
+    return Init(modelPath, dPtr_->modelDesc_);
+}
+
 /*
  * @description Unload Model
  * @return APP_ERROR error code
@@ -84,6 +91,7 @@ APP_ERROR ModelInferenceProcessor::DeInit(void)
         LogError << "Failed to unload model." << GetErrorInfo(ret, "aclmdlUnload");
         return APP_ERR_ACL_FAILURE;
     }
+    dPtr_->sharedWeight_ = nullptr;
     if (dPtr_->aclModelDesc_ != nullptr) {
         ret = aclmdlDestroyDesc((aclmdlDesc*)dPtr_->aclModelDesc_);
         if (ret != APP_ERR_OK) {
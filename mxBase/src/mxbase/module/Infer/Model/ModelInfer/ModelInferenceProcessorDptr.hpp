@@ -26,6 +26,7 @@
 #include <dirent.h>
 #include "MxBase/ModelInfer/ModelInferenceProcessor.h"
 #include "MxBase/Utils/FileUtils.h"
+#include "ModelWeightRegistry.h"
 
 namespace MxBase {
 const int IMAGE_ALL_DIMS = 4;
@@ -36,9 +37,10 @@ public:
      * @description Init Model
      * 1.Loads offline model data from files
      * 2.Users manage the memory used for model running
+     * 3.Weights are shared with other instances of the same model on the device if shareWeights is set
      * @return APP_ERROR error code
      */
-    APP_ERROR InitModel(std::string modelPath);
+    APP_ERROR InitModel(std::string modelPath, bool shareWeights = false);
 
     /**
      * @description Get model input sizes and dims
@@ -173,6 +175,8 @@ public:
     std::vector<std::vector<uint32_t>> inputshape {};
     aclrtStream stream_ = {};
     std::vector<std::vector<uint64_t>> dynamicDims_ {};
+    bool shareWeights_ = false;
+    std::shared_ptr<SharedModelWeight> sharedWeight_ = nullptr;
 };
 
 /*
@@ -181,15 +185,28 @@ public:
 * 2.Users manage the memory used for model running
 * @return APP_ERROR error code
 */
-APP_ERROR ModelInferenceProcessorDptr::InitModel(std::string modelPath)
+APP_ERROR ModelInferenceProcessorDptr::InitModel(std::string modelPath, bool shareWeights)
 {
     APP_ERROR ret = aclrtCreateStream(&stream_);
     if (ret != APP_ERR_OK) {
         LogError << "Failed to Create device stream." << GetErrorInfo(ret);
         return ret;
     }
+    int32_t deviceId = 0;
+    if (shareWeights && aclrtGetDevice(&deviceId) == APP_ERR_OK) {
+        ret = ModelWeightRegistry::GetInstance().LoadModel(modelPath, deviceId, modelId_, sharedWeight_);
+        if (ret != APP_ERR_OK) {
+            LogWarn << "Failed to load model with shared weight, load a private copy instead.";
+            sharedWeight_ = nullptr;
+            shareWeights = false;
+        }
+    } else {
+        shareWeights = false;
+    }
     // loads offline model data from file without mem
-    ret = aclmdlLoadFromFile(modelPath.c_str(), &modelId_);
+    if (!shareWeights) {
+        ret = aclmdlLoadFromFile(modelPath.c_str(), &modelId_);
+    }
     if (ret != APP_ERR_OK) {
         LogError << "Failed to load offline model data from file." << GetErrorInfo(ret, "aclmdlLoadFromFile");
         aclrtDestroyStream(stream_);
@@ -204,6 +221,7 @@ APP_ERROR ModelInferenceProcessorDptr::InitModel(std::string modelPath)
             aclModelDesc_ = nullptr;
         }
         aclmdlUnload(modelId_);
+        sharedWeight_ = nullptr;
         aclrtDestroyStream(stream_);
         LogError << "Failed to obtain the model description." << GetErrorInfo(ret, "aclmdlGetDesc");
         return APP_ERR_ACL_FAILURE;
@@ -302,6 +320,11 @@ APP_ERROR ModelInferenceProcessorDptr::ModelInfer(std::vector<BaseTensor>& input
     APP_ERROR subRet = APP_ERR_OK;
     auto input = static_cast<aclmdlDataset*>(inputDataset.mdlDataPtr);
     auto output = static_cast<aclmdlDataset*>(outputDataset.mdlDataPtr);
+    // the shared weights are not reloaded by another instance until the stream is synchronized
+    std::shared_lock<std::shared_timed_mutex> weightLock;
+    if (sharedWeight_ != nullptr) {
+        weightLock = std::shared_lock<std::shared_timed_mutex>(sharedWeight_->inferMutex);
+    }
     ret = aclmdlExecuteAsync(modelId_, input, output, stream_);
     if (ret != APP_ERR_OK) {
         LogError << "Failed to model infer execute." << GetErrorInfo(ret, "aclmdlExecute");
@@ -0,0 +1,224 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+* Description: Process-wide registry of read-only model weights shared by model instances.
+* Author: MindX SDK
+* Create: 2025
+* History: NA
+*/
+
+#include "ModelWeightRegistry.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "acl/acl.h"
+#include "MxBase/Log/Log.h"
+#include "MxBase/Utils/FileUtils.h"
+#include "MxBase/DeviceManager/DeviceManager.h"
+
+namespace {
+    constexpr size_t MAX_MODEL_FILE_SIZE = 4294967296; // 4GB
+    const std::string KEY_SEPARATOR = "#";
+    const std::string LOAD_OPTION_MEM_WITH_WEIGHT = "memWithWeight";
+}
+
+namespace MxBase {
+ModelWeightRegistry& ModelWeightRegistry::GetInstance()
+{
+    static ModelWeightRegistry registry;
+    return registry;
+}
+
+APP_ERROR ModelWeightRegistry::LoadModel(const std::string& modelPath, int32_t deviceId, uint32_t& modelId,
+                                         std::shared_ptr<SharedModelWeight>& weight)
+{
+    std::shared_ptr<SharedModelWeight> entry = nullptr;
+    APP_ERROR ret = AcquireWeight(modelPath, deviceId, entry);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    // The workspace is left to acl so that every instance owns a private one while the weights are shared.
+    {
+        std::unique_lock<std::shared_timed_mutex> loadLock(entry->inferMutex);
+        ret = aclmdlLoadFromMemWithMem(entry->modelData, entry->modelSize, &modelId, nullptr, 0,
+                                       entry->weightPtr, entry->weightSize);
+    }
+    if (ret != APP_ERR_OK) {
+        LogError << "Failed to load model with shared weight." << GetErrorInfo(ret, "aclmdlLoadFromMemWithMem");
+        return APP_ERR_ACL_FAILURE;
+    }
+    weight = entry;
+    return APP_ERR_OK;
+}
+
+APP_ERROR ModelWeightRegistry::AcquireWeight(const std::string& modelPath, int32_t deviceId,
+                                             std::shared_ptr<SharedModelWeight>& weight)
+{
+    std::string realPath;
+    if (!FileUtils::RegularFilePath(modelPath, realPath)) {
+        LogError << "Failed to get model, the model path is invalidate." << GetErrorInfo(APP_ERR_COMM_NO_EXIST);
+        return APP_ERR_COMM_NO_EXIST;
+    }
+    return Acquire(realPath, deviceId, weight);
+}
+
+size_t ModelWeightRegistry::GetEntryCount()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    size_t count = 0;
+    for (const auto& entry : entries_) {
+        if (!entry.second.expired()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+APP_ERROR ModelWeightRegistry::Acquire(const std::string& realPath, int32_t deviceId,
+                                       std::shared_ptr<SharedModelWeight>& weight)
+{
+    std::string key = realPath + KEY_SEPARATOR + std::to_string(deviceId) + KEY_SEPARATOR +
+        LOAD_OPTION_MEM_WITH_WEIGHT;
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto iter = entries_.find(key);
+    if (iter != entries_.end()) {
+        weight = iter->second.lock();
+        if (weight != nullptr) {
+            LogDebug << "Reuse shared weight of model(" << realPath << ") on device(" << deviceId << ").";
+            return APP_ERR_OK;
+        }
+        entries_.erase(iter);
+    }
+    std::unique_ptr<SharedModelWeight> entry(new (std::nothrow) SharedModelWeight);
+    if (entry == nullptr) {
+        LogError << "Failed to create shared model weight." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    entry->key = key;
+    entry->deviceId = deviceId;
+    APP_ERROR ret = MapModelFile(realPath, *entry);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    ret = MallocWeight(*entry);
+    if (ret != APP_ERR_OK) {
+        Release(entry.release());
+        return ret;
+    }
+    weight = std::shared_ptr<SharedModelWeight>(entry.release(), Release);
+    entries_[key] = weight;
+    LogInfo << "Load shared weight of model(" << realPath << ") on device(" << deviceId << "), weight size("
+            << weight->weightSize << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR ModelWeightRegistry::MapModelFile(const std::string& realPath, SharedModelWeight& weight)
+{
+    int fd = open(realPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LogError << "Failed to open model file." << GetErrorInfo(APP_ERR_COMM_OPEN_FAIL);
+        return APP_ERR_COMM_OPEN_FAIL;
+    }
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 ||
+        static_cast<size_t>(fileStat.st_size) > MAX_MODEL_FILE_SIZE) {
+        LogError << "Invalid model file size." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        close(fd);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    weight.modelSize = static_cast<size_t>(fileStat.st_size);
+    void* addr = mmap(nullptr, weight.modelSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+        close(fd);
+        weight.modelData = addr;
+        weight.isMapped = true;
+        return APP_ERR_OK;
+    }
+    // Fall back to a heap copy on file systems that do not support mmap.
+    LogWarn << "Failed to map model file, read it into host memory instead.";
+    std::unique_ptr<uint8_t[]> buffer(new (std::nothrow) uint8_t[weight.modelSize]);
+    if (buffer == nullptr) {
+        close(fd);
+        LogError << "Failed to malloc model buffer." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    size_t offset = 0;
+    while (offset < weight.modelSize) {
+        ssize_t readSize = read(fd, buffer.get() + offset, weight.modelSize - offset);
+        if (readSize <= 0) {
+            close(fd);
+            LogError << "Failed to read model file." << GetErrorInfo(APP_ERR_COMM_READ_FAIL);
+            return APP_ERR_COMM_READ_FAIL;
+        }
+        offset += static_cast<size_t>(readSize);
+    }
+    close(fd);
+    weight.modelData = buffer.release();
+    weight.isMapped = false;
+    return APP_ERR_OK;
+}
+
+APP_ERROR ModelWeightRegistry::MallocWeight(SharedModelWeight& weight)
+{
+    // the workspace is allocated by each instance, only the weight size is kept
+    size_t workSize = 0;
+    APP_ERROR ret = aclmdlQuerySizeFromMem(weight.modelData, weight.modelSize, &workSize, &weight.weightSize);
+    if (ret != APP_ERR_OK) {
+        LogError << "Failed to query model work or weight size." << GetErrorInfo(ret, "aclmdlQuerySizeFromMem");
+        return APP_ERR_ACL_FAILURE;
+    }
+    if (weight.weightSize == 0) {
+        return APP_ERR_OK;
+    }
+    ret = aclrtMalloc(&weight.weightPtr, weight.weightSize, ACL_MEM_MALLOC_HUGE_FIRST);
+    if (ret != APP_ERR_OK) {
+        weight.weightPtr = nullptr;
+        LogError << "Failed to malloc model weight memory." << GetErrorInfo(ret, "aclrtMalloc");
+        return APP_ERR_ACL_BAD_ALLOC;
+    }
+    return APP_ERR_OK;
+}
+
+void ModelWeightRegistry::Release(SharedModelWeight* weight)
+{
+    if (weight == nullptr) {
+        return;
+    }
+    if (weight->weightPtr != nullptr) {
+        DeviceContext context = {};
+        context.devId = weight->deviceId;
+        APP_ERROR ret = DeviceManager::GetInstance()->SetDevice(context);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to set device before freeing model weight." << GetErrorInfo(ret);
+        }
+        ret = aclrtFree(weight->weightPtr);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to free model weight memory." << GetErrorInfo(ret, "aclrtFree");
+        }
+        weight->weightPtr = nullptr;
+    }
+    if (weight->modelData != nullptr) {
+        if (weight->isMapped) {
+            munmap(weight->modelData, weight->modelSize);
+        } else {
+            delete[] static_cast<uint8_t*>(weight->modelData);
+        }
+        weight->modelData = nullptr;
+    }
+    delete weight;
+}
+}  // namespace MxBase
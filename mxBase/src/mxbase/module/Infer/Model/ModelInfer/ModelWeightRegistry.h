@@ -0,0 +1,98 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+* Description: Process-wide registry of read-only model weights shared by model instances.
+* Author: MindX SDK
+* Create: 2025
+* History: NA
+*/
+
+#ifndef MODEL_WEIGHT_REGISTRY_H
+#define MODEL_WEIGHT_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include "MxBase/ErrorCode/ErrorCode.h"
+
+namespace MxBase {
+/**
+ * One loaded model file and its device weight memory. The host image of the file stays mapped for the
+ * lifetime of the entry so that every instance can load its own execution context from it.
+ * Loading a model instance writes the weight memory again, so a load holds inferMutex exclusively and the
+ * instances hold it shared from the execution of a model until the stream is synchronized.
+ */
+struct SharedModelWeight {
+    std::string key = "";
+    int32_t deviceId = 0;
+    void* modelData = nullptr;
+    size_t modelSize = 0;
+    bool isMapped = false;
+    void* weightPtr = nullptr;
+    size_t weightSize = 0;
+    std::shared_timed_mutex inferMutex;
+};
+
+class ModelWeightRegistry {
+public:
+    static ModelWeightRegistry& GetInstance();
+
+    /**
+     * @description Load a model whose weights are shared with every other instance of the same
+     * (path, device, options). Each call gets its own model id, workspace and execution context.
+     * @param modelPath: path of the om model file
+     * @param deviceId: device the weights live on, must be the current device
+     * @param modelId: id of the loaded model instance
+     * @param weight: holds the shared weights, must outlive the model instance
+     */
+    APP_ERROR LoadModel(const std::string& modelPath, int32_t deviceId, uint32_t& modelId,
+                        std::shared_ptr<SharedModelWeight>& weight);
+
+    /**
+     * @description Get the shared weights of a model without loading an instance, for callers that load with
+     * their own options. The caller loads from modelData into weightPtr while holding inferMutex exclusively.
+     * @param modelPath: path of the om model file
+     * @param deviceId: device the weights live on, must be the current device
+     * @param weight: the shared weights
+     */
+    APP_ERROR AcquireWeight(const std::string& modelPath, int32_t deviceId,
+                            std::shared_ptr<SharedModelWeight>& weight);
+
+    /**
+     * @description Number of distinct weight entries currently alive, for statistics and tests
+     */
+    size_t GetEntryCount();
+
+    ModelWeightRegistry(const ModelWeightRegistry&) = delete;
+    ModelWeightRegistry& operator=(const ModelWeightRegistry&) = delete;
+
+private:
+    ModelWeightRegistry() = default;
+    ~ModelWeightRegistry() = default;
+
+    APP_ERROR Acquire(const std::string& realPath, int32_t deviceId, std::shared_ptr<SharedModelWeight>& weight);
+    static APP_ERROR MapModelFile(const std::string& realPath, SharedModelWeight& weight);
+    static APP_ERROR MallocWeight(SharedModelWeight& weight);
+    static void Release(SharedModelWeight* weight);
+
+private:
+    std::mutex mtx_ = {};
+    std::map<std::string, std::weak_ptr<SharedModelWeight>> entries_ = {};
+};
+}  // namespace MxBase
+#endif
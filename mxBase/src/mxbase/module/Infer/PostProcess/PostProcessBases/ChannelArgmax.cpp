@@ -0,0 +1,326 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Argmax and top k over the class channels of segmentation outputs.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/PostProcessBases/ChannelArgmax.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <system_error>
+#include <thread>
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "MxBase/Log/Log.h"
+#include "MxBase/Utils/DataTypeUtils.h"
+
+namespace {
+using namespace MxBase;
+
+// pixels handled together on the NCHW path, small enough for the running max and index to stay in L1
+const size_t CHUNK_PIXELS = 1024;
+const uint32_t MIN_BAND_ROWS = 16;
+const uint32_t MAX_THREAD_NUM = 64;
+const uint32_t MAX_LABEL_CLASS_NUM = 65536;
+
+/**
+ * Scores of num adjacent elements starting at offset, as float. Float32 data is read in place, float16 is converted
+ * into the buffer.
+ */
+inline const float* LoadScores(const ChannelScores& scores, size_t offset, size_t num, float* buffer)
+{
+    if (scores.dataType == TENSOR_DTYPE_FLOAT32) {
+        return static_cast<const float*>(scores.data) + offset;
+    }
+    DataTypeUtils::Float16ToFloat32(buffer, static_cast<const uint16_t*>(scores.data) + offset, num);
+    return buffer;
+}
+
+// where best < values, take the value and the class
+void UpdateMax(const float* values, float* best, uint32_t* index, uint32_t classId, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    const size_t lanes = 4;
+    uint32x4_t classVec = vdupq_n_u32(classId);
+    for (; i + lanes <= num; i += lanes) {
+        float32x4_t value = vld1q_f32(values + i);
+        float32x4_t maxValue = vld1q_f32(best + i);
+        uint32x4_t greater = vcgtq_f32(value, maxValue);
+        vst1q_f32(best + i, vbslq_f32(greater, value, maxValue));
+        vst1q_u32(index + i, vbslq_u32(greater, classVec, vld1q_u32(index + i)));
+    }
+#elif defined(__SSE2__)
+    const size_t lanes = 4;
+    __m128i classVec = _mm_set1_epi32(static_cast<int>(classId));
+    for (; i + lanes <= num; i += lanes) {
+        __m128 value = _mm_loadu_ps(values + i);
+        __m128 maxValue = _mm_loadu_ps(best + i);
+        __m128 greater = _mm_cmpgt_ps(value, maxValue);
+        __m128i greaterInt = _mm_castps_si128(greater);
+        _mm_storeu_ps(best + i, _mm_or_ps(_mm_and_ps(greater, value), _mm_andnot_ps(greater, maxValue)));
+        __m128i oldIndex = _mm_loadu_si128(reinterpret_cast<const __m128i*>(index + i));
+        __m128i newIndex = _mm_or_si128(_mm_and_si128(greaterInt, classVec),
+                                        _mm_andnot_si128(greaterInt, oldIndex));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(index + i), newIndex);
+    }
+#endif
+    for (; i < num; i++) {
+        bool greater = values[i] > best[i];
+        best[i] = greater ? values[i] : best[i];
+        index[i] = greater ? classId : index[i];
+    }
+}
+
+/**
+ * Where the bands write to. The pointers are taken once before the threads start, as taking a mutable pointer into
+ * a std::string is not thread safe with the copy on write strings of the old ABI.
+ */
+struct ArgmaxOutput {
+    char* labels = nullptr;
+    uint32_t elemSize = 1;
+    float* confidence = nullptr;
+};
+
+template<typename T>
+void StoreLabelsAs(char* labels, size_t offset, const uint32_t* index, size_t num)
+{
+    T* dst = reinterpret_cast<T*>(labels) + offset;
+    for (size_t i = 0; i < num; i++) {
+        dst[i] = static_cast<T>(index[i]);
+    }
+}
+
+inline void StoreLabels(const ArgmaxOutput& output, size_t offset, const uint32_t* index, size_t num)
+{
+    if (output.elemSize == 1) {
+        StoreLabelsAs<uint8_t>(output.labels, offset, index, num);
+    } else {
+        StoreLabelsAs<uint16_t>(output.labels, offset, index, num);
+    }
+}
+
+/**
+ * Rows [rowBegin, rowEnd) of every class plane are contiguous, so the band is walked in chunks of pixels, each chunk
+ * reading the classNum planes one after another.
+ */
+void ArgmaxNchwBand(const ChannelScores& scores, uint32_t rowBegin, uint32_t rowEnd, const ArgmaxOutput& output)
+{
+    const size_t planeSize = static_cast<size_t>(scores.width) * scores.height;
+    const size_t bandEnd = static_cast<size_t>(rowEnd) * scores.width;
+    std::vector<float> best(CHUNK_PIXELS);
+    std::vector<uint32_t> index(CHUNK_PIXELS);
+    std::vector<float> buffer(CHUNK_PIXELS);
+    std::vector<float> expSum(CHUNK_PIXELS);
+    for (size_t begin = static_cast<size_t>(rowBegin) * scores.width; begin < bandEnd; begin += CHUNK_PIXELS) {
+        size_t num = std::min(CHUNK_PIXELS, bandEnd - begin);
+        const float* first = LoadScores(scores, begin, num, buffer.data());
+        std::copy(first, first + num, best.begin());
+        std::fill(index.begin(), index.begin() + num, 0);
+        for (uint32_t c = 1; c < scores.classNum; c++) {
+            UpdateMax(LoadScores(scores, c * planeSize + begin, num, buffer.data()), best.data(), index.data(), c,
+                      num);
+        }
+        StoreLabels(output, begin, index.data(), num);
+        if (output.confidence == nullptr) {
+            continue;
+        }
+        std::fill(expSum.begin(), expSum.begin() + num, 0.f);
+        for (uint32_t c = 0; c < scores.classNum; c++) {
+            const float* values = LoadScores(scores, c * planeSize + begin, num, buffer.data());
+            for (size_t i = 0; i < num; i++) {
+                expSum[i] += std::exp(values[i] - best[i]);
+            }
+        }
+        for (size_t i = 0; i < num; i++) {
+            output.confidence[begin + i] = 1.f / expSum[i];
+        }
+    }
+}
+
+void ArgmaxNhwcBand(const ChannelScores& scores, uint32_t rowBegin, uint32_t rowEnd, const ArgmaxOutput& output)
+{
+    std::vector<float> buffer(scores.classNum);
+    std::vector<uint32_t> rowIndex(scores.width);
+    for (uint32_t y = rowBegin; y < rowEnd; y++) {
+        size_t rowOffset = static_cast<size_t>(y) * scores.width;
+        for (uint32_t x = 0; x < scores.width; x++) {
+            const float* values = LoadScores(scores, (rowOffset + x) * scores.classNum, scores.classNum,
+                                             buffer.data());
+            uint32_t maxIndex = 0;
+            float maxValue = values[0];
+            for (uint32_t c = 1; c < scores.classNum; c++) {
+                bool greater = values[c] > maxValue;
+                maxValue = greater ? values[c] : maxValue;
+                maxIndex = greater ? c : maxIndex;
+            }
+            rowIndex[x] = maxIndex;
+            if (output.confidence != nullptr) {
+                float expSum = 0.f;
+                for (uint32_t c = 0; c < scores.classNum; c++) {
+                    expSum += std::exp(values[c] - maxValue);
+                }
+                output.confidence[rowOffset + x] = 1.f / expSum;
+            }
+        }
+        StoreLabels(output, rowOffset, rowIndex.data(), scores.width);
+    }
+}
+
+void TopKBand(const ChannelScores& scores, uint32_t k, uint32_t rowBegin, uint32_t rowEnd,
+              std::vector<uint32_t>& classIds, std::vector<float>& classScores)
+{
+    const size_t planeSize = static_cast<size_t>(scores.width) * scores.height;
+    const size_t classStep = scores.layout == TYPE_NCHW ? planeSize : 1;
+    std::vector<float> buffer(scores.classNum);
+    std::vector<float> pixelScores(scores.classNum);
+    for (size_t pixel = static_cast<size_t>(rowBegin) * scores.width;
+         pixel < static_cast<size_t>(rowEnd) * scores.width; pixel++) {
+        size_t offset = scores.layout == TYPE_NCHW ? pixel : pixel * scores.classNum;
+        for (uint32_t c = 0; c < scores.classNum; c++) {
+            pixelScores[c] = *LoadScores(scores, offset + c * classStep, 1, buffer.data());
+        }
+        // insertion into the k best so far, kept in descending order, earlier classes first on ties
+        uint32_t* ids = classIds.data() + pixel * k;
+        float* values = classScores.data() + pixel * k;
+        uint32_t filled = 0;
+        for (uint32_t c = 0; c < scores.classNum; c++) {
+            if (filled == k && pixelScores[c] <= values[k - 1]) {
+                continue;
+            }
+            uint32_t pos = filled < k ? filled++ : k - 1;
+            while (pos > 0 && values[pos - 1] < pixelScores[c]) {
+                values[pos] = values[pos - 1];
+                ids[pos] = ids[pos - 1];
+                pos--;
+            }
+            values[pos] = pixelScores[c];
+            ids[pos] = c;
+        }
+    }
+}
+
+APP_ERROR CheckScores(const ChannelScores& scores)
+{
+    if (scores.data == nullptr) {
+        LogError << "The scores are nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (scores.dataType != TENSOR_DTYPE_FLOAT32 && scores.dataType != TENSOR_DTYPE_FLOAT16) {
+        LogError << "The data type(" << scores.dataType << ") of the scores is not supported, only float32 and "
+                 << "float16 are." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (scores.layout != TYPE_NCHW && scores.layout != TYPE_NHWC) {
+        LogError << "The layout(" << scores.layout << ") of the scores is not supported, only NCHW and NHWC are."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (scores.classNum == 0 || scores.classNum > MAX_LABEL_CLASS_NUM) {
+        LogError << "The classNum(" << scores.classNum << ") is out of range (0, " << MAX_LABEL_CLASS_NUM << "]."
+                 << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
+    }
+    return APP_ERR_OK;
+}
+
+/**
+ * Splits the rows into at most threadNum bands of at least MIN_BAND_ROWS rows, the calling thread takes the first.
+ */
+void RunInBands(uint32_t height, uint32_t threadNum, const std::function<void(uint32_t, uint32_t)>& func)
+{
+    uint32_t bandNum = std::max(1u, std::min({threadNum, MAX_THREAD_NUM, height / MIN_BAND_ROWS}));
+    uint32_t bandRows = (height + bandNum - 1) / bandNum;
+    std::vector<std::thread> threads;
+    uint32_t begin = bandRows;
+    for (; begin < height; begin += bandRows) {
+        try {
+            threads.emplace_back(func, begin, std::min(height, begin + bandRows));
+        } catch (const std::system_error&) {
+            LogWarn << "Create band thread failed, the bands left run in the calling thread.";
+            break;
+        }
+    }
+    func(0, std::min(height, bandRows));
+    for (; begin < height; begin += bandRows) {
+        func(begin, std::min(height, begin + bandRows));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+}
+
+namespace MxBase {
+APP_ERROR ChannelArgmax::Argmax(const ChannelScores& scores, SegLabelMap& labels, std::vector<float>* confidence,
+                                uint32_t threadNum)
+{
+    APP_ERROR ret = CheckScores(scores);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    labels.Reset(scores.width, scores.height, scores.classNum);
+    if (confidence != nullptr) {
+        confidence->resize(static_cast<size_t>(scores.width) * scores.height);
+    }
+    if (scores.width == 0 || scores.height == 0) {
+        return APP_ERR_OK;
+    }
+    ArgmaxOutput output;
+    output.labels = &labels.data[0];
+    output.elemSize = labels.elemSize;
+    output.confidence = confidence == nullptr ? nullptr : confidence->data();
+    RunInBands(scores.height, threadNum, [&scores, &output](uint32_t rowBegin, uint32_t rowEnd) {
+        if (scores.layout == TYPE_NCHW) {
+            ArgmaxNchwBand(scores, rowBegin, rowEnd, output);
+        } else {
+            ArgmaxNhwcBand(scores, rowBegin, rowEnd, output);
+        }
+    });
+    return APP_ERR_OK;
+}
+
+APP_ERROR ChannelArgmax::TopK(const ChannelScores& scores, uint32_t k, std::vector<uint32_t>& classIds,
+                              std::vector<float>& classScores, uint32_t threadNum)
+{
+    APP_ERROR ret = CheckScores(scores);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    if (k == 0 || k > scores.classNum) {
+        LogError << "The k(" << k << ") is out of range [1, " << scores.classNum << "]."
+                 << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
+    }
+    size_t resultSize = static_cast<size_t>(scores.width) * scores.height * k;
+    classIds.assign(resultSize, 0);
+    classScores.assign(resultSize, 0.f);
+    if (resultSize == 0) {
+        return APP_ERR_OK;
+    }
+    RunInBands(scores.height, threadNum, [&scores, k, &classIds, &classScores](uint32_t rowBegin, uint32_t rowEnd) {
+        TopKBand(scores, k, rowBegin, rowEnd, classIds, classScores);
+    });
+    return APP_ERR_OK;
+}
+}
@@ -0,0 +1,529 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: CTC decoding of text recognition outputs, greedy or with a prefix beam search.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/PostProcessBases/CtcDecoder.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "MxBase/Log/Log.h"
+#include "MxBase/Utils/DataTypeUtils.h"
+#include "MxBase/Utils/FileUtils.h"
+
+namespace {
+using namespace MxBase;
+
+const uint32_t MAX_BEAM_WIDTH = 1000;
+const int MAX_LEXICON_LINES = 1000000;
+const int32_t NO_NODE = -1;
+const uint32_t EDGE_KEY_SHIFT = 32;
+const float LOG_ZERO = -std::numeric_limits<float>::infinity();
+const float MIN_PROBABILITY = 1e-30f;
+
+/**
+ * Index of the highest of num values, the first one on ties like std::max_element. Lanes keep their own maximum and
+ * index, which are reduced by value and then by the lowest index.
+ */
+uint32_t RowArgmax(const float* row, uint32_t num, float& maxValue)
+{
+    uint32_t i = 0;
+    uint32_t best = 0;
+    float bestValue = row[0];
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    const uint32_t lanes = 4;
+    if (num >= lanes) {
+        float32x4_t laneMax = vld1q_f32(row);
+        const uint32_t initIndex[lanes] = {0, 1, 2, 3};
+        uint32x4_t index = vld1q_u32(initIndex);
+        uint32x4_t laneIndex = index;
+        const uint32x4_t step = vdupq_n_u32(lanes);
+        for (i = lanes; i + lanes <= num; i += lanes) {
+            index = vaddq_u32(index, step);
+            float32x4_t value = vld1q_f32(row + i);
+            uint32x4_t greater = vcgtq_f32(value, laneMax);
+            laneMax = vbslq_f32(greater, value, laneMax);
+            laneIndex = vbslq_u32(greater, index, laneIndex);
+        }
+        float maxes[lanes];
+        uint32_t indexes[lanes];
+        vst1q_f32(maxes, laneMax);
+        vst1q_u32(indexes, laneIndex);
+        bestValue = maxes[0];
+        best = indexes[0];
+        for (uint32_t lane = 1; lane < lanes; lane++) {
+            if (maxes[lane] > bestValue || (maxes[lane] == bestValue && indexes[lane] < best)) {
+                bestValue = maxes[lane];
+                best = indexes[lane];
+            }
+        }
+    }
+#elif defined(__SSE2__)
+    const uint32_t lanes = 4;
+    if (num >= lanes) {
+        __m128 laneMax = _mm_loadu_ps(row);
+        __m128i index = _mm_set_epi32(0x3, 0x2, 0x1, 0x0);
+        __m128i laneIndex = index;
+        const __m128i step = _mm_set1_epi32(static_cast<int>(lanes));
+        for (i = lanes; i + lanes <= num; i += lanes) {
+            index = _mm_add_epi32(index, step);
+            __m128 value = _mm_loadu_ps(row + i);
+            __m128 greater = _mm_cmpgt_ps(value, laneMax);
+            __m128i greaterInt = _mm_castps_si128(greater);
+            laneMax = _mm_or_ps(_mm_and_ps(greater, value), _mm_andnot_ps(greater, laneMax));
+            laneIndex = _mm_or_si128(_mm_and_si128(greaterInt, index), _mm_andnot_si128(greaterInt, laneIndex));
+        }
+        float maxes[lanes];
+        uint32_t indexes[lanes];
+        _mm_storeu_ps(maxes, laneMax);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indexes), laneIndex);
+        bestValue = maxes[0];
+        best = indexes[0];
+        for (uint32_t lane = 1; lane < lanes; lane++) {
+            if (maxes[lane] > bestValue || (maxes[lane] == bestValue && indexes[lane] < best)) {
+                bestValue = maxes[lane];
+                best = indexes[lane];
+            }
+        }
+    }
+#endif
+    for (; i < num; i++) {
+        if (row[i] > bestValue) {
+            bestValue = row[i];
+            best = i;
+        }
+    }
+    maxValue = bestValue;
+    return best;
+}
+
+/**
+ * Time step t of an image as float. Float32 data is read in place, float16 is converted into the buffer.
+ */
+inline const float* LoadTimeStep(const CtcLogits& logits, size_t offset, std::vector<float>& buffer)
+{
+    if (logits.dataType == TENSOR_DTYPE_FLOAT32) {
+        return static_cast<const float*>(logits.data) + offset;
+    }
+    DataTypeUtils::Float16ToFloat32(buffer.data(), static_cast<const uint16_t*>(logits.data) + offset,
+                                    logits.classNum);
+    return buffer.data();
+}
+
+inline float LogAdd(float a, float b)
+{
+    if (a < b) {
+        std::swap(a, b);
+    }
+    if (b == LOG_ZERO) {
+        return a;
+    }
+    return a + std::log1p(std::exp(b - a));
+}
+
+APP_ERROR CheckLogits(const CtcLogits& logits)
+{
+    if (logits.data == nullptr) {
+        LogError << "The ctc logits are nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (logits.dataType != TENSOR_DTYPE_FLOAT32 && logits.dataType != TENSOR_DTYPE_FLOAT16) {
+        LogError << "The ctc logits type(" << logits.dataType << ") is not float32 or float16."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (logits.classNum == 0) {
+        LogError << "The class number of the ctc logits is 0." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    return APP_ERR_OK;
+}
+
+// a node of the prefix tree shared by the beams, a beam is the path from its node to the root
+struct PrefixNode {
+    int32_t parent = NO_NODE;
+    uint32_t classId = 0;
+    int32_t lexiconNode = 0;
+};
+
+struct Beam {
+    int32_t node = 0;
+    float blankScore = LOG_ZERO;      // log probability of the prefix with the last step a blank
+    float labelScore = LOG_ZERO;      // log probability of the prefix with the last step its last class
+    float Total() const
+    {
+        return LogAdd(blankScore, labelScore);
+    }
+};
+}
+
+namespace MxBase {
+APP_ERROR CtcDecoder::Init(const std::vector<std::string>& classNames, uint32_t blankIdx)
+{
+    blankIdx_ = blankIdx;
+    classText_.clear();
+    classOffsets_.assign(1, 0);
+    classIds_.clear();
+    maxClassLength_ = 0;
+    for (uint32_t c = 0; c < classNames.size(); c++) {
+        classText_ += classNames[c];
+        classOffsets_.push_back(static_cast<uint32_t>(classText_.size()));
+        if (c != blankIdx && !classNames[c].empty()) {
+            classIds_.emplace(classNames[c], c);
+            maxClassLength_ = std::max(maxClassLength_, classNames[c].size());
+        }
+    }
+    lexiconEdges_.clear();
+    lexiconWordEnds_.clear();
+    return APP_ERR_OK;
+}
+
+APP_ERROR CtcDecoder::SetLexicon(const std::vector<std::string>& words)
+{
+    lexiconEdges_.clear();
+    lexiconWordEnds_.clear();
+    if (words.empty()) {
+        return APP_ERR_OK;
+    }
+    if (classIds_.empty()) {
+        LogError << "The ctc decoder has no class names to split the lexicon with."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    lexiconWordEnds_.push_back(0);
+    std::vector<uint32_t> tokens;
+    size_t skipped = 0;
+    for (const auto& word : words) {
+        tokens.clear();
+        size_t pos = 0;
+        while (pos < word.size()) {
+            size_t length = std::min(maxClassLength_, word.size() - pos);
+            for (; length > 0; length--) {
+                auto iter = classIds_.find(word.substr(pos, length));
+                if (iter != classIds_.end()) {
+                    tokens.push_back(iter->second);
+                    break;
+                }
+            }
+            if (length == 0) {
+                break;
+            }
+            pos += length;
+        }
+        if (word.empty() || pos < word.size()) {
+            skipped++;
+            continue;
+        }
+        int32_t node = 0;
+        for (uint32_t classId : tokens) {
+            uint64_t key = (static_cast<uint64_t>(node) << EDGE_KEY_SHIFT) | classId;
+            auto iter = lexiconEdges_.find(key);
+            if (iter == lexiconEdges_.end()) {
+                int32_t child = static_cast<int32_t>(lexiconWordEnds_.size());
+                lexiconWordEnds_.push_back(0);
+                iter = lexiconEdges_.emplace(key, child).first;
+            }
+            node = iter->second;
+        }
+        lexiconWordEnds_[node] = 1;
+    }
+    if (skipped > 0) {
+        LogWarn << skipped << " lexicon words are not made of the class names and are skipped.";
+    }
+    if (skipped == words.size()) {
+        lexiconWordEnds_.clear();
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR CtcDecoder::LoadLexicon(const std::string& lexiconPath)
+{
+    std::string canonicalizedPath;
+    if (!FileUtils::RegularFilePath(lexiconPath, canonicalizedPath)) {
+        LogError << "Failed to get canonicalized lexicon path." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (!FileUtils::IsFileValid(canonicalizedPath, false)) {
+        LogError << "Invalid lexicon path." << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        return APP_ERR_COMM_FAILURE;
+    }
+    std::ifstream in(canonicalizedPath, std::ios_base::in);
+    if (in.fail()) {
+        LogError << "Failed to open lexicon file." << GetErrorInfo(APP_ERR_COMM_OPEN_FAIL);
+        return APP_ERR_COMM_OPEN_FAIL;
+    }
+    std::vector<std::string> words;
+    std::string word;
+    int lineNum = 0;
+    while (std::getline(in, word)) {
+        if (++lineNum > MAX_LEXICON_LINES) {
+            LogError << "The line num of the lexicon should be less than or equal to " << MAX_LEXICON_LINES << "."
+                     << GetErrorInfo(APP_ERR_COMM_OPEN_FAIL);
+            return APP_ERR_COMM_OPEN_FAIL;
+        }
+        size_t end = word.find_last_not_of("\r\n\t ");
+        if (end == std::string::npos) {
+            continue;
+        }
+        word.erase(end + 1);
+        words.push_back(word);
+    }
+    return SetLexicon(words);
+}
+
+void CtcDecoder::AppendClass(uint32_t classId, std::string& text) const
+{
+    if (classId + 1 < classOffsets_.size()) {
+        text.append(classText_, classOffsets_[classId], classOffsets_[classId + 1] - classOffsets_[classId]);
+    }
+}
+
+int32_t CtcDecoder::NextLexiconNode(int32_t node, uint32_t classId) const
+{
+    auto iter = lexiconEdges_.find((static_cast<uint64_t>(node) << EDGE_KEY_SHIFT) | classId);
+    return iter == lexiconEdges_.end() ? NO_NODE : iter->second;
+}
+
+std::string CtcDecoder::DecodeBestPath(const CtcLogits& logits, uint32_t batchIdx, std::vector<float>& buffer) const
+{
+    std::string text;
+    const size_t imageOffset = static_cast<size_t>(batchIdx) * logits.timeStep * logits.classNum;
+    uint32_t previous = blankIdx_;
+    for (uint32_t t = 0; t < logits.timeStep; t++) {
+        const float* row = LoadTimeStep(logits, imageOffset + static_cast<size_t>(t) * logits.classNum, buffer);
+        float maxValue = 0;
+        uint32_t classId = RowArgmax(row, logits.classNum, maxValue);
+        if (classId != blankIdx_ && classId != previous) {
+            AppendClass(classId, text);
+        }
+        previous = classId;
+    }
+    return text;
+}
+
+APP_ERROR CtcDecoder::GreedyDecode(const CtcLogits& logits, std::vector<std::string>& texts) const
+{
+    APP_ERROR ret = CheckLogits(logits);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    texts.resize(logits.batchSize);
+    std::vector<float> buffer(logits.classNum);
+    for (uint32_t b = 0; b < logits.batchSize; b++) {
+        texts[b] = DecodeBestPath(logits, b, buffer);
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR CtcDecoder::GreedyDecode(const int64_t* classIds, uint32_t batchSize, uint32_t timeStep,
+                                   std::vector<std::string>& texts) const
+{
+    if (classIds == nullptr) {
+        LogError << "The ctc class ids are nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    texts.resize(batchSize);
+    for (uint32_t b = 0; b < batchSize; b++) {
+        const int64_t* ids = classIds + static_cast<size_t>(b) * timeStep;
+        std::string& text = texts[b];
+        text.clear();
+        int64_t previous = blankIdx_;
+        for (uint32_t t = 0; t < timeStep; t++) {
+            bool inRange = ids[t] >= 0 && ids[t] <= std::numeric_limits<uint32_t>::max();
+            if (inRange && ids[t] != blankIdx_ && ids[t] != previous) {
+                AppendClass(static_cast<uint32_t>(ids[t]), text);
+            }
+            previous = ids[t];
+        }
+    }
+    return APP_ERR_OK;
+}
+
+/**
+ * Log probabilities of a time step and the classes worth extending the beams with, the blank excluded. The log
+ * softmax needs only one exp per class, and the candidates are found in the same pass.
+ */
+void CtcDecoder::ScoreTimeStep(const float* row, uint32_t classNum, const CtcBeamConfig& config,
+                               std::vector<float>& logProbs, std::vector<uint32_t>& candidates) const
+{
+    float maxValue = 0;
+    uint32_t argmax = RowArgmax(row, classNum, maxValue);
+    if (config.applySoftmax) {
+        float expSum = 0;
+        for (uint32_t c = 0; c < classNum; c++) {
+            expSum += std::exp(row[c] - maxValue);
+        }
+        const float logNorm = maxValue + std::log(expSum);
+        for (uint32_t c = 0; c < classNum; c++) {
+            logProbs[c] = row[c] - logNorm;
+        }
+    } else {
+        for (uint32_t c = 0; c < classNum; c++) {
+            logProbs[c] = std::log(std::max(row[c], MIN_PROBABILITY));
+        }
+    }
+    const float logThresh = std::log(std::max(config.pruneThresh, MIN_PROBABILITY));
+    candidates.clear();
+    for (uint32_t c = 0; c < classNum; c++) {
+        if (c != blankIdx_ && logProbs[c] >= logThresh) {
+            candidates.push_back(c);
+        }
+    }
+    if (candidates.empty() && argmax != blankIdx_) {
+        candidates.push_back(argmax);
+    }
+}
+
+std::string CtcDecoder::DecodeBeams(const CtcLogits& logits, uint32_t batchIdx, const CtcBeamConfig& config,
+                                    std::vector<float>& buffer) const
+{
+    const bool useLexicon = HasLexicon();
+    const size_t imageOffset = static_cast<size_t>(batchIdx) * logits.timeStep * logits.classNum;
+    std::vector<PrefixNode> nodes(1);
+    std::unordered_map<uint64_t, int32_t> children;
+    std::vector<Beam> beams(1);
+    beams[0].blankScore = 0;
+    std::vector<Beam> nextBeams;
+    std::unordered_map<int32_t, size_t> beamOfNode;
+    std::vector<float> logProbs(logits.classNum);
+    std::vector<uint32_t> candidates;
+    auto nextBeam = [&nextBeams, &beamOfNode](int32_t node) -> Beam& {
+        auto iter = beamOfNode.find(node);
+        if (iter != beamOfNode.end()) {
+            return nextBeams[iter->second];
+        }
+        beamOfNode.emplace(node, nextBeams.size());
+        nextBeams.emplace_back();
+        nextBeams.back().node = node;
+        return nextBeams.back();
+    };
+    auto childNode = [this, &nodes, &children, useLexicon](int32_t node, uint32_t classId) -> int32_t {
+        uint64_t key = (static_cast<uint64_t>(node) << EDGE_KEY_SHIFT) | classId;
+        auto iter = children.find(key);
+        if (iter != children.end()) {
+            return iter->second;
+        }
+        PrefixNode child;
+        child.parent = node;
+        child.classId = classId;
+        if (useLexicon) {
+            child.lexiconNode = NextLexiconNode(nodes[node].lexiconNode, classId);
+            if (child.lexiconNode == NO_NODE) {
+                return NO_NODE;
+            }
+        }
+        int32_t index = static_cast<int32_t>(nodes.size());
+        nodes.push_back(child);
+        children.emplace(key, index);
+        return index;
+    };
+    for (uint32_t t = 0; t < logits.timeStep; t++) {
+        const float* row = LoadTimeStep(logits, imageOffset + static_cast<size_t>(t) * logits.classNum, buffer);
+        ScoreTimeStep(row, logits.classNum, config, logProbs, candidates);
+        nextBeams.clear();
+        beamOfNode.clear();
+        for (const Beam& beam : beams) {
+            const float total = beam.Total();
+            if (blankIdx_ < logits.classNum) {
+                Beam& stay = nextBeam(beam.node);
+                stay.blankScore = LogAdd(stay.blankScore, total + logProbs[blankIdx_]);
+            }
+            const bool hasLast = beam.node != 0;
+            const uint32_t lastClass = nodes[beam.node].classId;
+            for (uint32_t classId : candidates) {
+                const float logProb = logProbs[classId];
+                if (hasLast && classId == lastClass) {
+                    // a repeat without a blank in between collapses into the same prefix
+                    Beam& stay = nextBeam(beam.node);
+                    stay.labelScore = LogAdd(stay.labelScore, beam.labelScore + logProb);
+                }
+                int32_t child = childNode(beam.node, classId);
+                if (child == NO_NODE) {
+                    continue;
+                }
+                float extendScore = (hasLast && classId == lastClass) ? beam.blankScore + logProb : total + logProb;
+                Beam& extend = nextBeam(child);
+                extend.labelScore = LogAdd(extend.labelScore, extendScore);
+            }
+        }
+        size_t keepNum = std::min(nextBeams.size(), static_cast<size_t>(config.beamWidth));
+        std::partial_sort(nextBeams.begin(), nextBeams.begin() + keepNum, nextBeams.end(),
+            [](const Beam& a, const Beam& b) {
+                float totalA = a.Total();
+                float totalB = b.Total();
+                return totalA > totalB || (totalA == totalB && a.node < b.node);
+            });
+        nextBeams.resize(keepNum);
+        beams.swap(nextBeams);
+        if (beams.empty()) {
+            break;
+        }
+    }
+    // the beams are sorted, so the first acceptable one is the best
+    int32_t bestNode = NO_NODE;
+    for (const Beam& beam : beams) {
+        if (!useLexicon || lexiconWordEnds_[nodes[beam.node].lexiconNode] != 0) {
+            bestNode = beam.node;
+            break;
+        }
+    }
+    if (bestNode == NO_NODE) {
+        return DecodeBestPath(logits, batchIdx, buffer);
+    }
+    std::vector<uint32_t> path;
+    for (int32_t node = bestNode; node > 0; node = nodes[node].parent) {
+        path.push_back(nodes[node].classId);
+    }
+    std::string text;
+    for (auto iter = path.rbegin(); iter != path.rend(); ++iter) {
+        AppendClass(*iter, text);
+    }
+    return text;
+}
+
+APP_ERROR CtcDecoder::BeamSearchDecode(const CtcLogits& logits, const CtcBeamConfig& config,
+                                       std::vector<std::string>& texts) const
+{
+    if (config.beamWidth <= 1 && !HasLexicon()) {
+        return GreedyDecode(logits, texts);
+    }
+    APP_ERROR ret = CheckLogits(logits);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    if (config.beamWidth == 0 || config.beamWidth > MAX_BEAM_WIDTH) {
+        LogError << "The beam width(" << config.beamWidth << ") is out of range [1, " << MAX_BEAM_WIDTH << "]."
+                 << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
+    }
+    texts.resize(logits.batchSize);
+    std::vector<float> buffer(logits.classNum);
+    for (uint32_t b = 0; b < logits.batchSize; b++) {
+        texts[b] = DecodeBeams(logits, b, config, buffer);
+    }
+    return APP_ERR_OK;
+}
+}
@@ -0,0 +1,386 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Peak finding and sampling on keypoint heatmaps, shared by the pose postprocessors.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/PostProcessBases/KeypointPeakFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "MxBase/Log/Log.h"
+
+namespace {
+using namespace MxBase;
+
+const float EPSILON = 1e-6;
+const float HALF = 0.5f;
+const double SQRT_TWO = 1.4142135623730951;
+const uint32_t TWO = 2;
+const uint32_t MAX_WINDOW = 255;
+
+// acc += k * src
+void Axpy(float* acc, const float* src, float k, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    const size_t lanes = 4;
+    float32x4_t kVec = vdupq_n_f32(k);
+    for (; i + lanes <= num; i += lanes) {
+        vst1q_f32(acc + i, vmlaq_f32(vld1q_f32(acc + i), vld1q_f32(src + i), kVec));
+    }
+#elif defined(__SSE2__)
+    const size_t lanes = 4;
+    __m128 kVec = _mm_set1_ps(k);
+    for (; i + lanes <= num; i += lanes) {
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), _mm_mul_ps(_mm_loadu_ps(src + i), kVec)));
+    }
+#endif
+    for (; i < num; i++) {
+        acc[i] += k * src[i];
+    }
+}
+
+// acc = max(acc, src)
+void MaxInto(float* acc, const float* src, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__) || defined(__ARM_NEON)
+    const size_t lanes = 4;
+    for (; i + lanes <= num; i += lanes) {
+        vst1q_f32(acc + i, vmaxq_f32(vld1q_f32(acc + i), vld1q_f32(src + i)));
+    }
+#elif defined(__SSE2__)
+    const size_t lanes = 4;
+    for (; i + lanes <= num; i += lanes) {
+        _mm_storeu_ps(acc + i, _mm_max_ps(_mm_loadu_ps(acc + i), _mm_loadu_ps(src + i)));
+    }
+#endif
+    for (; i < num; i++) {
+        acc[i] = std::max(acc[i], src[i]);
+    }
+}
+
+double NormalCdf(double x)
+{
+    return HALF * std::erfc(-x / SQRT_TWO);
+}
+
+// maximum of the window x window neighbourhood of every pixel, ignoring the pixels out of the map
+void MaxFilter(const float* plane, uint32_t width, uint32_t height, uint32_t window, std::vector<float>& dst)
+{
+    uint32_t radius = window / TWO;
+    std::vector<float> rowMax(static_cast<size_t>(width) * height);
+    std::vector<float> padded(width + TWO * radius, -std::numeric_limits<float>::infinity());
+    for (uint32_t y = 0; y < height; y++) {
+        const float* srcRow = plane + static_cast<size_t>(y) * width;
+        float* maxRow = rowMax.data() + static_cast<size_t>(y) * width;
+        std::copy(srcRow, srcRow + width, padded.begin() + radius);
+        std::copy(padded.begin(), padded.begin() + width, maxRow);
+        for (uint32_t t = 1; t < TWO * radius + 1; t++) {
+            MaxInto(maxRow, padded.data() + t, width);
+        }
+    }
+    dst.resize(rowMax.size());
+    for (uint32_t y = 0; y < height; y++) {
+        uint32_t begin = y > radius ? y - radius : 0;
+        uint32_t end = std::min(height, y + radius + 1);
+        float* dstRow = dst.data() + static_cast<size_t>(y) * width;
+        std::copy(rowMax.begin() + static_cast<size_t>(begin) * width,
+                  rowMax.begin() + static_cast<size_t>(begin + 1) * width, dstRow);
+        for (uint32_t row = begin + 1; row < end; row++) {
+            MaxInto(dstRow, rowMax.data() + static_cast<size_t>(row) * width, width);
+        }
+    }
+}
+
+APP_ERROR CheckPlane(const float* plane, uint32_t width, uint32_t height, uint32_t window)
+{
+    if (plane == nullptr && width != 0 && height != 0) {
+        LogError << "The heatmap is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    if (window % TWO == 0 || window > MAX_WINDOW) {
+        LogError << "The window(" << window << ") must be odd and not larger than " << MAX_WINDOW << "."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    return APP_ERR_OK;
+}
+
+// offset of the vertex of the parabola through (-1, left), (0, center), (1, right)
+inline float QuadraticOffset(float left, float center, float right)
+{
+    float curvature = left - TWO * center + right;
+    if (curvature > -EPSILON) {
+        return 0;
+    }
+    return std::max(-HALF, std::min(HALF, HALF * (left - right) / curvature));
+}
+}
+
+namespace MxBase {
+APP_ERROR KeypointPeakFinder::MakeGaussianKernel(uint32_t size, float sigma, float scale, std::vector<float>& kernel)
+{
+    if (size == 0 || !(scale > 0)) {
+        LogError << "Invalid gaussian kernel size(" << size << ") or scale(" << scale << ")."
+                 << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
+    }
+    // the same cdf sampling as the 2-D kernel of OpenPose, whose entries are sqrt(kern1D[i] * kern1D[j])
+    double interval = (TWO * sigma + 1) / static_cast<double>(size);
+    double step = (TWO * sigma + interval) / static_cast<double>(size);
+    double start = -sigma - interval / TWO;
+    std::vector<double> fine(size);
+    for (uint32_t i = 0; i < size; i++) {
+        fine[i] = std::sqrt(std::max(0.0, NormalCdf(start + (i + 1) * step) - NormalCdf(start + i * step)));
+    }
+
+    // fine tap i covers [i - anchor - 0.5, i - anchor + 0.5] and coarse tap j covers [j - 0.5, j + 0.5] * scale
+    int anchor = static_cast<int>(size / TWO);
+    double reach = std::max(anchor, static_cast<int>(size) - 1 - anchor) + HALF;
+    int radius = static_cast<int>(std::ceil(reach / scale - HALF));
+    kernel.assign(TWO * radius + 1, 0.f);
+    double kernelSum = 0;
+    for (int j = -radius; j <= radius; j++) {
+        double begin = (j - HALF) * scale;
+        double end = (j + HALF) * scale;
+        double value = 0;
+        for (uint32_t i = 0; i < size; i++) {
+            double center = static_cast<double>(static_cast<int>(i) - anchor);
+            double overlap = std::min(end, center + HALF) - std::max(begin, center - HALF);
+            value += overlap > 0 ? fine[i] * overlap : 0;
+        }
+        kernel[j + radius] = static_cast<float>(value);
+        kernelSum += value;
+    }
+    if (kernelSum < EPSILON) {
+        LogError << "The gaussian kernel sums to 0, sigma(" << sigma << ")." << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
+    }
+    for (auto& value : kernel) {
+        value = static_cast<float>(value / kernelSum);
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR KeypointPeakFinder::GaussianBlur(const HeatmapPlane& src, const std::vector<float>& kernelX,
+                                           const std::vector<float>& kernelY, std::vector<float>& dst)
+{
+    if (kernelX.size() % TWO == 0 || kernelY.size() % TWO == 0) {
+        LogError << "The gaussian kernel size must be odd." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    APP_ERROR ret = CheckPlane(src.data, src.width, src.height, 1);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    uint32_t width = src.width;
+    uint32_t height = src.height;
+    uint32_t radiusX = static_cast<uint32_t>(kernelX.size() / TWO);
+    int radiusY = static_cast<int>(kernelY.size() / TWO);
+
+    // horizontal pass on a zero padded copy of every row, one multiply add over the row per tap
+    std::vector<float> rows(static_cast<size_t>(width) * height, 0.f);
+    std::vector<float> padded(width + TWO * radiusX, 0.f);
+    for (uint32_t y = 0; y < height; y++) {
+        const float* srcRow = src.data + static_cast<size_t>(y) * width * src.pixelStride;
+        for (uint32_t x = 0; x < width; x++) {
+            padded[radiusX + x] = srcRow[static_cast<size_t>(x) * src.pixelStride];
+        }
+        float* row = rows.data() + static_cast<size_t>(y) * width;
+        for (size_t t = 0; t < kernelX.size(); t++) {
+            Axpy(row, padded.data() + t, kernelX[t], width);
+        }
+    }
+
+    // vertical pass, rows out of the map are zeros
+    dst.assign(static_cast<size_t>(width) * height, 0.f);
+    for (int y = 0; y < static_cast<int>(height); y++) {
+        float* dstRow = dst.data() + static_cast<size_t>(y) * width;
+        for (int t = -radiusY; t <= radiusY; t++) {
+            int srcY = y + t;
+            if (srcY < 0 || srcY >= static_cast<int>(height)) {
+                continue;
+            }
+            Axpy(dstRow, rows.data() + static_cast<size_t>(srcY) * width, kernelY[t + radiusY], width);
+        }
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR KeypointPeakFinder::SuppressNonMaximum(float* plane, uint32_t width, uint32_t height, uint32_t window)
+{
+    APP_ERROR ret = CheckPlane(plane, width, height, window);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::vector<float> maxMap;
+    MaxFilter(plane, width, height, window, maxMap);
+    for (size_t i = 0; i < maxMap.size(); i++) {
+        plane[i] = (plane[i] >= maxMap[i] && plane[i] > 0) ? plane[i] : 0.f;
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR KeypointPeakFinder::FindPeaks(const float* plane, uint32_t width, uint32_t height, float threshold,
+                                        uint32_t window, bool refine, std::vector<HeatmapPeak>& peaks)
+{
+    APP_ERROR ret = CheckPlane(plane, width, height, window);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::vector<float> maxMap;
+    MaxFilter(plane, width, height, window, maxMap);
+    for (uint32_t y = 0; y < height; y++) {
+        const float* row = plane + static_cast<size_t>(y) * width;
+        const float* maxRow = maxMap.data() + static_cast<size_t>(y) * width;
+        for (uint32_t x = 0; x < width; x++) {
+            if (row[x] <= threshold || row[x] < maxRow[x]) {
+                continue;
+            }
+            HeatmapPeak peak;
+            peak.x = static_cast<float>(x);
+            peak.y = static_cast<float>(y);
+            peak.score = row[x];
+            peak.index = y * width + x;
+            if (refine && x > 0 && x + 1 < width) {
+                peak.x += QuadraticOffset(row[x - 1], row[x], row[x + 1]);
+            }
+            if (refine && y > 0 && y + 1 < height) {
+                peak.y += QuadraticOffset((row - width)[x], row[x], (row + width)[x]);
+            }
+            peaks.push_back(peak);
+        }
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR KeypointPeakFinder::ResizeBilinear(const float* src, uint32_t srcWidth, uint32_t srcHeight, float* dst,
+                                             uint32_t dstWidth, uint32_t dstHeight)
+{
+    if (dstWidth == 0 || dstHeight == 0) {
+        return APP_ERR_OK;
+    }
+    if (src == nullptr || dst == nullptr || srcWidth == 0 || srcHeight == 0) {
+        LogError << "Invalid source or destination of the bilinear resize." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    auto mapCoordinate = [](uint32_t dstPos, uint32_t srcSize, uint32_t dstSize, uint32_t& pos0, uint32_t& pos1,
+                            float& weight) {
+        float pos = (dstPos + HALF) * static_cast<float>(srcSize) / static_cast<float>(dstSize) - HALF;
+        pos = std::max(0.f, std::min(pos, static_cast<float>(srcSize - 1)));
+        pos0 = static_cast<uint32_t>(pos);
+        pos1 = std::min(pos0 + 1, srcSize - 1);
+        weight = pos - static_cast<float>(pos0);
+    };
+    std::vector<uint32_t> x0(dstWidth);
+    std::vector<uint32_t> x1(dstWidth);
+    std::vector<float> wx(dstWidth);
+    for (uint32_t x = 0; x < dstWidth; x++) {
+        mapCoordinate(x, srcWidth, dstWidth, x0[x], x1[x], wx[x]);
+    }
+    // source rows interpolated horizontally, the last two are kept as adjacent destination rows share them
+    std::vector<float> upper(dstWidth);
+    std::vector<float> lower(dstWidth);
+    uint32_t upperY = UINT32_MAX;
+    uint32_t lowerY = UINT32_MAX;
+    auto interpolateRow = [&](uint32_t srcY, std::vector<float>& row) {
+        const float* srcRow = src + static_cast<size_t>(srcY) * srcWidth;
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            row[x] = srcRow[x0[x]] + wx[x] * (srcRow[x1[x]] - srcRow[x0[x]]);
+        }
+    };
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        uint32_t y0 = 0;
+        uint32_t y1 = 0;
+        float wy = 0;
+        mapCoordinate(y, srcHeight, dstHeight, y0, y1, wy);
+        if (y0 != upperY) {
+            if (y0 == lowerY) {
+                upper.swap(lower);
+                std::swap(upperY, lowerY);
+            } else {
+                interpolateRow(y0, upper);
+                upperY = y0;
+            }
+        }
+        if (y1 != lowerY) {
+            interpolateRow(y1, lower);
+            lowerY = y1;
+        }
+        float* dstRow = dst + static_cast<size_t>(y) * dstWidth;
+        std::copy(upper.begin(), upper.end(), dstRow);
+        Axpy(dstRow, lower.data(), wy, dstWidth);
+        Axpy(dstRow, upper.data(), -wy, dstWidth);
+    }
+    return APP_ERR_OK;
+}
+
+float KeypointPeakFinder::SampleBilinear(const HeatmapPlane& plane, float x, float y)
+{
+    if (plane.data == nullptr || plane.width == 0 || plane.height == 0) {
+        return 0.f;
+    }
+    x = std::max(0.f, std::min(x, static_cast<float>(plane.width - 1)));
+    y = std::max(0.f, std::min(y, static_cast<float>(plane.height - 1)));
+    uint32_t x0 = static_cast<uint32_t>(x);
+    uint32_t y0 = static_cast<uint32_t>(y);
+    uint32_t x1 = std::min(x0 + 1, plane.width - 1);
+    uint32_t y1 = std::min(y0 + 1, plane.height - 1);
+    float wx = x - static_cast<float>(x0);
+    float wy = y - static_cast<float>(y0);
+    auto at = [&plane](uint32_t px, uint32_t py) {
+        return plane.data[(static_cast<size_t>(py) * plane.width + px) * plane.pixelStride];
+    };
+    float top = at(x0, y0) + wx * (at(x1, y0) - at(x0, y0));
+    float bottom = at(x0, y1) + wx * (at(x1, y1) - at(x0, y1));
+    return top + wy * (bottom - top);
+}
+
+LimbScore KeypointPeakFinder::ScoreLimb(const HeatmapPlane& fieldX, const HeatmapPlane& fieldY, float x0, float y0,
+                                        float x1, float y1, uint32_t sampleNum, float hitThresh)
+{
+    LimbScore limbScore;
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float norm = std::sqrt(dx * dx + dy * dy);
+    if (norm < EPSILON || sampleNum == 0) {
+        return limbScore;
+    }
+    float dirX = dx / norm;
+    float dirY = dy / norm;
+    float sum = 0;
+    for (uint32_t i = 0; i < sampleNum; i++) {
+        float t = static_cast<float>(i) / static_cast<float>(sampleNum);
+        float x = x0 + t * dx;
+        float y = y0 + t * dy;
+        float projection = dirX * SampleBilinear(fieldX, x, y) + dirY * SampleBilinear(fieldY, x, y);
+        sum += projection;
+        limbScore.hitNum += projection > hitThresh ? 1 : 0;
+    }
+    limbScore.score = sum / static_cast<float>(sampleNum);
+    return limbScore;
+}
+}
@@ -0,0 +1,175 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Contiguous label map of the semantic segmentation results.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/PostProcessBases/PostProcessDataType.h"
+
+namespace {
+const uint32_t UINT8_CLASS_NUM = 256;
+const uint32_t UINT16_ELEM_SIZE = 2;
+const int64_t COCO_RLE_CHUNK_BITS = 5;
+const int64_t COCO_RLE_CHUNK_MASK = 0x1f;
+const int64_t COCO_RLE_SIGN_BIT = 0x10;
+const int64_t COCO_RLE_MORE_BIT = 0x20;
+const char COCO_RLE_CHAR_BASE = 48;
+const size_t COCO_RLE_DELTA_START = 2;
+
+template<typename T>
+void ResizeRows(const MxBase::SegLabelMap& src, MxBase::SegLabelMap& dst, const std::vector<uint32_t>& xTable,
+                uint32_t srcHeight)
+{
+    const T* srcData = reinterpret_cast<const T*>(src.data.data());
+    T* dstData = reinterpret_cast<T*>(&dst.data[0]);
+    for (uint32_t y = 0; y < dst.height; y++) {
+        T* dstRow = dstData + static_cast<size_t>(y) * dst.stride;
+        uint32_t srcY = static_cast<uint32_t>(static_cast<uint64_t>(y) * srcHeight / dst.height);
+        if (srcY >= src.height) {
+            continue;
+        }
+        const T* srcRow = srcData + static_cast<size_t>(srcY) * src.stride;
+        for (uint32_t x = 0; x < dst.width; x++) {
+            dstRow[x] = xTable[x] < src.width ? srcRow[xTable[x]] : 0;
+        }
+    }
+}
+
+template<typename T>
+std::vector<std::vector<int>> RowsToPixels(const MxBase::SegLabelMap& labels)
+{
+    std::vector<std::vector<int>> pixels(labels.height);
+    const T* data = reinterpret_cast<const T*>(labels.data.data());
+    for (uint32_t y = 0; y < labels.height; y++) {
+        const T* row = data + static_cast<size_t>(y) * labels.stride;
+        pixels[y].assign(row, row + labels.width);
+    }
+    return pixels;
+}
+}
+
+namespace MxBase {
+SegLabelMap::SegLabelMap(uint32_t width, uint32_t height, uint32_t classNum)
+{
+    Reset(width, height, classNum);
+}
+
+void SegLabelMap::Reset(uint32_t width, uint32_t height, uint32_t classNum)
+{
+    this->width = width;
+    this->height = height;
+    stride = width;
+    elemSize = classNum <= UINT8_CLASS_NUM ? 1 : UINT16_ELEM_SIZE;
+    data.assign(static_cast<size_t>(stride) * height * elemSize, '\0');
+}
+
+SegLabelMap SegLabelMap::ResizeNearest(uint32_t dstWidth, uint32_t dstHeight, uint32_t srcWidth,
+                                       uint32_t srcHeight) const
+{
+    SegLabelMap dst;
+    dst.width = dstWidth;
+    dst.height = dstHeight;
+    dst.stride = dstWidth;
+    dst.elemSize = elemSize;
+    dst.data.assign(static_cast<size_t>(dstWidth) * dstHeight * elemSize, '\0');
+    if (dstWidth == 0 || dstHeight == 0) {
+        return dst;
+    }
+    std::vector<uint32_t> xTable(dstWidth);
+    for (uint32_t x = 0; x < dstWidth; x++) {
+        xTable[x] = static_cast<uint32_t>(static_cast<uint64_t>(x) * srcWidth / dstWidth);
+    }
+    if (elemSize == 1) {
+        ResizeRows<uint8_t>(*this, dst, xTable, srcHeight);
+    } else {
+        ResizeRows<uint16_t>(*this, dst, xTable, srcHeight);
+    }
+    return dst;
+}
+
+std::vector<std::vector<int>> SegLabelMap::ToPixels() const
+{
+    return elemSize == 1 ? RowsToPixels<uint8_t>(*this) : RowsToPixels<uint16_t>(*this);
+}
+
+std::vector<uint32_t> SegLabelMap::EncodeRle() const
+{
+    std::vector<uint32_t> runs;
+    if (width == 0 || height == 0) {
+        return runs;
+    }
+    uint32_t current = At(0, 0);
+    uint32_t length = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t label = At(x, y);
+            if (label != current) {
+                runs.push_back(current);
+                runs.push_back(length);
+                current = label;
+                length = 0;
+            }
+            length++;
+        }
+    }
+    runs.push_back(current);
+    runs.push_back(length);
+    return runs;
+}
+
+std::string SegLabelMap::EncodeCocoRle(uint32_t classId) const
+{
+    // run lengths in column major order, alternating background and foreground and starting with background
+    std::vector<int64_t> counts;
+    bool inside = false;
+    int64_t length = 0;
+    for (uint32_t x = 0; x < width; x++) {
+        for (uint32_t y = 0; y < height; y++) {
+            bool isClass = At(x, y) == classId;
+            if (isClass != inside) {
+                counts.push_back(length);
+                inside = isClass;
+                length = 0;
+            }
+            length++;
+        }
+    }
+    counts.push_back(length);
+
+    // the same string compression as rleToString of the coco api
+    std::string result;
+    for (size_t i = 0; i < counts.size(); i++) {
+        int64_t value = counts[i];
+        if (i > COCO_RLE_DELTA_START) {
+            value -= counts[i - COCO_RLE_DELTA_START];
+        }
+        bool more = true;
+        while (more) {
+            int64_t chunk = value & COCO_RLE_CHUNK_MASK;
+            value >>= COCO_RLE_CHUNK_BITS;
+            more = (chunk & COCO_RLE_SIGN_BIT) ? value != -1 : value != 0;
+            if (more) {
+                chunk |= COCO_RLE_MORE_BIT;
+            }
+            result.push_back(static_cast<char>(chunk + COCO_RLE_CHAR_BASE));
+        }
+    }
+    return result;
+}
+}
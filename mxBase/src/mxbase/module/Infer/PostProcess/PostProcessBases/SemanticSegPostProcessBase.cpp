@@ -28,6 +28,7 @@
 namespace MxBase {
 const int MAX_IMAGE_EDGE = 8192;
 const int MAX_RATIO = 16;
+const uint32_t MAX_ARGMAX_THREAD_NUM = 64;
 SemanticSegPostProcessBase& SemanticSegPostProcessBase::operator=(const SemanticSegPostProcessBase &other)
 {
     if (this == &other) {
@@ -38,6 +39,8 @@ SemanticSegPostProcessBase& SemanticSegPostProcessBase::operator=(const Semantic
     cropRoiBoxes_ = other.cropRoiBoxes_;
     classNum_ = other.classNum_;
     modelType_ = other.modelType_;
+    outputPixels_ = other.outputPixels_;
+    argmaxThreadNum_ = other.argmaxThreadNum_;
 
     return *this;
 }
@@ -55,6 +58,16 @@ APP_ERROR SemanticSegPostProcessBase::GetSemanticSegConfigData()
         LogWarn << GetErrorInfo(ret) << "Fail to read MODEL_TYPE from config, default value(" << modelType_
                 << ") will be used as modelType_.";
     }
+    ret = configData_.GetFileValue<bool>("OUTPUT_PIXELS", outputPixels_);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read OUTPUT_PIXELS from config, default value(" << outputPixels_
+                 << ") will be used as outputPixels_.";
+    }
+    ret = configData_.GetFileValue<uint32_t>("ARGMAX_THREAD_NUM", argmaxThreadNum_, 1, MAX_ARGMAX_THREAD_NUM);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read ARGMAX_THREAD_NUM from config, default value(" << argmaxThreadNum_
+                 << ") will be used as argmaxThreadNum_.";
+    }
 
     for (uint32_t i = 0; i < classNum_; i++) {
         labelMap_.push_back(configData_.GetClassName(i));
@@ -120,6 +133,11 @@ void SemanticSegPostProcessBase::CoordinatesReduction(const ResizedImageInfo& re
         resizedHeight = (uint32_t)(imgHeight * keepAspectRatioScaling);
         resizedWidth = (uint32_t)(imgWidth * keepAspectRatioScaling);
     }
+    if (!semanticSegInfo.labels.Empty()) {
+        semanticSegInfo.labels = semanticSegInfo.labels.ResizeNearest(imgWidth, imgHeight, resizedWidth,
+                                                                      resizedHeight);
+        return;
+    }
     std::vector<std::vector<int>> resultPixels(imgHeight, std::vector<int>(imgWidth));
     for (uint32_t y = 0; y < imgHeight; y++) {
         for (uint32_t x = 0; x < imgWidth; x++) {
@@ -133,6 +151,14 @@ void SemanticSegPostProcessBase::CoordinatesReduction(const ResizedImageInfo& re
     semanticSegInfo.pixels = resultPixels;
 }
 
+void SemanticSegPostProcessBase::FillSemanticSegInfo(SemanticSegInfo& semanticSegInfo) const
+{
+    if (outputPixels_) {
+        semanticSegInfo.pixels = semanticSegInfo.labels.ToPixels();
+    }
+    semanticSegInfo.labelMap = labelMap_;
+}
+
 APP_ERROR SemanticSegPostProcessBase::Process(const std::vector<TensorBase>&,
                                               std::vector<SemanticSegInfo>&,
                                               const std::vector<ResizedImageInfo>&,
@@ -21,9 +21,13 @@
  */
 
 #include "MxBase/DeviceManager/DeviceManager.h"
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <cstring>
+#include <sstream>
 #include "acl/acl.h"
 #include "acl/acl_base.h"
 #include "MxBase/Log/Log.h"
@@ -32,6 +36,14 @@
 
 namespace {
 const std::string MXBASE_LIB_PATH = "/lib/libmxbase.so";
+const std::string NUMA_NODE_PATH = "/sys/devices/system/node/node";
+
+// device of the acl context set on the thread by DeviceManager, valid while the generation is the current one
+struct ThreadBinding {
+    uint64_t generation = 0;
+    int32_t deviceId = -1;
+};
+thread_local ThreadBinding g_threadBinding;
 
 bool UserPermissionCheck()
 {
@@ -226,21 +238,25 @@ APP_ERROR DeviceManager::DestroyDevices()
     }
 
     LogInfo << "DestroyDevices begin";
-    for (auto item : contexts_) {
-        LogDebug << "destroy device:" << item.first;
-        ret = aclrtDestroyContext(item.second.get());
+    generation_++;
+    for (uint32_t i = 0; i < MAX_DEVICE_NUM; i++) {
+        aclrtContext context = contexts_[i].exchange(nullptr, std::memory_order_acq_rel);
+        if (context == nullptr) {
+            continue;
+        }
+        LogDebug << "destroy device:" << i;
+        ret = aclrtDestroyContext(context);
         if (ret != APP_ERR_OK) {
             LogError << "aclrtDestroyContext failed." << GetErrorInfo(ret, "aclrtDestroyContext");
             deInitRet = APP_ERR_ACL_FAILURE;
         }
-        ret = aclrtResetDevice(item.first);
+        ret = aclrtResetDevice(static_cast<int32_t>(i));
         if (ret != APP_ERR_OK) {
             LogError << "aclrtResetDevice failed." << GetErrorInfo(ret, "aclrtResetDevice");
             deInitRet = APP_ERR_ACL_FAILURE;
         }
         LogDebug << "aclrtDestroyContext finished!";
     }
-    contexts_.clear();
 
     ret = aclFinalize();
     if (ret != APP_ERR_OK) {
@@ -271,7 +287,6 @@ APP_ERROR DeviceManager::GetDevicesCount(uint32_t& deviceCount)
  */
 APP_ERROR DeviceManager::GetCurrentDevice(DeviceContext& device)
 {
-    std::lock_guard<std::mutex> lock(mtx_);
     aclrtContext currentContext = nullptr;
     APP_ERROR ret = aclrtGetCurrentContext(&currentContext);
     if (ret != APP_ERR_OK) {
@@ -280,9 +295,9 @@ APP_ERROR DeviceManager::GetCurrentDevice(DeviceContext& device)
         return APP_ERR_ACL_FAILURE;
     }
 
-    for (const auto &item : contexts_) {
-        if (item.second.get() == currentContext) {
-            device.devId = item.first;
+    for (uint32_t i = 0; i < MAX_DEVICE_NUM; i++) {
+        if (currentContext != nullptr && contexts_[i].load(std::memory_order_acquire) == currentContext) {
+            device.devId = static_cast<int32_t>(i);
             device.devStatus = DeviceContext::DeviceStatus::USING;
             return APP_ERR_OK;
         }
@@ -298,6 +313,11 @@ APP_ERROR DeviceManager::GetCurrentDevice(DeviceContext& device)
  */
 APP_ERROR DeviceManager::SetDevice(DeviceContext device)
 {
+    // streaming threads set the device of their element for every buffer, once bound there is nothing to do
+    if (g_threadBinding.deviceId == device.devId &&
+        g_threadBinding.generation == generation_.load(std::memory_order_acquire)) {
+        return APP_ERR_OK;
+    }
     if (!IsInitDevices()) {
         APP_ERROR ret = InitDevices();
         if (ret != APP_ERR_OK) {
@@ -305,38 +325,134 @@ APP_ERROR DeviceManager::SetDevice(DeviceContext device)
             return ret;
         }
     }
+    return BindThread(device.devId);
+}
+
+void DeviceManager::InvalidateThreadBinding()
+{
+    g_threadBinding = ThreadBinding();
+}
+
+APP_ERROR DeviceManager::BindThread(int32_t deviceId)
+{
     std::lock_guard<std::mutex> lock(mtx_);
-    auto deviceId = device.devId;
     APP_ERROR ret = CheckDeviceId(deviceId);
     if (ret != APP_ERR_OK) {
         LogError << "Device Id is out of range[0, " << deviceCount_ << ")." << GetErrorInfo(ret);
         return ret;
     }
-    if (contexts_.find(device.devId) == contexts_.end()) {
-        APP_ERROR ret = aclrtSetDevice(device.devId);
+    if (deviceId >= static_cast<int32_t>(MAX_DEVICE_NUM)) {
+        LogError << "Device Id is out of range[0, " << MAX_DEVICE_NUM << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    aclrtContext context = contexts_[deviceId].load(std::memory_order_acquire);
+    if (context == nullptr) {
+        ret = aclrtSetDevice(deviceId);
         if (ret != APP_ERR_OK) {
             LogError << "Calling aclrtSetDevice failed." << GetErrorInfo(ret, "aclrtSetDevice");
             return APP_ERR_ACL_FAILURE;
         }
-        aclrtContext newContext = nullptr;
-        ret = aclrtCreateContext(&newContext, device.devId);
+        ret = aclrtCreateContext(&context, deviceId);
         if (ret != APP_ERR_OK) {
             LogError << "Calling aclrtCreateContext failed." << GetErrorInfo(ret, "aclrtCreateContext");
             return APP_ERR_ACL_FAILURE;
         }
-        std::shared_ptr<void> context(newContext, [] (void *) {});
-        contexts_[device.devId] = context;
+        contexts_[deviceId].store(context, std::memory_order_release);
     } else {
-        APP_ERROR ret = aclrtSetCurrentContext(contexts_[deviceId].get());
+        ret = aclrtSetCurrentContext(context);
         if (ret != APP_ERR_OK) {
             LogError << "Calling aclrtSetCurrentContext failed."
                      << GetErrorInfo(ret, "aclrtSetCurrentContext");
             return APP_ERR_ACL_FAILURE;
         }
     }
+    g_threadBinding.generation = generation;
+    g_threadBinding.deviceId = deviceId;
+    SetThreadAffinity(deviceId);
+    return APP_ERR_OK;
+}
+
+void DeviceManager::SetThreadAffinity(int32_t deviceId)
+{
+    auto iter = affinities_.find(deviceId);
+    if (iter == affinities_.end()) {
+        return;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (auto cpuId : iter->second) {
+        CPU_SET(cpuId, &cpuSet);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (ret != 0) {
+        LogWarn << "Failed to set the cpu affinity of the thread bound to device(" << deviceId << "), error("
+                << ret << ").";
+    }
+}
+
+/**
+ * @description: set the cpus of the threads bound to a device
+ * @param: deviceId, cpuIds
+ * @return: set_device_affinity_result
+ */
+APP_ERROR DeviceManager::SetDeviceAffinity(int32_t deviceId, const std::vector<uint32_t>& cpuIds)
+{
+    if (deviceId < 0 || deviceId >= static_cast<int32_t>(MAX_DEVICE_NUM)) {
+        LogError << "Device Id is out of range[0, " << MAX_DEVICE_NUM << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    for (auto cpuId : cpuIds) {
+        if (cpuId >= CPU_SETSIZE) {
+            LogError << "The cpu(" << cpuId << ") is out of range[0, " << CPU_SETSIZE << ")."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (cpuIds.empty()) {
+        affinities_.erase(deviceId);
+    } else {
+        affinities_[deviceId] = cpuIds;
+    }
+    // the threads already bound to the device take the affinity when they bind again
+    generation_++;
     return APP_ERR_OK;
 }
 
+/**
+ * @description: get the cpus of a numa node from its cpu list, such as "0-23,48-71"
+ * @param: numaNode, cpuIds
+ * @return: get_numa_node_cpus_result
+ */
+APP_ERROR DeviceManager::GetNumaNodeCpus(uint32_t numaNode, std::vector<uint32_t>& cpuIds)
+{
+    std::ifstream file(NUMA_NODE_PATH + std::to_string(numaNode) + "/cpulist");
+    std::string cpuList;
+    if (!file.is_open() || !std::getline(file, cpuList)) {
+        LogError << "Failed to read the cpus of numa node(" << numaNode << ")." << GetErrorInfo(APP_ERR_COMM_NO_EXIST);
+        return APP_ERR_COMM_NO_EXIST;
+    }
+    cpuIds.clear();
+    std::stringstream ranges(cpuList);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        unsigned int first = 0;
+        unsigned int last = 0;
+        int num = sscanf(range.c_str(), "%u-%u", &first, &last);
+        if (num < 1) {
+            continue;
+        }
+        last = num == 1 ? first : last;
+        for (unsigned int cpuId = first; cpuId <= last && cpuId < CPU_SETSIZE; cpuId++) {
+            cpuIds.push_back(cpuId);
+        }
+    }
+    return cpuIds.empty() ? APP_ERR_COMM_NO_EXIST : APP_ERR_OK;
+}
+
 /**
  * @description: check device id
  * @param: deviceId
@@ -0,0 +1,310 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Elastic channel pool of one dvpp channel type on one device.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "DvppChnPool.h"
+#include <algorithm>
+#include <chrono>
+#include "MxBase/Log/Log.h"
+
+namespace MxBase {
+namespace {
+    int64_t NowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+    DvppChnPool::DvppChnPool(const std::string& name, const DvppChnPoolCfg& cfg, CreateChnFunc createFunc,
+                             DestroyChnFunc destroyFunc)
+        : name_(name), cfg_(cfg), createFunc_(std::move(createFunc)), destroyFunc_(std::move(destroyFunc))
+    {
+        cfg_.maxChnNum = std::max(cfg_.maxChnNum, cfg_.minChnNum);
+        lastShrinkMs_ = NowMs();
+    }
+
+    APP_ERROR DvppChnPool::Init()
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        for (uint32_t i = 0; i < cfg_.minChnNum; i++) {
+            DvppChnSlot* slot = nullptr;
+            APP_ERROR ret = GrowLocked(slot);
+            if (ret != APP_ERR_OK) {
+                LogError << "Failed to create " << name_ << " channel " << i << " of " << cfg_.minChnNum << "."
+                         << GetErrorInfo(ret);
+                return APP_ERR_COMM_INIT_FAIL;
+            }
+            slot->state = DVPP_CHN_POOLED;
+            pooledSlots_.push_back(slot);
+        }
+        growCount_ = 0;
+        LogInfo << "Initialized " << name_ << " channel pool successful, pool size: " << chnNum_
+                << ", max size: " << cfg_.maxChnNum << ".";
+        return APP_ERR_OK;
+    }
+
+    APP_ERROR DvppChnPool::DeInit()
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stopped_ = true;
+        cond_.notify_all();
+        APP_ERROR deInitRet = APP_ERR_OK;
+        uint32_t inUseNum = 0;
+        for (auto& slot : slots_) {
+            int state = DVPP_CHN_CACHED;
+            if (!slot->state.compare_exchange_strong(state, DVPP_CHN_DESTROYED) && state != DVPP_CHN_POOLED) {
+                inUseNum += (state == DVPP_CHN_IN_USE) ? 1 : 0;
+                continue;
+            }
+            slot->state = DVPP_CHN_DESTROYED;
+            APP_ERROR ret = destroyFunc_(slot->chnId);
+            if (ret != APP_ERR_OK) {
+                LogError << "Failed to destroy " << name_ << " channel(" << slot->chnId << ")." << GetErrorInfo(ret);
+                deInitRet = APP_ERR_COMM_FAILURE;
+            }
+        }
+        if (inUseNum > 0) {
+            LogWarn << inUseNum << " " << name_ << " channels are still in use and not destroyed.";
+        }
+        pooledSlots_.clear();
+        chnSlots_.clear();
+        chnNum_ = 0;
+        return deInitRet;
+    }
+
+    void DvppChnPool::OnTaken(DvppChnSlot* slot)
+    {
+        slot->getTimeUs = NowUs();
+        slot->useCount++;
+        getCount_++;
+    }
+
+    bool DvppChnPool::TakeCached(DvppChnSlot* slot)
+    {
+        int state = DVPP_CHN_CACHED;
+        if (!slot->state.compare_exchange_strong(state, DVPP_CHN_IN_USE)) {
+            return false;
+        }
+        OnTaken(slot);
+        cacheHitCount_++;
+        return true;
+    }
+
+    APP_ERROR DvppChnPool::GrowLocked(DvppChnSlot*& slot)
+    {
+        hi_s32 chnId = nextChnId_;
+        APP_ERROR ret = createFunc_(chnId);
+        if (ret != APP_ERR_OK) {
+            return ret;
+        }
+        nextChnId_ = chnId + 1;
+        // the slots are never freed before the pool, threads may still hold the destroyed ones
+        auto iter = std::find_if(slots_.begin(), slots_.end(), [](const std::unique_ptr<DvppChnSlot>& item) {
+            return item->state == DVPP_CHN_DESTROYED;
+        });
+        if (iter == slots_.end()) {
+            slots_.emplace_back(new DvppChnSlot());
+            iter = slots_.end() - 1;
+        }
+        slot = iter->get();
+        slot->chnId = chnId;
+        slot->lastUsedMs = NowMs();
+        slot->state = DVPP_CHN_IN_USE;
+        chnSlots_[chnId] = slot;
+        chnNum_++;
+        growCount_++;
+        return APP_ERR_OK;
+    }
+
+    bool DvppChnPool::TakeLocked(DvppChnSlot*& slot)
+    {
+        if (!pooledSlots_.empty()) {
+            slot = pooledSlots_.front();
+            pooledSlots_.pop_front();
+            slot->state = DVPP_CHN_IN_USE;
+            return true;
+        }
+        for (auto& item : slots_) {
+            int state = DVPP_CHN_CACHED;
+            if (item->state.compare_exchange_strong(state, DVPP_CHN_IN_USE)) {
+                slot = item.get();
+                return true;
+            }
+        }
+        if (chnNum_ < cfg_.maxChnNum) {
+            APP_ERROR ret = GrowLocked(slot);
+            if (ret == APP_ERR_OK) {
+                LogDebug << "Create " << name_ << " channel(" << slot->chnId << ") on demand, pool size: "
+                         << chnNum_ << ".";
+                return true;
+            }
+            LogWarn << "Failed to create " << name_ << " channel on demand, pool size: " << chnNum_
+                    << ", error(" << ret << ").";
+        }
+        return false;
+    }
+
+    APP_ERROR DvppChnPool::Get(DvppChnSlot*& slot, bool wait)
+    {
+        std::unique_lock<std::mutex> lck(mtx_);
+        if (stopped_) {
+            return APP_ERR_QUEUE_STOPED;
+        }
+        // a thread served by its cached channel never gets here, so the shrink is not left to PutChn alone
+        int64_t nowMs = NowMs();
+        if (IsShrinkDue(nowMs)) {
+            ShrinkLocked(nowMs);
+        }
+        if (TakeLocked(slot)) {
+            OnTaken(slot);
+            return APP_ERR_OK;
+        }
+        if (!wait) {
+            return APP_ERR_COMM_BUSY;
+        }
+        int64_t beginUs = NowUs();
+        // the increment is ordered with the state stores of Put, a channel cached meanwhile is found or notified
+        waiterNum_++;
+        bool taken = false;
+        while (!stopped_ && !(taken = TakeLocked(slot))) {
+            cond_.wait(lck);
+        }
+        waiterNum_--;
+        uint64_t waitTimeUs = static_cast<uint64_t>(NowUs() - beginUs);
+        waitCount_++;
+        waitTimeUs_ += waitTimeUs;
+        maxWaitTimeUs_ = std::max(maxWaitTimeUs_, waitTimeUs);
+        if (!taken) {
+            return APP_ERR_QUEUE_STOPED;
+        }
+        OnTaken(slot);
+        return APP_ERR_OK;
+    }
+
+    APP_ERROR DvppChnPool::Put(DvppChnSlot* slot, bool cache)
+    {
+        if (slot->state != DVPP_CHN_IN_USE) {
+            LogError << "The " << name_ << " channel(" << slot->chnId << ") is not in use."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+        slot->busyTimeUs += static_cast<uint64_t>(NowUs() - slot->getTimeUs);
+        int64_t nowMs = NowMs();
+        slot->lastUsedMs = nowMs;
+        bool shrink = IsShrinkDue(nowMs);
+        if (cache) {
+            slot->state = DVPP_CHN_CACHED;
+            if (waiterNum_ == 0 && !shrink) {
+                return APP_ERR_OK;
+            }
+        }
+        std::lock_guard<std::mutex> lck(mtx_);
+        if (!cache) {
+            slot->state = DVPP_CHN_POOLED;
+            pooledSlots_.push_back(slot);
+        }
+        if (waiterNum_ > 0) {
+            cond_.notify_one();
+        }
+        if (shrink) {
+            ShrinkLocked(nowMs);
+        }
+        return APP_ERR_OK;
+    }
+
+    bool DvppChnPool::IsShrinkDue(int64_t nowMs) const
+    {
+        return chnNum_ > cfg_.minChnNum && nowMs - lastShrinkMs_ >= static_cast<int64_t>(cfg_.idleTimeoutMs);
+    }
+
+    void DvppChnPool::ShrinkLocked(int64_t nowMs)
+    {
+        lastShrinkMs_ = nowMs;
+        for (auto& slot : slots_) {
+            if (chnNum_ <= cfg_.minChnNum) {
+                break;
+            }
+            if (nowMs - slot->lastUsedMs < static_cast<int64_t>(cfg_.idleTimeoutMs)) {
+                continue;
+            }
+            int state = DVPP_CHN_CACHED;
+            if (!slot->state.compare_exchange_strong(state, DVPP_CHN_IN_USE)) {
+                if (state != DVPP_CHN_POOLED) {
+                    continue;
+                }
+                pooledSlots_.erase(std::find(pooledSlots_.begin(), pooledSlots_.end(), slot.get()));
+            }
+            APP_ERROR ret = destroyFunc_(slot->chnId);
+            if (ret != APP_ERR_OK) {
+                LogWarn << "Failed to destroy idle " << name_ << " channel(" << slot->chnId << "), error(" << ret
+                        << ").";
+                slot->state = DVPP_CHN_POOLED;
+                pooledSlots_.push_back(slot.get());
+                continue;
+            }
+            LogDebug << "Destroy idle " << name_ << " channel(" << slot->chnId << ").";
+            chnSlots_.erase(slot->chnId);
+            slot->state = DVPP_CHN_DESTROYED;
+            chnNum_--;
+            shrinkCount_++;
+        }
+    }
+
+    DvppChnSlot* DvppChnPool::FindSlot(hi_s32 chnId)
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        auto iter = chnSlots_.find(chnId);
+        return iter == chnSlots_.end() ? nullptr : iter->second;
+    }
+
+    void DvppChnPool::GetStats(DvppPoolStats& stats)
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        stats = DvppPoolStats();
+        stats.chnNum = chnNum_;
+        stats.getCount = getCount_;
+        stats.cacheHitCount = cacheHitCount_;
+        stats.growCount = growCount_;
+        stats.shrinkCount = shrinkCount_;
+        stats.waitCount = waitCount_;
+        stats.waitTimeUs = waitTimeUs_;
+        stats.maxWaitTimeUs = maxWaitTimeUs_;
+        for (auto& slot : slots_) {
+            int state = slot->state;
+            if (state == DVPP_CHN_DESTROYED) {
+                continue;
+            }
+            stats.idleChnNum += (state == DVPP_CHN_IN_USE) ? 0 : 1;
+            DvppChnStats chnStats;
+            chnStats.chnId = slot->chnId;
+            chnStats.useCount = slot->useCount;
+            chnStats.busyTimeUs = slot->busyTimeUs;
+            stats.channels.push_back(chnStats);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Elastic channel pool of one dvpp channel type on one device.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_DVPPCHNPOOL_H
+#define MXBASE_DVPPCHNPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "acl/dvpp/hi_dvpp.h"
+#include "MxBase/ErrorCode/ErrorCode.h"
+
+namespace MxBase {
+    struct DvppChnStats {
+        hi_s32 chnId = 0;
+        uint64_t useCount = 0;      // times the channel was got
+        uint64_t busyTimeUs = 0;    // total time between getting the channel and putting it back
+    };
+
+    struct DvppPoolStats {
+        uint32_t chnNum = 0;        // channels created
+        uint32_t idleChnNum = 0;    // channels in the pool or cached by threads
+        uint64_t getCount = 0;
+        uint64_t cacheHitCount = 0; // gets served by the channel cached by the thread
+        uint64_t growCount = 0;
+        uint64_t shrinkCount = 0;
+        uint64_t waitCount = 0;
+        uint64_t waitTimeUs = 0;
+        uint64_t maxWaitTimeUs = 0;
+        std::vector<DvppChnStats> channels;
+    };
+
+    struct DvppChnPoolCfg {
+        uint32_t minChnNum = 0;     // channels created by Init and kept when idle
+        uint32_t maxChnNum = 0;     // channels created on demand when the pool is exhausted
+        uint32_t idleTimeoutMs = 0; // channels over minChnNum idle for the time are destroyed
+    };
+
+    enum DvppChnState {
+        DVPP_CHN_POOLED = 0,
+        DVPP_CHN_CACHED,            // put back by a thread that takes it first on its next get, others may steal it
+        DVPP_CHN_IN_USE,
+        DVPP_CHN_DESTROYED
+    };
+
+    struct DvppChnSlot {
+        hi_s32 chnId = 0;
+        std::atomic<int> state = {DVPP_CHN_DESTROYED};
+        std::atomic<int64_t> lastUsedMs = {0};
+        std::atomic<uint64_t> useCount = {0};
+        std::atomic<uint64_t> busyTimeUs = {0};
+        int64_t getTimeUs = 0;      // written by the holder of the channel
+    };
+
+    class DvppChnPool {
+    public:
+        // the channel id passed in is where to look for a free id, for the types with user assigned ids
+        using CreateChnFunc = std::function<APP_ERROR(hi_s32&)>;
+        using DestroyChnFunc = std::function<APP_ERROR(hi_s32)>;
+
+        DvppChnPool(const std::string& name, const DvppChnPoolCfg& cfg, CreateChnFunc createFunc,
+                    DestroyChnFunc destroyFunc);
+
+        ~DvppChnPool() = default;
+
+        /**
+         * @description: Create the minChnNum channels.
+         */
+        APP_ERROR Init();
+
+        /**
+         * @description: Destroy the channels in the pool, the waiting gets return APP_ERR_QUEUE_STOPED.
+         */
+        APP_ERROR DeInit();
+
+        /**
+         * @description: Take back the channel cached by the calling thread, fails when another thread stole it.
+         */
+        bool TakeCached(DvppChnSlot* slot);
+
+        /**
+         * @description: Get a channel from the pool, steal a cached one or create one, in that order.
+         * @param wait: wait for a channel put back when the pool is exhausted, or return APP_ERR_COMM_BUSY.
+         */
+        APP_ERROR Get(DvppChnSlot*& slot, bool wait);
+
+        /**
+         * @description: Put back a channel.
+         * @param cache: leave the channel cached for the next TakeCached of the calling thread.
+         */
+        APP_ERROR Put(DvppChnSlot* slot, bool cache);
+
+        DvppChnSlot* FindSlot(hi_s32 chnId);
+
+        void GetStats(DvppPoolStats& stats);
+
+    private:
+        DvppChnPool(const DvppChnPool&) = delete;
+
+        DvppChnPool& operator=(const DvppChnPool&) = delete;
+
+        bool TakeLocked(DvppChnSlot*& slot);
+
+        APP_ERROR GrowLocked(DvppChnSlot*& slot);
+
+        bool IsShrinkDue(int64_t nowMs) const;
+
+        void ShrinkLocked(int64_t nowMs);
+
+        void OnTaken(DvppChnSlot* slot);
+
+    private:
+        std::string name_;
+        DvppChnPoolCfg cfg_;
+        CreateChnFunc createFunc_;
+        DestroyChnFunc destroyFunc_;
+        std::mutex mtx_ = {};
+        std::condition_variable cond_ = {};
+        std::vector<std::unique_ptr<DvppChnSlot>> slots_ = {};
+        std::deque<DvppChnSlot*> pooledSlots_ = {};
+        std::map<hi_s32, DvppChnSlot*> chnSlots_ = {};
+        std::atomic<uint32_t> waiterNum_ = {0};
+        std::atomic<int64_t> lastShrinkMs_ = {0};
+        hi_s32 nextChnId_ = 0;
+        std::atomic<uint32_t> chnNum_ = {0};
+        bool stopped_ = false;
+        std::atomic<uint64_t> getCount_ = {0};
+        std::atomic<uint64_t> cacheHitCount_ = {0};
+        uint64_t growCount_ = 0;
+        uint64_t shrinkCount_ = 0;
+        uint64_t waitCount_ = 0;
+        uint64_t waitTimeUs_ = 0;
+        uint64_t maxWaitTimeUs_ = 0;
+    };
+}
+
+#endif
@@ -27,12 +27,51 @@ namespace MxBase {
     static bool g_chnInitStatus = false;
     static std::mutex g_chnMtx;
     static std::set<int32_t> g_himpiIsInitedDevices;
+    static std::mutex g_poolMapMtx;
+    // bumped by DeInit, the pools and channels cached by threads in older generations are stale
+    static std::atomic<uint64_t> g_poolGeneration = {1};
+
+    struct ThreadChn {
+        uint64_t generation = 0;
+        std::shared_ptr<DvppChnPool> pool = nullptr;
+        DvppChnSlot* slot = nullptr;
+    };
+    static thread_local std::map<std::pair<int32_t, DvppChnType>, ThreadChn> g_threadChns;
 
     AppGlobalCfgExtra DvppPool::dvppPoolCfg_;
-    std::map<int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_vpc_chn>>> DvppPool::vpcChnQueueMap_;
-    std::map<int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_vdec_chn>>> DvppPool::jpegdChnQueueMap_;
-    std::map<int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_pngd_chn>>> DvppPool::pngdChnQueueMap_;
-    std::map<int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_venc_chn>>> DvppPool::jpegeChnQueueMap_;
+    std::map<std::pair<int32_t, DvppChnType>, std::shared_ptr<DvppChnPool>> DvppPool::chnPoolMap_;
+
+    static const char* GetChnTypeName(DvppChnType chnType)
+    {
+        switch (chnType) {
+            case DvppChnType::VPC:
+                return "vpc";
+            case DvppChnType::JPEGD:
+                return "jpegd";
+            case DvppChnType::PNGD:
+                return "pngd";
+            case DvppChnType::JPEGE:
+                return "jpege";
+            default:
+                return "unknown";
+        }
+    }
+
+    template<typename CreateFunc>
+    static APP_ERROR CreateChnWithFreeId(hi_s32 maxChnId, hi_s32 &chnId, CreateFunc create)
+    {
+        hi_s32 startId = (chnId >= 0 && chnId <= maxChnId) ? chnId : 0;
+        APP_ERROR ret = APP_ERR_OK;
+        for (hi_s32 i = 0; i <= maxChnId; i++) {
+            hi_s32 id = (startId + i) % (maxChnId + 1);
+            ret = create(id);
+            if (ret == APP_ERR_OK) {
+                chnId = id;
+                return APP_ERR_OK;
+            }
+        }
+        return ret;
+    }
 
     void DvppPool::SetChnNum(const AppGlobalCfgExtra &globalCfgExtra)
     {
@@ -45,6 +84,11 @@ namespace MxBase {
         dvppPoolCfg_.jpegdChnNum = globalCfgExtra.jpegdChnNum;
         dvppPoolCfg_.jpegeChnNum = globalCfgExtra.jpegeChnNum;
         dvppPoolCfg_.pngdChnNum = globalCfgExtra.pngdChnNum;
+        dvppPoolCfg_.vpcMaxChnNum = globalCfgExtra.vpcMaxChnNum;
+        dvppPoolCfg_.jpegdMaxChnNum = globalCfgExtra.jpegdMaxChnNum;
+        dvppPoolCfg_.jpegeMaxChnNum = globalCfgExtra.jpegeMaxChnNum;
+        dvppPoolCfg_.pngdMaxChnNum = globalCfgExtra.pngdMaxChnNum;
+        dvppPoolCfg_.chnIdleTimeoutMs = globalCfgExtra.chnIdleTimeoutMs;
         LogDebug << "vpcChnNum is " << dvppPoolCfg_.vpcChnNum << ", jpegdChnNum is " << dvppPoolCfg_.jpegdChnNum
             << ", jpegeChnNum is " << dvppPoolCfg_.jpegeChnNum << ", pngdChnNum is " << dvppPoolCfg_.pngdChnNum << ".";
         g_chnInitStatus = true;
@@ -62,33 +106,31 @@ namespace MxBase {
             }
             g_himpiIsInitedDevices.insert(deviceId);
         }
+        DvppChnPoolCfg cfg;
+        DvppChnPool::CreateChnFunc createFunc = nullptr;
         switch (chnType) {
             case DvppChnType::VPC: {
-                ret = InitVpcPool(deviceId, dvppPoolCfg_.vpcChnNum);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to InitVpcPool on device[" << deviceId << "]." << GetErrorInfo(ret);
-                }
+                cfg.minChnNum = dvppPoolCfg_.vpcChnNum;
+                cfg.maxChnNum = dvppPoolCfg_.vpcMaxChnNum;
+                createFunc = CreateVpcChn;
                 break;
             }
             case DvppChnType::JPEGD: {
-                ret = InitJpegdPool(deviceId, dvppPoolCfg_.jpegdChnNum);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to InitJpegdPool on device[" << deviceId << "]." << GetErrorInfo(ret);
-                }
+                cfg.minChnNum = dvppPoolCfg_.jpegdChnNum;
+                cfg.maxChnNum = dvppPoolCfg_.jpegdMaxChnNum;
+                createFunc = CreateJpegdChn;
                 break;
             }
             case DvppChnType::PNGD: {
-                ret = InitPngdPool(deviceId, dvppPoolCfg_.pngdChnNum);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to InitPngdPool on device[" << deviceId << "]." << GetErrorInfo(ret);
-                }
+                cfg.minChnNum = dvppPoolCfg_.pngdChnNum;
+                cfg.maxChnNum = dvppPoolCfg_.pngdMaxChnNum;
+                createFunc = CreatePngdChn;
                 break;
             }
             case DvppChnType::JPEGE: {
-                ret = InitJpegePool(deviceId, dvppPoolCfg_.jpegeChnNum);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to InitJpegePool on device[" << deviceId << "]." << GetErrorInfo(ret);
-                }
+                cfg.minChnNum = dvppPoolCfg_.jpegeChnNum;
+                cfg.maxChnNum = dvppPoolCfg_.jpegeMaxChnNum;
+                createFunc = CreateJpegeChn;
                 break;
             }
             default:
@@ -96,36 +138,46 @@ namespace MxBase {
                          << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
                 return APP_ERR_COMM_INVALID_PARAM;
         }
-        return ret;
+        cfg.idleTimeoutMs = dvppPoolCfg_.chnIdleTimeoutMs;
+        // channels are created and destroyed on demand by the threads using the pool
+        auto setDevice = [deviceId]() {
+            DeviceContext device = {};
+            device.devId = deviceId;
+            return MxBase::DeviceManager::GetInstance()->SetDevice(device);
+        };
+        auto pool = std::make_shared<DvppChnPool>(std::string(GetChnTypeName(chnType)) + " device(" +
+            std::to_string(deviceId) + ")", cfg,
+            [setDevice, createFunc](hi_s32 &chnId) {
+                APP_ERROR ret = setDevice();
+                return ret == APP_ERR_OK ? createFunc(chnId) : ret;
+            },
+            [setDevice, chnType](hi_s32 chnId) {
+                APP_ERROR ret = setDevice();
+                return ret == APP_ERR_OK ? DestroyChn(chnType, chnId) : ret;
+            });
+        ret = pool->Init();
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to init " << GetChnTypeName(chnType) << " pool on device[" << deviceId << "]."
+                     << GetErrorInfo(ret);
+            pool->DeInit();
+            return ret;
+        }
+        std::lock_guard<std::mutex> lck(g_poolMapMtx);
+        chnPoolMap_[std::make_pair(deviceId, chnType)] = pool;
+        return APP_ERR_OK;
     }
 
-    APP_ERROR DvppPool::InitVpcPool(int32_t deviceId, uint32_t size)
+    APP_ERROR DvppPool::CreateVpcChn(hi_s32 &chnId)
     {
-        LogInfo << "Begin to initialize vpc pool.";
-        auto iter = vpcChnQueueMap_.find(deviceId);
-        if (iter == vpcChnQueueMap_.end()) {
-            LogError << "Failed to find ChannelQueue from device(" << deviceId << ")."
-                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
-        }
-        for (uint32_t i = 0; i < size; i++) {
-            hi_vpc_chn_attr vpcChnAttr;
-            hi_vpc_chn channelId;
-            vpcChnAttr.attr = 0;
-            APP_ERROR ret = hi_mpi_vpc_sys_create_chn(&channelId, &vpcChnAttr);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to create vpc hi_mpi_vpc_sys_chn."
-                    << GetErrorInfo(ret, "hi_mpi_vpc_sys_create_chn");
-                return APP_ERR_COMM_INIT_FAIL;
-            }
-            ret = iter->second->Push(channelId);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to push channel to pool." << GetErrorInfo(ret);
-                return APP_ERR_COMM_INIT_FAIL;
-            }
+        hi_vpc_chn_attr vpcChnAttr;
+        hi_vpc_chn channelId;
+        vpcChnAttr.attr = 0;
+        APP_ERROR ret = hi_mpi_vpc_sys_create_chn(&channelId, &vpcChnAttr);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to create vpc hi_mpi_vpc_sys_chn." << GetErrorInfo(ret, "hi_mpi_vpc_sys_create_chn");
+            return APP_ERR_COMM_INIT_FAIL;
         }
-        LogInfo << "Initialized vpc channel pool successful on device(" << deviceId << "), pool size: "
-                << iter->second->GetSize() << ".";
+        chnId = channelId;
         return APP_ERR_OK;
     }
 
@@ -152,144 +204,117 @@ namespace MxBase {
         return APP_ERR_OK;
     }
 
-    APP_ERROR DvppPool::InitJpegdPool(int32_t deviceId, uint32_t size)
+    APP_ERROR DvppPool::CreateJpegdChn(hi_s32 &chnId)
     {
-        LogInfo << "Begin to initialize jpegd pool.";
-        auto iter = jpegdChnQueueMap_.find(deviceId);
-        if (iter == jpegdChnQueueMap_.end()) {
-            LogError << "Failed to find ChannelQueue from device(" << deviceId << ")."
-                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
+        hi_vdec_chn_attr attr;
+        attr.type = HI_PT_JPEG;
+        attr.mode = HI_VDEC_SEND_MODE_FRAME;
+        attr.pic_width = MAX_JPEGD_WIDTH;
+        attr.pic_height = MAX_JPEGD_HEIGHT;
+        attr.stream_buf_size = MAX_JPEGD_WIDTH * MAX_JPEGD_HEIGHT;
+        attr.frame_buf_cnt = 0;
+        attr.frame_buf_size = 0;
+        APP_ERROR ret = CreateChnWithFreeId(MAX_HIMPI_CHN_NUM, chnId, [&attr](hi_s32 channelId) {
+            return hi_mpi_vdec_create_chn(channelId, &attr);
+        });
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to create jpeg decode channel, All channels are occupied."
+                     << GetErrorInfo(ret, "hi_mpi_vdec_create_chn");
+            return APP_ERR_ACL_FAILURE;
         }
-        hi_vdec_chn channelId = 0;
-        for (uint32_t i = 0; i < size; i++) {
-            hi_vdec_chn_attr attr;
-            attr.type = HI_PT_JPEG;
-            attr.mode = HI_VDEC_SEND_MODE_FRAME;
-            attr.pic_width = MAX_JPEGD_WIDTH;
-            attr.pic_height = MAX_JPEGD_HEIGHT;
-            attr.stream_buf_size = MAX_JPEGD_WIDTH * MAX_JPEGD_HEIGHT;
-            attr.frame_buf_cnt = 0;
-            attr.frame_buf_size = 0;
-            APP_ERROR ret = APP_ERR_OK;
-            while (channelId <= MAX_HIMPI_CHN_NUM) {
-                ret = hi_mpi_vdec_create_chn(channelId, &attr);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Create jpeg decode channel successfully. channel id is " << channelId << ".";
-                    break;
-                } else if (channelId == MAX_HIMPI_CHN_NUM) {
-                    LogError << "Failed to create jpeg decode channel, All channels are occupied."
-                             << GetErrorInfo(ret, "hi_mpi_vdec_create_chn");
-                    return APP_ERR_ACL_FAILURE;
-                } else {
-                    channelId++;
-                }
-            }
-            if (DvppPool::SetJpegdChnParam(channelId) != APP_ERR_OK) {
-                return APP_ERR_COMM_INIT_FAIL;
-            }
-            ret = iter->second->Push(channelId);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to push vdec channel to pool." << GetErrorInfo(ret);
-                return APP_ERR_COMM_INIT_FAIL;
-            }
-            channelId++;
+        LogDebug << "Create jpeg decode channel successfully. channel id is " << chnId << ".";
+        if (DvppPool::SetJpegdChnParam(chnId) != APP_ERR_OK) {
+            return APP_ERR_COMM_INIT_FAIL;
         }
-        LogInfo << "Initialized vdec channel pool successful on device(" << deviceId << "), pool size: "
-                << iter->second->GetSize() << ".";
         return APP_ERR_OK;
     }
 
-    APP_ERROR DvppPool::InitPngdPool(int32_t deviceId, uint32_t size)
+    APP_ERROR DvppPool::CreatePngdChn(hi_s32 &chnId)
     {
-        auto iter = pngdChnQueueMap_.find(deviceId);
-        if (iter == pngdChnQueueMap_.end()) {
-            LogError << "Failed to find ChannelQueue from device(" << deviceId << ")."
-                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
-        }
-        hi_pngd_chn channelId = 0;
-        APP_ERROR ret = APP_ERR_OK;
-        for (uint32_t i = 0; i < size; i++) {
-            hi_pngd_chn_attr attr;
-            while (channelId <= MAX_HIMPI_PNGD_CHN_NUM) {
-                ret = hi_mpi_pngd_create_chn(channelId, &attr);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Create pngd channel successfully. channel id is " << channelId << ".";
-                    break;
-                } else if (channelId == MAX_HIMPI_PNGD_CHN_NUM) {
-                    LogError << "Failed to create video decode channel, All channels are occupied."
-                             << GetErrorInfo(ret, "hi_mpi_pngd_create_chn");
-                    return APP_ERR_ACL_FAILURE;
-                } else {
-                    channelId++;
-                }
-            }
-            ret = iter->second->Push(channelId);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to push pngd channel to pool." << GetErrorInfo(ret);
-                return APP_ERR_COMM_INIT_FAIL;
-            }
-            channelId++;
+        hi_pngd_chn_attr attr;
+        APP_ERROR ret = CreateChnWithFreeId(MAX_HIMPI_PNGD_CHN_NUM, chnId, [&attr](hi_s32 channelId) {
+            return hi_mpi_pngd_create_chn(channelId, &attr);
+        });
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to create video decode channel, All channels are occupied."
+                     << GetErrorInfo(ret, "hi_mpi_pngd_create_chn");
+            return APP_ERR_ACL_FAILURE;
         }
-        LogInfo << "Initialized pngd channel pool successful on device(" << deviceId << "), pool size: "
-                << iter->second->GetSize() << ".";
-        return ret;
+        LogDebug << "Create pngd channel successfully. channel id is " << chnId << ".";
+        return APP_ERR_OK;
     }
 
-    APP_ERROR DvppPool::InitJpegePool(int32_t deviceId, uint32_t size)
+    APP_ERROR DvppPool::CreateJpegeChn(hi_s32 &chnId)
     {
-        auto iter = jpegeChnQueueMap_.find(deviceId);
-        if (iter == jpegeChnQueueMap_.end()) {
-            LogError << "Failed to find ChannelQueue from device(" << deviceId << ")."
-                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
-        }
         JpegEncodeChnConfig config;
-        hi_venc_chn channelId = 0;
+        uint32_t channelWidth = config.maxPicWidth;
+        uint32_t channelHeight = config.maxPicHeight;
+        channelWidth = (channelWidth + VENC_STRIDE_WIDTH - 1) / VENC_STRIDE_WIDTH * VENC_STRIDE_WIDTH;
+        channelHeight = (channelHeight + VENC_STRIDE_HEIGHT - 1) / VENC_STRIDE_HEIGHT * VENC_STRIDE_HEIGHT;
+        // channel height should be no less than width or the acl will return error code.
+        channelHeight = channelHeight < channelWidth ? channelWidth : channelHeight;
+        hi_venc_chn_attr attr;
+        attr.venc_attr.type = HI_PT_JPEG;
+        attr.venc_attr.profile = 0;
+        attr.venc_attr.max_pic_width = channelWidth;
+        attr.venc_attr.max_pic_height = channelHeight;
+        attr.venc_attr.pic_width = channelWidth;
+        attr.venc_attr.pic_height = channelHeight;
+        attr.venc_attr.buf_size =  channelWidth * channelHeight * HI_ODD_NUM_3 / HI_ODD_NUM_2;
+        attr.venc_attr.is_by_frame = HI_TRUE;
+        attr.venc_attr.jpeg_attr.dcf_en = HI_FALSE;
+        attr.venc_attr.jpeg_attr.recv_mode = HI_VENC_PIC_RECV_SINGLE;
+        attr.venc_attr.jpeg_attr.mpf_cfg.large_thumbnail_num = 0;
+        APP_ERROR ret = CreateChnWithFreeId(MAX_HIMPI_CHN_NUM, chnId, [&attr](hi_s32 channelId) {
+            return hi_mpi_venc_create_chn(channelId, &attr);
+        });
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to create jpeg encode channel, All channels are occupied."
+                     << GetErrorInfo(ret, "hi_mpi_venc_create_chn");
+            return APP_ERR_ACL_FAILURE;
+        }
+        LogDebug << "Create jpeg encode channels successfully. channel id is " << chnId << ".";
+        return APP_ERR_OK;
+    }
+
+    APP_ERROR DvppPool::DestroyChn(DvppChnType chnType, hi_s32 chnId)
+    {
         APP_ERROR ret = APP_ERR_OK;
-        for (uint32_t i = 0; i < size; i++) {
-            uint32_t channelWidth = config.maxPicWidth;
-            uint32_t channelHeight = config.maxPicHeight;
-            channelWidth = (channelWidth + VENC_STRIDE_WIDTH - 1) / VENC_STRIDE_WIDTH * VENC_STRIDE_WIDTH;
-            channelHeight = (channelHeight + VENC_STRIDE_HEIGHT - 1) / VENC_STRIDE_HEIGHT * VENC_STRIDE_HEIGHT;
-            // channel height should be no less than width or the acl will return error code.
-            channelHeight = channelHeight < channelWidth ? channelWidth : channelHeight;
-            hi_venc_chn_attr attr;
-            attr.venc_attr.type = HI_PT_JPEG;
-            attr.venc_attr.profile = 0;
-            attr.venc_attr.max_pic_width = channelWidth;
-            attr.venc_attr.max_pic_height = channelHeight;
-            attr.venc_attr.pic_width = channelWidth;
-            attr.venc_attr.pic_height = channelHeight;
-            attr.venc_attr.buf_size =  channelWidth * channelHeight * HI_ODD_NUM_3 / HI_ODD_NUM_2;
-            attr.venc_attr.is_by_frame = HI_TRUE;
-            attr.venc_attr.jpeg_attr.dcf_en = HI_FALSE;
-            attr.venc_attr.jpeg_attr.recv_mode = HI_VENC_PIC_RECV_SINGLE;
-            attr.venc_attr.jpeg_attr.mpf_cfg.large_thumbnail_num = 0;
-            while (channelId <= MAX_HIMPI_CHN_NUM) {
-                ret = hi_mpi_venc_create_chn(channelId, &attr);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Create jpeg encode channels successfully. channel id is " << channelId << ".";
-                    break;
-                } else if (channelId == MAX_HIMPI_CHN_NUM) {
-                    LogError << "Failed to create jpeg encode channel, All channels are occupied."
-                             << GetErrorInfo(ret, "hi_mpi_venc_create_chn");
-                    return APP_ERR_ACL_FAILURE;
-                } else {
-                    channelId++;
+        switch (chnType) {
+            case DvppChnType::VPC:
+                ret = hi_mpi_vpc_destroy_chn(chnId);
+                if (ret != APP_ERR_OK) {
+                    LogError << "Failed to destroy vpc channel." << GetErrorInfo(ret, "hi_mpi_vpc_destroy_chn");
                 }
-            }
-            ret = iter->second->Push(channelId);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to push venc channel to pool." << GetErrorInfo(ret);
-                return APP_ERR_COMM_INIT_FAIL;
-            }
-            channelId++;
+                break;
+            case DvppChnType::JPEGD:
+                ret = hi_mpi_vdec_destroy_chn(chnId);
+                if (ret != APP_ERR_OK) {
+                    LogError << "Failed to destroy jpegd channel." << GetErrorInfo(ret, "hi_mpi_vdec_destroy_chn");
+                }
+                break;
+            case DvppChnType::PNGD:
+                ret = hi_mpi_pngd_destroy_chn(chnId);
+                if (ret != APP_ERR_OK) {
+                    LogError << "Failed to destroy pngd channel." << GetErrorInfo(ret, "hi_mpi_pngd_destroy_chn");
+                }
+                break;
+            case DvppChnType::JPEGE:
+                ret = hi_mpi_venc_stop_chn(chnId);
+                if (ret != APP_ERR_OK) {
+                    LogError << "Failed to stop channel." << GetErrorInfo(ret, "hi_mpi_venc_stop_chn");
+                }
+                ret = hi_mpi_venc_destroy_chn(chnId);
+                if (ret != APP_ERR_OK) {
+                    LogError << "Failed to destroy venc channel." << GetErrorInfo(ret, "hi_mpi_venc_destroy_chn");
+                }
+                break;
+            default:
+                LogError << "DestroyChn: not supported chnType( " << static_cast<int>(chnType) << ")."
+                         << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+                return APP_ERR_COMM_INVALID_PARAM;
         }
-        LogInfo << "Initialized jpege channel pool successful on device(" << deviceId << "), pool size: "
-                << iter->second->GetSize() << ".";
-        return ret;
+        return ret == APP_ERR_OK ? APP_ERR_OK : APP_ERR_COMM_FAILURE;
     }
 
     APP_ERROR DvppPool::Init(int32_t deviceId, DvppChnType chnType)
@@ -306,6 +331,11 @@ namespace MxBase {
         if (DvppPool::IsInited(deviceId, chnType)) {
             return APP_ERR_OK;
         }
+        if (chnType < DvppChnType::VPC || chnType > DvppChnType::JPEGE) {
+            LogError << "DvppPool Inited: not supported chnType( " << static_cast<int>(chnType) << ")."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
 
         DeviceContext device = {};
         device.devId = deviceId;
@@ -315,28 +345,6 @@ namespace MxBase {
             return ret;
         }
 
-        switch (chnType) {
-            case DvppChnType::VPC: {
-                vpcChnQueueMap_[deviceId] = std::make_shared<MxBase::BlockingQueue<hi_vpc_chn>>();
-                break;
-            }
-            case DvppChnType::JPEGD: {
-                jpegdChnQueueMap_[deviceId] = std::make_shared<MxBase::BlockingQueue<hi_vdec_chn>>();
-                break;
-            }
-            case DvppChnType::PNGD: {
-                pngdChnQueueMap_[deviceId] = std::make_shared<MxBase::BlockingQueue<hi_pngd_chn>>();
-                break;
-            }
-            case DvppChnType::JPEGE: {
-                jpegeChnQueueMap_[deviceId] = std::make_shared<MxBase::BlockingQueue<hi_venc_chn>>();
-                break;
-            }
-            default:
-                LogError << "DvppPool Inited: not supported chnType( " << static_cast<int>(chnType) << ")."
-                         << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                return APP_ERR_COMM_INVALID_PARAM;
-        }
         ret = InitChnPoolOnDevice(deviceId, chnType);
         if (ret != APP_ERR_OK) {
             LogError << "Failed to Init Channel Pool on device(" << deviceId << ")." << GetErrorInfo(ret);
@@ -346,160 +354,14 @@ namespace MxBase {
 
     bool DvppPool::IsInited(int32_t deviceId, DvppChnType chnType)
     {
-        bool isInited = true;
-        switch (chnType) {
-            case DvppChnType::VPC: {
-                if (vpcChnQueueMap_.find(deviceId) == vpcChnQueueMap_.end()) {
-                    isInited = false;
-                }
-                break;
-            }
-            case DvppChnType::JPEGD: {
-                if (jpegdChnQueueMap_.find(deviceId) == jpegdChnQueueMap_.end()) {
-                    isInited = false;
-                }
-                break;
-            }
-            case DvppChnType::PNGD: {
-                if (pngdChnQueueMap_.find(deviceId) == pngdChnQueueMap_.end()) {
-                    isInited = false;
-                }
-                break;
-            }
-            case DvppChnType::JPEGE: {
-                if (jpegeChnQueueMap_.find(deviceId) == jpegeChnQueueMap_.end()) {
-                    isInited = false;
-                }
-                break;
-            }
-            default:
-                LogError << "IsInited: not supported chnType( " << static_cast<int>(chnType) << ").";
-                isInited = false;
-                break;
-        }
-        return isInited;
+        return FindPool(deviceId, chnType) != nullptr;
     }
 
-    APP_ERROR DvppPool::DeInitVpcPool()
+    std::shared_ptr<DvppChnPool> DvppPool::FindPool(int32_t deviceId, DvppChnType chnType)
     {
-        LogInfo << "Start to DeInit Vpc Chn Pool.";
-        APP_ERROR ret = APP_ERR_OK;
-        APP_ERROR deInitVpcRet = APP_ERR_OK;
-        for (auto iter : vpcChnQueueMap_) {
-            DeviceContext device = {};
-            device.devId = iter.first;
-            ret = MxBase::DeviceManager::GetInstance()->SetDevice(device);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to SetDevice in DvppPool DeInitVpcPool Operation." << GetErrorInfo(ret);
-                return ret;
-            }
-            while (!iter.second->IsEmpty()) {
-                hi_vpc_chn chnId = 0;
-                iter.second->Pop(chnId);
-                ret = hi_mpi_vpc_destroy_chn(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to destroy vpc channel on device(" << iter.first << ")."
-                             << GetErrorInfo(ret, "hi_mpi_vpc_destroy_chn");
-                    deInitVpcRet = APP_ERR_COMM_FAILURE;
-                }
-            }
-        }
-        vpcChnQueueMap_.clear();
-        LogInfo << "DeInit Vpc Chn Pool Finished.";
-        return deInitVpcRet;
-    }
-
-    APP_ERROR DvppPool::DeInitJpegdPool()
-    {
-        LogInfo << "Start to DeInit Jpegd Chn Pool.";
-        APP_ERROR ret = APP_ERR_OK;
-        APP_ERROR deInitJpegdRet = APP_ERR_OK;
-        for (auto iter : jpegdChnQueueMap_) {
-            DeviceContext device = {};
-            device.devId = iter.first;
-            ret = MxBase::DeviceManager::GetInstance()->SetDevice(device);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to SetDevice in DvppPool DeInitJpegdPool Operation." << GetErrorInfo(ret);
-                return ret;
-            }
-            while (!iter.second->IsEmpty()) {
-                hi_vdec_chn chnId = 0;
-                iter.second->Pop(chnId);
-                ret = hi_mpi_vdec_destroy_chn(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to destroy jpegd channel on device(" << iter.first << ")."
-                             << GetErrorInfo(ret, "hi_mpi_vdec_destroy_chn");
-                    deInitJpegdRet = APP_ERR_COMM_FAILURE;
-                }
-            }
-        }
-        jpegdChnQueueMap_.clear();
-        LogInfo << "DeInit Jpegd Chn Pool Finished.";
-        return deInitJpegdRet;
-    }
-
-    APP_ERROR DvppPool::DeInitPngdPool()
-    {
-        LogInfo << "Start to DeInit Pngd Chn Pool.";
-        APP_ERROR ret = APP_ERR_OK;
-        APP_ERROR deInitPngdRet = APP_ERR_OK;
-        for (auto iter : pngdChnQueueMap_) {
-            DeviceContext device = {};
-            device.devId = iter.first;
-            ret = MxBase::DeviceManager::GetInstance()->SetDevice(device);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to SetDevice in DvppPool DeInitPngdPool Operation." << GetErrorInfo(ret);
-                return ret;
-            }
-            while (!iter.second->IsEmpty()) {
-                hi_pngd_chn chnId = 0;
-                iter.second->Pop(chnId);
-                ret = hi_mpi_pngd_destroy_chn(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to destroy pngd channel on device(" << iter.first << ")."
-                             << GetErrorInfo(ret, "hi_mpi_pngd_destroy_chn");
-                    deInitPngdRet = APP_ERR_COMM_FAILURE;
-                }
-            }
-        }
-        pngdChnQueueMap_.clear();
-        LogInfo << "DeInit Pngd Chn Pool Finished.";
-        return deInitPngdRet;
-    }
-
-    APP_ERROR DvppPool::DeInitJpegePool()
-    {
-        LogInfo << "Start to DeInit Jpege Chn Pool.";
-        APP_ERROR ret = APP_ERR_OK;
-        APP_ERROR deInitJpegeRet = APP_ERR_OK;
-        for (auto iter : jpegeChnQueueMap_) {
-            DeviceContext device = {};
-            device.devId = iter.first;
-            ret = MxBase::DeviceManager::GetInstance()->SetDevice(device);
-            if (ret != APP_ERR_OK) {
-                LogError << "Failed to SetDevice in DvppPool DeInitJpegePool Operation." << GetErrorInfo(ret);
-                return ret;
-            }
-            while (!iter.second->IsEmpty()) {
-                hi_venc_chn chnId = 0;
-                iter.second->Pop(chnId);
-                ret = hi_mpi_venc_stop_chn(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to stop channel on device(" << iter.first << ")."
-                             << GetErrorInfo(ret, "hi_mpi_venc_stop_chn");
-                    deInitJpegeRet = APP_ERR_COMM_FAILURE;
-                }
-                ret = hi_mpi_venc_destroy_chn(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to destroy venc channel on device(" << iter.first << ")."
-                             << GetErrorInfo(ret, "hi_mpi_venc_destroy_chn");
-                    deInitJpegeRet = APP_ERR_COMM_FAILURE;
-                }
-            }
-        }
-        jpegeChnQueueMap_.clear();
-        LogInfo << "DeInit Jpege Chn Pool Finished.";
-        return deInitJpegeRet;
+        std::lock_guard<std::mutex> lck(g_poolMapMtx);
+        auto iter = chnPoolMap_.find(std::make_pair(deviceId, chnType));
+        return iter == chnPoolMap_.end() ? nullptr : iter->second;
     }
 
     APP_ERROR DvppPool::HimpiSysExit()
@@ -529,27 +391,23 @@ namespace MxBase {
     {
         std::lock_guard<std::mutex> lck(g_chnMtx);
         APP_ERROR deInitRet = APP_ERR_OK;
-        APP_ERROR ret = DeInitVpcPool();
-        if (ret != APP_ERR_OK) {
-            LogError << "Failed to DeInit VpcPool." << GetErrorInfo(ret);
-            deInitRet = APP_ERR_COMM_FAILURE;
-        }
-        ret = DeInitJpegdPool();
-        if (ret != APP_ERR_OK) {
-            LogError << "Failed to DeInit JpegdPool." << GetErrorInfo(ret);
-            deInitRet = APP_ERR_COMM_FAILURE;
-        }
-        ret = DeInitPngdPool();
-        if (ret != APP_ERR_OK) {
-            LogError << "Failed to DeInit PngdPool." << GetErrorInfo(ret);
-            deInitRet = APP_ERR_COMM_FAILURE;
-        }
-        ret = DeInitJpegePool();
-        if (ret != APP_ERR_OK) {
-            LogError << "Failed to DeInit JpegePool." << GetErrorInfo(ret);
-            deInitRet = APP_ERR_COMM_FAILURE;
+        std::map<std::pair<int32_t, DvppChnType>, std::shared_ptr<DvppChnPool>> chnPoolMap;
+        {
+            std::lock_guard<std::mutex> mapLck(g_poolMapMtx);
+            chnPoolMap.swap(chnPoolMap_);
+            g_poolGeneration++;
+        }
+        for (auto& iter : chnPoolMap) {
+            LogInfo << "Start to DeInit " << GetChnTypeName(iter.first.second) << " Chn Pool on device("
+                    << iter.first.first << ").";
+            APP_ERROR ret = iter.second->DeInit();
+            if (ret != APP_ERR_OK) {
+                LogError << "Failed to DeInit " << GetChnTypeName(iter.first.second) << " Pool on device("
+                         << iter.first.first << ")." << GetErrorInfo(ret);
+                deInitRet = APP_ERR_COMM_FAILURE;
+            }
         }
-        ret = HimpiSysExit();
+        APP_ERROR ret = HimpiSysExit();
         if (ret != APP_ERR_OK) {
             LogError << "Failed to HimpiSysExit." << GetErrorInfo(ret);
             deInitRet = APP_ERR_COMM_FAILURE;
@@ -558,126 +416,98 @@ namespace MxBase {
         LogInfo << "Success to destroy chn in dvpp channel pool on all devices.";
         return deInitRet;
     }
-    APP_ERROR DvppPool::GetChn(int32_t deviceId, hi_s32& chnId, DvppChnType chnType)
+
+    APP_ERROR DvppPool::AcquireChn(int32_t deviceId, hi_s32& chnId, DvppChnType chnType, bool wait)
     {
-        // init channel pool, if pool has inited, return OK.
-        APP_ERROR ret = Init(deviceId, chnType);
-        if (ret != APP_ERR_OK) {
-            LogError << "Failed to init DvppPool." << GetErrorInfo(ret);
-            return ret;
-        }
-        switch (chnType) {
-            case DvppChnType::VPC: {
-                ret = vpcChnQueueMap_[deviceId]->Pop(chnId);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Get vpc chnId: " << chnId << " from pool on device(" << deviceId << ") successful.";
-                } else {
-                    LogError<< "Get vpc chnId: " << chnId << " from pool on device(" << deviceId << ") failed.";
-                }
-                break;
-            }
-            case DvppChnType::JPEGD: {
-                ret = jpegdChnQueueMap_[deviceId]->Pop(chnId);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Get jpegd chnId: " << chnId << " from pool on device(" << deviceId << ") successful.";
-                } else {
-                    LogError<< "Get jpegd chnId: " << chnId << " from pool on device(" << deviceId << ") failed.";
-                }
-                break;
+        ThreadChn& threadChn = g_threadChns[std::make_pair(deviceId, chnType)];
+        uint64_t generation = g_poolGeneration.load();
+        if (threadChn.pool == nullptr || threadChn.generation != generation) {
+            // init channel pool, if pool has inited, return OK.
+            APP_ERROR ret = GetInstance().Init(deviceId, chnType);
+            if (ret != APP_ERR_OK) {
+                LogError << "Failed to init DvppPool." << GetErrorInfo(ret);
+                return ret;
             }
-            case DvppChnType::PNGD: {
-                ret = pngdChnQueueMap_[deviceId]->Pop(chnId);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Get pngd chnId: " << chnId << " from pool on device(" << deviceId << ") successful.";
-                } else {
-                    LogError<< "Get pngd chnId: " << chnId << " from pool on device(" << deviceId << ") failed.";
-                }
-                break;
+            threadChn.pool = FindPool(deviceId, chnType);
+            threadChn.slot = nullptr;
+            threadChn.generation = generation;
+            if (threadChn.pool == nullptr) {
+                LogError << "Failed to find " << GetChnTypeName(chnType) << " chn pool on deviceId: " << deviceId
+                         << "." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+                return APP_ERR_COMM_INVALID_PARAM;
             }
-            case DvppChnType::JPEGE: {
-                ret = jpegeChnQueueMap_[deviceId]->Pop(chnId);
-                if (ret == APP_ERR_OK) {
-                    LogDebug << "Get jpege chnId: " << chnId << " from pool on device(" << deviceId << ") successful.";
-                } else {
-                    LogError<< "Get jpege chnId: " << chnId << " from pool on device(" << deviceId << ") failed.";
-                }
-                break;
+        }
+        // the channel put back last by the thread, no lock and no queue when nobody else took it
+        if (threadChn.slot != nullptr && threadChn.pool->TakeCached(threadChn.slot)) {
+            chnId = threadChn.slot->chnId;
+            return APP_ERR_OK;
+        }
+        DvppChnSlot* slot = nullptr;
+        APP_ERROR ret = threadChn.pool->Get(slot, wait);
+        if (ret != APP_ERR_OK) {
+            if (ret != APP_ERR_COMM_BUSY) {
+                LogError << "Get " << GetChnTypeName(chnType) << " chnId from pool on device(" << deviceId
+                         << ") failed." << GetErrorInfo(ret);
             }
-            default:
-                LogError << "GetChn: not supported chnType( " << static_cast<int>(chnType) << ").";
-                return APP_ERR_COMM_INVALID_PARAM;
+            return ret;
         }
-        return ret;
+        threadChn.slot = slot;
+        chnId = slot->chnId;
+        LogDebug << "Get " << GetChnTypeName(chnType) << " chnId: " << chnId << " from pool on device("
+                 << deviceId << ") successful.";
+        return APP_ERR_OK;
+    }
+
+    APP_ERROR DvppPool::GetChn(int32_t deviceId, hi_s32& chnId, DvppChnType chnType)
+    {
+        return AcquireChn(deviceId, chnId, chnType, true);
+    }
+
+    APP_ERROR DvppPool::TryGetChn(int32_t deviceId, hi_s32& chnId, DvppChnType chnType)
+    {
+        return AcquireChn(deviceId, chnId, chnType, false);
     }
 
     APP_ERROR DvppPool::PutChn(int32_t deviceId, hi_s32& chnId, DvppChnType chnType)
     {
-        APP_ERROR ret = APP_ERR_OK;
-        switch (chnType) {
-            case DvppChnType::VPC: {
-                auto iterVpc = vpcChnQueueMap_.find(deviceId);
-                if (iterVpc == vpcChnQueueMap_.end()) {
-                    LogError << "Failed to find vpc chn pool on deviceId: " << deviceId << "."
-                        << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                    return APP_ERR_COMM_INVALID_PARAM;
-                }
-                ret = iterVpc->second->Push(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to push vpc channel to pool, channelId is: " << chnId << "."
-                        << GetErrorInfo(ret);
-                    return APP_ERR_COMM_FAILURE;
-                }
-                break;
-            }
-            case DvppChnType::JPEGD: {
-                auto iterVdec = jpegdChnQueueMap_.find(deviceId);
-                if (iterVdec == jpegdChnQueueMap_.end()) {
-                    LogError << "Failed to find jpegd chn pool on deviceId: " << deviceId << "."
-                        << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                    return APP_ERR_COMM_INVALID_PARAM;
-                }
-                ret = iterVdec->second->Push(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to push jpegd channel to pool, channelId is: " << chnId << "."
-                        << GetErrorInfo(ret);
-                    return APP_ERR_COMM_FAILURE;
-                }
-                break;
-            }
-            case DvppChnType::PNGD: {
-                auto iterPngd = pngdChnQueueMap_.find(deviceId);
-                if (iterPngd == pngdChnQueueMap_.end()) {
-                    LogError << "Failed to find pngd chn pool on deviceId: " << deviceId << "."
-                        << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                    return APP_ERR_COMM_INVALID_PARAM;
-                }
-                ret = iterPngd->second->Push(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to push pngd channel to pool, channelId is: " << chnId << "."
-                        << GetErrorInfo(ret);
-                    return APP_ERR_COMM_FAILURE;
-                }
-                break;
-            }
-            case DvppChnType::JPEGE: {
-                auto iterJpege = jpegeChnQueueMap_.find(deviceId);
-                if (iterJpege == jpegeChnQueueMap_.end()) {
-                    LogError << "Failed to find jpege chn pool on deviceId: " << deviceId << "."
-                        << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                    return APP_ERR_COMM_INVALID_PARAM;
-                }
-                ret = iterJpege->second->Push(chnId);
-                if (ret != APP_ERR_OK) {
-                    LogError << "Failed to push jpege channel to pool, channelId is: " << chnId << "."
-                        << GetErrorInfo(ret);
-                    return APP_ERR_COMM_FAILURE;
-                }
-                break;
-            }
-            default:
-                LogError << "DvppPool PutChn: not supported chnType.";
-                return APP_ERR_COMM_INVALID_PARAM;
+        auto iter = g_threadChns.find(std::make_pair(deviceId, chnType));
+        if (iter != g_threadChns.end() && iter->second.generation == g_poolGeneration.load() &&
+            iter->second.slot != nullptr && iter->second.slot->chnId == chnId &&
+            iter->second.slot->state == DVPP_CHN_IN_USE) {
+            // keep the channel for the next get of the thread
+            return iter->second.pool->Put(iter->second.slot, true);
+        }
+        // the channels got by other threads
+        std::shared_ptr<DvppChnPool> pool = FindPool(deviceId, chnType);
+        if (pool == nullptr) {
+            LogError << "Failed to find " << GetChnTypeName(chnType) << " chn pool on deviceId: " << deviceId << "."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
         }
-        return ret;
+        DvppChnSlot* slot = pool->FindSlot(chnId);
+        if (slot == nullptr) {
+            LogError << "Failed to push " << GetChnTypeName(chnType) << " channel to pool, channelId is: " << chnId
+                     << "." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_FAILURE;
+        }
+        APP_ERROR ret = pool->Put(slot, false);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to push " << GetChnTypeName(chnType) << " channel to pool, channelId is: " << chnId
+                     << "." << GetErrorInfo(ret);
+            return APP_ERR_COMM_FAILURE;
+        }
+        return APP_ERR_OK;
+    }
+
+    APP_ERROR DvppPool::GetPoolStats(int32_t deviceId, DvppChnType chnType, DvppPoolStats &stats)
+    {
+        std::shared_ptr<DvppChnPool> pool = FindPool(deviceId, chnType);
+        if (pool == nullptr) {
+            LogError << "Failed to find " << GetChnTypeName(chnType) << " chn pool on deviceId: " << deviceId << "."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+        pool->GetStats(stats);
+        return APP_ERR_OK;
     }
-}
\ No newline at end of file
+}
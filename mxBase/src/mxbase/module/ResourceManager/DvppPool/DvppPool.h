@@ -31,6 +31,7 @@
 #include "MxBase/BlockingQueue/BlockingQueue.h"
 #include "MxBase/E2eInfer/GlobalInit/GlobalInit.h"
 #include "MxBase/DvppWrapper/DvppWrapperDataType.h"
+#include "DvppChnPool.h"
 
 namespace MxBase {
     enum class DvppChnType {
@@ -80,6 +81,15 @@ namespace MxBase {
         */
         APP_ERROR GetChn(int32_t deviceId, hi_s32 &chnId, DvppChnType chnType = DvppChnType::VPC);
 
+        /**
+        * @description: Get channel from pool without waiting, for callers that have another way to do the task.
+        * @param deviceId: device id.
+        * @param chnId: channel id.
+        * @param chnType: the channel type of the dvpp pool.
+        * @return: APP_ERR_COMM_BUSY when all channels are in use and no channel can be created.
+        */
+        APP_ERROR TryGetChn(int32_t deviceId, hi_s32 &chnId, DvppChnType chnType = DvppChnType::VPC);
+
         /**
          * @description: Put back channel to pool.
          * @param deviceId: device id.
@@ -88,6 +98,14 @@ namespace MxBase {
          */
         APP_ERROR PutChn(int32_t deviceId, hi_s32 &chnId, DvppChnType chnType = DvppChnType::VPC);
 
+        /**
+         * @description: Get the size, wait time and channel usage of a pool.
+         * @param deviceId: device id.
+         * @param chnType: the channel type of the dvpp pool.
+         * @param stats: statistics of the pool.
+         */
+        APP_ERROR GetPoolStats(int32_t deviceId, DvppChnType chnType, DvppPoolStats &stats);
+
     private:
         DvppPool() = default;
 
@@ -99,32 +117,27 @@ namespace MxBase {
 
         static APP_ERROR InitChnPoolOnDevice(int32_t deviceId, DvppChnType chnType = DvppChnType::VPC);
 
-        static APP_ERROR InitVpcPool(int32_t deviceId, uint32_t size);
+        static std::shared_ptr<DvppChnPool> FindPool(int32_t deviceId, DvppChnType chnType);
 
-        static APP_ERROR DeInitVpcPool();
+        static APP_ERROR AcquireChn(int32_t deviceId, hi_s32 &chnId, DvppChnType chnType, bool wait);
 
-        static APP_ERROR InitJpegdPool(int32_t deviceId, uint32_t size);
+        static APP_ERROR CreateVpcChn(hi_s32 &chnId);
 
-        static APP_ERROR SetJpegdChnParam(hi_vdec_chn channelId);
-
-        static APP_ERROR DeInitJpegdPool();
+        static APP_ERROR CreateJpegdChn(hi_s32 &chnId);
 
-        static APP_ERROR InitJpegePool(int32_t deviceId, uint32_t size);
+        static APP_ERROR SetJpegdChnParam(hi_vdec_chn channelId);
 
-        static APP_ERROR DeInitJpegePool();
+        static APP_ERROR CreatePngdChn(hi_s32 &chnId);
 
-        static APP_ERROR InitPngdPool(int32_t deviceId, uint32_t size);
+        static APP_ERROR CreateJpegeChn(hi_s32 &chnId);
 
-        static APP_ERROR DeInitPngdPool();
+        static APP_ERROR DestroyChn(DvppChnType chnType, hi_s32 chnId);
 
         static APP_ERROR HimpiSysExit();
 
     private:
         static AppGlobalCfgExtra dvppPoolCfg_;
-        static std::map <int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_vpc_chn>>> vpcChnQueueMap_;
-        static std::map <int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_vdec_chn>>> jpegdChnQueueMap_;
-        static std::map <int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_pngd_chn>>> pngdChnQueueMap_;
-        static std::map <int32_t, std::shared_ptr<MxBase::BlockingQueue<hi_venc_chn>>> jpegeChnQueueMap_;
+        static std::map<std::pair<int32_t, DvppChnType>, std::shared_ptr<DvppChnPool>> chnPoolMap_;
     };
 }
 
@@ -294,11 +294,11 @@ APP_ERROR DvppWrapperWithHiMpi::GetInputAddrFromStream(hi_venc_stream &stream, v
         std::lock_guard<std::mutex> lock(rgbToYuvPtrMapMutex_);
         if (rgbToYuvPtrMap_.count(*inputAddr) == 0) {
             LogError << "Cannot find the original ptr of yuv image data." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            hi_mpi_dvpp_free(*inputAddr);
+            DVPPMemoryFreeFunc(*inputAddr);
             return APP_ERR_COMM_INVALID_PARAM;
         } else {
             void* tmpAddr = rgbToYuvPtrMap_[*inputAddr];
-            hi_mpi_dvpp_free(*inputAddr);
+            DVPPMemoryFreeFunc(*inputAddr);
             rgbToYuvPtrMap_.erase(*inputAddr);
             *inputAddr = tmpAddr;
         }
@@ -2752,7 +2752,7 @@ APP_ERROR DvppWrapperWithHiMpi::ConvertToYuv(DvppDataInfo& inputDataInfo)
     {
         std::lock_guard<std::mutex> lock(rgbToYuvPtrMapMutex_);
         if (rgbToYuvPtrMap_.size() > MAX_CACHE_COUNT) {
-            hi_mpi_dvpp_free(static_cast<void*>(tmpOutputDataInfo.data));
+            DVPPMemoryFreeFunc(static_cast<void*>(tmpOutputDataInfo.data));
             LogError << "The number of the frame waiting for rgb encoding is too large, cannot send more data now."
                      << GetErrorInfo(APP_ERR_COMM_FULL);
             return APP_ERR_COMM_FULL;
@@ -2826,7 +2826,7 @@ APP_ERROR DvppWrapperWithHiMpi::DvppVenc(DvppDataInfo& inputDataInfo,
         LogError << "Failed to send video encode frame." << GetErrorInfo(ret, "hi_mpi_venc_send_frame");
         if (vencCvtColor_) {
             std::lock_guard<std::mutex> lock(rgbToYuvPtrMapMutex_);
-            hi_mpi_dvpp_free(static_cast<void*>(inputDataInfo.data));
+            DVPPMemoryFreeFunc(static_cast<void*>(inputDataInfo.data));
             rgbToYuvPtrMap_.erase(static_cast<void*>(inputDataInfo.data));
         }
         return APP_ERR_ACL_FAILURE;
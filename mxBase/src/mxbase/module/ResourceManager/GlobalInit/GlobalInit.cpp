@@ -136,6 +136,17 @@ APP_ERROR MxInit(const AppGlobalCfgExtra &globalCfgExtra)
                  << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
+    if (globalCfgExtra.vpcMaxChnNum > MAX_VPC_CHN_POOL_SIZE ||
+        globalCfgExtra.jpegdMaxChnNum > MAX_JPEGD_CHN_POOL_SIZE ||
+        globalCfgExtra.pngdMaxChnNum > MAX_PNGD_CHN_POOL_SIZE ||
+        globalCfgExtra.jpegeMaxChnNum > MAX_JPEGE_CHN_POOL_SIZE) {
+        LogError << "Max channel num of vpc, jpegd, pngd and jpege must be no greater than " << MAX_VPC_CHN_POOL_SIZE
+                 << ", " << MAX_JPEGD_CHN_POOL_SIZE << ", " << MAX_PNGD_CHN_POOL_SIZE << " and "
+                 << MAX_JPEGE_CHN_POOL_SIZE << ", input is: " << globalCfgExtra.vpcMaxChnNum << ", "
+                 << globalCfgExtra.jpegdMaxChnNum << ", " << globalCfgExtra.pngdMaxChnNum << " and "
+                 << globalCfgExtra.jpegeMaxChnNum << "." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
 
     APP_ERROR ret = MxBase::Log::Init();
     if (ret != APP_ERR_OK) {
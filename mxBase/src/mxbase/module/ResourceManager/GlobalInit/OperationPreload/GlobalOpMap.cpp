@@ -21,11 +21,73 @@
  */
 
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include "acl/acl.h"
+#include "MxBase/DeviceManager/DeviceManager.h"
+#include "ResourceManager/HAL/AclApi.h"
 #include "OperationLoaders/ConfigLoader.h"
 #include "OperationLoaders/OpLoader.h"
 #include "GlobalOpMap.h"
 
 namespace MxBase {
+namespace {
+    const char *PRELOAD_THREAD_NUM_ENV = "MX_OP_PRELOAD_THREAD_NUM";
+    const char *PRELOAD_CACHE_DIR_ENV = "MX_OP_PRELOAD_CACHE_DIR";
+    const char *ASCEND_HOME_PATH_ENV = "ASCEND_HOME_PATH";
+    const std::string COMPILER_VERSION_FILE = "/compiler/version.info";
+    const std::string VERSION_KEY = "Version=";
+    constexpr long DEFAULT_MAX_PRELOAD_THREAD_NUM = 8;
+    constexpr long MAX_PRELOAD_THREAD_NUM = 64;
+
+    uint32_t GetPreloadThreadNum()
+    {
+        long threadNum = std::min(std::max(static_cast<long>(std::thread::hardware_concurrency()), 1L),
+                                  DEFAULT_MAX_PRELOAD_THREAD_NUM);
+        const char *env = std::getenv(PRELOAD_THREAD_NUM_ENV);
+        if (env == nullptr) {
+            return static_cast<uint32_t>(threadNum);
+        }
+        try {
+            long value = std::stol(env);
+            if (value >= 1 && value <= MAX_PRELOAD_THREAD_NUM) {
+                return static_cast<uint32_t>(value);
+            }
+        } catch (const std::exception &e) {
+            LogDebug << "Parse " << PRELOAD_THREAD_NUM_ENV << " failed.";
+        }
+        LogWarn << PRELOAD_THREAD_NUM_ENV << " should be in [1, " << MAX_PRELOAD_THREAD_NUM << "], use "
+                << threadNum << " threads.";
+        return static_cast<uint32_t>(threadNum);
+    }
+
+    // The compiler version of the toolkit, or the version of acl when the toolkit is not found.
+    std::string GetCannVersion()
+    {
+        const char *homePath = std::getenv(ASCEND_HOME_PATH_ENV);
+        if (homePath != nullptr) {
+            std::ifstream file(std::string(homePath) + COMPILER_VERSION_FILE);
+            std::string line;
+            while (file && std::getline(file, line)) {
+                if (line.compare(0, VERSION_KEY.size(), VERSION_KEY) == 0) {
+                    return line.substr(VERSION_KEY.size());
+                }
+            }
+        }
+        int32_t major = 0;
+        int32_t minor = 0;
+        int32_t patch = 0;
+        if (aclrtGetVersion(&major, &minor, &patch) != ACL_SUCCESS) {
+            return "";
+        }
+        return "acl" + std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(patch);
+    }
+}
+
     GlobalOpMap::GlobalOpMap() {}
 
     GlobalOpMap::GlobalOpMap(std::string configFile)
@@ -134,8 +196,12 @@ namespace MxBase {
         return APP_ERR_OK;
     }
 
-    APP_ERROR GlobalOpMap::LoadAllOperations()
+    APP_ERROR GlobalOpMap::PrepareAllTasks(std::vector<OpPreloadTask> &tasks)
     {
+        if (configLoader == nullptr) {
+            LogError << "PrepareAllTasks: config is not loaded." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+            return APP_ERR_COMM_INIT_FAIL;
+        }
         APP_ERROR ret = APP_ERR_OK;
         std::vector<std::string> opNames;
         ret = configLoader->GetAllOpNames(opNames);
@@ -143,25 +209,183 @@ namespace MxBase {
             LogError << "ConfigLoader getAllOpNames failed." << GetErrorInfo(ret);
         }
         for (std::string opName: opNames) {
-            LogInfo << "Start Loading op " << opName << ".";
+            LogInfo << "Start preparing op " << opName << ".";
             JsonPtr jsonPtr;
             ret = configLoader->GetOpInfoByName(opName, jsonPtr);
             if (ret != APP_ERR_OK) {
-                LogError << "LoadOpHandles: failed to get info for op: " << opName << "." << GetErrorInfo(ret);
+                LogError << "LoadAllOperations: failed to get info for op: " << opName << "." << GetErrorInfo(ret);
                 continue;
             }
             if (g_LoaderMap.find(opName) == g_LoaderMap.end()) {
-                LogWarn << "LoadOpHandles: op [" << opName << "] not subscribed in Preload Op Map."
+                LogWarn << "LoadAllOperations: op [" << opName << "] not subscribed in Preload Op Map."
                          << GetErrorInfo(APP_ERR_COMM_FAILURE);
                 continue;
             }
-            ret = g_LoaderMap[opName]->LoadOpHandles(jsonPtr);
+            OpLoader *loader = g_LoaderMap[opName];
+            std::vector<OpPreloadTask> opTasks;
+            ret = loader->PrepareOpTasks(jsonPtr, opTasks);
             if (ret != APP_ERR_OK) {
-                LogError << "LoadOpHandles: failed to load op: " << opName << "." << GetErrorInfo(ret);
+                LogError << "LoadAllOperations: failed to load op: " << opName << "." << GetErrorInfo(ret);
                 continue;
             }
+            for (auto &task : opTasks) {
+                // Every task reads its own copy of the config, since the tasks run in different threads.
+                task.jsonPtr = MemoryHelper::MakeShared<JsonPtr>();
+                if (task.jsonPtr == nullptr) {
+                    LogError << "Create JsonPtr failed, failed to allocate memory."
+                             << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+                    continue;
+                }
+                if (configLoader->GetOpInfoByName(opName, *task.jsonPtr) != APP_ERR_OK) {
+                    continue;
+                }
+                task.signature = loader->GetOpSignature(*task.jsonPtr, task.index, task.opName, task.opSets);
+                tasks.push_back(task);
+            }
+        }
+        return ret;
+    }
+
+    bool GlobalOpMap::OpenPreloadCache()
+    {
+        const char *cacheDir = std::getenv(PRELOAD_CACHE_DIR_ENV);
+        if (cacheDir == nullptr || std::string(cacheDir).empty()) {
+            return false;
+        }
+        std::string cannVersion = GetCannVersion();
+        if (cannVersion.empty()) {
+            LogWarn << "The CANN version is unknown, the preload cache is not used.";
+            return false;
+        }
+        APP_ERROR ret = preloadCache_.Open(cacheDir, cannVersion);
+        if (ret != APP_ERR_OK) {
+            LogWarn << "Open the preload cache failed, the preload cache is not used." << GetErrorInfo(ret);
+            return false;
+        }
+        std::string kernelDir = preloadCache_.GetKernelDir();
+        ret = AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_COMPILER_CACHE_DIR, kernelDir.c_str());
+        if (ret == APP_ERR_OK) {
+            ret = AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_COMPILER_CACHE_MODE, "enable");
+        }
+        if (ret != APP_ERR_OK) {
+            LogWarn << "Set the compile cache option failed, the preload cache is not used." << GetErrorInfo(ret);
+            return false;
+        }
+        LogInfo << "Preload with the cache of CANN " << cannVersion << ".";
+        return true;
+    }
+
+    void GlobalOpMap::RunTask(const OpPreloadTask &task)
+    {
+        OpPreloadTiming timing;
+        timing.opName = task.opName;
+        timing.index = task.index;
+        timing.recorded = task.expectedCostMs > 0;
+        auto start = std::chrono::steady_clock::now();
+        timing.ret = task.loader->OpPreload(*task.jsonPtr, task.index, task.opName, task.opSets);
+        timing.costMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (timing.ret != APP_ERR_OK) {
+            LogError << "LoadAllOperations: Fail to precompile op: [" << task.opName << ", " << task.index << "]."
+                     << GetErrorInfo(timing.ret);
+        } else {
+            preloadCache_.Record(task.signature, timing.costMs);
+            LogInfo << "Load op [" << task.opName << ", " << task.index << "] success, cost " << timing.costMs
+                    << " ms" << (timing.recorded ? " (cached)." : ".");
+        }
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        timings_.push_back(timing);
+    }
+
+    void GlobalOpMap::RunTasks(std::vector<OpPreloadTask> &tasks, uint32_t threadNum)
+    {
+        std::atomic<size_t> next(0);
+        auto drain = [&tasks, &next, this]() {
+            for (size_t i = next++; i < tasks.size(); i = next++) {
+                RunTask(tasks[i]);
+            }
+        };
+        size_t workerNum = std::min(static_cast<size_t>(threadNum), tasks.size());
+        DeviceContext device;
+        bool hasDevice = workerNum > 1 && DeviceManager::GetInstance()->GetCurrentDevice(device) == APP_ERR_OK;
+        std::vector<std::thread> workers;
+        // The calling thread is one of the workers, so the preload goes on when no thread can be created.
+        for (size_t i = 1; i < workerNum; i++) {
+            try {
+                workers.emplace_back([&drain, &device, hasDevice]() {
+                    if (hasDevice && DeviceManager::GetInstance()->SetDevice(device) != APP_ERR_OK) {
+                        LogWarn << "Preload thread failed to set device " << device.devId << ".";
+                    }
+                    drain();
+                });
+            } catch (const std::system_error &e) {
+                LogWarn << "Create preload thread failed, preload with " << workers.size() + 1 << " threads.";
+                break;
+            }
+        }
+        drain();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void GlobalOpMap::ReportTimings(double wallTimeMs)
+    {
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        std::map<std::string, std::pair<size_t, double>> opCosts;
+        double totalMs = 0;
+        size_t recordedNum = 0;
+        size_t failedNum = 0;
+        for (const auto &timing : timings_) {
+            opCosts[timing.opName].first++;
+            opCosts[timing.opName].second += timing.costMs;
+            totalMs += timing.costMs;
+            recordedNum += timing.recorded ? 1 : 0;
+            failedNum += timing.ret != APP_ERR_OK ? 1 : 0;
         }
+        for (const auto &opCost : opCosts) {
+            LogInfo << "Preload op [" << opCost.first << "]: " << opCost.second.first << " specifications, cost "
+                    << opCost.second.second << " ms.";
+        }
+        LogInfo << "Preload " << timings_.size() << " specifications in " << wallTimeMs << " ms, compile time "
+                << totalMs << " ms, " << recordedNum << " preloaded before, " << failedNum << " failed.";
+    }
+
+    std::vector<OpPreloadTiming> GlobalOpMap::GetPreloadTimings()
+    {
+        std::lock_guard<std::mutex> lock(timingMutex_);
+        return timings_;
+    }
 
+    APP_ERROR GlobalOpMap::LoadAllOperations()
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<OpPreloadTask> tasks;
+        APP_ERROR ret = PrepareAllTasks(tasks);
+        bool useCache = OpenPreloadCache();
+        if (useCache) {
+            for (auto &task : tasks) {
+                preloadCache_.Find(task.signature, task.expectedCostMs);
+            }
+        }
+        // The ops of the same compile mode are kept together so that the mode is rarely switched, and the longest
+        // ones known from the cache start first so that the threads finish together.
+        std::stable_sort(tasks.begin(), tasks.end(), [](const OpPreloadTask &a, const OpPreloadTask &b) {
+            if (a.dynamicShape != b.dynamicShape) {
+                return a.dynamicShape;
+            }
+            return a.expectedCostMs > b.expectedCostMs;
+        });
+        {
+            std::lock_guard<std::mutex> lock(timingMutex_);
+            timings_.clear();
+        }
+        RunTasks(tasks, GetPreloadThreadNum());
+        ReportTimings(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        if (useCache) {
+            preloadCache_.Save();
+            // The operators compiled at runtime do not use the cache.
+            AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_COMPILER_CACHE_MODE, "disable");
+        }
         return ret;
     }
-}
\ No newline at end of file
+}
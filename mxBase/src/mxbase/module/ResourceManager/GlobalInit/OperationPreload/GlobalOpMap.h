@@ -23,6 +23,7 @@
 #ifndef MXBASE_GLOBALOPMAP_H
 #define MXBASE_GLOBALOPMAP_H
 
+#include <mutex>
 #include "OperationLoaders/ConfigLoader.h"
 #include "OperationLoaders/OpLoader.h"
 #include "OperationLoaders/OpLoaderSplit.h"
@@ -40,8 +41,16 @@
 #include "OperationLoaders/OpLoaderSort.h"
 #include "OperationLoaders/OpLoaderDivide.h"
 #include "OperationLoaders/OpLoaderMultiply.h"
+#include "OpPreloadCache.h"
 
 namespace MxBase {
+    struct OpPreloadTiming {
+        std::string opName;
+        size_t index = 0;
+        double costMs = 0;
+        bool recorded = false;  // preloaded before with the same signature, the kernel is in the compile cache
+        APP_ERROR ret = APP_ERR_OK;
+    };
 
     class GlobalOpMap {
     public:
@@ -59,9 +68,29 @@ namespace MxBase {
 
         APP_ERROR InitLoaderMap();
 
+        /**
+         * @description: Compile the ops of all the preload lists with MX_OP_PRELOAD_THREAD_NUM threads. When
+         * MX_OP_PRELOAD_CACHE_DIR is set the compiled kernels are cached there and reused by the next processes.
+         */
         APP_ERROR LoadAllOperations();
 
+        std::vector<OpPreloadTiming> GetPreloadTimings();
+
+    private:
+        APP_ERROR PrepareAllTasks(std::vector<OpPreloadTask> &tasks);
+
+        bool OpenPreloadCache();
+
+        void RunTasks(std::vector<OpPreloadTask> &tasks, uint32_t threadNum);
+
+        void RunTask(const OpPreloadTask &task);
+
+        void ReportTimings(double wallTimeMs);
+
     private:
+        OpPreloadCache preloadCache_;
+        std::vector<OpPreloadTiming> timings_;
+        std::mutex timingMutex_;
         std::map<std::string, OpLoader *> g_LoaderMap;
         ConfigLoader *configLoader = nullptr;
         OpLoader *opLoaderAdd = nullptr;
@@ -0,0 +1,155 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: On-disk record of the preloaded operators and of their compile cost.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "OpPreloadCache.h"
+#include <cctype>
+#include <cstdio>
+#include <unistd.h>
+#include <sstream>
+#include "MxBase/Log/Log.h"
+#include "MxBase/Utils/FileUtils.h"
+
+namespace MxBase {
+    namespace {
+        const std::string MANIFEST_PREFIX = "preload_";
+        const std::string MANIFEST_SUFFIX = ".manifest";
+        const std::string KERNEL_DIR_PREFIX = "kernel_";
+        const std::string TMP_SUFFIX = ".tmp";
+        constexpr char FIELD_DELIMITER = '\t';
+
+        std::string ToFileNamePart(const std::string &version)
+        {
+            std::string part;
+            for (unsigned char c : version) {
+                part += (std::isalnum(c) || c == '.') ? static_cast<char>(c) : '_';
+            }
+            return part.empty() ? "unknown" : part;
+        }
+    }
+
+    APP_ERROR OpPreloadCache::Open(const std::string &cacheDir, const std::string &cannVersion)
+    {
+        if (cacheDir.empty()) {
+            LogError << "OpPreloadCache: cache directory is empty." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+        std::string versionPart = ToFileNamePart(cannVersion);
+        std::string kernelDir = cacheDir + "/" + KERNEL_DIR_PREFIX + versionPart;
+        if (!FileUtils::CreateDirectories(kernelDir)) {
+            LogError << "OpPreloadCache: failed to create the cache directory."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PATH);
+            return APP_ERR_COMM_INVALID_PATH;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        kernelDir_ = kernelDir;
+        manifestPath_ = cacheDir + "/" + MANIFEST_PREFIX + versionPart + MANIFEST_SUFFIX;
+        records_.clear();
+        changed_ = false;
+        return LoadManifest();
+    }
+
+    APP_ERROR OpPreloadCache::LoadManifest()
+    {
+        if (!FileUtils::CheckFileExists(manifestPath_)) {
+            LogInfo << "OpPreloadCache: no manifest for this CANN version, all operators are compiled.";
+            return APP_ERR_OK;
+        }
+        std::string content = FileUtils::ReadFileContent(manifestPath_);
+        std::istringstream stream(content);
+        std::string line;
+        while (std::getline(stream, line)) {
+            size_t pos = line.find(FIELD_DELIMITER);
+            if (pos == std::string::npos || pos + 1 >= line.size()) {
+                continue;
+            }
+            try {
+                records_[line.substr(pos + 1)] = std::stod(line.substr(0, pos));
+            } catch (const std::exception &e) {
+                LogWarn << "OpPreloadCache: skip an invalid manifest line.";
+            }
+        }
+        LogInfo << "OpPreloadCache: " << records_.size() << " operators recorded in the manifest.";
+        return APP_ERR_OK;
+    }
+
+    bool OpPreloadCache::IsOpen() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return !manifestPath_.empty();
+    }
+
+    std::string OpPreloadCache::GetKernelDir() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return kernelDir_;
+    }
+
+    bool OpPreloadCache::Find(const std::string &signature, double &costMs) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = records_.find(signature);
+        if (iter == records_.end()) {
+            return false;
+        }
+        costMs = iter->second;
+        return true;
+    }
+
+    void OpPreloadCache::Record(const std::string &signature, double costMs)
+    {
+        if (signature.find_first_of("\t\n") != std::string::npos) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto iter = records_.find(signature);
+        // Keep the cost of the first compilation, a cached one is much cheaper and would misorder the next preload.
+        if (iter == records_.end()) {
+            records_[signature] = costMs;
+            changed_ = true;
+        }
+    }
+
+    APP_ERROR OpPreloadCache::Save()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (manifestPath_.empty() || !changed_) {
+            return APP_ERR_OK;
+        }
+        std::ostringstream content;
+        for (const auto &record : records_) {
+            content << record.second << FIELD_DELIMITER << record.first << "\n";
+        }
+        // Written aside and renamed, so the processes preloading at the same time never read a partial manifest.
+        std::string tmpPath = manifestPath_ + "." + std::to_string(getpid()) + TMP_SUFFIX;
+        if (!FileUtils::WriteFileContent(tmpPath, content.str())) {
+            LogError << "OpPreloadCache: failed to write the manifest." << GetErrorInfo(APP_ERR_COMM_WRITE_FAIL);
+            return APP_ERR_COMM_WRITE_FAIL;
+        }
+        if (std::rename(tmpPath.c_str(), manifestPath_.c_str()) != 0) {
+            FileUtils::RemoveFile(tmpPath);
+            LogError << "OpPreloadCache: failed to replace the manifest." << GetErrorInfo(APP_ERR_COMM_WRITE_FAIL);
+            return APP_ERR_COMM_WRITE_FAIL;
+        }
+        changed_ = false;
+        return APP_ERR_OK;
+    }
+}
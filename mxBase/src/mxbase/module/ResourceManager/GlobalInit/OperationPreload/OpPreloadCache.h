@@ -0,0 +1,70 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: On-disk record of the preloaded operators and of their compile cost.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_OPPRELOADCACHE_H
+#define MXBASE_OPPRELOADCACHE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "MxBase/ErrorCode/ErrorCode.h"
+
+namespace MxBase {
+    /**
+     * The compiled kernels are kept by the compile cache of ACL in the kernel directory, the manifest records the
+     * signature and the compile cost of every operator preloaded before. Both are kept per CANN version, so a new
+     * CANN never reads the artifacts of another one.
+     */
+    class OpPreloadCache {
+    public:
+        OpPreloadCache() = default;
+
+        OpPreloadCache(const OpPreloadCache&) = delete;
+
+        OpPreloadCache& operator=(const OpPreloadCache&) = delete;
+
+        ~OpPreloadCache() = default;
+
+        APP_ERROR Open(const std::string &cacheDir, const std::string &cannVersion);
+
+        bool IsOpen() const;
+
+        std::string GetKernelDir() const;
+
+        bool Find(const std::string &signature, double &costMs) const;
+
+        void Record(const std::string &signature, double costMs);
+
+        APP_ERROR Save();
+
+    private:
+        APP_ERROR LoadManifest();
+
+    private:
+        std::string manifestPath_;
+        std::string kernelDir_;
+        std::map<std::string, double> records_;
+        bool changed_ = false;
+        mutable std::mutex mutex_;
+    };
+}
+#endif
@@ -25,6 +25,47 @@
 #include "OpLoader.h"
 
 namespace MxBase {
+    namespace {
+        constexpr int COMPILE_MODE_UNSET = -1;
+        constexpr int COMPILE_MODE_STATIC = 0;
+        constexpr int COMPILE_MODE_JIT = 1;
+    }
+
+    std::mutex OpCompileModeGate::mutex_;
+    std::condition_variable OpCompileModeGate::cond_;
+    int OpCompileModeGate::holderNum_ = 0;
+    int OpCompileModeGate::currentMode_ = COMPILE_MODE_UNSET;
+
+    APP_ERROR OpCompileModeGate::Acquire(bool jitCompile)
+    {
+        int mode = jitCompile ? COMPILE_MODE_JIT : COMPILE_MODE_STATIC;
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [mode]() { return holderNum_ == 0 || currentMode_ == mode; });
+        if (currentMode_ != mode) {
+            APP_ERROR ret = AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_JIT_COMPILE,
+                                                     jitCompile ? "enable" : "disable");
+            if (ret != APP_ERR_OK) {
+                return ret;
+            }
+            currentMode_ = mode;
+        }
+        holderNum_++;
+        return APP_ERR_OK;
+    }
+
+    void OpCompileModeGate::Release()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (holderNum_ > 0) {
+            holderNum_--;
+        }
+        if (holderNum_ == 0) {
+            // The option may be changed by the operators compiled at runtime, so it is set again next time.
+            currentMode_ = COMPILE_MODE_UNSET;
+            cond_.notify_all();
+        }
+    }
+
     OpLoader::OpLoader()
     {
         opInfoJsonPtr_ = MemoryHelper::MakeShared<MxBase::JsonPtr>();
@@ -542,7 +583,13 @@ namespace MxBase {
             return ret;
         }
 
-        ret = AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_JIT_COMPILE, "enable");
+        bool jitCompile = true;
+        auto iter = toDynamicSupportMap.find(opName);
+        if (iter != toDynamicSupportMap.end() && iter->second) {
+            LogDebug << "Custom op support dynamic.";
+            jitCompile = false;
+        }
+        ret = OpCompileModeGate::Acquire(jitCompile);
         if (ret != APP_ERR_OK) {
             aclopDestroyAttr(opAttr);
             auto deInitRet = opDesc.DeInit();
@@ -552,22 +599,6 @@ namespace MxBase {
             LogError  << "Set compile flag failed" << GetErrorInfo(ret);
             return ret;
         }
-        auto iter = toDynamicSupportMap.find(opName);
-        if (iter != toDynamicSupportMap.end()) {
-            if (iter->second) {
-                LogDebug << "Custom op support dynamic.";
-                ret = AclApi::aclSetCompileopt(aclCompileOpt::ACL_OP_JIT_COMPILE, "disable");
-                if (ret != APP_ERR_OK) {
-                    aclopDestroyAttr(opAttr);
-                    auto deInitRet = opDesc.DeInit();
-                    if (deInitRet != APP_ERR_OK) {
-                        LogError << "OpPreload: OperatorDesc deinit failed." << GetErrorInfo(deInitRet);
-                    }
-                    LogError << "set compile flag failed" << GetErrorInfo(ret);
-                    return ret;
-                }
-            }
-        }
 
         // 2. Op Compile.
         ret = AclApi::aclopCompile(opName.c_str(), opDesc.GetInputDesc().size(),
@@ -575,6 +606,7 @@ namespace MxBase {
                                    opDesc.GetOutputDesc().size(),
                                    reinterpret_cast<aclTensorDesc **>(opDesc.GetOutputDesc().data()),
                                    opAttr, ACL_ENGINE_SYS, ACL_COMPILE_SYS, nullptr);
+        OpCompileModeGate::Release();
         if (ret != APP_ERR_OK) {
             aclopDestroyAttr(opAttr);
             auto deInitRet = opDesc.DeInit();
@@ -594,48 +626,83 @@ namespace MxBase {
         return ret;
     }
 
-    APP_ERROR OpLoader::LoadOpHandles(const JsonPtr &jsonPtr)
+    APP_ERROR OpLoader::PrepareOpTasks(const JsonPtr &jsonPtr, std::vector<OpPreloadTask> &tasks)
     {
-        APP_ERROR ret = APP_ERR_OK;
         std::string opName;
-        ret = GetOpName(jsonPtr, opName);
+        APP_ERROR ret = GetOpName(jsonPtr, opName);
         if (ret != APP_ERR_OK) {
-            LogError << "LoadOpHandles: GetOpName failed. opName: " << opName << "." << GetErrorInfo(ret);
+            LogError << "PrepareOpTasks: GetOpName failed. opName: " << opName << "." << GetErrorInfo(ret);
             return ret;
         }
         std::string preloadListString;
         ret = jsonPtr.GetPreloadList(preloadListString);
         if (ret != APP_ERR_OK) {
-            LogError << "LoadOpHandles: GetPreloadList failed. opName: " << opName << "." << GetErrorInfo(ret);
+            LogError << "PrepareOpTasks: GetPreloadList failed. opName: " << opName << "." << GetErrorInfo(ret);
             return ret;
         }
         auto preloadList = nlohmann::json::parse(preloadListString);
 
         for (size_t i = 0; i < preloadList.size(); i++) {
-            // 1. preprocess json file, read the properties.
             OpSettings opSets;
             ret = GetSettingByIndex(jsonPtr, opSets, i, opName);
             if (ret != APP_ERR_OK) {
-                LogError << "LoadOpHandles: get [" << opName << ", " << i << "] configs failed." << GetErrorInfo(ret);
+                LogError << "PrepareOpTasks: get [" << opName << ", " << i << "] configs failed." << GetErrorInfo(ret);
                 continue;
             }
-
-            // 2. Preload the op.
             ret = CheckOpParams(opSets);
             if (ret != APP_ERR_OK) {
-                LogError << "LoadOpHandles: [" << opType_ << ", " << i << "] failed to check params."
+                LogError << "PrepareOpTasks: [" << opType_ << ", " << i << "] failed to check params."
                          << GetErrorInfo(ret);
                 continue;
             }
-            ret = OpPreload(jsonPtr, i, opName, opSets);
+            OpPreloadTask task;
+            task.loader = this;
+            task.index = i;
+            task.opName = opName;
+            task.opSets = opSets;
+            auto iter = toDynamicSupportMap.find(opName);
+            task.dynamicShape = iter != toDynamicSupportMap.end() && iter->second;
+            tasks.push_back(task);
+        }
+        return APP_ERR_OK;
+    }
+
+    std::string OpLoader::GetOpSignature(const JsonPtr &jsonPtr, size_t index, const std::string &opName,
+                                         const OpSettings &opSets)
+    {
+        std::string attrName;
+        std::string attrType;
+        std::string attrVal;
+        // Ops without attributes have no such keys, the attributes are empty in the signature then.
+        if (jsonPtr.GetAttrNameByIndex(index, attrName) != APP_ERR_OK ||
+            jsonPtr.GetAttrTypeByIndex(index, attrType) != APP_ERR_OK ||
+            jsonPtr.GetAttrValByIndex(index, attrVal) != APP_ERR_OK) {
+            attrName.clear();
+            attrType.clear();
+            attrVal.clear();
+        }
+        return opType_ + "|" + opName + "|" + opSets.inputType + "|" + opSets.inputShape + "|" +
+            opSets.outputType + "|" + opSets.outputShape + "|" + attrName + "|" + attrType + "|" + attrVal;
+    }
+
+    APP_ERROR OpLoader::LoadOpHandles(const JsonPtr &jsonPtr)
+    {
+        std::vector<OpPreloadTask> tasks;
+        APP_ERROR ret = PrepareOpTasks(jsonPtr, tasks);
+        if (ret != APP_ERR_OK) {
+            LogError << "LoadOpHandles: PrepareOpTasks failed. opType: " << opType_ << "." << GetErrorInfo(ret);
+            return ret;
+        }
+        for (const auto &task : tasks) {
+            ret = OpPreload(jsonPtr, task.index, task.opName, task.opSets);
             if (ret != APP_ERR_OK) {
-                LogError << "LoadOpHandles: Fail to precompile op: [" << opName << ", " << i << "]."
+                LogError << "LoadOpHandles: Fail to precompile op: [" << task.opName << ", " << task.index << "]."
                          << GetErrorInfo(ret);
                 continue;
             }
-            LogInfo << "Load op [" << opName << ", " << i << "] success.";
+            LogInfo << "Load op [" << task.opName << ", " << task.index << "] success.";
         }
-        LogInfo << "Load op [" << opName  << "] finished.";
+        LogInfo << "Load op [" << opType_ << "] finished.";
         return APP_ERR_OK;
     }
-}
\ No newline at end of file
+}
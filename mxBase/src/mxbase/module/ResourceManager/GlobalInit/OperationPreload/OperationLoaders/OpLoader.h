@@ -23,6 +23,8 @@
 #ifndef MXBASE_OPLOADER_H
 #define MXBASE_OPLOADER_H
 
+#include <condition_variable>
+#include <mutex>
 #include "acl/acl_op_compiler.h"
 #include "acl/ops/acl_dvpp.h"
 #include "acl/dvpp/hi_dvpp.h"
@@ -60,6 +62,34 @@ namespace MxBase {
         std::vector<std::string> attrName;
         std::vector<std::string> attrType;
     };
+    class OpLoader;
+    // One entry of a preload_list, checked and ready to be compiled.
+    struct OpPreloadTask {
+        OpLoader *loader = nullptr;
+        std::shared_ptr<JsonPtr> jsonPtr;
+        size_t index = 0;
+        std::string opName;
+        OpSettings opSets;
+        bool dynamicShape = false;
+        std::string signature;
+        double expectedCostMs = 0;
+    };
+    /**
+     * The ACL_OP_JIT_COMPILE option is process wide, the gate lets the compilations of the same mode run at the
+     * same time and switches the mode when none is running.
+     */
+    class OpCompileModeGate {
+    public:
+        static APP_ERROR Acquire(bool jitCompile);
+
+        static void Release();
+
+    private:
+        static std::mutex mutex_;
+        static std::condition_variable cond_;
+        static int holderNum_;
+        static int currentMode_;
+    };
     class OpLoader {
     public:
         OpLoader();
@@ -74,6 +104,15 @@ namespace MxBase {
 
         virtual APP_ERROR LoadOpHandles(const JsonPtr &jsonPtr);
 
+        /**
+         * @description: Read and check every entry of the preload_list, the tasks are compiled later by OpPreload.
+         * @return: error of the op name or the preload_list, invalid entries are skipped.
+         */
+        APP_ERROR PrepareOpTasks(const JsonPtr &jsonPtr, std::vector<OpPreloadTask> &tasks);
+
+        std::string GetOpSignature(const JsonPtr &jsonPtr, size_t index, const std::string &opName,
+                                   const OpSettings &opSets);
+
         const std::map<std::string, OpDataType> toOpDataTypeMap = {
             {"float",   OpDataType::OP_FLOAT},
             {"float16", OpDataType::OP_FLOAT16},
@@ -0,0 +1,443 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Caching allocator for the device and dvpp memory of MemoryHelper.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxBase/MemoryHelper/MemoryCache.h"
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "acl/acl.h"
+#include "acl/dvpp/hi_dvpp.h"
+#include "MxBase/MemoryHelper/CustomizedMemoryHelper.h"
+#include "MxBase/Log/Log.h"
+
+namespace MxBase {
+namespace {
+constexpr size_t BLOCK_ALIGN = 512;
+constexpr size_t SMALL_SIZE = 1024 * 1024;
+constexpr size_t SMALL_SEGMENT_SIZE = 2 * 1024 * 1024;
+constexpr size_t MIN_LARGE_SPLIT_SIZE = 1024 * 1024;
+constexpr size_t CLASS_STEP_NUM = 4;
+constexpr size_t MAX_SEGMENT_SIZE = UINT_MAX;
+constexpr size_t DEFAULT_MAX_CACHED_SIZE = 512 * 1024 * 1024;
+constexpr size_t DEFAULT_MAX_BLOCK_SIZE = 256 * 1024 * 1024;
+
+struct Block {
+    int32_t deviceId = 0;
+    bool small = false;
+    bool allocated = false;
+    size_t size = 0;
+    void* ptr = nullptr;
+    // neighbours in the segment, a segment is one free block without neighbours when it can be released
+    Block* prev = nullptr;
+    Block* next = nullptr;
+};
+
+struct BlockLess {
+    bool operator()(const Block* left, const Block* right) const
+    {
+        if (left->size != right->size) {
+            return left->size < right->size;
+        }
+        return std::less<void*>()(left->ptr, right->ptr);
+    }
+};
+
+using BlockBin = std::set<Block*, BlockLess>;
+
+struct DevicePool {
+    BlockBin smallBin;
+    BlockBin largeBin;
+
+    BlockBin& GetBin(bool small)
+    {
+        return small ? smallBin : largeBin;
+    }
+};
+
+size_t RoundSize(size_t size)
+{
+    size_t rounded = (size + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+    if (rounded <= SMALL_SIZE) {
+        return rounded;
+    }
+    // CLASS_STEP_NUM classes between two powers of two, at most a quarter of the request is wasted
+    size_t power = SMALL_SIZE;
+    while (power * 2 < rounded) {
+        power *= 2;
+    }
+    size_t step = power / CLASS_STEP_NUM;
+    return (rounded + step - 1) / step * step;
+}
+
+class CachingAllocator {
+public:
+    explicit CachingAllocator(MemoryData::MemoryType type) : type_(type) {}
+
+    ~CachingAllocator() = default;
+
+    void SetConfig(const MemoryCacheConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        config_ = config;
+        ReleaseOverCap();
+    }
+
+    APP_ERROR Malloc(int32_t deviceId, void** ptr, size_t size);
+
+    APP_ERROR Free(void* ptr);
+
+    bool InUse()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return !allocatedBlocks_.empty() || !directBlocks_.empty();
+    }
+
+    void Trim()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        ReleaseSegments(0);
+    }
+
+    MemoryCacheStats GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return stats_;
+    }
+
+private:
+    APP_ERROR DriverMalloc(int32_t deviceId, void** ptr, size_t size) const;
+    APP_ERROR DriverFree(void* ptr) const;
+    Block* AllocSegment(int32_t deviceId, bool small, size_t size);
+    void SplitBlock(Block* block, size_t size);
+    void ReleaseOverCap();
+    void ReleaseSegments(size_t keepSize);
+
+private:
+    MemoryData::MemoryType type_;
+    std::mutex mtx_ = {};
+    MemoryCacheConfig config_ = {};
+    std::map<int32_t, DevicePool> pools_ = {};
+    std::unordered_map<void*, Block*> allocatedBlocks_ = {};
+    std::unordered_map<void*, size_t> directBlocks_ = {};
+    MemoryCacheStats stats_ = {};
+};
+
+APP_ERROR CachingAllocator::DriverMalloc(int32_t deviceId, void** ptr, size_t size) const
+{
+    if (type_ == MemoryData::MEMORY_DVPP) {
+        return hi_mpi_dvpp_malloc(static_cast<hi_u32>(deviceId), ptr, size);
+    }
+    return aclrtMallocAdapter(ptr, static_cast<unsigned int>(size), MX_MEM_MALLOC_HUGE_FIRST);
+}
+
+APP_ERROR CachingAllocator::DriverFree(void* ptr) const
+{
+    if (type_ == MemoryData::MEMORY_DVPP) {
+        return hi_mpi_dvpp_free(ptr);
+    }
+    return aclrtFree(ptr);
+}
+
+Block* CachingAllocator::AllocSegment(int32_t deviceId, bool small, size_t size)
+{
+    void* ptr = nullptr;
+    APP_ERROR ret = DriverMalloc(deviceId, &ptr, size);
+    if (ret != APP_ERR_OK) {
+        // the cached segments of all devices may hold the memory, release them and try again
+        LogDebug << "Failed to allocate a segment of " << size << " bytes, release the cached segments.";
+        ReleaseSegments(0);
+        ret = DriverMalloc(deviceId, &ptr, size);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to allocate a segment of " << size << " bytes." << GetErrorInfo(ret);
+            return nullptr;
+        }
+    }
+    Block* block = new (std::nothrow) Block();
+    if (block == nullptr) {
+        LogError << "Failed to create the block of a segment." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        DriverFree(ptr);
+        return nullptr;
+    }
+    block->deviceId = deviceId;
+    block->small = small;
+    block->size = size;
+    block->ptr = ptr;
+    stats_.driverMallocCount++;
+    stats_.reservedSize += size;
+    stats_.peakReservedSize = std::max(stats_.peakReservedSize, stats_.reservedSize);
+    return block;
+}
+
+void CachingAllocator::SplitBlock(Block* block, size_t size)
+{
+    size_t remaining = block->size - size;
+    if (remaining < (block->small ? BLOCK_ALIGN : MIN_LARGE_SPLIT_SIZE + 1)) {
+        return;
+    }
+    Block* rest = new (std::nothrow) Block();
+    if (rest == nullptr) {
+        // the block is used whole
+        return;
+    }
+    rest->deviceId = block->deviceId;
+    rest->small = block->small;
+    rest->size = remaining;
+    rest->ptr = static_cast<uint8_t*>(block->ptr) + size;
+    rest->prev = block;
+    rest->next = block->next;
+    if (block->next != nullptr) {
+        block->next->prev = rest;
+    }
+    block->next = rest;
+    block->size = size;
+    pools_[block->deviceId].GetBin(block->small).insert(rest);
+}
+
+APP_ERROR CachingAllocator::Malloc(int32_t deviceId, void** ptr, size_t size)
+{
+    size_t roundedSize = RoundSize(size);
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (size == 0 || size > config_.maxBlockSize || roundedSize > MAX_SEGMENT_SIZE) {
+        APP_ERROR ret = DriverMalloc(deviceId, ptr, size);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to allocate " << size << " bytes." << GetErrorInfo(ret);
+            return ret;
+        }
+        directBlocks_[*ptr] = size;
+        stats_.directMallocCount++;
+        return APP_ERR_OK;
+    }
+    bool small = roundedSize <= SMALL_SIZE;
+    BlockBin& bin = pools_[deviceId].GetBin(small);
+    Block key;
+    key.size = roundedSize;
+    auto iter = bin.lower_bound(&key);
+    Block* block = nullptr;
+    if (iter != bin.end()) {
+        block = *iter;
+        bin.erase(iter);
+        stats_.hitCount++;
+    } else {
+        block = AllocSegment(deviceId, small, small ? SMALL_SEGMENT_SIZE : roundedSize);
+        if (block == nullptr) {
+            return APP_ERR_COMM_ALLOC_MEM;
+        }
+    }
+    SplitBlock(block, roundedSize);
+    block->allocated = true;
+    allocatedBlocks_[block->ptr] = block;
+    stats_.mallocCount++;
+    stats_.allocatedSize += block->size;
+    *ptr = block->ptr;
+    return APP_ERR_OK;
+}
+
+APP_ERROR CachingAllocator::Free(void* ptr)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto iter = allocatedBlocks_.find(ptr);
+    if (iter == allocatedBlocks_.end()) {
+        // direct blocks and the memory allocated before the cache was enabled
+        directBlocks_.erase(ptr);
+        return DriverFree(ptr);
+    }
+    Block* block = iter->second;
+    allocatedBlocks_.erase(iter);
+    block->allocated = false;
+    stats_.allocatedSize -= block->size;
+    BlockBin& bin = pools_[block->deviceId].GetBin(block->small);
+    Block* prev = block->prev;
+    if (prev != nullptr && !prev->allocated) {
+        bin.erase(prev);
+        prev->size += block->size;
+        prev->next = block->next;
+        if (block->next != nullptr) {
+            block->next->prev = prev;
+        }
+        delete block;
+        block = prev;
+    }
+    Block* next = block->next;
+    if (next != nullptr && !next->allocated) {
+        bin.erase(next);
+        block->size += next->size;
+        block->next = next->next;
+        if (next->next != nullptr) {
+            next->next->prev = block;
+        }
+        delete next;
+    }
+    bin.insert(block);
+    ReleaseOverCap();
+    return APP_ERR_OK;
+}
+
+void CachingAllocator::ReleaseOverCap()
+{
+    size_t cachedSize = stats_.reservedSize - stats_.allocatedSize;
+    if (cachedSize > config_.maxCachedSize) {
+        ReleaseSegments(config_.maxCachedSize);
+    }
+}
+
+void CachingAllocator::ReleaseSegments(size_t keepSize)
+{
+    std::vector<Block*> segments;
+    for (auto& pool : pools_) {
+        for (bool small : {false, true}) {
+            for (auto block : pool.second.GetBin(small)) {
+                if (block->prev == nullptr && block->next == nullptr) {
+                    segments.push_back(block);
+                }
+            }
+        }
+    }
+    // the largest segments first, so that few driver calls bring the cache under the cap
+    std::sort(segments.begin(), segments.end(), [](const Block* left, const Block* right) {
+        return left->size > right->size;
+    });
+    for (auto block : segments) {
+        if (stats_.reservedSize - stats_.allocatedSize <= keepSize) {
+            break;
+        }
+        APP_ERROR ret = DriverFree(block->ptr);
+        if (ret != APP_ERR_OK) {
+            LogWarn << "Failed to free a cached segment of " << block->size << " bytes, error(" << ret << ").";
+            continue;
+        }
+        pools_[block->deviceId].GetBin(block->small).erase(block);
+        stats_.driverFreeCount++;
+        stats_.reservedSize -= block->size;
+        delete block;
+    }
+}
+
+CachingAllocator g_deviceCache(MemoryData::MEMORY_DEVICE);
+CachingAllocator g_dvppCache(MemoryData::MEMORY_DVPP);
+
+CachingAllocator* GetCache(MemoryData::MemoryType type)
+{
+    if (type == MemoryData::MEMORY_DEVICE) {
+        return &g_deviceCache;
+    }
+    if (type == MemoryData::MEMORY_DVPP) {
+        return &g_dvppCache;
+    }
+    LogError << "The memory type(" << type << ") has no cache, only device and dvpp memory are cached."
+             << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+    return nullptr;
+}
+
+APP_ERROR CachingDeviceMalloc(void** devPtr, unsigned int size, MxMemMallocPolicy policy)
+{
+    int32_t deviceId = 0;
+    if (policy != MX_MEM_MALLOC_HUGE_FIRST || aclrtGetDevice(&deviceId) != APP_ERR_OK) {
+        return aclrtMallocAdapter(devPtr, size, policy);
+    }
+    return g_deviceCache.Malloc(deviceId, devPtr, size);
+}
+
+APP_ERROR CachingDeviceFree(void* devPtr)
+{
+    return g_deviceCache.Free(devPtr);
+}
+
+APP_ERROR CachingDvppMalloc(unsigned int deviceId, void** devPtr, unsigned long long size)
+{
+    return g_dvppCache.Malloc(static_cast<int32_t>(deviceId), devPtr, size);
+}
+
+APP_ERROR CachingDvppFree(void* devPtr)
+{
+    return g_dvppCache.Free(devPtr);
+}
+}
+
+MemoryCacheConfig::MemoryCacheConfig() : maxCachedSize(DEFAULT_MAX_CACHED_SIZE), maxBlockSize(DEFAULT_MAX_BLOCK_SIZE)
+{
+}
+
+APP_ERROR MemoryCache::Enable(MemoryData::MemoryType type, const MemoryCacheConfig& config)
+{
+    CachingAllocator* cache = GetCache(type);
+    if (cache == nullptr) {
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    cache->SetConfig(config);
+    if (type == MemoryData::MEMORY_DEVICE) {
+        DeviceMallocFuncHookReg(CachingDeviceMalloc);
+        DeviceFreeFuncHookReg(CachingDeviceFree);
+    } else {
+        DVPPMallocFuncHookReg(CachingDvppMalloc);
+        DVPPFreeFuncHookReg(CachingDvppFree);
+    }
+    LogInfo << "Enable the memory cache of type(" << type << "), max cached size(" << config.maxCachedSize
+            << "), max block size(" << config.maxBlockSize << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MemoryCache::Disable(MemoryData::MemoryType type)
+{
+    CachingAllocator* cache = GetCache(type);
+    if (cache == nullptr) {
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (cache->InUse()) {
+        LogError << "The memory cache of type(" << type << ") is in use, free the memory before disabling it."
+                 << GetErrorInfo(APP_ERR_COMM_BUSY);
+        return APP_ERR_COMM_BUSY;
+    }
+    cache->Trim();
+    if (type == MemoryData::MEMORY_DEVICE) {
+        DeviceMallocFuncHookReg(aclrtMallocAdapter);
+        DeviceFreeFuncHookReg(aclrtFree);
+    } else {
+        DVPPMallocFuncHookReg(hi_mpi_dvpp_malloc);
+        DVPPFreeFuncHookReg(hi_mpi_dvpp_free);
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR MemoryCache::Trim(MemoryData::MemoryType type)
+{
+    CachingAllocator* cache = GetCache(type);
+    if (cache == nullptr) {
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    cache->Trim();
+    return APP_ERR_OK;
+}
+
+APP_ERROR MemoryCache::GetStats(MemoryData::MemoryType type, MemoryCacheStats& stats)
+{
+    CachingAllocator* cache = GetCache(type);
+    if (cache == nullptr) {
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    stats = cache->GetStats();
+    return APP_ERR_OK;
+}
+}  // namespace MxBase
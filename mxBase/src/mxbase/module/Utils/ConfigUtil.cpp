@@ -264,6 +264,11 @@ std::string ConfigData::GetClassName(const size_t classId)
     return labelVec_[classId];
 }
 
+const std::vector<std::string> &ConfigData::GetClassNames() const
+{
+    return labelVec_;
+}
+
 /**
  * @description: Load content
  * @param config  file path or file content
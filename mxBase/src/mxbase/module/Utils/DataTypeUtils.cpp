@@ -20,9 +20,76 @@
  * History: NA
  */
 
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 #include "MxBase/Utils/DataTypeUtils.h"
 
+namespace {
+const uint32_t FP16_EXP_MASK = 0x1f;
+const uint32_t FP16_MANT_MASK = 0x3ff;
+const uint32_t FP16_MANT_BITS = 10;
+const uint32_t FP32_MANT_SHIFT = 13;
+const uint32_t FP32_EXP_SHIFT = 23;
+const uint32_t FP16_TO_FP32_EXP_BIAS = 112;
+const uint32_t FP32_INF_EXP = 0x7f800000u;
+const uint32_t SIGN_SHIFT = 16;
+const uint32_t FP16_SIGN_MASK = 0x8000u;
+const float FP16_SUBNORMAL_SCALE = 1.0f / 16777216.0f;    // 2^-24
+const float FP16_SUBNORMAL_UNITS = 16777216.0f;           // 2^24
+const uint32_t FP32_ABS_MASK = 0x7fffffffu;
+const uint32_t FP32_FP16_OVERFLOW = 0x477ff000u;          // 65520, rounds to infinity
+const uint32_t FP32_FP16_MIN_NORMAL = 0x38800000u;        // 2^-14
+const uint32_t FP32_TO_FP16_EXP_BIAS = 0x38000000u;
+const uint32_t FP32_ROUND_HALF = 0xfffu;
+const uint16_t FP16_INF = 0x7c00u;
+const uint16_t FP16_QUIET_NAN = 0x7e00u;
+
+inline float HalfToFloat(uint16_t half)
+{
+    uint32_t sign = static_cast<uint32_t>(half & FP16_SIGN_MASK) << SIGN_SHIFT;
+    uint32_t exponent = (static_cast<uint32_t>(half) >> FP16_MANT_BITS) & FP16_EXP_MASK;
+    uint32_t mantissa = half & FP16_MANT_MASK;
+    uint32_t bits;
+    if (exponent == FP16_EXP_MASK) {
+        bits = sign | FP32_INF_EXP | (mantissa << FP32_MANT_SHIFT);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + FP16_TO_FP32_EXP_BIAS) << FP32_EXP_SHIFT) | (mantissa << FP32_MANT_SHIFT);
+    } else {
+        float value = static_cast<float>(mantissa) * FP16_SUBNORMAL_SCALE;
+        return sign ? -value : value;
+    }
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> SIGN_SHIFT) & FP16_SIGN_MASK);
+    uint32_t absBits = bits & FP32_ABS_MASK;
+    if (absBits > FP32_INF_EXP) {
+        return sign | FP16_QUIET_NAN;
+    }
+    if (absBits >= FP32_FP16_OVERFLOW) {
+        return sign | FP16_INF;
+    }
+    if (absBits < FP32_FP16_MIN_NORMAL) {
+        // scaling by a power of two is exact, the rounding is the one of the float16 subnormal
+        float absValue;
+        std::memcpy(&absValue, &absBits, sizeof(absValue));
+        return sign | static_cast<uint16_t>(std::lrint(absValue * FP16_SUBNORMAL_UNITS));
+    }
+    uint32_t rounded = absBits + FP32_ROUND_HALF + ((absBits >> FP32_MANT_SHIFT) & 1u);
+    return sign | static_cast<uint16_t>((rounded - FP32_TO_FP16_EXP_BIAS) >> FP32_MANT_SHIFT);
+}
+}
+
 namespace MxBase {
 
 void DataTypeUtils::Float32ToFloat16(uint16_t *__restrict out, float &in)
@@ -49,4 +116,32 @@ void DataTypeUtils::Float32ToFloat16(uint16_t *__restrict out, float &in)
 
     *((uint16_t *) out) = value;
 }
+
+void DataTypeUtils::Float16ToFloat32(float *__restrict out, const uint16_t *__restrict in, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__)
+    const size_t lanes = 4;
+    for (; i + lanes <= num; i += lanes) {
+        vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+    }
+#endif
+    for (; i < num; i++) {
+        out[i] = HalfToFloat(in[i]);
+    }
+}
+
+void DataTypeUtils::Float32ToFloat16(uint16_t *__restrict out, const float *__restrict in, size_t num)
+{
+    size_t i = 0;
+#if defined(__aarch64__)
+    const size_t lanes = 4;
+    for (; i + lanes <= num; i += lanes) {
+        vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    }
+#endif
+    for (; i < num; i++) {
+        out[i] = FloatToHalf(in[i]);
+    }
+}
 }
@@ -0,0 +1,597 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Asynchronous writer of the log files, fed by lock-free staging buffers of the logging threads.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "AsyncLogWriter.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include "MxBase/Log/Log.h"
+
+namespace MxBase {
+namespace {
+struct RecordHeader {
+    uint32_t len;
+    int32_t level;
+    int64_t timeUs;
+};
+
+const int32_t PADDING_LEVEL = -100;
+const size_t RECORD_ALIGN = sizeof(uint64_t);
+const size_t MIN_BUFFER_SIZE = 4096;
+const size_t MAX_IOV_NUM = 1024;
+const int SEVERITY_NUM = 3;      // info, warning and error files, fatal is written by glog before aborting
+const int LEVEL_NUM = 4;         // debug, info, warning and error
+const int DEFAULT_WAIT_MS = 100;
+const int FLUSH_TIMEOUT_MS = 1000;
+const int64_t US_PER_SECOND = 1000000;
+const int64_t SECONDS_PER_DAY = 86400;
+const size_t MB = 1024 * 1024;
+const mode_t LOG_FILE_MODE = 0600;
+const mode_t LOG_ARCHIVE_MODE = 0400;
+const char* const SEVERITY_FILE_NAMES[SEVERITY_NUM] = {"info.", "warn.", "error."};
+const char* const SEVERITY_LINK_NAMES[SEVERITY_NUM] = {"INFO", "WARNING", "ERROR"};
+const char SEVERITY_TAGS[] = "IIWEF";
+const char* const LEVEL_NAMES[LEVEL_NUM] = {"debug", "info", "warn", "error"};
+
+size_t AlignRecord(size_t len)
+{
+    return (sizeof(RecordHeader) + len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+}
+
+size_t RoundUpPowerOfTwo(size_t value)
+{
+    size_t result = MIN_BUFFER_SIZE;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+// debug lines are written as info, as glog does with VLOG
+int SeverityOf(int level)
+{
+    return std::max(level, static_cast<int>(LOG_LEVEL_INFO));
+}
+
+int LevelIndex(int level)
+{
+    return std::min(std::max(level - LOG_LEVEL_DEBUG, 0), LEVEL_NUM - 1);
+}
+
+int64_t LocalDay(time_t seconds)
+{
+    struct tm local = {};
+    localtime_r(&seconds, &local);
+    return (static_cast<int64_t>(seconds) + local.tm_gmtoff) / SECONDS_PER_DAY;
+}
+
+bool WriteAll(int fd, std::vector<iovec>& iov)
+{
+    size_t index = 0;
+    while (index < iov.size()) {
+        int count = static_cast<int>(std::min(iov.size() - index, MAX_IOV_NUM));
+        ssize_t written = writev(fd, &iov[index], count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        size_t left = static_cast<size_t>(written);
+        while (index < iov.size() && left >= iov[index].iov_len) {
+            left -= iov[index].iov_len;
+            ++index;
+        }
+        if (left > 0) {
+            iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + left;
+            iov[index].iov_len -= left;
+        }
+    }
+    return true;
+}
+
+struct LocalBufferHolder {
+    std::shared_ptr<ThreadLogBuffer> buffer;
+    ~LocalBufferHolder()
+    {
+        if (buffer != nullptr) {
+            buffer->closed.store(true, std::memory_order_release);
+        }
+    }
+};
+}
+
+int64_t GetLogTimeUs()
+{
+    struct timespec now = {};
+    clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<int64_t>(now.tv_sec) * US_PER_SECOND + now.tv_nsec / 1000;
+}
+
+size_t FormatLogPrefix(char* buffer, size_t size, int level, int64_t timeUs, const char* file, int line)
+{
+    // localtime_r takes a process wide lock, so the formatted second is cached per thread
+    thread_local time_t cachedSecond = -1;
+    thread_local char cachedStamp[32] = {0};
+    thread_local long threadId = syscall(SYS_gettid);
+    time_t second = static_cast<time_t>(timeUs / US_PER_SECOND);
+    if (second != cachedSecond) {
+        struct tm local = {};
+        localtime_r(&second, &local);
+        strftime(cachedStamp, sizeof(cachedStamp), "%Y%m%d %H:%M:%S", &local);
+        cachedSecond = second;
+    }
+    const char* slash = (file == nullptr) ? nullptr : strrchr(file, '/');
+    const char* baseName = (slash == nullptr) ? ((file == nullptr) ? "" : file) : slash + 1;
+    int tagIndex = std::min(std::max(level - LOG_LEVEL_DEBUG, 0), static_cast<int>(sizeof(SEVERITY_TAGS)) - 2);
+    int len = snprintf(buffer, size, "%c%s.%06ld %5ld %s:%d] ", SEVERITY_TAGS[tagIndex], cachedStamp,
+        static_cast<long>(timeUs % US_PER_SECOND), threadId, baseName, line);
+    if (len < 0) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(len), size - 1);
+}
+
+ThreadLogBuffer::ThreadLogBuffer(size_t capacity)
+    : capacity_(RoundUpPowerOfTwo(capacity)), data_(new uint64_t[RoundUpPowerOfTwo(capacity) / RECORD_ALIGN])
+{}
+
+size_t ThreadLogBuffer::MaxRecordLength() const
+{
+    return capacity_ / 2 - sizeof(RecordHeader);
+}
+
+bool ThreadLogBuffer::Push(int level, int64_t timeUs, const char* data, size_t len)
+{
+    size_t total = AlignRecord(len);
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+    size_t padding = (capacity_ - offset < total) ? capacity_ - offset : 0;
+    if (len > MaxRecordLength() || capacity_ - static_cast<size_t>(head - tail) < padding + total) {
+        return false;
+    }
+    char* base = reinterpret_cast<char*>(data_.get());
+    if (padding > 0) {
+        RecordHeader pad = {static_cast<uint32_t>(padding - sizeof(RecordHeader)), PADDING_LEVEL, 0};
+        std::copy_n(reinterpret_cast<const char*>(&pad), sizeof(pad), base + offset);
+        offset = 0;
+    }
+    RecordHeader header = {static_cast<uint32_t>(len), level, timeUs};
+    std::copy_n(reinterpret_cast<const char*>(&header), sizeof(header), base + offset);
+    std::copy_n(data, len, base + offset + sizeof(header));
+    head_.store(head + padding + total, std::memory_order_release);
+    return true;
+}
+
+uint64_t ThreadLogBuffer::Peek(std::vector<LogRecordView>& records) const
+{
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    const char* base = reinterpret_cast<const char*>(data_.get());
+    while (tail != head) {
+        const char* record = base + (tail & (capacity_ - 1));
+        RecordHeader header = {};
+        std::copy_n(record, sizeof(header), reinterpret_cast<char*>(&header));
+        if (header.level != PADDING_LEVEL) {
+            records.push_back({header.timeUs, header.level, record + sizeof(header), header.len});
+        }
+        tail += AlignRecord(header.len);
+    }
+    return tail;
+}
+
+void ThreadLogBuffer::Release(uint64_t position)
+{
+    tail_.store(position, std::memory_order_release);
+}
+
+size_t ThreadLogBuffer::Used() const
+{
+    return static_cast<size_t>(head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire));
+}
+
+size_t ThreadLogBuffer::Capacity() const
+{
+    return capacity_;
+}
+
+AsyncLogFile::AsyncLogFile(int severity, const AsyncLogOptions& options)
+    : severity_(severity), logDir_(options.logDir), baseName_(options.baseName), linkName_(options.linkName),
+      rotateDay_(options.rotateDay), rotateFileNumber_(options.rotateFileNumber)
+{}
+
+AsyncLogFile::~AsyncLogFile()
+{
+    Close();
+}
+
+void AsyncLogFile::Close()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+std::string AsyncLogFile::GetFileName() const
+{
+    return name_;
+}
+
+std::vector<std::string> AsyncLogFile::GetArchivedFileNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& file : archived_) {
+        names.push_back(file.name);
+    }
+    return names;
+}
+
+bool AsyncLogFile::Roll(int64_t timeUs)
+{
+    time_t second = static_cast<time_t>(timeUs / US_PER_SECOND);
+    struct tm local = {};
+    localtime_r(&second, &local);
+    char stamp[32] = {0};
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+    std::string name = baseName_ + SEVERITY_FILE_NAMES[severity_] + stamp + "." + std::to_string(getpid());
+    if (name == name_) {
+        // rolled twice in a second, keep the current file as the name would be the same
+        return fd_ >= 0;
+    }
+    std::string path = logDir_ + "/" + name;
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, LOG_FILE_MODE);
+    if (fd < 0) {
+        std::cout << "Failed to create log file, keep writing the current one." << std::endl;
+        return fd_ >= 0;
+    }
+    if (fd_ >= 0) {
+        Close();
+        chmod((logDir_ + "/" + name_).c_str(), LOG_ARCHIVE_MODE);
+        archived_.push_back({name_, day_});
+    }
+    fd_ = fd;
+    name_ = name;
+    day_ = LocalDay(second);
+    char header[256] = {0};
+    strftime(stamp, sizeof(stamp), "%Y/%m/%d %H:%M:%S", &local);
+    int len = snprintf(header, sizeof(header), "Log file created at: %s\n"
+        "Log line format: [IWEF]yyyymmdd hh:mm:ss.uuuuuu threadid file:line] msg\n", stamp);
+    size_ = 0;
+    if (len > 0 && write(fd_, header, static_cast<size_t>(len)) == len) {
+        size_ = static_cast<size_t>(len);
+    }
+    std::string linkPath = logDir_ + "/" + linkName_ + "." + SEVERITY_LINK_NAMES[severity_];
+    unlink(linkPath.c_str());
+    if (symlink(name_.c_str(), linkPath.c_str()) != 0) {
+        std::cout << "Failed to link the current log file." << std::endl;
+    }
+    Retain(rotateDay_, rotateFileNumber_);
+    return true;
+}
+
+void AsyncLogFile::Retain(int rotateDay, int rotateFileNumber)
+{
+    rotateDay_ = rotateDay;
+    rotateFileNumber_ = rotateFileNumber;
+    // the current file counts in the file number, as it does in Log::LogRotateByNumbers
+    while (rotateFileNumber_ > 0 && !archived_.empty() &&
+        archived_.size() + 1 > static_cast<size_t>(rotateFileNumber_)) {
+        remove((logDir_ + "/" + archived_.front().name).c_str());
+        archived_.pop_front();
+    }
+    while (rotateDay_ > 0 && !archived_.empty() && day_ - archived_.front().day >= rotateDay_) {
+        remove((logDir_ + "/" + archived_.front().name).c_str());
+        archived_.pop_front();
+    }
+}
+
+bool AsyncLogFile::FlushPending()
+{
+    if (iov_.empty()) {
+        return true;
+    }
+    bool ret = WriteAll(fd_, iov_);
+    iov_.clear();
+    return ret || errno != ENOSPC;
+}
+
+bool AsyncLogFile::Write(const std::vector<LogRecordView>& records, size_t maxSize)
+{
+    for (const auto& record : records) {
+        if (SeverityOf(record.level) < severity_) {
+            continue;
+        }
+        int64_t day = LocalDay(static_cast<time_t>(record.timeUs / US_PER_SECOND));
+        bool full = size_ > 0 && size_ + record.len > maxSize;
+        if (fd_ < 0 || full || day != day_) {
+            if (!FlushPending()) {
+                return false;
+            }
+            if (!Roll(record.timeUs)) {
+                return true;
+            }
+        }
+        iov_.push_back({const_cast<char*>(record.data), record.len});
+        size_ += record.len;
+        if (iov_.size() == MAX_IOV_NUM && !FlushPending()) {
+            return false;
+        }
+    }
+    return FlushPending();
+}
+
+AsyncLogWriter& AsyncLogWriter::GetInstance()
+{
+    static AsyncLogWriter instance;
+    return instance;
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    Stop();
+}
+
+APP_ERROR AsyncLogWriter::Start(const AsyncLogOptions& options)
+{
+    std::lock_guard<std::mutex> lk(startMutex_);
+    if (running_.load()) {
+        return APP_ERR_OK;
+    }
+    options_ = options;
+    rotateDay_ = options.rotateDay;
+    rotateFileNumber_ = options.rotateFileNumber;
+    files_.clear();
+    for (int severity = 0; severity < SEVERITY_NUM; ++severity) {
+        files_.emplace_back(new AsyncLogFile(severity, options_));
+    }
+    diskFull_ = false;
+    stopping_ = false;
+    running_.store(true);
+    try {
+        thread_ = std::thread(&AsyncLogWriter::Run, this);
+    } catch (const std::exception& ex) {
+        running_.store(false);
+        std::cout << "Failed to start the log writer thread, " << ex.what() << std::endl;
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return APP_ERR_OK;
+}
+
+void AsyncLogWriter::Stop()
+{
+    std::lock_guard<std::mutex> lk(startMutex_);
+    if (!running_.load()) {
+        return;
+    }
+    running_.store(false);
+    {
+        std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+        stopping_ = true;
+    }
+    wakeCond_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    // the lines staged after the last turn of the writer
+    uint64_t flushTarget = flushRequested_.load();
+    Drain();
+    files_.clear();
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    flushDone_ = flushTarget;
+    flushCond_.notify_all();
+}
+
+bool AsyncLogWriter::IsRunning() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+ThreadLogBuffer* AsyncLogWriter::GetLocalBuffer()
+{
+    thread_local LocalBufferHolder holder;
+    if (holder.buffer == nullptr) {
+        std::shared_ptr<ThreadLogBuffer> buffer;
+        try {
+            buffer = std::make_shared<ThreadLogBuffer>(options_.bufferSize);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lk(bufferMutex_);
+        buffers_.push_back(buffer);
+        holder.buffer = buffer;
+    }
+    return holder.buffer.get();
+}
+
+void AsyncLogWriter::Wake()
+{
+    if (!wakePending_.exchange(true)) {
+        std::lock_guard<std::mutex> lk(wakeMutex_);
+        wakeCond_.notify_one();
+    }
+}
+
+bool AsyncLogWriter::Push(int level, int64_t timeUs, const char* data, size_t len)
+{
+    if (!running_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    ThreadLogBuffer* buffer = GetLocalBuffer();
+    if (buffer == nullptr) {
+        return false;
+    }
+    len = std::min(len, buffer->MaxRecordLength());
+    while (!buffer->Push(level, timeUs, data, len)) {
+        if (!running_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        Wake();
+        if (options_.overflowPolicy == LOG_OVERFLOW_DROP) {
+            dropped_[LevelIndex(level)].fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    if (level >= LOG_LEVEL_ERROR || options_.flushIntervalMs == 0 || buffer->Used() > buffer->Capacity() / 2) {
+        Wake();
+    }
+    return true;
+}
+
+void AsyncLogWriter::Flush()
+{
+    if (!IsRunning()) {
+        return;
+    }
+    uint64_t target = flushRequested_.fetch_add(1) + 1;
+    Wake();
+    std::unique_lock<std::mutex> lk(flushMutex_);
+    flushCond_.wait_for(lk, std::chrono::milliseconds(FLUSH_TIMEOUT_MS), [this, target] {
+        return flushDone_ >= target;
+    });
+}
+
+void AsyncLogWriter::SetRetention(int rotateDay, int rotateFileNumber)
+{
+    if (rotateDay > 0) {
+        rotateDay_.store(rotateDay);
+    }
+    if (rotateFileNumber > 0) {
+        rotateFileNumber_.store(rotateFileNumber);
+    }
+    retentionPending_.store(true);
+    Wake();
+}
+
+uint64_t AsyncLogWriter::GetDroppedNumber() const
+{
+    uint64_t total = 0;
+    for (const auto& dropped : dropped_) {
+        total += dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void AsyncLogWriter::Run()
+{
+    int waitMs = options_.flushIntervalMs > 0 ? options_.flushIntervalMs : DEFAULT_WAIT_MS;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lk(wakeMutex_);
+            wakeCond_.wait_for(lk, std::chrono::milliseconds(waitMs), [this] {
+                return wakePending_.load() || stopping_;
+            });
+            wakePending_.store(false);
+            if (stopping_) {
+                break;
+            }
+        }
+        uint64_t flushTarget = flushRequested_.load();
+        Drain();
+        std::lock_guard<std::mutex> flushLock(flushMutex_);
+        flushDone_ = flushTarget;
+        flushCond_.notify_all();
+    }
+}
+
+void AsyncLogWriter::AddDroppedReport()
+{
+    uint64_t counts[LEVEL_NUM] = {0};
+    uint64_t total = 0;
+    for (int i = 0; i < LEVEL_NUM; ++i) {
+        uint64_t dropped = dropped_[i].load(std::memory_order_relaxed);
+        counts[i] = dropped - droppedReported_[i];
+        droppedReported_[i] = dropped;
+        total += counts[i];
+    }
+    if (total == 0) {
+        return;
+    }
+    int64_t timeUs = GetLogTimeUs();
+    char prefix[128] = {0};
+    size_t prefixLen = FormatLogPrefix(prefix, sizeof(prefix), LOG_LEVEL_WARN, timeUs, __FILE__, __LINE__);
+    droppedReport_.assign(prefix, prefixLen);
+    droppedReport_ += "Dropped " + std::to_string(total) + " log messages since the last report (";
+    for (int i = 0; i < LEVEL_NUM; ++i) {
+        droppedReport_ += std::string(i == 0 ? "" : ", ") + LEVEL_NAMES[i] + " " + std::to_string(counts[i]);
+    }
+    droppedReport_ += "), the staging buffers of the logging threads were full.\n";
+    records_.push_back({timeUs, LOG_LEVEL_WARN, droppedReport_.data(), droppedReport_.size()});
+}
+
+void AsyncLogWriter::Drain()
+{
+    std::vector<std::shared_ptr<ThreadLogBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lk(bufferMutex_);
+        buffers = buffers_;
+    }
+    records_.clear();
+    positions_.clear();
+    for (auto& buffer : buffers) {
+        positions_.push_back(buffer->Peek(records_));
+    }
+    AddDroppedReport();
+    if (!records_.empty()) {
+        // every buffer is in order already, the merge keeps the lines of the threads interleaved by time
+        std::stable_sort(records_.begin(), records_.end(), [](const LogRecordView& lhs, const LogRecordView& rhs) {
+            return lhs.timeUs < rhs.timeUs;
+        });
+        size_t maxSize = static_cast<size_t>(std::max(FLAGS_max_log_size, 1U)) * MB;
+        for (auto& file : files_) {
+            if (!diskFull_ && !file->Write(records_, maxSize) && FLAGS_stop_logging_if_full_disk) {
+                std::cout << "The disk is full, stop writing the log files." << std::endl;
+                diskFull_ = true;
+            }
+        }
+        consoleIov_.clear();
+        for (const auto& record : records_) {
+            if (SeverityOf(record.level) >= FLAGS_stderrthreshold) {
+                consoleIov_.push_back({const_cast<char*>(record.data), record.len});
+            }
+        }
+        WriteAll(STDERR_FILENO, consoleIov_);
+    }
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        buffers[i]->Release(positions_[i]);
+    }
+    if (retentionPending_.exchange(false)) {
+        for (auto& file : files_) {
+            file->Retain(rotateDay_.load(), rotateFileNumber_.load());
+        }
+    }
+    std::lock_guard<std::mutex> lk(bufferMutex_);
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(), [](const std::shared_ptr<ThreadLogBuffer>& b) {
+        return b->closed.load(std::memory_order_acquire) && b->Used() == 0;
+    }), buffers_.end());
+}
+}  // namespace MxBase
@@ -0,0 +1,240 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Asynchronous writer of the log files, fed by lock-free staging buffers of the logging threads.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_ASYNCLOGWRITER_H
+#define MXBASE_ASYNCLOGWRITER_H
+
+#include <sys/uio.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+
+namespace MxBase {
+enum LogOverflowPolicy {
+    LOG_OVERFLOW_DROP = 0,   // drop the message and count it when the staging buffer of the thread is full
+    LOG_OVERFLOW_BLOCK,      // wait until the writer makes room in the staging buffer
+};
+
+struct AsyncLogOptions {
+    std::string logDir;
+    std::string baseName;       // file name before the severity, such as mxsdk.log.<process name>.
+    std::string linkName;       // symlink name before the severity, the program name as glog uses it
+    size_t bufferSize = 0;      // staging buffer bytes of each logging thread
+    LogOverflowPolicy overflowPolicy = LOG_OVERFLOW_DROP;
+    int flushIntervalMs = 0;    // 0 wakes the writer for every message
+    int rotateDay = 0;
+    int rotateFileNumber = 0;
+};
+
+struct LogRecordView {
+    int64_t timeUs;
+    int level;
+    const char* data;
+    size_t len;
+};
+
+/**
+ * Format the glog style prefix "Lyyyymmdd hh:mm:ss.uuuuuu threadid file:line] " of a log line.
+ * @return length of the prefix, not more than size - 1
+ */
+size_t FormatLogPrefix(char* buffer, size_t size, int level, int64_t timeUs, const char* file, int line);
+
+int64_t GetLogTimeUs();
+
+/**
+ * Single producer single consumer ring of log records, each logging thread owns one. A record never wraps, the space
+ * left at the end of the ring is skipped with a padding record.
+ */
+class ThreadLogBuffer {
+public:
+    explicit ThreadLogBuffer(size_t capacity);
+
+    ThreadLogBuffer(const ThreadLogBuffer&) = delete;
+
+    ThreadLogBuffer& operator=(const ThreadLogBuffer&) = delete;
+
+    ~ThreadLogBuffer() = default;
+
+    // producer side
+    bool Push(int level, int64_t timeUs, const char* data, size_t len);
+
+    size_t MaxRecordLength() const;
+
+    // consumer side, the views stay valid until the returned position is released
+    uint64_t Peek(std::vector<LogRecordView>& records) const;
+
+    void Release(uint64_t position);
+
+    size_t Used() const;
+
+    size_t Capacity() const;
+
+    std::atomic<bool> closed{false};
+
+private:
+    size_t capacity_;
+    std::unique_ptr<uint64_t[]> data_;
+    char headPad_[64] = {0};
+    std::atomic<uint64_t> head_{0};
+    char tailPad_[64] = {0};
+    std::atomic<uint64_t> tail_{0};
+};
+
+/**
+ * One log file of a severity, holding the records of that severity and above. The file is rolled when it grows over
+ * the max size or the day changes, the files rolled before are remembered so the retention never lists the directory.
+ */
+class AsyncLogFile {
+public:
+    AsyncLogFile(int severity, const AsyncLogOptions& options);
+
+    AsyncLogFile(const AsyncLogFile&) = delete;
+
+    AsyncLogFile& operator=(const AsyncLogFile&) = delete;
+
+    ~AsyncLogFile();
+
+    // returns false when the disk is full and logging should stop
+    bool Write(const std::vector<LogRecordView>& records, size_t maxSize);
+
+    void Retain(int rotateDay, int rotateFileNumber);
+
+    void Close();
+
+    std::string GetFileName() const;
+
+    std::vector<std::string> GetArchivedFileNames() const;
+
+private:
+    struct ArchivedFile {
+        std::string name;
+        int64_t day;
+    };
+
+    bool Roll(int64_t timeUs);
+
+    bool FlushPending();
+
+    int severity_;
+    std::string logDir_;
+    std::string baseName_;
+    std::string linkName_;
+    int rotateDay_;
+    int rotateFileNumber_;
+    int fd_ = -1;
+    std::string name_;
+    size_t size_ = 0;
+    int64_t day_ = 0;
+    std::deque<ArchivedFile> archived_;
+    std::vector<iovec> iov_;
+};
+
+class AsyncLogWriter {
+public:
+    static AsyncLogWriter& GetInstance();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    ~AsyncLogWriter();
+
+    APP_ERROR Start(const AsyncLogOptions& options);
+
+    void Stop();
+
+    bool IsRunning() const;
+
+    /**
+     * Stage a formatted line ending with '\n' in the buffer of the calling thread.
+     * @return false when the writer is not running, the caller writes the line synchronously then
+     */
+    bool Push(int level, int64_t timeUs, const char* data, size_t len);
+
+    /**
+     * Wait until the lines staged before the call are written.
+     */
+    void Flush();
+
+    /**
+     * Apply the retention on the writer thread with the files this process rolled, the directory is never listed.
+     */
+    void SetRetention(int rotateDay, int rotateFileNumber);
+
+    uint64_t GetDroppedNumber() const;
+
+private:
+    AsyncLogWriter() = default;
+
+    ThreadLogBuffer* GetLocalBuffer();
+
+    void Wake();
+
+    void Run();
+
+    void Drain();
+
+    void AddDroppedReport();
+
+    std::atomic<bool> running_{false};
+    std::mutex startMutex_;
+    AsyncLogOptions options_;
+    std::thread thread_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCond_;
+    std::atomic<bool> wakePending_{false};
+    bool stopping_ = false;
+
+    std::mutex flushMutex_;
+    std::condition_variable flushCond_;
+    std::atomic<uint64_t> flushRequested_{0};
+    uint64_t flushDone_ = 0;
+
+    std::mutex bufferMutex_;
+    std::vector<std::shared_ptr<ThreadLogBuffer>> buffers_;
+
+    std::atomic<int> rotateDay_{0};
+    std::atomic<int> rotateFileNumber_{0};
+    std::atomic<bool> retentionPending_{false};
+
+    std::atomic<uint64_t> dropped_[4] = {};
+    uint64_t droppedReported_[4] = {};
+    std::string droppedReport_;
+
+    // only touched by the writer
+    std::vector<std::unique_ptr<AsyncLogFile>> files_;
+    std::vector<LogRecordView> records_;
+    std::vector<uint64_t> positions_;
+    std::vector<iovec> consoleIov_;
+    bool diskFull_ = false;
+};
+}  // namespace MxBase
+
+#endif  // MXBASE_ASYNCLOGWRITER_H
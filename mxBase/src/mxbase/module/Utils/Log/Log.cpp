@@ -29,6 +29,7 @@
 #include <dirent.h>
 #include <vector>
 #include <regex>
+#include <chrono>
 #include "dvpp/securec.h"
 #include "MxBase/GlobalManager/GlobalManager.h"
 #include "MxBase/MemoryHelper/MemoryHelper.h"
@@ -36,6 +37,7 @@
 #include "MxBase/Utils/StringUtils.h"
 #include "MxBase/Utils/FileUtils.h"
 #include "MxBase/Log/Log.h"
+#include "AsyncLogWriter.h"
 
 using namespace MxBase;
 
@@ -75,6 +77,12 @@ const int MAX_LOG_LEVEL = 3;
 const mode_t LOG_FILE_MODE = 0600;
 const mode_t LOG_ARCHIVE_MODE = 0400;
 const int MAX_PROCESS_NAME = 1024;
+const int MIN_ASYNC_BUFFER_SIZE = 16;
+const int MAX_ASYNC_BUFFER_SIZE = 4096;
+const size_t KB = 1024;
+const int MAX_RATE_LIMIT = 10000;
+const int MS_PER_SECOND = 1000;
+const size_t MAX_LOG_LINE_LEN = 30000;
 
 static bool g_initStatus = false;
 static std::mutex g_mtx;
@@ -98,6 +106,12 @@ static int g_rotateFileNumber = 50;                // rotate file number of log
 static bool g_stopLoggingIfFullDisk = true;    // whether stop logging once disk is full
 static int g_flowControlFrequency = 1;                    // flow_frequency >= 1 and must be an integer
 static bool g_logFileNumWarn = false;
+static int g_asyncMode = 0;                        // 1: stage the logs per thread and write them in a background thread
+static int g_asyncBufferSize = 256;                // staging buffer size of each logging thread, unit is KB
+static int g_asyncOverflowPolicy = 0;              // 0: drop the log when the staging buffer is full, 1: wait
+static int g_rateLimitPerSite = 0;                 // max logs per second of each call site, 0 means no limit
+thread_local char g_lineStorage[MAX_LOG_LINE_LEN];
+thread_local bool g_lineStorageUsed = false;
 
 bool ExistDirectory(const std::string& path)
 {
@@ -161,6 +175,7 @@ Log::~Log()
  */
 void Log::Flush()
 {
+    AsyncLogWriter::GetInstance().Flush();
     Log& instance = getLogger(MxBase::DEFAULT_LOGGER);
     if (instance.msg_ != nullptr) {
         instance.msg_ = nullptr;
@@ -185,31 +200,46 @@ inline std::string MessageMeta(const std::string& instanceName, const std::strin
 void Log::Debug(const std::string& file, const std::string& function, const int& line, std::string& msg)
 {
     MxBase::StringUtils::ReplaceInvalidChar(msg);
-    VLOG(MxBase::LOG_LEVEL_DEBUG) << MessageMeta(instanceName_, file, function, line) << msg << std::endl;
+    if (IsLevelEnabled(LOG_LEVEL_DEBUG)) {
+        LogLine(LOG_LEVEL_DEBUG, file.c_str(), line).stream() << MessageMeta(instanceName_, file, function, line)
+            << msg;
+    }
 }
 
 void Log::Info(const std::string& file, const std::string& function, const int& line, std::string& msg)
 {
     MxBase::StringUtils::ReplaceInvalidChar(msg);
-    LOG(INFO) << MessageMeta(instanceName_, file, function, line) << msg << std::endl;
+    if (IsLevelEnabled(LOG_LEVEL_INFO)) {
+        LogLine(LOG_LEVEL_INFO, file.c_str(), line).stream() << MessageMeta(instanceName_, file, function, line)
+            << msg;
+    }
 }
 
 void Log::Warn(const std::string& file, const std::string& function, const int& line, std::string& msg)
 {
     MxBase::StringUtils::ReplaceInvalidChar(msg);
-    LOG(WARNING) << MessageMeta(instanceName_, file, function, line) << msg << std::endl;
+    if (IsLevelEnabled(LOG_LEVEL_WARN)) {
+        LogLine(LOG_LEVEL_WARN, file.c_str(), line).stream() << MessageMeta(instanceName_, file, function, line)
+            << msg;
+    }
 }
 
 void Log::Error(const std::string& file, const std::string& function, const int& line, std::string& msg)
 {
     MxBase::StringUtils::ReplaceInvalidChar(msg);
-    LOG(ERROR) << MessageMeta(instanceName_, file, function, line) << msg << std::endl;
+    if (IsLevelEnabled(LOG_LEVEL_ERROR)) {
+        LogLine(LOG_LEVEL_ERROR, file.c_str(), line).stream() << MessageMeta(instanceName_, file, function, line)
+            << msg;
+    }
 }
 
 void Log::Fatal(const std::string& file, const std::string& function, const int& line, std::string& msg)
 {
     MxBase::StringUtils::ReplaceInvalidChar(msg);
-    LOG(FATAL) << MessageMeta(instanceName_, file, function, line) << msg << std::endl;
+    if (IsLevelEnabled(LOG_LEVEL_FATAL)) {
+        LogLine(LOG_LEVEL_FATAL, file.c_str(), line).stream() << MessageMeta(instanceName_, file, function, line)
+            << msg;
+    }
 }
 
 /**
@@ -243,6 +273,7 @@ APP_ERROR Log::Deinit()
     std::lock_guard<std::mutex> lk(g_deinitMtx);
     // release the glog resource
     if (g_initStatus) {
+        AsyncLogWriter::GetInstance().Stop();
         for (auto it = instances.begin(); it != instances.end();) {
             delete it->second;
             it->second = nullptr;
@@ -269,6 +300,11 @@ void Log::SetLogParameters(const ConfigData& configData)
     configData.GetFileValueWarn("console_level", g_consoleLevel, MIN_LOG_LEVEL, MAX_LOG_LEVEL);
     configData.GetFileValueWarn("flow_control_frequency", g_flowControlFrequency, 1, MAX_FLOW_FREQUENCY);
     MxBase::Log::logFlowControlFrequency_ = g_flowControlFrequency;
+    configData.GetFileValueWarn("async_mode", g_asyncMode, 0, 1);
+    configData.GetFileValueWarn("async_buffer_size", g_asyncBufferSize, MIN_ASYNC_BUFFER_SIZE, MAX_ASYNC_BUFFER_SIZE);
+    configData.GetFileValueWarn("async_overflow_policy", g_asyncOverflowPolicy, 0, 1);
+    configData.GetFileValueWarn("rate_limit_per_site", g_rateLimitPerSite, 0, MAX_RATE_LIMIT);
+    MxBase::Log::logRateLimit_ = g_rateLimitPerSite;
     g_rotateDay = std::max(g_rotateDay, 1);
     if (g_globalLevel == LOG_LEVEL_DEBUG) {
         FLAGS_v = LOG_LEVEL_DEBUG;
@@ -465,6 +501,9 @@ APP_ERROR Log::Init()
         return APP_ERR_COMM_INIT_FAIL;
     }
     LogRotateByNumbers(g_rotateFileNumber);
+    if (g_asyncMode != 0) {
+        StartAsyncWriter();
+    }
     if (!g_initStatus) {
         std::cout << "End to initialize Log." << std::endl;
     }
@@ -745,6 +784,10 @@ void Log::RemoveBeyondFileNameList(std::vector<std::string>& fileNameList,
 
 void Log::LogRotateByTime(int rotateDay)
 {
+    if (AsyncLogWriter::GetInstance().IsRunning()) {
+        AsyncLogWriter::GetInstance().SetRetention(rotateDay, 0);
+        return;
+    }
     std::vector<std::string> fileNameList = GetFileNameList(Log::logDir_);
     std::vector<std::string> usingFilenameVecByTimes = {};
     GetUsingFilenames(usingFilenameVecByTimes);
@@ -807,6 +850,10 @@ void Log::LogRotateByNumbers(int rotateFileNumber)
         std::cout << "RotateFileNumber cannot be less than zero." << std::endl;
         return;
     }
+    if (AsyncLogWriter::GetInstance().IsRunning()) {
+        AsyncLogWriter::GetInstance().SetRetention(0, rotateFileNumber);
+        return;
+    }
     std::vector<std::string> fileNameList = GetFileNameList(Log::logDir_);
     if (!g_logFileNumWarn && fileNameList.size() > MAX_LINK_FILE_NUM) {
         LogWarn << "Log file number is beyond " << MAX_LINK_FILE_NUM
@@ -834,6 +881,113 @@ void Log::LogRotateByNumbers(int rotateFileNumber)
     }
 }
 
+void Log::StartAsyncWriter()
+{
+    AsyncLogOptions options;
+    options.logDir = Log::logDir_;
+    options.baseName = g_baseFilename + Log::pName_ + ".";
+    options.linkName = g_programName;
+    options.bufferSize = static_cast<size_t>(g_asyncBufferSize) * KB;
+    options.overflowPolicy = static_cast<LogOverflowPolicy>(g_asyncOverflowPolicy);
+    options.flushIntervalMs = logbufsecs * MS_PER_SECOND;
+    options.rotateDay = g_rotateDay;
+    options.rotateFileNumber = g_rotateFileNumber;
+    if (AsyncLogWriter::GetInstance().Start(options) != APP_ERR_OK) {
+        std::cout << "Failed to start the asynchronous log writer, write the logs synchronously." << std::endl;
+    }
+}
+
+uint64_t Log::GetDroppedMessageNumber()
+{
+    return AsyncLogWriter::GetInstance().GetDroppedNumber();
+}
+
+bool LogSite::Pass()
+{
+    uint32_t frequency = static_cast<uint32_t>(std::max(Log::logFlowControlFrequency_, 1));
+    if (occurrences.fetch_add(1, std::memory_order_relaxed) % frequency != 0) {
+        return false;
+    }
+    int limit = Log::logRateLimit_;
+    if (limit <= 0) {
+        return true;
+    }
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t current = window.load(std::memory_order_relaxed);
+    if (current != now && window.compare_exchange_strong(current, now, std::memory_order_relaxed)) {
+        windowCount.store(0, std::memory_order_relaxed);
+    }
+    if (windowCount.fetch_add(1, std::memory_order_relaxed) < static_cast<uint32_t>(limit)) {
+        return true;
+    }
+    suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+LogLine::LogLine(LogLevels level, const char* file, int line, LogSite* site)
+    : level_(level), file_(file), line_(line), stream_(&buf_)
+{
+    if (site != nullptr && !site->Pass()) {
+        stream_.setstate(std::ios_base::badbit);
+        return;
+    }
+    // a line built while formatting another one, by an operator<< that logs, gets its own storage
+    if (!g_lineStorageUsed) {
+        g_lineStorageUsed = true;
+        localStorage_ = true;
+        data_ = g_lineStorage;
+    } else {
+        heapData_.reset(new (std::nothrow) char[MAX_LOG_LINE_LEN]);
+        data_ = heapData_.get();
+    }
+    if (data_ == nullptr) {
+        stream_.setstate(std::ios_base::badbit);
+        return;
+    }
+    async_ = level < LOG_LEVEL_FATAL && AsyncLogWriter::GetInstance().IsRunning();
+    if (async_) {
+        timeUs_ = GetLogTimeUs();
+        prefixLen_ = FormatLogPrefix(data_, MAX_LOG_LINE_LEN, level, timeUs_, file, line);
+    }
+    // one byte is kept for the line feed
+    buf_.Reset(data_ + prefixLen_, MAX_LOG_LINE_LEN - prefixLen_ - 1);
+    if (site != nullptr) {
+        suppressed_ = site->suppressed.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+LogLine::~LogLine()
+{
+    if (data_ == nullptr) {
+        return;
+    }
+    if (suppressed_ > 0) {
+        stream_ << " [" << suppressed_ << " logs of this call site were suppressed by the rate limit]";
+    }
+    size_t len = buf_.Size();
+    bool written = false;
+    if (async_) {
+        size_t total = prefixLen_ + len;
+        if (len == 0 || data_[total - 1] != '\n') {
+            data_[total++] = '\n';
+        }
+        written = AsyncLogWriter::GetInstance().Push(level_, timeUs_, data_, total);
+    }
+    if (!written) {
+        const char* body = data_ + prefixLen_;
+        if (level_ == LOG_LEVEL_FATAL) {
+            AsyncLogWriter::GetInstance().Flush();
+            google::LogMessageFatal(file_, line_).stream().write(body, static_cast<std::streamsize>(len));
+        }
+        google::LogMessage(file_, line_, static_cast<google::LogSeverity>(std::max(level_, LOG_LEVEL_INFO)))
+            .stream().write(body, static_cast<std::streamsize>(len));
+    }
+    if (localStorage_) {
+        g_lineStorageUsed = false;
+    }
+}
+
 // initialize the static variables here
 std::map<std::string, Log*> Log::instances;
 ConfigData Log::config_;
@@ -842,6 +996,7 @@ int Log::rotateDay_;
 int Log::rotateFileNumber_;
 std::string Log::logConfigPath_;
 int Log::logFlowControlFrequency_ = 1;
+int Log::logRateLimit_ = 0;
 bool Log::showLog_ = true;
 std::string Log::pId_;
 std::string Log::pName_;
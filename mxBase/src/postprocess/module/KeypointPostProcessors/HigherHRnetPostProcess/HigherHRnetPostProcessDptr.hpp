@@ -29,6 +29,7 @@
 #include "KeypointPostProcessors/HigherHRnetPostProcess.h"
 #include "MxBase/CV/MultipleObjectTracking/Huangarian.h"
 #include "MxBase/GlobalManager/GlobalManager.h"
+#include "MxBase/PostProcessBases/KeypointPeakFinder.h"
 
 namespace MxBase {
 const float EPSILON = 1e-6;
@@ -68,14 +69,10 @@ public:
     APP_ERROR KeyPointsDetect(const std::vector<TensorBase> &tensors,
         const std::vector<ResizedImageInfo> &resizedImageInfos,
         std::vector<std::vector<KeyPointDetectionInfo>>& keyPointInfos);
-    float GetPixelVal(cv::Mat& src, int row, int col, int chl);
     bool isValidPixel(cv::Mat& src, int row, int col);
     std::vector<cv::Mat> GetHeatMapAndTags(float* interPolateTensor1st, float* interPolateTensor2nd,
                                            int imageFeatHight2nd, int imageFeatWidth2nd);
-    float GetPoolMax(cv::Mat &img, int row, int col, int c, int size);
-    cv::Mat MaxPooling(cv::Mat& img);
     void SparseHeatMap(cv::Mat& heatMap);
-    void InsertTargetVal(std::vector<std::pair<float, int>> &tmpTopk, std::pair<float, int> targetVal);
     void Normalize(std::vector<std::vector<float>> &diff, std::vector<std::vector<float>> &joints);
     float GetMean(std::vector<float> &keys);
     APP_ERROR GetHuangarian(std::vector<std::vector<float>> diff, std::vector<int> &matchPairs,
@@ -207,12 +204,6 @@ APP_ERROR HigherHRnetPostProcessDptr::CheckAndMoveTensors(std::vector<TensorBase
     return qPtr_->CheckAndMoveTensors(tensors);
 }
 
-float HigherHRnetPostProcessDptr::GetPixelVal(cv::Mat& src, int row, int col, int chl)
-{
-    int pixelIdx = row * src.cols + col + chl * src.rows * src.cols;
-    return *((float*)src.data + pixelIdx);
-}
-
 bool HigherHRnetPostProcessDptr::isValidPixel(cv::Mat& src, int row, int col)
 {
     if (row >= src.rows || col >= src.cols || row < 0 || col < 0) {
@@ -226,35 +217,15 @@ APP_ERROR HigherHRnetPostProcessDptr::BiInterLinear(cv::Mat& src, cv::Mat& dst,
     int dstRows = static_cast<int>(round(sx * src.rows));
     int dstCols = static_cast<int>(round(sy * src.cols));
     dst = cv::Mat(dstRows, dstCols, src.type());
-    int chl = dst.channels();
-    int beginIdx = 0;
-    for (int i = 0; i < dst.rows; i++) {
-        double index_i = (i + 0.5) / sx - 0.5;
-        if (index_i < 0) index_i = 0;
-        if (index_i > src.rows - 1) index_i = src.rows - 1;
-        int i1 = static_cast<int>(floor(index_i));
-        int i2 = static_cast<int>(ceil(index_i));
-        double u = index_i - i1;
-        for (int j = 0; j < dst.cols; j++) {
-            double index_j = (j + 0.5) / sy - 0.5;
-            if (index_j < 0) index_j = 0;
-            if (index_j > src.cols - 1) index_j = src.cols - 1;
-            int j1 = static_cast<int>(floor(index_j));
-            int j2 = static_cast<int>(ceil(index_j));
-            double v = index_j - j1;
-            if (!isValidPixel(src, i1, j1) || !isValidPixel(src, i1, j2)
-                || !isValidPixel(src, i2, j1) || !isValidPixel(src, i2, j2)) {
-                    LogError << "Calc PixelVal failed. Please check models output."
-                             << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-                    return APP_ERR_COMM_INVALID_PARAM;
-            }
-            for (int z = 0; z < chl; z++) {
-                beginIdx = dst.cols * dst.rows * z + i * dst.cols + j;
-                *((float*)dst.data + beginIdx) = (1 - u) * (1 - v) * GetPixelVal(src, i1, j1, z)
-                                               + (1 - u) * v * GetPixelVal(src, i1, j2, z)
-                                               + u * (1 - v) * GetPixelVal(src, i2, j1, z)
-                                               + u * v * GetPixelVal(src, i2, j2, z);
-            }
+    // the channels are planes of rows x cols, as the model outputs are NCHW
+    size_t srcStride = static_cast<size_t>(src.rows) * static_cast<size_t>(src.cols);
+    size_t dstStride = static_cast<size_t>(dstRows) * static_cast<size_t>(dstCols);
+    for (int z = 0; z < dst.channels(); z++) {
+        APP_ERROR ret = KeypointPeakFinder::ResizeBilinear((float*)src.data + z * srcStride, src.cols, src.rows,
+            (float*)dst.data + z * dstStride, dstCols, dstRows);
+        if (ret != APP_ERR_OK) {
+            LogError << "Calc PixelVal failed. Please check models output." << GetErrorInfo(ret);
+            return ret;
         }
     }
     return APP_ERR_OK;
@@ -284,58 +255,12 @@ std::vector<cv::Mat> HigherHRnetPostProcessDptr::GetHeatMapAndTags(float* interP
     return heatAndTags;
 }
 
-float HigherHRnetPostProcessDptr::GetPoolMax(cv::Mat &img, int row, int col, int c, int size)
-{
-    float v = 0.;
-    int height = img.rows;
-    int width = img.cols;
-    float* imgData = (float *)img.data;
-    int begin = -((size - 1) / 2);
-    int end = ((size - 1) / 2) + 1;
-    for (int j = begin; j < end; j++) {
-        if ((row + j >= height) || (row + j < 0)) continue;
-        for (int i = begin; i < end; i++) {
-            if ((col + i >= width) || (col + i < 0)) continue;
-            v = fmax(*(imgData + img.rows * img.cols * c + (row + j) * width + col + i), v);
-        }
-    }
-    return v;
-}
-
-cv::Mat HigherHRnetPostProcessDptr::MaxPooling(cv::Mat& img)
-{
-    int height = img.rows;
-    int width = img.cols;
-    int channels = img.channels();
-    cv::Mat peakMat(height, width, CV_32FC(static_cast<size_t>(channels)));
-
-    int size = KERNEL_SIZE;
-    float *peakMatData = (float *)peakMat.data;
-
-    for (int64_t j = 0 ; j < height; j += 1) {
-        for (int64_t i = 0; i < width; i += 1) {
-            for (int64_t c = 0; c < channels; c++) {
-                float v = GetPoolMax(img, j, i, c, size);
-                *(peakMatData + width * height * c + j * width + i) = v;
-            }
-        }
-    }
-    return peakMat;
-}
-
 void HigherHRnetPostProcessDptr::SparseHeatMap(cv::Mat& heatMap)
 {
-    cv::Mat dstHeatMap = MaxPooling(heatMap);
-    uint64_t stride = static_cast<uint64_t>(heatMap.cols * heatMap.rows * heatMap.channels());
-    float* heatMapPtr = (float*) heatMap.data;
-    float* dstHeatMapPtr = (float*) dstHeatMap.data;
-    for (uint64_t i = 0; i < stride; i++) {
-        if (fabs(*(heatMapPtr + i) - *(dstHeatMapPtr + i)) < EPSILON) {
-            *(dstHeatMapPtr + i) = 1.0;
-        } else {
-            *(dstHeatMapPtr + i) = 0.0;
-        }
-        *(heatMapPtr + i) *= *(dstHeatMapPtr + i);
+    size_t stride = static_cast<size_t>(heatMap.cols) * static_cast<size_t>(heatMap.rows);
+    for (int c = 0; c < heatMap.channels(); c++) {
+        KeypointPeakFinder::SuppressNonMaximum((float*)heatMap.data + c * stride, heatMap.cols, heatMap.rows,
+            KERNEL_SIZE);
     }
 }
 
@@ -345,19 +270,6 @@ static bool PairComp(std::pair<float, int> a, std::pair<float, int> b)
     else return a.second < b.second;
 }
 
-void HigherHRnetPostProcessDptr::InsertTargetVal(std::vector<std::pair<float, int>> &tmpTopk,
-    std::pair<float, int> targetVal)
-{
-    int idx = 0;
-    for (; idx < (int)tmpTopk.size(); idx++) {
-        if (tmpTopk[idx].first < targetVal.first) {
-            break;
-        }
-    }
-    tmpTopk.insert(tmpTopk.begin() + idx, targetVal);
-    tmpTopk.pop_back();
-}
-
 float HigherHRnetPostProcessDptr::GetMean(std::vector<float> &keys)
 {
     float sum = 0.;
@@ -708,15 +620,17 @@ APP_ERROR HigherHRnetPostProcessDptr::GetTopkPose(std::vector<cv::Mat> &heatAndT
         return APP_ERR_COMM_INVALID_PARAM;
     }
     for (int i = 0; i < keyPointNum_; i++) {
+        // only the peaks are positive after the suppression, the zeros filling up the k are below the threshold
         std::vector<std::pair<float, int>> tmpTopk;
-        for (int k = 0; k < MAX_PEOPLE_NUM; k++) {
-            tmpTopk.push_back(std::pair<float, int> (*(sparseHeatPtr + i * stride + k), k));
-        }
-        std::sort(tmpTopk.begin(), tmpTopk.end(), PairComp);
-        for (int k = MAX_PEOPLE_NUM; k < stride; k++) {
-            std::pair<float, int> targetVal(*(sparseHeatPtr + i * stride + k), k);
-            InsertTargetVal(tmpTopk, targetVal);
+        float* planePtr = sparseHeatPtr + i * stride;
+        for (int k = 0; k < stride; k++) {
+            if (planePtr[k] > 0) {
+                tmpTopk.push_back(std::pair<float, int>(planePtr[k], k));
+            }
         }
+        size_t topNum = std::min(tmpTopk.size(), static_cast<size_t>(MAX_PEOPLE_NUM));
+        std::partial_sort(tmpTopk.begin(), tmpTopk.begin() + topNum, tmpTopk.end(), PairComp);
+        tmpTopk.resize(MAX_PEOPLE_NUM, std::pair<float, int>(0.f, 0));
         topkValHeatAndInd.push_back(tmpTopk);
     }
     std::vector<std::vector<float>> topkValTags;
@@ -877,7 +791,10 @@ APP_ERROR HigherHRnetPostProcessDptr::KeyPointsDetect(const std::vector<TensorBa
         cv::Mat dstImg;
         double scaleX = (double)(tensors[1].GetShape()[heightIndex_]) / (double)(tensors[0].GetShape()[heightIndex_]);
         double scaleY = (double)(tensors[1].GetShape()[widthIndex_]) / (double)(tensors[0].GetShape()[widthIndex_]);
-        BiInterLinear(srcImg, dstImg, scaleX, scaleY);
+        ret = BiInterLinear(srcImg, dstImg, scaleX, scaleY);
+        if (ret != APP_ERR_OK) {
+            return ret;
+        }
         float* interPolateTensor1st = (float*)dstImg.data;
         float* interPolateTensor2nd = (float*)(tensors[1].GetBuffer()) +
             i * (tensors[1].GetStrides())[0] / (qPtr_->FOUR_BYTE);
@@ -23,34 +23,28 @@
 #ifndef OPENPOSE_POST_PROCESS_DPTR_H
 #define OPENPOSE_POST_PROCESS_DPTR_H
 
-#include <opencv2/core/mat.hpp>
-#include <opencv2/imgproc.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
 #include "KeypointPostProcessors/OpenPosePostProcess.h"
 #include "MxBase/Log/Log.h"
 #include "MxBase/GlobalManager/GlobalManager.h"
+#include "MxBase/PostProcessBases/KeypointPeakFinder.h"
 
 namespace MxBase {
     const float EPSILON = 1e-6;
-    const int IMAGE_HEIGHTINDEX = 0;
-    const int IMAGE_WIDTHINDEX = 1;
-    const int IMAGE_CHANNELINDEX = 2;
-    const float ROUND_NUM = 0.5;
     const int SHOWED_ONCE = 1;
     const int SHOWED_TWICE = 2;
     const int NUM_TO_PAIR = 2;
     const int PAIR_OFFSET = 1;
     const int NEVERSHOWED_SIGN = -1;
     const float HALF_SCALE = 0.5;
-    const int SPLIT_TWO_PART = 2;
     struct PeakPoint {
-        int x;
-        int y;
-        float score;
-        int id;
-    };
-    struct UnitVector {
         float x;
         float y;
+        float score;
+        int id;
     };
     struct CandidateConnection {
         int idx1;
@@ -78,6 +72,10 @@ public:
 
     OpenPosePostProcessDptr &operator=(const OpenPosePostProcessDptr &other);
 
+    /**
+     * Peaks are found on the heatmaps at model resolution and their refined positions are scaled to the resized
+     * image, the part affinity fields are only sampled along the candidate limbs. Nothing is upsampled.
+     */
     APP_ERROR Upsample(std::vector<TensorBase> &tensors, const std::vector<ResizedImageInfo> &resizedImageInfos,
         std::vector<std::vector<KeyPointDetectionInfo>>& keyPointInfos);
 
@@ -111,7 +109,6 @@ private:
     const int HUMANSCORE_INDEX = 18;
     const int KEYPOINTNUM_INDEX = 19;
     const int HUMANINFO_NUM = 20;
-    const int DEFAULT_POOLING_STEP = 1;
     const int FILTERSIZE_MAX = 100;
     const int SIGMA_MAX = 10;
     const int NHWC_C_DIM = 3;
@@ -130,79 +127,41 @@ private:
 
     void GetImageInfoShape(uint32_t batchNum, const std::vector<TensorBase> &tensors,
         const std::vector<ResizedImageInfo> &resizedImageInfos);
-    void ProcessMat(cv::Mat peakMat, cv::Mat upHeatMat, cv::Mat upPafMat);
     int GetNumHumans();
     int GetPartCid(int humanid, int partid);
     float GetScore(int humanid);
-    int GetPartX(int cid);
-    int GetPartY(int cid);
+    float GetPartX(int cid);
+    float GetPartY(int cid);
     float GetPartScore(int cid);
-    int RoundPaf(float v);
     static bool CompCandidate(CandidateConnection a, CandidateConnection b);
-    std::vector<UnitVector> GetPafVectors(cv::Mat upPafMat, const int& chid1, const int& chid2, PeakPoint& peak1,
-        PeakPoint& peak2);
-
-    cv::Mat MaxPooling(cv::Mat img);
-    float GetPoolMax(cv::Mat img, int j, int i, int c, int size);
-    APP_ERROR MakeGaussianKernel(cv::Mat kernel, int size, float sigma);
-    void KeyPointOutput(std::vector<KeyPointDetectionInfo>& keyPointInfos, cv::Mat peakMat, cv::Mat upHeatMat,
-        cv::Mat upPafMat);
+
+    APP_ERROR CheckOutputLen(uint32_t outputLen);
+    HeatmapPlane GetChannel(int channel) const;
+    APP_ERROR FindPartPeaks(const std::vector<float>& kernelX, const std::vector<float>& kernelY);
+    void KeyPointOutput(std::vector<KeyPointDetectionInfo>& keyPointInfos);
     void PickCandidates(std::vector<PeakPoint>& peakAList, std::vector<PeakPoint>& peakBList, int pairid,
-        cv::Mat upPafMat, std::vector<CandidateConnection>& candidates);
+        std::vector<CandidateConnection>& candidates);
     void ConnectCandidates(std::vector<PeakPoint>& peakAList, std::vector<PeakPoint>& peakBList,
         std::vector<PartConnection>& onePairConnections, std::vector<CandidateConnection>& candidates);
     void GenerateSubset(std::vector<PartConnection> connectionAll[], int size);
     void AddConnections(PartConnection& conn, int pairid, int subsetidx1, int subsetidx2, int found);
-    float CheckEqual(float a, float b);
-    APP_ERROR SeparateMatValue(cv::Mat& heatMatOut, cv::Mat& pafMatOut, float& outputInfo, uint32_t &outputLen);
-    void GeneratePeaks(float& peaks, float& heatmap, std::vector<int> shape, std::vector<int> index, int& peakCnt);
     void ConnectOnePair(int pairId, int partId1, int partId2, std::vector<PartConnection>& onePairConnections);
     void CombineSubset(PartConnection& conn, int partId1, int partId2, int subsetIdx1, int subsetIdx2);
-    void ProcessPafMat(cv::Mat upPafMat);
+    void ProcessPafMat();
     void ConnectSubset(int found, int subsetId, int& subsetIdx1, int& subsetIdx2);
-    double CalcGaussianValue(double x);
     std::vector<std::vector<float>> subset_ = {};
     std::vector<PeakPoint> peakInfosLine_ = {};
     uint32_t outputModelHeight_ = 0;
     uint32_t outputModelWidth_ = 0;
     std::vector<PeakPoint> peakInfos_[PART_NUM] = {{}};
+    // the image being decoded: its model output in NHWC and the ratio of the resized image to the model output
+    const float* outputData_ = nullptr;
+    uint32_t resizedWidth_ = 0;
+    uint32_t resizedHeight_ = 0;
+    float scaleX_ = 1.f;
+    float scaleY_ = 1.f;
 };
 
-template<typename T>
-T IndexMat(T& mat, std::vector<int> shape, std::vector<int> index)
-{
-    int idx = 0;
-    float *matData = &mat;
-    for (size_t i = 0; i < shape.size(); i++) {
-        idx = idx * shape[i] + index[i];
-    }
-    return static_cast<T>(matData[idx]);
-}
-
-double OpenPosePostProcessDptr::CalcGaussianValue(double x)
-{
-    // constants
-    const double point1 =  0.254829592;
-    const double point2 = -0.284496736;
-    const double point3 =  1.421413741;
-    const double point4 = -1.453152027;
-    const double point5 =  1.061405429;
-    const double num  =  0.3275911;
-
-    // check the sign of x
-    int sign = 1;
-    if (x < 0) {
-        sign = -1;
-    }
-    x = fabs(x) / sqrt(2.);
-
-    // A&S formula 7.1.26
-    double timeStep = 1.0 / (1.0 + num * x);
-    double y = 1.0 - (((((point5 * timeStep + point4) * timeStep) + point3) * timeStep + point2) * timeStep + point1)
-        * timeStep * exp(-x * x);
-    return HALF_SCALE * (1.0 + sign * y);
-}
-
 OpenPosePostProcessDptr::OpenPosePostProcessDptr(OpenPosePostProcess *pOpenPosePostProcess)
     : qPtr_(pOpenPosePostProcess)
 {}
@@ -293,7 +252,6 @@ void OpenPosePostProcessDptr::GetImageInfoShape(uint32_t batchNum, const std::ve
     LogDebug << "End to process GetImageInfoShape.";
 }
 
-
 APP_ERROR OpenPosePostProcessDptr::Upsample(std::vector<TensorBase> &tensors,
     const std::vector<ResizedImageInfo> &resizedImageInfos,
     std::vector<std::vector<KeyPointDetectionInfo>>& keyPointInfos)
@@ -337,186 +295,106 @@ APP_ERROR OpenPosePostProcessDptr::Upsample(std::vector<TensorBase> &tensors,
             return APP_ERR_COMM_OUT_OF_RANGE;
         }
         GetImageInfoShape(i, tensors, resizedImageInfos);
-        cv::Mat gaussianMat = cv::Mat::zeros(resizedHeight, resizedWidth, CV_32FC(static_cast<size_t>(keyPointNum_)));
-        cv::Mat peakMat = cv::Mat::zeros(resizedHeight, resizedWidth, CV_32FC(static_cast<size_t>(keyPointNum_)));
-        cv::Mat upPafMat = cv::Mat::zeros(resizedHeight, resizedWidth,
-            CV_32FC(static_cast<size_t>(keyPointNum_ * PAFCHANNEL)));
-        cv::Mat upHeatMat = cv::Mat::zeros(resizedHeight, resizedWidth, CV_32FC(static_cast<size_t>(keyPointNum_)));
-        cv::Mat heatMat = cv::Mat::zeros(outputModelHeight_, outputModelWidth_,
-                                         CV_32FC(static_cast<size_t>(keyPointNum_)));
-        cv::Mat pafMat = cv::Mat::zeros(outputModelHeight_, outputModelWidth_,
-                                        CV_32FC(static_cast<size_t>(keyPointNum_ * PAFCHANNEL)));
-        cv::Mat &heatMatOut = heatMat;
-        cv::Mat &pafMatOut = pafMat;
         if (tensor.GetBuffer() == nullptr) {
             LogError << "The buffer is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
             return APP_ERR_COMM_INVALID_POINTER;
         }
-        float& outputInfo = *((float *) (tensor.GetBuffer()) + i * tensor.GetByteSize() / batchSize);
         uint32_t outputLen = tensor.GetSize() / batchSize;
-        APP_ERROR ret = SeparateMatValue(heatMatOut, pafMatOut, outputInfo, outputLen);
+        APP_ERROR ret = CheckOutputLen(outputLen);
         if (ret != APP_ERR_OK) {
-            LogError << "Separate mat value failed." << GetErrorInfo(ret);
+            LogError << "The model output is smaller than its shape." << GetErrorInfo(ret);
             return ret;
         }
-        cv::resize(heatMat, upHeatMat, cv::Size(static_cast<int>(resizedWidth), static_cast<int>(resizedHeight)),
-            cv::INTER_AREA);
-        cv::resize(pafMat, upPafMat, cv::Size(static_cast<int>(resizedWidth), static_cast<int>(resizedHeight)),
-            cv::INTER_AREA);
-        cv::Mat gaussianKernel = cv::Mat::zeros(filterSize_, filterSize_, CV_32FC1);
-        ret = MakeGaussianKernel(gaussianKernel, filterSize_, sigma_);
+        outputData_ = static_cast<const float *>(tensor.GetBuffer()) + static_cast<size_t>(i) * outputLen;
+        resizedWidth_ = resizedWidth;
+        resizedHeight_ = resizedHeight;
+        scaleX_ = static_cast<float>(resizedWidth) / static_cast<float>(outputModelWidth_);
+        scaleY_ = static_cast<float>(resizedHeight) / static_cast<float>(outputModelHeight_);
+        // the filter size and sigma are in pixels of the resized image, the kernel is mapped onto the model output
+        std::vector<float> kernelX;
+        std::vector<float> kernelY;
+        ret = KeypointPeakFinder::MakeGaussianKernel(filterSize_, sigma_, scaleX_, kernelX);
+        if (ret == APP_ERR_OK) {
+            ret = KeypointPeakFinder::MakeGaussianKernel(filterSize_, sigma_, scaleY_, kernelY);
+        }
         if (ret != APP_ERR_OK) {
             LogError << "MakeGaussianKernel failed." << GetErrorInfo(ret);
             return ret;
         }
-        cv::filter2D(upHeatMat, gaussianMat, -1, gaussianKernel, cv::Point(-1, -1), 0, cv::BORDER_CONSTANT);
-        peakMat = MaxPooling(gaussianMat);
+        ret = FindPartPeaks(kernelX, kernelY);
+        if (ret != APP_ERR_OK) {
+            LogError << "Find peaks of the heatmaps failed." << GetErrorInfo(ret);
+            return ret;
+        }
+        ProcessPafMat();
         std::vector<KeyPointDetectionInfo> keyPointInfo;
-        KeyPointOutput(keyPointInfo, peakMat, upHeatMat, upPafMat);
+        KeyPointOutput(keyPointInfo);
         keyPointInfos.push_back(keyPointInfo);
     }
     LogDebug << "Upsample successed.";
     return APP_ERR_OK;
 }
 
-APP_ERROR OpenPosePostProcessDptr::SeparateMatValue(cv::Mat& heatMatOut, cv::Mat& pafMatOut,
-                                                    float& outputInfo, uint32_t& outputLen)
+APP_ERROR OpenPosePostProcessDptr::CheckOutputLen(uint32_t outputLen)
 {
-    float *heatMatData = (float *) heatMatOut.data;
-    float *pafMatData = (float *) pafMatOut.data;
-    float *outputData = &outputInfo;
-    uint32_t WidthStride = static_cast<uint32_t>(keyPointNum_ * MAPCHANNEL);
-    uint32_t HeightStride = static_cast<uint32_t>(keyPointNum_ * MAPCHANNEL) * outputModelWidth_;
-    uint32_t headStride = outputModelWidth_ * static_cast<uint32_t>(keyPointNum_);
-    uint32_t pafWidthStride = static_cast<uint32_t>(keyPointNum_ * PAFCHANNEL);
-    uint32_t pafHeightStride = static_cast<uint32_t>(keyPointNum_ * PAFCHANNEL) * outputModelWidth_;
-    uint32_t beginLen = (outputModelHeight_ - 1) * HeightStride + (outputModelWidth_ - 1) * WidthStride
-                        + pafWidthStride + static_cast<uint32_t>(keyPointNum_) - 1;
-    uint32_t heatMatLen = (outputModelHeight_ - 1) * headStride + (outputModelWidth_ - 1)
-                          * static_cast<uint32_t>(keyPointNum_) + static_cast<uint32_t>(keyPointNum_) - 1;
-    uint32_t pafMatLen = (outputModelHeight_ - 1) * pafHeightStride + (outputModelWidth_ - 1) * pafWidthStride
-                        + 2 * static_cast<uint32_t>(keyPointNum_) - 1;
-    uint32_t heatMaxLen = outputModelHeight_ * outputModelWidth_ * static_cast<uint32_t>(keyPointNum_);
-    uint32_t pafMaxLen = outputModelHeight_ * outputModelWidth_ * static_cast<uint32_t>(keyPointNum_ * PAFCHANNEL);
-    if (beginLen >= outputLen || pafMatLen >= pafMaxLen || heatMatLen >= heatMaxLen) {
+    // every pixel holds keyPointNum_ heatmaps followed by keyPointNum_ * PAFCHANNEL part affinity fields
+    uint64_t requiredLen = static_cast<uint64_t>(outputModelHeight_) * outputModelWidth_ *
+        static_cast<uint64_t>(keyPointNum_ * MAPCHANNEL);
+    if (outputModelHeight_ == 0 || outputModelWidth_ == 0 || requiredLen > outputLen) {
         LogError << "Calculate separate mat value failed, please check!"
                  << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    for (uint32_t y = 0; y < outputModelHeight_; ++y) {
-        for (uint32_t x = 0; x < outputModelWidth_; ++x) {
-            for (int c = 0; c < keyPointNum_; ++c) {
-                float *begin = outputData + y * HeightStride + x * WidthStride;
-                heatMatData[y * headStride + x * static_cast<uint32_t>(keyPointNum_) + static_cast<uint32_t>(c)] =
-                    *(begin + c);
-                pafMatData[y * pafHeightStride + x * pafWidthStride + static_cast<uint32_t>(c)] =
-                    *(begin + keyPointNum_ + c);
-                pafMatData[y * pafHeightStride + x * pafWidthStride +
-                    static_cast<uint32_t>(keyPointNum_) + static_cast<uint32_t>(c)] =
-                    *(begin + static_cast<int>(pafWidthStride) + c);
-            }
-        }
-    }
-    return APP_ERR_OK;
-}
-
-APP_ERROR OpenPosePostProcessDptr::MakeGaussianKernel(cv::Mat kernel, int size, float sigma)
-{
-    if (size == 0) {
-        return APP_ERR_COMM_OUT_OF_RANGE;
-    }
-    int gaussianKernelHeight = size;
-    int gaussianKernelWidth = size;
-    float interval = (SPLIT_TWO_PART * sigma + 1) / (float)size;
-    float step = (SPLIT_TWO_PART * sigma + interval) / (float)size;
-    float start = (-sigma - (interval / SPLIT_TWO_PART));
-    float index[size + 1];
-    for (int i = 0; i < size + 1; i++) {
-        index[i] = start + (i * step);
-    }
-    float cdf[size + 1];
-    for (int i = 0; i < size + 1; i++) {
-        cdf[i] = CalcGaussianValue(index[i]);
-    }
-    float kern1D[size];
-    for (int i = 0; i < size; i++) {
-        kern1D[i] = cdf[i + 1] - cdf[i];
-    }
-    float* outData = (float *)kernel.data;
-    float kernelSum = 0;
-    for (int i = 0; i < gaussianKernelHeight; i++) {
-        for (int j = 0; j < gaussianKernelWidth; j++) {
-            outData[i * kernel.cols + j] = sqrt(kern1D[i] * kern1D[j]);
-            kernelSum += outData[i * kernel.cols + j];
-        }
-    }
-    if (fabs(kernelSum) < EPSILON) {
-        return APP_ERR_COMM_OUT_OF_RANGE;
-    }
-    for (int i = 0; i < gaussianKernelHeight; i++) {
-        for (int j = 0; j < gaussianKernelWidth; j++) {
-            outData[i * kernel.cols + j] = outData[i * kernel.cols + j] / kernelSum;
-        }
-    }
     return APP_ERR_OK;
 }
 
-cv::Mat OpenPosePostProcessDptr::MaxPooling(cv::Mat img)
+HeatmapPlane OpenPosePostProcessDptr::GetChannel(int channel) const
 {
-    int height = img.rows;
-    int width = img.cols;
-    int channels = img.channels();
-    cv::Mat peakMat = cv::Mat::zeros(height, width, CV_32FC(static_cast<size_t>(channels)));
-
-    int r = DEFAULT_POOLING_STEP;
-    int size = DEFAULT_KERNEL_SIZE;
-    float *imgData = (float *)img.data;
-    float *peakMatData = (float *)peakMat.data;
-
-    for (int64_t j = 0; j < height; j += r) {
-        for (int64_t i = 0; i < width; i += r) {
-            for (int64_t c = 0; c < channels; c++) {
-                float v = GetPoolMax(img, j, i, c, size);
-                float current = *(imgData + j * channels * width + i * channels + c);
-                *(peakMatData + j * channels * width + i * channels + c) = CheckEqual(current, v);
-            }
-        }
-    }
-    return peakMat;
+    HeatmapPlane plane;
+    plane.data = outputData_ + channel;
+    plane.width = outputModelWidth_;
+    plane.height = outputModelHeight_;
+    plane.pixelStride = static_cast<uint32_t>(keyPointNum_ * MAPCHANNEL);
+    return plane;
 }
 
-float OpenPosePostProcessDptr::CheckEqual(float a, float b)
+APP_ERROR OpenPosePostProcessDptr::FindPartPeaks(const std::vector<float>& kernelX, const std::vector<float>& kernelY)
 {
-    if (fabs(a - b) < EPSILON) {
-        return b;
-    } else {
-        return 0;
+    for (auto& peakInfo : peakInfos_) {
+        peakInfo.clear();
     }
-}
-
-float OpenPosePostProcessDptr::GetPoolMax(cv::Mat img, int row, int col, int c, int size)
-{
-    float v = 0;
-    int height = img.rows;
-    int width = img.cols;
-    int channels = img.channels();
-    float* imgData = (float *)img.data;
-    int begin = -((size - 1) / SPLIT_TWO_PART);
-    int end = ((size - 1) / SPLIT_TWO_PART) + 1;
-    for (int j = begin; j < end; j++) {
-        if ((row + j >= height) || (row + j < 0)) break;
-        for (int i = begin; i < end; i++) {
-            if ((col + i >= width) || (col + i < 0)) break;
-            v = fmax(*(imgData + (int64_t)(row + j) * channels * width + (int64_t)(col + i) * channels + c), v);
+    int peakCnt = 0;
+    std::vector<float> smoothed;
+    std::vector<HeatmapPeak> peaks;
+    for (int partId = 0; partId < std::min(PART_NUM, keyPointNum_); partId++) {
+        HeatmapPlane heatmap = GetChannel(partId);
+        APP_ERROR ret = KeypointPeakFinder::GaussianBlur(heatmap, kernelX, kernelY, smoothed);
+        if (ret != APP_ERR_OK) {
+            return ret;
+        }
+        peaks.clear();
+        ret = KeypointPeakFinder::FindPeaks(smoothed.data(), outputModelWidth_, outputModelHeight_, HEAT_THRESH,
+            DEFAULT_KERNEL_SIZE, true, peaks);
+        if (ret != APP_ERR_OK) {
+            return ret;
+        }
+        for (const auto& peak : peaks) {
+            // pixel centers of the model output and of the resized image are aligned, as with cv::resize
+            PeakPoint info;
+            info.id = peakCnt++;
+            info.x = std::max(0.f, std::min((peak.x + HALF_SCALE) * scaleX_ - HALF_SCALE,
+                static_cast<float>(resizedWidth_) - 1.f));
+            info.y = std::max(0.f, std::min((peak.y + HALF_SCALE) * scaleY_ - HALF_SCALE,
+                static_cast<float>(resizedHeight_) - 1.f));
+            info.score = KeypointPeakFinder::SampleBilinear(heatmap, peak.x, peak.y);
+            peakInfos_[partId].push_back(info);
         }
     }
-    return v;
+    return APP_ERR_OK;
 }
 
-void OpenPosePostProcessDptr::KeyPointOutput(std::vector<KeyPointDetectionInfo>& keyPointInfos, cv::Mat peakMat,
-    cv::Mat upHeatMat, cv::Mat upPafMat)
+void OpenPosePostProcessDptr::KeyPointOutput(std::vector<KeyPointDetectionInfo>& keyPointInfos)
 {
-    ProcessMat(peakMat, upHeatMat, upPafMat);
     for (int humanId = 0; humanId < GetNumHumans(); humanId++) {
         KeyPointDetectionInfo keyPointInfo;
         bool is_added = false;
@@ -527,13 +405,13 @@ void OpenPosePostProcessDptr::KeyPointOutput(std::vector<KeyPointDetectionInfo>&
             }
             is_added = true;
             std::vector<float> keyPoint = {};
-            if (IsDenominatorZero(peakMat.cols) || IsDenominatorZero(peakMat.rows)) {
-                LogError << "peakMat.cols is " << peakMat.cols << ", peakMat.rows is " << peakMat.rows << "."
+            if (resizedWidth_ == 0 || resizedHeight_ == 0) {
+                LogError << "resizedWidth is " << resizedWidth_ << ", resizedHeight is " << resizedHeight_ << "."
                          << GetErrorInfo(APP_ERR_COMM_FAILURE);
                 return;
             }
-            keyPointInfo.keyPointMap[part_idx].push_back((float)GetPartX(cIdx) / (float)peakMat.cols);
-            keyPointInfo.keyPointMap[part_idx].push_back((float)GetPartY(cIdx) / (float)peakMat.rows);
+            keyPointInfo.keyPointMap[part_idx].push_back(GetPartX(cIdx) / (float)resizedWidth_);
+            keyPointInfo.keyPointMap[part_idx].push_back(GetPartY(cIdx) / (float)resizedHeight_);
             keyPointInfo.scoreMap[part_idx] = GetPartScore(cIdx);
         }
         if (is_added) {
@@ -543,30 +421,7 @@ void OpenPosePostProcessDptr::KeyPointOutput(std::vector<KeyPointDetectionInfo>&
     }
 }
 
-void OpenPosePostProcessDptr::ProcessMat(cv::Mat peakMat, cv::Mat upHeatMat, cv::Mat upPafMat)
-{
-    int p1 = peakMat.rows;
-    int p2 = peakMat.cols;
-    int p3 = peakMat.channels();
-    float& peaks = *((float *) peakMat.data);
-    float& heatmap = *((float *) upHeatMat.data);
-    for (auto peakInfo : peakInfos_) {
-        peakInfo.clear();
-    }
-    int peakCnt = 0;
-    std::vector<int> shape {p1, p2, p3};
-    for (int partId = 0; partId < PART_NUM; partId++) {
-        for (int y = 0; y < p1; y++) {
-            for (int x = 0; x < p2; x++) {
-                std::vector<int> index {y, x, partId};
-                GeneratePeaks(peaks, heatmap, shape, index, peakCnt);
-            }
-        }
-    }
-    ProcessPafMat(upPafMat);
-}
-
-void OpenPosePostProcessDptr::ProcessPafMat(cv::Mat upPafMat)
+void OpenPosePostProcessDptr::ProcessPafMat()
 {
     peakInfosLine_.clear();
     for (int partId = 0; partId < PART_NUM; partId++) {
@@ -583,7 +438,7 @@ void OpenPosePostProcessDptr::ProcessPafMat(cv::Mat upPafMat)
         if (peakAList.size() == 0 || peakBList.size() == 0) {
             continue;
         }
-        PickCandidates(peakAList, peakBList, pairId, upPafMat, candidates);
+        PickCandidates(peakAList, peakBList, pairId, candidates);
         std::vector<PartConnection>& onePairConnections = connectionAll[pairId];
         sort(candidates.begin(), candidates.end(), CompCandidate);
         ConnectCandidates(peakAList, peakBList, onePairConnections, candidates);
@@ -598,49 +453,34 @@ void OpenPosePostProcessDptr::ProcessPafMat(cv::Mat upPafMat)
     }
 }
 
-void OpenPosePostProcessDptr::GeneratePeaks(float& peaks, float& heatmap, std::vector<int> shape,
-                                            std::vector<int> index, int& peakCnt)
-{
-    if (IndexMat<float>(peaks, shape, index) > HEAT_THRESH) {
-        PeakPoint info;
-        info.id = peakCnt++;
-        info.x = index[IMAGE_WIDTHINDEX];
-        info.y = index[IMAGE_HEIGHTINDEX];
-        info.score = IndexMat<float>(heatmap, shape, index);
-        peakInfos_[index[IMAGE_CHANNELINDEX]].push_back(info);
-    }
-}
-
 void OpenPosePostProcessDptr::PickCandidates(std::vector<PeakPoint>& peakAList, std::vector<PeakPoint>& peakBList,
-    int pairId, cv::Mat upPafMat, std::vector<CandidateConnection>& candidates)
+    int pairId, std::vector<CandidateConnection>& candidates)
 {
-    int f1 = upPafMat.rows;
-    int h1 = f1;
+    int channelX = PAIRS_NET[pairId * NUM_TO_PAIR];
+    int channelY = PAIRS_NET[pairId * NUM_TO_PAIR + PAIR_OFFSET];
+    if (std::max(channelX, channelY) >= keyPointNum_ * PAFCHANNEL) {
+        return;
+    }
+    HeatmapPlane pafX = GetChannel(keyPointNum_ + channelX);
+    HeatmapPlane pafY = GetChannel(keyPointNum_ + channelY);
+    float h1 = static_cast<float>(resizedHeight_);
     for (int peadAId = 0; peadAId < (int) peakAList.size(); peadAId++) {
         PeakPoint& peakA = peakAList[peadAId];
         for (int peakBId = 0; peakBId < (int) peakBList.size(); peakBId++) {
             PeakPoint& peakB = peakBList[peakBId];
-            // calculate vector(direction)
-            UnitVector vec;
-            vec.x = peakB.x - peakA.x;
-            vec.y = peakB.y - peakA.y;
-            float norm = (float) sqrt(vec.x * vec.x + vec.y * vec.y);
+            float dx = peakB.x - peakA.x;
+            float dy = peakB.y - peakA.y;
+            float norm = std::sqrt(dx * dx + dy * dy);
             if (norm < EPSILON) continue;
-            vec.x = vec.x / norm;
-            vec.y = vec.y / norm;
-
-            std::vector<UnitVector> pafVecs = GetPafVectors(upPafMat, PAIRS_NET[pairId * NUM_TO_PAIR],
-                PAIRS_NET[pairId * NUM_TO_PAIR + PAIR_OFFSET], peakA, peakB);
-            float scores = 0.0f;
+            // the limb is sampled on the model output, where the fields were computed
+            LimbScore limb = KeypointPeakFinder::ScoreLimb(pafX, pafY,
+                (peakA.x + HALF_SCALE) / scaleX_ - HALF_SCALE, (peakA.y + HALF_SCALE) / scaleY_ - HALF_SCALE,
+                (peakB.x + HALF_SCALE) / scaleX_ - HALF_SCALE, (peakB.y + HALF_SCALE) / scaleY_ - HALF_SCALE,
+                static_cast<uint32_t>(PAF_STEP), VECTOR_SCORE_THRESH);
             // criterion 1 : score threshold count
-            int pointNumCriterion = 0;
-            for (int i = 0; i < PAF_STEP; i++) {
-                float score = vec.x * pafVecs[i].x + vec.y * pafVecs[i].y;
-                scores += score;
-                pointNumCriterion += (int)(score > VECTOR_SCORE_THRESH);
-            }
-            float scoreCriterion = scores / PAF_STEP + std::min(0.0, HALF_SCALE * h1 / norm - 1.0);
-            if (pointNumCriterion > VECTOR_CNT1_THRESH && scoreCriterion > std::numeric_limits<float>::epsilon()) {
+            float scoreCriterion = limb.score + std::min(0.0, HALF_SCALE * h1 / norm - 1.0);
+            if (static_cast<int>(limb.hitNum) > VECTOR_CNT1_THRESH &&
+                scoreCriterion > std::numeric_limits<float>::epsilon()) {
                 CandidateConnection candidate;
                 candidate.idx1 = peadAId;
                 candidate.idx2 = peakBId;
@@ -788,12 +628,12 @@ float OpenPosePostProcessDptr::GetScore(int humanId)
     return subset_[humanId][HUMANSCORE_INDEX] / subset_[humanId][KEYPOINTNUM_INDEX];
 }
 
-int OpenPosePostProcessDptr::GetPartX(int cid)
+float OpenPosePostProcessDptr::GetPartX(int cid)
 {
     return peakInfosLine_[cid].x;
 }
 
-int OpenPosePostProcessDptr::GetPartY(int cid)
+float OpenPosePostProcessDptr::GetPartY(int cid)
 {
     return peakInfosLine_[cid].y;
 }
@@ -803,43 +643,9 @@ float OpenPosePostProcessDptr::GetPartScore(int cid)
     return peakInfosLine_[cid].score;
 }
 
-int OpenPosePostProcessDptr::RoundPaf(float v)
-{
-    return (int) (v + ROUND_NUM);
-}
-
 bool OpenPosePostProcessDptr::CompCandidate(CandidateConnection a, CandidateConnection b)
 {
     return a.score > b.score;
 }
-
-std::vector<UnitVector> OpenPosePostProcessDptr::GetPafVectors(cv::Mat upPafMat, const int &channelId1,
-    const int &channelId2, PeakPoint &peak1, PeakPoint &peak2)
-{
-    float *pafmap = (float *) upPafMat.data;
-    int f1 = upPafMat.rows;
-    int f2 = upPafMat.cols;
-    int f3 = upPafMat.channels();
-    std::vector<UnitVector> pafVectors;
-
-    std::vector<int> shape {f1, f2, f3};
-
-    const float STEP_X = (peak2.x - peak1.x) / float(PAF_STEP);
-    const float STEP_Y = (peak2.y - peak1.y) / float(PAF_STEP);
-
-    for (int i = 0; i < PAF_STEP; i++) {
-        int locationX = RoundPaf(peak1.x + i * STEP_X);
-        int locationY = RoundPaf(peak1.y + i * STEP_Y);
-
-        UnitVector v;
-        std::vector<int> index {locationY, locationX, channelId1};
-        v.x = IndexMat<float>(*pafmap, shape, index);
-        index[IMAGE_CHANNELINDEX] = channelId2;
-        v.y = IndexMat<float>(*pafmap, shape, index);
-
-        pafVectors.push_back(v);
-    }
-    return pafVectors;
-}
 }
 #endif
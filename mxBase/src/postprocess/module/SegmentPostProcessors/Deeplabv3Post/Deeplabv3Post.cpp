@@ -148,7 +148,11 @@ APP_ERROR Deeplabv3Post::Process(const std::vector<TensorBase>& tensors,
             }
             break;
         case FrameworkType::PYTORCH:
-            dPtr_->PytorchFwOutput(inputs, resizedImageInfos, semanticSegInfos);
+            ret = dPtr_->PytorchFwOutput(inputs, resizedImageInfos, semanticSegInfos);
+            if (ret != APP_ERR_OK) {
+                LogError << "Execute PytorchFwOutput failed" << GetErrorInfo(ret);
+                return ret;
+            }
             break;
         case FrameworkType::MINDSPORE:
             dPtr_->MindsporeFwOutput(inputs, resizedImageInfos, semanticSegInfos);
@@ -24,6 +24,7 @@
 #define DEEPLAB_V3_POST_DPTR_H
 
 #include "MxBase/GlobalManager/GlobalManager.h"
+#include "MxBase/PostProcessBases/ChannelArgmax.h"
 
 namespace MxBase {
 class SDK_UNAVAILABLE_FOR_OTHER Deeplabv3PostDptr {
@@ -40,9 +41,9 @@ public:
     APP_ERROR TensorflowFwOutput(const std::vector<TensorBase>& tensors,
                                  const std::vector<ResizedImageInfo>& resizedImageInfos,
                                  std::vector<SemanticSegInfo> &semanticSegInfos);
-    void PytorchFwOutput(const std::vector<TensorBase>& tensors,
-                         const std::vector<ResizedImageInfo>& resizedImageInfos,
-                         std::vector<SemanticSegInfo> &semanticSegInfos);
+    APP_ERROR PytorchFwOutput(const std::vector<TensorBase>& tensors,
+                              const std::vector<ResizedImageInfo>& resizedImageInfos,
+                              std::vector<SemanticSegInfo> &semanticSegInfos);
     void MindsporeFwOutput(const std::vector<TensorBase>& tensors,
                            const std::vector<ResizedImageInfo>& resizedImageInfos,
                            std::vector<SemanticSegInfo> &semanticSegInfos);
@@ -50,10 +51,11 @@ public:
     void GetImageInfoShape(uint32_t batchNum,
                            const std::vector<TensorBase> &tensors,
                            const std::vector<ResizedImageInfo> &resizedImageInfos);
-    std::vector<std::vector<int>> CalArgmaxRes(cv::Mat OriginalMat, uint32_t& label);
-    std::vector<std::vector<int>> OriginalSizeOutput(
-            const std::vector<ResizedImageInfo>& resizedImageInfos,
-            uint32_t bathNum, std::vector<std::vector<int>> argmaxResults);
+    APP_ERROR ModelSizeArgmax(const TensorBase& tensor, uint32_t batchNum, TensorArrangementType layout,
+                              SegLabelMap& results);
+    SegLabelMap CalArgmaxRes(cv::Mat OriginalMat, uint32_t& label);
+    SegLabelMap OriginalSizeOutput(const std::vector<ResizedImageInfo>& resizedImageInfos,
+                                   uint32_t bathNum, const SegLabelMap& argmaxResults);
 
 public:
     int frameworkType_ = 0;
@@ -142,32 +144,23 @@ APP_ERROR Deeplabv3PostDptr::TensorflowFwOutput(const std::vector<TensorBase> &t
     for (uint32_t i = 0; i < batchSize; i++) {
         GetImageInfoShape(i, tensors, resizedImageInfos);
         SemanticSegInfo semanticSegInfo;
-        auto tensorPtr = (float*)(qPtr_->GetBuffer)(tensor, i);
-        if (tensorPtr == nullptr) {
-            LogError << "The tensorPtr is nullptr" << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
-            return APP_ERR_COMM_INVALID_POINTER;
-        }
         // Argmax between classes.
-        std::vector<std::vector<int>> results(outputModelHeight_, std::vector<int>(outputModelWidth_));
-        for (uint32_t y = 0; y < outputModelHeight_; y++) {
-            for (uint32_t x = 0; x < outputModelWidth_; x++) {
-                float* begin = tensorPtr +  y * outputModelWidth_ * qPtr_->classNum_
-                        + x * qPtr_->classNum_;
-                results[y][x] = std::max_element(begin, begin + qPtr_->classNum_) - begin;
-            }
+        SegLabelMap results;
+        APP_ERROR ret = ModelSizeArgmax(tensor, i, TYPE_NHWC, results);
+        if (ret != APP_ERR_OK) {
+            return ret;
         }
-        std::vector<std::vector<int>> resultPixels = OriginalSizeOutput(resizedImageInfos, i, results);
-        semanticSegInfo.pixels = resultPixels;
-        semanticSegInfo.labelMap = qPtr_->labelMap_;
-        semanticSegInfos.push_back(semanticSegInfo);
+        semanticSegInfo.labels = OriginalSizeOutput(resizedImageInfos, i, results);
+        qPtr_->FillSemanticSegInfo(semanticSegInfo);
+        semanticSegInfos.push_back(std::move(semanticSegInfo));
     }
     LogDebug << "TensorflowFwOutput write results successed.";
     return APP_ERR_OK;
 }
 
-void Deeplabv3PostDptr::PytorchFwOutput(const std::vector<TensorBase> &tensors,
-                                        const std::vector<ResizedImageInfo> &resizedImageInfos,
-                                        std::vector<SemanticSegInfo> &semanticSegInfos)
+APP_ERROR Deeplabv3PostDptr::PytorchFwOutput(const std::vector<TensorBase> &tensors,
+                                             const std::vector<ResizedImageInfo> &resizedImageInfos,
+                                             std::vector<SemanticSegInfo> &semanticSegInfos)
 {
     LogDebug << "PytorchFwOutput start to write results.";
     auto tensor = tensors[0];
@@ -177,23 +170,16 @@ void Deeplabv3PostDptr::PytorchFwOutput(const std::vector<TensorBase> &tensors,
     for (uint32_t i = 0; i < batchSize; i++) {
         GetImageInfoShape(i, tensors, resizedImageInfos);
         SemanticSegInfo semanticSegInfo;
-        cv::Mat hwcMat = NCHWToNHWC(tensor, i, batchSize);
-        // Argmax
-        std::vector<std::vector<int>> results(outputModelHeight_, std::vector<int>(outputModelWidth_));
-        cv::Mat& hwcMatOut = hwcMat;
-        float* hwcMatData = (float*)hwcMatOut.data;
-        for (uint32_t y = 0; y < outputModelHeight_; ++y) {
-            for (uint32_t x = 0; x < outputModelWidth_; ++x) {
-                float* begin = hwcMatData + y * (outputModelWidth_ * qPtr_->classNum_)
-                        + x * qPtr_->classNum_;
-                results[y][x] = std::max_element(begin, begin + qPtr_->classNum_) - begin;
-            }
+        // Argmax across the class planes, no transposition to NHWC needed.
+        APP_ERROR ret = ModelSizeArgmax(tensor, i, TYPE_NCHW, semanticSegInfo.labels);
+        if (ret != APP_ERR_OK) {
+            return ret;
         }
-        semanticSegInfo.pixels = results;
-        semanticSegInfo.labelMap = qPtr_->labelMap_;
-        semanticSegInfos.push_back(semanticSegInfo);
+        qPtr_->FillSemanticSegInfo(semanticSegInfo);
+        semanticSegInfos.push_back(std::move(semanticSegInfo));
     }
     LogDebug << "PytorchFwOutput write results successed.";
+    return APP_ERR_OK;
 }
 
 void Deeplabv3PostDptr::MindsporeFwOutput(const std::vector<TensorBase> &tensors,
@@ -219,13 +205,12 @@ void Deeplabv3PostDptr::MindsporeFwOutput(const std::vector<TensorBase> &tensors
                    cv::Size(static_cast<int>(originalWidth_), static_cast<int>(originalHeight_)),
                    cv::INTER_LINEAR);
         uint32_t label = 0;
-        std::vector<std::vector<int>> results = CalArgmaxRes(originalMat, label);
+        semanticSegInfo.labels = CalArgmaxRes(originalMat, label);
         if (label) {
             continue;
         }
-        semanticSegInfo.pixels = results;
-        semanticSegInfo.labelMap = qPtr_->labelMap_;
-        semanticSegInfos.push_back(semanticSegInfo);
+        qPtr_->FillSemanticSegInfo(semanticSegInfo);
+        semanticSegInfos.push_back(std::move(semanticSegInfo));
     }
     LogDebug << "MindsporeFwOutput write results successed.";
 }
@@ -233,8 +218,7 @@ void Deeplabv3PostDptr::MindsporeFwOutput(const std::vector<TensorBase> &tensors
 cv::Mat Deeplabv3PostDptr::NCHWToNHWC(TensorBase &tensor, uint32_t batchNum, uint32_t batchSize)
 {
     LogDebug << "Start to Process NCHWToNHWC.";
-    cv::Mat hwcMat = cv::Mat::zeros(outputModelHeight_, outputModelWidth_,
-                                    CV_32FC(qPtr_->classNum_));
+    cv::Mat hwcMat(outputModelHeight_, outputModelWidth_, CV_32FC(qPtr_->classNum_));
     cv::Mat& hwcMatOut = hwcMat;
     float* hwcMatData = (float*)hwcMatOut.data;
     if (hwcMatData == nullptr) {
@@ -253,15 +237,13 @@ cv::Mat Deeplabv3PostDptr::NCHWToNHWC(TensorBase &tensor, uint32_t batchNum, uin
         LogError << "The hwcMatData are invalid pointer." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
         return cv::Mat::zeros(0, 0, CV_32FC(0));
     }
+    // Interleave the class planes with cv::merge instead of an element by element copy.
+    std::vector<cv::Mat> planes;
+    size_t planeSize = static_cast<size_t>(outputModelHeight_) * outputModelWidth_;
     for (uint32_t c = 0; c < qPtr_->classNum_; ++c) {
-        for (uint32_t y = 0; y < outputModelHeight_; ++y) {
-            for (uint32_t x = 0; x < outputModelWidth_; ++x) {
-                float* begin = outputInfo +  c * outputModelHeight_ * outputModelWidth_ +  y * outputModelWidth_;
-                hwcMatData[y * (outputModelWidth_ * qPtr_->classNum_)
-                + x * qPtr_->classNum_ + c] = *(begin + x);
-            }
-        }
+        planes.emplace_back(outputModelHeight_, outputModelWidth_, CV_32FC1, outputInfo + c * planeSize);
     }
+    cv::merge(planes, hwcMat);
     LogDebug << "End to Process NCHWToNHWC.";
     return hwcMat;
 }
@@ -293,46 +275,60 @@ void Deeplabv3PostDptr::GetImageInfoShape(uint32_t batchNum,
     LogDebug << "End to process GetImageInfoShape.";
 }
 
-std::vector<std::vector<int>> Deeplabv3PostDptr::OriginalSizeOutput(
-    const std::vector<ResizedImageInfo>& resizedImageInfos,
-    uint32_t bathNum, std::vector<std::vector<int>> argmaxResults)
+SegLabelMap Deeplabv3PostDptr::OriginalSizeOutput(const std::vector<ResizedImageInfo>& resizedImageInfos,
+                                                  uint32_t bathNum, const SegLabelMap& argmaxResults)
 {
     LogDebug << "Start to Process OriginalSizeOutput.";
-    std::vector<std::vector<int>> resultPixels(imgHeight_, std::vector<int>(imgWidth_));
-    for (uint32_t y = 0; y < imgHeight_; y++) {
-        for (uint32_t x = 0; x < imgWidth_; x++) {
-            // Use Slice on results to original image size.
-            if (resizedImageInfos[bathNum].resizeType == RESIZER_ONLY_PADDING) {
-                resultPixels[y][x] = argmaxResults[y][x];
-            }  else {
-                // Resize to original image size.
-                resultPixels[y][x] = argmaxResults[y * outputModelHeight_ / imgHeight_] \
-                [x * outputModelWidth_ / imgWidth_];
-            }
-        }
+    SegLabelMap resultLabels;
+    if (resizedImageInfos[bathNum].resizeType == RESIZER_ONLY_PADDING) {
+        // Use Slice on results to original image size.
+        resultLabels = argmaxResults.ResizeNearest(imgWidth_, imgHeight_, imgWidth_, imgHeight_);
+    } else {
+        // Resize to original image size.
+        resultLabels = argmaxResults.ResizeNearest(imgWidth_, imgHeight_, outputModelWidth_, outputModelHeight_);
     }
     LogDebug << "End to Process OriginalSizeOutput.";
-    return resultPixels;
+    return resultLabels;
 }
 
-std::vector<std::vector<int>> Deeplabv3PostDptr::CalArgmaxRes(cv::Mat originalMat, uint32_t& label)
+APP_ERROR Deeplabv3PostDptr::ModelSizeArgmax(const TensorBase& tensor, uint32_t batchNum,
+                                             TensorArrangementType layout, SegLabelMap& results)
+{
+    ChannelScores scores;
+    scores.data = qPtr_->GetBuffer(tensor, batchNum);
+    if (scores.data == nullptr) {
+        LogError << "The tensorPtr is nullptr" << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    scores.dataType = tensor.GetDataType();
+    scores.layout = layout;
+    scores.width = outputModelWidth_;
+    scores.height = outputModelHeight_;
+    scores.classNum = qPtr_->classNum_;
+    APP_ERROR ret = ChannelArgmax::Argmax(scores, results, nullptr, qPtr_->argmaxThreadNum_);
+    if (ret != APP_ERR_OK) {
+        LogError << "Argmax between classes failed." << GetErrorInfo(ret);
+    }
+    return ret;
+}
+
+SegLabelMap Deeplabv3PostDptr::CalArgmaxRes(cv::Mat originalMat, uint32_t& label)
 {
     LogDebug << "Start to Process CalArgmaxRes.";
-    uint32_t step0 = originalMat.step[0];
-    uint32_t step1 = originalMat.step[1];
-    std::vector<std::vector<int>> results(originalHeight_, std::vector<int>(originalWidth_));
-    float *originalData = (float*)(originalMat.data);
-    if (originalData == nullptr) {
+    SegLabelMap results;
+    if (originalMat.data == nullptr || !originalMat.isContinuous()) {
         LogError << "The pointer are invalid." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
         label = 1;
         return results;
     }
-    for (uint32_t y = 0; y < originalHeight_; y++) {
-        for (uint32_t x = 0; x < originalWidth_; x++) {
-            float *pre_ptr = originalData +
-                step0 / sizeof(float) * y + step1 / sizeof(float) * x;
-            results[y][x] = std::max_element(pre_ptr, pre_ptr + qPtr_->classNum_) - pre_ptr;
-        }
+    ChannelScores scores;
+    scores.data = originalMat.data;
+    scores.layout = TYPE_NHWC;
+    scores.width = originalWidth_;
+    scores.height = originalHeight_;
+    scores.classNum = qPtr_->classNum_;
+    if (ChannelArgmax::Argmax(scores, results, nullptr, qPtr_->argmaxThreadNum_) != APP_ERR_OK) {
+        label = 1;
     }
     LogDebug << "End to Process CalArgmaxRes.";
     return results;
@@ -153,6 +153,9 @@ APP_ERROR UNetMindSporePostProcess::Process(const std::vector<TensorBase>& tenso
             CoordinatesReduction(resizedImageInfos[i], semanticSegInfos[i]);
         }
     }
+    for (auto& semanticSegInfo : semanticSegInfos) {
+        FillSemanticSegInfo(semanticSegInfo);
+    }
 
     LogDebug << "End to Process UNetMindSporePostProcess.";
     return APP_ERR_OK;
@@ -24,6 +24,7 @@
 #define UNETMINDSPORE_POST_PROCESS_DPTR_H
 
 #include "MxBase/GlobalManager/GlobalManager.h"
+#include "MxBase/PostProcessBases/ChannelArgmax.h"
 
 namespace MxBase {
 class SDK_UNAVAILABLE_FOR_OTHER UNetMindSporePostProcessDptr {
@@ -45,13 +46,10 @@ public:
     APP_ERROR ArgmaxSemanticSegOutput(const std::vector<TensorBase> &tensors,
         const std::vector<ResizedImageInfo> &resizedImageInfos, std::vector<SemanticSegInfo> &semanticSegInfos);
 
-    int GenArgmaxPixelIndex(const uint32_t &classNum, const uint32_t &classIndexOffset,
-    	const float *tensorPtr, const uint32_t modelSizeProduct, const size_t tensorSize);
-
     APP_ERROR ModelArgmaxDirectOutput(const std::vector<TensorBase>& tensors,
     	const std::vector<ResizedImageInfo>& resizedImageInfos, std::vector<SemanticSegInfo> &semanticSegInfos);
 
-    APP_ERROR SetSemanticSegPixels(const size_t tensorSize, const uint32_t outputModelHeight,
+    APP_ERROR SetSemanticSegLabels(const size_t tensorSize, const uint32_t outputModelHeight,
         const uint32_t outputModelWidth, const float *tensorPtr, SemanticSegInfo &semanticSegInfo);
 
     enum PostType {
@@ -142,26 +140,6 @@ bool UNetMindSporePostProcessDptr::IsValidTensors(const std::vector<TensorBase>
     return TestModelType(tensors);
 }
 
-int UNetMindSporePostProcessDptr::GenArgmaxPixelIndex(const uint32_t &classNum, const uint32_t &classIndexOffset,
-    const float *tensorPtr, const uint32_t modelSizeProduct, const size_t tensorSize)
-{
-    int maxIndex = 0;
-    uint32_t curPtr = classIndexOffset;
-    float maxValue = tensorPtr[curPtr];
-    for (uint32_t cl = 0; cl < classNum; cl++) {
-        curPtr = cl * modelSizeProduct + classIndexOffset;
-        if (tensorSize <= curPtr) {
-            LogError << "The tensorSize must be larger than curPtr." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return -1;
-        }
-        if (tensorPtr[curPtr] > maxValue) {
-            maxValue = tensorPtr[curPtr];
-            maxIndex = static_cast<int>(cl);
-        }
-    }
-    return maxIndex;
-}
-
 APP_ERROR UNetMindSporePostProcessDptr::ArgmaxSemanticSegOutput(const std::vector<TensorBase>& tensors,
     const std::vector<ResizedImageInfo>& resizedImageInfos, std::vector<SemanticSegInfo> &semanticSegInfos)
 {
@@ -187,40 +165,36 @@ APP_ERROR UNetMindSporePostProcessDptr::ArgmaxSemanticSegOutput(const std::vecto
             LogError << "The tensorPtr is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
             return APP_ERR_COMM_INVALID_POINTER;
         }
-        APP_ERROR ret = SetSemanticSegPixels(tensorSize, outputModelHeight, outputModelWidth,
+        APP_ERROR ret = SetSemanticSegLabels(tensorSize, outputModelHeight, outputModelWidth,
                                              tensorPtr, semanticSegInfo);
         if (ret != APP_ERR_OK) {
-            LogError << "Failed to set SemanticSegInfo of pixels." << GetErrorInfo(ret);
+            LogError << "Failed to set SemanticSegInfo of labels." << GetErrorInfo(ret);
             return ret;
         }
-        semanticSegInfo.labelMap = qPtr_->labelMap_;
-        semanticSegInfos.push_back(semanticSegInfo);
+        semanticSegInfos.push_back(std::move(semanticSegInfo));
     }
-    LogDebug << "semanticSegInfos. " << semanticSegInfos[0].pixels[0].size();
 
     LogDebug << "UNetMindSporePostProcess write results successed.";
     return APP_ERR_OK;
 }
 
-APP_ERROR UNetMindSporePostProcessDptr::SetSemanticSegPixels(const size_t tensorSize, const uint32_t outputModelHeight,
+APP_ERROR UNetMindSporePostProcessDptr::SetSemanticSegLabels(const size_t tensorSize, const uint32_t outputModelHeight,
     const uint32_t outputModelWidth, const float *tensorPtr, SemanticSegInfo &semanticSegInfo)
 {
-    uint32_t modelSizeProduct = outputModelWidth * outputModelHeight;
-    for (uint32_t y = 0; y < outputModelHeight; y++) {
-        std::vector<int> result;
-        for (uint32_t x = 0; x < outputModelWidth; x++) {
-            uint32_t classIndexOffset = y * outputModelWidth + x;
-            int indexNum = GenArgmaxPixelIndex(qPtr_->classNum_, classIndexOffset,
-                                               tensorPtr, modelSizeProduct, tensorSize);
-            if (indexNum == -1) {
-                LogError << "Failed to get indexNum." << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
-                return APP_ERR_COMM_OUT_OF_RANGE;
-            }
-            result.push_back(indexNum);
-        }
-        semanticSegInfo.pixels.push_back(result);
+    size_t modelSizeProduct = static_cast<size_t>(outputModelWidth) * outputModelHeight;
+    if (tensorSize < modelSizeProduct * qPtr_->classNum_) {
+        LogError << "The tensorSize(" << tensorSize << ") is smaller than classNum x height x width("
+                 << modelSizeProduct * qPtr_->classNum_ << ")." << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+        return APP_ERR_COMM_OUT_OF_RANGE;
     }
-    return APP_ERR_OK;
+    // Argmax across the class planes.
+    ChannelScores scores;
+    scores.data = tensorPtr;
+    scores.layout = TYPE_NCHW;
+    scores.width = outputModelWidth;
+    scores.height = outputModelHeight;
+    scores.classNum = qPtr_->classNum_;
+    return ChannelArgmax::Argmax(scores, semanticSegInfo.labels, nullptr, qPtr_->argmaxThreadNum_);
 }
 
 APP_ERROR UNetMindSporePostProcessDptr::ModelArgmaxDirectOutput(const std::vector<TensorBase>& tensors,
@@ -235,9 +209,7 @@ APP_ERROR UNetMindSporePostProcessDptr::ModelArgmaxDirectOutput(const std::vecto
         uint32_t outputModelHeight = tensor.GetShape()[heightIndex_];
         std::cout << outputModelWidth << ", " << outputModelHeight << std::endl;
         SemanticSegInfo semanticSegInfo;
-        std::vector<int> subPixel(outputModelWidth);
-        semanticSegInfo.pixels.resize(outputModelHeight, subPixel);
-        std::vector<std::vector<int>> results(outputModelHeight, std::vector<int>(outputModelWidth));
+        semanticSegInfo.labels.Reset(outputModelWidth, outputModelHeight, qPtr_->classNum_);
         auto tensorPtr = (int32_t *)qPtr_->GetBuffer(tensor, i);
         if (tensorPtr == nullptr) {
             LogError << "The tensorPtr is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
@@ -246,11 +218,10 @@ APP_ERROR UNetMindSporePostProcessDptr::ModelArgmaxDirectOutput(const std::vecto
         for (uint32_t y = 0; y < outputModelHeight; y++) {
             for (uint32_t x = 0; x < outputModelWidth; x++) {
                 auto curPtr = y * outputModelWidth + x;
-                semanticSegInfo.pixels[y][x] = tensorPtr[curPtr];
+                semanticSegInfo.labels.Set(x, y, static_cast<uint32_t>(tensorPtr[curPtr]));
             }
         }
-        semanticSegInfo.labelMap = qPtr_->labelMap_;
-        semanticSegInfos.push_back(semanticSegInfo);
+        semanticSegInfos.push_back(std::move(semanticSegInfo));
     }
     LogDebug << "UNetMindSpore ModelArgmaxDirectOutput write results successed.";
     return APP_ERR_OK;
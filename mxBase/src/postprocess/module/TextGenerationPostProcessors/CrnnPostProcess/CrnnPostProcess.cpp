@@ -63,6 +63,9 @@ CrnnPostProcess &CrnnPostProcess::operator=(const CrnnPostProcess &other)
     dPtr_->objectNum_ = other.dPtr_->objectNum_;
     dPtr_->blankIdx_ = other.dPtr_->blankIdx_;
     dPtr_->withArgmax_ = other.dPtr_->withArgmax_;
+    dPtr_->beamConfig_ = other.dPtr_->beamConfig_;
+    dPtr_->lexiconPath_ = other.dPtr_->lexiconPath_;
+    dPtr_->decoder_ = other.dPtr_->decoder_;
     return *this;
 }
 
@@ -108,6 +111,27 @@ APP_ERROR CrnnPostProcess::Init(const std::map<std::string, std::string> &postCo
         LogWarn << GetErrorInfo(ret) << "Fail to read WITH_ARGMAX from config, default value(false) will be used "
                                     "as withArgmax_.";
     }
+    ret = configData_.GetFileValue<uint32_t>("BEAM_WIDTH", dPtr_->beamConfig_.beamWidth, (uint32_t)0x1,
+                                             (uint32_t)0x3e8);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read BEAM_WIDTH from config, default value(1) will be used as beamWidth.";
+    }
+    ret = configData_.GetFileValue<float>("BEAM_PRUNE_THRESH", dPtr_->beamConfig_.pruneThresh, 0.0f, 1.0f);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read BEAM_PRUNE_THRESH from config, default value(0.001) will be used as pruneThresh.";
+    }
+    ret = configData_.GetFileValue<bool>("APPLY_SOFTMAX", dPtr_->beamConfig_.applySoftmax);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read APPLY_SOFTMAX from config, default value(true) will be used as applySoftmax.";
+    }
+    ret = configData_.GetFileValue<std::string>("LEXICON_PATH", dPtr_->lexiconPath_);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "No LEXICON_PATH in config, the decoding is not restricted to a lexicon.";
+    }
+    ret = dPtr_->InitDecoder();
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
     LogDebug << "End to Init CrnnPostProcess.";
     isInitConfig_ = true;
     return APP_ERR_OK;
@@ -24,6 +24,7 @@
 #define CRNN_POST_PROCESS_DPTR_H
 
 #include "TextGenerationPostProcessors/CrnnPostProcess.h"
+#include "MxBase/PostProcessBases/CtcDecoder.h"
 #include "MxBase/Log/Log.h"
 
 namespace MxBase {
@@ -35,6 +36,8 @@ public:
 
     ~CrnnPostProcessDptr() = default;
 
+    APP_ERROR InitDecoder();
+
     void TextGenerationOutput(const std::vector<TensorBase> &tensors, std::vector<TextsInfo> &textsInfos);
 
     APP_ERROR CheckAndMoveTensors(std::vector<TensorBase> &tensors);
@@ -51,6 +54,9 @@ public:
     uint32_t objectNum_ = 0;
     uint32_t blankIdx_ = 0;
     bool withArgmax_ = false;
+    CtcBeamConfig beamConfig_ = {1, 0.001f, true};
+    std::string lexiconPath_ = "";
+    CtcDecoder decoder_ = {};
     CrnnPostProcess* qPtr_ = nullptr;
 };
 
@@ -71,9 +77,33 @@ CrnnPostProcessDptr& CrnnPostProcessDptr::operator=(const CrnnPostProcessDptr &o
     objectNum_ = other.objectNum_;
     blankIdx_ = other.blankIdx_;
     withArgmax_ = other.withArgmax_;
+    beamConfig_ = other.beamConfig_;
+    lexiconPath_ = other.lexiconPath_;
+    decoder_ = other.decoder_;
     return *this;
 }
 
+APP_ERROR CrnnPostProcessDptr::InitDecoder()
+{
+    APP_ERROR ret = decoder_.Init((qPtr_->configData_).GetClassNames(), blankIdx_);
+    if (ret != APP_ERR_OK) {
+        LogError << "Fail to init the ctc decoder." << GetErrorInfo(ret);
+        return ret;
+    }
+    if (lexiconPath_.empty()) {
+        return APP_ERR_OK;
+    }
+    if (withArgmax_) {
+        LogWarn << "The lexicon is not used when WITH_ARGMAX is true, as the model outputs no class scores.";
+        return APP_ERR_OK;
+    }
+    ret = decoder_.LoadLexicon(lexiconPath_);
+    if (ret != APP_ERR_OK) {
+        LogError << "Fail to load the lexicon of the ctc decoder." << GetErrorInfo(ret);
+    }
+    return ret;
+}
+
 void CrnnPostProcessDptr::TextGenerationOutput(const std::vector<TensorBase> &tensors,
     std::vector<TextsInfo> &textsInfos)
 {
@@ -96,7 +126,6 @@ void CrnnPostProcessDptr::TextGenerationOutput(const std::vector<TensorBase> &te
     }
     LogDebug << "CrnnPostProcess end to write results.";
 }
-
 bool CrnnPostProcessDptr::IsValidTensors(const std::vector <TensorBase> &tensors) const
 {
     if (tensors.size() != 1) {
@@ -109,9 +138,10 @@ bool CrnnPostProcessDptr::IsValidTensors(const std::vector <TensorBase> &tensors
     // The output tensors of model with no argmax layer have one more dimension.
     if (!withArgmax_) {
         for (size_t i = 0; i < tensors.size(); i++) {
-            if (tensors[i].GetDataTypeSize() != qPtr_->FOUR_BYTE) {
+            if (tensors[i].GetDataTypeSize() != qPtr_->FOUR_BYTE &&
+                tensors[i].GetDataType() != TENSOR_DTYPE_FLOAT16) {
                 LogError << "The tensor type(" << TensorDataTypeStr[tensors[i].GetTensorType()]
-                         << ") mismatched. requires(" << qPtr_->FOUR_BYTE << ") bytes tensortype."
+                         << ") mismatched. requires(" << qPtr_->FOUR_BYTE << ") bytes or float16 tensortype."
                          << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
                 return false;
             }
@@ -163,48 +193,52 @@ APP_ERROR CrnnPostProcessDptr::CheckAndMoveTensors(std::vector<TensorBase> &tens
 std::string CrnnPostProcessDptr::CalcOutputArgmax(TensorBase &tensor, uint32_t batchNum)
 {
     LogDebug << "Start to Process CalcOutputArgmax.";
-    float *outputInfo = (float *)(qPtr_->GetBuffer)(tensor, batchNum);
+    const void *outputInfo = (qPtr_->GetBuffer)(tensor, batchNum);
     if (outputInfo == nullptr) {
         LogError << "The outputInfo is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
         return "";
     }
-    std::vector<float> logits;
-    uint32_t previousIdx = blankIdx_;
-    std::string result = "";
-    for (uint32_t i = 0; i < objectNum_; i++) {
-        for (uint32_t j = 0; j < (qPtr_->classNum_); j++) {
-            logits.push_back(outputInfo[i * (qPtr_->classNum_) + j]);
-        }
-        auto maxElement = std::max_element(std::begin(logits), std::end(logits));
-        uint32_t argmaxIndex = (uint32_t)(maxElement - std::begin(logits));
-        if (argmaxIndex != blankIdx_ && argmaxIndex != previousIdx) {
-            result += (qPtr_->configData_).GetClassName(argmaxIndex);
-        }
-        previousIdx = argmaxIndex;
-        logits.clear();
+    CtcLogits logits;
+    logits.data = outputInfo;
+    logits.dataType = tensor.GetDataType() == TENSOR_DTYPE_FLOAT16 ? TENSOR_DTYPE_FLOAT16 : TENSOR_DTYPE_FLOAT32;
+    logits.timeStep = objectNum_;
+    logits.classNum = qPtr_->classNum_;
+    size_t elemSize = logits.dataType == TENSOR_DTYPE_FLOAT16 ? qPtr_->TWO_BYTE : qPtr_->FOUR_BYTE;
+    if (static_cast<size_t>(objectNum_) * qPtr_->classNum_ * elemSize > tensor.GetByteSize() / tensor.GetShape()[0]) {
+        LogError << "The tensor is smaller than objectNum(" << objectNum_ << ") x classNum(" << qPtr_->classNum_
+                 << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return "";
+    }
+    std::vector<std::string> texts;
+    APP_ERROR ret = decoder_.BeamSearchDecode(logits, beamConfig_, texts);
+    if (ret != APP_ERR_OK) {
+        LogError << "Fail to decode the ctc logits." << GetErrorInfo(ret);
+        return "";
     }
     LogDebug << "End to Process CalcOutputArgmax.";
-    return result;
+    return texts[0];
 }
 
 std::string CrnnPostProcessDptr::CalcOutputIndex(TensorBase &tensor, uint32_t batchNum)
 {
     LogDebug << "Start to Process CalcOutputIndex.";
-    long long int *objectInfo = (long long int *)(qPtr_->GetBuffer)(tensor, batchNum);
+    const int64_t *objectInfo = (const int64_t *)(qPtr_->GetBuffer)(tensor, batchNum);
     if (objectInfo == nullptr) {
         LogError << "The objectInfo is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
         return "";
     }
-    long long int previousIdx = blankIdx_;
-    std::string result = "";
-    for (uint32_t i = 0; i < objectNum_; i++) {
-        if (objectInfo[i] != blankIdx_ && objectInfo[i] != previousIdx) {
-            result += (qPtr_->configData_).GetClassName(objectInfo[i]);
-        }
-        previousIdx = objectInfo[i];
+    // with a malformed shape the ids of the last images would be read past the end of the tensor
+    size_t imageOffset = static_cast<size_t>(batchNum) * (tensor.GetByteSize() / tensor.GetShape()[0]);
+    size_t idNum = (tensor.GetByteSize() - imageOffset) / sizeof(int64_t);
+    uint32_t timeStep = static_cast<uint32_t>(std::min<size_t>(objectNum_, idNum));
+    std::vector<std::string> texts;
+    APP_ERROR ret = decoder_.GreedyDecode(objectInfo, 1, timeStep, texts);
+    if (ret != APP_ERR_OK) {
+        LogError << "Fail to decode the class ids." << GetErrorInfo(ret);
+        return "";
     }
     LogDebug << "End to Process CalcOutputIndex.";
-    return result;
+    return texts[0];
 }
 }
 #endif
@@ -111,19 +111,18 @@ private:
     bool CalcOverLaps(const int &index1, const int &index2, const std::vector<std::vector<float>> &textProposals);
 
     void BuildGraph(const std::vector<std::vector<float>> &textProposals, const std::vector<float> &scores,
-        const ResizedImageInfo &resizedImageInfo, std::vector<std::vector<bool>> &graph);
+        const ResizedImageInfo &resizedImageInfo);
 
-    void GetSuccessions(const std::vector<std::vector<float>> &textProposals,
-        const std::vector<std::vector<int>> &boxesTable, const ResizedImageInfo &resizedImageInfo,
-        const int &index, std::vector<int> &successions);
+    int GetSuccession(const std::vector<std::vector<float>> &textProposals, const std::vector<float> &scores,
+        const ResizedImageInfo &resizedImageInfo, const int &index);
 
-    void GetPrecursors(const std::vector<std::vector<float>> &textProposals,
-        const std::vector<std::vector<int>> &boxesTable, const int &successionIdx, const int &index,
-        std::vector<int> &precursors);
+    bool GetPrecursorScore(const std::vector<std::vector<float>> &textProposals, const std::vector<float> &scores,
+        const int &successionIdx, const int &index, float &precursorScoreMax);
+
+    void GetSubGraph();
 
     void GetTextLines(const std::vector<std::vector<float>> &textProposals, const std::vector<float> &scores,
-        const std::vector<std::vector<int>> &subGraphs, const ResizedImageInfo &resizedImageInfos,
-        std::vector<TextObjectInfo> &textRecs);
+        const ResizedImageInfo &resizedImageInfos, std::vector<TextObjectInfo> &textRecs);
 
     bool FilterBoxesFinal(TextObjectInfo textObjDetectInfo);
 
@@ -155,6 +154,17 @@ private:
     void GetInfo(std::vector<std::vector<float>> &textLineBoxes, std::vector<float> &textLineBoxesX0,
                  std::vector<float> &textLineBoxesX1, std::vector<float> &textLineBoxesY0,
                  std::vector<float> &textLineBoxesY1) const;
+
+    // Scratch buffers of the text proposal graph, reused across images. The proposals are bucketed by the column
+    // of their left edge, the boxes of column c are columnBoxes_[columnOffsets_[c], columnOffsets_[c + 1]).
+    std::vector<int> columnOffsets_;
+    std::vector<int> columnBoxes_;
+    // every proposal is linked to at most one succession on its right, -1 when it has none
+    std::vector<int> successions_;
+    std::vector<uint8_t> hasPrecursor_;
+    // the proposals of text line l are lineBoxes_[lineOffsets_[l], lineOffsets_[l + 1])
+    std::vector<int> lineOffsets_;
+    std::vector<int> lineBoxes_;
 };
 
 CtpnPostProcessDptr::CtpnPostProcessDptr(CtpnPostProcess* pCtpnPostProcess)
@@ -195,17 +205,6 @@ CtpnPostProcessDptr& CtpnPostProcessDptr::operator=(const CtpnPostProcessDptr &o
     return *this;
 }
 
-bool GetConncectY(const std::vector<std::vector<bool>> &graph, int connectX, int &connectY)
-{
-    for (size_t y = 0; y < graph[0].size(); y++) {
-        if (graph[connectX][y]) {
-            connectY = int(y);
-            return true;
-        }
-    }
-    return false;
-}
-
 bool CtpnPostProcessDptr::IsValidTensors(const std::vector<TensorBase> &tensors) const
 {
     LogDebug << "Start to check the output tensor of model";
@@ -258,40 +257,20 @@ APP_ERROR CtpnPostProcessDptr::CheckAndMoveTensors(std::vector<TensorBase> &tens
     return qPtr_->CheckAndMoveTensors(tensors);
 }
 
-void GetSubGraph(std::vector<std::vector<bool>> &graph, std::vector<std::vector<int>> &subGraphs)
+void CtpnPostProcessDptr::GetSubGraph()
 {
-    std::vector<int> nonByConnects;
-    for (size_t j = 0; j < graph.size(); j++) {
-        bool nonByConnectLabel = true;
-        for (size_t i = 0; i < graph[0].size(); i++) {
-            if (graph[i][j]) {
-                nonByConnectLabel = false;
-                break;
-            }
-        }
-        if (nonByConnectLabel) {
-            nonByConnects.push_back(j);
-        }
-    }
-    // Get connect left index
-    std::vector<int> connects;
-    for (auto nonByConnectIdx : nonByConnects) {
-        for (size_t k = 0; k < graph[0].size(); k++) {
-            if (graph[nonByConnectIdx][k]) {
-                connects.push_back(nonByConnectIdx);
-                break;
-            }
+    // A text line starts at a proposal that has a succession but no precursor and follows the successions. The
+    // successions always lie on the right, so the chains end and the whole walk is linear in the line lengths.
+    lineOffsets_.assign(1, 0);
+    lineBoxes_.clear();
+    for (size_t start = 0; start < successions_.size(); start++) {
+        if (hasPrecursor_[start] != 0 || successions_[start] < 0) {
+            continue;
         }
-    }
-    // Get connect right index
-    for (auto connectX : connects) {
-        std::vector<int> connectTemp = { connectX };
-        subGraphs.push_back(connectTemp);
-        int connectY;
-        while (GetConncectY(graph, connectX, connectY)) {
-            subGraphs.back().push_back(connectY);
-            connectX = connectY;
+        for (int index = static_cast<int>(start); index >= 0; index = successions_[index]) {
+            lineBoxes_.push_back(index);
         }
+        lineOffsets_.push_back(static_cast<int>(lineBoxes_.size()));
     }
 }
 
@@ -311,6 +290,8 @@ void CtpnPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorBase> &t
     for (uint32_t i = 0; i < batchSize; i++) {
         std::vector<TextObjectInfo> textObjInfo;
         ResizedImageInfo resizedImageInfo = resizedImageInfos[i];
+        textProposals.clear();
+        scores.clear();
         if (i < qPtr_->cropRoiBoxes_.size()) {
             resizedImageInfo.widthOriginal =
                 static_cast<uint32_t>(qPtr_->cropRoiBoxes_[i].x1 - qPtr_->cropRoiBoxes_[i].x0);
@@ -337,15 +318,12 @@ void CtpnPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorBase> &t
             inputInfo.wholeImgAnchors = &wholeImgAnchors;
             NonMaxSuppression(inputInfo, i, textProposals, scores);
         }
-        // 4. Create graph, the value is bool. The value true show the two index box connect each other.
-        size_t proposalSize = textProposals.size();
-        std::vector<std::vector<bool>> graph(proposalSize, std::vector<bool>(proposalSize, false));
-        BuildGraph(textProposals, scores, resizedImageInfo, graph);
+        // 4. Create graph, every proposal is linked to the succession it connects to.
+        BuildGraph(textProposals, scores, resizedImageInfo);
         // 5. Get connective proposals from graph
-        std::vector<std::vector<int>> subGraphs;
-        GetSubGraph(graph, subGraphs);
+        GetSubGraph();
         // 6. Fit box's y and get final box location
-        GetTextLines(textProposals, scores, subGraphs, resizedImageInfo, textObjInfo);
+        GetTextLines(textProposals, scores, resizedImageInfo, textObjInfo);
         LogDebug << "Number of objects found : " << textObjInfo.size();
         GetTextObjInfoResult(resizedImageInfo, textObjInfo, i);
         textObjInfos.push_back(textObjInfo);
@@ -610,92 +588,102 @@ bool CtpnPostProcessDptr::CalcOverLaps(const int &index1, const int &index2,
     return (overLaps >= minOverLaps_ && similarity >= minSizeSim_);
 }
 
-void CtpnPostProcessDptr::GetSuccessions(const std::vector<std::vector<float>> &textProposals,
-    const std::vector<std::vector<int>> &boxesTable, const ResizedImageInfo &resizedImageInfo,
-    const int &index, std::vector<int> &successions)
+int CtpnPostProcessDptr::GetSuccession(const std::vector<std::vector<float>> &textProposals,
+    const std::vector<float> &scores, const ResizedImageInfo &resizedImageInfo, const int &index)
 {
-    // Get positive connective anchors
-    std::vector<float> box = textProposals[index];
+    // Get positive connective anchors, the one of max score in the nearest column on the right
+    const std::vector<float> &box = textProposals[index];
     int leftMaxIdx = std::min((uint32_t)box[LEFTTOPX] + maxHorizontalGap_ + 1, resizedImageInfo.widthResize);
-    for (auto left = static_cast<int>(box[LEFTTOPX]) + 1; left >=0 && left < leftMaxIdx; left++) {
-        std::vector<int> adjBoxIndices = boxesTable[left];
-        for (auto adjBoxIndex : adjBoxIndices) {
-            if (CalcOverLaps(adjBoxIndex, index, textProposals)) {
-                successions.push_back(adjBoxIndex);
+    for (auto left = static_cast<int>(box[LEFTTOPX]) + 1; left >= 0 && left < leftMaxIdx; left++) {
+        int successionIdx = -1;
+        float successionScoreMax = INTMAX_MIN;
+        for (int k = columnOffsets_[left]; k < columnOffsets_[left + 1]; k++) {
+            int adjBoxIndex = columnBoxes_[k];
+            if (CalcOverLaps(adjBoxIndex, index, textProposals) && scores[adjBoxIndex] > successionScoreMax) {
+                successionIdx = adjBoxIndex;
+                successionScoreMax = scores[adjBoxIndex];
             }
         }
-        if (!successions.empty()) {
-            return;
+        if (successionIdx >= 0) {
+            return successionIdx;
         }
     }
+    return -1;
 }
 
-void CtpnPostProcessDptr::GetPrecursors(const std::vector<std::vector<float>> &textProposals,
-    const std::vector<std::vector<int>> &boxesTable, const int &successionIdx, const int &index,
-    std::vector<int> &precursors)
+bool CtpnPostProcessDptr::GetPrecursorScore(const std::vector<std::vector<float>> &textProposals,
+    const std::vector<float> &scores, const int &successionIdx, const int &index, float &precursorScoreMax)
 {
-    // Get negative connective anchors
-    std::vector<float> box = textProposals[successionIdx];
+    // Get negative connective anchors, the max score in the nearest column on the left
+    const std::vector<float> &box = textProposals[successionIdx];
     int leftMaxNegIdx = std::max((int)box[LEFTTOPX] - maxHorizontalGap_, 0) - 1;
+    const int columnNum = static_cast<int>(columnOffsets_.size()) - 1;
+    bool found = false;
+    precursorScoreMax = INTMAX_MIN;
     for (auto left = (int)box[LEFTTOPX] - 1; left > leftMaxNegIdx; left--) {
-        std::vector<int> adjBoxIndices = boxesTable[left];
-        for (auto adjBoxIndex : adjBoxIndices) {
+        if (left >= columnNum) {
+            continue;
+        }
+        for (int k = columnOffsets_[left]; k < columnOffsets_[left + 1]; k++) {
+            int adjBoxIndex = columnBoxes_[k];
             if (CalcOverLaps(adjBoxIndex, index, textProposals)) {
-                precursors.push_back(adjBoxIndex);
+                precursorScoreMax = std::max(precursorScoreMax, scores[adjBoxIndex]);
+                found = true;
             }
         }
-        if (!precursors.empty()) {
-            return;
+        if (found) {
+            return true;
         }
     }
+    return false;
 }
 
 void CtpnPostProcessDptr::BuildGraph(const std::vector<std::vector<float>> &textProposals,
-    const std::vector<float> &scores, const ResizedImageInfo &resizedImageInfo, std::vector<std::vector<bool>> &graph)
+    const std::vector<float> &scores, const ResizedImageInfo &resizedImageInfo)
 {
-    // Put index into boxes table of x0 value of proposal, it's like histogram.
-    std::vector<std::vector<int>> boxesTable(resizedImageInfo.widthResize, std::vector<int>());
-    int boxesTableIdx = 0;
+    // Put index into boxes table of x0 value of proposal, it's like histogram. A counting sort keeps the boxes of a
+    // column in index order.
+    const uint32_t columnNum = resizedImageInfo.widthResize;
+    const int boxesSize = (int)textProposals.size();
+    columnOffsets_.assign(columnNum + 1, 0);
     for (const auto &textProposal : textProposals) {
         auto tableIndex = static_cast<uint32_t>(textProposal[LEFTTOPX]);
-        if (tableIndex < resizedImageInfo.widthResize) {
-            boxesTable[tableIndex].push_back(boxesTableIdx);
+        if (tableIndex < columnNum) {
+            columnOffsets_[tableIndex + 1]++;
+        }
+    }
+    for (uint32_t column = 0; column < columnNum; column++) {
+        columnOffsets_[column + 1] += columnOffsets_[column];
+    }
+    columnBoxes_.resize(columnOffsets_[columnNum]);
+    for (auto index = 0; index < boxesSize; index++) {
+        auto tableIndex = static_cast<uint32_t>(textProposals[index][LEFTTOPX]);
+        if (tableIndex < columnNum) {
+            columnBoxes_[columnOffsets_[tableIndex]++] = index;
         }
-        boxesTableIdx++;
     }
-    int boxesSize = (int)textProposals.size();
+    // the fill moved every offset to the end of its column, shift them back
+    for (uint32_t column = columnNum; column > 0; column--) {
+        columnOffsets_[column] = columnOffsets_[column - 1];
+    }
+    columnOffsets_[0] = 0;
+
+    successions_.assign(boxesSize, -1);
+    hasPrecursor_.assign(boxesSize, 0);
     for (auto index = 0; index < boxesSize; index++) {
-        std::vector<int> successions;
         // Get succession connective anchors
-        GetSuccessions(textProposals, boxesTable, resizedImageInfo, index, successions);
-        if (successions.empty()) {
+        int successionIdx = GetSuccession(textProposals, scores, resizedImageInfo, index);
+        if (successionIdx < 0) {
             continue;
         }
-        // Get the index of max score from successions
-        int successionIdx = 0;
-        float successionScoreMax = INTMAX_MIN;
-        for (auto succession : successions) {
-            if (scores[succession] > successionScoreMax) {
-                successionIdx = succession;
-                successionScoreMax = scores[succession];
-            }
-        }
-
         // Get precursors connective anchors
-        std::vector<int> precursors;
-        GetPrecursors(textProposals, boxesTable, successionIdx, index, precursors);
-        if (precursors.empty()) {
+        float precursorScoreMax = 0;
+        if (!GetPrecursorScore(textProposals, scores, successionIdx, index, precursorScoreMax)) {
             continue;
         }
-        // Get the index of max score from negative successions
-        float precursorScoreMax = INTMAX_MIN;
-        for (auto precursor : precursors) {
-            if (scores[precursor] > precursorScoreMax) {
-                precursorScoreMax = scores[precursor];
-            }
-        }
         if (scores[index] >= precursorScoreMax) {
-            graph[index][successionIdx] = true;
+            successions_[index] = successionIdx;
+            hasPrecursor_[successionIdx] = 1;
         }
     }
 }
@@ -799,13 +787,13 @@ bool CtpnPostProcessDptr::FilterBoxesFinal(TextObjectInfo textObjDetectInfo)
 }
 
 void CtpnPostProcessDptr::GetTextLines(const std::vector<std::vector<float>> &textProposals,
-    const std::vector<float> &scores, const std::vector<std::vector<int>> &subGraphs,
-    const ResizedImageInfo &resizedImageInfos, std::vector<TextObjectInfo> &textRecs)
+    const std::vector<float> &scores, const ResizedImageInfo &resizedImageInfos, std::vector<TextObjectInfo> &textRecs)
 {
-    for (const auto &subGraph : subGraphs) {
+    for (size_t line = 0; line + 1 < lineOffsets_.size(); line++) {
         std::vector<std::vector<float>> textLineBoxes;
         std::vector<float> textBoxesScores;
-        for (auto index : subGraph) {
+        for (int k = lineOffsets_[line]; k < lineOffsets_[line + 1]; k++) {
+            int index = lineBoxes_[k];
             textLineBoxes.push_back(textProposals[index]);
             textBoxesScores.push_back(scores[index]);
         }
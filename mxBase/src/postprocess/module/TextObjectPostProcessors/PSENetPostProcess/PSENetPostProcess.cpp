@@ -47,6 +47,7 @@ PSENetPostProcess &PSENetPostProcess::operator = (const PSENetPostProcess &other
     dPtr_->min_score_ = other.dPtr_->min_score_;
     dPtr_->min_area_ = other.dPtr_->min_area_;
     dPtr_->kernel_num_ = other.dPtr_->kernel_num_;
+    dPtr_->labelThreadNum_ = other.dPtr_->labelThreadNum_;
     dPtr_->objectNumTensor_ = other.dPtr_->objectNumTensor_;
     return *this;
 }
@@ -114,6 +115,10 @@ APP_ERROR PSENetPostProcess::Init(const std::map<std::string, std::string> &post
         LogWarn << GetErrorInfo(ret)
                 << "Fail to read " << KERNEL_NUM << " from config, default is: " << dPtr_->kernel_num_;
     }
+    ret = configData_.GetFileValue<uint32_t>("LABEL_THREAD_NUM", dPtr_->labelThreadNum_, 1, MAX_LABEL_THREAD_NUM);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Fail to read LABEL_THREAD_NUM from config, default is: " << dPtr_->labelThreadNum_;
+    }
     LogInfo << "End to initialize PSENetPostProcess.";
     isInitConfig_ = true;
     return APP_ERR_OK;
@@ -23,6 +23,9 @@
 #ifndef PSENETPOSTPROCESS_DPTR_H
 #define PSENETPOSTPROCESS_DPTR_H
 
+#include <algorithm>
+#include <climits>
+#include <thread>
 #include "TextObjectPostProcessors/PSENetPostProcess.h"
 #include "MxBase/GlobalManager/GlobalManager.h"
 
@@ -33,9 +36,22 @@ const int DIRECT_NUM = 4;
 const int KERNEL_DIM = 1;
 const int HEIGHT_DIM = 2;
 const int WEIGHT_DIM = 3;
+const int MAX_KERNEL_NUM = 32;
+const uint32_t MAX_LABEL_THREAD_NUM = 64;
+const uint32_t MIN_LABEL_BAND_ROWS = 16;
+const int32_t BACKGROUND_PIXEL = -1;
 }
 
 namespace MxBase {
+// Statistics of one text line, area and rows are accumulated while labelling and expanding.
+struct TextLineStat {
+    uint32_t area = 0;
+    int32_t top = INT_MAX;
+    int32_t bottom = -1;
+    int32_t spanBegin = -1;     // first row span of a text line large enough to be boxed
+    float scoreSum = 0.f;
+};
+
 class SDK_UNAVAILABLE_FOR_OTHER PSENetPostProcessDptr {
 public:
     explicit PSENetPostProcessDptr(PSENetPostProcess* qPtr);
@@ -49,33 +65,41 @@ public:
     APP_ERROR ObjectDetectionOutput(const std::vector<TensorBase> &tensors,
         std::vector<std::vector<TextObjectInfo>> &textObjInfos, const std::vector<ResizedImageInfo> &resizedImageInfos);
 
-    static void Pse(const std::vector<std::vector<std::vector<unsigned int>>> &kernels, const float &minAreaPse,
-        std::vector<std::vector<int>> &textLine);
+    APP_ERROR GetKernelMask(const std::vector<TensorBase> &tensors, const int &i, const float *&textMap);
 
-    static void GetKernelsMat(const std::vector<std::vector<std::vector<unsigned int>>> &kernels,
-        std::vector<cv::Mat> &kernelsMat);
+    void Pse(const float &minAreaPse);
 
-    static void GrowingTextLine(const std::vector<cv::Mat> &kernelsMat, const float &minAreaPse,
-        std::vector<std::vector<int>> &textLine);
+    void LabelMinKernel(uint32_t kernelBit);
 
-    static void BfsForTextLine(const std::vector<cv::Mat> &kernelsMat, std::queue<cv::Point> curQueue,
-        std::vector<std::vector<int>> &textLine);
+    uint32_t SeedTextLines(const float &minAreaPse);
 
-    void GenerateBoxes(const std::vector<std::vector<int>> &textLine, const std::vector<std::vector<float>> &score,
-        const ResizedImageInfo &resizedImageInfos, std::vector<TextObjectInfo> &textObjInfos) const;
+    void ExpandTextLines(uint32_t seedNum);
 
-    APP_ERROR GetSrcData(const std::vector<TensorBase> &tensors, const int &i,
-        std::vector<std::vector<std::vector<unsigned int>>> &kernels, std::vector<std::vector<float>> &score) const;
+    void GenerateBoxes(const float *textMap, const ResizedImageInfo &resizedImageInfos,
+        std::vector<TextObjectInfo> &textObjInfos);
 
     float min_kernel_area_ = .0f;
     float pse_scale_ = .0f;
     float min_score_ = .0f;
     float min_area_ = .0f;
     int kernel_num_ = 0;
+    uint32_t labelThreadNum_ = 1;
 
 public:
     PSENetPostProcess *qPtr_ = nullptr;
     int objectNumTensor_ = DEFAULT_OBJECT_NUM_TENSOR;
+
+private:
+    // bit t of a pixel is set when the pixel is in kernel t, kernel 0 is the whole text region
+    std::vector<uint32_t> kernelMask_;
+    // union find parents while labelling the smallest kernel, text line labels afterwards, 0 is background
+    std::vector<int32_t> labels_;
+    // ring queue of pixel indexes for the expansion, never holds more than one entry per pixel
+    std::vector<uint32_t> queue_;
+    std::vector<TextLineStat> stats_;
+    std::vector<int32_t> spanLeft_;
+    std::vector<int32_t> spanRight_;
+    std::vector<cv::Point> hullPoints_;
 };
 
 PSENetPostProcessDptr::PSENetPostProcessDptr(PSENetPostProcess* qPtr)
@@ -120,152 +144,278 @@ APP_ERROR PSENetPostProcessDptr::CheckAndMoveTensors(std::vector<TensorBase> &te
     return qPtr_->CheckAndMoveTensors(tensors);
 }
 
-void SetCurQueue(const std::vector<cv::Mat> &kernelsMat, const int &kernelId, std::vector<std::vector<int>> &textLine,
-    std::queue<cv::Point> &curQueue, bool &isEdge)
+namespace {
+// the label, mask and queue buffers have a one pixel border of background, so neighbours never leave the buffers
+const int32_t PADDED_WIDTH = MODEL_OUTPUT_WIDTH + 2;
+const size_t PADDED_SIZE = static_cast<size_t>(MODEL_OUTPUT_HEIGHT + 2) * PADDED_WIDTH;
+
+inline int32_t PaddedPixel(int y, int x)
 {
-    std::vector<int> dx = { -1, 1, 0, 0 };
-    std::vector<int> dy = { 0, 0, -1, 1 };
-    cv::Point point = curQueue.front();
-    curQueue.pop();
-    int x = point.x;
-    int y = point.y;
-    int label = textLine[x][y];
-    for (int d = 0; d < DIRECT_NUM; ++d) {
-        int tmpX = x + dx[d];
-        int tmpY = y + dy[d];
-        if (tmpX < 0 || tmpX >= (int)textLine.size()) {
-            continue;
-        }
-        if (tmpY < 0 || tmpY >= (int)textLine[1].size()) {
-            continue;
-        }
-        if (kernelsMat[kernelId].at<char>(tmpX, tmpY) == 0) {
-            continue;
-        }
-        if (textLine[tmpX][tmpY] > 0) {
-            continue;
+    return (y + 1) * PADDED_WIDTH + x + 1;
+}
+
+// path halving keeps every parent smaller than its child, so the root of a component is its first pixel
+int32_t FindRoot(int32_t *parents, int32_t pixel)
+{
+    while (parents[pixel] != pixel) {
+        parents[pixel] = parents[parents[pixel]];
+        pixel = parents[pixel];
+    }
+    return pixel;
+}
+
+void UnionPixels(int32_t *parents, int32_t first, int32_t second)
+{
+    first = FindRoot(parents, first);
+    second = FindRoot(parents, second);
+    if (first < second) {
+        parents[second] = first;
+    } else if (second < first) {
+        parents[first] = second;
+    }
+}
+
+void LabelBand(const uint32_t *kernelMask, uint32_t kernelBit, int32_t *parents, int rowBegin, int rowEnd)
+{
+    for (int y = rowBegin; y < rowEnd; ++y) {
+        int32_t pixel = PaddedPixel(y, 0);
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; ++x, ++pixel) {
+            if ((kernelMask[pixel] & kernelBit) == 0) {
+                parents[pixel] = BACKGROUND_PIXEL;
+                continue;
+            }
+            parents[pixel] = pixel;
+            if (x > 0 && parents[pixel - 1] != BACKGROUND_PIXEL) {
+                UnionPixels(parents, pixel, pixel - 1);
+            }
+            if (y > rowBegin && parents[pixel - PADDED_WIDTH] != BACKGROUND_PIXEL) {
+                UnionPixels(parents, pixel, pixel - PADDED_WIDTH);
+            }
         }
-        cv::Point pointTmp(tmpX, tmpY);
-        curQueue.push(pointTmp);
-        textLine[tmpX][tmpY] = label;
-        isEdge = false;
     }
 }
+}
 
-void PSENetPostProcessDptr::BfsForTextLine(const std::vector<cv::Mat> &kernelsMat, std::queue<cv::Point> curQueue,
-    std::vector<std::vector<int>> &textLine)
+APP_ERROR PSENetPostProcessDptr::GetKernelMask(const std::vector<TensorBase> &tensors, const int &i,
+    const float *&textMap)
 {
-    std::queue<cv::Point> nextQueue;
-    for (int kernelId = (int)kernelsMat.size() - 0x2; kernelId >= 0; --kernelId) {
-        while (!curQueue.empty()) {
-            bool isEdge = true;
-            cv::Point point = curQueue.front();
-            SetCurQueue(kernelsMat, kernelId, textLine, curQueue, isEdge);
-            if (isEdge) {
-                nextQueue.push(point);
+    const float *kernelsPtr = (const float *)qPtr_->GetBuffer(tensors[objectNumTensor_], i);
+    if (kernelsPtr == nullptr) {
+        LogError << "The kernelsPtr is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
+        return APP_ERR_COMM_INVALID_POINTER;
+    }
+    const size_t planeSize = static_cast<size_t>(MODEL_OUTPUT_HEIGHT) * MODEL_OUTPUT_WIDTH;
+    // the border is zeroed once here and never written afterwards
+    kernelMask_.resize(PADDED_SIZE, 0);
+    textMap = kernelsPtr;
+    for (int y = 0; y < MODEL_OUTPUT_HEIGHT; y++) {
+        uint32_t *mask = &kernelMask_[PaddedPixel(y, 0)];
+        const float *text = kernelsPtr + static_cast<size_t>(y) * MODEL_OUTPUT_WIDTH;
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; x++) {
+            mask[x] = static_cast<uint32_t>(text[x] > 1.f);
+        }
+        // a pixel is in kernel t when both its kernel t and its text region outputs are above 1
+        for (int t = 1; t < kernel_num_; t++) {
+            const float *kernel = text + t * planeSize;
+            for (int x = 0; x < MODEL_OUTPUT_WIDTH; x++) {
+                mask[x] |= static_cast<uint32_t>((mask[x] & 1u) & (kernel[x] > 1.f)) << t;
             }
         }
-        swap(curQueue, nextQueue);
     }
+    return APP_ERR_OK;
 }
 
-void PSENetPostProcessDptr::GrowingTextLine(const std::vector<cv::Mat> &kernelsMat, const float &minAreaPse,
-    std::vector<std::vector<int>> &textLine)
+void PSENetPostProcessDptr::LabelMinKernel(uint32_t kernelBit)
 {
-    cv::Mat labelMat;
-    int labelNum = cv::connectedComponents(kernelsMat[kernelsMat.size() - 1], labelMat, DIRECT_NUM);
-    LogDebug << "label num: " << labelNum;
-    std::vector<int> area(labelNum + 1, 0);
-    for (int x = 0; x < labelMat.rows; ++x) {
-        for (int y = 0; y < labelMat.cols; ++y) {
-            int label = labelMat.at<int>(x, y);
-            if (label == 0) {
+    labels_.resize(PADDED_SIZE, 0);
+    uint32_t bandNum = std::max(1u, std::min({labelThreadNum_, MAX_LABEL_THREAD_NUM,
+        MODEL_OUTPUT_HEIGHT / MIN_LABEL_BAND_ROWS}));
+    int bandRows = (MODEL_OUTPUT_HEIGHT + static_cast<int>(bandNum) - 1) / static_cast<int>(bandNum);
+    const uint32_t *kernelMask = kernelMask_.data();
+    int32_t *parents = labels_.data();
+    std::vector<std::thread> threads;
+    for (int begin = bandRows; begin < MODEL_OUTPUT_HEIGHT; begin += bandRows) {
+        threads.emplace_back(LabelBand, kernelMask, kernelBit, parents, begin,
+            std::min(MODEL_OUTPUT_HEIGHT, begin + bandRows));
+    }
+    LabelBand(kernelMask, kernelBit, parents, 0, std::min(MODEL_OUTPUT_HEIGHT, bandRows));
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    // merge the components across the band borders
+    for (int begin = bandRows; begin < MODEL_OUTPUT_HEIGHT; begin += bandRows) {
+        int32_t pixel = PaddedPixel(begin, 0);
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; ++x, ++pixel) {
+            if (parents[pixel] != BACKGROUND_PIXEL && parents[pixel - PADDED_WIDTH] != BACKGROUND_PIXEL) {
+                UnionPixels(parents, pixel, pixel - PADDED_WIDTH);
+            }
+        }
+    }
+    // parents always precede their children, so one raster pass turns them into labels in first pixel order,
+    // the same numbering as cv::connectedComponents
+    stats_.assign(1, TextLineStat());
+    for (int y = 0; y < MODEL_OUTPUT_HEIGHT; ++y) {
+        int32_t pixel = PaddedPixel(y, 0);
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; ++x, ++pixel) {
+            int32_t parent = parents[pixel];
+            if (parent == BACKGROUND_PIXEL) {
+                parents[pixel] = 0;
                 continue;
             }
-            area[label] += 1;
+            if (parent == pixel) {
+                parents[pixel] = static_cast<int32_t>(stats_.size());
+                stats_.emplace_back();
+            } else {
+                parents[pixel] = parents[parent];
+            }
+            stats_[parents[pixel]].area++;
+        }
+    }
+}
+
+uint32_t PSENetPostProcessDptr::SeedTextLines(const float &minAreaPse)
+{
+    for (auto &stat : stats_) {
+        if (stat.area < minAreaPse) {
+            stat.area = 0;
         }
     }
-    std::queue<cv::Point> curQueue;
-    for (int x = 0; x < labelMat.rows; ++x) {
-        std::vector<int> row(labelMat.cols);
-        for (int y = 0; y < labelMat.cols; ++y) {
-            int label = labelMat.at<int>(x, y);
+    queue_.resize(PADDED_SIZE);
+    uint32_t seedNum = 0;
+    for (int y = 0; y < MODEL_OUTPUT_HEIGHT; ++y) {
+        int32_t pixel = PaddedPixel(y, 0);
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; ++x, ++pixel) {
+            int32_t label = labels_[pixel];
             if (label == 0) {
                 continue;
             }
-            if (area[label] < minAreaPse) {
+            TextLineStat &stat = stats_[label];
+            if (stat.area == 0) {
+                labels_[pixel] = 0;
                 continue;
             }
-            cv::Point point(x, y);
-            curQueue.push(point);
-            row[y] = label;
+            stat.top = std::min(stat.top, y);
+            stat.bottom = y;
+            queue_[seedNum++] = static_cast<uint32_t>(pixel);
         }
-        textLine.emplace_back(row);
     }
-    BfsForTextLine(kernelsMat, curQueue, textLine);
+    return seedNum;
 }
 
-void PSENetPostProcessDptr::GetKernelsMat(const std::vector<std::vector<std::vector<unsigned int>>> &kernels,
-    std::vector<cv::Mat> &kernelsMat)
+void PSENetPostProcessDptr::ExpandTextLines(uint32_t seedNum)
 {
-    for (const auto &kernel : kernels) {
-        cv::Mat kernelMat = cv::Mat::zeros(MODEL_OUTPUT_HEIGHT, MODEL_OUTPUT_WIDTH, CV_8UC1);
-        for (size_t x = 0; x < MODEL_OUTPUT_HEIGHT; x++) {
-            for (size_t y = 0; y < MODEL_OUTPUT_WIDTH; y++) {
-                kernelMat.at<char>(x, y) = kernel[x][y];
+    const uint32_t capacity = static_cast<uint32_t>(queue_.size());
+    // up, down, left and right, the order in which the neighbours are claimed
+    const int32_t offsets[DIRECT_NUM] = { -PADDED_WIDTH, PADDED_WIDTH, -1, 1 };
+    const uint32_t *kernelMask = kernelMask_.data();
+    int32_t *labels = labels_.data();
+    uint32_t *queue = queue_.data();
+    uint32_t start = 0;
+    uint32_t size = seedNum;
+    // The pixels of one level are popped from read while the pixels they grow into are pushed at tail. A popped
+    // pixel that grows into nothing is an edge of the next level and is written back at write, which never passes
+    // read, so the edges of the next level end up in [start, write) of the same ring. Edges without a free neighbour
+    // in the remaining kernels can not grow any more and are dropped, the order of the others does not change.
+    for (int kernelId = kernel_num_ - 0x2; kernelId >= 0; --kernelId) {
+        const uint32_t kernelBit = 1u << kernelId;
+        const uint32_t lowerBits = kernelBit - 1;
+        uint32_t read = start;
+        uint32_t write = start;
+        uint32_t tail = (start + size) % capacity;
+        uint32_t pending = size;
+        uint32_t edgeNum = 0;
+        while (pending > 0) {
+            uint32_t pixel = queue[read];
+            read = read + 1 == capacity ? 0 : read + 1;
+            pending--;
+            int32_t label = labels[pixel];
+            bool isEdge = true;
+            bool canGrow = false;
+            for (int d = 0; d < DIRECT_NUM; ++d) {
+                uint32_t next = static_cast<uint32_t>(static_cast<int32_t>(pixel) + offsets[d]);
+                if (labels[next] > 0) {
+                    continue;
+                }
+                if ((kernelMask[next] & kernelBit) == 0) {
+                    canGrow = canGrow || (kernelMask[next] & lowerBits) != 0;
+                    continue;
+                }
+                labels[next] = label;
+                TextLineStat &stat = stats_[label];
+                int32_t row = static_cast<int32_t>(next / PADDED_WIDTH) - 1;
+                stat.area++;
+                stat.top = std::min(stat.top, row);
+                stat.bottom = std::max(stat.bottom, row);
+                queue[tail] = next;
+                tail = tail + 1 == capacity ? 0 : tail + 1;
+                pending++;
+                isEdge = false;
+            }
+            if (isEdge && canGrow) {
+                queue[write] = pixel;
+                write = write + 1 == capacity ? 0 : write + 1;
+                edgeNum++;
             }
         }
-        kernelsMat.emplace_back(kernelMat);
+        size = edgeNum;
     }
 }
 
-void PSENetPostProcessDptr::Pse(const std::vector<std::vector<std::vector<unsigned int>>> &kernels,
-    const float &minAreaPse, std::vector<std::vector<int>> &textLine)
+void PSENetPostProcessDptr::Pse(const float &minAreaPse)
 {
-    // get kernals for opencv's Mat
-    std::vector<cv::Mat> kernelsMat;
-    GetKernelsMat(kernels, kernelsMat);
-    // get text line
-    GrowingTextLine(kernelsMat, minAreaPse, textLine);
+    // label the smallest kernel, then grow the labels kernel by kernel up to the text region
+    LabelMinKernel(1u << (kernel_num_ - 1));
+    uint32_t seedNum = SeedTextLines(minAreaPse);
+    ExpandTextLines(seedNum);
 }
 
-void PSENetPostProcessDptr::GenerateBoxes(const std::vector<std::vector<int>> &textLine,
-    const std::vector<std::vector<float>> &score, const ResizedImageInfo &resizedImageInfos,
-    std::vector<TextObjectInfo> &textObjInfos) const
+void PSENetPostProcessDptr::GenerateBoxes(const float *textMap, const ResizedImageInfo &resizedImageInfos,
+    std::vector<TextObjectInfo> &textObjInfos)
 {
-    std::vector<float> scale = {(float)resizedImageInfos.widthOriginal / textLine[0].size(),
-        (float)resizedImageInfos.heightOriginal / textLine.size()
+    std::vector<float> scale = {(float)resizedImageInfos.widthOriginal / MODEL_OUTPUT_WIDTH,
+        (float)resizedImageInfos.heightOriginal / MODEL_OUTPUT_HEIGHT
     };
-    std::unordered_map<int, float> scoreLabelSum;
-    std::map<int, std::vector<std::vector<size_t>>> pointMapDest;
-    for (size_t row = 0; row < textLine.size(); row++) {
-        for (size_t col = 0; col < textLine[0].size(); col++) {
-            scoreLabelSum[textLine[row][col]] += score[row][col];
-            if (pointMapDest[textLine[row][col]].empty()) {
-                std::vector<size_t> temp = { row, col };
-                pointMapDest[textLine[row][col]] = {temp};
-            } else {
-                std::vector<size_t> temp = { row, col };
-                pointMapDest[textLine[row][col]].push_back(temp);
-            }
+    // only the leftmost and rightmost pixels of every row are kept, they have the same convex hull as the text line
+    int32_t spanNum = 0;
+    for (auto &stat : stats_) {
+        if (stat.area == 0 || stat.area < min_area_) {
+            continue;
         }
+        stat.spanBegin = spanNum;
+        spanNum += stat.bottom - stat.top + 1;
     }
-    for (auto pointMap = pointMapDest.begin(); pointMap != pointMapDest.end();) {
-        if (pointMap->first == 0) {
-            ++pointMap;
-            continue;
+    spanLeft_.assign(spanNum, INT_MAX);
+    spanRight_.assign(spanNum, -1);
+    for (int y = 0; y < MODEL_OUTPUT_HEIGHT; ++y) {
+        const int32_t *labels = &labels_[PaddedPixel(y, 0)];
+        const float *text = textMap + static_cast<size_t>(y) * MODEL_OUTPUT_WIDTH;
+        for (int x = 0; x < MODEL_OUTPUT_WIDTH; ++x) {
+            if (labels[x] == 0 || stats_[labels[x]].spanBegin == -1) {
+                continue;
+            }
+            TextLineStat &stat = stats_[labels[x]];
+            int32_t span = stat.spanBegin + y - stat.top;
+            spanLeft_[span] = std::min(spanLeft_[span], x);
+            spanRight_[span] = std::max(spanRight_[span], x);
+            stat.scoreSum += fastmath::sigmoid(text[x]);
         }
-        std::vector<cv::Point> points;
-        if ((pointMap->second.size() < min_area_) || pointMap->second.empty() ||
-            (scoreLabelSum[pointMap->first] / pointMap->second.size()) < min_score_) {
-            ++pointMap;
+    }
+    for (auto &stat : stats_) {
+        if (stat.spanBegin == -1 || (stat.scoreSum / stat.area) < min_score_) {
             continue;
         }
-        for (auto pointValue : pointMap->second) {
-            cv::Point point(pointValue[1], pointValue[0]);
-            points.push_back(point);
+        hullPoints_.clear();
+        for (int32_t row = stat.top; row <= stat.bottom; row++) {
+            int32_t span = stat.spanBegin + row - stat.top;
+            if (spanRight_[span] < 0) {
+                continue;
+            }
+            hullPoints_.emplace_back(spanLeft_[span], row);
+            if (spanRight_[span] != spanLeft_[span]) {
+                hullPoints_.emplace_back(spanRight_[span], row);
+            }
         }
-        cv::RotatedRect rect = cv::minAreaRect(points);
+        cv::RotatedRect rect = cv::minAreaRect(hullPoints_);
         cv::Mat bbox;
         TextObjectInfo textObjDetectInfo {};
         cv::boxPoints(rect, bbox);
@@ -277,42 +427,16 @@ void PSENetPostProcessDptr::GenerateBoxes(const std::vector<std::vector<int>> &t
         textObjDetectInfo.y1 = bbox.at<float>(0x2, 0x1) * scale[0x1];
         textObjDetectInfo.x2 = bbox.at<float>(0x3, 0x0) * scale[0x0];
         textObjDetectInfo.y2 = bbox.at<float>(0x3, 0x1) * scale[0x1];
-        ++pointMap;
         textObjInfos.push_back(textObjDetectInfo);
     }
 }
 
-APP_ERROR PSENetPostProcessDptr::GetSrcData(const std::vector<TensorBase> &tensors, const int &i,
-    std::vector<std::vector<std::vector<unsigned int>>> &kernels, std::vector<std::vector<float>> &score) const
-{
-    float *kernelsPtr = (float *)qPtr_->GetBuffer(tensors[objectNumTensor_], i);
-    if (kernelsPtr == nullptr) {
-        LogError << "The kernelsPtr is nullptr." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
-        return APP_ERR_COMM_INVALID_POINTER;
-    }
-    for (auto t = 0; t < kernel_num_; t++) {
-        for (auto j = 0; j < MODEL_OUTPUT_HEIGHT; j++) {
-            for (auto k = 0; k < MODEL_OUTPUT_WIDTH; k++) {
-                float value = kernelsPtr[k + j * MODEL_OUTPUT_WIDTH + t * MODEL_OUTPUT_HEIGHT * MODEL_OUTPUT_WIDTH];
-                float kernelsZeroLayer = kernelsPtr[k + j * MODEL_OUTPUT_WIDTH];
-                score[j][k] = fastmath::sigmoid(kernelsZeroLayer);
-                float outPut = (fastmath::sign(value - 1.0f) + 1) / 0x2;
-                float text = (fastmath::sign(kernelsZeroLayer - 1.0f) + 1) / 0x2;
-                kernels[t][j][k] = outPut * text;
-            }
-        }
-    }
-    return APP_ERR_OK;
-}
-
 APP_ERROR PSENetPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorBase> &tensors,
     std::vector<std::vector<TextObjectInfo>> &textObjInfos, const std::vector<ResizedImageInfo> &resizedImageInfos)
 {
     LogDebug << "PSENetPostProcess start to write results.";
     auto shape = tensors[objectNumTensor_].GetShape();
     uint32_t batchSize = shape[0];
-    std::vector<std::vector<float>> textProposals;
-    std::vector<float> scores;
     clock_t startTime, endTime;
     startTime = clock();
     if (resizedImageInfos.size() < batchSize) {
@@ -320,6 +444,16 @@ APP_ERROR PSENetPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorB
                  << resizedImageInfos.size() << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
+    if (kernel_num_ < 1 || kernel_num_ > MAX_KERNEL_NUM) {
+        LogError << "The value of KERNEL_NUM(" << kernel_num_ << ") is out of range [1, " << MAX_KERNEL_NUM << "]."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    // pse algorithm
+    if (IsDenominatorZero(pse_scale_)) {
+        LogError << "The value of PSE_SCALE must not equal to zero!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
     for (uint32_t i = 0; i < batchSize; i++) {
         std::vector<TextObjectInfo> textObjInfo;
         ResizedImageInfo resizedImageInfo = resizedImageInfos[i];
@@ -327,27 +461,16 @@ APP_ERROR PSENetPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorB
         LogDebug << "imgInfo.imgWidth: " << resizedImageInfo.widthOriginal;
         LogDebug << "imgInfo.modelHeight: " << resizedImageInfo.heightResize;
         LogDebug << "imgInfo.modelWidth: " << resizedImageInfo.widthResize;
-        std::vector<std::vector<std::vector<unsigned int>>> kernels(kernel_num_,
-            std::vector<std::vector<unsigned int>>(MODEL_OUTPUT_HEIGHT, std::vector<unsigned int>(MODEL_OUTPUT_WIDTH)));
-        std::vector<std::vector<float>> score(MODEL_OUTPUT_HEIGHT, std::vector<float>(MODEL_OUTPUT_WIDTH, 0));
-        APP_ERROR ret = GetSrcData(tensors, i, kernels, score);
+        const float *textMap = nullptr;
+        APP_ERROR ret = GetKernelMask(tensors, i, textMap);
         if (ret != APP_ERR_OK) {
-            LogError << "GetSrcData failed." << GetErrorInfo(ret);
+            LogError << "GetKernelMask failed." << GetErrorInfo(ret);
             return ret;
         }
-        std::vector<std::vector<int>> textLine;
-        // pse algorithm
-        if (IsDenominatorZero(pse_scale_)) {
-            LogError << "The value of PSE_SCALE must not equal to zero!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
-        }
-        Pse(kernels, min_kernel_area_ / (pse_scale_ * pse_scale_), textLine);
-        if (textLine.empty() || textLine[0].empty()) {
-            LogWarn << "Can't detect text lines";
-            continue;
-        }
+        Pse(min_kernel_area_ / (pse_scale_ * pse_scale_));
+        LogDebug << "label num: " << stats_.size();
         // get boxes
-        GenerateBoxes(textLine, score, resizedImageInfo, textObjInfo);
+        GenerateBoxes(textMap, resizedImageInfo, textObjInfo);
         textObjInfos.push_back(textObjInfo);
     }
     endTime = clock();
@@ -357,5 +480,4 @@ APP_ERROR PSENetPostProcessDptr::ObjectDetectionOutput(const std::vector<TensorB
     return APP_ERR_OK;
 }
 }
-
-#endif
\ No newline at end of file
+#endif
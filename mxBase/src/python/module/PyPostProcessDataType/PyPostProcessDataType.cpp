@@ -153,7 +153,8 @@ std::string SemanticSegInfo::Print()
 }
 void SemanticSegInfo::FromBase(const MxBase::SemanticSegInfo& other)
 {
-    pixels = other.pixels;
+    // the python api keeps the per pixel lists, so expand the label map when the postprocess only produced that
+    pixels = (other.pixels.empty() && !other.labels.Empty()) ? other.labels.ToPixels() : other.pixels;
     labelMap = other.labelMap;
 }
 std::string ClassInfo::Print()
@@ -0,0 +1,243 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Microbenchmarks of nms, sorting, fast math and tracking algorithms.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <numeric>
+#include <benchmark/benchmark.h>
+#include "MxBase/CV/ObjectDetection/Nms/Nms.h"
+#include "MxBase/CV/ObjectDetection/Nms/TileMerger.h"
+#include "MxBase/CV/MultipleObjectTracking/Huangarian.h"
+#include "MxBase/CV/MultipleObjectTracking/KalmanTracker.h"
+#include "MxBase/Maths/FastMath.h"
+#include "MxBase/Maths/NpySort.h"
+#include "MxBase/PostProcessBases/ChannelArgmax.h"
+#include "MxBase/PostProcessBases/CtcDecoder.h"
+#include "BenchmarkUtils.h"
+
+namespace {
+using namespace MxBase;
+const float IOU_THRESH = 0.45f;
+const size_t BOXES_PER_CLUSTER = 20;
+const int COCO_CLASS_NUM = 80;
+const int MAX_COST = 1000;
+const float TRACK_STEP = 3.f;
+const uint32_t SEG_CLASS_NUM = 21;
+const uint32_t SEG_EDGE = 512;
+const uint32_t CTC_CLASS_NUM = 6625;
+const uint32_t CTC_TIME_STEP = 80;
+const uint32_t CTC_BATCH_SIZE = 8;
+
+void BM_NmsSortCrowded(benchmark::State& state)
+{
+    const size_t boxNum = static_cast<size_t>(state.range(0));
+    const auto boxes = BenchmarkUtils::MakeCrowdedBoxes(boxNum, boxNum / BOXES_PER_CLUSTER);
+    for (auto _ : state) {
+        // NmsSort works in place, the copy is part of every iteration and is cheap next to the suppression
+        std::vector<DetectBox> detBoxes = boxes;
+        NmsSort(detBoxes, IOU_THRESH);
+        benchmark::DoNotOptimize(detBoxes.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_NmsSortCrowded)->RangeMultiplier(4)->Range(64, 4096);
+
+void BM_NmsSortMultiClass(benchmark::State& state)
+{
+    const size_t boxNum = static_cast<size_t>(state.range(0));
+    const auto boxes = BenchmarkUtils::MakeCrowdedBoxes(boxNum, boxNum / BOXES_PER_CLUSTER, COCO_CLASS_NUM);
+    for (auto _ : state) {
+        std::vector<DetectBox> detBoxes = boxes;
+        NmsSort(detBoxes, IOU_THRESH);
+        benchmark::DoNotOptimize(detBoxes.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_NmsSortMultiClass)->RangeMultiplier(4)->Range(256, 4096);
+
+void BM_TileMergeCrowded(benchmark::State& state)
+{
+    const size_t boxNum = static_cast<size_t>(state.range(0));
+    const auto boxes = BenchmarkUtils::MakeCrowdedBoxes(boxNum, boxNum / BOXES_PER_CLUSTER);
+    TileMerger merger;
+    TileMergeConfig config;
+    config.iouThresh = IOU_THRESH;
+    config.policy = TILE_MERGE_MAX_SCORE;
+    std::vector<DetectBox> merged;
+    for (auto _ : state) {
+        merger.Merge(boxes, {}, {}, config, merged);
+        benchmark::DoNotOptimize(merged.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_TileMergeCrowded)->RangeMultiplier(4)->Range(64, 4096);
+
+void BM_NpyArgQuickSort(benchmark::State& state)
+{
+    const size_t num = static_cast<size_t>(state.range(0));
+    const auto values = BenchmarkUtils::MakeUniform(num, 0.f, 1.f);
+    std::vector<int> indices(num);
+    std::iota(indices.begin(), indices.end(), 0);
+    for (auto _ : state) {
+        NpySort sorter(values, indices);
+        sorter.NpyArgQuickSort(true);
+        benchmark::DoNotOptimize(sorter.GetSortIdx());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_NpyArgQuickSort)->RangeMultiplier(8)->Range(64, 1 << 18);
+
+void BM_FastMathExp(benchmark::State& state)
+{
+    const auto values = BenchmarkUtils::MakeUniform(static_cast<size_t>(state.range(0)), -20.f, 20.f);
+    for (auto _ : state) {
+        float sum = 0.f;
+        for (float value : values) {
+            sum += fastmath::exp(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FastMathExp)->Arg(1 << 16);
+
+void BM_FastMathSigmoid(benchmark::State& state)
+{
+    const auto values = BenchmarkUtils::MakeUniform(static_cast<size_t>(state.range(0)), -20.f, 20.f);
+    for (auto _ : state) {
+        float sum = 0.f;
+        for (float value : values) {
+            sum += fastmath::sigmoid(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FastMathSigmoid)->Arg(1 << 16);
+
+void BM_FastMathSoftmax(benchmark::State& state)
+{
+    const auto values = BenchmarkUtils::MakeUniform(static_cast<size_t>(state.range(0)), -10.f, 10.f);
+    for (auto _ : state) {
+        std::vector<float> digits = values;
+        fastmath::softmax(digits);
+        benchmark::DoNotOptimize(digits.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FastMathSoftmax)->Arg(COCO_CLASS_NUM)->Arg(1000);
+
+void BM_HungarianSolve(benchmark::State& state)
+{
+    const int size = static_cast<int>(state.range(0));
+    std::mt19937 gen(BenchmarkUtils::DEFAULT_SEED);
+    std::uniform_int_distribution<int> distrib(0, MAX_COST);
+    std::vector<std::vector<int>> cost(size, std::vector<int>(size));
+    for (auto& row : cost) {
+        for (auto& value : row) {
+            value = distrib(gen);
+        }
+    }
+    for (auto _ : state) {
+        HungarianHandle handle = {};
+        if (HungarianHandleInit(handle, size, size) != APP_ERR_OK ||
+            HungarianSolve(handle, cost, size, size) != APP_ERR_OK) {
+            state.SkipWithError("HungarianSolve failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(handle.resX);
+    }
+}
+BENCHMARK(BM_HungarianSolve)->RangeMultiplier(2)->Range(8, 256);
+
+void BM_KalmanTrackerPredictUpdate(benchmark::State& state)
+{
+    const size_t trackNum = static_cast<size_t>(state.range(0));
+    const auto boxes = BenchmarkUtils::MakeCrowdedBoxes(trackNum, trackNum);
+    std::vector<KalmanTracker> trackers(trackNum);
+    for (size_t i = 0; i < trackNum; i++) {
+        trackers[i].CvKalmanInit(boxes[i]);
+    }
+    std::vector<DetectBox> measures = boxes;
+    for (auto _ : state) {
+        // every frame the targets move by a constant step, as a steady stream of matched detections
+        for (size_t i = 0; i < trackNum; i++) {
+            DetectBox predicted = trackers[i].Predict();
+            benchmark::DoNotOptimize(predicted);
+            measures[i].x += TRACK_STEP;
+            measures[i].y += TRACK_STEP;
+            trackers[i].Update(measures[i]);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_KalmanTrackerPredictUpdate)->Arg(16)->Arg(128)->Arg(512);
+
+/**
+ * Argmax over the 21 classes of a 512 x 512 segmentation output, args are the layout and the number of threads.
+ */
+void BM_ChannelArgmax(benchmark::State& state)
+{
+    const auto values = BenchmarkUtils::MakeUniform(static_cast<size_t>(SEG_EDGE) * SEG_EDGE * SEG_CLASS_NUM,
+                                                    -1.f, 1.f);
+    ChannelScores scores;
+    scores.data = values.data();
+    scores.layout = static_cast<TensorArrangementType>(state.range(0));
+    scores.width = SEG_EDGE;
+    scores.height = SEG_EDGE;
+    scores.classNum = SEG_CLASS_NUM;
+    SegLabelMap labels;
+    for (auto _ : state) {
+        ChannelArgmax::Argmax(scores, labels, nullptr, static_cast<uint32_t>(state.range(1)));
+        benchmark::DoNotOptimize(labels.data.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * SEG_EDGE * SEG_EDGE);
+}
+BENCHMARK(BM_ChannelArgmax)->Args({TYPE_NCHW, 1})->Args({TYPE_NCHW, 4})->Args({TYPE_NHWC, 1})->UseRealTime();
+
+/**
+ * CTC decoding of a batch of 8 lines with 80 time steps over a 6625 class charset, the arg is the beam width.
+ */
+void BM_CtcDecode(benchmark::State& state)
+{
+    const auto values = BenchmarkUtils::MakeUniform(
+        static_cast<size_t>(CTC_BATCH_SIZE) * CTC_TIME_STEP * CTC_CLASS_NUM, -5.f, 5.f);
+    std::vector<std::string> classNames(CTC_CLASS_NUM);
+    for (uint32_t c = 0; c < CTC_CLASS_NUM; c++) {
+        classNames[c] = std::to_string(c);
+    }
+    CtcDecoder decoder;
+    decoder.Init(classNames, 0);
+    CtcLogits logits;
+    logits.data = values.data();
+    logits.batchSize = CTC_BATCH_SIZE;
+    logits.timeStep = CTC_TIME_STEP;
+    logits.classNum = CTC_CLASS_NUM;
+    CtcBeamConfig config;
+    config.beamWidth = static_cast<uint32_t>(state.range(0));
+    std::vector<std::string> texts;
+    for (auto _ : state) {
+        decoder.BeamSearchDecode(logits, config, texts);
+        benchmark::DoNotOptimize(texts.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * CTC_BATCH_SIZE);
+}
+BENCHMARK(BM_CtcDecode)->Arg(1)->Arg(10);
+}
@@ -0,0 +1,106 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Deterministic synthetic inputs shared by the mxBase microbenchmarks.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXBASE_BENCHMARK_UTILS_H
+#define MXBASE_BENCHMARK_UTILS_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "MxBase/CV/Core/DataType.h"
+#include "MxBase/Tensor/TensorBase/TensorBase.h"
+
+namespace BenchmarkUtils {
+// every generator is seeded with a constant so that two runs measure exactly the same input
+const uint32_t DEFAULT_SEED = 20250101;
+const float IMAGE_WIDTH = 1920.f;
+const float IMAGE_HEIGHT = 1080.f;
+const float MIN_BOX_EDGE = 16.f;
+const float MAX_BOX_EDGE = 256.f;
+const float CLUSTER_JITTER = 12.f;
+
+/**
+ * @description: Boxes gathered around a few centers, as a crowded scene before nms. boxNum / clusterNum boxes
+ * overlap heavily inside each cluster.
+ */
+inline std::vector<MxBase::DetectBox> MakeCrowdedBoxes(size_t boxNum, size_t clusterNum, int classNum = 1,
+                                                       uint32_t seed = DEFAULT_SEED)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> centerX(MAX_BOX_EDGE, IMAGE_WIDTH - MAX_BOX_EDGE);
+    std::uniform_real_distribution<float> centerY(MAX_BOX_EDGE, IMAGE_HEIGHT - MAX_BOX_EDGE);
+    std::uniform_real_distribution<float> edge(MIN_BOX_EDGE, MAX_BOX_EDGE);
+    std::uniform_real_distribution<float> jitter(-CLUSTER_JITTER, CLUSTER_JITTER);
+    std::uniform_real_distribution<float> prob(0.f, 1.f);
+    std::uniform_int_distribution<int> classId(0, std::max(classNum - 1, 0));
+    clusterNum = std::max<size_t>(clusterNum, 1);
+    std::vector<MxBase::DetectBox> clusters(clusterNum);
+    for (auto& cluster : clusters) {
+        cluster.x = centerX(gen);
+        cluster.y = centerY(gen);
+        cluster.width = edge(gen);
+        cluster.height = edge(gen);
+    }
+    std::vector<MxBase::DetectBox> boxes(boxNum);
+    for (size_t i = 0; i < boxNum; i++) {
+        const auto& cluster = clusters[i % clusterNum];
+        boxes[i].prob = prob(gen);
+        boxes[i].classID = classId(gen);
+        boxes[i].x = cluster.x + jitter(gen);
+        boxes[i].y = cluster.y + jitter(gen);
+        boxes[i].width = std::max(cluster.width + jitter(gen), 1.f);
+        boxes[i].height = std::max(cluster.height + jitter(gen), 1.f);
+        boxes[i].maskPtr = nullptr;
+    }
+    return boxes;
+}
+
+inline std::vector<float> MakeUniform(size_t num, float minValue, float maxValue, uint32_t seed = DEFAULT_SEED)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> distrib(minValue, maxValue);
+    std::vector<float> values(num);
+    for (auto& value : values) {
+        value = distrib(gen);
+    }
+    return values;
+}
+
+/**
+ * @description: Host tensor filled with uniform values, the memory is owned by the tensor.
+ */
+inline MxBase::TensorBase MakeTensor(const std::vector<uint32_t>& shape, float minValue, float maxValue,
+                                     uint32_t seed = DEFAULT_SEED)
+{
+    MxBase::TensorBase tensor(shape, MxBase::TENSOR_DTYPE_FLOAT32);
+    MxBase::TensorBase::TensorBaseMalloc(tensor);
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> distrib(minValue, maxValue);
+    float* data = static_cast<float*>(tensor.GetBuffer());
+    for (size_t i = 0; i < tensor.GetSize(); i++) {
+        data[i] = distrib(gen);
+    }
+    return tensor;
+}
+}
+
+#endif
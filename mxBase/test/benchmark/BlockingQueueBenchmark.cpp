@@ -0,0 +1,68 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Microbenchmarks of the blocking queue used between the pipeline stages.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <memory>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include "MxBase/BlockingQueue/BlockingQueue.h"
+
+namespace {
+using namespace MxBase;
+const unsigned int POP_TIMEOUT_MS = 10;
+
+void BM_BlockingQueuePushPop(benchmark::State& state)
+{
+    BlockingQueue<std::shared_ptr<int>> queue;
+    auto item = std::make_shared<int>(0);
+    std::shared_ptr<int> out;
+    for (auto _ : state) {
+        queue.Push(item);
+        queue.Pop(out);
+        benchmark::DoNotOptimize(out.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_BlockingQueuePushPop);
+
+/**
+ * One consumer thread drains the queue while the benchmark thread pushes and waits whenever the queue is full,
+ * which is what a pipeline stage sees when the downstream element is the slower one.
+ */
+void BM_BlockingQueueProducerConsumer(benchmark::State& state)
+{
+    BlockingQueue<std::shared_ptr<int>> queue(static_cast<uint32_t>(state.range(0)));
+    std::thread consumer([&queue]() {
+        std::shared_ptr<int> out;
+        while (queue.Pop(out, POP_TIMEOUT_MS) != APP_ERR_QUEUE_STOPED) {
+            benchmark::DoNotOptimize(out.get());
+        }
+    });
+    auto item = std::make_shared<int>(0);
+    for (auto _ : state) {
+        queue.Push(item, true);
+    }
+    queue.Stop();
+    consumer.join();
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_BlockingQueueProducerConsumer)->Arg(8)->Arg(256)->UseRealTime();
+}
@@ -0,0 +1,292 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Microbenchmarks of the model postprocessors on synthetic host tensors.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <benchmark/benchmark.h>
+#include "acl/acl.h"
+#include "ObjectPostProcessors/Yolov3PostProcess.h"
+#include "ObjectPostProcessors/Ssdvgg16PostProcess.h"
+#include "ObjectPostProcessors/RetinaNetPostProcess.h"
+#include "KeypointPostProcessors/OpenPosePostProcess.h"
+#include "TextObjectPostProcessors/PSENetPostProcess.h"
+#include "SegmentPostProcessors/Deeplabv3Post.h"
+#include "BenchmarkUtils.h"
+
+namespace {
+using namespace MxBase;
+const std::map<std::string, std::string> YOLOV3_CONFIG = {
+    {"postProcessConfigContent", "{\"CLASS_NUM\": \"80\","
+                                 "\"BIASES_NUM\": \"18\","
+                                 "\"BIASES\": \"10,13,16,30,33,23,30,61,62,45,59,119,116,90,156,198,373,326\","
+                                 "\"SCORE_THRESH\": \"0.3\","
+                                 "\"OBJECTNESS_THRESH\": \"0.3\","
+                                 "\"IOU_THRESH\": \"0.45\","
+                                 "\"YOLO_TYPE\": \"3\","
+                                 "\"ANCHOR_DIM\": \"3\","
+                                 "\"MODEL_TYPE\": \"0\","
+                                 "\"RESIZE_FLAG\": \"0\"}"}
+};
+const std::map<std::string, std::string> SSDVGG16_CONFIG = {
+    {"postProcessConfigContent", "{\"CLASS_NUM\": \"80\", \"SCORE_THRESH\": \"0.7\"}"}
+};
+const std::map<std::string, std::string> RETINANET_CONFIG = {
+    {"postProcessConfigContent", "{\"CLASS_NUM\": \"80\", \"SCORE_THRESH\": \"0.5\", \"MODEL_TYPE\": \"0\"}"}
+};
+const std::map<std::string, std::string> OPENPOSE_CONFIG = {
+    {"postProcessConfigContent", "{\"KEYPOINT_NUM\": \"17\", \"SCORE_THRESH\": \"0.1\"}"}
+};
+const std::map<std::string, std::string> PSENET_CONFIG = {
+    {"postProcessConfigContent", "{\"KERNEL_NUM\": \"7\", \"PSE_SCALE\": \"1.0\", \"MIN_SCORE\": \"0.9\","
+                                 "\"MIN_AREA\": \"600\", \"MIN_KERNEL_AREA\": \"5.0\"}"}
+};
+const std::map<std::string, std::string> DEEPLABV3_CONFIG = {
+    {"postProcessConfigContent", "{\"CLASS_NUM\": \"21\", \"CHECK_MODEL\": \"true\", \"MODEL_TYPE\": \"0\"}"}
+};
+const uint32_t YOLO_CHANNEL = 255;
+const std::vector<uint32_t> YOLO_GRIDS = {13, 26, 52};
+const uint32_t SSD_MAX_OUTPUT = 200;
+const uint32_t SSD_INFO_NUM = 8;
+const int SSD_DETECT_NUM = 100;
+const uint32_t RETINANET_MAX_OUTPUT = 300;
+const uint32_t RETINANET_BOX_DIM = 4;
+const int RETINANET_DETECT_NUM = 100;
+const int RETINANET_CLASS_NUM = 80;
+const std::vector<uint32_t> OPENPOSE_SHAPE = {1, 255, 32, 51};
+const uint32_t PSENET_KERNEL_NUM = 7;
+const uint32_t PSENET_HEIGHT = 704;
+const uint32_t PSENET_WIDTH = 1216;
+const uint32_t PSENET_TEXT_ROWS = 8;
+const uint32_t PSENET_TEXT_COLS = 4;
+const uint32_t PSENET_TEXT_HEIGHT = 48;
+const uint32_t PSENET_TEXT_WIDTH = 240;
+const uint32_t PSENET_KERNEL_SHRINK = 3;
+const float PSENET_TEXT_VALUE = 2.f;
+const uint32_t DEEPLABV3_SIZE = 513;
+const uint32_t DEEPLABV3_CLASS_NUM = 21;
+const uint32_t INPUT_WIDTH = 416;
+const uint32_t INPUT_HEIGHT = 416;
+const ResizedImageInfo RESIZED_IMAGE_INFO = {INPUT_WIDTH, INPUT_HEIGHT, 1920, 1080,
+                                             ResizeType::RESIZER_STRETCHING, 1.0};
+
+TensorBase MakeIntTensor(const std::vector<uint32_t>& shape, int value)
+{
+    TensorBase tensor(shape, TENSOR_DTYPE_INT32);
+    TensorBase::TensorBaseMalloc(tensor);
+    int* data = static_cast<int*>(tensor.GetBuffer());
+    for (size_t i = 0; i < tensor.GetSize(); i++) {
+        data[i] = value;
+    }
+    return tensor;
+}
+
+TensorBase MakeFloat16Tensor(const std::vector<uint32_t>& shape, float minValue, float maxValue)
+{
+    TensorBase floatTensor = BenchmarkUtils::MakeTensor(shape, minValue, maxValue);
+    TensorBase tensor(shape, TENSOR_DTYPE_FLOAT16);
+    TensorBase::TensorBaseMalloc(tensor);
+    const float* src = static_cast<const float*>(floatTensor.GetBuffer());
+    aclFloat16* dst = static_cast<aclFloat16*>(tensor.GetBuffer());
+    for (size_t i = 0; i < tensor.GetSize(); i++) {
+        dst[i] = aclFloatToFloat16(src[i]);
+    }
+    return tensor;
+}
+
+template<typename T>
+bool InitPostProcess(benchmark::State& state, T& postProcess, const std::map<std::string, std::string>& config)
+{
+    if (postProcess.Init(config) != APP_ERR_OK) {
+        state.SkipWithError("Init postprocess failed.");
+        return false;
+    }
+    return true;
+}
+
+void BM_Yolov3PostProcess(benchmark::State& state)
+{
+    Yolov3PostProcess postProcess;
+    if (!InitPostProcess(state, postProcess, YOLOV3_CONFIG)) {
+        return;
+    }
+    // raw logits, about a third of the anchors pass the objectness threshold after the sigmoid
+    std::vector<TensorBase> tensors;
+    for (auto grid : YOLO_GRIDS) {
+        tensors.push_back(BenchmarkUtils::MakeTensor({1, grid, grid, YOLO_CHANNEL}, -6.f, 2.f));
+    }
+    std::vector<ResizedImageInfo> resizedImageInfos = {RESIZED_IMAGE_INFO};
+    std::map<std::string, std::shared_ptr<void>> paramMap;
+    std::vector<std::vector<ObjectInfo>> objectInfos;
+    for (auto _ : state) {
+        objectInfos.clear();
+        if (postProcess.Process(tensors, objectInfos, resizedImageInfos, paramMap) != APP_ERR_OK) {
+            state.SkipWithError("Yolov3PostProcess failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(objectInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_Yolov3PostProcess)->Unit(benchmark::kMillisecond);
+
+void BM_Ssdvgg16PostProcess(benchmark::State& state)
+{
+    Ssdvgg16PostProcess postProcess;
+    if (!InitPostProcess(state, postProcess, SSDVGG16_CONFIG)) {
+        return;
+    }
+    std::vector<TensorBase> tensors = {
+        MakeIntTensor({1, 1}, SSD_DETECT_NUM),
+        BenchmarkUtils::MakeTensor({1, SSD_MAX_OUTPUT, SSD_INFO_NUM}, 0.f, 1.f)
+    };
+    std::vector<ResizedImageInfo> resizedImageInfos = {RESIZED_IMAGE_INFO};
+    std::map<std::string, std::shared_ptr<void>> paramMap;
+    std::vector<std::vector<ObjectInfo>> objectInfos;
+    for (auto _ : state) {
+        objectInfos.clear();
+        if (postProcess.Process(tensors, objectInfos, resizedImageInfos, paramMap) != APP_ERR_OK) {
+            state.SkipWithError("Ssdvgg16PostProcess failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(objectInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_Ssdvgg16PostProcess);
+
+void BM_RetinaNetPostProcess(benchmark::State& state)
+{
+    RetinaNetPostProcess postProcess;
+    if (!InitPostProcess(state, postProcess, RETINANET_CONFIG)) {
+        return;
+    }
+    std::vector<TensorBase> tensors = {
+        MakeFloat16Tensor({1, RETINANET_MAX_OUTPUT, RETINANET_BOX_DIM}, 0.f, 1.f),
+        MakeFloat16Tensor({1, RETINANET_MAX_OUTPUT}, 0.f, 1.f),
+        MakeFloat16Tensor({1, RETINANET_MAX_OUTPUT}, 0.f, static_cast<float>(RETINANET_CLASS_NUM - 1)),
+        MakeIntTensor({1}, RETINANET_DETECT_NUM)
+    };
+    std::vector<ResizedImageInfo> resizedImageInfos = {RESIZED_IMAGE_INFO};
+    std::map<std::string, std::shared_ptr<void>> paramMap;
+    std::vector<std::vector<ObjectInfo>> objectInfos;
+    for (auto _ : state) {
+        objectInfos.clear();
+        if (postProcess.Process(tensors, objectInfos, resizedImageInfos, paramMap) != APP_ERR_OK) {
+            state.SkipWithError("RetinaNetPostProcess failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(objectInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_RetinaNetPostProcess);
+
+void BM_OpenPosePostProcess(benchmark::State& state)
+{
+    OpenPosePostProcess postProcess;
+    if (!InitPostProcess(state, postProcess, OPENPOSE_CONFIG)) {
+        return;
+    }
+    // low noise just above the score threshold, tens of peak candidates per keypoint
+    TensorBase tensor = BenchmarkUtils::MakeTensor(OPENPOSE_SHAPE, 0.f, 0.11f);
+    std::vector<TensorBase> tensors = {tensor, tensor};
+    std::vector<ResizedImageInfo> resizedImageInfos = {RESIZED_IMAGE_INFO, RESIZED_IMAGE_INFO};
+    std::map<std::string, std::shared_ptr<void>> paramMap;
+    std::vector<std::vector<KeyPointDetectionInfo>> keyPointInfos;
+    for (auto _ : state) {
+        keyPointInfos.clear();
+        if (postProcess.Process(tensors, keyPointInfos, resizedImageInfos, paramMap) != APP_ERR_OK) {
+            state.SkipWithError("OpenPosePostProcess failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(keyPointInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_OpenPosePostProcess)->Unit(benchmark::kMillisecond);
+
+void BM_PSENetPostProcess(benchmark::State& state)
+{
+    PSENetPostProcess postProcess;
+    if (!InitPostProcess(state, postProcess, PSENET_CONFIG)) {
+        return;
+    }
+    // a grid of text lines, every kernel is the previous one shrunk by a few pixels
+    TensorBase tensor({1, PSENET_KERNEL_NUM, PSENET_HEIGHT, PSENET_WIDTH}, TENSOR_DTYPE_FLOAT32);
+    TensorBase::TensorBaseMalloc(tensor);
+    float* data = static_cast<float*>(tensor.GetBuffer());
+    std::fill(data, data + tensor.GetSize(), 0.f);
+    const uint32_t cellHeight = PSENET_HEIGHT / PSENET_TEXT_ROWS;
+    const uint32_t cellWidth = PSENET_WIDTH / PSENET_TEXT_COLS;
+    for (uint32_t k = 0; k < PSENET_KERNEL_NUM; k++) {
+        const uint32_t shrink = k * PSENET_KERNEL_SHRINK;
+        float* kernel = data + static_cast<size_t>(k) * PSENET_HEIGHT * PSENET_WIDTH;
+        for (uint32_t row = 0; row < PSENET_TEXT_ROWS; row++) {
+            for (uint32_t col = 0; col < PSENET_TEXT_COLS; col++) {
+                for (uint32_t y = row * cellHeight + shrink; y < row * cellHeight + PSENET_TEXT_HEIGHT - shrink; y++) {
+                    float* line = kernel + static_cast<size_t>(y) * PSENET_WIDTH + col * cellWidth;
+                    std::fill(line + shrink, line + PSENET_TEXT_WIDTH - shrink, PSENET_TEXT_VALUE);
+                }
+            }
+        }
+    }
+    std::vector<TensorBase> tensors = {tensor};
+    std::vector<ResizedImageInfo> resizedImageInfos = {
+        {PSENET_WIDTH, PSENET_HEIGHT, PSENET_WIDTH, PSENET_HEIGHT, ResizeType::RESIZER_TF_KEEP_ASPECT_RATIO, 1.0}
+    };
+    std::vector<std::vector<TextObjectInfo>> textObjInfos;
+    for (auto _ : state) {
+        textObjInfos.clear();
+        if (postProcess.Process(tensors, textObjInfos, resizedImageInfos) != APP_ERR_OK) {
+            state.SkipWithError("PSENetPostProcess failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(textObjInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_PSENetPostProcess)->Unit(benchmark::kMillisecond);
+
+void BM_Deeplabv3PostProcess(benchmark::State& state)
+{
+    Deeplabv3Post postProcess;
+    if (!InitPostProcess(state, postProcess, DEEPLABV3_CONFIG)) {
+        return;
+    }
+    std::vector<TensorBase> tensors = {
+        BenchmarkUtils::MakeTensor({1, DEEPLABV3_SIZE, DEEPLABV3_SIZE, DEEPLABV3_CLASS_NUM}, -5.f, 5.f)
+    };
+    std::vector<ResizedImageInfo> resizedImageInfos = {
+        {DEEPLABV3_SIZE, DEEPLABV3_SIZE, DEEPLABV3_SIZE, DEEPLABV3_SIZE, ResizeType::RESIZER_STRETCHING, 1.0}
+    };
+    std::map<std::string, std::shared_ptr<void>> paramMap;
+    std::vector<SemanticSegInfo> semanticSegInfos;
+    for (auto _ : state) {
+        semanticSegInfos.clear();
+        if (postProcess.Process(tensors, semanticSegInfos, resizedImageInfos, paramMap) != APP_ERR_OK) {
+            state.SkipWithError("Deeplabv3Post failed.");
+            break;
+        }
+        benchmark::DoNotOptimize(semanticSegInfos.data());
+    }
+    postProcess.DeInit();
+}
+BENCHMARK(BM_Deeplabv3PostProcess)->Unit(benchmark::kMillisecond);
+}
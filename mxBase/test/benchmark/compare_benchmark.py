@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# coding=utf-8
+
+"""
+-------------------------------------------------------------------------
+ This file is part of the Vision SDK project.
+Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+
+Vision SDK is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+
+          http://license.coscl.org.cn/MulanPSL2
+
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details.
+-------------------------------------------------------------------------
+Description: Compare two Google Benchmark json results and fail on regressions.
+Author: MindX SDK
+Create: 2025
+History: NA
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load_times(path, metric):
+    """Name -> time in ns. The median aggregate is preferred, plain runs are used when no repetitions were made."""
+    with open(path, "r", encoding="utf-8") as result_file:
+        result = json.load(result_file)
+    medians = {}
+    iterations = {}
+    for entry in result.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        value = float(entry[metric]) * TIME_UNIT_TO_NS.get(entry.get("time_unit", "ns"), 1.0)
+        if entry.get("run_type") == "aggregate":
+            if entry.get("aggregate_name") == "median":
+                medians[entry["run_name"]] = value
+        else:
+            iterations.setdefault(entry.get("run_name", entry["name"]), value)
+    return medians if medians else iterations
+
+
+def compare(baseline, current, threshold):
+    regressions = []
+    print("{:<56} {:>14} {:>14} {:>9}".format("Benchmark", "Baseline(ns)", "Current(ns)", "Change"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print("{:<56} {:>14.1f} {:>14} {:>9}".format(name, baseline[name], "-", "missing"))
+            continue
+        if name not in baseline:
+            print("{:<56} {:>14} {:>14.1f} {:>9}".format(name, "-", current[name], "new"))
+            continue
+        change = current[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        mark = " <" if change > threshold else ""
+        print("{:<56} {:>14.1f} {:>14.1f} {:>+8.1%}{}".format(name, baseline[name], current[name], change, mark))
+        if change > threshold:
+            regressions.append(name)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two Google Benchmark json results.")
+    parser.add_argument("baseline", help="json of the reference commit")
+    parser.add_argument("current", help="json of the commit under test")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative slowdown reported as a regression, 0.10 means 10%%")
+    parser.add_argument("--metric", choices=["cpu_time", "real_time"], default="cpu_time")
+    args = parser.parse_args()
+
+    regressions = compare(load_times(args.baseline, args.metric), load_times(args.current, args.metric),
+                          args.threshold)
+    if regressions:
+        print("{} benchmark(s) slower than the threshold {:.0%}: {}".format(
+            len(regressions), args.threshold, ", ".join(regressions)))
+        return 1
+    print("No regression above the threshold {:.0%}.".format(args.threshold))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,157 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Gtest unit cases.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include "MxBase/CV/Preprocess/ImageNormalizer.h"
+
+using namespace MxBase;
+
+namespace {
+const int IMAGE_WIDTH = 301;
+const int IMAGE_HEIGHT = 67;
+const int CHANNEL_NUM = 3;
+const std::vector<double> MEAN = {123.675, 116.28, 103.53};
+const std::vector<double> STD = {58.395, 57.12, 57.375};
+
+class ImageNormalizerTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        image_ = cv::Mat(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3);
+        cv::randu(image_, 0, 256);
+        src_.data = image_.data;
+        src_.width = IMAGE_WIDTH;
+        src_.height = IMAGE_HEIGHT;
+        src_.channelNum = CHANNEL_NUM;
+        ASSERT_EQ(ImageNormalizer::MeanStdToScaleBias(MEAN, STD, param_.scale, param_.bias), APP_ERR_OK);
+    }
+
+    // the OpenCV steps replaced by the kernel: split, convertTo of every channel, merge and a color conversion
+    cv::Mat Reference(int type, bool swapChannel)
+    {
+        std::vector<cv::Mat> channels;
+        cv::split(image_, channels);
+        for (size_t i = 0; i < channels.size(); i++) {
+            channels[i].convertTo(channels[i], type, 1 / STD[i], -MEAN[i] / STD[i]);
+        }
+        cv::Mat dst;
+        cv::merge(channels, dst);
+        if (swapChannel) {
+            cv::cvtColor(dst, dst, cv::COLOR_RGB2BGR);
+        }
+        return dst;
+    }
+
+    cv::Mat image_;
+    NormalizeImage src_;
+    NormalizeParam param_;
+};
+
+TEST_F(ImageNormalizerTest, Normalize_Should_Match_OpenCV_When_Float32_Output)
+{
+    cv::Mat expect = Reference(CV_32F, false);
+    cv::Mat result(IMAGE_HEIGHT, IMAGE_WIDTH, CV_32FC3);
+    ASSERT_EQ(ImageNormalizer::GetOutputSize(src_, param_), result.total() * result.elemSize());
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, result.data, result.total() * result.elemSize(), 4),
+              APP_ERR_OK);
+    EXPECT_LE(cv::norm(expect, result, cv::NORM_INF), 1e-5);
+}
+
+TEST_F(ImageNormalizerTest, Normalize_Should_Match_OpenCV_When_Channel_Reorder_And_Uint8_Output)
+{
+    cv::Mat expect = Reference(CV_8U, true);
+    param_.channelOrder = {2, 1, 0};
+    std::swap(param_.scale[0], param_.scale[2]);
+    std::swap(param_.bias[0], param_.bias[2]);
+    param_.dataType = TENSOR_DTYPE_UINT8;
+    cv::Mat result(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3);
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, result.data, result.total() * result.elemSize()),
+              APP_ERR_OK);
+    EXPECT_EQ(cv::norm(expect, result, cv::NORM_INF), 0);
+}
+
+TEST_F(ImageNormalizerTest, Normalize_Should_Write_Planes_When_Nchw_Float16_Output)
+{
+    cv::Mat expect = Reference(CV_16F, false);
+    std::vector<cv::Mat> planes;
+    cv::split(expect, planes);
+    param_.layout = TYPE_NCHW;
+    param_.dataType = TENSOR_DTYPE_FLOAT16;
+    std::vector<uint16_t> result(IMAGE_WIDTH * IMAGE_HEIGHT * CHANNEL_NUM);
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, result.data(), result.size() * sizeof(uint16_t), 2),
+              APP_ERR_OK);
+    for (int c = 0; c < CHANNEL_NUM; c++) {
+        cv::Mat plane(IMAGE_HEIGHT, IMAGE_WIDTH, CV_16U, result.data() + c * IMAGE_WIDTH * IMAGE_HEIGHT);
+        cv::Mat expectBits(IMAGE_HEIGHT, IMAGE_WIDTH, CV_16U, planes[c].data);
+        EXPECT_EQ(cv::norm(expectBits, plane, cv::NORM_INF), 0);
+    }
+}
+
+TEST_F(ImageNormalizerTest, Normalize_Should_Round_And_Saturate_When_Int8_Output)
+{
+    // quantization with scale 32 and zero point 0 folded into scale and bias
+    const float quantScale = 32.f;
+    for (size_t i = 0; i < param_.scale.size(); i++) {
+        param_.scale[i] *= quantScale;
+        param_.bias[i] *= quantScale;
+    }
+    param_.dataType = TENSOR_DTYPE_INT8;
+    cv::Mat result(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8SC3);
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, result.data, result.total() * result.elemSize()),
+              APP_ERR_OK);
+    std::vector<cv::Mat> channels;
+    cv::split(image_, channels);
+    for (size_t i = 0; i < channels.size(); i++) {
+        channels[i].convertTo(channels[i], CV_8S, param_.scale[i], param_.bias[i]);
+    }
+    cv::Mat expect;
+    cv::merge(channels, expect);
+    EXPECT_EQ(cv::norm(expect, result, cv::NORM_INF), 0);
+}
+
+TEST_F(ImageNormalizerTest, Normalize_Should_Return_Fail_When_Param_Invalid)
+{
+    std::vector<float> result(IMAGE_WIDTH * IMAGE_HEIGHT * CHANNEL_NUM);
+    size_t size = result.size() * sizeof(float);
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, nullptr, size), APP_ERR_COMM_INVALID_POINTER);
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param_, result.data(), size - 1), APP_ERR_COMM_INVALID_PARAM);
+    NormalizeParam param = param_;
+    param.channelOrder = {0, 1, 3};
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param, result.data(), size), APP_ERR_COMM_INVALID_PARAM);
+    param = param_;
+    param.scale.pop_back();
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param, result.data(), size), APP_ERR_COMM_INVALID_PARAM);
+    param = param_;
+    param.dataType = TENSOR_DTYPE_INT32;
+    EXPECT_EQ(ImageNormalizer::Normalize(src_, param, result.data(), size), APP_ERR_COMM_INVALID_PARAM);
+    std::vector<float> scale;
+    std::vector<float> bias;
+    EXPECT_EQ(ImageNormalizer::MeanStdToScaleBias(MEAN, {1, 0, 1}, scale, bias), APP_ERR_COMM_INVALID_PARAM);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,178 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Gtest unit cases.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include "MxBase/CV/Preprocess/LetterboxResizer.h"
+
+using namespace MxBase;
+
+namespace {
+const int IMAGE_WIDTH = 302;
+const int IMAGE_HEIGHT = 68;
+const uint32_t RESIZE_WIDTH = 211;
+const uint32_t RESIZE_HEIGHT = 47;
+const uint32_t PADDING_WIDTH = 224;
+const uint32_t PADDING_HEIGHT = 64;
+const int NV12_HEIGHT_RATIO = 3;
+const double PAD_VALUE[] = {114.4, 0, 300};
+
+class LetterboxResizerTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        image_ = cv::Mat(IMAGE_HEIGHT, IMAGE_WIDTH, CV_8UC3);
+        cv::randu(image_, 0, 256);
+        src_.data = image_.data;
+        src_.width = IMAGE_WIDTH;
+        src_.height = IMAGE_HEIGHT;
+        ASSERT_EQ(LetterboxResizer::MakeGeometry(RESIZE_WIDTH, RESIZE_HEIGHT, PADDING_WIDTH, PADDING_HEIGHT,
+                                                 LetterboxPadding::AROUND, param_.geometry), APP_ERR_OK);
+        for (size_t i = 0; i < sizeof(PAD_VALUE) / sizeof(PAD_VALUE[0]); i++) {
+            param_.padValue[i] = static_cast<float>(PAD_VALUE[i]);
+        }
+    }
+
+    // the OpenCV steps replaced by the kernel: cv::resize into a temporary and cv::copyMakeBorder around it
+    cv::Mat Reference(const cv::Mat& src, int interpolation)
+    {
+        const LetterboxGeometry& geometry = param_.geometry;
+        cv::Mat resized;
+        cv::resize(src, resized, cv::Size(geometry.resizeWidth, geometry.resizeHeight), 0, 0, interpolation);
+        cv::Mat dst;
+        cv::copyMakeBorder(resized, dst, geometry.top, geometry.height - geometry.resizeHeight - geometry.top,
+                           geometry.left, geometry.width - geometry.resizeWidth - geometry.left, cv::BORDER_CONSTANT,
+                           cv::Scalar(PAD_VALUE[0], PAD_VALUE[1], PAD_VALUE[2]));
+        return dst;
+    }
+
+    cv::Mat Resize(int type, uint32_t threadNum)
+    {
+        cv::Mat dst(param_.geometry.height, param_.geometry.width, type);
+        size_t size = dst.total() * dst.elemSize();
+        EXPECT_EQ(LetterboxResizer::GetOutputSize(src_.dataType, param_.geometry), size);
+        EXPECT_EQ(LetterboxResizer::Resize(src_, param_, dst.data, size, threadNum), APP_ERR_OK);
+        return dst;
+    }
+
+    cv::Mat image_;
+    LetterboxImage src_;
+    LetterboxParam param_;
+};
+
+TEST_F(LetterboxResizerTest, MakeGeometry_Should_Center_Image_When_Padding_Around)
+{
+    const LetterboxGeometry& geometry = param_.geometry;
+    EXPECT_EQ(geometry.left, (PADDING_WIDTH - RESIZE_WIDTH) / 2);
+    EXPECT_EQ(geometry.top, (PADDING_HEIGHT - RESIZE_HEIGHT) / 2);
+    EXPECT_EQ(geometry.width, PADDING_WIDTH);
+    EXPECT_EQ(geometry.height, PADDING_HEIGHT);
+    LetterboxGeometry rightDown;
+    EXPECT_EQ(LetterboxResizer::MakeGeometry(RESIZE_WIDTH, RESIZE_HEIGHT, PADDING_WIDTH, PADDING_HEIGHT,
+                                             LetterboxPadding::RIGHT_DOWN, rightDown), APP_ERR_OK);
+    EXPECT_EQ(rightDown.left + rightDown.top, 0u);
+    LetterboxGeometry none;
+    EXPECT_EQ(LetterboxResizer::MakeGeometry(RESIZE_WIDTH, RESIZE_HEIGHT, 0, 0, LetterboxPadding::NONE, none),
+              APP_ERR_OK);
+    EXPECT_EQ(none.width, RESIZE_WIDTH);
+    EXPECT_EQ(none.height, RESIZE_HEIGHT);
+    EXPECT_EQ(LetterboxResizer::MakeGeometry(PADDING_WIDTH + 1, RESIZE_HEIGHT, PADDING_WIDTH, PADDING_HEIGHT,
+                                             LetterboxPadding::AROUND, none), APP_ERR_COMM_INVALID_PARAM);
+}
+
+TEST_F(LetterboxResizerTest, Resize_Should_Match_OpenCV_When_Bilinear)
+{
+    // the vectorized and scalar passes of cv::resize round differently, so a few pixels differ by 1
+    EXPECT_LE(cv::norm(Reference(image_, cv::INTER_LINEAR), Resize(CV_8UC3, 4), cv::NORM_INF), 1);
+}
+
+TEST_F(LetterboxResizerTest, Resize_Should_Match_OpenCV_When_Nearest_And_Area)
+{
+    param_.interpolation = LetterboxInterpolation::NEAREST;
+    EXPECT_EQ(cv::norm(Reference(image_, cv::INTER_NEAREST), Resize(CV_8UC3, 1), cv::NORM_INF), 0);
+    param_.interpolation = LetterboxInterpolation::AREA;
+    EXPECT_EQ(cv::norm(Reference(image_, cv::INTER_AREA), Resize(CV_8UC3, 2), cv::NORM_INF), 0);
+}
+
+TEST_F(LetterboxResizerTest, Resize_Should_Match_OpenCV_When_Float32_Image)
+{
+    cv::Mat image;
+    image_.convertTo(image, CV_32FC3);
+    src_.data = image.data;
+    src_.dataType = TENSOR_DTYPE_FLOAT32;
+    EXPECT_LE(cv::norm(Reference(image, cv::INTER_LINEAR), Resize(CV_32FC3, 3), cv::NORM_INF), 1e-2);
+}
+
+TEST_F(LetterboxResizerTest, Resize_Should_Convert_When_Nv12_Image)
+{
+    cv::Mat yuv(IMAGE_HEIGHT * NV12_HEIGHT_RATIO / 2, IMAGE_WIDTH, CV_8UC1);
+    cv::randu(yuv, 0, 256);
+    src_.data = yuv.data;
+    src_.uvData = yuv.data + IMAGE_WIDTH * IMAGE_HEIGHT;
+    src_.format = LetterboxSourceFormat::NV12;
+    param_.bgrOutput = true;
+    param_.interpolation = LetterboxInterpolation::NEAREST;
+    cv::Mat bgr;
+    cv::cvtColor(yuv, bgr, cv::COLOR_YUV2BGR_NV12);
+    EXPECT_EQ(cv::norm(Reference(bgr, cv::INTER_NEAREST), Resize(CV_8UC3, 1), cv::NORM_INF), 0);
+    src_.format = LetterboxSourceFormat::NV21;
+    param_.bgrOutput = false;
+    param_.interpolation = LetterboxInterpolation::BILINEAR;
+    cv::Mat rgb;
+    cv::cvtColor(yuv, rgb, cv::COLOR_YUV2RGB_NV21);
+    EXPECT_LE(cv::norm(Reference(rgb, cv::INTER_LINEAR), Resize(CV_8UC3, 2), cv::NORM_INF), 1);
+}
+
+TEST_F(LetterboxResizerTest, FillBorder_Should_Keep_Resized_Area)
+{
+    cv::Mat dst(PADDING_HEIGHT, PADDING_WIDTH, CV_8UC3, cv::Scalar::all(1));
+    size_t size = dst.total() * dst.elemSize();
+    EXPECT_EQ(LetterboxResizer::FillBorder(param_, TENSOR_DTYPE_UINT8, dst.data, size), APP_ERR_OK);
+    const LetterboxGeometry& geometry = param_.geometry;
+    cv::Rect area(geometry.left, geometry.top, geometry.resizeWidth, geometry.resizeHeight);
+    EXPECT_EQ(cv::countNonZero(dst(area).reshape(1) != 1), 0);
+    EXPECT_EQ(dst.at<cv::Vec3b>(0, 0), cv::Vec3b(114, 0, 255));
+    EXPECT_EQ(dst.at<cv::Vec3b>(PADDING_HEIGHT - 1, PADDING_WIDTH - 1), cv::Vec3b(114, 0, 255));
+}
+
+TEST_F(LetterboxResizerTest, Resize_Should_Return_Fail_When_Param_Invalid)
+{
+    std::vector<uint8_t> result(LetterboxResizer::GetOutputSize(TENSOR_DTYPE_UINT8, param_.geometry));
+    EXPECT_EQ(LetterboxResizer::Resize(src_, param_, nullptr, result.size()), APP_ERR_COMM_INVALID_POINTER);
+    EXPECT_EQ(LetterboxResizer::Resize(src_, param_, result.data(), result.size() - 1), APP_ERR_COMM_INVALID_PARAM);
+    LetterboxParam param = param_;
+    param.geometry.left = PADDING_WIDTH;
+    EXPECT_EQ(LetterboxResizer::Resize(src_, param, result.data(), result.size()), APP_ERR_COMM_INVALID_PARAM);
+    LetterboxImage src = src_;
+    src.format = LetterboxSourceFormat::NV12;
+    EXPECT_EQ(LetterboxResizer::Resize(src, param_, result.data(), result.size()), APP_ERR_COMM_INVALID_POINTER);
+    src = src_;
+    src.dataType = TENSOR_DTYPE_INT32;
+    EXPECT_EQ(LetterboxResizer::Resize(src, param_, result.data(), result.size()), APP_ERR_COMM_INVALID_PARAM);
+}
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -31,6 +31,7 @@
 #include "MxBase/Utils/StringUtils.h"
 #include "MxBase/DeviceManager/DeviceManager.h"
 #include "MxBase/E2eInfer/GlobalInit/GlobalInit.h"
+#include "MxBase/MemoryHelper/CustomizedMemoryHelper.h"
 
 namespace {
 using namespace std;
@@ -99,20 +100,95 @@ TEST_F(WarpAffineTest, TestWarpAffine)
     }
 }
 
-void WarpAffineMockFuc(InputArray src, OutputArray dst, InputArray M, Size dsize, int flags = INTER_LINEAR,
-    int borderMode = BORDER_CONSTANT, const Scalar &borderValue = Scalar())
+const int NV12_WIDTH = 90;
+const int NV12_HEIGHT = 70;
+const int NV12_STRIDE = 96;
+const int MAX_PIXEL_DIFF = 1;
+
+cv::Mat MakeNv12(unsigned int seed)
 {
-    cv::Mat image = cv::imread("face.jpg");
-    image.copyTo(dst);
+    cv::Mat nv12(NV12_HEIGHT * 3 / 2, NV12_STRIDE, CV_8UC1);
+    cv::RNG rng(seed);
+    rng.fill(nv12, cv::RNG::UNIFORM, 0, 256);
+    return nv12;
+}
+
+Nv12HostPlanes GetPlanes(const cv::Mat &nv12, uint32_t top, uint32_t rows)
+{
+    Nv12HostPlanes planes;
+    planes.width = NV12_WIDTH;
+    planes.height = NV12_HEIGHT;
+    planes.stride = NV12_STRIDE;
+    planes.top = top;
+    planes.rows = rows;
+    planes.yPlane = nv12.ptr<uint8_t>(top);
+    planes.uvPlane = nv12.ptr<uint8_t>(NV12_HEIGHT + top / 2);
+    return planes;
+}
+
+TEST_F(WarpAffineTest, TestWarpNv12ToBgr_Should_Match_CvtColor_And_WarpAffine)
+{
+    cv::Mat nv12 = MakeNv12(1);
+    cv::Mat bgr;
+    cv::cvtColor(nv12(cv::Rect(0, 0, NV12_WIDTH, NV12_HEIGHT * 3 / 2)).clone(), bgr, cv::COLOR_YUV2BGR_NV12);
+    const double angle = 0.4;
+    const double scale = 1.7;
+    double matrix[AFFINE_MATRIX_LEN] = {
+        std::cos(angle) * scale, -std::sin(angle) * scale, 10., std::sin(angle) * scale, std::cos(angle) * scale, -30.};
+    cv::Mat expect;
+    cv::warpAffine(bgr, expect, cv::Mat(2, 3, CV_64F, matrix), cv::Size(NORMAL_LENGTH, NORMAL_LENGTH));
+
+    cv::Mat result(NORMAL_LENGTH, NORMAL_LENGTH, CV_8UC3);
+    auto ret = WarpAffine::WarpNv12ToBgr(GetPlanes(nv12, 0, NV12_HEIGHT), matrix, result.data, NORMAL_LENGTH,
+                                         NORMAL_LENGTH);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_LE(cv::norm(expect, result, cv::NORM_INF), MAX_PIXEL_DIFF);
 }
 
-void WarpAffineMockFuc2(InputArray src, OutputArray dst, InputArray M, Size dsize, int flags = INTER_LINEAR,
-    int borderMode = BORDER_CONSTANT, const Scalar &borderValue = Scalar())
-{}
+TEST_F(WarpAffineTest, TestWarpNv12ToBgr_Should_Only_Read_Source_Rows)
+{
+    cv::Mat nv12 = MakeNv12(2);
+    const double scale = 4.;
+    double matrix[AFFINE_MATRIX_LEN] = {scale, 0., -40., 0., scale, -60.};
+    uint32_t top = 0;
+    uint32_t rows = 0;
+    WarpAffine::GetSourceRows(matrix, NV12_HEIGHT, NORMAL_LENGTH, NORMAL_LENGTH, top, rows);
+    EXPECT_EQ(top % 2, 0u);
+    EXPECT_GT(rows, 0u);
+    EXPECT_LT(rows, static_cast<uint32_t>(NV12_HEIGHT));
+
+    cv::Mat full(NORMAL_LENGTH, NORMAL_LENGTH, CV_8UC3);
+    cv::Mat band(NORMAL_LENGTH, NORMAL_LENGTH, CV_8UC3);
+    EXPECT_EQ(WarpAffine::WarpNv12ToBgr(GetPlanes(nv12, 0, NV12_HEIGHT), matrix, full.data, NORMAL_LENGTH,
+                                        NORMAL_LENGTH), APP_ERR_OK);
+    EXPECT_EQ(WarpAffine::WarpNv12ToBgr(GetPlanes(nv12, top, rows), matrix, band.data, NORMAL_LENGTH,
+                                        NORMAL_LENGTH), APP_ERR_OK);
+    EXPECT_EQ(cv::norm(full, band, cv::NORM_INF), 0);
+
+    // the output maps below the picture
+    double outside[AFFINE_MATRIX_LEN] = {1., 0., 0., 0., 1., -1000.};
+    WarpAffine::GetSourceRows(outside, NV12_HEIGHT, NORMAL_LENGTH, NORMAL_LENGTH, top, rows);
+    EXPECT_EQ(rows, 0u);
+}
+
+TEST_F(WarpAffineTest, TestWarpNv12ToBgr_Should_Return_Fail_When_Band_Invalid)
+{
+    cv::Mat nv12 = MakeNv12(3);
+    double matrix[AFFINE_MATRIX_LEN] = {1., 0., 0., 0., 1., 0.};
+    cv::Mat result(NORMAL_LENGTH, NORMAL_LENGTH, CV_8UC3);
+    Nv12HostPlanes planes = GetPlanes(nv12, 1, NV12_HEIGHT - 1);
+    EXPECT_EQ(WarpAffine::WarpNv12ToBgr(planes, matrix, result.data, NORMAL_LENGTH, NORMAL_LENGTH),
+              APP_ERR_COMM_INVALID_PARAM);
+    planes = GetPlanes(nv12, 0, NV12_HEIGHT + 2);
+    EXPECT_EQ(WarpAffine::WarpNv12ToBgr(planes, matrix, result.data, NORMAL_LENGTH, NORMAL_LENGTH),
+              APP_ERR_COMM_INVALID_PARAM);
+    planes = GetPlanes(nv12, 0, NV12_HEIGHT);
+    EXPECT_EQ(WarpAffine::WarpNv12ToBgr(planes, matrix, nullptr, NORMAL_LENGTH, NORMAL_LENGTH),
+              APP_ERR_COMM_INVALID_POINTER);
+}
 
 TEST_F(WarpAffineTest, TestWarpAffine_When_Different_picHeight_picWidth)
 {
-    MOCKER_CPP(&cv::warpAffine).stubs().will(invoke(WarpAffineMockFuc));
     std::shared_ptr<DvppWrapper> g_dvppJpegDecoder = MemoryHelper::MakeShared<DvppWrapper>();
     JpegDecodeChnConfig jpegConfig;
     g_dvppJpegDecoder->InitJpegDecodeChannel(jpegConfig);
@@ -135,9 +211,10 @@ TEST_F(WarpAffineTest, TestWarpAffine_When_Different_picHeight_picWidth)
     ret = warpAffine.Process(inputDataVec, outputDataVec, keyPointInfoVec, NORMAL_LENGTH, ALIGN_LENGTH);
     EXPECT_EQ(ret, APP_ERR_OK);
 
-    // picWidth not align
+    // picWidth not align, the output of the last call is written in place
     ret = warpAffine.Process(inputDataVec, outputDataVec, keyPointInfoVec, NORMAL_LENGTH, NORMAL_LENGTH);
-    EXPECT_EQ(ret, APP_ERR_ACL_BAD_COPY);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(outputDataVec[0].dataSize, static_cast<uint32_t>(NORMAL_LENGTH * NORMAL_LENGTH * 3));
 
     // picWidth > MAX_EDGE
     ret = warpAffine.Process(inputDataVec, outputDataVec, keyPointInfoVec, NORMAL_LENGTH, OVER_MAX_EDGE);
@@ -198,9 +275,9 @@ TEST_F(WarpAffineTest, TestWarpAffine_Should_Return_Fail_When_Input_Null)
     EXPECT_EQ(ret, APP_ERR_COMM_INVALID_POINTER);
 }
 
-TEST_F(WarpAffineTest, TestWarpAffine_Should_Return_Fail_When_Mock_Null_For_CvWarpAffine)
+TEST_F(WarpAffineTest, TestWarpAffine_Should_Return_Fail_When_Device_Malloc_Fail)
 {
-    MOCKER_CPP(&cv::warpAffine).stubs().will(invoke(WarpAffineMockFuc2));
+    MOCKER_CPP(&DeviceMemoryMallocFunc).times(1).will(returnValue(1));
     std::shared_ptr<DvppWrapper> g_dvppJpegDecoder = MemoryHelper::MakeShared<DvppWrapper>();
     JpegDecodeChnConfig jpegConfig;
     g_dvppJpegDecoder->InitJpegDecodeChannel(jpegConfig);
@@ -20,7 +20,10 @@
  * History: NA
  */
 
+#include <sched.h>
+#include <thread>
 #include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
 #include "acl/acl.h"
 #include "MxBase/DeviceManager/DeviceManager.h"
 
@@ -38,6 +41,7 @@ public:
     virtual void TearDown()
     {
         std::cout << "TearDown()";
+        GlobalMockObject::verify();
         m = nullptr;
     }
     MxBase::DeviceManager *m = nullptr;
@@ -132,6 +136,106 @@ TEST_F(TestDevice, Test_GetDevicesCount_Should_Return_Success_And_Compatible_Wit
     EXPECT_EQ(device.devStatus, MxBase::DeviceContext::DeviceStatus::USING);
 }
 
+TEST_F(TestDevice, Test_SetDevice_Should_Not_Call_Acl_When_Thread_Is_Bound)
+{
+    MxBase::DeviceContext device;
+    device.devId = 0;
+    APP_ERROR ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    MOCKER_CPP(&aclrtSetCurrentContext).expects(never());
+    MOCKER_CPP(&aclrtCreateContext).expects(never());
+    ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestDevice, Test_SetDevice_Should_Set_Context_Once_On_New_Thread)
+{
+    MxBase::DeviceContext device;
+    device.devId = 0;
+    APP_ERROR ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    MOCKER_CPP(&aclrtSetCurrentContext).expects(once()).will(returnValue(0));
+    APP_ERROR threadRet = APP_ERR_COMM_FAILURE;
+    std::thread thread([this, device, &threadRet]() {
+        threadRet = m->SetDevice(device);
+        if (threadRet == APP_ERR_OK) {
+            threadRet = m->SetDevice(device);
+        }
+    });
+    thread.join();
+    EXPECT_EQ(threadRet, APP_ERR_OK);
+}
+
+TEST_F(TestDevice, Test_SetDevice_Should_Set_Context_Again_After_InvalidateThreadBinding)
+{
+    MxBase::DeviceContext device;
+    device.devId = 0;
+    APP_ERROR ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    m->InvalidateThreadBinding();
+    MOCKER_CPP(&aclrtSetCurrentContext).expects(once()).will(returnValue(0));
+    ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestDevice, Test_SetDevice_Should_Return_Fail_When_SetCurrentContext_Fail)
+{
+    MxBase::DeviceContext device;
+    device.devId = 0;
+    APP_ERROR ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    m->InvalidateThreadBinding();
+    MOCKER_CPP(&aclrtSetCurrentContext).times(1).will(returnValue(-1));
+    ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_ACL_FAILURE);
+    GlobalMockObject::verify();
+    // the failed call does not bind the thread
+    ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestDevice, Test_SetDeviceAffinity_Should_Bind_Cpus_Of_Threads_Set_To_Device)
+{
+    APP_ERROR ret = m->SetDeviceAffinity(0, {0});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    bool bound = false;
+    std::thread thread([this, &bound]() {
+        MxBase::DeviceContext device;
+        device.devId = 0;
+        if (m->SetDevice(device) != APP_ERR_OK) {
+            return;
+        }
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        sched_getaffinity(0, sizeof(cpuSet), &cpuSet);
+        bound = CPU_COUNT(&cpuSet) == 1 && CPU_ISSET(0, &cpuSet);
+    });
+    thread.join();
+    EXPECT_TRUE(bound);
+    ret = m->SetDeviceAffinity(0, {});
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestDevice, Test_SetDeviceAffinity_Should_Return_Fail_When_Param_Is_Invalid)
+{
+    APP_ERROR ret = m->SetDeviceAffinity(INVALID_DEVICE_ID_1, {0});
+    EXPECT_EQ(ret, APP_ERR_COMM_INVALID_PARAM);
+    ret = m->SetDeviceAffinity(0, {CPU_SETSIZE});
+    EXPECT_EQ(ret, APP_ERR_COMM_INVALID_PARAM);
+}
+
+TEST_F(TestDevice, Test_GetNumaNodeCpus_Should_Return_Cpus_Of_Node_Zero)
+{
+    std::vector<uint32_t> cpuIds;
+    APP_ERROR ret = MxBase::DeviceManager::GetNumaNodeCpus(0, cpuIds);
+    if (ret == APP_ERR_COMM_NO_EXIST) {
+        // no numa node on the machine
+        return;
+    }
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_FALSE(cpuIds.empty());
+}
+
 // release all devices
 TEST_F(TestDevice, Test_DestroyDevices_Should_Return_Success_And_Compatible_With_GetDevicesCount)
 {
@@ -149,6 +253,15 @@ TEST_F(TestDevice, Test_DestroyDevices_Should_Return_Success_Second_Times)
     EXPECT_EQ(ret, APP_ERR_OK);
 }
 
+TEST_F(TestDevice, Test_SetDevice_Should_Not_Keep_Thread_Binding_After_DestroyDevices)
+{
+    MxBase::DeviceContext device;
+    device.devId = 0;
+    MOCKER_CPP(&aclrtSetDevice).expects(once()).will(returnValue(-1));
+    APP_ERROR ret = m->SetDevice(device);
+    EXPECT_EQ(ret, APP_ERR_ACL_FAILURE);
+}
+
 // release all devices
 TEST_F(TestDevice, Test_DestroyDevices_Should_Return_Success_Third_Times)
 {
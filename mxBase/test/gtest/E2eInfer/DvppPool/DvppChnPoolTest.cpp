@@ -0,0 +1,267 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Host side cases of the dvpp channel pool with fake channels.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <gtest/gtest.h>
+#include "MxBase/E2eInfer/GlobalInit/GlobalInit.h"
+#include "ResourceManager/DvppPool/DvppChnPool.h"
+
+namespace {
+    using namespace MxBase;
+
+    constexpr uint32_t IDLE_TIMEOUT_MS = 50;
+
+    class DvppChnPoolTest : public testing::Test {
+    protected:
+        std::unique_ptr<DvppChnPool> MakePool(uint32_t minChnNum, uint32_t maxChnNum, uint32_t idleTimeoutMs = 0)
+        {
+            DvppChnPoolCfg cfg;
+            cfg.minChnNum = minChnNum;
+            cfg.maxChnNum = maxChnNum;
+            cfg.idleTimeoutMs = idleTimeoutMs;
+            return std::unique_ptr<DvppChnPool>(new DvppChnPool("fake", cfg,
+                [this](hi_s32& chnId) { return CreateChn(chnId); },
+                [this](hi_s32 chnId) { return DestroyChn(chnId); }));
+        }
+
+        APP_ERROR CreateChn(hi_s32& chnId)
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            if (createFail_) {
+                return APP_ERR_COMM_FAILURE;
+            }
+            while (aliveChns_.count(chnId) > 0) {
+                chnId++;
+            }
+            aliveChns_.insert(chnId);
+            return APP_ERR_OK;
+        }
+
+        APP_ERROR DestroyChn(hi_s32 chnId)
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            return aliveChns_.erase(chnId) > 0 ? APP_ERR_OK : APP_ERR_COMM_FAILURE;
+        }
+
+        size_t AliveChnNum()
+        {
+            std::lock_guard<std::mutex> lck(mtx_);
+            return aliveChns_.size();
+        }
+
+        std::mutex mtx_;
+        std::set<hi_s32> aliveChns_;
+        bool createFail_ = false;
+    };
+
+    TEST_F(DvppChnPoolTest, Test_Init_Should_Create_MinChnNum_Channels)
+    {
+        auto pool = MakePool(2, 4);
+        EXPECT_EQ(pool->Init(), APP_ERR_OK);
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.chnNum, 2U);
+        EXPECT_EQ(stats.idleChnNum, 2U);
+        EXPECT_EQ(stats.growCount, 0U);
+        EXPECT_EQ(AliveChnNum(), 2U);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+        EXPECT_EQ(AliveChnNum(), 0U);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Init_Should_Return_Fail_When_Create_Failed)
+    {
+        createFail_ = true;
+        auto pool = MakePool(1, 1);
+        EXPECT_EQ(pool->Init(), APP_ERR_COMM_INIT_FAIL);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Grow_Up_To_MaxChnNum_Then_Return_Busy)
+    {
+        auto pool = MakePool(1, 2);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* first = nullptr;
+        DvppChnSlot* second = nullptr;
+        DvppChnSlot* third = nullptr;
+        EXPECT_EQ(pool->Get(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Get(second, false), APP_ERR_OK);
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        EXPECT_NE(first->chnId, second->chnId);
+        EXPECT_EQ(pool->Get(third, false), APP_ERR_COMM_BUSY);
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.chnNum, 2U);
+        EXPECT_EQ(stats.idleChnNum, 0U);
+        EXPECT_EQ(stats.growCount, 1U);
+        EXPECT_EQ(AliveChnNum(), 2U);
+        EXPECT_EQ(pool->Put(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(second, false), APP_ERR_OK);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Not_Grow_Lowered_Pool_When_MaxChnNum_Is_Default)
+    {
+        AppGlobalCfgExtra globalCfgExtra;
+        globalCfgExtra.vpcChnNum = 2;
+        auto pool = MakePool(globalCfgExtra.vpcChnNum, globalCfgExtra.vpcMaxChnNum);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* first = nullptr;
+        DvppChnSlot* second = nullptr;
+        DvppChnSlot* third = nullptr;
+        EXPECT_EQ(pool->Get(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Get(second, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Get(third, false), APP_ERR_COMM_BUSY);
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.chnNum, 2U);
+        EXPECT_EQ(stats.growCount, 0U);
+        EXPECT_EQ(AliveChnNum(), 2U);
+        EXPECT_EQ(pool->Put(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(second, false), APP_ERR_OK);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Return_Busy_When_Grow_Failed)
+    {
+        auto pool = MakePool(1, 2);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* first = nullptr;
+        DvppChnSlot* second = nullptr;
+        EXPECT_EQ(pool->Get(first, false), APP_ERR_OK);
+        createFail_ = true;
+        EXPECT_EQ(pool->Get(second, false), APP_ERR_COMM_BUSY);
+        EXPECT_EQ(pool->Put(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Put_Should_Shrink_Idle_Channels_Over_MinChnNum)
+    {
+        auto pool = MakePool(1, 2, IDLE_TIMEOUT_MS);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* first = nullptr;
+        DvppChnSlot* second = nullptr;
+        ASSERT_EQ(pool->Get(first, false), APP_ERR_OK);
+        ASSERT_EQ(pool->Get(second, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(second, false), APP_ERR_OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_TIMEOUT_MS * 2));
+        // the channel just put back is kept, the one idle for longer than the timeout is destroyed
+        EXPECT_EQ(pool->Put(first, true), APP_ERR_OK);
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.chnNum, 1U);
+        EXPECT_EQ(stats.shrinkCount, 1U);
+        EXPECT_EQ(AliveChnNum(), 1U);
+        EXPECT_TRUE(pool->TakeCached(first));
+        EXPECT_EQ(pool->Put(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Shrink_Idle_Channels_Over_MinChnNum)
+    {
+        auto pool = MakePool(1, 2, IDLE_TIMEOUT_MS);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* first = nullptr;
+        DvppChnSlot* second = nullptr;
+        ASSERT_EQ(pool->Get(first, false), APP_ERR_OK);
+        ASSERT_EQ(pool->Get(second, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(first, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(second, false), APP_ERR_OK);
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_TIMEOUT_MS * 2));
+        DvppChnSlot* slot = nullptr;
+        EXPECT_EQ(pool->Get(slot, false), APP_ERR_OK);
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.chnNum, 1U);
+        EXPECT_EQ(stats.shrinkCount, 1U);
+        EXPECT_EQ(AliveChnNum(), 1U);
+        EXPECT_EQ(pool->Put(slot, false), APP_ERR_OK);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_TakeCached_Should_Fail_When_Cached_Channel_Stolen)
+    {
+        auto pool = MakePool(1, 1);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* cached = nullptr;
+        ASSERT_EQ(pool->Get(cached, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(cached, true), APP_ERR_OK);
+        EXPECT_TRUE(pool->TakeCached(cached));
+        EXPECT_EQ(pool->Put(cached, true), APP_ERR_OK);
+        // another thread finds the pool empty and takes the cached channel
+        DvppChnSlot* stolen = nullptr;
+        std::thread other([&pool, &stolen]() { EXPECT_EQ(pool->Get(stolen, false), APP_ERR_OK); });
+        other.join();
+        EXPECT_EQ(stolen, cached);
+        EXPECT_FALSE(pool->TakeCached(cached));
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.cacheHitCount, 1U);
+        EXPECT_EQ(stats.getCount, 3U);
+        EXPECT_EQ(pool->Put(stolen, false), APP_ERR_OK);
+        EXPECT_EQ(pool->Put(stolen, false), APP_ERR_COMM_INVALID_PARAM);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Wake_Up_When_Channel_Put_Back)
+    {
+        auto pool = MakePool(1, 1);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        for (bool cache : {false, true}) {
+            DvppChnSlot* slot = nullptr;
+            ASSERT_EQ(pool->Get(slot, false), APP_ERR_OK);
+            DvppChnSlot* waited = nullptr;
+            APP_ERROR waitRet = APP_ERR_COMM_FAILURE;
+            std::thread waiter([&pool, &waited, &waitRet]() { waitRet = pool->Get(waited, true); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_TIMEOUT_MS));
+            // a channel cached by the thread is found by the waiter as well
+            EXPECT_EQ(pool->Put(slot, cache), APP_ERR_OK);
+            waiter.join();
+            EXPECT_EQ(waitRet, APP_ERR_OK);
+            EXPECT_EQ(waited, slot);
+            EXPECT_EQ(pool->Put(waited, false), APP_ERR_OK);
+        }
+        DvppPoolStats stats;
+        pool->GetStats(stats);
+        EXPECT_EQ(stats.waitCount, 2U);
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+    }
+
+    TEST_F(DvppChnPoolTest, Test_Get_Should_Return_Stopped_When_DeInit_While_Waiting)
+    {
+        auto pool = MakePool(1, 1);
+        ASSERT_EQ(pool->Init(), APP_ERR_OK);
+        DvppChnSlot* slot = nullptr;
+        ASSERT_EQ(pool->Get(slot, false), APP_ERR_OK);
+        DvppChnSlot* waited = nullptr;
+        APP_ERROR waitRet = APP_ERR_OK;
+        std::thread waiter([&pool, &waited, &waitRet]() { waitRet = pool->Get(waited, true); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_TIMEOUT_MS));
+        EXPECT_EQ(pool->DeInit(), APP_ERR_OK);
+        waiter.join();
+        EXPECT_EQ(waitRet, APP_ERR_QUEUE_STOPED);
+        // the channel in use is left to its holder
+        EXPECT_EQ(AliveChnNum(), 1U);
+    }
+}
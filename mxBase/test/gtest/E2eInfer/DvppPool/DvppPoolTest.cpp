@@ -129,6 +129,50 @@ namespace {
         EXPECT_EQ(ret, APP_ERR_COMM_INVALID_PARAM);
     }
 
+    TEST_F(DvppPoolTest, Test_VpcPool_GetChn_Should_Reuse_Cached_Chn_On_Same_Thread) {
+        int32_t deviceId = 0;
+        hi_s32 channelId = -1;
+        APP_ERROR ret = DvppPool::GetInstance().GetChn(deviceId, channelId, DvppChnType::VPC);
+        if (!(DeviceManager::IsAscend310P() || DeviceManager::IsAtlas800IA2())) {
+            // the pool itself is covered on any host by DvppChnPoolTest
+            EXPECT_EQ(ret, APP_ERR_COMM_FAILURE);
+            EXPECT_EQ(DvppPool::GetInstance().TryGetChn(deviceId, channelId, DvppChnType::VPC), APP_ERR_COMM_FAILURE);
+            return;
+        }
+        EXPECT_EQ(ret, APP_ERR_OK);
+        EXPECT_EQ(DvppPool::GetInstance().PutChn(deviceId, channelId, DvppChnType::VPC), APP_ERR_OK);
+        DvppPoolStats stats;
+        EXPECT_EQ(DvppPool::GetInstance().GetPoolStats(deviceId, DvppChnType::VPC, stats), APP_ERR_OK);
+        hi_s32 cachedChannelId = -1;
+        EXPECT_EQ(DvppPool::GetInstance().TryGetChn(deviceId, cachedChannelId, DvppChnType::VPC), APP_ERR_OK);
+        EXPECT_EQ(cachedChannelId, channelId);
+        DvppPoolStats newStats;
+        EXPECT_EQ(DvppPool::GetInstance().GetPoolStats(deviceId, DvppChnType::VPC, newStats), APP_ERR_OK);
+        EXPECT_EQ(newStats.cacheHitCount, stats.cacheHitCount + 1);
+        EXPECT_EQ(newStats.idleChnNum + 1, newStats.chnNum);
+        EXPECT_EQ(DvppPool::GetInstance().PutChn(deviceId, cachedChannelId, DvppChnType::VPC), APP_ERR_OK);
+    }
+
+    TEST_F(DvppPoolTest, Test_VpcPool_PutChn_Should_Return_Fail_When_Chn_Not_In_Use) {
+        int32_t deviceId = 0;
+        hi_s32 channelId = -1;
+        APP_ERROR ret = DvppPool::GetInstance().GetChn(deviceId, channelId, DvppChnType::VPC);
+        if (DeviceManager::IsAscend310P() || DeviceManager::IsAtlas800IA2()) {
+            EXPECT_EQ(ret, APP_ERR_OK);
+            EXPECT_EQ(DvppPool::GetInstance().PutChn(deviceId, channelId, DvppChnType::VPC), APP_ERR_OK);
+        } else {
+            EXPECT_EQ(ret, APP_ERR_COMM_FAILURE);
+        }
+        EXPECT_NE(DvppPool::GetInstance().PutChn(deviceId, channelId, DvppChnType::VPC), APP_ERR_OK);
+    }
+
+    TEST_F(DvppPoolTest, Test_DvppPool_GetPoolStats_Should_Return_Fail_When_DeviceId_Is_Invalid) {
+        int32_t deviceId = 100;
+        DvppPoolStats stats;
+        APP_ERROR ret = DvppPool::GetInstance().GetPoolStats(deviceId, DvppChnType::VPC, stats);
+        EXPECT_EQ(ret, APP_ERR_COMM_INVALID_PARAM);
+    }
+
     TEST_F(DvppPoolTest, Test_DvppPool_DeInit_Should_Return_Success) {
         APP_ERROR ret = DvppPool::GetInstance().DeInit();
         EXPECT_EQ(ret, APP_ERR_OK);
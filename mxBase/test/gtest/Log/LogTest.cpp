@@ -22,9 +22,11 @@
 
 #include <map>
 #include <regex>
+#include <thread>
 #include <gtest/gtest.h>
 #include "MxBase/Log/Log.h"
 #include "MxBase/Utils/FileUtils.h"
+#include "Utils/Log/AsyncLogWriter.h"
 
 using namespace MxBase;
 
@@ -216,6 +218,206 @@ TEST_F(LogTest, LogRotateByTime)
     }
     EXPECT_GE(rotateDay, infoLogSize);
 }
+
+int g_formatCount = 0;
+
+std::string CountFormat()
+{
+    ++g_formatCount;
+    return "formatted";
+}
+
+void RemoveAsyncLogDir(const std::string& dir)
+{
+    std::vector<std::string> files;
+    MxBase::FileUtils::ListFiles(dir, files, true, false);
+    for (auto& file : files) {
+        remove(file.c_str());
+    }
+    for (auto& link : {"LogTest.INFO", "LogTest.WARNING", "LogTest.ERROR"}) {
+        unlink((dir + link).c_str());
+    }
+    MxBase::FileUtils::RemoveDirectories(dir);
+}
+
+size_t CountLines(const std::string& content, const std::string& pattern)
+{
+    size_t count = 0;
+    for (size_t pos = content.find(pattern); pos != std::string::npos; pos = content.find(pattern, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+TEST_F(LogTest, LogSiteFlowControlAndRateLimit)
+{
+    int frequency = Log::logFlowControlFrequency_;
+    int rateLimit = Log::logRateLimit_;
+    Log::logFlowControlFrequency_ = 3;
+    Log::logRateLimit_ = 0;
+    LogSite site;
+    int passed = 0;
+    for (int i = 0; i < 6; i++) {
+        passed += site.Pass() ? 1 : 0;
+    }
+    EXPECT_EQ(passed, 2);
+
+    Log::logFlowControlFrequency_ = 1;
+    Log::logRateLimit_ = 2;
+    LogSite limitedSite;
+    passed = 0;
+    const int callNum = 100;
+    for (int i = 0; i < callNum; i++) {
+        passed += limitedSite.Pass() ? 1 : 0;
+    }
+    // the calls may straddle two windows of one second
+    EXPECT_LE(passed, 4);
+    EXPECT_EQ(static_cast<int>(limitedSite.suppressed.load()), callNum - passed);
+    Log::logFlowControlFrequency_ = frequency;
+    Log::logRateLimit_ = rateLimit;
+}
+
+TEST_F(LogTest, DisabledLevelIsNotFormatted)
+{
+    int minLogLevel = FLAGS_minloglevel;
+    FLAGS_minloglevel = LOG_LEVEL_WARN;
+    g_formatCount = 0;
+    LogInfo << CountFormat();
+    EXPECT_EQ(g_formatCount, 0);
+    LogWarn << CountFormat();
+    EXPECT_EQ(g_formatCount, 1);
+    FLAGS_minloglevel = minLogLevel;
+}
+
+TEST_F(LogTest, LogIsOneStatementWithItsOwnSite)
+{
+    int minLogLevel = FLAGS_minloglevel;
+    int frequency = Log::logFlowControlFrequency_;
+    FLAGS_minloglevel = LOG_LEVEL_INFO;
+    Log::logFlowControlFrequency_ = 2;
+    g_formatCount = 0;
+    // the else belongs to the if of the test, not to a hidden if of the macro
+    bool branch = false;
+    if (branch)
+        LogInfo << CountFormat();
+    else
+        branch = true;
+    EXPECT_TRUE(branch);
+    EXPECT_EQ(g_formatCount, 0);
+    // every call site counts its own lines, the second site is not skipped by the first one
+    for (int i = 0; i < 4; i++) {
+        LogInfo << "first site " << i;
+    }
+    LogInfo << CountFormat();
+    EXPECT_EQ(g_formatCount, 1);
+    Log::logFlowControlFrequency_ = frequency;
+    FLAGS_minloglevel = minLogLevel;
+}
+
+TEST_F(LogTest, ThreadLogBufferWrapsAndRejectsWhenFull)
+{
+    ThreadLogBuffer buffer(4096);
+    std::string line(100, 'a');
+    int pushed = 0;
+    while (buffer.Push(LOG_LEVEL_INFO, pushed, line.c_str(), line.size())) {
+        pushed++;
+    }
+    EXPECT_GT(pushed, 0);
+    std::vector<LogRecordView> records;
+    uint64_t position = buffer.Peek(records);
+    EXPECT_EQ(records.size(), static_cast<size_t>(pushed));
+    EXPECT_EQ(records.back().timeUs, pushed - 1);
+    buffer.Release(position);
+    EXPECT_EQ(buffer.Used(), 0U);
+    // the next records do not fit at the end of the ring and start over behind a padding record
+    for (int i = 0; i < pushed; i++) {
+        EXPECT_TRUE(buffer.Push(LOG_LEVEL_WARN, i, line.c_str(), line.size()));
+    }
+    records.clear();
+    buffer.Release(buffer.Peek(records));
+    EXPECT_EQ(records.size(), static_cast<size_t>(pushed));
+    EXPECT_EQ(std::string(records.front().data, records.front().len), line);
+    EXPECT_FALSE(buffer.Push(LOG_LEVEL_INFO, 0, line.c_str(), buffer.MaxRecordLength() + 1));
+}
+
+TEST_F(LogTest, AsyncLogFileRollsAndRetainsWithoutListing)
+{
+    const std::string dir = LOG_DIR + "async_file/";
+    MxBase::FileUtils::CreateDirectories(dir);
+    AsyncLogOptions options;
+    options.logDir = dir;
+    options.baseName = "mxsdk.log.LogTest.";
+    options.linkName = "LogTest";
+    options.rotateDay = 2;
+    options.rotateFileNumber = 3;
+    AsyncLogFile file(0, options);
+    const int64_t usPerDay = 86400LL * 1000000;
+    int64_t firstDay = 1700000000LL * 1000000;
+    std::string line = "I20231114 22:13:20.000000 1 LogTest.cpp:1] line\n";
+    for (int day = 0; day < 4; day++) {
+        std::vector<LogRecordView> records = {{firstDay + day * usPerDay, LOG_LEVEL_INFO, line.c_str(), line.size()}};
+        EXPECT_TRUE(file.Write(records, line.size() * 10));
+    }
+    // one file a day, the archived files two days older than the current one are removed as it is opened
+    std::vector<std::string> archived = file.GetArchivedFileNames();
+    EXPECT_EQ(archived.size(), 1U);
+    EXPECT_TRUE(MxBase::FileUtils::CheckFileExists(dir + archived[0]));
+    EXPECT_TRUE(MxBase::FileUtils::CheckFileExists(dir + file.GetFileName()));
+    file.Retain(1, 3);
+    EXPECT_TRUE(file.GetArchivedFileNames().empty());
+    EXPECT_FALSE(MxBase::FileUtils::CheckFileExists(dir + archived[0]));
+    file.Close();
+    RemoveAsyncLogDir(dir);
+}
+
+TEST_F(LogTest, AsyncLogWriterWritesAllThreads)
+{
+    const std::string dir = LOG_DIR + "async_writer/";
+    MxBase::FileUtils::CreateDirectories(dir);
+    AsyncLogOptions options;
+    options.logDir = dir;
+    options.baseName = "mxsdk.log.LogTest.";
+    options.linkName = "LogTest";
+    options.bufferSize = 64 * 1024;
+    options.overflowPolicy = LOG_OVERFLOW_BLOCK;
+    options.rotateDay = 7;
+    options.rotateFileNumber = 50;
+    AsyncLogWriter& writer = AsyncLogWriter::GetInstance();
+    ASSERT_EQ(writer.Start(options), APP_ERR_OK);
+    const int threadNum = 4;
+    const int lineNum = 1000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; i++) {
+        threads.emplace_back([]() {
+            for (int j = 0; j < lineNum; j++) {
+                LogInfo << "async info line " << j;
+            }
+            LogError << "async error line";
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    writer.Flush();
+    writer.Stop();
+    EXPECT_EQ(Log::GetDroppedMessageNumber(), 0U);
+    std::vector<std::string> files;
+    MxBase::FileUtils::ListFiles(dir, files, false, false);
+    size_t infoNum = 0;
+    size_t errorNum = 0;
+    for (auto& file : files) {
+        std::string content = FileUtils::ReadFileContent(dir + file, true);
+        if (file.find(".info.") != std::string::npos) {
+            infoNum += CountLines(content, "async info line");
+            errorNum += CountLines(content, "async error line");
+        } else if (file.find(".error.") != std::string::npos) {
+            EXPECT_EQ(CountLines(content, "async error line"), static_cast<size_t>(threadNum));
+        }
+    }
+    EXPECT_EQ(infoNum, static_cast<size_t>(threadNum * lineNum));
+    EXPECT_EQ(errorNum, static_cast<size_t>(threadNum));
+    RemoveAsyncLogDir(dir);
+}
 }
 
 int main(int argc, char* argv[])
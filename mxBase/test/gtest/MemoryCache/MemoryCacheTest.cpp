@@ -0,0 +1,253 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Gtest unit cases of the memory cache.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include "acl/acl.h"
+#include "MxBase/MemoryHelper/MemoryCache.h"
+#include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxBase/DeviceManager/DeviceManager.h"
+#include "MxBase/MemoryHelper/CustomizedMemoryHelper.h"
+#include "module/ResourceManager/DvppWrapper/DvppWrapperWithHiMpi/DvppWrapperWithHiMpi.h"
+
+using namespace MxBase;
+namespace {
+const size_t SMALL_SIZE = 1000;
+const size_t ROUNDED_SMALL_SIZE = 1024;
+const size_t LARGE_SIZE = 3 * 1024 * 1024;
+const size_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+const size_t DIRECT_SIZE = 32 * 1024 * 1024;
+const uint32_t THREAD_NUM = 4;
+const uint32_t LOOP_NUM = 1000;
+const uint32_t IMAGE_WIDTH = 64;
+const uint32_t IMAGE_HEIGHT = 64;
+const uint32_t RGB_CHANNEL_NUM = 3;
+
+class MemoryCacheTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        MemoryCacheConfig config;
+        config.maxBlockSize = MAX_BLOCK_SIZE;
+        APP_ERROR ret = MemoryCache::Enable(MemoryData::MEMORY_DEVICE, config);
+        ASSERT_EQ(ret, APP_ERR_OK);
+    }
+
+    void TearDown() override
+    {
+        GlobalMockObject::verify();
+        MemoryCache::Disable(MemoryData::MEMORY_DEVICE);
+    }
+
+    static MemoryCacheStats GetStats()
+    {
+        MemoryCacheStats stats;
+        MemoryCache::GetStats(MemoryData::MEMORY_DEVICE, stats);
+        return stats;
+    }
+};
+
+TEST_F(MemoryCacheTest, Test_MxbsMalloc_Should_Reuse_Block_When_Same_Size_Freed)
+{
+    MemoryData data(LARGE_SIZE, MemoryData::MEMORY_DEVICE);
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    void* ptr = data.ptrData;
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+    MemoryCacheStats before = GetStats();
+
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    EXPECT_EQ(data.ptrData, ptr);
+    MemoryCacheStats after = GetStats();
+    EXPECT_EQ(after.driverMallocCount, before.driverMallocCount);
+    EXPECT_EQ(after.hitCount, before.hitCount + 1);
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+}
+
+TEST_F(MemoryCacheTest, Test_MxbsMalloc_Should_Split_Small_Blocks_From_One_Segment)
+{
+    MemoryData first(SMALL_SIZE, MemoryData::MEMORY_DEVICE);
+    MemoryData second(SMALL_SIZE, MemoryData::MEMORY_DEVICE);
+    MemoryCacheStats before = GetStats();
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(first), APP_ERR_OK);
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(second), APP_ERR_OK);
+    MemoryCacheStats after = GetStats();
+    EXPECT_LE(after.driverMallocCount, before.driverMallocCount + 1);
+    EXPECT_EQ(after.allocatedSize, before.allocatedSize + ROUNDED_SMALL_SIZE * 2);
+    EXPECT_EQ(MemoryHelper::MxbsFree(first), APP_ERR_OK);
+    EXPECT_EQ(MemoryHelper::MxbsFree(second), APP_ERR_OK);
+    EXPECT_EQ(GetStats().allocatedSize, before.allocatedSize);
+}
+
+TEST_F(MemoryCacheTest, Test_MxbsMalloc_Should_Allocate_Directly_When_Size_Is_Over_Max_Block_Size)
+{
+    MemoryData data(DIRECT_SIZE, MemoryData::MEMORY_DEVICE);
+    MemoryCacheStats before = GetStats();
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    EXPECT_EQ(GetStats().directMallocCount, before.directMallocCount + 1);
+    EXPECT_EQ(GetStats().reservedSize, before.reservedSize);
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+}
+
+TEST_F(MemoryCacheTest, Test_Trim_Should_Release_Free_Segments)
+{
+    MemoryData data(LARGE_SIZE, MemoryData::MEMORY_DEVICE);
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+    EXPECT_GT(GetStats().reservedSize, 0);
+    EXPECT_EQ(MemoryCache::Trim(MemoryData::MEMORY_DEVICE), APP_ERR_OK);
+    EXPECT_EQ(GetStats().reservedSize, 0);
+}
+
+TEST_F(MemoryCacheTest, Test_MxbsFree_Should_Release_Segment_When_Over_Max_Cached_Size)
+{
+    MemoryCacheConfig config;
+    config.maxCachedSize = 0;
+    config.maxBlockSize = MAX_BLOCK_SIZE;
+    ASSERT_EQ(MemoryCache::Enable(MemoryData::MEMORY_DEVICE, config), APP_ERR_OK);
+    MemoryData data(LARGE_SIZE, MemoryData::MEMORY_DEVICE);
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+    EXPECT_EQ(GetStats().reservedSize, 0);
+}
+
+TEST_F(MemoryCacheTest, Test_MxbsMalloc_Should_Return_Fail_When_Driver_Malloc_Fail)
+{
+    MemoryCache::Trim(MemoryData::MEMORY_DEVICE);
+    MOCKER_CPP(&aclrtMalloc).stubs().will(returnValue(-1));
+    MemoryData data(LARGE_SIZE, MemoryData::MEMORY_DEVICE);
+    APP_ERROR ret = MemoryHelper::MxbsMalloc(data);
+    EXPECT_NE(ret, APP_ERR_OK);
+    EXPECT_EQ(data.ptrData, nullptr);
+}
+
+TEST_F(MemoryCacheTest, Test_Disable_Should_Return_Fail_When_Block_In_Use)
+{
+    MemoryData data(SMALL_SIZE, MemoryData::MEMORY_DEVICE);
+    ASSERT_EQ(MemoryHelper::MxbsMalloc(data), APP_ERR_OK);
+    EXPECT_EQ(MemoryCache::Disable(MemoryData::MEMORY_DEVICE), APP_ERR_COMM_BUSY);
+    EXPECT_EQ(MemoryHelper::MxbsFree(data), APP_ERR_OK);
+    EXPECT_EQ(MemoryCache::Disable(MemoryData::MEMORY_DEVICE), APP_ERR_OK);
+}
+
+TEST_F(MemoryCacheTest, Test_Enable_Should_Return_Fail_When_Type_Is_Host)
+{
+    EXPECT_EQ(MemoryCache::Enable(MemoryData::MEMORY_HOST), APP_ERR_COMM_INVALID_PARAM);
+    MemoryCacheStats stats;
+    EXPECT_EQ(MemoryCache::GetStats(MemoryData::MEMORY_HOST_NEW, stats), APP_ERR_COMM_INVALID_PARAM);
+}
+
+TEST_F(MemoryCacheTest, Test_MxbsMalloc_Should_Return_Success_When_Called_By_Threads)
+{
+    DeviceContext device;
+    device.devId = 0;
+    std::vector<std::thread> threads;
+    std::vector<APP_ERROR> rets(THREAD_NUM, APP_ERR_OK);
+    for (uint32_t i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([device, i, &rets]() {
+            DeviceManager::GetInstance()->SetDevice(device);
+            for (uint32_t j = 0; j < LOOP_NUM && rets[i] == APP_ERR_OK; j++) {
+                MemoryData data(SMALL_SIZE * (j + 1), MemoryData::MEMORY_DEVICE);
+                rets[i] = MemoryHelper::MxbsMalloc(data);
+                if (rets[i] == APP_ERR_OK) {
+                    rets[i] = MemoryHelper::MxbsFree(data);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto ret : rets) {
+        EXPECT_EQ(ret, APP_ERR_OK);
+    }
+    EXPECT_EQ(GetStats().allocatedSize, 0);
+}
+
+TEST_F(MemoryCacheTest, Test_DvppVenc_Should_Free_Yuv_Through_Cache_When_Rgb_Frame_Send_Fail)
+{
+    ASSERT_EQ(MemoryCache::Enable(MemoryData::MEMORY_DVPP), APP_ERR_OK);
+    MemoryCacheStats before;
+    MemoryCache::GetStats(MemoryData::MEMORY_DVPP, before);
+    MOCKER_CPP(&hi_mpi_venc_start_chn).stubs().will(returnValue(0));
+    MOCKER_CPP(&DvppWrapperWithHiMpi::DoVpcCvtColor).stubs().will(returnValue(APP_ERR_OK));
+    MOCKER_CPP(&hi_mpi_venc_send_frame).stubs().will(returnValue(-1));
+    std::vector<uint8_t> rgb(IMAGE_WIDTH * IMAGE_HEIGHT * RGB_CHANNEL_NUM);
+    DvppDataInfo inputDataInfo;
+    inputDataInfo.width = IMAGE_WIDTH;
+    inputDataInfo.height = IMAGE_HEIGHT;
+    inputDataInfo.widthStride = IMAGE_WIDTH;
+    inputDataInfo.heightStride = IMAGE_HEIGHT;
+    inputDataInfo.format = MXBASE_PIXEL_FORMAT_RGB_888;
+    inputDataInfo.data = rgb.data();
+    inputDataInfo.dataSize = rgb.size();
+    std::function<void(std::shared_ptr<uint8_t>, uint32_t, void**)> handleFunc =
+        [](std::shared_ptr<uint8_t>, uint32_t, void**) {};
+    DvppWrapperWithHiMpi dvppWrapper;
+    EXPECT_NE(dvppWrapper.DvppVenc(inputDataInfo, &handleFunc), APP_ERR_OK);
+    // the converted yuv image is a block of the cache, freeing it by the driver would leave the block allocated
+    MemoryCacheStats after;
+    MemoryCache::GetStats(MemoryData::MEMORY_DVPP, after);
+    EXPECT_GT(after.mallocCount, before.mallocCount);
+    EXPECT_EQ(after.allocatedSize, before.allocatedSize);
+    EXPECT_TRUE(dvppWrapper.rgbToYuvPtrMap_.empty());
+    EXPECT_EQ(MemoryCache::Disable(MemoryData::MEMORY_DVPP), APP_ERR_OK);
+}
+
+TEST_F(MemoryCacheTest, Test_GetInputAddrFromStream_Should_Free_Yuv_Through_Cache_When_Rgb_Frame_Encoded)
+{
+    ASSERT_EQ(MemoryCache::Enable(MemoryData::MEMORY_DVPP), APP_ERR_OK);
+    MemoryCacheStats before;
+    MemoryCache::GetStats(MemoryData::MEMORY_DVPP, before);
+    void* yuvData = nullptr;
+    ASSERT_EQ(DVPPMemoryMallocFunc(0, &yuvData, IMAGE_WIDTH * IMAGE_HEIGHT * RGB_CHANNEL_NUM), APP_ERR_OK);
+    std::vector<uint8_t> rgb(IMAGE_WIDTH * IMAGE_HEIGHT * RGB_CHANNEL_NUM);
+    DvppWrapperWithHiMpi dvppWrapper;
+    dvppWrapper.vencCvtColor_ = true;
+    dvppWrapper.rgbToYuvPtrMap_[yuvData] = rgb.data();
+    hi_venc_pack pack = {};
+    pack.input_addr = reinterpret_cast<uintptr_t>(yuvData);
+    hi_venc_stream stream = {};
+    stream.pack = &pack;
+    stream.pack_cnt = 1;
+    void* inputAddr = nullptr;
+    EXPECT_EQ(dvppWrapper.GetInputAddrFromStream(stream, &inputAddr), APP_ERR_OK);
+    EXPECT_EQ(inputAddr, static_cast<void*>(rgb.data()));
+    MemoryCacheStats after;
+    MemoryCache::GetStats(MemoryData::MEMORY_DVPP, after);
+    EXPECT_EQ(after.allocatedSize, before.allocatedSize);
+    EXPECT_EQ(MemoryCache::Disable(MemoryData::MEMORY_DVPP), APP_ERR_OK);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    DeviceManager::GetInstance()->InitDevices();
+    DeviceContext device;
+    device.devId = 0;
+    DeviceManager::GetInstance()->SetDevice(device);
+    testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    DeviceManager::GetInstance()->DestroyDevices();
+    return ret;
+}
@@ -0,0 +1,132 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: DT test for the ModelWeightRegistry.cpp file.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <fstream>
+#include <shared_mutex>
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include "acl/acl.h"
+#include "MxBase/MxBase.h"
+#include "ModelInfer/ModelWeightRegistry.h"
+
+namespace {
+using namespace MxBase;
+const std::string FAKE_MODEL_PATH = "./fake_shared_weight.om";
+const int32_t DEVICE_ID = 0;
+
+class ModelWeightRegistryTest : public testing::Test {
+protected:
+    void SetUp()
+    {
+        std::ofstream file(FAKE_MODEL_PATH, std::ios::binary);
+        file << "fake om model content";
+    }
+
+    void TearDown()
+    {
+        // clear mock
+        GlobalMockObject::verify();
+        remove(FAKE_MODEL_PATH.c_str());
+    }
+};
+
+TEST_F(ModelWeightRegistryTest, Test_LoadModel_Should_Return_Fail_When_Path_Is_Invalid)
+{
+    uint32_t modelId = 0;
+    std::shared_ptr<SharedModelWeight> weight = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().LoadModel("./not_exist.om", DEVICE_ID, modelId, weight);
+    EXPECT_EQ(ret, APP_ERR_COMM_NO_EXIST);
+    EXPECT_EQ(weight, nullptr);
+}
+
+TEST_F(ModelWeightRegistryTest, Test_LoadModel_Should_Return_Fail_When_QuerySize_Fail)
+{
+    MOCKER_CPP(&aclmdlQuerySizeFromMem).times(1).will(returnValue(1));
+    uint32_t modelId = 0;
+    std::shared_ptr<SharedModelWeight> weight = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight);
+    EXPECT_EQ(ret, APP_ERR_ACL_FAILURE);
+    EXPECT_EQ(ModelWeightRegistry::GetInstance().GetEntryCount(), 0);
+}
+
+TEST_F(ModelWeightRegistryTest, Test_LoadModel_Should_Share_Weight_When_Same_Model_Loaded_Twice)
+{
+    MOCKER_CPP(&aclmdlQuerySizeFromMem).times(1).will(returnValue(0));
+    MOCKER_CPP(&aclmdlLoadFromMemWithMem).times(2).will(returnValue(0));
+    uint32_t modelId = 0;
+    std::shared_ptr<SharedModelWeight> weight1 = nullptr;
+    std::shared_ptr<SharedModelWeight> weight2 = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight1);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight2);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(weight1.get(), weight2.get());
+    EXPECT_TRUE(weight1->isMapped);
+    EXPECT_EQ(ModelWeightRegistry::GetInstance().GetEntryCount(), 1);
+    weight1 = nullptr;
+    weight2 = nullptr;
+    EXPECT_EQ(ModelWeightRegistry::GetInstance().GetEntryCount(), 0);
+}
+
+TEST_F(ModelWeightRegistryTest, Test_LoadModel_Should_Keep_Weight_When_Load_Fail)
+{
+    MOCKER_CPP(&aclmdlQuerySizeFromMem).times(1).will(returnValue(0));
+    MOCKER_CPP(&aclmdlLoadFromMemWithMem).times(2).will(returnValue(0)).then(returnValue(1));
+    uint32_t modelId = 0;
+    std::shared_ptr<SharedModelWeight> weight1 = nullptr;
+    std::shared_ptr<SharedModelWeight> weight2 = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight1);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight2);
+    EXPECT_EQ(ret, APP_ERR_ACL_FAILURE);
+    EXPECT_EQ(weight2, nullptr);
+    EXPECT_EQ(ModelWeightRegistry::GetInstance().GetEntryCount(), 1);
+}
+
+TEST_F(ModelWeightRegistryTest, Test_AcquireWeight_Should_Share_Weight_Without_Loading_Model)
+{
+    MOCKER_CPP(&aclmdlQuerySizeFromMem).times(1).will(returnValue(0));
+    MOCKER_CPP(&aclmdlLoadFromMemWithMem).times(1).will(returnValue(0));
+    std::shared_ptr<SharedModelWeight> weight1 = nullptr;
+    APP_ERROR ret = ModelWeightRegistry::GetInstance().AcquireWeight(FAKE_MODEL_PATH, DEVICE_ID, weight1);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_NE(weight1, nullptr);
+    EXPECT_NE(weight1->modelData, nullptr);
+    uint32_t modelId = 0;
+    std::shared_ptr<SharedModelWeight> weight2 = nullptr;
+    ret = ModelWeightRegistry::GetInstance().LoadModel(FAKE_MODEL_PATH, DEVICE_ID, modelId, weight2);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(weight1.get(), weight2.get());
+    // a load waits for the instances inferring on the shared weights
+    std::shared_lock<std::shared_timed_mutex> inferLock(weight1->inferMutex);
+    EXPECT_FALSE(weight1->inferMutex.try_lock());
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    MxInit();
+    testing::InitGoogleTest(&argc, argv);
+    int ret = RUN_ALL_TESTS();
+    MxDeInit();
+    return ret;
+}
@@ -0,0 +1,243 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: OpPreloadCache test.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include "MxBase/Utils/FileUtils.h"
+#include "module/ResourceManager/HAL/AclApi.h"
+#include "module/ResourceManager/GlobalInit/OperationPreload/OpPreloadCache.h"
+#define private public
+#include "module/ResourceManager/GlobalInit/OperationPreload/GlobalOpMap.h"
+#undef private
+
+namespace {
+    using namespace MxBase;
+
+    const std::string SIGNATURE = "Add|Add|float;float|1,2;1,2|float|1,2|||";
+    constexpr double COST_MS = 12.5;
+    const std::vector<std::string> VERSIONS = {"7.0.0", "8.0.0"};
+    const std::string OP_CONFIG = R"({"Operations": [{"name": "Add", "preload_list": [
+        {"input_shape": "1,3,16,16;1,3,16,16", "input_type": "float;float",
+         "output_shape": "1,3,16,16", "output_type": "float"},
+        {"input_shape": "1,3,32,32;1,3,32,32", "input_type": "float;float",
+         "output_shape": "1,3,32,32", "output_type": "float"},
+        {"input_shape": "1,3,64,64;1,3,64,64", "input_type": "float;float",
+         "output_shape": "1,3,64,64", "output_type": "float"}]}]})";
+    constexpr size_t OP_SPEC_NUM = 3;
+
+    // Compiles nothing, counts the specifications it is asked to compile.
+    class FakeOpLoader : public OpLoader {
+    public:
+        FakeOpLoader() : OpLoader("Add") {}
+
+        APP_ERROR OpPreload(const JsonPtr &, size_t, std::string, OpSettings) override
+        {
+            preloadNum++;
+            return APP_ERR_OK;
+        }
+
+        std::atomic<size_t> preloadNum{0};
+    };
+
+    class OpPreloadCacheTest : public testing::Test {
+    protected:
+        void SetUp() override
+        {
+            cacheDir_ = "./OpPreloadCacheTest_" + std::to_string(getpid());
+            const char *ascendHomePath = std::getenv("ASCEND_HOME_PATH");
+            ascendHomePath_ = ascendHomePath == nullptr ? "" : ascendHomePath;
+        }
+
+        void TearDown() override
+        {
+            std::vector<std::string> files;
+            FileUtils::ListFiles(cacheDir_, files, true);
+            for (const auto &file : files) {
+                std::remove(file.c_str());
+            }
+            for (const auto &version : VERSIONS) {
+                FileUtils::RemoveDirectories(cacheDir_ + "/kernel_" + version);
+            }
+            FileUtils::RemoveDirectories(cacheDir_ + "/compiler");
+            FileUtils::RemoveDirectories(cacheDir_);
+            unsetenv("MX_OP_PRELOAD_CACHE_DIR");
+            unsetenv("MX_OP_PRELOAD_THREAD_NUM");
+            if (ascendHomePath_.empty()) {
+                unsetenv("ASCEND_HOME_PATH");
+            } else {
+                setenv("ASCEND_HOME_PATH", ascendHomePath_.c_str(), 1);
+            }
+            GlobalMockObject::verify();
+        }
+
+        // The config and the CANN version are put in the cache dir too, so that TearDown removes them.
+        void PrepareLoadAll(const std::string &threadNum)
+        {
+            ASSERT_TRUE(FileUtils::CreateDirectories(cacheDir_ + "/compiler"));
+            std::ofstream(cacheDir_ + "/compiler/version.info") << "Version=7.0.0" << std::endl;
+            std::ofstream(cacheDir_ + "/OpConfig.json") << OP_CONFIG;
+            setenv("ASCEND_HOME_PATH", cacheDir_.c_str(), 1);
+            setenv("MX_OP_PRELOAD_CACHE_DIR", cacheDir_.c_str(), 1);
+            setenv("MX_OP_PRELOAD_THREAD_NUM", threadNum.c_str(), 1);
+            MOCKER_CPP(&AclApi::aclSetCompileopt).stubs().will(returnValue(0));
+        }
+
+        // The loader of Add is replaced by the fake one, GlobalOpMap deletes it with the others.
+        FakeOpLoader *InitOpMap(GlobalOpMap &opMap)
+        {
+            opMap.InitLoaderMap();
+            auto fakeLoader = new FakeOpLoader();
+            delete opMap.g_LoaderMap["Add"];
+            opMap.g_LoaderMap["Add"] = fakeLoader;
+            opMap.opLoaderAdd = fakeLoader;
+            return fakeLoader;
+        }
+
+        std::string cacheDir_;
+        std::string ascendHomePath_;
+    };
+
+    TEST_F(OpPreloadCacheTest, Test_Open_EmptyDirFailed)
+    {
+        OpPreloadCache cache;
+        EXPECT_EQ(cache.Open("", "7.0.0"), APP_ERR_COMM_INVALID_PARAM);
+        EXPECT_FALSE(cache.IsOpen());
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_Record_FoundAfterReopen)
+    {
+        {
+            OpPreloadCache cache;
+            EXPECT_EQ(cache.Open(cacheDir_, "7.0.0"), APP_ERR_OK);
+            EXPECT_TRUE(FileUtils::CheckDirectoryExists(cache.GetKernelDir()));
+            double costMs = 0;
+            EXPECT_FALSE(cache.Find(SIGNATURE, costMs));
+            cache.Record(SIGNATURE, COST_MS);
+            EXPECT_EQ(cache.Save(), APP_ERR_OK);
+        }
+        OpPreloadCache cache;
+        EXPECT_EQ(cache.Open(cacheDir_, "7.0.0"), APP_ERR_OK);
+        double costMs = 0;
+        EXPECT_TRUE(cache.Find(SIGNATURE, costMs));
+        EXPECT_DOUBLE_EQ(costMs, COST_MS);
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_Record_KeepFirstCost)
+    {
+        OpPreloadCache cache;
+        EXPECT_EQ(cache.Open(cacheDir_, "7.0.0"), APP_ERR_OK);
+        cache.Record(SIGNATURE, COST_MS);
+        cache.Record(SIGNATURE, 1.0);
+        double costMs = 0;
+        EXPECT_TRUE(cache.Find(SIGNATURE, costMs));
+        EXPECT_DOUBLE_EQ(costMs, COST_MS);
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_Open_OtherVersionNotFound)
+    {
+        std::string kernelDir;
+        {
+            OpPreloadCache cache;
+            EXPECT_EQ(cache.Open(cacheDir_, "7.0.0"), APP_ERR_OK);
+            kernelDir = cache.GetKernelDir();
+            cache.Record(SIGNATURE, COST_MS);
+            EXPECT_EQ(cache.Save(), APP_ERR_OK);
+        }
+        OpPreloadCache cache;
+        EXPECT_EQ(cache.Open(cacheDir_, "8.0.0"), APP_ERR_OK);
+        EXPECT_NE(cache.GetKernelDir(), kernelDir);
+        double costMs = 0;
+        EXPECT_FALSE(cache.Find(SIGNATURE, costMs));
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_LoadAllOperations_RecordedByNextProcess)
+    {
+        PrepareLoadAll("2");
+        {
+            GlobalOpMap opMap(cacheDir_ + "/OpConfig.json");
+            FakeOpLoader *loader = InitOpMap(opMap);
+            EXPECT_EQ(opMap.LoadAllOperations(), APP_ERR_OK);
+            EXPECT_EQ(loader->preloadNum, OP_SPEC_NUM);
+            auto timings = opMap.GetPreloadTimings();
+            ASSERT_EQ(timings.size(), OP_SPEC_NUM);
+            for (const auto &timing : timings) {
+                EXPECT_EQ(timing.ret, APP_ERR_OK);
+                EXPECT_FALSE(timing.recorded);
+            }
+        }
+        GlobalOpMap opMap(cacheDir_ + "/OpConfig.json");
+        FakeOpLoader *loader = InitOpMap(opMap);
+        EXPECT_EQ(opMap.LoadAllOperations(), APP_ERR_OK);
+        EXPECT_EQ(loader->preloadNum, OP_SPEC_NUM);
+        auto timings = opMap.GetPreloadTimings();
+        ASSERT_EQ(timings.size(), OP_SPEC_NUM);
+        for (const auto &timing : timings) {
+            EXPECT_TRUE(timing.recorded);
+        }
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_LoadAllOperations_NoCacheWhenCacheDirUnset)
+    {
+        PrepareLoadAll("1");
+        unsetenv("MX_OP_PRELOAD_CACHE_DIR");
+        GlobalOpMap opMap(cacheDir_ + "/OpConfig.json");
+        FakeOpLoader *loader = InitOpMap(opMap);
+        EXPECT_EQ(opMap.LoadAllOperations(), APP_ERR_OK);
+        EXPECT_EQ(loader->preloadNum, OP_SPEC_NUM);
+        EXPECT_FALSE(opMap.preloadCache_.IsOpen());
+        EXPECT_FALSE(FileUtils::CheckDirectoryExists(cacheDir_ + "/kernel_7.0.0"));
+    }
+
+    TEST_F(OpPreloadCacheTest, Test_RunTasks_EveryTaskOnceWithMoreThreads)
+    {
+        GlobalOpMap opMap;
+        FakeOpLoader loader;
+        std::vector<OpPreloadTask> tasks(OP_SPEC_NUM);
+        for (size_t i = 0; i < tasks.size(); i++) {
+            tasks[i].loader = &loader;
+            tasks[i].jsonPtr = std::make_shared<JsonPtr>();
+            tasks[i].index = i;
+            tasks[i].opName = "Add";
+        }
+        opMap.RunTasks(tasks, OP_SPEC_NUM + 1);
+        EXPECT_EQ(loader.preloadNum, OP_SPEC_NUM);
+        auto timings = opMap.GetPreloadTimings();
+        ASSERT_EQ(timings.size(), OP_SPEC_NUM);
+        std::vector<bool> done(OP_SPEC_NUM, false);
+        for (const auto &timing : timings) {
+            ASSERT_LT(timing.index, OP_SPEC_NUM);
+            EXPECT_FALSE(done[timing.index]);
+            done[timing.index] = true;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
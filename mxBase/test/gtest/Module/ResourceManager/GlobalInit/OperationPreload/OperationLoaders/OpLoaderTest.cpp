@@ -322,6 +322,51 @@ namespace {
         EXPECT_EQ(ret, APP_ERR_OK);
     }
 
+    TEST_F(OpLoaderTest, Test_PrepareOpTasks_Success)
+    {
+        OpLoader oploader("Add");
+        const JsonPtr jsonPtr;
+        MOCKER_CPP(&OpLoader::GetOpName).stubs().will(returnValue(0));
+        MOCKER_CPP(&JsonPtr::GetPreloadList).stubs().will(invoke(GetPreloadListMock));
+        MOCKER_CPP(&OpLoader::GetSettingByIndex).stubs().will(returnValue(0));
+        MOCKER_CPP(&OpLoader::CheckOpParams).stubs().will(returnValue(0));
+        std::vector<OpPreloadTask> tasks;
+        APP_ERROR ret = oploader.PrepareOpTasks(jsonPtr, tasks);
+        EXPECT_EQ(ret, APP_ERR_OK);
+        ASSERT_EQ(tasks.size(), 1U);
+        EXPECT_EQ(tasks[0].loader, &oploader);
+        EXPECT_EQ(tasks[0].index, 0U);
+    }
+
+    TEST_F(OpLoaderTest, Test_PrepareOpTasks_CheckOpParamsFailed)
+    {
+        OpLoader oploader;
+        const JsonPtr jsonPtr;
+        MOCKER_CPP(&OpLoader::GetOpName).stubs().will(returnValue(0));
+        MOCKER_CPP(&JsonPtr::GetPreloadList).stubs().will(invoke(GetPreloadListMock));
+        MOCKER_CPP(&OpLoader::GetSettingByIndex).stubs().will(returnValue(0));
+        MOCKER_CPP(&OpLoader::CheckOpParams).stubs().will(returnValue(1));
+        std::vector<OpPreloadTask> tasks;
+        APP_ERROR ret = oploader.PrepareOpTasks(jsonPtr, tasks);
+        EXPECT_EQ(ret, APP_ERR_OK);
+        EXPECT_EQ(tasks.size(), 0U);
+    }
+
+    TEST_F(OpLoaderTest, Test_OpCompileModeGate_SameModeSetOnce)
+    {
+        MOCKER_CPP(&AclApi::aclSetCompileopt).expects(once()).will(returnValue(0));
+        EXPECT_EQ(OpCompileModeGate::Acquire(true), APP_ERR_OK);
+        EXPECT_EQ(OpCompileModeGate::Acquire(true), APP_ERR_OK);
+        OpCompileModeGate::Release();
+        OpCompileModeGate::Release();
+    }
+
+    TEST_F(OpLoaderTest, Test_OpCompileModeGate_SetCompileoptFailed)
+    {
+        MOCKER_CPP(&AclApi::aclSetCompileopt).stubs().will(returnValue(1));
+        EXPECT_NE(OpCompileModeGate::Acquire(false), APP_ERR_OK);
+    }
+
     TEST_F(OpLoaderTest, Test_GetOpName_GetOpNameFailed)
     {
         OpLoader oploader;
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include "MxBase/CV/ObjectDetection/Nms/Nms.h"
+#include "MxBase/CV/ObjectDetection/Nms/TileMerger.h"
 #include "MxBase/PostProcessBases/PostProcessDataType.h"
 
 using namespace std;
@@ -300,6 +301,69 @@ TEST_F(NmsTest, Test_CalcIou_Should_Return_0_When_MIN_And_Fabs_Pass)
     EXPECT_EQ(ret, 1);
 }
 
+TEST_F(NmsTest, Test_TileMerger_Should_Match_NmsSortByArea_When_Policy_Is_Nms_By_Area)
+{
+    std::vector<DetectBox> boxVec{
+            {0.91, 1, 100, 100, 20, 20, "glue"},
+            {0.91, 1, 230, 100, 20, 20, "glue"},
+            {0.92, 1, 190, 120, 20, 20, "glue"},
+            {0.91, 1, 190, 120, 21, 20, "glue"},
+            {0.80, 2, 190, 120, 20, 20, "tape"},
+            {0.70, 2, 195, 125, 20, 20, "tape"}
+    };
+    std::vector<DetectBox> expected = boxVec;
+    NmsSortByArea(expected, IOU_THRESH, IOUMethod::MIN);
+    TileMerger merger;
+    TileMergeConfig config;
+    config.iouThresh = IOU_THRESH;
+    std::vector<DetectBox> merged;
+    APP_ERROR ret = merger.Merge(boxVec, {}, {}, config, merged);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(merged.size(), expected.size());
+    for (size_t i = 0; i < merged.size(); i++) {
+        EXPECT_EQ(merged[i].classID, expected[i].classID);
+        EXPECT_FLOAT_EQ(merged[i].x, expected[i].x);
+        EXPECT_FLOAT_EQ(merged[i].width, expected[i].width);
+    }
+}
+
+TEST_F(NmsTest, Test_TileMerger_Should_Keep_Same_Tile_Boxes_When_Cross_Tile_Only)
+{
+    // two overlapping boxes inside tile 0, and one box of tile 1 crossing into the overlap of the two tiles
+    std::vector<DetectBox> boxVec{
+            {0.90, 1, 50, 50, 20, 20, "glue"},
+            {0.80, 1, 55, 50, 20, 20, "glue"},
+            {0.85, 1, 95, 50, 20, 20, "glue"},
+            {0.70, 1, 97, 50, 20, 20, "glue"}
+    };
+    std::vector<uint32_t> tileIds{0, 0, 0, 1};
+    std::vector<CropRoiBox> tileAreas{{0, 0, 100, 100}, {100, 0, 200, 100}};
+    TileMerger merger;
+    TileMergeConfig config;
+    config.crossTileOnly = true;
+    std::vector<DetectBox> merged;
+    APP_ERROR ret = merger.Merge(boxVec, tileIds, tileAreas, config, merged);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(merged.size(), 3);
+}
+
+TEST_F(NmsTest, Test_TileMerger_Should_Average_Boxes_When_Weighted_Fusion)
+{
+    std::vector<DetectBox> boxVec{
+            {0.75, 1, 100, 100, 20, 20, "glue"},
+            {0.25, 1, 104, 100, 20, 20, "glue"}
+    };
+    TileMerger merger;
+    TileMergeConfig config;
+    config.policy = TILE_MERGE_WEIGHTED_FUSION;
+    std::vector<DetectBox> merged;
+    APP_ERROR ret = merger.Merge(boxVec, {}, {}, config, merged);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_FLOAT_EQ(merged[0].x, 101.f);
+    EXPECT_FLOAT_EQ(merged[0].width, 20.f);
+    EXPECT_FLOAT_EQ(merged[0].prob, 0.75f);
+}
 }
 
 int main(int argc, char *argv[])
@@ -22,7 +22,12 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#define private public
 #include "TextGenerationPostProcessors/CrnnPostProcess.h"
+#include "postprocess/module/TextGenerationPostProcessors/CrnnPostProcess/CrnnPostProcessDptr.hpp"
+#undef private
+#include "MxBase/PostProcessBases/CtcDecoder.h"
+#include "MxBase/Utils/DataTypeUtils.h"
 #include "MxBase/Log/Log.h"
 
 namespace {
@@ -30,6 +35,22 @@ using namespace MxBase;
 
 class CrnnPostProcessTest : public testing::Test {};
 
+// rows of time step scores are written as probabilities, the missing mass is left to the blank
+std::vector<float> MakeProbabilities(const std::vector<std::vector<std::pair<uint32_t, float>>>& steps,
+                                     uint32_t classNum, uint32_t blankIdx)
+{
+    std::vector<float> probs(steps.size() * classNum, 0.f);
+    for (size_t t = 0; t < steps.size(); t++) {
+        float sum = 0;
+        for (const auto& classProb : steps[t]) {
+            probs[t * classNum + classProb.first] = classProb.second;
+            sum += classProb.second;
+        }
+        probs[t * classNum + blankIdx] += 1.f - sum;
+    }
+    return probs;
+}
+
 TEST_F(CrnnPostProcessTest, Test_CrnnPostProcess_Constructor_Should_Success)
 {
     CrnnPostProcess crnnPostProcess;
@@ -199,6 +220,117 @@ TEST_F(CrnnPostProcessTest, Test_CrnnPostProcessTest_Process_Should_Success_In_W
     ret = instanceSrc.Process(vec, textInfos, configParamMap);
     EXPECT_EQ(ret, APP_ERR_OK);
 }
+
+TEST_F(CrnnPostProcessTest, Test_CtcDecoder_GreedyDecode_Should_Collapse_Repeats_And_Blanks)
+{
+    CtcDecoder decoder;
+    decoder.Init({"a", "b", "c", "-"}, 0x3);
+    std::vector<float> probs = MakeProbabilities({{{0, 0.9f}}, {{0, 0.8f}}, {}, {{0, 0.7f}}, {{1, 0.9f}},
+                                                  {{1, 0.6f}}, {{0x2, 0.3f}}}, 0x4, 0x3);
+    CtcLogits logits;
+    logits.data = probs.data();
+    logits.timeStep = static_cast<uint32_t>(probs.size() / 0x4);
+    logits.classNum = 0x4;
+    std::vector<std::string> texts;
+    EXPECT_EQ(decoder.GreedyDecode(logits, texts), APP_ERR_OK);
+    ASSERT_EQ(texts.size(), 1u);
+    EXPECT_EQ(texts[0], "aab");
+
+    std::vector<int64_t> ids = {0, 0, 0x3, 0, 1, 1, -1, 0x63, 0x2};
+    EXPECT_EQ(decoder.GreedyDecode(ids.data(), 1, static_cast<uint32_t>(ids.size()), texts), APP_ERR_OK);
+    EXPECT_EQ(texts[0], "aabc");
+}
+
+TEST_F(CrnnPostProcessTest, Test_CtcDecoder_Float16_Should_Match_Float32)
+{
+    CtcDecoder decoder;
+    decoder.Init({"-", "x", "y", "z", "w", "v"}, 0);
+    const uint32_t classNum = 0x6;
+    const uint32_t timeStep = 0x9;
+    std::vector<float> values(0x2 * timeStep * classNum);
+    std::vector<uint16_t> halfValues(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<float>((i * 0x25) % 0x11) * 0.25f;
+        DataTypeUtils::Float32ToFloat16(&halfValues[i], values[i]);
+    }
+    CtcLogits logits;
+    logits.data = values.data();
+    logits.batchSize = 0x2;
+    logits.timeStep = timeStep;
+    logits.classNum = classNum;
+    std::vector<std::string> texts;
+    std::vector<std::string> halfTexts;
+    CtcBeamConfig config;
+    EXPECT_EQ(decoder.BeamSearchDecode(logits, config, texts), APP_ERR_OK);
+    logits.data = halfValues.data();
+    logits.dataType = TENSOR_DTYPE_FLOAT16;
+    EXPECT_EQ(decoder.BeamSearchDecode(logits, config, halfTexts), APP_ERR_OK);
+    EXPECT_EQ(texts, halfTexts);
+}
+
+TEST_F(CrnnPostProcessTest, Test_CtcDecoder_BeamSearch_Should_Sum_Alignments_Of_A_Prefix)
+{
+    CtcDecoder decoder;
+    decoder.Init({"-", "a"}, 0);
+    // the best path is two blanks (0.36), but "a" has the three alignments aa, a-, -a (0.64)
+    std::vector<float> probs = MakeProbabilities({{{1, 0.4f}}, {{1, 0.4f}}}, 0x2, 0);
+    CtcLogits logits;
+    logits.data = probs.data();
+    logits.timeStep = 0x2;
+    logits.classNum = 0x2;
+    std::vector<std::string> texts;
+    EXPECT_EQ(decoder.GreedyDecode(logits, texts), APP_ERR_OK);
+    EXPECT_EQ(texts[0], "");
+    CtcBeamConfig config;
+    config.applySoftmax = false;
+    EXPECT_EQ(decoder.BeamSearchDecode(logits, config, texts), APP_ERR_OK);
+    EXPECT_EQ(texts[0], "a");
+}
+
+TEST_F(CrnnPostProcessTest, Test_CtcDecoder_BeamSearch_Should_Keep_To_The_Lexicon)
+{
+    CtcDecoder decoder;
+    decoder.Init({"-", "c", "a", "o", "t"}, 0);
+    EXPECT_EQ(decoder.SetLexicon({"cat", "dog"}), APP_ERR_OK);
+    EXPECT_TRUE(decoder.HasLexicon());
+    std::vector<float> probs = MakeProbabilities({{{1, 0.9f}}, {{0x3, 0.6f}, {0x2, 0.35f}}, {{0x4, 0.9f}}}, 0x5, 0);
+    CtcLogits logits;
+    logits.data = probs.data();
+    logits.timeStep = 0x3;
+    logits.classNum = 0x5;
+    std::vector<std::string> texts;
+    EXPECT_EQ(decoder.GreedyDecode(logits, texts), APP_ERR_OK);
+    EXPECT_EQ(texts[0], "cot");
+    CtcBeamConfig config;
+    config.applySoftmax = false;
+    EXPECT_EQ(decoder.BeamSearchDecode(logits, config, texts), APP_ERR_OK);
+    EXPECT_EQ(texts[0], "cat");
+}
+
+TEST_F(CrnnPostProcessTest, Test_CrnnPostProcessTest_Process_Should_Success_With_Float16_And_Beam_Search)
+{
+    CrnnPostProcess instanceSrc;
+    std::map<std::string, std::string> postConfig = {
+            {"postProcessConfigContent", "{\"CLASS_NUM\": \"37\","
+                                         "\"OBJECT_NUM\": \"24\","
+                                         "\"BLANK_INDEX\": \"36\","
+                                         "\"BEAM_WIDTH\": \"5\","
+                                         "\"WITH_ARGMAX\": \"false\"}"}
+    };
+    APP_ERROR ret = instanceSrc.Init(postConfig);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(instanceSrc.dPtr_->beamConfig_.beamWidth, 5u);
+    std::vector<uint32_t> shape = {2, 24, 37};
+    auto type = TensorDataType::TENSOR_DTYPE_FLOAT16;
+    TensorBase tensor(shape, type);
+    TensorBase::TensorBaseMalloc(tensor);
+    std::vector<TensorBase> vec = {tensor};
+    std::vector<TextsInfo> textInfos;
+    std::map<std::string, std::shared_ptr<void>> configParamMap;
+    ret = instanceSrc.Process(vec, textInfos, configParamMap);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(textInfos.size(), 2u);
+}
 } // namespace
 
 int main(int argc, char *argv[])
@@ -23,7 +23,10 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <opencv2/opencv.hpp>
+#define private public
 #include "TextObjectPostProcessors/CtpnPostProcess.h"
+#include "postprocess/module/TextObjectPostProcessors/CtpnPostProcess/CtpnPostProcessDptr.hpp"
+#undef private
 #include "MxBase/Log/Log.h"
 #include "MxBase/MxBase.h"
 
@@ -33,8 +36,43 @@ using namespace std;
 const uint32_t WIDTH = 1072;
 const uint32_t HEIGHT = 608;
 const uint32_t CHANNEL = 3;
+const float PROPOSAL_WIDTH = 15.f;
+const float PROPOSAL_HEIGHT = 20.f;
 class CtpnPostProcessTest : public testing::Test {};
 
+TEST_F(CtpnPostProcessTest, BuildGraph_Links_Proposals_Into_Text_Lines)
+{
+    CtpnPostProcess ctpnPostProcess;
+    auto &dPtr = ctpnPostProcess.dPtr_;
+    dPtr->maxHorizontalGap_ = 0x32;
+    dPtr->minOverLaps_ = 0.7f;
+    dPtr->minSizeSim_ = 0.7f;
+    // two lines of proposals 16 pixels apart, listed out of order, and a single proposal far away
+    std::vector<std::vector<float>> textProposals;
+    std::vector<float> scores;
+    const std::vector<float> lineY = {100.f, 300.f};
+    for (uint32_t i = 0; i < 0x4; i++) {
+        for (auto y : lineY) {
+            float x = static_cast<float>(0x30 - 0x10 * i);
+            textProposals.push_back({x, y, x + PROPOSAL_WIDTH, y + PROPOSAL_HEIGHT});
+            scores.push_back(0.9f);
+        }
+    }
+    textProposals.push_back({800.f, 500.f, 800.f + PROPOSAL_WIDTH, 500.f + PROPOSAL_HEIGHT});
+    scores.push_back(0.9f);
+    ResizedImageInfo resizedImageInfo(WIDTH, HEIGHT, WIDTH, HEIGHT, RESIZER_TF_KEEP_ASPECT_RATIO, 1);
+    dPtr->BuildGraph(textProposals, scores, resizedImageInfo);
+    dPtr->GetSubGraph();
+    ASSERT_EQ(dPtr->lineOffsets_.size(), 0x3);
+    std::vector<int> firstLine(dPtr->lineBoxes_.begin() + dPtr->lineOffsets_[0],
+        dPtr->lineBoxes_.begin() + dPtr->lineOffsets_[1]);
+    std::vector<int> secondLine(dPtr->lineBoxes_.begin() + dPtr->lineOffsets_[1],
+        dPtr->lineBoxes_.begin() + dPtr->lineOffsets_[0x2]);
+    EXPECT_EQ(firstLine, std::vector<int>({6, 4, 2, 0}));
+    EXPECT_EQ(secondLine, std::vector<int>({7, 5, 3, 1}));
+    EXPECT_EQ(dPtr->successions_[0x8], -1);
+}
+
 TEST_F(CtpnPostProcessTest, TestCtpnPostProcess)
 {
     LogInfo << "****************case TestCtpnPostProcess***************";
@@ -20,11 +20,13 @@
  * History: NA
  */
 
+#include <cmath>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include "MxBase/Log/Log.h"
 #include "SegmentPostProcessors/Deeplabv3Post.h"
 #include "MxBase/MxBase.h"
+#include "MxBase/PostProcessBases/ChannelArgmax.h"
 
 namespace {
 using namespace MxBase;
@@ -200,6 +202,74 @@ TEST_F(Deeplabv3PostProcessTest, TestDeeplabv3_Should_Return_Success_when_FRAMEW
     ret = deeplabv3Post.Process(tensors, semanticSegInfos, resizedImageInfos, paramMap);
     EXPECT_EQ(ret, APP_ERR_OK);
 }
+
+TEST_F(Deeplabv3PostProcessTest, TestSegLabelMap_Should_Keep_Labels_When_Resize_And_Encode)
+{
+    const uint32_t classNum = 21;
+    SegLabelMap labels(2, 2, classNum);
+    labels.Set(1, 0, 1);
+    labels.Set(1, 1, 1);
+    EXPECT_EQ(labels.elemSize, 1u);
+    SegLabelMap resized = labels.ResizeNearest(4, 2, 2, 2);
+    std::vector<std::vector<int>> expectPixels = {{0, 0, 1, 1}, {0, 0, 1, 1}};
+    EXPECT_EQ(resized.ToPixels(), expectPixels);
+    std::vector<uint32_t> expectRuns = {0, 2, 1, 2, 0, 2, 1, 2};
+    EXPECT_EQ(resized.EncodeRle(), expectRuns);
+    // column major: 4 background pixels, then 4 pixels of class 1
+    EXPECT_EQ(resized.EncodeCocoRle(1), "44");
+}
+
+TEST_F(Deeplabv3PostProcessTest, TestSegLabelMap_Should_Use_Uint16_When_ClassNum_Over_256)
+{
+    const uint32_t classNum = 300;
+    const uint32_t label = 299;
+    SegLabelMap labels(1, 1, classNum);
+    labels.Set(0, 0, label);
+    EXPECT_EQ(labels.elemSize, 2u);
+    EXPECT_EQ(labels.At(0, 0), label);
+}
+
+TEST_F(Deeplabv3PostProcessTest, TestChannelArgmax_Should_Match_Between_Layouts_And_Data_Types)
+{
+    // 2 x 2 image and 3 classes, pixel scores in NHWC: class 2, class 0, class 1 and a tie of classes 1 and 2
+    std::vector<float> nhwc = {0.f, 1.f, 2.f, 3.f, 1.f, 0.f, 0.f, 4.f, 1.f, 0.f, 5.f, 5.f};
+    std::vector<float> nchw = {0.f, 3.f, 0.f, 0.f, 1.f, 1.f, 4.f, 5.f, 2.f, 0.f, 1.f, 5.f};
+    // the same scores of nchw as float16
+    std::vector<uint16_t> nchwHalf = {0x0000, 0x4200, 0x0000, 0x0000, 0x3c00, 0x3c00, 0x4400, 0x4500,
+                                      0x4000, 0x0000, 0x3c00, 0x4500};
+    const uint32_t classNum = 3;
+    ChannelScores scores;
+    scores.width = 2;
+    scores.height = 2;
+    scores.classNum = classNum;
+    std::vector<std::vector<int>> expectPixels = {{2, 0}, {1, 1}};
+
+    SegLabelMap labels;
+    std::vector<float> confidence;
+    scores.data = nhwc.data();
+    scores.layout = TYPE_NHWC;
+    EXPECT_EQ(ChannelArgmax::Argmax(scores, labels, &confidence), APP_ERR_OK);
+    EXPECT_EQ(labels.ToPixels(), expectPixels);
+    const float tieConfidence = 1.f / (2.f + std::exp(-5.f));
+    EXPECT_NEAR(confidence[3], tieConfidence, 1e-6);
+
+    scores.data = nchw.data();
+    scores.layout = TYPE_NCHW;
+    EXPECT_EQ(ChannelArgmax::Argmax(scores, labels), APP_ERR_OK);
+    EXPECT_EQ(labels.ToPixels(), expectPixels);
+
+    scores.data = nchwHalf.data();
+    scores.dataType = TENSOR_DTYPE_FLOAT16;
+    EXPECT_EQ(ChannelArgmax::Argmax(scores, labels), APP_ERR_OK);
+    EXPECT_EQ(labels.ToPixels(), expectPixels);
+
+    std::vector<uint32_t> classIds;
+    std::vector<float> classScores;
+    EXPECT_EQ(ChannelArgmax::TopK(scores, 2, classIds, classScores), APP_ERR_OK);
+    std::vector<uint32_t> expectIds = {2, 1, 0, 1, 1, 2, 1, 2};
+    EXPECT_EQ(classIds, expectIds);
+    EXPECT_NE(ChannelArgmax::TopK(scores, classNum + 1, classIds, classScores), APP_ERR_OK);
+}
 } // namespace
 
 int main(int argc, char* argv[])
@@ -20,6 +20,7 @@
  * History: NA
  */
 
+#include <cmath>
 #include <new>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -409,49 +410,100 @@ TEST_F(OpenPosePostProcessTest, Test_OpenPosePostProcessDptr_Upsample)
     EXPECT_EQ(ret, APP_ERR_COMM_OUT_OF_RANGE);
 }
 
-TEST_F(OpenPosePostProcessTest, Test_OpenPosePostProcessDptr_CheckEqual)
+TEST_F(OpenPosePostProcessTest, Test_OpenPosePostProcessDptr_FindPartPeaks_At_Model_Resolution)
 {
     OpenPosePostProcess openPosePostProcess;
     OpenPosePostProcessDptr openPosePostProcessDptr(&openPosePostProcess);
-    float a = 0.1;
-    float b = 0.2;
-    float ret = openPosePostProcessDptr.CheckEqual(a, b);
-    EXPECT_EQ(ret, 0);
+    const uint32_t height = 32;
+    const uint32_t width = 40;
+    const uint32_t scale = 8;
+    const int partId = 2;
+    openPosePostProcessDptr.keyPointNum_ = 17;
+    uint32_t channels = static_cast<uint32_t>(openPosePostProcessDptr.keyPointNum_) * 3;
+    std::vector<float> output(height * width * channels, 0.f);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            float dx = x - 10.25f;
+            float dy = y - 6.5f;
+            output[(y * width + x) * channels + partId] = std::exp(-(dx * dx + dy * dy) / 2.f);
+        }
+    }
+    openPosePostProcessDptr.outputData_ = output.data();
+    openPosePostProcessDptr.outputModelHeight_ = height;
+    openPosePostProcessDptr.outputModelWidth_ = width;
+    openPosePostProcessDptr.resizedWidth_ = width * scale;
+    openPosePostProcessDptr.resizedHeight_ = height * scale;
+    openPosePostProcessDptr.scaleX_ = scale;
+    openPosePostProcessDptr.scaleY_ = scale;
+    std::vector<float> kernel;
+    APP_ERROR ret = KeypointPeakFinder::MakeGaussianKernel(25, 3, scale, kernel);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = openPosePostProcessDptr.FindPartPeaks(kernel, kernel);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(openPosePostProcessDptr.peakInfos_[partId].size(), 1);
+    EXPECT_TRUE(openPosePostProcessDptr.peakInfos_[0].empty());
+    // the refined peak is scaled to the resized image with the pixel centers aligned
+    EXPECT_NEAR(openPosePostProcessDptr.peakInfos_[partId][0].x, (10.25f + 0.5f) * scale - 0.5f, 1.f);
+    EXPECT_NEAR(openPosePostProcessDptr.peakInfos_[partId][0].y, (6.5f + 0.5f) * scale - 0.5f, 1.f);
+
+    // peaks of the previous image are dropped
+    ret = openPosePostProcessDptr.FindPartPeaks(kernel, kernel);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(openPosePostProcessDptr.peakInfos_[partId].size(), 1);
 }
 
-TEST_F(OpenPosePostProcessTest, Test_OpenPosePostProcessDptr_GeneratePeaks)
+TEST_F(OpenPosePostProcessTest, Test_KeypointPeakFinder_MakeGaussianKernel)
 {
-    OpenPosePostProcess openPosePostProcess;
-    OpenPosePostProcessDptr openPosePostProcessDptr(&openPosePostProcess);
+    std::vector<float> kernel;
+    EXPECT_EQ(KeypointPeakFinder::MakeGaussianKernel(0, 3, 1, kernel), APP_ERR_COMM_OUT_OF_RANGE);
+    EXPECT_EQ(KeypointPeakFinder::MakeGaussianKernel(25, 3, 0, kernel), APP_ERR_COMM_OUT_OF_RANGE);
+    EXPECT_EQ(KeypointPeakFinder::MakeGaussianKernel(25, 3, 1, kernel), APP_ERR_OK);
+    ASSERT_EQ(kernel.size(), 25);
+    float sum = 0;
+    for (size_t i = 0; i < kernel.size(); i++) {
+        EXPECT_NEAR(kernel[i], kernel[kernel.size() - 1 - i], 1e-6);
+        sum += kernel[i];
+    }
+    EXPECT_NEAR(sum, 1.f, 1e-5);
+    EXPECT_EQ(KeypointPeakFinder::MakeGaussianKernel(25, 3, 8, kernel), APP_ERR_OK);
+    EXPECT_EQ(kernel.size(), 5);
+}
 
-    float peaks[2][2][3] = {
-        {
-            {0.0, 0.2, 0.4},
-            {0.6, 0.8, 1.0}
-        },
-        {
-            {0.0, 0.2, 0.4},
-            {0.6, 0.8, 1.0}
-        }
-    };
-    float heatmap[2][2][3] = {
-        {
-            {0.1, 0.3, 0.5},
-            {0.7, 0.9, 0.1}
-        },
-        {
-            {0.1, 0.3, 0.5},
-            {0.7, 0.9, 0.1}
-        }
+TEST_F(OpenPosePostProcessTest, Test_KeypointPeakFinder_SuppressNonMaximum_And_FindPeaks)
+{
+    std::vector<float> plane = {
+        0, 1, 0,
+        2, 3, 2,
+        0, 1, 0,
+        0, 0, 5
     };
-    std::vector<int> shape = {2, 2, 3};
-    std::vector<int> index = {1, 1, 0};
-    int peakCnt = 0;
-
-    openPosePostProcessDptr.GeneratePeaks(peaks[0][0][0], heatmap[0][0][0], shape, index, peakCnt);
-    EXPECT_FALSE(openPosePostProcessDptr.peakInfos_[0].empty());
-    EXPECT_EQ(openPosePostProcessDptr.peakInfos_[0][0].x, 1);
-    EXPECT_EQ(openPosePostProcessDptr.peakInfos_[0][0].y, 1);
+    std::vector<HeatmapPeak> peaks;
+    APP_ERROR ret = KeypointPeakFinder::FindPeaks(plane.data(), 3, 4, 0.5f, 3, true, peaks);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(peaks.size(), 2);
+    EXPECT_FLOAT_EQ(peaks[0].x, 1.f);
+    EXPECT_FLOAT_EQ(peaks[0].score, 3.f);
+    EXPECT_EQ(peaks[1].index, 11);
+    EXPECT_EQ(KeypointPeakFinder::FindPeaks(plane.data(), 3, 4, 0.5f, 2, true, peaks), APP_ERR_COMM_INVALID_PARAM);
+
+    ret = KeypointPeakFinder::SuppressNonMaximum(plane.data(), 3, 4, 3);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    std::vector<float> expected = {0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 5};
+    EXPECT_EQ(plane, expected);
+}
+
+TEST_F(OpenPosePostProcessTest, Test_KeypointPeakFinder_ScoreLimb)
+{
+    std::vector<float> fieldX(16, 0.6f);
+    std::vector<float> fieldY(16, 0.8f);
+    HeatmapPlane planeX = {fieldX.data(), 4, 4, 1};
+    HeatmapPlane planeY = {fieldY.data(), 4, 4, 1};
+    LimbScore limb = KeypointPeakFinder::ScoreLimb(planeX, planeY, 0, 0, 1.5f, 2.f, 10, 0.05f);
+    EXPECT_NEAR(limb.score, 1.f, 1e-5);
+    EXPECT_EQ(limb.hitNum, 10);
+    limb = KeypointPeakFinder::ScoreLimb(planeX, planeY, 1.5f, 2.f, 0, 0, 10, 0.05f);
+    EXPECT_NEAR(limb.score, -1.f, 1e-5);
+    EXPECT_EQ(limb.hitNum, 0);
 }
 } // namespace
 
@@ -23,7 +23,10 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <opencv2/opencv.hpp>
+#define private public
 #include "TextObjectPostProcessors/PSENetPostProcess.h"
+#include "postprocess/module/TextObjectPostProcessors/PSENetPostProcess/PSENetPostProcessDptr.hpp"
+#undef private
 #include "MxBase/Log/Log.h"
 #include "MxBase/MxBase.h"
 
@@ -32,8 +35,73 @@ using namespace MxBase;
 using namespace std;
 const uint32_t WIDTH = 1216;
 const uint32_t HEIGHT = 704;
+const uint32_t TEST_KERNEL_NUM = 3;
+const float TEXT_VALUE = 5.f;
 class PSENetPostProcessTest : public testing::Test {};
 
+// fills the text region of kernel t with a box shrunk by 2 * t pixels
+void FillTextLine(float *data, uint32_t top, uint32_t left, uint32_t bottom, uint32_t right)
+{
+    const size_t planeSize = static_cast<size_t>(WIDTH) * HEIGHT;
+    for (uint32_t t = 0; t < TEST_KERNEL_NUM; t++) {
+        for (uint32_t y = top + 0x2 * t; y < bottom - 0x2 * t; y++) {
+            std::fill(data + t * planeSize + y * WIDTH + left + 0x2 * t,
+                data + t * planeSize + y * WIDTH + right - 0x2 * t, TEXT_VALUE);
+        }
+    }
+}
+
+TensorBase MakeKernelTensor()
+{
+    TensorBase tensor({1, TEST_KERNEL_NUM, HEIGHT, WIDTH}, TENSOR_DTYPE_FLOAT32);
+    TensorBase::TensorBaseMalloc(tensor);
+    float *data = static_cast<float *>(tensor.GetBuffer());
+    std::fill(data, data + tensor.GetSize(), 0.f);
+    FillTextLine(data, 0x10, 0x10, 0x30, 0x200);
+    FillTextLine(data, 0x40, 0x10, 0x60, 0x300);
+    // two text lines whose text regions touch, they are split where the smaller kernels are apart
+    FillTextLine(data, 0x100, 0x10, 0x120, 0x100);
+    FillTextLine(data, 0x100, 0x100, 0x120, 0x200);
+    return tensor;
+}
+
+TEST_F(PSENetPostProcessTest, Pse_Labels_Do_Not_Depend_On_Label_Threads)
+{
+    PSENetPostProcess pseNetPostProcess;
+    pseNetPostProcess.dPtr_->kernel_num_ = TEST_KERNEL_NUM;
+    std::vector<TensorBase> tensors = {MakeKernelTensor()};
+    const float *textMap = nullptr;
+    ASSERT_EQ(pseNetPostProcess.dPtr_->GetKernelMask(tensors, 0, textMap), APP_ERR_OK);
+    pseNetPostProcess.dPtr_->Pse(MIN_KERNEL_AREA);
+    std::vector<int32_t> labels = pseNetPostProcess.dPtr_->labels_;
+    EXPECT_EQ(pseNetPostProcess.dPtr_->stats_.size(), 0x5);
+    pseNetPostProcess.dPtr_->labelThreadNum_ = 0x8;
+    pseNetPostProcess.dPtr_->Pse(MIN_KERNEL_AREA);
+    EXPECT_EQ(pseNetPostProcess.dPtr_->labels_, labels);
+}
+
+TEST_F(PSENetPostProcessTest, Process_Boxes_Synthetic_Text_Lines)
+{
+    PSENetPostProcess pseNetPostProcess;
+    pseNetPostProcess.dPtr_->kernel_num_ = TEST_KERNEL_NUM;
+    std::vector<TensorBase> tensors = {MakeKernelTensor()};
+    std::vector<ResizedImageInfo> imagePreProcessInfos = {
+        ResizedImageInfo(WIDTH, HEIGHT, WIDTH, HEIGHT, RESIZER_TF_KEEP_ASPECT_RATIO, 1)
+    };
+    std::vector<std::vector<TextObjectInfo>> textObjInfos;
+    auto ret = pseNetPostProcess.Process(tensors, textObjInfos, imagePreProcessInfos);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(textObjInfos.size(), 1);
+    ASSERT_EQ(textObjInfos[0].size(), 0x4);
+    const float eps = 1.f;
+    float left = std::min({textObjInfos[0][0].x0, textObjInfos[0][0].x1, textObjInfos[0][0].x2,
+        textObjInfos[0][0].x3});
+    float right = std::max({textObjInfos[0][0].x0, textObjInfos[0][0].x1, textObjInfos[0][0].x2,
+        textObjInfos[0][0].x3});
+    EXPECT_NEAR(left, 0x10, eps);
+    EXPECT_NEAR(right, 0x200 - 1, eps);
+}
+
 TEST_F(PSENetPostProcessTest, TestPSENetPostProcess)
 {
     LogInfo << "****************case TestPSENetPostProcess***************";
@@ -81,9 +81,12 @@ private:
 
     APP_ERROR SetDistributeAllMode(const std::string& distributeAll);
 
-    bool NoDataOfInterested(std::vector<std::shared_ptr<MxTools::MxpiObjectList>> &objlistVec);
+    bool NoDataOfInterested(const std::vector<std::vector<int>> &memberIdsVec);
 
-    bool NoDataOfInterested(std::vector<std::shared_ptr<MxTools::MxpiClassList>> &clslistVec);
+    void SelectMember(int memberId, int32_t classId, std::vector<std::vector<int>> &memberIdsVec);
+
+    APP_ERROR DistributeListByClassId(const std::vector<std::vector<int>> &memberIdsVec,
+        const std::string &dataStructure, MxTools::MxpiBuffer* mxpiBuffer);
 
     APP_ERROR DistributeByChannelId(MxTools::MxpiBuffer* mxpiBuffer);
 
@@ -101,18 +104,8 @@ private:
 
     APP_ERROR MallocFailedHandle(MxTools::MxpiBuffer* mxpiBuffer);
 
-    APP_ERROR GetObjectListVec(std::vector<std::shared_ptr<MxTools::MxpiObjectList>> &objectListVec,
-        const std::shared_ptr<void> dataPtr);
-
     APP_ERROR NullptrHandle(MxTools::MxpiBuffer* mxpiBuffer);
 
-    APP_ERROR CopyMxpiObject(size_t i, MxTools::MxpiObject &dst, const MxTools::MxpiObject &src);
-
-    APP_ERROR GetclassListVec(std::vector<std::shared_ptr<MxTools::MxpiClassList>> &classListVec,
-        const std::shared_ptr<void> dataPtr);
-
-    APP_ERROR CopyMxpiClass(size_t i, MxTools::MxpiClass &dst, const MxTools::MxpiClass &src);
-
     // first level split id vector
     std::vector<std::string> firstLevelIdVec_;
     // second level split id vector
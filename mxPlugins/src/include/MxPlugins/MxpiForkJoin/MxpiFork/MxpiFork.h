@@ -0,0 +1,82 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Send a child buffer sharing the memory and the metadata of the input buffer to every output port.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPLUGINS_MXPIFORK_H
+#define MXPLUGINS_MXPIFORK_H
+
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxTools/PluginToolkit/base/MxPluginGenerator.h"
+#include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
+#include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+#include "MxPlugins/MxpiForkJoin/MxpiForkContext.h"
+
+/**
+ * This plugin is used for running branches in parallel, the branches are joined again by mxpi_join.
+ */
+namespace MxPlugins {
+class MxpiFork : public MxTools::MxPluginBase {
+public:
+    /**
+    * @description: Init configs.
+    * @param configParamMap: config.
+    * @return: Error code.
+    */
+    APP_ERROR Init(std::map<std::string, std::shared_ptr<void>> &configParamMap) override;
+
+    /**
+    * @description: DeInit.
+    * @return: Error code.
+    */
+    APP_ERROR DeInit() override;
+
+    /**
+    * @description: MxpiFork plugin process.
+    * @param mxpiBuffer: data receive from the previous.
+    * @return: Error code.
+    */
+    APP_ERROR Process(std::vector<MxTools::MxpiBuffer*> &mxpiBuffer) override;
+
+    /**
+    * @api
+    * @brief Define the number and data type of input ports.
+    * @return MxTools::MxpiPortInfo.
+    */
+    static MxTools::MxpiPortInfo DefineInputPorts();
+
+    /**
+    * @api
+    * @brief Define the number and data type of output ports.
+    * @return MxTools::MxpiPortInfo.
+    */
+    static MxTools::MxpiPortInfo DefineOutputPorts();
+
+private:
+    MxTools::MxpiBuffer* CreateChildBuffer(MxTools::MxpiBuffer& parentMxpiBuffer,
+                                           const std::shared_ptr<MxpiForkContext>& context);
+
+    void SetFrameInfo(MxTools::MxpiBuffer& parentMxpiBuffer, MxpiForkContext& context);
+
+    uint64_t sequence_ = 0;
+};
+}
+
+#endif
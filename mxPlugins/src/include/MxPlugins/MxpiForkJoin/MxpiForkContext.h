@@ -0,0 +1,58 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Context shared by the child buffers that MxpiFork creates for one input buffer.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPLUGINS_MXPIFORKCONTEXT_H
+#define MXPLUGINS_MXPIFORKCONTEXT_H
+
+#include <atomic>
+#include <cstdint>
+#include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+
+namespace MxPlugins {
+/**
+ * Every child buffer holds the context as metadata with the key of the fork element name. The parent buffer lives
+ * as long as one of its children or until MxpiJoin takes it over to send it downstream.
+ */
+struct MxpiForkContext {
+    MxpiForkContext() = default;
+
+    ~MxpiForkContext()
+    {
+        if (parent != nullptr) {
+            MxTools::MxpiBufferManager::DestroyBuffer(parent);
+            parent = nullptr;
+        }
+    }
+
+    MxpiForkContext(const MxpiForkContext &) = delete;
+
+    MxpiForkContext& operator=(const MxpiForkContext &) = delete;
+
+    MxTools::MxpiBuffer* parent = nullptr;
+    uint64_t sequence = 0;      // index of the input buffer in the fork, unique per fork element
+    uint32_t frameId = 0;
+    uint32_t channelId = 0;
+    std::atomic<bool> joined {false};   // the parent was sent or dropped by the join, later children are dropped
+};
+}
+
+#endif
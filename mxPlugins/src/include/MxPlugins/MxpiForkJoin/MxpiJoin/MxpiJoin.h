@@ -0,0 +1,104 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Join the branches started by mxpi_fork, the metadata of the branches is merged into the input buffer.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPLUGINS_MXPIJOIN_H
+#define MXPLUGINS_MXPIJOIN_H
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxTools/PluginToolkit/base/MxPluginGenerator.h"
+#include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
+#include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+#include "MxPlugins/MxpiForkJoin/MxpiForkContext.h"
+
+/**
+ * This plugin is used for joining the branches of mxpi_fork, a frame is sent once every input port has its child.
+ */
+namespace MxPlugins {
+class MxpiJoin : public MxTools::MxPluginBase {
+public:
+    /**
+    * @description: Init configs.
+    * @param configParamMap: config.
+    * @return: Error code.
+    */
+    APP_ERROR Init(std::map<std::string, std::shared_ptr<void>> &configParamMap) override;
+
+    /**
+    * @description: DeInit.
+    * @return: Error code.
+    */
+    APP_ERROR DeInit() override;
+
+    /**
+    * @description: MxpiJoin plugin process.
+    * @param mxpiBuffer: data receive from the previous.
+    * @return: Error code.
+    */
+    APP_ERROR Process(std::vector<MxTools::MxpiBuffer*> &mxpiBuffer) override;
+
+    /**
+    * @description: MxpiJoin plugin define properties.
+    * @return: properties.
+    */
+    static std::vector<std::shared_ptr<void>> DefineProperties();
+
+    /**
+    * @api
+    * @brief Define the number and data type of input ports.
+    * @return MxTools::MxpiPortInfo.
+    */
+    static MxTools::MxpiPortInfo DefineInputPorts();
+
+    /**
+    * @api
+    * @brief Define the number and data type of output ports.
+    * @return MxTools::MxpiPortInfo.
+    */
+    static MxTools::MxpiPortInfo DefineOutputPorts();
+
+private:
+    struct PendingFrame {
+        std::shared_ptr<MxpiForkContext> context;
+        std::vector<bool> arrived;
+        size_t arrivedNum = 0;
+        std::chrono::steady_clock::time_point startTime;
+    };
+
+    // called with pendingMutex_ held, the parent is sent after the lock is released
+    MxTools::MxpiBuffer* TakeParent(MxpiForkContext& context);
+
+    void TimeoutCall();
+
+    std::string forkName_;
+    uint32_t timeout_ = 0;
+    std::map<uint64_t, PendingFrame> pendingFrames_;
+    std::mutex pendingMutex_;
+    std::condition_variable condition_;
+    std::thread thread_;
+    bool runningFlag_ = false;
+};
+}
+
+#endif
@@ -90,21 +90,20 @@ private:
 
     APP_ERROR OpenCVNormalize(size_t idx, MxTools::MxpiVision& srcVision, MxTools::MxpiVision& dstVision);
 
-    APP_ERROR Normalize(cv::Mat &src, cv::Mat &dst, const std::vector<double>& mean, const std::vector<double>& std,
-        int type);
-    
+    APP_ERROR FusedNormalize(size_t idx, const MxTools::MxpiVision& srcVision, MxTools::MxpiVision& dstVision);
+
     APP_ERROR MinMaxNormalize(cv::Mat &src, cv::Mat &dst, int type);
 
     APP_ERROR DoNormalize(cv::Mat& dst, MxTools::MxpiVision& srcVision);
 
-    void SwitchAlphaAndBeta(const MxTools::MxpiVision& srcVision);
-
     APP_ERROR ConvertType(const MxTools::MxpiDataType& dataType);
 
     bool IsNeedConvert(const MxBase::MxbasePixelFormat& format);
 
     APP_ERROR Mat2MxpiVision(size_t idx, const cv::Mat& mat, MxTools::MxpiVision& vision);
 
+    APP_ERROR SetVisionInfo(size_t idx, uint32_t width, uint32_t height, MxTools::MxpiVision& vision);
+
     void SendErrorInfo(std::vector<MxTools::MxpiBuffer *> &mxpiBuffer, APP_ERROR errorCode,
         const std::string &errorInfo);
 
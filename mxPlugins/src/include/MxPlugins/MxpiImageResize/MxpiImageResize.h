@@ -31,6 +31,7 @@
 #include "MxBase/DvppWrapper/DvppWrapper.h"
 #include "MxBase/ErrorCode/ErrorCode.h"
 #include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxBase/CV/Preprocess/LetterboxResizer.h"
 
 namespace MxPlugins {
 class MxpiImageResize : public MxTools::MxPluginBase {
@@ -91,7 +92,7 @@ private:
                          MxTools::MxpiVisionInfo& srcMxpiVisionInfo, MxTools::MxpiVisionData& srcMxpiVisionData);
     APP_ERROR OpencvResize(MxTools::MxpiVisionInfo& dstMxpiVisionInfo, MxTools::MxpiVisionData& dstMxpiVisionData,
                            MxTools::MxpiVisionInfo& srcMxpiVisionInfo, MxTools::MxpiVisionData& srcMxpiVisionData);
-    APP_ERROR OpencvPaddingProcess(cv::Mat& imageRGB, MxTools::MxpiVisionInfo &srcMxpiVisionInfo);
+    APP_ERROR OpencvPaddingProcess(uint32_t width, uint32_t height, MxBase::LetterboxGeometry& geometry);
     APP_ERROR CheckOutputImage(uint32_t width, uint32_t height);
 
     void SetResizeConfig(MxTools::MxpiVisionInfo& srcMxpiVisionInfo);
@@ -107,23 +108,29 @@ private:
     bool CheckPasteAreaPosition(const MxBase::CropRoiConfig& config);
     void CalcPasteAreaPosition(MxBase::CropRoiConfig& pasteConfig);
     void CalcPasteArea(MxBase::CropRoiConfig& pasteConfig, uint32_t& dataSize);
-    void GetScalarValue(MxTools::MxpiVisionInfo &srcMxpiVisionInfo, cv::Scalar& value);
-    float OpencvRescaleProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB, uint32_t resizeDstWidth,
-                               uint32_t resizeDstHeight);
-    void OpencvRescaleDoubleProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB, uint32_t resizeDstWidth,
-                                    uint32_t resizeDstHeight);
-    void OpencvResizeProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB,
-        MxTools::MxpiVisionInfo& srcMxpiVisionInfo);
+    void GetPaddingValue(uint32_t format, float padValue[]);
+    float OpencvRescaleProcess(uint32_t srcWidth, uint32_t srcHeight, uint32_t resizeDstWidth,
+                               uint32_t resizeDstHeight, uint32_t& width, uint32_t& height);
+    APP_ERROR OpencvRescaleDoubleProcess(MxBase::LetterboxImage& image, std::vector<uint8_t>& rescaled,
+                                         uint32_t& width, uint32_t& height);
+    APP_ERROR OpencvResizeProcess(MxBase::LetterboxImage& image, std::vector<uint8_t>& rescaled, uint32_t& width,
+                                  uint32_t& height, int& interpolation);
     APP_ERROR CheckOpencvParam(MxTools::MxpiVisionInfo &srcMxpiVisionInfo,
         MxTools::MxpiVisionData &srcMxpiVisionData);
-    APP_ERROR SetOutputData(MxTools::MxpiVisionInfo &dstMxpiVisionInfo, MxTools::MxpiVisionData &dstMxpiVisionData,
-        MxTools::MxpiVisionInfo &srcMxpiVisionInfo, MxTools::MxpiVisionData &srcMxpiVisionData, cv::Mat& resizeRGB);
+    APP_ERROR GetLetterboxImage(MxTools::MxpiVisionInfo &srcMxpiVisionInfo, MxTools::MxpiVisionData &srcMxpiVisionData,
+                                MxBase::LetterboxImage& image, uint32_t& format);
+    APP_ERROR LetterboxResize(const MxBase::LetterboxImage& image, MxBase::LetterboxParam& param, int interpolation,
+                              MxBase::MemoryData& data);
+    void SetOutputData(MxTools::MxpiVisionInfo &dstMxpiVisionInfo, MxTools::MxpiVisionData &dstMxpiVisionData,
+        MxTools::MxpiVisionData &srcMxpiVisionData, const MxBase::MemoryData& data,
+        const MxBase::LetterboxGeometry& geometry, uint32_t format);
     static void SetProperties(std::vector<std::shared_ptr<void>>& properties);
-    void OpencvYolov4Process(cv::Mat& resizeRGB, cv::Mat& imageRGB);
-    void OpencvPaddleOCR(cv::Mat& resizeRGB, cv::Mat& imageRGB);
+    void OpencvYolov4Process(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height,
+                             int& interpolation);
+    void OpencvPaddleOCR(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height);
     bool CheckOpencvResizeMode();
-    void OpencvKeepAspectRatioFit(cv::Mat& resizeRGB, const cv::Mat& imageRGB);
-    void OpencvKeepAspectRatioFastRcnn(cv::Mat& resizeRGB, const cv::Mat& imageRGB);
+    void OpencvKeepAspectRatioFit(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height);
+    void OpencvKeepAspectRatioFastRcnn(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height);
     void CalcFastRcnnHW(const uint32_t inputWidth, const uint32_t inputHeight, uint32_t& outputWidth,
         uint32_t& outputHeight);
     APP_ERROR MxpiVisionPreProcess(const std::shared_ptr<MxTools::MxpiVisionList> &srcMxpiVisionListSptr,
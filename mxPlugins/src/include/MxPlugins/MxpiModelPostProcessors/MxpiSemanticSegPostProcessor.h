@@ -29,6 +29,7 @@
 #include "MxBase/Tensor/TensorBase/TensorBase.h"
 #include "MxBase/PostProcessBases/PostProcessDataType.h"
 #include "MxTools/PluginToolkit/PostProcessPluginBases/MxImagePostProcessorBase.h"
+#include "MxTools/PluginToolkit/MxpiDataTypeWrapper/MxpiDataTypeConverter.h"
 
 /**
  * This plugin is used for loading semantic segmentation modelPostProcessor and write results in metadata.
@@ -68,6 +69,9 @@ public:
     * @return MxTools::MxpiPortInfo.
     */
     static MxTools::MxpiPortInfo DefineOutputPorts();
+
+private:
+    MxTools::MaskEncoding maskEncoding_ = MxTools::MaskEncoding::RAW;
 };
 }
 #endif // MXPLUGINS_MXPISEMANTICSEGPOSTPROCESSOR
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
 #include "MxTools/Proto/MxpiDataType.pb.h"
 #include "MxBase/CV/ObjectDetection/Nms/Nms.h"
+#include "MxBase/CV/ObjectDetection/Nms/TileMerger.h"
 
 namespace MxPlugins {
 class MxpiNmsOverlapedRoiBase : public MxTools::MxPluginBase {
@@ -74,12 +75,12 @@ public:
     static MxTools::MxpiPortInfo DefineOutputPorts();
 
 protected:
+    APP_ERROR InitMergeConfig(std::map<std::string, std::shared_ptr<void>>& configParamMap);
     void CalcEffectiveArea();
     APP_ERROR GetBlockDataInfo(MxTools::MxpiBuffer &buffer);
     APP_ERROR FilterRepeatObject(std::shared_ptr<MxTools::MxpiObjectList> mxpiObjectList,
                             std::shared_ptr<MxTools::MxpiObjectList> metaDataPtr);
-    void ConvertObjectToDetectBox(std::vector<MxBase::DetectBox>& detectBoxes,
-                                  std::vector<MxTools::MxpiObject> filterObjectVec);
+    void ConvertObjectToDetectBox(const MxTools::MxpiObject& object, MxBase::DetectBox& detectBox);
     APP_ERROR ConvertDetectBoxToObject(const std::vector<MxBase::DetectBox>& detectBoxes,
                                   std::shared_ptr<MxTools::MxpiObjectList> metaDataPtr);
     void CompareBlockObject(std::shared_ptr<MxTools::MxpiObjectList> mxpiObjectList);
@@ -94,6 +95,12 @@ protected:
     std::string blockPluginName_ = "";     // Block plugin name
     float nmsValue_ = 0.f;     // Block plugin name
     std::map<int, MxTools::MxpiObject> mxpiObjectMap_ = {}; // Block object information
+    std::vector<MxBase::CropRoiBox> effectiveAreas_ = {};   // Effective area of every block, by block id
+    MxBase::TileMergeConfig mergeConfig_ = {};
+    MxBase::TileMerger merger_ = {};
+    std::vector<MxBase::DetectBox> detectBoxes_ = {};       // Reused buffers of the merge
+    std::vector<uint32_t> blockIds_ = {};
+    std::vector<MxBase::DetectBox> mergedBoxes_ = {};
 };
 }
 
@@ -0,0 +1,99 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Host OSD renderer drawing straight on NV12/NV21 planes or packed RGB/BGR images.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPLUGINS_HOSTOSDRENDERER_H
+#define MXPLUGINS_HOSTOSDRENDERER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxTools/Proto/MxpiOSDType.pb.h"
+
+namespace MxPlugins {
+struct OsdImage {
+    uint8_t* data = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t widthStride = 0;    // in pixels
+    uint32_t heightStride = 0;   // rows of the luma plane, the uv plane starts after them
+    uint32_t format = 0;         // MxBase::MxbasePixelFormat
+};
+
+/**
+ * Coverage masks of the printable ascii glyphs for one font, scale, thickness and line type, rasterized once
+ * with cv::putText and reused by every frame.
+ */
+class GlyphAtlas {
+public:
+    struct Glyph {
+        cv::Mat mask;            // coverage of the glyph, 255 is fully covered
+        cv::Point offset;        // top left of the mask relative to the pen position on the baseline
+        int advance = 0;
+    };
+
+    static std::shared_ptr<const GlyphAtlas> Get(int fontFace, double fontScale, int thickness, int lineType);
+
+    const Glyph& GetGlyph(char c) const;
+
+    GlyphAtlas(int fontFace, double fontScale, int thickness, int lineType);
+
+private:
+    std::vector<Glyph> glyphs_ = {};
+};
+
+class HostOsdRenderer {
+public:
+    static bool IsFormatSupported(uint32_t format);
+
+    /**
+     * @description: Collect the primitives of one frame, clipped to the image, then blend them in horizontal
+     * bands in parallel. Rects, texts, circles and lines are drawn in this order, the same as the aicpu operator.
+     */
+    APP_ERROR Render(const MxTools::MxpiOsdInstances& osdInstances, OsdImage& image);
+
+private:
+    struct DrawItem {
+        cv::Rect box;            // clipped to the image
+        cv::Mat mask;            // coverage of the box, empty means the box is fully covered
+        cv::Scalar color;        // b, g, r
+    };
+
+    void AddSolid(const cv::Rect& box, const cv::Scalar& color);
+    void AddMask(const cv::Rect& box, const cv::Mat& mask, const cv::Scalar& color);
+    void AddRect(const MxTools::MxpiOsdRect& rect);
+    void AddText(const MxTools::MxpiOsdText& text);
+    void AddCircle(const MxTools::MxpiOsdCircle& circle);
+    void AddLine(const MxTools::MxpiOsdLine& line);
+    void BlendBandNv12(int rowBegin, int rowEnd);
+    void BlendBandPacked(int rowBegin, int rowEnd);
+
+private:
+    OsdImage image_ = {};
+    cv::Rect imageRect_ = {};
+    std::vector<DrawItem> items_ = {};
+};
+}
+
+#endif
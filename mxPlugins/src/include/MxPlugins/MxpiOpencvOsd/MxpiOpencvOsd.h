@@ -31,6 +31,7 @@
 #include "MxBase/SingleOp/OpRunner.h"
 #include "MxBase/DvppWrapper/DvppWrapper.h"
 #include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxPlugins/MxpiOpencvOsd/HostOsdRenderer.h"
 
 class MxpiOpencvOsd : public MxTools::MxPluginBase {
 public:
@@ -92,6 +93,18 @@ private:
             std::shared_ptr<MxTools::MxpiOsdInstancesList> mxpiOsdInstancesList,
             std::shared_ptr<MxTools::MxpiVisionList> mxpiVisionListDest);
 
+    APP_ERROR HostProcess(std::shared_ptr<MxTools::MxpiVisionList> mxpiVisionList,
+            std::shared_ptr<MxTools::MxpiOsdInstancesList> mxpiOsdInstancesList,
+            std::shared_ptr<MxTools::MxpiVisionList> mxpiVisionListDest);
+
+    APP_ERROR HostDrawVision(MxTools::MxpiVision& vision, const MxTools::MxpiOsdInstances& osdList);
+
+    APP_ERROR HostCopyVision(MxTools::MxpiVision& vision);
+
+    void SetHostVisionData(MxTools::MxpiVision& vision, const MxBase::MemoryData& data);
+
+    APP_ERROR InitAicpuRunner();
+
     APP_ERROR SetOperatorDescInfo(MxBase::OperatorDesc& opDesc,
             const MxTools::MxpiOsdInstances& osdList, uint64_t dataPtr);
 
@@ -107,6 +120,7 @@ private:
     bool CheckColorValue(uint32_t value);
     bool CheckFontFace(int face);
     bool CheckTextParam(MxTools::MxpiOsdText txt);
+    bool CheckHostOsdParam(const MxTools::MxpiOsdInstances& osdList);
 
 private:
     MxBase::OpRunner runner_;
@@ -114,6 +128,9 @@ private:
     std::string dataSourceImage_ = "";
     std::string dataSourceOsd_ = "";
     MxBase::DvppWrapper dvppWrapper_;
+    bool hostOsd_ = false;
+    MxPlugins::HostOsdRenderer hostRenderer_;
+    std::vector<uint8_t> hostBuffer_ = {};
 };
 
 #endif
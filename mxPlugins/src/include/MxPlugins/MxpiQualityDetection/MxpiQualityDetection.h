@@ -25,6 +25,9 @@
 
 #include <map>
 #include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include "opencv4/opencv2/highgui.hpp"
 #include "opencv4/opencv2/imgcodecs.hpp"
@@ -39,18 +42,52 @@
 #include "MxTools/PluginToolkit/base/MxPluginBase.h"
 #include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
 #include "MxTools/Proto/MxpiDataType.pb.h"
+#include "MxBase/BlockingQueue/BlockingQueue.h"
 #include "MxBase/DvppWrapper/DvppWrapper.h"
 #include "MxBase/ErrorCode/ErrorCode.h"
 #include "MxBase/ConfigUtil/ConfigUtil.h"
 
-struct FrameInfo {
-    uint32_t frameIdPlugin;
-    uint32_t frameIdVdec;
-    uint32_t channelIdVdec;
-    cv::Mat rgbData;
+namespace MxPlugins {
+/**
+ * Analysis pyramid of one frame. It is built once per frame on the host from the luma plane only, and every
+ * detector reads the level it needs. Chroma is fetched only when the color cast detection is due.
+ */
+struct AnalysisFrame {
+    uint32_t frameIdVdec = 0;
+    uint32_t dueMask = 0;               // detections due on this frame, one bit per detection type
+    float scale = 1.f;                  // full resolution pixels per analysis pixel
+    cv::Mat fullLuma;                   // luma plane copied from device, released after the pyramid is built
+    cv::Mat fullChroma;                 // interleaved uv plane, only when the color cast detection is due
+    cv::Mat luma;                       // level 0, downscaled luma for the spatial detections
+    cv::Mat thumb;                      // level 1, kept in the history for the temporal detections
+    cv::Mat rgb;                        // downscaled rgb, only when the color cast detection is due
+    std::vector<int> hist = {};         // luma histogram of level 0, shared by brightness and black screen
+    std::vector<int> rowProfile = {};   // zero mean row projections of level 0, for the view shake detection
+    std::vector<int> colProfile = {};   // zero mean col projections of level 0, for the view shake detection
+};
+
+/**
+ * Per-channel state. All frames of one channel are analyzed by the same worker, so the state is never shared
+ * between two threads.
+ */
+struct ChannelState {
+    uint32_t channelId = 0;
+    uint32_t frameIdCur = 0;
+    std::deque<std::shared_ptr<AnalysisFrame>> history = {};
+    // running sums of the two halves of the PTZ movement window, updated once per frame
+    cv::Mat ptzHeadSum;
+    cv::Mat ptzTailSum;
+    bool ptzSumValid = false;
+    // a frame of the channel was not queued, only read and written by the streaming thread
+    bool dropPending = false;
+};
+
+struct AnalysisTask {
+    std::shared_ptr<ChannelState> channel = nullptr;
+    std::shared_ptr<AnalysisFrame> frame = nullptr;
+    bool resetHistory = false;          // frames were dropped before this one, the history has a gap
 };
 
-namespace MxPlugins {
 class MxpiQualityDetection : public MxTools::MxPluginBase {
 public:
     APP_ERROR Init(std::map<std::string, std::shared_ptr<void>> &configParamMap) override;
@@ -66,42 +103,56 @@ private:
     APP_ERROR CheckImageDectParams(void);
     APP_ERROR CheckVideoDectParams(void);
     APP_ERROR LoadConfig(std::string configPath);
-    bool FrameSkip(bool switchDetection, uint32_t frameInterval);
-    APP_ERROR ImageFormatConversion(MxTools::MxpiVision visionItem);
+    APP_ERROR StartWorkers(void);
+    void StopWorkers(void);
+    void WorkerThread(uint32_t workerId);
+    std::shared_ptr<ChannelState> GetChannelState(uint32_t channelId);
+    uint32_t GetDueMask(const ChannelState &channel);
+    bool IsTemporalEnabled(void);
+    APP_ERROR CopyFramePlanes(const MxTools::MxpiVision &visionItem, AnalysisFrame &frame);
+    APP_ERROR ImageFormatConversion(const MxTools::MxpiVision &visionItem, uint32_t frameIdVdec, uint32_t channelId);
     APP_ERROR ImageProcessAndDetection(MxTools::MxpiBuffer &buffer);
-    APP_ERROR DetectionProcess(void);
+    void DispatchTask(AnalysisTask &task);
+    void AnalyzeFrame(AnalysisTask &task);
+    void BuildPyramid(AnalysisFrame &frame);
+    void UpdateHistory(ChannelState &channel, const std::shared_ptr<AnalysisFrame> &frame);
+    APP_ERROR DetectionProcess(ChannelState &channel, const AnalysisFrame &frame);
 
-    APP_ERROR ImageBrightnessDetection(void);
-    APP_ERROR ImageOcclusionDetection(void);
-    APP_ERROR ImageBlurDetection(void);
-    APP_ERROR ImageNoiseDetection(void);
-    APP_ERROR CheckValuePixelSum(int pixelSum, int noiseNum);
-    APP_ERROR ImageColorCastDetection(void);
+    APP_ERROR ImageBrightnessDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR ImageOcclusionDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR ImageBlurDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR ImageNoiseDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR CheckValuePixelSum(int pixelSum, int noiseNum, uint32_t frameIdVdec, uint32_t channelId);
+    APP_ERROR ImageColorCastDetection(ChannelState &channel, const AnalysisFrame &frame);
     double StripeRateCalculation(const cv::Mat &imgGray);
-    APP_ERROR ImageStripeDetection(void);
-    APP_ERROR BlackScreenDetection(void);
-    APP_ERROR VideoFreezeDetection(void);
+    APP_ERROR ImageStripeDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR BlackScreenDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR VideoFreezeDetection(ChannelState &channel, const AnalysisFrame &frame);
     APP_ERROR ViewShakeOffsetCal(const cv::Mat &imageGray, std::vector<int> &sumRowVec, std::vector<int> &sumColVec);
-    int ViewShakeCalMin(std::vector<int> &sumVecImage1, std::vector<int> &sumVecImage2, const int searchLen);
-    APP_ERROR ViewShakeDetection(void);
-    APP_ERROR SceneMutationDetection(void);
+    int ViewShakeCalMin(const std::vector<int> &sumVecImage1, const std::vector<int> &sumVecImage2,
+        const int searchLen);
+    APP_ERROR ViewShakeDetection(ChannelState &channel, const AnalysisFrame &frame);
+    APP_ERROR SceneMutationDetection(ChannelState &channel, const AnalysisFrame &frame);
     float PTZMovementHistSim(const cv::Mat &imageGrayAvg1, const cv::Mat &imageGrayAvg2);
-    APP_ERROR PTZMovementDetection(void);
+    APP_ERROR PTZMovementDetection(ChannelState &channel, const AnalysisFrame &frame);
 
-    typedef APP_ERROR (MxpiQualityDetection::*DoDetection)(void);
+    typedef APP_ERROR (MxpiQualityDetection::*DoDetection)(ChannelState &, const AnalysisFrame &);
     std::map<int, DoDetection> keyToHandle;
-    APP_ERROR DetectionWithKey(int detectionType);
+    APP_ERROR DetectionWithKey(int detectionType, ChannelState &channel, const AnalysisFrame &frame);
     void MapKeyToHandle(void);
 
 private:
     std::ostringstream errorInfo_;
-    std::uint32_t frameIdCur_ = 0;
-    std::uint32_t frameIdVdec_;
-    std::uint32_t channelIdVdec_;
-    std::deque<FrameInfo> frameList_ = {};
     MxBase::ConfigData configData_;
+    std::mutex channelMutex_ = {};
+    std::map<uint32_t, std::shared_ptr<ChannelState>> channels_ = {};
+    std::vector<std::shared_ptr<MxBase::BlockingQueue<AnalysisTask>>> taskQueues_ = {};
+    std::vector<std::thread> workers_ = {};
+    uint32_t droppedTaskCount_ = 0;
 
     uint32_t frameListMaxLen_ = 20;
+    uint32_t analysisWidth_ = 0;
+    uint32_t analysisThreadNum_ = 1;
     bool switchBrightnessDetection_ = false;
     uint32_t frameIntervalBrightnessDetection_ = 10;
     float thresholdBrightnessFactor_ = 1;
@@ -87,6 +87,9 @@ private:
 
     APP_ERROR CheckRoiWithImageSize();
 
+    void SkipEmptyBlocks(MxTools::MxpiBuffer &buffer, std::vector<MxBase::CropRoiBox> &cropRoiVec,
+        std::vector<MxBase::CropRoiBox> &mergeRoiVec);
+
 private:
     int blockHeight_ = 1;
     int blockWidth_ = 1;
@@ -100,6 +103,8 @@ private:
     std::vector<MxBase::CropRoiBox> cropRoiVec_ {};
     std::vector<MxBase::CropRoiBox> mergeRoiVec_ {};
     bool needMergeRoi_ = true;
+    std::string hintDataSource_ = "";    // objects found on a low resolution pass, blocks without any are skipped
+    int hintMargin_ = 0;
 };
 }
 
@@ -0,0 +1,92 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Adaptive skip ratio controller shared by the MxpiSkipFrame instances of a group.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPLUGINS_ADAPTIVESKIPCONTROLLER_H
+#define MXPLUGINS_ADAPTIVESKIPCONTROLLER_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace MxPlugins {
+struct AdaptiveSkipConfig {
+    uint32_t minSkipNum = 0;        // skip number when the pipeline is idle
+    uint32_t maxSkipNum = 0;        // upper bound, keeps one frame of every (maxSkipNum + 1) for tracking
+    float highWaterMark = 0.8f;     // queue fill ratio which raises the skip number
+    float lowWaterMark = 0.3f;      // queue fill ratio below which the skip number may be lowered
+    float targetLatency = 0.f;      // target of the estimated queueing latency, in milliseconds
+};
+
+struct AdaptiveSkipSample {
+    float fillRatio = 0.f;          // max fill ratio of the watched queues
+    float latency = 0.f;            // estimated queueing latency, in milliseconds
+};
+
+class AdaptiveSkipController {
+public:
+    static AdaptiveSkipController& GetInstance();
+
+    /**
+    * @description: Register one channel (one MxpiSkipFrame instance) into a group.
+    */
+    void Register(const std::string& group, const std::string& channel, uint32_t skipNum);
+
+    /**
+    * @description: Remove one channel from its group.
+    */
+    void Unregister(const std::string& group, const std::string& channel);
+
+    /**
+    * @description: Feed one sample of the channel and get its new skip number. The skip number moves by one step
+    * at a time with hysteresis between the water marks, and channels which are further behind than the group
+    * average are raised first and lowered last.
+    */
+    uint32_t Adjust(const std::string& group, const std::string& channel, const AdaptiveSkipConfig& config,
+                    const AdaptiveSkipSample& sample);
+
+    /**
+    * @description: Current skip ratio of the channel, i.e. the fraction of frames dropped.
+    */
+    float GetSkipRatio(const std::string& group, const std::string& channel);
+
+    AdaptiveSkipController(const AdaptiveSkipController&) = delete;
+    AdaptiveSkipController& operator=(const AdaptiveSkipController&) = delete;
+
+private:
+    AdaptiveSkipController() = default;
+    ~AdaptiveSkipController() = default;
+
+    struct ChannelState {
+        uint32_t skipNum = 0;
+        float lag = 0.f;
+    };
+
+    float GetGroupMeanLag(const std::map<std::string, ChannelState>& channels) const;
+
+private:
+    std::mutex mtx_ = {};
+    std::map<std::string, std::map<std::string, ChannelState>> groups_ = {};
+};
+}
+
+#endif
@@ -23,11 +23,14 @@
 #ifndef MXPLUGINS_MXPISKIPFRAME_H
 #define MXPLUGINS_MXPISKIPFRAME_H
 
+#include <chrono>
+
 #include "MxBase/ErrorCode/ErrorCode.h"
 #include "MxTools/PluginToolkit/base/MxPluginGenerator.h"
 #include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
 #include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
 #include "MxTools/Proto/MxpiDataType.pb.h"
+#include "MxPlugins/MxpiSkipFrame/AdaptiveSkipController.h"
 
 /**
  * This plugin is used for skip frame.
@@ -83,11 +86,68 @@ private:
     */
     APP_ERROR InitAndRefreshProps();
 
+    /**
+    * @api
+    * @brief Init the properties of adaptive mode
+    * @return
+    */
+    APP_ERROR InitAdaptiveProps();
+
+    /**
+    * @api
+    * @brief Find the watched queue elements in the stream
+    * @return
+    */
+    void ResolveWatchQueues();
+
+    /**
+    * @api
+    * @brief Sample the watched queues and estimate the queueing latency
+    * @return
+    */
+    AdaptiveSkipSample SampleWatchQueues(float elapsedMs);
+
+    /**
+    * @api
+    * @brief Update the skip number from the downstream load when the adjust interval elapsed
+    * @return
+    */
+    void AdjustSkipFrameNum();
+
+    /**
+    * @api
+    * @brief Whether the frame id of the buffer falls on the key frame cadence
+    * @return
+    */
+    bool IsKeyFrame(MxTools::MxpiMetadataManager& mxpiMetadataManager);
+
+    /**
+    * @api
+    * @brief Publish the current skip ratio to the performance statistics log
+    * @return
+    */
+    void PublishSkipRatio(const AdaptiveSkipSample& sample);
+
 private:
     // skip frame num
     uint32_t skipFrameNum_ = 0;
     // frame count
     uint32_t frameCount_ = 0;
+    // frames whose frame id is a multiple of it are always sent, 0 disables it
+    uint32_t keyFrameInterval_ = 0;
+    // adaptive mode
+    bool adaptive_ = false;
+    std::string skipGroup_ = "";
+    std::string channelKey_ = "";
+    AdaptiveSkipConfig adaptiveConfig_ = {};
+    uint32_t adjustInterval_ = 0;
+    uint32_t adaptiveSkipNum_ = 0;
+    std::vector<std::string> watchQueueNames_ = {};
+    std::vector<void*> watchQueues_ = {};
+    bool watchQueuesResolved_ = false;
+    std::chrono::steady_clock::time_point lastAdjustTime_ = {};
+    uint32_t sentInWindow_ = 0;
+    uint32_t lastQueueLevel_ = 0;
     // config parameter map
     std::map<std::string, std::shared_ptr<void>>* configParamMap_ = nullptr;
 };
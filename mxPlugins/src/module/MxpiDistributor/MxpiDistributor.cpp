@@ -39,7 +39,7 @@ const std::string PROPERTY_DEFAULT_VALUE = "";
 const char LEVEL_FIRST_SPLIT_RULE = ',';
 const char LEVEL_SECOND_SPLIT_RULE = '|';
 
-bool IsElementInVector(std::vector<std::string> v, const std::string& e)
+bool IsElementInVector(const std::vector<std::string>& v, const std::string& e)
 {
     return !(std::find(v.begin(), v.end(), e) == v.end());
 }
@@ -293,75 +293,30 @@ APP_ERROR MxpiDistributor::DistributeByClassId(MxpiBuffer* mxpiBuffer)
     return ret;
 }
 
-bool MxpiDistributor::NoDataOfInterested(std::vector<std::shared_ptr<MxTools::MxpiObjectList>> &objlistVec)
+bool MxpiDistributor::NoDataOfInterested(const std::vector<std::vector<int>> &memberIdsVec)
 {
-    for (size_t i = 0; i < objlistVec.size(); i++) {
-        if (objlistVec[i]->objectvec().size() != 0) {
+    for (size_t i = 0; i < memberIdsVec.size(); i++) {
+        if (!memberIdsVec[i].empty()) {
             return false;
         }
     }
     return true;
 }
 
-bool MxpiDistributor::NoDataOfInterested(std::vector<std::shared_ptr<MxTools::MxpiClassList>> &clslistVec)
+void MxpiDistributor::SelectMember(int memberId, int32_t classId, std::vector<std::vector<int>> &memberIdsVec)
 {
-    for (size_t i = 0; i < clslistVec.size(); i++) {
-        if (clslistVec[i]->classvec().size() != 0) {
-            return false;
+    std::string classIdStr = std::to_string(classId);
+    for (size_t j = 0; j < firstLevelIdVec_.size(); j++) {
+        if (IsElementInVector(secondLevelIdVec_[j], classIdStr)) {
+            memberIdsVec[j].push_back(memberId);
         }
     }
-    return true;
-}
-
-APP_ERROR MxpiDistributor::CopyMxpiObject(size_t i, MxTools::MxpiObject &dst, const MxTools::MxpiObject &src)
-{
-    dst.CopyFrom(src);
-    dst.clear_headervec();
-    MxTools::MxpiMetaHeader *header = dst.add_headervec();
-    if (CheckPtrIsNullptr(header, "header"))  return APP_ERR_COMM_ALLOC_MEM;
-    header->set_datasource(parentName_);
-    header->set_memberid(i);
-    return APP_ERR_OK;
 }
 
-APP_ERROR MxpiDistributor::GetObjectListVec(std::vector<std::shared_ptr<MxTools::MxpiObjectList>> &objectListVec,
-    const std::shared_ptr<void> dataPtr)
+APP_ERROR MxpiDistributor::DistributeListByClassId(const std::vector<std::vector<int>> &memberIdsVec,
+    const std::string &dataStructure, MxTools::MxpiBuffer* mxpiBuffer)
 {
-    std::shared_ptr<MxTools::MxpiObjectList> objectList = std::static_pointer_cast<MxTools::MxpiObjectList>(dataPtr);
-    for (size_t i = 0; i < firstLevelIdVec_.size(); i++) {
-        objectListVec[i] = MemoryHelper::MakeShared<MxTools::MxpiObjectList>();
-        if (objectListVec[i] == nullptr) {
-            LogError << "Fail to allocate memory." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
-            return APP_ERR_COMM_ALLOC_MEM;
-        }
-    }
-    for (int i = 0; i < objectList->objectvec().size(); i++) {
-        int32_t classId = objectList->objectvec(i).classvec(0).classid();
-        for (size_t j = 0; j < firstLevelIdVec_.size(); j++) {
-            if (!IsElementInVector(secondLevelIdVec_[j], std::to_string(classId))) {
-                continue;
-            }
-            MxTools::MxpiObject* mxpiObject = objectListVec[j]->add_objectvec();
-            if (CheckPtrIsNullptr(mxpiObject, "mxpiObject"))  return APP_ERR_COMM_ALLOC_MEM;
-            APP_ERROR ret = CopyMxpiObject(i, *mxpiObject, objectList->objectvec(i));
-            if (ret != APP_ERR_OK) {
-                LogError << "Fail to copy mxpiObject." << GetErrorInfo(ret);
-                return ret;
-            }
-        }
-    }
-    return APP_ERR_OK;
-}
-
-APP_ERROR MxpiDistributor::DistributeObjectListByClassId(const std::shared_ptr<void> dataPtr,
-    MxTools::MxpiBuffer* mxpiBuffer)
-{
-    std::vector<std::shared_ptr<MxTools::MxpiObjectList>> objectListVec(firstLevelIdVec_.size());
-    APP_ERROR ret = GetObjectListVec(objectListVec, dataPtr);
-    if (ret != APP_ERR_OK) {
-        return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
-    }
-    if (!distributeAll_ && NoDataOfInterested(objectListVec)) {
+    if (!distributeAll_ && NoDataOfInterested(memberIdsVec)) {
         LogDebug << "element(" << elementName_
                  << ") found no object that's class id belongs to specified category.";
         return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
@@ -370,17 +325,17 @@ APP_ERROR MxpiDistributor::DistributeObjectListByClassId(const std::shared_ptr<v
     for (size_t i = 0; i < firstLevelIdVec_.size(); i++) {
         std::string name = elementName_ + "_" + std::to_string(i);
         LogDebug << "element(" << elementName_
-                 << ") distibute data(data structure:MxpiObjectList) by class id."
-                 << "object number: " << objectListVec[i]->objectvec().size();
-        if (objectListVec[i]->objectvec().size() != 0) {
-            std::shared_ptr<void> metadata = std::static_pointer_cast<void>(objectListVec[i]);
-            ret = mxpiMetadataManager.AddProtoMetadata(name, metadata);
+                 << ") distribute data(data structure:" << dataStructure << ") by class id."
+                 << "object number: " << memberIdsVec[i].size();
+        // the ports share the input list, the members of a port are copied when its branch gets them
+        if (!memberIdsVec[i].empty()) {
+            APP_ERROR ret = mxpiMetadataManager.AddProtoMetadataView(name, parentName_, memberIdsVec[i]);
             if (ret != APP_ERR_OK) {
                 LogDebug << "element(" << elementName_ << ") add proto metadata failed.";
                 return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
             }
         }
-        if (distributeAll_ || objectListVec[i]->objectvec().size() != 0) {
+        if (distributeAll_ || !memberIdsVec[i].empty()) {
             gst_buffer_ref((GstBuffer*) mxpiBuffer->buffer);
             MxTools::MxpiBuffer* tmpBuffer = new(std::nothrow) MxpiBuffer {mxpiBuffer->buffer, nullptr};
             if (tmpBuffer == nullptr) {
@@ -393,6 +348,17 @@ APP_ERROR MxpiDistributor::DistributeObjectListByClassId(const std::shared_ptr<v
     return APP_ERR_OK;
 }
 
+APP_ERROR MxpiDistributor::DistributeObjectListByClassId(const std::shared_ptr<void> dataPtr,
+    MxTools::MxpiBuffer* mxpiBuffer)
+{
+    std::shared_ptr<MxTools::MxpiObjectList> objectList = std::static_pointer_cast<MxTools::MxpiObjectList>(dataPtr);
+    std::vector<std::vector<int>> memberIdsVec(firstLevelIdVec_.size());
+    for (int i = 0; i < objectList->objectvec().size(); i++) {
+        SelectMember(i, objectList->objectvec(i).classvec(0).classid(), memberIdsVec);
+    }
+    return DistributeListByClassId(memberIdsVec, OBJECT_LIST_KEY, mxpiBuffer);
+}
+
 APP_ERROR MxpiDistributor::DistributeObjectByClassId(const std::shared_ptr<void> dataPtr,
     MxTools::MxpiBuffer* mxpiBuffer)
 {
@@ -425,84 +391,15 @@ APP_ERROR MxpiDistributor::DistributeObjectByClassId(const std::shared_ptr<void>
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiDistributor::CopyMxpiClass(size_t i, MxTools::MxpiClass &dst, const MxTools::MxpiClass &src)
-{
-    dst.CopyFrom(src);
-    dst.clear_headervec();
-    MxTools::MxpiMetaHeader *header = dst.add_headervec();
-    if (CheckPtrIsNullptr(header, "header"))  return APP_ERR_COMM_ALLOC_MEM;
-    header->set_datasource(parentName_);
-    header->set_memberid(i);
-    return APP_ERR_OK;
-}
-
-APP_ERROR MxpiDistributor::GetclassListVec(std::vector<std::shared_ptr<MxTools::MxpiClassList>> &classListVec,
-    const std::shared_ptr<void> dataPtr)
-{
-    std::shared_ptr<MxTools::MxpiClassList> classList = std::static_pointer_cast<MxTools::MxpiClassList>(dataPtr);
-    for (size_t i = 0; i < firstLevelIdVec_.size(); i++) {
-        classListVec[i] = MemoryHelper::MakeShared<MxTools::MxpiClassList>();
-        if (classListVec[i] == nullptr) {
-            LogError << "Fail to allocate memory." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
-            return APP_ERR_COMM_ALLOC_MEM;
-        }
-    }
-    for (int i = 0; i < classList->classvec().size(); i++) {
-        int32_t classId = classList->classvec(i).classid();
-        for (size_t j = 0; j < firstLevelIdVec_.size(); j++) {
-            if (!IsElementInVector(secondLevelIdVec_[j], std::to_string(classId))) {
-                continue;
-            }
-            MxTools::MxpiClass* mxpiClass = classListVec[j]->add_classvec();
-            if (CheckPtrIsNullptr(mxpiClass, "mxpiClass"))  return APP_ERR_COMM_ALLOC_MEM;
-            APP_ERROR ret = CopyMxpiClass(i, *mxpiClass, classList->classvec(i));
-            if (ret != APP_ERR_OK) {
-                LogError << "Fail to copy mxpiClass." << GetErrorInfo(ret);
-                return ret;
-            }
-        }
-    }
-    return APP_ERR_OK;
-}
-
 APP_ERROR MxpiDistributor::DistributeClassListByClassId(const std::shared_ptr<void> dataPtr,
     MxTools::MxpiBuffer* mxpiBuffer)
 {
-    std::vector<std::shared_ptr<MxTools::MxpiClassList>> classListVec(firstLevelIdVec_.size());
-    APP_ERROR ret = GetclassListVec(classListVec, dataPtr);
-    if (ret != APP_ERR_OK) {
-        return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
-    }
-    if (!distributeAll_ && NoDataOfInterested(classListVec)) {
-        LogDebug << "element(" << elementName_
-                 << ") found no object that's class id belongs to specified category.";
-        return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
-    }
-    MxTools::MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
-    for (size_t i = 0; i < firstLevelIdVec_.size(); i++) {
-        std::string name = elementName_ + "_" + std::to_string(i);
-        LogDebug << "element(" << elementName_
-                 << ") distribute data(data structure:MxpiClassList) by class id."
-                 << ", object number: " << classListVec[i]->classvec().size();
-        if (classListVec[i]->classvec().size() != 0) {
-            std::shared_ptr<void> metadata = std::static_pointer_cast<void>(classListVec[i]);
-            ret = mxpiMetadataManager.AddProtoMetadata(name, metadata);
-            if (ret != APP_ERR_OK) {
-                LogDebug << "element(" << elementName_ << ") add proto metadata failed.";
-                return MxpiBufferManager::DestroyBuffer(mxpiBuffer);
-            }
-        }
-        if (distributeAll_ || classListVec[i]->classvec().size() != 0) {
-            gst_buffer_ref((GstBuffer*) mxpiBuffer->buffer);
-            MxTools::MxpiBuffer* tmpBuffer = new(std::nothrow) MxpiBuffer {mxpiBuffer->buffer, nullptr};
-            if (tmpBuffer == nullptr) {
-                return MallocFailedHandle(mxpiBuffer);
-            }
-            SendData(i, *tmpBuffer);
-        }
+    std::shared_ptr<MxTools::MxpiClassList> classList = std::static_pointer_cast<MxTools::MxpiClassList>(dataPtr);
+    std::vector<std::vector<int>> memberIdsVec(firstLevelIdVec_.size());
+    for (int i = 0; i < classList->classvec().size(); i++) {
+        SelectMember(i, classList->classvec(i).classid(), memberIdsVec);
     }
-    MxpiBufferManager::DestroyBuffer(mxpiBuffer);
-    return ret;
+    return DistributeListByClassId(memberIdsVec, CLASS_LIST_KEY, mxpiBuffer);
 }
 
 APP_ERROR MxpiDistributor::DistributeClassByClassId(const std::shared_ptr<void> dataPtr,
@@ -0,0 +1,178 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Send a child buffer sharing the memory and the metadata of the input buffer to every output port.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxPlugins/MxpiForkJoin/MxpiFork/MxpiFork.h"
+#include "MxBase/Log/Log.h"
+#include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxPlugins/MxpiPluginsUtils/MxpiPluginsUtils.h"
+
+using namespace MxBase;
+using namespace MxTools;
+using namespace MxPlugins;
+
+namespace {
+const std::string FRAME_INFO_KEY = "ReservedFrameInfo";
+// the memory is referenced by the child, the metas are not copied since the metadata is shared afterwards
+const auto CHILD_COPY_FLAGS = static_cast<GstBufferCopyFlags>(GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS |
+                                                              GST_BUFFER_COPY_MEMORY);
+}
+
+APP_ERROR MxpiFork::Init(std::map<std::string, std::shared_ptr<void>> &)
+{
+    LogInfo << "Begin to initialize MxpiFork(" << elementName_ << ").";
+    if (srcPadNum_ == 0) {
+        LogError << "The number of output ports is zero. please check your pipeline."
+                 << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    sequence_ = 0;
+    LogInfo << "End to initialize MxpiFork(" << elementName_ << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiFork::DeInit()
+{
+    LogInfo << "Begin to deinitialize MxpiFork(" << elementName_ << ").";
+    LogInfo << "End to deinitialize MxpiFork(" << elementName_ << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiFork::Process(std::vector<MxpiBuffer *> &mxpiBuffer)
+{
+    LogDebug << "Begin to process MxpiFork(" << elementName_ << ").";
+    errorInfo_.str("");
+    auto ret = CheckMxpiBufferIsValid(mxpiBuffer);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    auto context = MemoryHelper::MakeShared<MxpiForkContext>();
+    if (context == nullptr) {
+        errorInfo_ << "Create MxpiForkContext object failed." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        LogError << errorInfo_.str();
+        return SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, APP_ERR_COMM_ALLOC_MEM, errorInfo_.str());
+    }
+    // from now on the parent is released with the last child
+    context->parent = mxpiBuffer[0];
+    context->sequence = sequence_++;
+    SetFrameInfo(*context->parent, *context);
+
+    // all children are created before the first one is sent, so that the context is complete in every branch
+    std::vector<MxpiBuffer*> childVec;
+    for (size_t i = 0; i < srcPadNum_; i++) {
+        MxpiBuffer* childMxpiBuffer = CreateChildBuffer(*context->parent, context);
+        if (childMxpiBuffer == nullptr) {
+            for (auto child : childVec) {
+                MxpiBufferManager::DestroyBuffer(child);
+            }
+            // the context holds no child now, the parent is taken back to carry the error downstream
+            MxpiBuffer* parent = context->parent;
+            context->parent = nullptr;
+            errorInfo_ << "element(" << elementName_ << ") failed to create the child buffers of frame("
+                       << context->frameId << ")." << GetErrorInfo(APP_ERR_COMM_FAILURE);
+            LogError << errorInfo_.str();
+            return SendMxpiErrorInfo(*parent, elementName_, APP_ERR_COMM_FAILURE, errorInfo_.str());
+        }
+        childVec.push_back(childMxpiBuffer);
+    }
+    context.reset();
+    for (size_t i = 0; i < childVec.size(); i++) {
+        ret = SendData(i, *childVec[i]);
+        if (ret != APP_ERR_OK) {
+            LogWarn << "element(" << elementName_ << ") failed to send data to port(" << i << "), the frame is joined "
+                    << "without this branch.";
+        }
+    }
+    LogDebug << "End to process MxpiFork(" << elementName_ << ").";
+    return APP_ERR_OK;
+}
+
+MxpiBuffer* MxpiFork::CreateChildBuffer(MxpiBuffer& parentMxpiBuffer, const std::shared_ptr<MxpiForkContext>& context)
+{
+    auto* gstBuffer = gst_buffer_new();
+    if (gstBuffer == nullptr) {
+        LogError << "Create gst buffer failed." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return nullptr;
+    }
+    if (!gst_buffer_copy_into(gstBuffer, (GstBuffer*) parentMxpiBuffer.buffer, CHILD_COPY_FLAGS, 0, -1)) {
+        gst_buffer_unref(gstBuffer);
+        LogError << "Share the memory of the input buffer failed." << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        return nullptr;
+    }
+    auto* childMxpiBuffer = new (std::nothrow) MxpiBuffer {gstBuffer, nullptr};
+    if (childMxpiBuffer == nullptr) {
+        gst_buffer_unref(gstBuffer);
+        LogError << "Create MxpiBuffer object failed." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return nullptr;
+    }
+    MxpiMetadataManager parentManager(parentMxpiBuffer);
+    APP_ERROR ret = parentManager.ShareMetadata(*childMxpiBuffer);
+    if (ret != APP_ERR_OK) {
+        MxpiBufferManager::DestroyBuffer(childMxpiBuffer);
+        LogError << "Share the metadata of the input buffer failed." << GetErrorInfo(ret);
+        return nullptr;
+    }
+    MxpiMetadataManager childManager(*childMxpiBuffer);
+    // an invalid input stays invalid in every branch, the error informations are copied since branches add to them
+    auto errorInfo = parentManager.GetErrorInfo();
+    if (errorInfo != nullptr) {
+        for (auto& item : *errorInfo) {
+            childManager.AddErrorInfo(item.first, item.second);
+        }
+    }
+    ret = childManager.AddMetadata(elementName_, std::static_pointer_cast<void>(context));
+    if (ret != APP_ERR_OK) {
+        MxpiBufferManager::DestroyBuffer(childMxpiBuffer);
+        LogError << "Add the fork context to the child buffer failed." << GetErrorInfo(ret);
+        return nullptr;
+    }
+    return childMxpiBuffer;
+}
+
+void MxpiFork::SetFrameInfo(MxpiBuffer& parentMxpiBuffer, MxpiForkContext& context)
+{
+    MxpiMetadataManager mxpiMetadataManager(parentMxpiBuffer);
+    auto frameInfo = std::static_pointer_cast<MxpiFrameInfo>(mxpiMetadataManager.GetMetadata(FRAME_INFO_KEY));
+    if (frameInfo != nullptr) {
+        context.frameId = frameInfo->frameid();
+        context.channelId = frameInfo->channelid();
+    }
+}
+
+MxpiPortInfo MxpiFork::DefineInputPorts()
+{
+    MxpiPortInfo inputPortInfo;
+    std::vector<std::vector<std::string>> value = {{"ANY"}};
+    GenerateStaticInputPortsInfo(value, inputPortInfo);
+    return inputPortInfo;
+}
+
+MxpiPortInfo MxpiFork::DefineOutputPorts()
+{
+    MxpiPortInfo outputPortInfo;
+    std::vector<std::vector<std::string>> value = {{"ANY"}};
+    GenerateDynamicOutputPortsInfo(value, outputPortInfo);
+    return outputPortInfo;
+}
+
+namespace {
+    MX_PLUGIN_GENERATE(MxpiFork)
+}
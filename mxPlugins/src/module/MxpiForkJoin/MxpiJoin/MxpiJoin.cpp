@@ -0,0 +1,239 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Join the branches started by mxpi_fork, the metadata of the branches is merged into the input buffer.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxPlugins/MxpiForkJoin/MxpiJoin/MxpiJoin.h"
+#include <algorithm>
+#include "MxBase/Log/Log.h"
+#include "MxBase/DeviceManager/DeviceManager.h"
+#include "MxPlugins/MxpiPluginsUtils/MxpiPluginsUtils.h"
+
+using namespace MxBase;
+using namespace MxTools;
+using namespace MxPlugins;
+
+namespace {
+const uint32_t CHECK_FREQUENCY = 10;
+const uint32_t DEFAULT_TIMEOUT = 3000;
+const uint32_t ORPHAN_CHECK_INTERVAL = 100;
+}
+
+APP_ERROR MxpiJoin::Init(std::map<std::string, std::shared_ptr<void>> &configParamMap)
+{
+    LogInfo << "Begin to initialize MxpiJoin(" << elementName_ << ").";
+    std::vector<std::string> parameterNamesPtr = {"dataSourceFork", "timeout"};
+    auto ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
+    if (ret != APP_ERR_OK) {
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    forkName_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceFork"]);
+    timeout_ = *std::static_pointer_cast<uint32_t>(configParamMap["timeout"]);
+    if (forkName_.empty()) {
+        LogError << "The property dataSourceFork of element(" << elementName_
+                 << ") is empty, please set it to the name of the mxpi_fork element."
+                 << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    if (sinkPadNum_ == 0) {
+        LogError << "The number of input ports is zero. please check your pipeline."
+                 << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    // status must be ASYNC, the branches are matched by frame and not by arrival order
+    if (status_ != MxTools::ASYNC) {
+        LogDebug << "element(" << elementName_
+                 << ") status must be async(0), you set status sync(1), so force status to async(0).";
+        status_ = MxTools::ASYNC;
+    }
+    runningFlag_ = true;
+    // the thread also sends the frames whose missing branches dropped their buffers, so it runs without timeout too
+    thread_ = std::thread(&MxpiJoin::TimeoutCall, this);
+    LogInfo << "element(" << elementName_ << ") joins the branches of (" << forkName_ << "), timeout(" << timeout_
+            << "ms).";
+    LogInfo << "End to initialize MxpiJoin(" << elementName_ << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiJoin::DeInit()
+{
+    LogInfo << "Begin to deinitialize MxpiJoin(" << elementName_ << ").";
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    runningFlag_ = false;
+    for (auto& item : pendingFrames_) {
+        item.second.context->joined = true;
+    }
+    pendingFrames_.clear();
+    lock.unlock();
+    condition_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    LogInfo << "End to deinitialize MxpiJoin(" << elementName_ << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiJoin::Process(std::vector<MxpiBuffer *> &mxpiBuffer)
+{
+    LogDebug << "Begin to process MxpiJoin(" << elementName_ << ").";
+    errorInfo_.str("");
+    // the status is async, only the port the buffer arrived on is set
+    size_t index = 0;
+    while (index < mxpiBuffer.size() && mxpiBuffer[index] == nullptr) {
+        index++;
+    }
+    if (index == mxpiBuffer.size()) {
+        LogError << "Invalid mxpiBuffer, no input port has data." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    MxpiBuffer* childMxpiBuffer = mxpiBuffer[index];
+    MxpiMetadataManager childManager(*childMxpiBuffer);
+    auto context = std::static_pointer_cast<MxpiForkContext>(childManager.GetMetadata(forkName_));
+    if (context == nullptr) {
+        errorInfo_ << "The buffer of port(" << index << ") does not come from element(" << forkName_ << ")."
+                   << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        LogError << errorInfo_.str();
+        return SendMxpiErrorInfo(*childMxpiBuffer, elementName_, APP_ERR_COMM_INVALID_PARAM, errorInfo_.str());
+    }
+    // the context is not merged into the parent, only the children in flight may keep it alive
+    childManager.RemoveMetadata(forkName_);
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    auto& pendingFrame = pendingFrames_[context->sequence];
+    if (context->joined || (pendingFrame.context != nullptr && pendingFrame.arrived[index])) {
+        LogWarn << "element(" << elementName_ << ") drops the buffer of port(" << index << ") of frame("
+                << context->frameId << ") channel(" << context->channelId << "), the frame was joined already.";
+        if (pendingFrame.context == nullptr) {
+            pendingFrames_.erase(context->sequence);
+        }
+        MxpiBufferManager::DestroyBuffer(childMxpiBuffer);
+        return APP_ERR_OK;
+    }
+    if (pendingFrame.context == nullptr) {
+        pendingFrame.context = context;
+        pendingFrame.arrived.assign(sinkPadNum_, false);
+        pendingFrame.startTime = std::chrono::steady_clock::now();
+    }
+    pendingFrame.arrived[index] = true;
+    pendingFrame.arrivedNum++;
+    // the parent is not used anywhere else until it is sent, the keys added by the branch are referenced only
+    MxpiMetadataManager parentManager(*context->parent);
+    APP_ERROR ret = parentManager.MergeMetadata(*childMxpiBuffer);
+    if (ret != APP_ERR_OK) {
+        LogWarn << "element(" << elementName_ << ") failed to merge some metadata of port(" << index << ").";
+    }
+    MxpiBufferManager::DestroyBuffer(childMxpiBuffer);
+    if (pendingFrame.arrivedNum < sinkPadNum_) {
+        return APP_ERR_OK;
+    }
+    pendingFrames_.erase(context->sequence);
+    MxpiBuffer* parentMxpiBuffer = TakeParent(*context);
+    // downstream may block, the other branches and the timeout thread are not held up meanwhile
+    lock.unlock();
+    ret = SendData(0, *parentMxpiBuffer);
+    LogDebug << "End to process MxpiJoin(" << elementName_ << ").";
+    return ret;
+}
+
+MxpiBuffer* MxpiJoin::TakeParent(MxpiForkContext& context)
+{
+    context.joined = true;
+    MxpiBuffer* parentMxpiBuffer = context.parent;
+    context.parent = nullptr;
+    return parentMxpiBuffer;
+}
+
+void MxpiJoin::TimeoutCall()
+{
+    if (useDevice_) {
+        DeviceContext deviceContext;
+        deviceContext.devId = deviceId_;
+        APP_ERROR ret = DeviceManager::GetInstance()->SetDevice(deviceContext);
+        if (ret != APP_ERR_OK) {
+            LogError << "Element(" << elementName_ << ") Failed to set deviceId." << GetErrorInfo(ret);
+        }
+    }
+    const auto timeout = std::chrono::milliseconds(timeout_);
+    const auto interval = std::chrono::milliseconds(timeout_ > 0 ? std::max(timeout_ / CHECK_FREQUENCY, 1u) :
+        ORPHAN_CHECK_INTERVAL);
+    std::unique_lock<std::mutex> lock(pendingMutex_);
+    while (runningFlag_) {
+        condition_.wait_for(lock, interval);
+        auto now = std::chrono::steady_clock::now();
+        std::vector<MxpiBuffer*> readyParents;
+        for (auto iter = pendingFrames_.begin(); iter != pendingFrames_.end() && runningFlag_;) {
+            MxpiForkContext& context = *iter->second.context;
+            // every child holds the context, when only the join does the missing branches dropped their buffers
+            bool orphaned = iter->second.context.use_count() == 1;
+            if (!orphaned && (timeout_ == 0 || now - iter->second.startTime < timeout)) {
+                iter++;
+                continue;
+            }
+            LogWarn << "element(" << elementName_ << ") " << (orphaned ? "lost the other branches of" :
+                "timed out waiting for") << " frame(" << context.frameId << ") channel(" << context.channelId
+                << "), only " << iter->second.arrivedNum << " of " << sinkPadNum_ << " branches are joined.";
+            readyParents.push_back(TakeParent(context));
+            iter = pendingFrames_.erase(iter);
+        }
+        if (readyParents.empty()) {
+            continue;
+        }
+        lock.unlock();
+        for (auto parentMxpiBuffer : readyParents) {
+            SendData(0, *parentMxpiBuffer);
+        }
+        lock.lock();
+    }
+}
+
+std::vector<std::shared_ptr<void>> MxpiJoin::DefineProperties()
+{
+    std::vector<std::shared_ptr<void>> properties;
+    auto forkName = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+        STRING, "dataSourceFork", "fork", "the name of the mxpi_fork element whose branches are joined", "", "", ""
+    });
+    auto timeout = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+        UINT, "timeout", "timeout",
+        "time to wait for all branches of a frame, 0 waits until each branch sends or drops it, unit:ms",
+        DEFAULT_TIMEOUT, 0, UINT32_MAX
+    });
+    properties = { forkName, timeout };
+    return properties;
+}
+
+MxpiPortInfo MxpiJoin::DefineInputPorts()
+{
+    MxpiPortInfo inputPortInfo;
+    std::vector<std::vector<std::string>> value = {{"ANY"}};
+    GenerateDynamicInputPortsInfo(value, inputPortInfo);
+    return inputPortInfo;
+}
+
+MxpiPortInfo MxpiJoin::DefineOutputPorts()
+{
+    MxpiPortInfo outputPortInfo;
+    std::vector<std::vector<std::string>> value = {{"ANY"}};
+    GenerateStaticOutputPortsInfo(value, outputPortInfo);
+    return outputPortInfo;
+}
+
+namespace {
+    MX_PLUGIN_GENERATE(MxpiJoin)
+}
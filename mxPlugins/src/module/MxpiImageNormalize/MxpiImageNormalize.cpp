@@ -22,6 +22,7 @@
 
 #include "MxPlugins/MxpiImageNormalize/MxpiImageNormalize.h"
 #include "MxBase/Log/Log.h"
+#include "MxBase/CV/Preprocess/ImageNormalizer.h"
 #include "MxBase/GlobalManager/GlobalManager.h"
 #include "MxPlugins/MxpiPluginsUtils/MxpiPluginsUtils.h"
 #include "MxBase/Utils/FileUtils.h"
@@ -36,6 +37,7 @@ namespace {
 const char SPLIT_RULE = ',';
 const size_t ALPHA_AND_BETA_SIZE = 3;
 const int R_INDEX = 0;
+const int G_INDEX = 1;
 const int B_INDEX = 2;
 const int AUTO = -1;
 const double DOUBLE_PRECISION_DEVIATION = 1e-15;
@@ -253,7 +255,8 @@ APP_ERROR MxpiImageNormalize::CheckInput(const MxTools::MxpiVision &vision)
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiImageNormalize::Mat2MxpiVision(size_t idx, const cv::Mat &mat, MxTools::MxpiVision &vision)
+APP_ERROR MxpiImageNormalize::SetVisionInfo(size_t idx, uint32_t width, uint32_t height,
+    MxTools::MxpiVision &vision)
 {
     auto header = vision.add_headervec();
     if (CheckPtrIsNullptr(header, "header"))  return APP_ERR_COMM_ALLOC_MEM;
@@ -261,15 +264,24 @@ APP_ERROR MxpiImageNormalize::Mat2MxpiVision(size_t idx, const cv::Mat &mat, MxT
     header->set_datasource(dataSource_);
     auto visionInfo = vision.mutable_visioninfo();
     visionInfo->set_format(outputPixelFormat_);
-    visionInfo->set_width(mat.cols);
-    visionInfo->set_height(mat.rows);
-    visionInfo->set_widthaligned(mat.cols);
-    visionInfo->set_heightaligned(mat.rows);
+    visionInfo->set_width(width);
+    visionInfo->set_height(height);
+    visionInfo->set_widthaligned(width);
+    visionInfo->set_heightaligned(height);
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiImageNormalize::Mat2MxpiVision(size_t idx, const cv::Mat &mat, MxTools::MxpiVision &vision)
+{
+    APP_ERROR ret = SetVisionInfo(idx, mat.cols, mat.rows, vision);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
     auto visionData = vision.mutable_visiondata();
     visionData->set_datasize(mat.cols * mat.rows * mat.elemSize());
     MemoryData memoryDataDst(visionData->datasize(), MemoryData::MEMORY_HOST_MALLOC, deviceId_);
     MemoryData memoryDataSrc(mat.data, visionData->datasize(), MemoryData::MEMORY_HOST_MALLOC);
-    APP_ERROR ret = MemoryHelper::MxbsMallocAndCopy(memoryDataDst, memoryDataSrc);
+    ret = MemoryHelper::MxbsMallocAndCopy(memoryDataDst, memoryDataSrc);
     if (ret != APP_ERR_OK) {
         errorInfo_ << "Copy data from host to host failed." << GetErrorInfo(ret);
         LogError << errorInfo_.str();
@@ -282,16 +294,6 @@ APP_ERROR MxpiImageNormalize::Mat2MxpiVision(size_t idx, const cv::Mat &mat, MxT
     return APP_ERR_OK;
 }
 
-void MxpiImageNormalize::SwitchAlphaAndBeta(const MxTools::MxpiVision &srcVision)
-{
-    if (srcVision.visioninfo().format() == MxBase::MxbasePixelFormat::MXBASE_PIXEL_FORMAT_BGR_888) {
-        // convert mean from rgb to bgr
-        std::swap(alpha_[R_INDEX], alpha_[B_INDEX]);
-        // convert std from rgb to bgr
-        std::swap(beta_[R_INDEX], beta_[B_INDEX]);
-    }
-}
-
 APP_ERROR MxpiImageNormalize::ConvertType(const MxpiDataType &dataType)
 {
     auto iter = OPENCV_C3_INPUT_DATA_TYPE_MAP.find(dataType);
@@ -321,18 +323,9 @@ APP_ERROR MxpiImageNormalize::DoNormalize(cv::Mat &dst, MxTools::MxpiVision &src
     // init src
     cv::Mat src(srcVision.visioninfo().height(), srcVision.visioninfo().width(), inputType_,
         (void *)srcVision.visiondata().dataptr());
-    // base on process type select image process function
-    std::string processTypeName;
-    APP_ERROR ret;
-    if (processType_ == 1) {
-        processTypeName = "Normalize";
-        ret = Normalize(src, dst, alpha_, beta_, outputType_);
-    } else {
-        processTypeName = "MinMaxNormalize";
-        ret = MinMaxNormalize(src, dst, outputType_);
-    }
+    APP_ERROR ret = MinMaxNormalize(src, dst, outputType_);
     if (ret != APP_ERR_OK) {
-        LogError << "Failed to executed " << processTypeName << "." << GetErrorInfo(ret);
+        LogError << "Failed to executed MinMaxNormalize." << GetErrorInfo(ret);
         return ret;
     }
     // cvt color space
@@ -354,8 +347,6 @@ APP_ERROR MxpiImageNormalize::OpenCVNormalize(size_t idx, MxTools::MxpiVision &s
         LogError << errorInfo_.str();
         return ret;
     }
-    // switch alpha and beta if input format is BGR
-    SwitchAlphaAndBeta(srcVision);
     // convert input data type to opencv data type
     ret = ConvertType(srcVision.visiondata().datatype());
     if (ret != APP_ERR_OK) {
@@ -368,6 +359,10 @@ APP_ERROR MxpiImageNormalize::OpenCVNormalize(size_t idx, MxTools::MxpiVision &s
         outputType_ = iter->second;
         outputDataType_ = srcVision.visiondata().datatype();
     }
+    // standardization in one pass straight into the output buffer
+    if (processType_ == 1) {
+        return FusedNormalize(idx, srcVision, dstVision);
+    }
     // do normalization
     cv::Mat dst;
     ret = DoNormalize(dst, srcVision);
@@ -385,35 +380,72 @@ APP_ERROR MxpiImageNormalize::OpenCVNormalize(size_t idx, MxTools::MxpiVision &s
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiImageNormalize::Normalize(cv::Mat &src, cv::Mat &dst, const std::vector<double> &mean,
-    const std::vector<double> &std, int type)
+APP_ERROR MxpiImageNormalize::FusedNormalize(size_t idx, const MxTools::MxpiVision &srcVision,
+    MxTools::MxpiVision &dstVision)
 {
-    std::vector<cv::Mat> tmp;
-    // split channel
-    cv::split(src, tmp);
+    auto format = static_cast<MxBase::MxbasePixelFormat>(srcVision.visioninfo().format());
+    bool needConvert = IsNeedConvert(format);
     /*
-     * formula convert
-     * original convertTo function: x' = alpha * x + beta
-     * target function: x' = (x - mean) / std
-     * => alpha = 1 / std
-     * => beta = - mean / std
+     * x' = (x - mean) / std = x * (1 / std) - mean / std, alpha and beta are given in RGB order and the
+     * output channels are the input channels, swapped when the output format differs from the input one
      */
-    if (tmp.size() != ALPHA_AND_BETA_SIZE) {
-        LogError << "After split, channel size is " << tmp.size() << ", required channel size is "
-                 << ALPHA_AND_BETA_SIZE << "." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
-        return APP_ERR_COMM_INVALID_POINTER;
+    std::vector<double> mean = alpha_;
+    std::vector<double> std = beta_;
+    if (format == MxBase::MxbasePixelFormat::MXBASE_PIXEL_FORMAT_BGR_888) {
+        std::swap(mean[R_INDEX], mean[B_INDEX]);
+        std::swap(std[R_INDEX], std[B_INDEX]);
+    }
+    NormalizeParam param;
+    if (needConvert) {
+        LogDebug << "element(" << elementName_ << ") input and output format are different, convert color.";
+        param.channelOrder = { B_INDEX, G_INDEX, R_INDEX };
+        std::swap(mean[R_INDEX], mean[B_INDEX]);
+        std::swap(std[R_INDEX], std[B_INDEX]);
     }
-    // subtract mean and divide std
-    for (size_t i = 0; i < ALPHA_AND_BETA_SIZE; i++) {
-        if (IsDenominatorZero(std[i])) {
-            LogError << "The value of std[i]: " << std[i] << "must not equal to zero!"
-                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-            return APP_ERR_COMM_INVALID_PARAM;
-        }
-        tmp[i].convertTo(tmp[i], type, 1 / std[i], -mean[i] / std[i]);
+    APP_ERROR ret = ImageNormalizer::MeanStdToScaleBias(mean, std, param.scale, param.bias);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Invalid alpha or beta." << GetErrorInfo(ret);
+        return ret;
+    }
+    param.layout = TYPE_NHWC;
+    param.dataType = outputType_ == CV_8U ? TENSOR_DTYPE_UINT8 : TENSOR_DTYPE_FLOAT32;
+    NormalizeImage src;
+    src.data = reinterpret_cast<const void *>(srcVision.visiondata().dataptr());
+    src.dataType = inputType_ == CV_8UC3 ? TENSOR_DTYPE_UINT8 : TENSOR_DTYPE_FLOAT32;
+    src.width = srcVision.visioninfo().width();
+    src.height = srcVision.visioninfo().height();
+    src.channelNum = ALPHA_AND_BETA_SIZE;
+    size_t srcSize = static_cast<size_t>(src.width) * src.height * src.channelNum *
+        (src.dataType == TENSOR_DTYPE_UINT8 ? sizeof(uint8_t) : sizeof(float));
+    if (srcSize == 0 || srcVision.visiondata().datasize() < srcSize) {
+        errorInfo_ << "Input data size(" << srcVision.visiondata().datasize() << ") is smaller than the image size("
+                   << srcSize << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+
+    MemoryData memoryDataDst(ImageNormalizer::GetOutputSize(src, param), MemoryData::MEMORY_HOST_MALLOC, deviceId_);
+    ret = MemoryHelper::MxbsMalloc(memoryDataDst);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Failed to malloc the output memory." << GetErrorInfo(ret);
+        return ret;
     }
-    // merge channel
-    cv::merge(tmp, dst);
+    ret = ImageNormalizer::Normalize(src, param, memoryDataDst.ptrData, memoryDataDst.size);
+    if (ret != APP_ERR_OK) {
+        MemoryHelper::MxbsFree(memoryDataDst);
+        errorInfo_ << "Failed to normalize the image." << GetErrorInfo(ret);
+        return ret;
+    }
+    ret = SetVisionInfo(idx, src.width, src.height, dstVision);
+    if (ret != APP_ERR_OK) {
+        MemoryHelper::MxbsFree(memoryDataDst);
+        return ret;
+    }
+    auto visionData = dstVision.mutable_visiondata();
+    visionData->set_datasize(memoryDataDst.size);
+    visionData->set_dataptr((uint64)memoryDataDst.ptrData);
+    visionData->set_deviceid(deviceId_);
+    visionData->set_memtype(MxTools::MXPI_MEMORY_HOST_MALLOC);
+    visionData->set_datatype(outputDataType_);
     return APP_ERR_OK;
 }
 
@@ -46,10 +46,10 @@ const int OUTPUT_MAX_HEIGHT = 4096;
 const float SCALE_PADDING = 0.5;
 const int BILINEAR_OPENCV = 1;
 const int NEAREST_NEIGHBOR_TF = 4;
-const float AVERAGE = 2.f;
 const int RGB_MEMORY_EXTEND = 2;
 const int DVPP_ALIGN_LEFT = 16;
 const int DVPP_ALIGN_TOP = 2;
+const uint32_t UV_ROW_RATIO = 2;
 } // namespace
 
 APP_ERROR MxpiImageResize::InitConfig(std::map<std::string, std::shared_ptr<void>>& configParamMap)
@@ -262,95 +262,114 @@ APP_ERROR MxpiImageResize::DvppResize(MxpiVisionInfo& dstMxpiVisionInfo, MxpiVis
     return APP_ERR_OK;
 }
 
-float MxpiImageResize::OpencvRescaleProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB, uint32_t resizeDstWidth,
-    uint32_t resizeDstHeight)
+float MxpiImageResize::OpencvRescaleProcess(uint32_t srcWidth, uint32_t srcHeight, uint32_t resizeDstWidth,
+    uint32_t resizeDstHeight, uint32_t& width, uint32_t& height)
 {
     int maxLongEdge = max(resizeDstWidth, resizeDstHeight);
     int maxShortEdge = min(resizeDstWidth, resizeDstHeight);
-    if (IsDenominatorZero(imageRGB.cols) || IsDenominatorZero(imageRGB.rows)) {
-        LogError << "ImageRGB.cols: " << imageRGB.cols << ", imageRGB.rows: " << imageRGB.rows
+    if (IsDenominatorZero(srcWidth) || IsDenominatorZero(srcHeight)) {
+        LogError << "Source width: " << srcWidth << ", source height: " << srcHeight
                  << "must not equal to zero!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return 0.f;
     }
-    float scaleFactor = min((float)maxLongEdge / max(imageRGB.cols, imageRGB.rows),
-                            (float)maxShortEdge / min(imageRGB.cols, imageRGB.rows));
-    int newSizeWidth = int(imageRGB.cols * scaleFactor + SCALE_PADDING);
-    int newSizeHeight = int(imageRGB.rows * scaleFactor + SCALE_PADDING);
-    cv::resize(imageRGB, resizeRGB, cv::Size(newSizeWidth, newSizeHeight));
+    float scaleFactor = min((float)maxLongEdge / max(srcWidth, srcHeight),
+                            (float)maxShortEdge / min(srcWidth, srcHeight));
+    width = static_cast<uint32_t>(srcWidth * scaleFactor + SCALE_PADDING);
+    height = static_cast<uint32_t>(srcHeight * scaleFactor + SCALE_PADDING);
     keepAspectRatioScaling_ = scaleFactor;
-    LogInfo << "src img height: " << imageRGB.rows << ", width: " << imageRGB.cols;
-    LogInfo << "rescale img height: " << resizeRGB.rows << ", width: " << resizeRGB.cols;
+    LogInfo << "src img height: " << srcHeight << ", width: " << srcWidth;
+    LogInfo << "rescale img height: " << height << ", width: " << width;
     return scaleFactor;
 }
 
-void MxpiImageResize::OpencvRescaleDoubleProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB, uint32_t resizeDstWidth,
-    uint32_t resizeDstHeight)
+APP_ERROR MxpiImageResize::OpencvRescaleDoubleProcess(LetterboxImage& image, std::vector<uint8_t>& rescaled,
+    uint32_t& width, uint32_t& height)
 {
-    cv::Mat tmpRGB;
-    float scaleFactor1 = OpencvRescaleProcess(tmpRGB, imageRGB, resizeDstWidth, resizeDstHeight);
-    float scaleFactor2 = 1.0f;
-    if (resizeConfig_.width > resizeConfig_.height && (uint32_t)tmpRGB.rows > resizeConfig_.height) {
-        scaleFactor2 = OpencvRescaleProcess(resizeRGB, tmpRGB, resizeDstHeight, resizeDstHeight);
-    } else if (resizeConfig_.width < resizeConfig_.height && (uint32_t)tmpRGB.cols > resizeConfig_.width) {
-        scaleFactor2 = OpencvRescaleProcess(resizeRGB, tmpRGB, resizeDstWidth, resizeDstWidth);
-    } else {
-        resizeRGB = tmpRGB;
+    float scaleFactor1 = OpencvRescaleProcess(image.width, image.height, resizeConfig_.width, resizeConfig_.height,
+        width, height);
+    uint32_t side = 0;
+    if (resizeConfig_.width > resizeConfig_.height && height > resizeConfig_.height) {
+        side = resizeConfig_.height;
+    } else if (resizeConfig_.width < resizeConfig_.height && width > resizeConfig_.width) {
+        side = resizeConfig_.width;
+    }
+    if (side == 0) {
+        keepAspectRatioScaling_ = scaleFactor1;
+        return APP_ERR_OK;
+    }
+    // the first rescale is the source of the second one, the output only receives the second
+    LetterboxParam param;
+    APP_ERROR ret = LetterboxResizer::MakeGeometry(width, height, 0, 0, LetterboxPadding::NONE, param.geometry);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    rescaled.resize(LetterboxResizer::GetOutputSize(image.dataType, param.geometry));
+    ret = LetterboxResizer::Resize(image, param, rescaled.data(), rescaled.size());
+    if (ret != APP_ERR_OK) {
+        return ret;
     }
+    image.data = rescaled.data();
+    image.uvData = nullptr;
+    image.format = LetterboxSourceFormat::PACKED_3;
+    image.width = width;
+    image.height = height;
+    image.rowStride = 0;
+    float scaleFactor2 = OpencvRescaleProcess(image.width, image.height, side, side, width, height);
     keepAspectRatioScaling_ = scaleFactor1 * scaleFactor2;
+    return APP_ERR_OK;
 }
 
-void MxpiImageResize::OpencvYolov4Process(cv::Mat& resizeRGB, cv::Mat& imageRGB)
+void MxpiImageResize::OpencvYolov4Process(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height,
+    int& interpolation)
 {
-    if (static_cast<uint32_t>(imageRGB.rows) > resizeConfig_.height &&
-        static_cast<uint32_t>(imageRGB.cols) > resizeConfig_.width) {
-        cv::resize(imageRGB, resizeRGB, cv::Size(resizeConfig_.width, resizeConfig_.height), 0, 0, cv::INTER_NEAREST);
-    } else if (static_cast<uint32_t>(imageRGB.rows) < resizeConfig_.height &&
-        static_cast<uint32_t>(imageRGB.cols) < resizeConfig_.width) {
-        cv::resize(imageRGB, resizeRGB, cv::Size(resizeConfig_.width, resizeConfig_.height), 0, 0, cv::INTER_CUBIC);
+    if (srcHeight > resizeConfig_.height && srcWidth > resizeConfig_.width) {
+        interpolation = cv::INTER_NEAREST;
+    } else if (srcHeight < resizeConfig_.height && srcWidth < resizeConfig_.width) {
+        interpolation = cv::INTER_CUBIC;
     } else {
-        cv::resize(imageRGB, resizeRGB, cv::Size(resizeConfig_.width, resizeConfig_.height), 0, 0, cv::INTER_LINEAR);
+        interpolation = cv::INTER_LINEAR;
     }
+    width = resizeConfig_.width;
+    height = resizeConfig_.height;
 }
 
-void MxpiImageResize::OpencvPaddleOCR(cv::Mat& resizeRGB, cv::Mat& imageRGB)
+void MxpiImageResize::OpencvPaddleOCR(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width, uint32_t& height)
 {
-    if (IsDenominatorZero(imageRGB.rows)) {
-        LogError << "The value of imageRGB.rows: " << imageRGB.rows << "must not equal to zero!"
+    if (IsDenominatorZero(srcHeight)) {
+        LogError << "The value of source height: " << srcHeight << "must not equal to zero!"
                  << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return;
     }
-    float ratio = static_cast<float>(imageRGB.cols) / imageRGB.rows;
+    float ratio = static_cast<float>(srcWidth) / srcHeight;
+    height = resizeConfig_.height;
     if (std::ceil(resizeConfig_.height * ratio) > resizeConfig_.width) {
-        cv::resize(imageRGB, resizeRGB, cv::Size(resizeConfig_.width, resizeConfig_.height));
+        width = resizeConfig_.width;
         keepAspectRatioScaling_ = 0.f;
     } else {
-        cv::resize(imageRGB, resizeRGB,
-            cv::Size(static_cast<uint32_t>(std::ceil(resizeConfig_.height * ratio)), resizeConfig_.height));
-        keepAspectRatioScaling_ = static_cast<float>(resizeHeight_) / imageRGB.rows;
+        width = static_cast<uint32_t>(std::ceil(resizeConfig_.height * ratio));
+        keepAspectRatioScaling_ = static_cast<float>(resizeHeight_) / srcHeight;
     }
     paddingWidth_ = resizeConfig_.width;
     paddingHeight_ = resizeConfig_.height;
 }
 
-void MxpiImageResize::OpencvKeepAspectRatioFit(cv::Mat& resizeRGB, const cv::Mat& imageRGB)
+void MxpiImageResize::OpencvKeepAspectRatioFit(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width,
+    uint32_t& height)
 {
-    uint32_t width = 0;
-    uint32_t height = 0;
-    if (IsDenominatorZero(imageRGB.cols) || IsDenominatorZero(imageRGB.rows)) {
-        LogError << "ImageRGB.cols: " << imageRGB.cols << ", imageRGB.rows: " << imageRGB.rows
+    if (IsDenominatorZero(srcWidth) || IsDenominatorZero(srcHeight)) {
+        LogError << "Source width: " << srcWidth << ", source height: " << srcHeight
                  << "must not equal to zero!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return;
     }
-    if (resizeHeight_ * imageRGB.cols > imageRGB.rows * resizeWidth_) {
+    if (resizeHeight_ * srcWidth > srcHeight * resizeWidth_) {
         width = resizeWidth_;
-        height = static_cast<uint32_t>(std::lround(imageRGB.rows * resizeWidth_ * 1.0 / imageRGB.cols));
-        keepAspectRatioScaling_ = static_cast<float>(resizeWidth_) / imageRGB.cols;
+        height = static_cast<uint32_t>(std::lround(srcHeight * resizeWidth_ * 1.0 / srcWidth));
+        keepAspectRatioScaling_ = static_cast<float>(resizeWidth_) / srcWidth;
     } else {
-        width = static_cast<uint32_t>(std::lround(imageRGB.cols * resizeHeight_ * 1.0 / imageRGB.rows));
+        width = static_cast<uint32_t>(std::lround(srcWidth * resizeHeight_ * 1.0 / srcHeight));
         height = resizeHeight_;
-        keepAspectRatioScaling_ = static_cast<float>(resizeHeight_) / imageRGB.rows;
+        keepAspectRatioScaling_ = static_cast<float>(resizeHeight_) / srcHeight;
     }
-    cv::resize(imageRGB, resizeRGB, cv::Size(width, height));
     paddingWidth_ = resizeWidth_;
     paddingHeight_ = resizeHeight_;
 }
@@ -386,99 +405,75 @@ void MxpiImageResize::CalcFastRcnnHW(const uint32_t inputWidth, const uint32_t i
     }
 }
 
-void MxpiImageResize::OpencvKeepAspectRatioFastRcnn(cv::Mat& resizeRGB, const cv::Mat& imageRGB)
+void MxpiImageResize::OpencvKeepAspectRatioFastRcnn(uint32_t srcWidth, uint32_t srcHeight, uint32_t& width,
+    uint32_t& height)
 {
-    uint32_t width = 0;
-    uint32_t height = 0;
-    CalcFastRcnnHW(imageRGB.cols, imageRGB.rows, width, height);
-    cv::resize(imageRGB, resizeRGB, cv::Size(width, height));
+    CalcFastRcnnHW(srcWidth, srcHeight, width, height);
     paddingWidth_ = maxDimension_;
     paddingHeight_ = maxDimension_;
 }
 
-void MxpiImageResize::OpencvResizeProcess(cv::Mat& resizeRGB, cv::Mat& imageRGB, MxpiVisionInfo &srcMxpiVisionInfo)
+APP_ERROR MxpiImageResize::OpencvResizeProcess(LetterboxImage& image, std::vector<uint8_t>& rescaled,
+    uint32_t& width, uint32_t& height, int& interpolation)
 {
-    uint32_t resizeDstWidth = resizeConfig_.width;
-    uint32_t resizeDstHeight = resizeConfig_.height;
-    bool flagValue = IsDenominatorZero(srcMxpiVisionInfo.width()) || IsDenominatorZero(srcMxpiVisionInfo.height());
-    if (flagValue) {
-        LogError << "SrcMxpiVisionInfo.width(): " << srcMxpiVisionInfo.width() << ", srcMxpiVisionInfo.height(): "
-                 << srcMxpiVisionInfo.height() << "must not equal to zero!"
-                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-        return;
-    }
+    width = image.width;
+    height = image.height;
+    interpolation = cv::INTER_LINEAR;
     if (resizeType_ == RESIZETYPE["Resizer_Stretch"]) {
-        cv::resize(imageRGB, resizeRGB, cv::Size(resizeConfig_.width, resizeConfig_.height)); //  default INTER_LINEAR
+        width = resizeConfig_.width;
+        height = resizeConfig_.height;
     } else if (resizeType_ == RESIZETYPE["Resizer_KeepAspectRatio_Short"]) {
-        float scale = static_cast<float>(scaleValue_) / min(srcMxpiVisionInfo.width(), srcMxpiVisionInfo.height());
-        int dstWidth = static_cast<int>(srcMxpiVisionInfo.width() * scale);
-        int dstHeight = static_cast<int>(srcMxpiVisionInfo.height() * scale);
-        cv::resize(imageRGB, resizeRGB, cv::Size(dstWidth, dstHeight));
+        float scale = static_cast<float>(scaleValue_) / min(image.width, image.height);
+        width = static_cast<uint32_t>(image.width * scale);
+        height = static_cast<uint32_t>(image.height * scale);
     } else if (resizeType_ == RESIZETYPE["Resizer_KeepAspectRatio_Long"]) {
-        float scale = static_cast<float>(scaleValue_) / max(srcMxpiVisionInfo.width(), srcMxpiVisionInfo.height());
-        int dstWidth = static_cast<int>(srcMxpiVisionInfo.width() * scale);
-        int dstHeight = static_cast<int>(srcMxpiVisionInfo.height() * scale);
-        cv::resize(imageRGB, resizeRGB, cv::Size(dstWidth, dstHeight));
+        float scale = static_cast<float>(scaleValue_) / max(image.width, image.height);
+        width = static_cast<uint32_t>(image.width * scale);
+        height = static_cast<uint32_t>(image.height * scale);
     } else if (resizeType_ == RESIZETYPE["Resizer_Rescale"]) {
-        OpencvRescaleProcess(resizeRGB, imageRGB, resizeDstWidth, resizeDstHeight);
+        OpencvRescaleProcess(image.width, image.height, resizeConfig_.width, resizeConfig_.height, width, height);
     } else if (resizeType_ == RESIZETYPE["Resizer_Rescale_Double"]) {
-        OpencvRescaleDoubleProcess(resizeRGB, imageRGB, resizeDstWidth, resizeDstHeight);
+        return OpencvRescaleDoubleProcess(image, rescaled, width, height);
     } else if (resizeType_ == RESIZETYPE["Resizer_MS_Yolov4"]) {
-        OpencvYolov4Process(resizeRGB, imageRGB);
+        OpencvYolov4Process(image.width, image.height, width, height, interpolation);
     } else if (resizeType_ == RESIZETYPE["Resizer_PaddleOCR"]) {
-        OpencvPaddleOCR(resizeRGB, imageRGB);
+        OpencvPaddleOCR(image.width, image.height, width, height);
     } else if (resizeType_ == RESIZETYPE["Resizer_KeepAspectRatio_FastRCNN"]) {
-        OpencvKeepAspectRatioFastRcnn(resizeRGB, imageRGB);
+        OpencvKeepAspectRatioFastRcnn(image.width, image.height, width, height);
     } else if (resizeType_ == RESIZETYPE["Resizer_KeepAspectRatio_Fit"]) {
-        OpencvKeepAspectRatioFit(resizeRGB, imageRGB);
-    } else {
-        resizeRGB = imageRGB;
+        OpencvKeepAspectRatioFit(image.width, image.height, width, height);
     }
+    return APP_ERR_OK;
 }
 
-void MxpiImageResize::GetScalarValue(MxpiVisionInfo &srcMxpiVisionInfo, cv::Scalar& value)
+void MxpiImageResize::GetPaddingValue(uint32_t format, float padValue[])
 {
-    if (srcMxpiVisionInfo.format() == MXBASE_PIXEL_FORMAT_BGR_888) {
-        cv::Scalar value1(paddingColorB_, paddingColorG_, paddingColorR_);
-        value = value1;
-    } else if (srcMxpiVisionInfo.format() == MXBASE_PIXEL_FORMAT_RGB_888) {
-        cv::Scalar value2(paddingColorR_, paddingColorG_, paddingColorB_);
-        value = value2;
+    if (format == MXBASE_PIXEL_FORMAT_BGR_888) {
+        padValue[0] = paddingColorB_;
+        padValue[1] = paddingColorG_;
+        padValue[2] = paddingColorR_;
+    } else if (format == MXBASE_PIXEL_FORMAT_RGB_888) {
+        padValue[0] = paddingColorR_;
+        padValue[1] = paddingColorG_;
+        padValue[2] = paddingColorB_;
     }
 }
 
-APP_ERROR MxpiImageResize::OpencvPaddingProcess(cv::Mat& imageRGB, MxpiVisionInfo &srcMxpiVisionInfo)
+APP_ERROR MxpiImageResize::OpencvPaddingProcess(uint32_t width, uint32_t height, LetterboxGeometry& geometry)
 {
-    if (paddingType_ == PADDINGTYPE["Padding_NO"]) {
-        return APP_ERR_OK;
+    LetterboxPadding padding = LetterboxPadding::NONE;
+    if (paddingType_ == PADDINGTYPE["Padding_RightDown"]) {
+        padding = LetterboxPadding::RIGHT_DOWN;
+    } else if (paddingType_ == PADDINGTYPE["Padding_Around"]) {
+        padding = LetterboxPadding::AROUND;
     }
-    if ((uint32_t)imageRGB.cols > paddingWidth_ || (uint32_t)imageRGB.rows > paddingHeight_) {
+    if (padding != LetterboxPadding::NONE && (width > paddingWidth_ || height > paddingHeight_)) {
         LogError << "Image cols or rows is bigger than padding size, paddingWidth_=" << paddingWidth_
-                 << " paddingHeight_=" << paddingHeight_ << " imageRGB.cols is " << imageRGB.cols
-                 << " imageRGB.rows is " << imageRGB.rows << "." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+                 << " paddingHeight_=" << paddingHeight_ << " image cols is " << width
+                 << " image rows is " << height << "." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    if (paddingType_ == PADDINGTYPE["Padding_RightDown"]) {
-        int padH = static_cast<int>(paddingHeight_) - imageRGB.rows;
-        int padW = static_cast<int>(paddingWidth_) - imageRGB.cols;
-        if (padH > 0 || padW > 0) {
-            cv::Scalar value;
-            GetScalarValue(srcMxpiVisionInfo, value);
-            cv::copyMakeBorder(imageRGB, imageRGB, 0, padH, 0, padW, cv::BORDER_CONSTANT, value);
-        }
-    } else if (paddingType_ == PADDINGTYPE["Padding_Around"]) {
-        int padTop = static_cast<int>((static_cast<int32_t>(paddingHeight_) - imageRGB.rows) / AVERAGE);
-        int padLeft = static_cast<int>((static_cast<int32_t>(paddingWidth_) - imageRGB.cols) / AVERAGE);
-        int padBottom = static_cast<int>(paddingHeight_) - imageRGB.rows - padTop;
-        int padRight = static_cast<int>(paddingWidth_) - imageRGB.cols - padLeft;
-        if (padTop >= 0 || padLeft >= 0) {
-            cv::Scalar value;
-            GetScalarValue(srcMxpiVisionInfo, value);
-            cv::copyMakeBorder(imageRGB, imageRGB, padTop, padBottom, padLeft, padRight,
-                cv::BORDER_CONSTANT, value);
-        }
-    }
-    return APP_ERR_OK;
+    return LetterboxResizer::MakeGeometry(width, height, paddingWidth_, paddingHeight_, padding, geometry);
 }
 
 bool MxpiImageResize::CheckOpencvResizeMode()
@@ -523,46 +518,98 @@ APP_ERROR MxpiImageResize::CheckOpencvParam(MxpiVisionInfo &srcMxpiVisionInfo,
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiImageResize::SetOutputData(MxpiVisionInfo &dstMxpiVisionInfo, MxpiVisionData &dstMxpiVisionData,
-    MxpiVisionInfo &srcMxpiVisionInfo, MxpiVisionData &srcMxpiVisionData, cv::Mat& resizeRGB)
+APP_ERROR MxpiImageResize::GetLetterboxImage(MxpiVisionInfo &srcMxpiVisionInfo, MxpiVisionData &srcMxpiVisionData,
+    LetterboxImage& image, uint32_t& format)
 {
-    DvppDataInfo outputDataInfo;
-    outputDataInfo.widthStride = static_cast<uint32_t>(resizeRGB.cols);
-    outputDataInfo.heightStride = static_cast<uint32_t>(resizeRGB.rows);
-    outputDataInfo.width = static_cast<uint32_t>(resizeRGB.cols);
-    outputDataInfo.height = static_cast<uint32_t>(resizeRGB.rows);
     if (srcMxpiVisionData.datatype() == MxTools::MXPI_DATA_TYPE_UINT8) {
-        outputDataInfo.dataSize = static_cast<uint32_t>(resizeRGB.cols) * static_cast<uint32_t>(resizeRGB.rows) *
-            YUV444_RGB_WIDTH_NU;
+        image.dataType = TENSOR_DTYPE_UINT8;
     } else if (srcMxpiVisionData.datatype() == MxTools::MXPI_DATA_TYPE_FLOAT32) {
-        outputDataInfo.dataSize = static_cast<uint32_t>(resizeRGB.cols) * static_cast<uint32_t>(resizeRGB.rows) *
-            YUV444_RGB_WIDTH_NU * sizeof(float);
+        image.dataType = TENSOR_DTYPE_FLOAT32;
+    } else {
+        errorInfo_ << "SrcMxpiVisionData datatype error, vaule:" <<  srcMxpiVisionData.datatype() << "."
+                   << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        LogError << errorInfo_.str();
+        return APP_ERR_COMM_INVALID_PARAM;
     }
-    MemoryData memoryDataDst(outputDataInfo.dataSize, MemoryData::MEMORY_HOST_MALLOC, deviceId_);
-    MemoryData memoryDataSrc(resizeRGB.data, outputDataInfo.dataSize, MemoryData::MEMORY_HOST_MALLOC);
-    APP_ERROR ret = MemoryHelper::MxbsMallocAndCopy(memoryDataDst, memoryDataSrc);
-    if (ret != APP_ERR_OK) {
-        errorInfo_ << "Memory malloc failed." << GetErrorInfo(ret);
+    image.data = reinterpret_cast<const void *>(srcMxpiVisionData.dataptr());
+    image.width = srcMxpiVisionInfo.width();
+    image.height = srcMxpiVisionInfo.height();
+    format = srcMxpiVisionInfo.format();
+    size_t srcSize = static_cast<size_t>(image.width) * image.height * YUV444_RGB_WIDTH_NU *
+        (image.dataType == TENSOR_DTYPE_UINT8 ? sizeof(uint8_t) : sizeof(float));
+    if (format == MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420 || format == MXBASE_PIXEL_FORMAT_YVU_SEMIPLANAR_420) {
+        // the conversion to RGB is done while the rows are sampled
+        image.format = format == MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420 ? LetterboxSourceFormat::NV12 :
+            LetterboxSourceFormat::NV21;
+        image.rowStride = max(srcMxpiVisionInfo.widthaligned(), image.width);
+        size_t lumaSize = static_cast<size_t>(image.rowStride) * max(srcMxpiVisionInfo.heightaligned(), image.height);
+        image.uvData = static_cast<const uint8_t *>(image.data) + lumaSize;
+        srcSize = lumaSize + static_cast<size_t>(image.rowStride) * ((image.height + 1) / UV_ROW_RATIO);
+        format = MXBASE_PIXEL_FORMAT_RGB_888;
+    }
+    if (static_cast<size_t>(srcMxpiVisionData.datasize()) < srcSize) {
+        errorInfo_ << "Input data size(" << srcMxpiVisionData.datasize() << ") is smaller than the image size("
+                   << srcSize << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         LogError << errorInfo_.str();
-        return ret;
+        return APP_ERR_COMM_INVALID_PARAM;
     }
-    dstMxpiVisionData.set_dataptr((uint64_t)memoryDataDst.ptrData);
-    dstMxpiVisionData.set_datasize((int32_t)outputDataInfo.dataSize);
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiImageResize::LetterboxResize(const LetterboxImage& image, LetterboxParam& param, int interpolation,
+    MemoryData& data)
+{
+    if (interpolation == cv::INTER_NEAREST) {
+        param.interpolation = LetterboxInterpolation::NEAREST;
+    } else if (interpolation == cv::INTER_AREA) {
+        param.interpolation = LetterboxInterpolation::AREA;
+    }
+    if (interpolation != cv::INTER_CUBIC) {
+        return LetterboxResizer::Resize(image, param, data.ptrData, data.size);
+    }
+    // bicubic upscaling has no fixed-point kernel, cv::resize writes into the resized area of the output
+    int type = image.dataType == TENSOR_DTYPE_FLOAT32 ? CV_32FC3 : CV_8UC3;
+    cv::Mat source;
+    if (image.format == LetterboxSourceFormat::PACKED_3) {
+        source = cv::Mat(image.height, image.width, type, const_cast<void *>(image.data), image.rowStride);
+    } else {
+        cv::Mat luma(image.height, image.width, CV_8UC1, const_cast<void *>(image.data), image.rowStride);
+        cv::Mat chroma(image.height / UV_ROW_RATIO, image.width / UV_ROW_RATIO, CV_8UC2,
+            const_cast<uint8_t *>(image.uvData), image.rowStride);
+        cv::cvtColorTwoPlane(luma, chroma, source, image.format == LetterboxSourceFormat::NV12 ?
+            cv::COLOR_YUV2RGB_NV12 : cv::COLOR_YUV2RGB_NV21);
+    }
+    const LetterboxGeometry& geometry = param.geometry;
+    size_t pixelSize = data.size / (static_cast<size_t>(geometry.width) * geometry.height);
+    size_t rowStep = pixelSize * geometry.width;
+    cv::Mat resized(geometry.resizeHeight, geometry.resizeWidth, type,
+        static_cast<uint8_t *>(data.ptrData) + geometry.top * rowStep + geometry.left * pixelSize, rowStep);
+    cv::resize(source, resized, resized.size(), 0, 0, cv::INTER_CUBIC);
+    return LetterboxResizer::FillBorder(param, image.dataType, data.ptrData, data.size);
+}
+
+void MxpiImageResize::SetOutputData(MxpiVisionInfo &dstMxpiVisionInfo, MxpiVisionData &dstMxpiVisionData,
+    MxpiVisionData &srcMxpiVisionData, const MemoryData& data, const LetterboxGeometry& geometry, uint32_t format)
+{
+    dstMxpiVisionData.set_dataptr((uint64_t)data.ptrData);
+    dstMxpiVisionData.set_datasize((int32_t)data.size);
     dstMxpiVisionData.set_deviceid(deviceId_);
     dstMxpiVisionData.set_memtype(MXPI_MEMORY_HOST_MALLOC);
     dstMxpiVisionData.set_freefunc(srcMxpiVisionData.freefunc());
     dstMxpiVisionData.set_datatype(srcMxpiVisionData.datatype());
-    dstMxpiVisionInfo.set_format(srcMxpiVisionInfo.format());
-    dstMxpiVisionInfo.set_width(outputDataInfo.width);
-    dstMxpiVisionInfo.set_height(outputDataInfo.height);
-    dstMxpiVisionInfo.set_widthaligned(outputDataInfo.widthStride);
-    dstMxpiVisionInfo.set_heightaligned(outputDataInfo.heightStride);
+    dstMxpiVisionInfo.set_format(format);
+    dstMxpiVisionInfo.set_width(geometry.width);
+    dstMxpiVisionInfo.set_height(geometry.height);
+    dstMxpiVisionInfo.set_widthaligned(geometry.width);
+    dstMxpiVisionInfo.set_heightaligned(geometry.height);
     dstMxpiVisionInfo.set_keepaspectratioscaling(keepAspectRatioScaling_);
     dstMxpiVisionInfo.set_resizetype(resizeType_);
-    return APP_ERR_OK;
 }
 
-
+/**
+ * The resize size and the padding are computed first, then the source is resampled into the resized area of the
+ * output and only the padding around it is filled, so every output pixel is written once.
+ */
 APP_ERROR MxpiImageResize::OpencvResize(MxpiVisionInfo &dstMxpiVisionInfo, MxpiVisionData &dstMxpiVisionData,
     MxpiVisionInfo &srcMxpiVisionInfo, MxpiVisionData &srcMxpiVisionData)
 {
@@ -578,32 +625,43 @@ APP_ERROR MxpiImageResize::OpencvResize(MxpiVisionInfo &dstMxpiVisionInfo, MxpiV
         LogError << errorInfo_.str();
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    cv::Mat imageRGB;
-    if (srcMxpiVisionData.datatype() == MxTools::MXPI_DATA_TYPE_UINT8) {
-        imageRGB.create(srcMxpiVisionInfo.height(), srcMxpiVisionInfo.width(), CV_8UC3);
-    } else if (srcMxpiVisionData.datatype() == MxTools::MXPI_DATA_TYPE_FLOAT32) {
-        imageRGB.create(srcMxpiVisionInfo.height(), srcMxpiVisionInfo.width(), CV_32FC3);
-    } else {
-        errorInfo_ << "SrcMxpiVisionData datatype error, vaule:" <<  srcMxpiVisionData.datatype() << "."
-                   << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-        LogError << errorInfo_.str();
-        return APP_ERR_COMM_INVALID_PARAM;
+    LetterboxImage image;
+    uint32_t format = 0;
+    ret = GetLetterboxImage(srcMxpiVisionInfo, srcMxpiVisionData, image, format);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::vector<uint8_t> rescaled;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int interpolation = cv::INTER_LINEAR;
+    LetterboxParam param;
+    ret = OpencvResizeProcess(image, rescaled, width, height, interpolation);
+    if (ret == APP_ERR_OK) {
+        ret = OpencvPaddingProcess(width, height, param.geometry);
     }
-    imageRGB.data = (uchar *)srcMxpiVisionData.dataptr();
-    cv::Mat resizeRGB;
-    OpencvResizeProcess(resizeRGB, imageRGB, srcMxpiVisionInfo);
-    ret = OpencvPaddingProcess(resizeRGB, srcMxpiVisionInfo);
     if (ret != APP_ERR_OK) {
         errorInfo_ << "OpencvPaddingProcess failed." << GetErrorInfo(ret);
         LogError << errorInfo_.str();
         return ret;
     }
-    ret = SetOutputData(dstMxpiVisionInfo, dstMxpiVisionData, srcMxpiVisionInfo, srcMxpiVisionData, resizeRGB);
+    GetPaddingValue(format, param.padValue);
+    MemoryData memoryDataDst(LetterboxResizer::GetOutputSize(image.dataType, param.geometry),
+        MemoryData::MEMORY_HOST_MALLOC, deviceId_);
+    ret = MemoryHelper::MxbsMalloc(memoryDataDst);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Memory malloc failed." << GetErrorInfo(ret);
+        LogError << errorInfo_.str();
+        return ret;
+    }
+    ret = LetterboxResize(image, param, interpolation, memoryDataDst);
     if (ret != APP_ERR_OK) {
-        errorInfo_ << "SetOutputData failed." << GetErrorInfo(ret);
+        MemoryHelper::MxbsFree(memoryDataDst);
+        errorInfo_ << "Letterbox resize failed." << GetErrorInfo(ret);
         LogError << errorInfo_.str();
         return ret;
     }
+    SetOutputData(dstMxpiVisionInfo, dstMxpiVisionData, srcMxpiVisionData, memoryDataDst, param.geometry, format);
     return APP_ERR_OK;
 }
 
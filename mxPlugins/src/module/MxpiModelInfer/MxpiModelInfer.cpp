@@ -73,13 +73,14 @@ APP_ERROR MxpiModelInfer::Init(std::map<std::string, std::shared_ptr<void>>& con
 
 APP_ERROR MxpiModelInfer::InitModelInfer(std::map<std::string, std::shared_ptr<void>> &configParamMap)
 {
-    std::vector<std::string> parameterNamesPtr = {"modelPath", "waitingTime", "dynamicStrategy"};
+    std::vector<std::string> parameterNamesPtr = {"modelPath", "waitingTime", "dynamicStrategy", "shareWeights"};
     auto ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
     if (ret != APP_ERR_OK) {
         LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
         return ret;
     }
-    ret = modelInfer_.Init(*std::static_pointer_cast<std::string>(configParamMap["modelPath"]));
+    bool shareWeights = *std::static_pointer_cast<bool>(configParamMap["shareWeights"]);
+    ret = modelInfer_.Init(*std::static_pointer_cast<std::string>(configParamMap["modelPath"]), shareWeights);
     if (ret != APP_ERR_OK) {
         LogError << "Failed to init model inference." << GetErrorInfo(ret);
         return ret;
@@ -202,7 +203,12 @@ std::vector<std::shared_ptr<void>> MxpiModelInfer::DefineProperties()
     auto checkImageAlignInfo = (std::make_shared<ElementProperty<std::string>>)(ElementProperty<std::string> {
         STRING, "checkImageAlignInfo", "check image align info", "yes or no to check image align info", "on", "", ""
     });
-    properties = {modelPath, parentName, checkImageAlignInfo, timeTravel, dynamicStrategy, outputDeviceId};
+    auto shareWeights = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+        UINT, "shareWeights", "shareWeights",
+        "share model weights with other elements loading the same model on the device, yes:1, no:0", 0, 0, 1
+    });
+    properties = {modelPath, parentName, checkImageAlignInfo, timeTravel, dynamicStrategy, outputDeviceId,
+                  shareWeights};
     return properties;
 }
 
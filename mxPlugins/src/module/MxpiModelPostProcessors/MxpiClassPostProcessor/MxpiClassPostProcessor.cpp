@@ -97,7 +97,8 @@ APP_ERROR MxpiClassPostProcessor::Process(std::vector<MxTools::MxpiBuffer *> &mx
         return ret;
     }
     if (!IsVVectorEmpty(classInfos)) {
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(classInfos, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_,
+            ConstructProtobuf(classInfos, dataSource_, mxpiMetadataManager.GetArena()));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
@@ -101,7 +101,8 @@ APP_ERROR MxpiKeypointPostProcessor::Process(std::vector<MxTools::MxpiBuffer *>
         return ret;
     }
     if (!IsVVectorEmpty(keypointInfos)) {
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(keypointInfos, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_,
+            ConstructProtobuf(keypointInfos, dataSource_, mxpiMetadataManager.GetArena()));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
@@ -108,7 +108,8 @@ APP_ERROR MxpiObjectPostProcessor::Process(std::vector<MxTools::MxpiBuffer *> &m
         return ret;
     }
     if (!IsVVectorEmpty(objectInfos)) {
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(objectInfos, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_,
+            ConstructProtobuf(objectInfos, dataSource_, mxpiMetadataManager.GetArena()));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
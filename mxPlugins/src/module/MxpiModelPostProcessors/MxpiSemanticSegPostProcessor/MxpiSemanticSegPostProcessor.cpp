@@ -31,6 +31,15 @@ using namespace MxBase;
 using namespace MxTools;
 using namespace MxPlugins;
 
+namespace {
+const std::string MASK_ENCODING_RAW = "raw";
+const std::map<std::string, MaskEncoding> MASK_ENCODINGS = {
+    {MASK_ENCODING_RAW, MaskEncoding::RAW},
+    {"compact", MaskEncoding::RAW_COMPACT},
+    {"rle", MaskEncoding::RLE},
+};
+}
+
 APP_ERROR MxpiSemanticSegPostProcessor::Init(std::map<std::string, std::shared_ptr<void>> &configParamMap)
 {
     APP_ERROR ret = APP_ERR_OK;
@@ -48,6 +57,18 @@ APP_ERROR MxpiSemanticSegPostProcessor::Init(std::map<std::string, std::shared_p
             return ret;
         }
     }
+    if (configParamMap.find("maskEncoding") == configParamMap.end() || configParamMap["maskEncoding"] == nullptr) {
+        LogError << "Property(maskEncoding) not exists in plugin!" << GetErrorInfo(APP_ERR_COMM_NO_EXIST);
+        return APP_ERR_COMM_NO_EXIST;
+    }
+    std::string maskEncoding = *std::static_pointer_cast<std::string>(configParamMap["maskEncoding"]);
+    auto encodingIter = MASK_ENCODINGS.find(maskEncoding);
+    if (encodingIter == MASK_ENCODINGS.end()) {
+        LogError << "Property(maskEncoding) must be \"raw\", \"compact\" or \"rle\", but it is \"" << maskEncoding
+                 << "\"." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    maskEncoding_ = encodingIter->second;
     // InitPostProcessInstance.
     ret = InitPostProcessInstance<GetSemanticSegInstanceFunc>(configParamMap, "GetSemanticSegInstance");
     if (ret != APP_ERR_OK) {
@@ -88,7 +109,8 @@ APP_ERROR MxpiSemanticSegPostProcessor::Process(std::vector<MxTools::MxpiBuffer
     }
     if (!semanticSegInfos.empty()) {
         auto startTime0 = std::chrono::high_resolution_clock::now();
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(semanticSegInfos, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(std::move(semanticSegInfos),
+            dataSource_, maskEncoding_));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
@@ -118,6 +140,10 @@ APP_ERROR MxpiSemanticSegPostProcessor::DeInit()
 std::vector<std::shared_ptr<void>> MxpiSemanticSegPostProcessor::DefineProperties()
 {
     std::vector<std::shared_ptr<void>> properties = MxImagePostProcessorBase::DefineProperties();
+    auto maskEncoding = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+        STRING, "maskEncoding", "encoding", "output mask encoding, raw, compact or rle", MASK_ENCODING_RAW, "", ""
+    });
+    properties.push_back(maskEncoding);
     return properties;
 }
 
@@ -100,7 +100,8 @@ APP_ERROR MxpiTextGenerationPostProcessor::Process(std::vector<MxTools::MxpiBuff
         return ret;
     }
     if (!IsTextsInfosEmpty(textsInfo)) {
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(textsInfo, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_,
+            ConstructProtobuf(textsInfo, dataSource_, mxpiMetadataManager.GetArena()));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
@@ -103,7 +103,8 @@ APP_ERROR MxpiTextObjectPostProcessor::Process(std::vector<MxTools::MxpiBuffer *
         return ret;
     }
     if (!IsVVectorEmpty(textObjectInfos)) {
-        ret = mxpiMetadataManager.AddProtoMetadata(elementName_, ConstructProtobuf(textObjectInfos, dataSource_));
+        ret = mxpiMetadataManager.AddProtoMetadata(elementName_,
+            ConstructProtobuf(textObjectInfos, dataSource_, mxpiMetadataManager.GetArena()));
         if (ret != APP_ERR_OK) {
             errorInfo_ << "Add proto metadata failed in Process." << GetErrorInfo(ret);
             SendMxpiErrorInfo(*mxpiBuffer[0], elementName_, ret, errorInfo_.str());
@@ -32,6 +32,11 @@ using namespace MxPlugins;
 
 namespace {
     const float CENTER_OFFSET_DIVISOR = 2.f;
+    const std::map<std::string, MxBase::TileMergePolicy> MERGE_POLICY = {
+        {"Nms_By_Area", MxBase::TILE_MERGE_NMS_BY_AREA},
+        {"Max_Score", MxBase::TILE_MERGE_MAX_SCORE},
+        {"Weighted_Fusion", MxBase::TILE_MERGE_WEIGHTED_FUSION}
+    };
 }
 
 namespace MxPlugins {
@@ -47,14 +52,44 @@ APP_ERROR MxpiNmsOverlapedRoiBase::Init(std::map<std::string, std::shared_ptr<vo
     }
     blockPluginName_ = *std::static_pointer_cast<std::string>(configParamMap["blockName"]);
     nmsValue_ = *std::static_pointer_cast<float>(configParamMap["nmsThreshold"]);
+    ret = InitMergeConfig(configParamMap);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
     LogInfo << "End to process (" << elementName_ << ") init.";
     return APP_ERR_OK;
 }
 
+APP_ERROR MxpiNmsOverlapedRoiBase::InitMergeConfig(std::map<std::string, std::shared_ptr<void>> &configParamMap)
+{
+    std::vector<std::string> parameterNamesPtr = {"mergePolicy", "crossBlockOnly"};
+    auto ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
+    if (ret != APP_ERR_OK) {
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    std::string mergePolicy = *std::static_pointer_cast<std::string>(configParamMap["mergePolicy"]);
+    auto iter = MERGE_POLICY.find(mergePolicy);
+    if (iter == MERGE_POLICY.end()) {
+        LogWarn << "element(" << elementName_ << ") unknown mergePolicy(" << mergePolicy
+                << "), using the default policy (Nms_By_Area) instead.";
+        mergeConfig_.policy = MxBase::TILE_MERGE_NMS_BY_AREA;
+    } else {
+        mergeConfig_.policy = iter->second;
+    }
+    mergeConfig_.crossTileOnly = *std::static_pointer_cast<int>(configParamMap["crossBlockOnly"]) != 0;
+    mergeConfig_.iouThresh = nmsValue_;
+    mergeConfig_.iouMethod = MxBase::IOUMethod::MIN;
+    LogInfo << "element(" << elementName_ << ") property mergePolicy(" << mergePolicy << "), crossBlockOnly("
+            << mergeConfig_.crossTileOnly << ").";
+    return APP_ERR_OK;
+}
+
 APP_ERROR MxpiNmsOverlapedRoiBase::DeInit()
 {
     LogInfo << "Begin to process (" << elementName_ << ") deinit.";
     mxpiObjectMap_.clear();
+    effectiveAreas_.clear();
     LogInfo << "End to process (" << elementName_ << ") deinit.";
     return APP_ERR_OK;
 }
@@ -146,15 +181,12 @@ void MxpiNmsOverlapedRoiBase::CompareBlockObject(std::shared_ptr<MxTools::MxpiOb
     for (int i = 0; i < mxpiObjectList->objectvec_size(); i++) {
         mxpiObject[i] = mxpiObjectList->objectvec(i);
     }
-    if (mxpiObjectMap_.size() == mxpiObject.size()) {
-        for (size_t i = 0; i < mxpiObjectMap_.size(); i++) {
-            if (!IsIntersecting(mxpiObject, i)) {
-                mxpiObjectMap_.clear();
-                mxpiObjectMap_.insert(mxpiObject.begin(), mxpiObject.end());
-                CalcEffectiveArea();
-            }
-        }
-    } else {
+    // the blocks rarely change between frames, the effective areas are only computed again when they do
+    bool changed = mxpiObjectMap_.size() != mxpiObject.size();
+    for (size_t i = 0; !changed && i < mxpiObjectMap_.size(); i++) {
+        changed = !IsIntersecting(mxpiObject, i);
+    }
+    if (changed) {
         mxpiObjectMap_.clear();
         mxpiObjectMap_.insert(mxpiObject.begin(), mxpiObject.end());
         CalcEffectiveArea();
@@ -173,6 +205,10 @@ void MxpiNmsOverlapedRoiBase::CalcEffectiveArea()
             }
         }
     }
+    effectiveAreas_.resize(mxpiObjectMap_.size());
+    for (const auto &block : mxpiObjectMap_) {
+        effectiveAreas_[block.first] = {block.second.x0(), block.second.y0(), block.second.x1(), block.second.y1()};
+    }
 }
 
 void MxpiNmsOverlapedRoiBase::CalcAreaOffsetY(int i, int j)
@@ -208,16 +244,22 @@ void MxpiNmsOverlapedRoiBase::CalcAreaOffsetX(int i, int j)
 APP_ERROR MxpiNmsOverlapedRoiBase::FilterRepeatObject(std::shared_ptr<MxTools::MxpiObjectList> mxpiObjectList,
                                                       std::shared_ptr<MxTools::MxpiObjectList> metaDataPtr)
 {
-    std::vector<MxTools::MxpiObject> filterObjectVec;
+    detectBoxes_.clear();
+    blockIds_.clear();
     for (const auto &item : mxpiObjectList->objectvec()) {
-        if (!IsExceedingEffectiveArea(item)) {
-            filterObjectVec.push_back(item);
+        if (item.classvec_size() == 0 || IsExceedingEffectiveArea(item)) {
+            continue;
         }
+        detectBoxes_.emplace_back();
+        ConvertObjectToDetectBox(item, detectBoxes_.back());
+        blockIds_.push_back(item.headervec(0).memberid());
     }
-    std::vector<MxBase::DetectBox> detectBoxes;
-    ConvertObjectToDetectBox(detectBoxes, filterObjectVec);
-    MxBase::NmsSortByArea(detectBoxes, nmsValue_, MxBase::IOUMethod::MIN);
-    APP_ERROR ret = ConvertDetectBoxToObject(detectBoxes, metaDataPtr);
+    APP_ERROR ret = merger_.Merge(detectBoxes_, blockIds_, effectiveAreas_, mergeConfig_, mergedBoxes_);
+    if (ret != APP_ERR_OK) {
+        LogError << "Merge the objects of the blocks failed." << GetErrorInfo(ret);
+        return ret;
+    }
+    ret = ConvertDetectBoxToObject(mergedBoxes_, metaDataPtr);
     if (ret != APP_ERR_OK) {
         LogError << "Convert detectBox to object failed"<<  GetErrorInfo(ret);
         return ret;
@@ -225,22 +267,19 @@ APP_ERROR MxpiNmsOverlapedRoiBase::FilterRepeatObject(std::shared_ptr<MxTools::M
     return APP_ERR_OK;
 }
 
-void MxpiNmsOverlapedRoiBase::ConvertObjectToDetectBox(std::vector<MxBase::DetectBox> &detectBoxes,
-                                                       std::vector<MxTools::MxpiObject> filterObjectVec)
+void MxpiNmsOverlapedRoiBase::ConvertObjectToDetectBox(const MxTools::MxpiObject &object,
+                                                       MxBase::DetectBox &detectBox)
 {
-    for (const auto &object : filterObjectVec) {
-        MxBase::DetectBox detectBox {};
-        float width = object.x1() - object.x0();
-        float height = object.y1() - object.y0();
-        detectBox.x = object.x0() + width / CENTER_OFFSET_DIVISOR;
-        detectBox.y = object.y0() + height / CENTER_OFFSET_DIVISOR;
-        detectBox.width = width;
-        detectBox.height = height;
-        detectBox.classID = object.classvec(0).classid();
-        detectBox.prob = object.classvec(0).confidence();
-        detectBox.className = object.classvec(0).classname();
-        detectBoxes.push_back(detectBox);
-    }
+    float width = object.x1() - object.x0();
+    float height = object.y1() - object.y0();
+    detectBox.x = object.x0() + width / CENTER_OFFSET_DIVISOR;
+    detectBox.y = object.y0() + height / CENTER_OFFSET_DIVISOR;
+    detectBox.width = width;
+    detectBox.height = height;
+    detectBox.classID = object.classvec(0).classid();
+    detectBox.prob = object.classvec(0).confidence();
+    detectBox.className = object.classvec(0).classname();
+    detectBox.maskPtr = nullptr;
 }
 
 APP_ERROR MxpiNmsOverlapedRoiBase::ConvertDetectBoxToObject(const std::vector<MxBase::DetectBox> &detectBoxes,
@@ -279,9 +318,18 @@ std::vector<std::shared_ptr<void>> MxpiNmsOverlapedRoiBase::DefineProperties()
     auto nmsValue = std::make_shared<ElementProperty<float>>(ElementProperty<float> {
         FLOAT, "nmsThreshold", "nms", "the threshold of nms", 0.45f, 0.f, 1.f
     });
+    auto mergePolicy = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+        STRING, "mergePolicy", "policy", "how overlapping objects are merged, Nms_By_Area, Max_Score or "
+        "Weighted_Fusion", "Nms_By_Area", "", ""
+    });
+    auto crossBlockOnly = std::make_shared<ElementProperty<int>>(ElementProperty<int> {
+        INT, "crossBlockOnly", "cross", "only merge objects of different blocks around the block borders", 0, 0, 1
+    });
 
     properties.push_back(blockName);
     properties.push_back(nmsValue);
+    properties.push_back(mergePolicy);
+    properties.push_back(crossBlockOnly);
     return properties;
 }
 
@@ -309,10 +357,13 @@ bool MxpiNmsOverlapedRoiBase::IsExceedingEffectiveArea(const MxTools::MxpiObject
         LogError << "Protobuf message vector is invalid." << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
         return true;
     }
-    return (object.x0() > mxpiObjectMap_[object.headervec(0).memberid()].x1() ||
-            object.y0() > mxpiObjectMap_[object.headervec(0).memberid()].y1() ||
-            object.x1() < mxpiObjectMap_[object.headervec(0).memberid()].x0() ||
-            object.y1() < mxpiObjectMap_[object.headervec(0).memberid()].y0());
+    if (object.headervec(0).memberid() < 0 ||
+        static_cast<size_t>(object.headervec(0).memberid()) >= effectiveAreas_.size()) {
+        LogDebug << "The object of block(" << object.headervec(0).memberid() << ") has no effective area.";
+        return true;
+    }
+    const MxBase::CropRoiBox &area = effectiveAreas_[object.headervec(0).memberid()];
+    return (object.x0() > area.x1 || object.y0() > area.y1 || object.x1() < area.x0 || object.y1() < area.y0);
 }
 
 bool MxpiNmsOverlapedRoiBase::IsIntersecting(std::map<int, MxTools::MxpiObject> &mxpiObject, int index)
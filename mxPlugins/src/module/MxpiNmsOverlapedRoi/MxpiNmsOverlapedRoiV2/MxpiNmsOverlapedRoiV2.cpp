@@ -63,6 +63,10 @@ APP_ERROR MxpiNmsOverlapedRoiV2::Init(std::map<std::string, std::shared_ptr<void
     // nms threshold
     nmsValue_ = *std::static_pointer_cast<float>(configParamMap["nmsThreshold"]);
     LogInfo << "element(" << elementName_ << ") property nmsThreshold(" << nmsValue_ << ").";
+    ret = InitMergeConfig(configParamMap);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
 
     // status must be SYNC
     if (status_ != MxTools::SYNC) {
@@ -238,10 +242,19 @@ std::vector<std::shared_ptr<void>> MxpiNmsOverlapedRoiV2::DefineProperties()
     auto nmsValue = std::make_shared<ElementProperty<float>>(ElementProperty<float> {
         FLOAT, "nmsThreshold", "nms", "the threshold of nms", 0.45f, 0.f, 1.f
     });
+    auto mergePolicy = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+        STRING, "mergePolicy", "policy", "how overlapping objects are merged, Nms_By_Area, Max_Score or "
+        "Weighted_Fusion", "Nms_By_Area", "", ""
+    });
+    auto crossBlockOnly = std::make_shared<ElementProperty<int>>(ElementProperty<int> {
+        INT, "crossBlockOnly", "cross", "only merge objects of different blocks around the block borders", 0, 0, 1
+    });
 
     properties.push_back(objectName);
     properties.push_back(blockName);
     properties.push_back(nmsValue);
+    properties.push_back(mergePolicy);
+    properties.push_back(crossBlockOnly);
     return properties;
 }
 
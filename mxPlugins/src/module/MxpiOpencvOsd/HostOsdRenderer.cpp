@@ -0,0 +1,431 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Host OSD renderer drawing straight on NV12/NV21 planes or packed RGB/BGR images.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxPlugins/MxpiOpencvOsd/HostOsdRenderer.h"
+#include <algorithm>
+#include <tuple>
+#include "MxBase/Log/Log.h"
+#include "MxBase/DvppWrapper/DvppWrapperDataType.h"
+
+using namespace MxTools;
+
+namespace {
+const char FIRST_GLYPH = ' ';
+const char LAST_GLYPH = '~';
+const char UNKNOWN_GLYPH = '?';
+const int GLYPH_PAD = 2;
+const size_t MAX_ATLAS_NUM = 64;
+const int MAX_ALPHA = 255;
+const int HALF_ALPHA = 127;
+const int MIN_BAND_ROWS = 16;
+const int EVEN_MASK = ~1;
+const int PACKED_CHANNELS = 3;
+const int AA_MARGIN = 2;
+
+using AtlasKey = std::tuple<int, double, int, int>;
+std::mutex g_atlasMutex;
+std::map<AtlasKey, std::shared_ptr<const MxPlugins::GlyphAtlas>> g_atlasMap;
+
+struct YuvColor {
+    uint8_t y;
+    uint8_t u;
+    uint8_t v;
+};
+
+inline uint8_t ClampToByte(double value)
+{
+    return static_cast<uint8_t>(std::min(std::max(value + 0.5, 0.0), 255.0));
+}
+
+// BT.601 video range, the same conversion the vpc applies to the aicpu output
+YuvColor BgrToYuv(const cv::Scalar& color)
+{
+    const double b = color[0];
+    const double g = color[1];
+    const double r = color[2];
+    YuvColor yuv = {};
+    yuv.y = ClampToByte(16.0 + 0.257 * r + 0.504 * g + 0.098 * b);
+    yuv.u = ClampToByte(128.0 - 0.148 * r - 0.291 * g + 0.439 * b);
+    yuv.v = ClampToByte(128.0 + 0.439 * r - 0.368 * g - 0.071 * b);
+    return yuv;
+}
+
+inline uint8_t Blend(uint8_t dst, uint8_t src, int alpha)
+{
+    if (alpha >= MAX_ALPHA) {
+        return src;
+    }
+    return static_cast<uint8_t>((dst * (MAX_ALPHA - alpha) + src * alpha + HALF_ALPHA) / MAX_ALPHA);
+}
+
+inline int GetAlpha(const cv::Mat& mask, int row, int col)
+{
+    return mask.empty() ? MAX_ALPHA : mask.at<uint8_t>(row, col);
+}
+
+cv::Scalar GetColor(const MxpiOsdParams& params)
+{
+    return cv::Scalar(params.scalorb(), params.scalorg(), params.scalorr());
+}
+}
+
+namespace MxPlugins {
+GlyphAtlas::GlyphAtlas(int fontFace, double fontScale, int thickness, int lineType)
+{
+    const int pad = thickness + GLYPH_PAD;
+    glyphs_.resize(LAST_GLYPH - FIRST_GLYPH + 1);
+    for (char c = FIRST_GLYPH; c <= LAST_GLYPH; c++) {
+        Glyph& glyph = glyphs_[c - FIRST_GLYPH];
+        std::string single(1, c);
+        int baseline = 0;
+        cv::Size size = cv::getTextSize(single, fontFace, fontScale, thickness, &baseline);
+        // putText has no per glyph metrics, the advance is measured from the width of a doubled glyph
+        cv::Size doubled = cv::getTextSize(single + single, fontFace, fontScale, thickness, &baseline);
+        glyph.advance = doubled.width - size.width;
+        glyph.offset = cv::Point(-pad, -(size.height + pad));
+        glyph.mask = cv::Mat::zeros(size.height + baseline + pad * 2, size.width + pad * 2, CV_8UC1);
+        cv::putText(glyph.mask, single, cv::Point(pad, size.height + pad), fontFace, fontScale,
+                    cv::Scalar(MAX_ALPHA), thickness, lineType, false);
+    }
+}
+
+std::shared_ptr<const GlyphAtlas> GlyphAtlas::Get(int fontFace, double fontScale, int thickness, int lineType)
+{
+    AtlasKey key(fontFace, fontScale, thickness, lineType);
+    std::lock_guard<std::mutex> lock(g_atlasMutex);
+    auto iter = g_atlasMap.find(key);
+    if (iter != g_atlasMap.end()) {
+        return iter->second;
+    }
+    if (g_atlasMap.size() >= MAX_ATLAS_NUM) {
+        // text styles are few in practice, dropping every entry keeps the cache bounded without lru bookkeeping
+        LogDebug << "Glyph atlas cache is full, clear it.";
+        g_atlasMap.clear();
+    }
+    auto atlas = std::make_shared<const GlyphAtlas>(fontFace, fontScale, thickness, lineType);
+    g_atlasMap[key] = atlas;
+    return atlas;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(char c) const
+{
+    if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+        c = UNKNOWN_GLYPH;
+    }
+    return glyphs_[c - FIRST_GLYPH];
+}
+
+bool HostOsdRenderer::IsFormatSupported(uint32_t format)
+{
+    return format == MxBase::MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420 ||
+        format == MxBase::MXBASE_PIXEL_FORMAT_YVU_SEMIPLANAR_420 ||
+        format == MxBase::MXBASE_PIXEL_FORMAT_RGB_888 ||
+        format == MxBase::MXBASE_PIXEL_FORMAT_BGR_888;
+}
+
+APP_ERROR HostOsdRenderer::Render(const MxpiOsdInstances& osdInstances, OsdImage& image)
+{
+    if (image.data == nullptr || image.width == 0 || image.height == 0 ||
+        image.widthStride < image.width || image.heightStride < image.height) {
+        LogError << "Invalid image for host osd, width(" << image.width << "), height(" << image.height
+                 << "), widthStride(" << image.widthStride << "), heightStride(" << image.heightStride << ")."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (!IsFormatSupported(image.format)) {
+        LogError << "The format(" << image.format << ") is not supported by host osd."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    image_ = image;
+    imageRect_ = cv::Rect(0, 0, static_cast<int>(image.width), static_cast<int>(image.height));
+    items_.clear();
+    for (int i = 0; i < osdInstances.osdrectvec_size(); i++) {
+        AddRect(osdInstances.osdrectvec(i));
+    }
+    for (int i = 0; i < osdInstances.osdtextvec_size(); i++) {
+        AddText(osdInstances.osdtextvec(i));
+    }
+    for (int i = 0; i < osdInstances.osdcirclevec_size(); i++) {
+        AddCircle(osdInstances.osdcirclevec(i));
+    }
+    for (int i = 0; i < osdInstances.osdlinevec_size(); i++) {
+        AddLine(osdInstances.osdlinevec(i));
+    }
+    if (items_.empty()) {
+        return APP_ERR_OK;
+    }
+
+    const int rows = static_cast<int>(image.height);
+    int bandNum = std::max(1, std::min(cv::getNumThreads(), rows / MIN_BAND_ROWS));
+    // bands start on even rows so that every chroma row belongs to exactly one band
+    int bandRows = ((rows + bandNum - 1) / bandNum + 1) & EVEN_MASK;
+    bandNum = (rows + bandRows - 1) / bandRows;
+    bool isYuv = image.format == MxBase::MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420 ||
+        image.format == MxBase::MXBASE_PIXEL_FORMAT_YVU_SEMIPLANAR_420;
+    cv::parallel_for_(cv::Range(0, bandNum), [&](const cv::Range& range) {
+        for (int band = range.start; band < range.end; band++) {
+            int rowBegin = band * bandRows;
+            int rowEnd = std::min(rows, rowBegin + bandRows);
+            if (isYuv) {
+                BlendBandNv12(rowBegin, rowEnd);
+            } else {
+                BlendBandPacked(rowBegin, rowEnd);
+            }
+        }
+    });
+    items_.clear();
+    return APP_ERR_OK;
+}
+
+void HostOsdRenderer::AddSolid(const cv::Rect& box, const cv::Scalar& color)
+{
+    cv::Rect clipped = box & imageRect_;
+    if (clipped.area() <= 0) {
+        return;
+    }
+    items_.push_back(DrawItem{clipped, cv::Mat(), color});
+}
+
+void HostOsdRenderer::AddMask(const cv::Rect& box, const cv::Mat& mask, const cv::Scalar& color)
+{
+    cv::Rect clipped = box & imageRect_;
+    if (clipped.area() <= 0) {
+        return;
+    }
+    cv::Rect local(clipped.x - box.x, clipped.y - box.y, clipped.width, clipped.height);
+    items_.push_back(DrawItem{clipped, mask(local), color});
+}
+
+void HostOsdRenderer::AddRect(const MxpiOsdRect& rect)
+{
+    const MxpiOsdParams& params = rect.osdparams();
+    const cv::Scalar color = GetColor(params);
+    const int thickness = params.thickness();
+    if (thickness == 0) {
+        return;
+    }
+    if (params.linetype() != cv::LINE_AA && params.shift() == 0) {
+        int left = std::min(rect.x0(), rect.x1());
+        int right = std::max(rect.x0(), rect.x1());
+        int top = std::min(rect.y0(), rect.y1());
+        int bottom = std::max(rect.y0(), rect.y1());
+        if (thickness < 0) {
+            AddSolid(cv::Rect(left, top, right - left + 1, bottom - top + 1), color);
+            return;
+        }
+        // four solid bars centered on the edges, no mask is needed for the common detection box
+        const int half = thickness / 2;
+        const int outerWidth = right - left + thickness;
+        const int innerHeight = bottom - top - thickness;
+        AddSolid(cv::Rect(left - half, top - half, outerWidth, thickness), color);
+        AddSolid(cv::Rect(left - half, bottom - half, outerWidth, thickness), color);
+        if (innerHeight > 0) {
+            AddSolid(cv::Rect(left - half, top - half + thickness, thickness, innerHeight), color);
+            AddSolid(cv::Rect(right - half, top - half + thickness, thickness, innerHeight), color);
+        }
+        return;
+    }
+    const int shift = params.shift();
+    const int margin = std::max(thickness, 1) + AA_MARGIN;
+    int left = (std::min(rect.x0(), rect.x1()) >> shift) - margin;
+    int top = (std::min(rect.y0(), rect.y1()) >> shift) - margin;
+    int right = (std::max(rect.x0(), rect.x1()) >> shift) + margin;
+    int bottom = (std::max(rect.y0(), rect.y1()) >> shift) + margin;
+    cv::Rect box(left, top, right - left + 1, bottom - top + 1);
+    if ((box & imageRect_).area() <= 0) {
+        return;
+    }
+    cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+    cv::Point origin(left * (1 << shift), top * (1 << shift));
+    cv::rectangle(mask, cv::Point(rect.x0(), rect.y0()) - origin, cv::Point(rect.x1(), rect.y1()) - origin,
+                  cv::Scalar(MAX_ALPHA), thickness, params.linetype(), shift);
+    AddMask(box, mask, color);
+}
+
+void HostOsdRenderer::AddText(const MxpiOsdText& text)
+{
+    if (text.text().empty()) {
+        return;
+    }
+    const MxpiOsdParams& params = text.osdparams();
+    const int thickness = std::max(params.thickness(), 1);
+    if (text.bottomleftorigin()) {
+        // mirrored text is rare, draw it as a whole instead of through the atlas
+        int baseline = 0;
+        cv::Size size = cv::getTextSize(text.text(), text.fontface(), text.fontscale(), thickness, &baseline);
+        const int pad = thickness + GLYPH_PAD;
+        const int fullHeight = size.height + baseline;
+        cv::Rect box(text.x0() - pad, text.y0() - fullHeight - pad, size.width + pad * 2, fullHeight * 2 + pad * 2);
+        if ((box & imageRect_).area() <= 0) {
+            return;
+        }
+        cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+        cv::putText(mask, text.text(), cv::Point(text.x0() - box.x, text.y0() - box.y), text.fontface(),
+                    text.fontscale(), cv::Scalar(MAX_ALPHA), thickness, params.linetype(), true);
+        AddMask(box, mask, GetColor(params));
+        return;
+    }
+    auto atlas = GlyphAtlas::Get(text.fontface(), text.fontscale(), thickness, params.linetype());
+    // merge the glyphs into one mask so that the blend pass touches every pixel of the label once
+    cv::Rect box;
+    int pen = text.x0();
+    for (char c : text.text()) {
+        const GlyphAtlas::Glyph& glyph = atlas->GetGlyph(c);
+        cv::Rect glyphBox(pen + glyph.offset.x, text.y0() + glyph.offset.y, glyph.mask.cols, glyph.mask.rows);
+        box = box.area() > 0 ? (box | glyphBox) : glyphBox;
+        pen += glyph.advance;
+    }
+    if ((box & imageRect_).area() <= 0) {
+        return;
+    }
+    cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+    pen = text.x0();
+    for (char c : text.text()) {
+        const GlyphAtlas::Glyph& glyph = atlas->GetGlyph(c);
+        cv::Rect local(pen + glyph.offset.x - box.x, text.y0() + glyph.offset.y - box.y,
+                       glyph.mask.cols, glyph.mask.rows);
+        cv::Mat roi = mask(local);
+        cv::max(roi, glyph.mask, roi);
+        pen += glyph.advance;
+    }
+    AddMask(box, mask, GetColor(params));
+}
+
+void HostOsdRenderer::AddCircle(const MxpiOsdCircle& circle)
+{
+    const MxpiOsdParams& params = circle.osdparams();
+    const int shift = params.shift();
+    const int margin = std::max(params.thickness(), 1) + AA_MARGIN;
+    const int radius = (circle.radius() >> shift) + margin;
+    const int centerX = circle.x0() >> shift;
+    const int centerY = circle.y0() >> shift;
+    cv::Rect box(centerX - radius, centerY - radius, radius * 2 + 1, radius * 2 + 1);
+    if ((box & imageRect_).area() <= 0) {
+        return;
+    }
+    cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+    cv::Point origin(box.x * (1 << shift), box.y * (1 << shift));
+    cv::circle(mask, cv::Point(circle.x0(), circle.y0()) - origin, circle.radius(), cv::Scalar(MAX_ALPHA),
+               params.thickness(), params.linetype(), shift);
+    AddMask(box, mask, GetColor(params));
+}
+
+void HostOsdRenderer::AddLine(const MxpiOsdLine& line)
+{
+    const MxpiOsdParams& params = line.osdparams();
+    if (params.thickness() <= 0) {
+        return;
+    }
+    const int shift = params.shift();
+    const int margin = params.thickness() + AA_MARGIN;
+    int left = (std::min(line.x0(), line.x1()) >> shift) - margin;
+    int top = (std::min(line.y0(), line.y1()) >> shift) - margin;
+    int right = (std::max(line.x0(), line.x1()) >> shift) + margin;
+    int bottom = (std::max(line.y0(), line.y1()) >> shift) + margin;
+    cv::Rect box(left, top, right - left + 1, bottom - top + 1);
+    if ((box & imageRect_).area() <= 0) {
+        return;
+    }
+    cv::Mat mask = cv::Mat::zeros(box.size(), CV_8UC1);
+    cv::Point origin(left * (1 << shift), top * (1 << shift));
+    cv::line(mask, cv::Point(line.x0(), line.y0()) - origin, cv::Point(line.x1(), line.y1()) - origin,
+             cv::Scalar(MAX_ALPHA), params.thickness(), params.linetype(), shift);
+    AddMask(box, mask, GetColor(params));
+}
+
+void HostOsdRenderer::BlendBandNv12(int rowBegin, int rowEnd)
+{
+    const size_t stride = image_.widthStride;
+    uint8_t* lumaPlane = image_.data;
+    uint8_t* chromaPlane = image_.data + stride * image_.heightStride;
+    const bool isNv21 = image_.format == MxBase::MXBASE_PIXEL_FORMAT_YVU_SEMIPLANAR_420;
+    for (const auto& item : items_) {
+        int top = std::max(rowBegin, item.box.y);
+        int bottom = std::min(rowEnd, item.box.y + item.box.height);
+        if (top >= bottom) {
+            continue;
+        }
+        const YuvColor yuv = BgrToYuv(item.color);
+        const int left = item.box.x;
+        const int right = item.box.x + item.box.width;
+        for (int row = top; row < bottom; row++) {
+            uint8_t* luma = lumaPlane + stride * row;
+            for (int col = left; col < right; col++) {
+                int alpha = GetAlpha(item.mask, row - item.box.y, col - left);
+                if (alpha > 0) {
+                    luma[col] = Blend(luma[col], yuv.y, alpha);
+                }
+            }
+        }
+        // one chroma sample covers a 2x2 block, it takes the strongest coverage of the block
+        const uint8_t first = isNv21 ? yuv.v : yuv.u;
+        const uint8_t second = isNv21 ? yuv.u : yuv.v;
+        for (int chromaRow = top / 2; chromaRow * 2 < bottom; chromaRow++) {
+            uint8_t* chroma = chromaPlane + stride * chromaRow;
+            for (int chromaCol = left / 2; chromaCol * 2 < right; chromaCol++) {
+                int alpha = 0;
+                for (int row = chromaRow * 2; row < chromaRow * 2 + 2; row++) {
+                    for (int col = chromaCol * 2; col < chromaCol * 2 + 2; col++) {
+                        if (row >= top && row < bottom && col >= left && col < right) {
+                            alpha = std::max(alpha, GetAlpha(item.mask, row - item.box.y, col - left));
+                        }
+                    }
+                }
+                if (alpha > 0) {
+                    chroma[chromaCol * 2] = Blend(chroma[chromaCol * 2], first, alpha);
+                    chroma[chromaCol * 2 + 1] = Blend(chroma[chromaCol * 2 + 1], second, alpha);
+                }
+            }
+        }
+    }
+}
+
+void HostOsdRenderer::BlendBandPacked(int rowBegin, int rowEnd)
+{
+    const size_t stride = static_cast<size_t>(image_.widthStride) * PACKED_CHANNELS;
+    const bool isRgb = image_.format == MxBase::MXBASE_PIXEL_FORMAT_RGB_888;
+    for (const auto& item : items_) {
+        int top = std::max(rowBegin, item.box.y);
+        int bottom = std::min(rowEnd, item.box.y + item.box.height);
+        if (top >= bottom) {
+            continue;
+        }
+        const uint8_t b = ClampToByte(item.color[0]);
+        const uint8_t g = ClampToByte(item.color[1]);
+        const uint8_t r = ClampToByte(item.color[2]);
+        const uint8_t first = isRgb ? r : b;
+        const uint8_t third = isRgb ? b : r;
+        for (int row = top; row < bottom; row++) {
+            uint8_t* pixel = image_.data + stride * row + static_cast<size_t>(item.box.x) * PACKED_CHANNELS;
+            for (int col = 0; col < item.box.width; col++, pixel += PACKED_CHANNELS) {
+                int alpha = GetAlpha(item.mask, row - item.box.y, col);
+                if (alpha > 0) {
+                    pixel[0] = Blend(pixel[0], first, alpha);
+                    pixel[1] = Blend(pixel[1], g, alpha);
+                    pixel[2] = Blend(pixel[2], third, alpha);
+                }
+            }
+        }
+    }
+}
+}
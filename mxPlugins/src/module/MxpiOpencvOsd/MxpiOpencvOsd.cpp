@@ -53,6 +53,11 @@ const int OFFSET_POS = 5;
 const int MAX_THICKNESS = 32767;
 const uint32_t MAX_COLOR = 255;
 const int XY_SHIFT = 16;
+const std::string OSD_BACKEND_AICPU = "aicpu";
+const std::string OSD_BACKEND_HOST = "host";
+const uint32_t YUV420_PLANE_NUM = 3;
+const uint32_t YUV420_PLANE_DEN = 2;
+const uint32_t PACKED_CHANNEL_NUM = 3;
 }
 
 static APP_ERROR CheckOmPath(std::string& realPath)
@@ -77,6 +82,57 @@ APP_ERROR MxpiOpencvOsd::Init(std::map<std::string, std::shared_ptr<void>> &conf
     status_ = SYNC;
     doPreErrorCheck_ = true;
     doPreMetaDataCheck_ = false;
+    std::vector<std::string> backendNames = {"osdBackend"};
+    APP_ERROR ret = CheckConfigParamMapIsValid(backendNames, configParamMap);
+    if (ret != APP_ERR_OK) {
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    std::string osdBackend = *std::static_pointer_cast<std::string>(configParamMap["osdBackend"]);
+    if (osdBackend != OSD_BACKEND_AICPU && osdBackend != OSD_BACKEND_HOST) {
+        LogError << "The osdBackend is [" << osdBackend << "], the value must be \"aicpu\" or \"host\"."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    hostOsd_ = (osdBackend == OSD_BACKEND_HOST);
+    if (!hostOsd_) {
+        ret = InitAicpuRunner();
+        if (ret != APP_ERR_OK) {
+            return ret;
+        }
+    }
+    if (dataSourceKeys_.size() != DATA_SOURCE_SIZE) {
+        runner_.DeInit();
+        LogError << "The number of data sources is [" << dataSourceKeys_.size() << "] not equal to 2."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    std::vector<std::string> parameterNamesPtr = {"dataSourceImage", "dataSourceOsd"};
+    ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
+    if (ret != APP_ERR_OK) {
+        runner_.DeInit();
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    dataSourceImage_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceImage"]);
+    dataSourceOsd_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceOsd"]);
+    dataSourceImage_ = (dataSourceImage_ == "auto") ? dataSourceKeys_[0] : dataSourceImage_;
+    dataSourceOsd_ = (dataSourceOsd_ == "auto") ? dataSourceKeys_[1] : dataSourceOsd_;
+    dataSourceKeys_ = {dataSourceImage_, dataSourceOsd_};
+    if (!hostOsd_) {
+        ret = dvppWrapper_.Init(MxBase::MXBASE_DVPP_CHNMODE_VPC);
+        if (ret != APP_ERR_OK) {
+            runner_.DeInit();
+            LogError << "Failed to initialize dvppWrapper_ object." << GetErrorInfo(ret);
+            return ret;
+        }
+    }
+    LogInfo << "End to initialize MxpiOpencvOsd(" << elementName_ << "), osd backend(" << osdBackend << ").";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiOpencvOsd::InitAicpuRunner()
+{
     std::string sdkHome = "/usr/local";
     auto sdkHomeEnv = std::getenv("MX_SDK_HOME");
     if (sdkHomeEnv) {
@@ -104,37 +160,17 @@ APP_ERROR MxpiOpencvOsd::Init(std::map<std::string, std::shared_ptr<void>> &conf
         LogError << "Single operator init failed." << GetErrorInfo(ret);
         return ret;
     }
-    if (dataSourceKeys_.size() != DATA_SOURCE_SIZE) {
-        runner_.DeInit();
-        LogError << "The number of data sources is [" << dataSourceKeys_.size() << "] not equal to 2."
-                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
-        return APP_ERR_COMM_INVALID_PARAM;
-    }
-    std::vector<std::string> parameterNamesPtr = {"dataSourceImage", "dataSourceOsd"};
-    ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
-    if (ret != APP_ERR_OK) {
-        runner_.DeInit();
-        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
-        return ret;
-    }
-    dataSourceImage_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceImage"]);
-    dataSourceOsd_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceOsd"]);
-    dataSourceImage_ = (dataSourceImage_ == "auto") ? dataSourceKeys_[0] : dataSourceImage_;
-    dataSourceOsd_ = (dataSourceOsd_ == "auto") ? dataSourceKeys_[1] : dataSourceOsd_;
-    dataSourceKeys_ = {dataSourceImage_, dataSourceOsd_};
-    ret = dvppWrapper_.Init(MxBase::MXBASE_DVPP_CHNMODE_VPC);
-    if (ret != APP_ERR_OK) {
-        runner_.DeInit();
-        LogError << "Failed to initialize dvppWrapper_ object." << GetErrorInfo(ret);
-        return ret;
-    }
-    LogInfo << "End to initialize MxpiOpencvOsd(" << elementName_ << ").";
     return APP_ERR_OK;
 }
 
 APP_ERROR MxpiOpencvOsd::DeInit()
 {
     LogInfo << "Begin to deinitialize MxpiOpencvOsd(" << elementName_ << ").";
+    if (hostOsd_) {
+        std::vector<uint8_t>().swap(hostBuffer_);
+        LogInfo << "End to deinitialize MxpiOpencvOsd(" << elementName_ << ").";
+        return APP_ERR_OK;
+    }
     APP_ERROR ret = runner_.DeInit();
     if (ret != APP_ERR_OK) {
         LogError << "Single operator deinit failed." << GetErrorInfo(ret);
@@ -233,7 +269,11 @@ APP_ERROR MxpiOpencvOsd::Process(std::vector<MxTools::MxpiBuffer *> &mxpiBuffer)
         return APP_ERR_COMM_INIT_FAIL;
     }
     std::shared_ptr<MxpiVisionList> mxpiVisionListDest(mxpiVisionListPtr, g_deleteFuncMxpiVisionList);
-    ret = AicpuProcess(mxpiVisionList, mxpiOsdInstancesList, mxpiVisionListDest);
+    if (hostOsd_) {
+        ret = HostProcess(mxpiVisionList, mxpiOsdInstancesList, mxpiVisionListDest);
+    } else {
+        ret = AicpuProcess(mxpiVisionList, mxpiOsdInstancesList, mxpiVisionListDest);
+    }
     MxpiBufferManager::DestroyBuffer(osdBuffer);
     if (ret != APP_ERR_OK) {
         LogError << errorInfo_.str() << GetErrorInfo(ret);
@@ -396,6 +436,162 @@ APP_ERROR MxpiOpencvOsd::BgrToYuvProcess(MxTools::MxpiVision& vision, MxBase::Me
     return APP_ERR_OK;
 }
 
+bool MxpiOpencvOsd::CheckHostOsdParam(const MxpiOsdInstances& osdList)
+{
+    for (int i = 0; i < osdList.osdrectvec_size(); i++) {
+        if (CheckOsdParam(osdList.osdrectvec(i).osdparams(), true)) {
+            return true;
+        }
+    }
+    for (int i = 0; i < osdList.osdtextvec_size(); i++) {
+        if (CheckTextParam(osdList.osdtextvec(i))) {
+            return true;
+        }
+    }
+    for (int i = 0; i < osdList.osdcirclevec_size(); i++) {
+        if (CheckOsdParam(osdList.osdcirclevec(i).osdparams(), true)) {
+            return true;
+        }
+    }
+    for (int i = 0; i < osdList.osdlinevec_size(); i++) {
+        if (CheckOsdParam(osdList.osdlinevec(i).osdparams(), true)) {
+            return true;
+        }
+        if (osdList.osdlinevec(i).osdparams().thickness() < 0) {
+            errorInfo_ << "The thickness of line is [" << osdList.osdlinevec(i).osdparams().thickness()
+                       << "], the value must be positive." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            LogError << errorInfo_.str();
+            return true;
+        }
+    }
+    return false;
+}
+
+APP_ERROR MxpiOpencvOsd::HostProcess(std::shared_ptr<MxpiVisionList> mxpiVisionList,
+    std::shared_ptr<MxpiOsdInstancesList> mxpiOsdInstancesList, std::shared_ptr<MxpiVisionList> mxpiVisionListDest)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < mxpiVisionList->visionvec_size(); i++) {
+        // the merged vision still points to the data of the input, so it is added once the data is its own copy
+        MxpiVision vision;
+        vision.MergeFrom(mxpiVisionList->visionvec(i));
+        APP_ERROR ret = APP_ERR_OK;
+        if (i < mxpiOsdInstancesList->osdinstancesvec_size()) {
+            const MxpiOsdInstances& osdList = mxpiOsdInstancesList->osdinstancesvec(i);
+            if (CheckHostOsdParam(osdList)) {
+                return APP_ERR_COMM_INVALID_PARAM;
+            }
+            ret = HostDrawVision(vision, osdList);
+        } else {
+            ret = HostCopyVision(vision);
+        }
+        if (ret != APP_ERR_OK) {
+            LogError << "Draw osd on host failed." << GetErrorInfo(ret);
+            return ret;
+        }
+        auto visionVec = mxpiVisionListDest->add_visionvec();
+        if (CheckPtrIsNullptr(visionVec, "visionVec")) {
+            if (vision.visiondata().dataptr() != 0) {
+                MxBase::MemoryData data((void*)vision.visiondata().dataptr(), vision.visiondata().datasize(),
+                    MxBase::MemoryData::MEMORY_DVPP, deviceId_);
+                MxBase::MemoryHelper::MxbsFree(data);
+            }
+            return APP_ERR_COMM_ALLOC_MEM;
+        }
+        visionVec->Swap(&vision);
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double costTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    LogDebug << "Opencv OSD using host time: " << costTime << "ms";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiOpencvOsd::HostDrawVision(MxpiVision& vision, const MxpiOsdInstances& osdList)
+{
+    const MxpiVisionInfo& info = vision.visioninfo();
+    const MxpiVisionData& data = vision.visiondata();
+    if (!HostOsdRenderer::IsFormatSupported(info.format())) {
+        errorInfo_ << "The format is [" << info.format() << "], host osd only supports NV12, NV21, RGB and BGR."
+                   << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        LogError << errorInfo_.str();
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    bool isYuv = info.format() == MxBase::MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420 ||
+        info.format() == MxBase::MXBASE_PIXEL_FORMAT_YVU_SEMIPLANAR_420;
+    size_t imageSize = static_cast<size_t>(info.widthaligned()) * info.heightaligned();
+    imageSize = isYuv ? imageSize * YUV420_PLANE_NUM / YUV420_PLANE_DEN : imageSize * PACKED_CHANNEL_NUM;
+    if (data.dataptr() == 0 || imageSize == 0 || data.datasize() < imageSize) {
+        errorInfo_ << "The data size is [" << data.datasize() << "], while the image requires [" << imageSize
+                   << "]." << GetErrorInfo(APP_ERR_SIZE_NOT_MATCH);
+        LogError << errorInfo_.str();
+        return APP_ERR_SIZE_NOT_MATCH;
+    }
+    // the staging buffer is kept across frames, only a larger resolution grows it
+    if (hostBuffer_.size() < imageSize) {
+        hostBuffer_.resize(imageSize);
+    }
+    MxBase::MemoryData hostData(hostBuffer_.data(), imageSize, MxBase::MemoryData::MEMORY_HOST);
+    MxBase::MemoryData srcData((void*)data.dataptr(), imageSize,
+        static_cast<MxBase::MemoryData::MemoryType>(data.memtype()), data.deviceid());
+    APP_ERROR ret = MxBase::MemoryHelper::MxbsMemcpy(hostData, srcData, imageSize);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Failed to copy image to host." << GetErrorInfo(ret);
+        LogError << errorInfo_.str();
+        return ret;
+    }
+    OsdImage image;
+    image.data = hostBuffer_.data();
+    image.width = info.width();
+    image.height = info.height();
+    image.widthStride = info.widthaligned();
+    image.heightStride = info.heightaligned();
+    image.format = info.format();
+    ret = hostRenderer_.Render(osdList, image);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Failed to render osd on host." << GetErrorInfo(ret);
+        LogError << errorInfo_.str();
+        return ret;
+    }
+    MxBase::MemoryData dstData(imageSize, MxBase::MemoryData::MEMORY_DVPP, deviceId_);
+    ret = MxBase::MemoryHelper::MxbsMallocAndCopy(dstData, hostData);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Failed to copy image back to dvpp memory." << GetErrorInfo(ret);
+        LogError << errorInfo_.str();
+        return ret;
+    }
+    SetHostVisionData(vision, dstData);
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiOpencvOsd::HostCopyVision(MxpiVision& vision)
+{
+    const MxpiVisionData& data = vision.visiondata();
+    if (data.dataptr() == 0) {
+        return APP_ERR_OK;
+    }
+    MxBase::MemoryData srcData((void*)data.dataptr(), data.datasize(),
+        static_cast<MxBase::MemoryData::MemoryType>(data.memtype()), data.deviceid());
+    MxBase::MemoryData dstData(data.datasize(), MxBase::MemoryData::MEMORY_DVPP, deviceId_);
+    APP_ERROR ret = MxBase::MemoryHelper::MxbsMallocAndCopy(dstData, srcData);
+    if (ret != APP_ERR_OK) {
+        errorInfo_ << "Failed to copy image without osd to dvpp memory." << GetErrorInfo(ret);
+        LogError << errorInfo_.str();
+        return ret;
+    }
+    SetHostVisionData(vision, dstData);
+    return APP_ERR_OK;
+}
+
+void MxpiOpencvOsd::SetHostVisionData(MxpiVision& vision, const MxBase::MemoryData& data)
+{
+    vision.mutable_visiondata()->set_dataptr((uint64_t)data.ptrData);
+    vision.mutable_visiondata()->set_freefunc((uint64_t)data.free);
+    vision.mutable_visiondata()->set_matptr(0);
+    vision.mutable_visiondata()->set_datasize(data.size);
+    vision.mutable_visiondata()->set_deviceid(deviceId_);
+    vision.mutable_visiondata()->set_memtype(MxTools::MxpiMemoryType::MXPI_MEMORY_DVPP);
+}
+
 APP_ERROR MxpiOpencvOsd::RunSingleOperator(MxBase::OperatorDesc& opDesc)
 {
     APP_ERROR ret = opDesc.MemoryCpy();
@@ -801,7 +997,10 @@ std::vector<std::shared_ptr<void>> MxpiOpencvOsd::DefineProperties()
     auto dataSourceOsd = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
         STRING, "dataSourceOsd", "dataSourceOsd", "dataSource of OSD instances", "auto", "", ""
     });
-    properties = {dataSourceImage, dataSourceOsd};
+    auto osdBackend = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+        STRING, "osdBackend", "osdBackend", "draw on aicpu or on host, aicpu or host", "aicpu", "", ""
+    });
+    properties = {dataSourceImage, dataSourceOsd, osdBackend};
     return properties;
 }
 
@@ -22,6 +22,7 @@
 
 #include "MxPlugins/MxpiQualityDetection/MxpiQualityDetection.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <fstream>
@@ -48,6 +49,11 @@ const int OCCLUSION_LAP_THRES = 10;
 const float INT_TO_FLOAT = 1.0;
 const int POW_AREA = 2;
 const int NUM_2 = 2;
+const uint32_t MIN_ANALYSIS_WIDTH = 64;
+const uint32_t MAX_ANALYSIS_THREAD_NUM = 16;
+const uint32_t ANALYSIS_QUEUE_LEN = 16;
+const uint32_t DROP_LOG_INTERVAL = 100;
+const int BLOCK_NUM = 8;
 
 enum class DetectionType {
     IMAGE_BRIGHTNESS_DETECTION = 0,
@@ -63,6 +69,17 @@ enum class DetectionType {
     VIDEO_FREEZE_DETECTION,
 };
 
+uint32_t DetectionBit(DetectionType type)
+{
+    return 1u << static_cast<uint32_t>(type);
+}
+
+const uint32_t TEMPORAL_DETECTION_MASK = DetectionBit(DetectionType::SCENE_MUTATION_DETECTION) |
+    DetectionBit(DetectionType::PTZ_MOVEMENT_DETECTION) | DetectionBit(DetectionType::VIEW_SHAKE_DETECTION) |
+    DetectionBit(DetectionType::VIDEO_FREEZE_DETECTION);
+const uint32_t HIST_DETECTION_MASK = DetectionBit(DetectionType::IMAGE_BRIGHTNESS_DETECTION) |
+    DetectionBit(DetectionType::BLACK_SCREEN_DETECTION);
+
 int AlignToEven(int num)
 {
     if (num % NUM_2 == 0) {
@@ -75,6 +92,8 @@ int AlignToEven(int num)
 APP_ERROR MxpiQualityDetection::InitParams(void)
 {
     configData_.GetFileValueWarn<uint32_t>("FRAME_LIST_LEN", frameListMaxLen_);
+    configData_.GetFileValueWarn<uint32_t>("ANALYSIS_WIDTH", analysisWidth_);
+    configData_.GetFileValueWarn<uint32_t>("ANALYSIS_THREAD_NUM", analysisThreadNum_);
 
     configData_.GetFileValueWarn<bool>("BRIGHTNESS_SWITCH", switchBrightnessDetection_);
     configData_.GetFileValueWarn<uint32_t>("BRIGHTNESS_FRAME_INTERVAL", frameIntervalBrightnessDetection_);
@@ -147,6 +166,13 @@ APP_ERROR MxpiQualityDetection::CheckImageDectParams(void)
         LogError << errorInfo_.str();
         return APP_ERR_COMM_INVALID_PARAM;
     }
+    if ((analysisWidth_ != 0 && analysisWidth_ < MIN_ANALYSIS_WIDTH) ||
+        analysisThreadNum_ > MAX_ANALYSIS_THREAD_NUM) {
+        errorInfo_ << "Invalid analysis width or analysis thread number, please check it."
+                   << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        LogError << errorInfo_.str();
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
     return APP_ERR_OK;
 }
 
@@ -242,6 +268,11 @@ APP_ERROR MxpiQualityDetection::Init(std::map<std::string, std::shared_ptr<void>
         return ret;
     }
     MapKeyToHandle(); // Initialize detection func map
+    ret = StartWorkers();
+    if (ret != APP_ERR_OK) {
+        LogError << "Failed to start analysis workers." << GetErrorInfo(ret);
+        return ret;
+    }
     LogInfo << "End to initialize MxpiQualityDetection(" << elementName_ << ").";
     return APP_ERR_OK;
 }
@@ -249,41 +280,112 @@ APP_ERROR MxpiQualityDetection::Init(std::map<std::string, std::shared_ptr<void>
 APP_ERROR MxpiQualityDetection::DeInit()
 {
     LogInfo << "Begin to deinitialize MxpiQualityDetection(" << elementName_ << ").";
+    StopWorkers();
+    {
+        std::lock_guard<std::mutex> lock(channelMutex_);
+        channels_.clear();
+    }
     LogInfo << "End to deinitialize MxpiQualityDetection(" << elementName_ << ").";
     return APP_ERR_OK;
 }
 
-bool MxpiQualityDetection::FrameSkip(bool switchDetection, uint32_t frameInterval)
+APP_ERROR MxpiQualityDetection::StartWorkers(void)
 {
-    bool ifSkip = false;
-    if (!switchDetection) {
-        LogDebug << "Switch Off, skip frame " << frameIdVdec_ << ", channel " << channelIdVdec_;
-        ifSkip = true;
-    } else if (frameIdCur_ % frameInterval != 0) {
-        LogDebug << "Invalid Frame Id, skip frame " << frameIdVdec_ << ", channel " << channelIdVdec_;
-        ifSkip = true;
-    }
-    return ifSkip;
+    // 0 keeps the analysis on the streaming thread
+    for (uint32_t i = 0; i < analysisThreadNum_; i++) {
+        taskQueues_.push_back(std::make_shared<BlockingQueue<AnalysisTask>>(ANALYSIS_QUEUE_LEN));
+    }
+    try {
+        for (uint32_t i = 0; i < analysisThreadNum_; i++) {
+            workers_.emplace_back(&MxpiQualityDetection::WorkerThread, this, i);
+        }
+    } catch (const std::exception &ex) {
+        LogError << "Failed to create analysis thread, " << ex.what() << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        StopWorkers();
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageBrightnessDetection(void)
+void MxpiQualityDetection::StopWorkers(void)
 {
-    LogDebug << "Begin to process ImageBrightnessDetection.";
-    if (FrameSkip(switchBrightnessDetection_, frameIntervalBrightnessDetection_)) {
-        return APP_ERR_OK;
+    for (auto &queue : taskQueues_) {
+        queue->Stop();
+    }
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    taskQueues_.clear();
+}
+
+void MxpiQualityDetection::WorkerThread(uint32_t workerId)
+{
+    auto queue = taskQueues_[workerId];
+    while (true) {
+        AnalysisTask task;
+        if (queue->Pop(task) != APP_ERR_OK) {
+            break;
+        }
+        AnalyzeFrame(task);
     }
+}
+
+std::shared_ptr<ChannelState> MxpiQualityDetection::GetChannelState(uint32_t channelId)
+{
+    std::lock_guard<std::mutex> lock(channelMutex_);
+    auto iter = channels_.find(channelId);
+    if (iter != channels_.end()) {
+        return iter->second;
+    }
+    auto channel = std::make_shared<ChannelState>();
+    channel->channelId = channelId;
+    channels_[channelId] = channel;
+    return channel;
+}
+
+bool MxpiQualityDetection::IsTemporalEnabled(void)
+{
+    return switchSceneMutationDetection_ || switchPTZMovementDetection_ || switchViewShakeDetection_ ||
+        switchVideoFreezeDetection_;
+}
+
+uint32_t MxpiQualityDetection::GetDueMask(const ChannelState &channel)
+{
+    // indexed by DetectionType
+    const std::pair<bool, uint32_t> cadences[] = {
+        {switchBrightnessDetection_, frameIntervalBrightnessDetection_},
+        {switchOcclusionDetection_, frameIntervalOcclusionDetection_},
+        {switchBlurDetection_, frameIntervalBlurDetection_},
+        {switchNoiseDetection_, frameIntervalNoiseDetection_},
+        {switchColorCastDetection_, frameIntervalColorCastDetection_},
+        {switchStripeDetection_, frameIntervalStripeDetection_},
+        {switchScreenDetection_, frameIntervalScreenDetection_},
+        {switchSceneMutationDetection_, frameIntervalSceneMutationDetection_},
+        {switchPTZMovementDetection_, frameIntervalPTZMovementDetection_},
+        {switchViewShakeDetection_, frameIntervalViewShakeDetection_},
+        {switchVideoFreezeDetection_, frameIntervalVideoFreezeDetection_},
+    };
+    uint32_t dueMask = 0;
+    for (uint32_t i = 0; i < sizeof(cadences) / sizeof(cadences[0]); i++) {
+        if (cadences[i].first && channel.frameIdCur % cadences[i].second == 0) {
+            dueMask |= (1u << i);
+        }
+    }
+    return dueMask;
+}
+
+APP_ERROR MxpiQualityDetection::ImageBrightnessDetection(ChannelState &channel, const AnalysisFrame &frame)
+{
+    LogDebug << "Begin to process ImageBrightnessDetection.";
     float diffSum = 0;
     float deviation = 0;
     const int brightnessMean = 128;
-    int hist[PIXEL_VALUE_NUM] = { 0 };
-    Mat imgGray;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
-    for (int i = 0; i < imgGray.rows; i++) {
-        for (int j = 0; j < imgGray.cols; j++) {
-            diffSum += float(imgGray.at<uchar>(i, j) - brightnessMean);
-            hist[imgGray.at<uchar>(i, j)]++;
-        }
+    const cv::Mat &imgGray = frame.luma;
+    for (int i = 0; i < PIXEL_VALUE_NUM; i++) {
+        diffSum += float(i - brightnessMean) * frame.hist[i];
     }
     if (IsDenominatorZero(float(imgGray.rows * imgGray.cols))) {
         LogError << "The multiplication of rows and cols must not equal to 0!"
@@ -292,7 +394,7 @@ APP_ERROR MxpiQualityDetection::ImageBrightnessDetection(void)
     }
     float diffAvg = diffSum / float(imgGray.rows * imgGray.cols);
     for (int i = 0; i < PIXEL_VALUE_NUM; i++) {
-        deviation += abs(i - brightnessMean - diffAvg) * hist[i];
+        deviation += abs(i - brightnessMean - diffAvg) * frame.hist[i];
     }
     deviation /= float((imgGray.rows * imgGray.cols));
     if (IsDenominatorZero(deviation)) {
@@ -303,38 +405,36 @@ APP_ERROR MxpiQualityDetection::ImageBrightnessDetection(void)
     if (brightnessFactor > thresholdBrightnessFactor_) {
         if (diffAvg > std::numeric_limits<float>::epsilon()) {
             LogWarn << "Video Lightness Detection: Too bright, Brightness Rate = " << brightnessFactor <<
-                ", Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+                ", Frame ID = " << frame.frameIdVdec << ", Channel ID = " << channel.channelId;
         } else {
             LogWarn << "Video Lightness Detection: Too dark, Brightness Rate = " << brightnessFactor <<
-                ", Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+                ", Frame ID = " << frame.frameIdVdec << ", Channel ID = " << channel.channelId;
         }
     } else {
-        LogDebug << "Video Lightness Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Video Lightness Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ImageBrightnessDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageOcclusionDetection(void)
+APP_ERROR MxpiQualityDetection::ImageOcclusionDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ImageOcclusionDetection.";
-    if (FrameSkip(switchOcclusionDetection_, frameIntervalOcclusionDetection_)) {
+    int coverBlock = 0;
+    const int sumBlock = static_cast<int>(pow(BLOCK_NUM, POW_AREA));
+    const cv::Mat &imgGray = frame.luma;
+    if (imgGray.rows < BLOCK_NUM || imgGray.cols < BLOCK_NUM) {
+        LogDebug << "Image is too small for occlusion detection, Channel ID = " << channel.channelId;
         return APP_ERR_OK;
     }
-    int coverBlock = 0;
-    const int blockNum = 8;
-    const int sumBlock = static_cast<int>(pow(blockNum, POW_AREA));
-    Mat imgGray;
     Mat imgLap;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
     Laplacian(imgGray, imgLap, imgGray.depth());
-    for (int i = 0; i < imgGray.rows / blockNum * blockNum; i += imgGray.rows / blockNum) {
-        for (int j = 0; j < imgGray.cols / blockNum * blockNum; j += imgGray.cols / blockNum) {
+    for (int i = 0; i < imgGray.rows / BLOCK_NUM * BLOCK_NUM; i += imgGray.rows / BLOCK_NUM) {
+        for (int j = 0; j < imgGray.cols / BLOCK_NUM * BLOCK_NUM; j += imgGray.cols / BLOCK_NUM) {
             float sigmaGray = 0;
             float sigmaLap = 0;
-            cv::Rect rec = cv::Rect(j, i, imgGray.cols / blockNum, imgGray.rows / blockNum);
+            cv::Rect rec = cv::Rect(j, i, imgGray.cols / BLOCK_NUM, imgGray.rows / BLOCK_NUM);
             Mat subImgGray = imgGray(rec);
             Mat subImgLap = imgLap(rec);
             Mat means, stdDevGray, stdDevLap;
@@ -352,51 +452,42 @@ APP_ERROR MxpiQualityDetection::ImageOcclusionDetection(void)
     }
     if (coveredRate > thresholdOcclusion_) {
         LogWarn << "Image Occlusion Detection: Occlusion, Covered Rate = " << coveredRate << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "Image Occlusion Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Image Occlusion Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ImageOcclusionDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageBlurDetection(void)
+APP_ERROR MxpiQualityDetection::ImageBlurDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ImageBlurDetection.";
-    if (FrameSkip(switchBlurDetection_, frameIntervalBlurDetection_)) {
-        return APP_ERR_OK;
-    }
-    Mat imgGray;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
+    Mat imgLap;
     Mat meansMat, stdDevGrayMat;
     double stdDevGray = 0;
     int kernelSize = 3;
-    Laplacian(imgGray, imgGray, imgGray.depth(), kernelSize);
-    convertScaleAbs(imgGray, imgGray);
-    meanStdDev(imgGray, meansMat, stdDevGrayMat);
+    Laplacian(frame.luma, imgLap, frame.luma.depth(), kernelSize);
+    convertScaleAbs(imgLap, imgLap);
+    meanStdDev(imgLap, meansMat, stdDevGrayMat);
     stdDevGray = stdDevGrayMat.at<double>(0, 0);
     double var = pow(stdDevGray, POW_AREA);
     if (var < thresholdBlur_) {
-        LogWarn << "Image Blur Detection: Blur, Blur Rate = " << var << ", Frame ID = " << frameIdVdec_ <<
-            ", Channel ID = " << channelIdVdec_;
+        LogWarn << "Image Blur Detection: Blur, Blur Rate = " << var << ", Frame ID = " << frame.frameIdVdec <<
+            ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "Image Blur Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+        LogDebug << "Image Blur Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ImageBlurDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageNoiseDetection(void)
+APP_ERROR MxpiQualityDetection::ImageNoiseDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ImageNoiseDetection.";
-    if (FrameSkip(switchNoiseDetection_, frameIntervalNoiseDetection_)) {
-        return APP_ERR_OK;
-    }
-    Mat imgGray;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
+    const cv::Mat &imgGray = frame.luma;
     const int matRowSize = 3;
     const int matColSize = 3;
     // initialize convolution kernel1 (-1, 0, 1, -2, 0, 2, -1, 0, 1)
@@ -423,16 +514,9 @@ APP_ERROR MxpiQualityDetection::ImageNoiseDetection(void)
     Mat countLocate = imgSpbel1Locate.mul(imgSpbel2Locate).mul(imgSpbel3Locate).mul(imgSpbel4Locate);
     medianBlur(imgGray, imgMBlur, kernSize);
     Mat reduce = abs(imgMBlur - imgGray).mul(countLocate);
-    int noiseNum = 0;
     const int noiseValue = 20;
-    for (int i = 0; i < reduce.rows; i++) {
-        for (int j = 0; j < reduce.cols; j++) {
-            if (reduce.at<uchar>(i, j) > noiseValue) {
-                noiseNum++;
-            }
-        }
-    }
-    APP_ERROR ret = CheckValuePixelSum(pixelSum, noiseNum);
+    int noiseNum = countNonZero(reduce > noiseValue);
+    APP_ERROR ret = CheckValuePixelSum(pixelSum, noiseNum, frame.frameIdVdec, channel.channelId);
     if (ret != APP_ERR_OK) {
         LogError << "The value of pixelSum must not equal to 0!" << GetErrorInfo(ret);
         return ret;
@@ -441,7 +525,8 @@ APP_ERROR MxpiQualityDetection::ImageNoiseDetection(void)
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::CheckValuePixelSum(int pixelSum, int noiseNum)
+APP_ERROR MxpiQualityDetection::CheckValuePixelSum(int pixelSum, int noiseNum, uint32_t frameIdVdec,
+    uint32_t channelId)
 {
     if (IsDenominatorZero(pixelSum)) {
         LogError << "The value of pixelSum must not equal to 0!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
@@ -449,31 +534,23 @@ APP_ERROR MxpiQualityDetection::CheckValuePixelSum(int pixelSum, int noiseNum)
     }
     float noiseRate = noiseNum * INT_TO_FLOAT / pixelSum;
     if (noiseRate > thresholdNoiseRate_) {
-        LogWarn << "Image Noise Detection: Noise, Noise Rate = " << noiseRate << ", Frame ID = " << frameIdVdec_
-            <<", Channel ID = " << channelIdVdec_;
+        LogWarn << "Image Noise Detection: Noise, Noise Rate = " << noiseRate << ", Frame ID = " << frameIdVdec
+            <<", Channel ID = " << channelId;
     } else {
-        LogDebug << "Image Noise Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+        LogDebug << "Image Noise Detection: Normal, Frame ID = " << frameIdVdec << ", Channel ID = " << channelId;
     }
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageColorCastDetection(void)
+APP_ERROR MxpiQualityDetection::ImageColorCastDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ImageColorCastDetection.";
-    if (FrameSkip(switchColorCastDetection_, frameIntervalColorCastDetection_)) {
-        return APP_ERR_OK;
-    }
-    Mat imgRgb = frameList_.back().rgbData;
-    Mat_<Vec3b>::iterator begin = imgRgb.begin<Vec3b>();
-    Mat_<Vec3b>::iterator end = imgRgb.end<Vec3b>();
-    float sumA = 0;
-    float sumB = 0;
+    const cv::Mat &imgRgb = frame.rgb;
     const int idxA = 1;
     const int idxB = 2;
-    for (; begin != end; begin++) {
-        sumA += (*begin)[idxA];
-        sumB += (*begin)[idxB];
-    }
+    cv::Scalar sums = cv::sum(imgRgb);
+    float sumA = static_cast<float>(sums[idxA]);
+    float sumB = static_cast<float>(sums[idxB]);
     int pixelSum = imgRgb.rows * imgRgb.cols;
     const int normValue = 128;
     if (IsDenominatorZero(pixelSum - normValue) || IsDenominatorZero(pixelSum)) {
@@ -484,12 +561,14 @@ APP_ERROR MxpiQualityDetection::ImageColorCastDetection(void)
     double normA = sumA / pixelSum - normValue;
     double normB = sumB / pixelSum - normValue;
     double chrAvg = sqrt(pow(normA, POW_AREA) + pow(normB, POW_AREA));
-    begin = imgRgb.begin<Vec3b>();
     double centerDisA = 0;
     double centerDisB = 0;
-    for (; begin != end; begin++) {
-        centerDisA += abs((*begin)[idxA] - normValue - normA);
-        centerDisB += abs((*begin)[idxB] - normValue - normB);
+    for (int i = 0; i < imgRgb.rows; i++) {
+        const Vec3b *row = imgRgb.ptr<Vec3b>(i);
+        for (int j = 0; j < imgRgb.cols; j++) {
+            centerDisA += abs(row[j][idxA] - normValue - normA);
+            centerDisB += abs(row[j][idxB] - normValue - normB);
+        }
     }
     centerDisA = centerDisA / pixelSum;
     centerDisB = centerDisB / pixelSum;
@@ -497,10 +576,10 @@ APP_ERROR MxpiQualityDetection::ImageColorCastDetection(void)
     float colorCastFactor = static_cast<float>(chrAvg / centerDisAvg);
     if (colorCastFactor >= thresholdcolorCastFactor_) {
         LogWarn << "Image Color Cast Detection: Color Cast, Cast Rate = " << colorCastFactor << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "Image Color Cast Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Image Color Cast Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ImageColorCastDetection.";
     return APP_ERR_OK;
@@ -555,57 +634,40 @@ double MxpiQualityDetection::StripeRateCalculation(const Mat &imgGray)
     return stripeRate;
 }
 
-APP_ERROR MxpiQualityDetection::ImageStripeDetection(void)
+APP_ERROR MxpiQualityDetection::ImageStripeDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ImageStripeDetection.";
-    if (FrameSkip(switchStripeDetection_, frameIntervalStripeDetection_)) {
-        return APP_ERR_OK;
-    }
-    Mat imgGray;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
-
-    double stripeRate = StripeRateCalculation(imgGray);
+    double stripeRate = StripeRateCalculation(frame.luma);
 
+    Mat imgLap;
     Mat meansMat, stdDevGrayMat;
     double stdDevGray = 0;
     const int kernelSize = 3;
     const double varThreshould = 3000;
-    Laplacian(imgGray, imgGray, imgGray.depth(), kernelSize);
-    convertScaleAbs(imgGray, imgGray);
-    meanStdDev(imgGray, meansMat, stdDevGrayMat);
+    Laplacian(frame.luma, imgLap, frame.luma.depth(), kernelSize);
+    convertScaleAbs(imgLap, imgLap);
+    meanStdDev(imgLap, meansMat, stdDevGrayMat);
     stdDevGray = stdDevGrayMat.at<double>(0, 0);
     double var = pow(stdDevGray, POW_AREA);
     if (stripeRate > thresholdStripe_ && var > varThreshould) {
         LogWarn << "Image Stripe Detection：Stripe Noise, Stripe Rate = " << stripeRate << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "Image Stripe Detection：Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Image Stripe Detection：Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ImageStripeDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::BlackScreenDetection(void)
+APP_ERROR MxpiQualityDetection::BlackScreenDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process BlackScreenDetection.";
-    if (FrameSkip(switchScreenDetection_, frameIntervalScreenDetection_)) {
-        return APP_ERR_OK;
-    }
-    Mat imgGray;
-    Mat imgRgb = frameList_.back().rgbData;
-    cvtColor(imgRgb, imgGray, COLOR_RGB2GRAY);
-
-    int pixelSum = imgGray.rows * imgGray.cols;
+    int pixelSum = frame.luma.rows * frame.luma.cols;
     int darkSum = 0;
     const int darknessValue = 20;
-    for (int i = 0; i < imgGray.rows; i++) {
-        for (int j = 0; j < imgGray.cols; j++) {
-            if (imgGray.at<uchar>(i, j) < darknessValue) {
-                darkSum++;
-            }
-        }
+    for (int i = 0; i < darknessValue; i++) {
+        darkSum += frame.hist[i];
     }
     if (IsDenominatorZero(pixelSum)) {
         LogError << "The value of pixelSum must not equal to 0!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
@@ -614,46 +676,36 @@ APP_ERROR MxpiQualityDetection::BlackScreenDetection(void)
     double darkProp = darkSum * INT_TO_FLOAT / pixelSum;
     if (darkProp >= thresholdDarkProp_) {
         LogWarn << "Black Screen Detection: Black screen, Dark Rate = " << darkProp << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "Black Screen Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Black Screen Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process BlackScreenDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::VideoFreezeDetection(void)
+APP_ERROR MxpiQualityDetection::VideoFreezeDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process VideoFreezeDetection.";
-    if (FrameSkip(switchVideoFreezeDetection_, frameIntervalVideoFreezeDetection_)) {
-        return APP_ERR_OK;
-    }
-    FrameInfo image1 = frameList_[frameListMaxLen_ - 1 - frameIntervalVideoFreezeDetection_];
-    FrameInfo image2 = frameList_[frameListMaxLen_ - 1];
-    cv::Mat image1Gray, image2GRAY;
-    cvtColor(image1.rgbData, image1Gray, cv::COLOR_RGB2GRAY);
-    cvtColor(image2.rgbData, image2GRAY, cv::COLOR_RGB2GRAY);
-    int diffPixelNum = 0;
+    const cv::Mat &image1Gray = channel.history[frameListMaxLen_ - 1 - frameIntervalVideoFreezeDetection_]->thumb;
+    const cv::Mat &image2Gray = channel.history[frameListMaxLen_ - 1]->thumb;
     const int pixelDiffValue = 10;
-    for (int i = 0; i < image1Gray.rows; i++) {
-        for (int j = 0; j < image1Gray.cols; j++) {
-            if (abs(image1Gray.at<uchar>(i, j) - image2GRAY.at<uchar>(i, j)) > pixelDiffValue)
-                diffPixelNum++;
-        }
-    }
+    Mat diff;
+    absdiff(image1Gray, image2Gray, diff);
+    int diffPixelNum = countNonZero(diff > pixelDiffValue);
     auto imageRowsCols = image1Gray.rows * image1Gray.cols;
     if (IsDenominatorZero(imageRowsCols)) {
         LogError << "The value of imageRowsCols must not equal to 0!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    float freezeFactor = diffPixelNum * INT_TO_FLOAT / (image1Gray.rows * image1Gray.cols);
+    float freezeFactor = diffPixelNum * INT_TO_FLOAT / imageRowsCols;
     if (freezeFactor > thresholdVideoFreezeDetection_) {
-        LogDebug << "Video Freeze Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Video Freeze Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     } else {
         LogWarn << "Video Freeze Detection: Freeze, Freeze Rate = " << freezeFactor << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     }
     LogDebug << "End to process VideoFreezeDetection.";
     return APP_ERR_OK;
@@ -661,41 +713,29 @@ APP_ERROR MxpiQualityDetection::VideoFreezeDetection(void)
 
 APP_ERROR MxpiQualityDetection::ViewShakeOffsetCal(const Mat &imageGray, vector<int> &sumRowVec, vector<int> &sumColVec)
 {
-    int sumRow, sumCol;
-    float meanRow, meanCol;
-    float sumRC = 0;
-    for (int i = 0; i < imageGray.rows; i++) {
-        sumRow = 0;
-        for (int j = 0; j < imageGray.cols; j++) {
-            sumRow += imageGray.at<uchar>(i, j);
-        }
-        sumRC += sumRow;
-        sumRowVec.push_back(sumRow);
-    }
-    for (int i = 0; i < imageGray.cols; i++) {
-        sumCol = 0;
-        for (int j = 0; j < imageGray.rows; j++) {
-            sumCol += imageGray.at<uchar>(j, i);
-        }
-        sumColVec.push_back(sumCol);
-    }
     if (IsDenominatorZero(imageGray.rows) || IsDenominatorZero(imageGray.cols)) {
         LogError << "ImageGray.rows: " << imageGray.rows << ", imageGray.cols: " << imageGray.cols
                  <<  "must not equal to zero!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    meanRow = sumRC / imageGray.rows;
-    meanCol = sumRC / imageGray.cols;
-    for (size_t i = 0; i < sumRowVec.size(); i++) {
-        sumRowVec[i] = static_cast<int>(sumRowVec[i] - meanRow);
+    Mat sumRow, sumCol;
+    cv::reduce(imageGray, sumRow, 1, REDUCE_SUM, CV_32S);
+    cv::reduce(imageGray, sumCol, 0, REDUCE_SUM, CV_32S);
+    float sumRC = static_cast<float>(cv::sum(sumRow)[0]);
+    float meanRow = sumRC / imageGray.rows;
+    float meanCol = sumRC / imageGray.cols;
+    sumRowVec.resize(imageGray.rows);
+    sumColVec.resize(imageGray.cols);
+    for (int i = 0; i < imageGray.rows; i++) {
+        sumRowVec[i] = static_cast<int>(sumRow.at<int>(i, 0) - meanRow);
     }
-    for (size_t i = 0; i < sumColVec.size(); i++) {
-        sumColVec[i] = static_cast<int>(sumColVec[i] - meanCol);
+    for (int i = 0; i < imageGray.cols; i++) {
+        sumColVec[i] = static_cast<int>(sumCol.at<int>(0, i) - meanCol);
     }
     return APP_ERR_OK;
 }
 
-int MxpiQualityDetection::ViewShakeCalMin(std::vector<int> &sumVecImage1, std::vector<int> &sumVecImage2,
+int MxpiQualityDetection::ViewShakeCalMin(const std::vector<int> &sumVecImage1, const std::vector<int> &sumVecImage2,
     const int searchLen)
 {
     int minCor;
@@ -704,6 +744,10 @@ int MxpiQualityDetection::ViewShakeCalMin(std::vector<int> &sumVecImage1, std::v
     int doubleLen = offsetProduct * searchLen + 1;
     float sumDiff;
     float minDiff = numeric_limits<float>::max();
+    if (static_cast<int>(sumVecImage1.size()) <= offsetProduct * searchLen ||
+        sumVecImage1.size() != sumVecImage2.size()) {
+        return 0;
+    }
     if (static_cast<int>(sumVecImage1.size()) < doubleLen) {
         doubleLen = static_cast<int>(sumVecImage1.size());
     }
@@ -721,74 +765,50 @@ int MxpiQualityDetection::ViewShakeCalMin(std::vector<int> &sumVecImage1, std::v
     return minCor;
 }
 
-APP_ERROR MxpiQualityDetection::ViewShakeDetection(void)
+APP_ERROR MxpiQualityDetection::ViewShakeDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process ViewShakeDetection.";
-    if (FrameSkip(switchViewShakeDetection_, frameIntervalViewShakeDetection_)) {
-        return APP_ERR_OK;
-    }
-    FrameInfo image1 = frameList_[frameListMaxLen_ - 1 - frameIntervalViewShakeDetection_];
-    FrameInfo image2 = frameList_[frameListMaxLen_ - 1];
-    cv::Mat image1Gray, image2Gray;
-    cvtColor(image1.rgbData, image1Gray, cv::COLOR_RGB2GRAY);
-    cvtColor(image2.rgbData, image2Gray, cv::COLOR_RGB2GRAY);
-    vector<int> sumRowVecImage1, sumColVecImage1, sumRowVecImage2, sumColVecImage2;
-    APP_ERROR ret = ViewShakeOffsetCal(image1Gray, sumRowVecImage1, sumColVecImage1);
-    if (ret != APP_ERR_OK) {
-        LogError << "Failed to executed first function of ViewShakeOffsetCal." << GetErrorInfo(ret);
-        return ret;
-    }
-    ret = ViewShakeOffsetCal(image2Gray, sumRowVecImage2, sumColVecImage2);
-    if (ret != APP_ERR_OK) {
-        LogError << "Failed to executed first function of ViewShakeOffsetCal." << GetErrorInfo(ret);
-        return ret;
-    }
-    int searchLen = static_cast<int>(thresholdViewShakeDetection_);
-    int offsetPixelRow = ViewShakeCalMin(sumRowVecImage1, sumRowVecImage2, searchLen);
-    int offsetPixelCol = ViewShakeCalMin(sumColVecImage1, sumColVecImage2, searchLen);
+    const AnalysisFrame &image1 = *channel.history[frameListMaxLen_ - 1 - frameIntervalViewShakeDetection_];
+    const AnalysisFrame &image2 = *channel.history[frameListMaxLen_ - 1];
+    // the profiles are taken at the analysis resolution, so search and report in full resolution pixels
+    int searchLen = std::max(1, static_cast<int>(thresholdViewShakeDetection_ / frame.scale));
+    int offsetPixelRow = static_cast<int>(ViewShakeCalMin(image1.rowProfile, image2.rowProfile, searchLen) *
+        frame.scale);
+    int offsetPixelCol = static_cast<int>(ViewShakeCalMin(image1.colProfile, image2.colProfile, searchLen) *
+        frame.scale);
     if (offsetPixelRow < 0 || offsetPixelRow > thresholdViewShakeDetection_ || offsetPixelCol < 0 ||
         offsetPixelCol > thresholdViewShakeDetection_) {
         LogWarn << "View Shake Detection: Shake, Row Shake Rate = " << offsetPixelRow << ", Col Shake Rate = " <<
-            offsetPixelCol << ", Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            offsetPixelCol << ", Frame ID = " << frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "View Shake Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+        LogDebug << "View Shake Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process ViewShakeDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::SceneMutationDetection(void)
+APP_ERROR MxpiQualityDetection::SceneMutationDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process SceneMutationDetection.";
-    if (FrameSkip(switchSceneMutationDetection_, frameIntervalSceneMutationDetection_)) {
-        return APP_ERR_OK;
-    }
-    FrameInfo image1 = frameList_[frameListMaxLen_ - 1 - frameIntervalSceneMutationDetection_];
-    FrameInfo image2 = frameList_[frameListMaxLen_ - 1];
-    Mat image1Gray, image2Gray;
-    cvtColor(image1.rgbData, image1Gray, cv::COLOR_RGB2GRAY);
-    cvtColor(image2.rgbData, image2Gray, cv::COLOR_RGB2GRAY);
-    int diffSum = 0;
+    const cv::Mat &image1Gray = channel.history[frameListMaxLen_ - 1 - frameIntervalSceneMutationDetection_]->thumb;
+    const cv::Mat &image2Gray = channel.history[frameListMaxLen_ - 1]->thumb;
     const int pixelDiffValue = 50;
     int totalPixelNum = image1Gray.rows * image1Gray.cols;
-    for (int i = 0; i < image1Gray.rows; i++) {
-        for (int j = 0; j < image1Gray.cols; j++) {
-            if (abs(image1Gray.at<uchar>(i, j) - image2Gray.at<uchar>(i, j)) > pixelDiffValue) {
-                diffSum++;
-            }
-        }
-    }
+    Mat diff;
+    absdiff(image1Gray, image2Gray, diff);
+    int diffSum = countNonZero(diff > pixelDiffValue);
     if (IsDenominatorZero(totalPixelNum)) {
         LogError << "The value of totalPixelNum must not equal to 0!" << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
     float diffAvg = diffSum * INT_TO_FLOAT / totalPixelNum;
     if (diffAvg < thresholdSceneMutationDetection_) {
-        LogDebug << "Scene Mutation Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "Scene Mutation Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     } else {
         LogWarn << "Scene Mutation Detection: Mutation, Mutation Rate = " << diffAvg << ", Frame ID = " <<
-            frameIdVdec_ << ", Channel ID = " << channelIdVdec_;
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     }
     LogDebug << "End to process SceneMutationDetection.";
     return APP_ERR_OK;
@@ -810,29 +830,16 @@ float MxpiQualityDetection::PTZMovementHistSim(const Mat &imageGrayAvg1, const M
     return histSimilarity;
 }
 
-APP_ERROR MxpiQualityDetection::PTZMovementDetection(void)
+APP_ERROR MxpiQualityDetection::PTZMovementDetection(ChannelState &channel, const AnalysisFrame &frame)
 {
     LogDebug << "Begin to process PTZMovementDetection.";
-    if (FrameSkip(switchPTZMovementDetection_, frameIntervalPTZMovementDetection_)) {
+    if (!channel.ptzSumValid) {
         return APP_ERR_OK;
     }
-    FrameInfo image = frameList_[frameListMaxLen_ - 1];
-    Mat imageGray;
-    cvtColor(image.rgbData, imageGray, cv::COLOR_RGB2GRAY);
     const uint32_t defaultScalarValue = 255;
-    Mat imageGraySum1(imageGray.rows, imageGray.cols, CV_32FC1, Scalar(defaultScalarValue));
-    Mat imageGraySum2(imageGray.rows, imageGray.cols, CV_32FC1, Scalar(defaultScalarValue));
     const uint32_t medianDivisor = 2;
     uint32_t startFrameIdx = frameListMaxLen_ - frameIntervalPTZMovementDetection_ - 1;
     uint32_t midFrameIdx = startFrameIdx + (frameIntervalPTZMovementDetection_ / medianDivisor);
-    for (size_t i = startFrameIdx; i < midFrameIdx; i++) {
-        cvtColor(frameList_[i].rgbData, imageGray, cv::COLOR_RGB2GRAY);
-        accumulate(imageGray, imageGraySum1);
-    }
-    for (size_t j = midFrameIdx; j < frameListMaxLen_; j++) {
-        cvtColor(frameList_[j].rgbData, imageGray, cv::COLOR_RGB2GRAY);
-        accumulate(imageGray, imageGraySum2);
-    }
     auto frameIdxDifference = midFrameIdx - startFrameIdx;
     auto listMaxLenIdxDifference = frameListMaxLen_ - midFrameIdx;
     if (IsDenominatorZero(frameIdxDifference) || IsDenominatorZero(listMaxLenIdxDifference)) {
@@ -840,85 +847,224 @@ APP_ERROR MxpiQualityDetection::PTZMovementDetection(void)
                  << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
-    imageGraySum1 /= frameIdxDifference;
-    imageGraySum2 /= listMaxLenIdxDifference;
+    // the sums start from the default scalar value, the same as the accumulators used before
     Mat imageGrayAvg1, imageGrayAvg2;
-    imageGraySum1.convertTo(imageGrayAvg1, CV_8UC1, 1, 0);
-    imageGraySum2.convertTo(imageGrayAvg2, CV_8UC1, 1, 0);
+    channel.ptzHeadSum.convertTo(imageGrayAvg1, CV_8UC1, 1.0 / frameIdxDifference,
+        static_cast<double>(defaultScalarValue) / frameIdxDifference);
+    channel.ptzTailSum.convertTo(imageGrayAvg2, CV_8UC1, 1.0 / listMaxLenIdxDifference,
+        static_cast<double>(defaultScalarValue) / listMaxLenIdxDifference);
     float simHist = PTZMovementHistSim(imageGrayAvg1, imageGrayAvg2);
     if (simHist > thresholdPTZMovementDetection_) {
-        LogWarn << "PTZ Movement Detection: Abnormal, Movement Rate = " << simHist << ", Frame ID = " << frameIdVdec_ <<
-            ", Channel ID = " << channelIdVdec_;
+        LogWarn << "PTZ Movement Detection: Abnormal, Movement Rate = " << simHist << ", Frame ID = " <<
+            frame.frameIdVdec << ", Channel ID = " << channel.channelId;
     } else {
-        LogDebug << "PTZ Movement Detection: Normal, Frame ID = " << frameIdVdec_ << ", Channel ID = " <<
-            channelIdVdec_;
+        LogDebug << "PTZ Movement Detection: Normal, Frame ID = " << frame.frameIdVdec << ", Channel ID = " <<
+            channel.channelId;
     }
     LogDebug << "End to process PTZMovementDetection.";
     return APP_ERR_OK;
 }
 
-APP_ERROR MxpiQualityDetection::ImageFormatConversion(MxpiVision visionItem)
+APP_ERROR MxpiQualityDetection::CopyFramePlanes(const MxpiVision &visionItem, AnalysisFrame &frame)
 {
-    MxpiVisionInfo visionItemInfo = visionItem.visioninfo();
-    MxpiVisionData visionItemData = visionItem.visiondata();
-
-    auto inputData = visionItemData.dataptr();
-    auto dataSize = (uint32_t)visionItemData.datasize();
-    uint32_t dstImageWidth = visionItemInfo.widthaligned();
-    uint32_t dstImageHeigh = visionItemInfo.heightaligned();
-    uint32_t srcImageWidth = dstImageWidth;
-    uint32_t srcImageHeigh = static_cast<uint32_t>(dstImageHeigh * NV12_COEF);
-
-    MemoryData dataDevice((void *)inputData, dataSize, MxBase::MemoryData::MEMORY_DEVICE);
-    MemoryData dataHost(dataSize, MxBase::MemoryData::MEMORY_HOST);
-
-    APP_ERROR ret = MemoryHelper::MxbsMallocAndCopy(dataHost, dataDevice);
-    if (ret != APP_ERR_OK) {
-        errorInfo_ << "Failed to create destination memory, type(" << dataHost.type
-                   << "), size(" << dataHost.size << ")." << GetErrorInfo(ret);
+    const MxpiVisionInfo &visionItemInfo = visionItem.visioninfo();
+    const MxpiVisionData &visionItemData = visionItem.visiondata();
+    uint32_t widthAligned = visionItemInfo.widthaligned();
+    uint32_t heightAligned = visionItemInfo.heightaligned();
+    uint32_t width = visionItemInfo.width();
+    uint32_t height = visionItemInfo.height();
+    if (width == 0 || width > widthAligned || height == 0 || height > heightAligned) {
+        width = widthAligned;
+        height = heightAligned;
+    }
+    // only the luma plane is needed unless the color cast detection is due
+    bool needChroma = (frame.dueMask & DetectionBit(DetectionType::IMAGE_COLOR_CAST_DETECTION)) != 0;
+    uint32_t planeRows = needChroma ? static_cast<uint32_t>(heightAligned * NV12_COEF) : heightAligned;
+    size_t copySize = static_cast<size_t>(widthAligned) * planeRows;
+    if (widthAligned == 0 || heightAligned == 0 || copySize > static_cast<size_t>(visionItemData.datasize())) {
+        errorInfo_ << "Invalid image size, width aligned(" << widthAligned << "), height aligned(" << heightAligned
+                   << "), data size(" << visionItemData.datasize() << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         LogError << errorInfo_.str();
-        return ret;
+        return APP_ERR_COMM_INVALID_PARAM;
     }
-
-    Mat srcNV12Mat(srcImageHeigh, srcImageWidth, CV_8UC1, dataHost.ptrData);
-    Mat dstRGB888(dstImageHeigh, dstImageWidth, CV_8UC3);
-    cvtColor(srcNV12Mat, dstRGB888, COLOR_YUV2RGB_NV12); // COLOR_YUV2RGB_NV12
-    ret = MxBase::MemoryHelper::MxbsFree(dataHost);
+    Mat planes(planeRows, widthAligned, CV_8UC1);
+    MemoryData dataDevice((void *)visionItemData.dataptr(), copySize, MxBase::MemoryData::MEMORY_DEVICE);
+    MemoryData dataHost((void *)planes.data, copySize, MxBase::MemoryData::MEMORY_HOST);
+    APP_ERROR ret = MemoryHelper::MxbsMemcpy(dataHost, dataDevice, copySize);
     if (ret != APP_ERR_OK) {
-        errorInfo_ << "Fail to free host memory." << GetErrorInfo(ret);
+        errorInfo_ << "Failed to copy image planes to host, size(" << copySize << ")." << GetErrorInfo(ret);
         LogError << errorInfo_.str();
         return ret;
     }
+    frame.fullLuma = planes(cv::Rect(0, 0, width, height));
+    if (needChroma) {
+        Mat chroma = planes.rowRange(heightAligned, planeRows).reshape(NUM_2);
+        frame.fullChroma = chroma(cv::Rect(0, 0, width / NUM_2, height / NUM_2));
+    }
+    return APP_ERR_OK;
+}
 
-    if (frameList_.size() >= frameListMaxLen_) {
-        frameList_.pop_front();
+void MxpiQualityDetection::BuildPyramid(AnalysisFrame &frame)
+{
+    const Mat &fullLuma = frame.fullLuma;
+    if (analysisWidth_ == 0 || fullLuma.cols <= static_cast<int>(analysisWidth_)) {
+        frame.luma = fullLuma;
+        frame.scale = 1.f;
+    } else {
+        frame.scale = static_cast<float>(fullLuma.cols) / analysisWidth_;
+        int analysisHeight = std::max(1, static_cast<int>(std::round(fullLuma.rows / frame.scale)));
+        resize(fullLuma, frame.luma, Size(analysisWidth_, analysisHeight), 0, 0, INTER_AREA);
+    }
+    if (IsTemporalEnabled()) {
+        pyrDown(frame.luma, frame.thumb);
+    }
+    if (frame.dueMask & HIST_DETECTION_MASK) {
+        frame.hist.assign(PIXEL_VALUE_NUM, 0);
+        for (int i = 0; i < frame.luma.rows; i++) {
+            const uchar *row = frame.luma.ptr<uchar>(i);
+            for (int j = 0; j < frame.luma.cols; j++) {
+                frame.hist[row[j]]++;
+            }
+        }
+    }
+    if (switchViewShakeDetection_) {
+        ViewShakeOffsetCal(frame.luma, frame.rowProfile, frame.colProfile);
     }
-    FrameInfo imageInfo = { frameIdCur_, frameIdVdec_, channelIdVdec_, dstRGB888 };
-    frameList_.push_back(imageInfo);
+    if (!frame.fullChroma.empty()) {
+        Size chromaSize(frame.luma.cols / NUM_2, frame.luma.rows / NUM_2);
+        Mat chroma;
+        resize(frame.fullChroma, chroma, chromaSize, 0, 0, INTER_AREA);
+        Mat luma = frame.luma(cv::Rect(0, 0, chromaSize.width * NUM_2, chromaSize.height * NUM_2));
+        cvtColorTwoPlane(luma, chroma, frame.rgb, COLOR_YUV2RGB_NV12);
+    }
+    frame.fullLuma.release();
+    frame.fullChroma.release();
+}
 
-    return APP_ERR_OK;
+void MxpiQualityDetection::UpdateHistory(ChannelState &channel, const std::shared_ptr<AnalysisFrame> &frame)
+{
+    auto &history = channel.history;
+    if (!history.empty() && history.back()->thumb.size() != frame->thumb.size()) {
+        LogInfo << "Resolution changed, reset the history of channel " << channel.channelId << ".";
+        history.clear();
+        channel.ptzSumValid = false;
+    }
+    const uint32_t medianDivisor = 2;
+    uint32_t startFrameIdx = frameListMaxLen_ - frameIntervalPTZMovementDetection_ - 1;
+    uint32_t midFrameIdx = startFrameIdx + (frameIntervalPTZMovementDetection_ / medianDivisor);
+    if (switchPTZMovementDetection_ && channel.ptzSumValid) {
+        // slide both halves of the window by one frame instead of summing the whole window again
+        subtract(channel.ptzHeadSum, history[startFrameIdx]->thumb, channel.ptzHeadSum, noArray(), CV_32F);
+        accumulate(history[midFrameIdx]->thumb, channel.ptzHeadSum);
+        subtract(channel.ptzTailSum, history[midFrameIdx]->thumb, channel.ptzTailSum, noArray(), CV_32F);
+        accumulate(frame->thumb, channel.ptzTailSum);
+    }
+    history.push_back(frame);
+    if (history.size() > frameListMaxLen_) {
+        history.pop_front();
+    }
+    if (switchPTZMovementDetection_ && !channel.ptzSumValid && history.size() == frameListMaxLen_) {
+        channel.ptzHeadSum = Mat::zeros(frame->thumb.size(), CV_32FC1);
+        channel.ptzTailSum = Mat::zeros(frame->thumb.size(), CV_32FC1);
+        for (uint32_t i = startFrameIdx; i < midFrameIdx; i++) {
+            accumulate(history[i]->thumb, channel.ptzHeadSum);
+        }
+        for (uint32_t i = midFrameIdx; i < frameListMaxLen_; i++) {
+            accumulate(history[i]->thumb, channel.ptzTailSum);
+        }
+        channel.ptzSumValid = true;
+    }
 }
 
+void MxpiQualityDetection::AnalyzeFrame(AnalysisTask &task)
+{
+    AnalysisFrame &frame = *task.frame;
+    BuildPyramid(frame);
+    if (IsTemporalEnabled()) {
+        if (task.resetHistory && !task.channel->history.empty()) {
+            LogDebug << "Frames were dropped, reset the history of channel " << task.channel->channelId << ".";
+            task.channel->history.clear();
+            task.channel->ptzSumValid = false;
+        }
+        UpdateHistory(*task.channel, task.frame);
+    }
+    APP_ERROR ret = DetectionProcess(*task.channel, frame);
+    if (ret != APP_ERR_OK) {
+        LogError << "Failed to finish detection process, Channel ID = " << task.channel->channelId << "."
+                 << GetErrorInfo(ret);
+    }
+    // only the thumbnail and the profiles stay in the history
+    frame.luma.release();
+    frame.rgb.release();
+    frame.hist.clear();
+}
 
-APP_ERROR MxpiQualityDetection::DetectionProcess(void)
+APP_ERROR MxpiQualityDetection::ImageFormatConversion(const MxpiVision &visionItem, uint32_t frameIdVdec,
+    uint32_t channelId)
 {
-    if (frameList_.size() < frameListMaxLen_) {
-        LogInfo << "The list size of frameList_ is less than " << frameListMaxLen_ << ", Channel ID = " <<
-            channelIdVdec_;
+    auto channel = GetChannelState(channelId);
+    auto frame = std::make_shared<AnalysisFrame>();
+    frame->frameIdVdec = frameIdVdec;
+    frame->dueMask = GetDueMask(*channel);
+    channel->frameIdCur++;
+    // the temporal detections need every frame in the history, the others only the frames they are due on
+    if (frame->dueMask == 0 && !IsTemporalEnabled()) {
         return APP_ERR_OK;
     }
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_BRIGHTNESS_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_OCCLUSION_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_BLUR_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_NOISE_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_COLOR_CAST_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::IMAGE_STRIPE_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::BLACK_SCREEN_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::SCENE_MUTATION_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::PTZ_MOVEMENT_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::VIEW_SHAKE_DETECTION));
-    DetectionWithKey(static_cast<int>(DetectionType::VIDEO_FREEZE_DETECTION));
+    APP_ERROR ret = CopyFramePlanes(visionItem, *frame);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    AnalysisTask task = {channel, frame};
+    if (taskQueues_.empty()) {
+        AnalyzeFrame(task);
+        return APP_ERR_OK;
+    }
+    DispatchTask(task);
+    return APP_ERR_OK;
+}
+
+void MxpiQualityDetection::DispatchTask(AnalysisTask &task)
+{
+    ChannelState &channel = *task.channel;
+    // the temporal detections compare consecutive frames, so they restart after a gap instead of reading across it
+    task.resetHistory = channel.dropPending;
+    // one channel always goes to the same worker to keep its frames in order
+    auto &queue = taskQueues_[channel.channelId % taskQueues_.size()];
+    if (queue->Push(task) == APP_ERR_OK) {
+        channel.dropPending = false;
+        return;
+    }
+    channel.dropPending = true;
+    droppedTaskCount_++;
+    if (droppedTaskCount_ % DROP_LOG_INTERVAL == 1) {
+        LogWarn << "Analysis is slower than the stream, " << droppedTaskCount_ << " frames are not analyzed, "
+                << "please raise ANALYSIS_THREAD_NUM or the frame intervals. Element(" << elementName_ << ").";
+    }
+}
 
+APP_ERROR MxpiQualityDetection::DetectionProcess(ChannelState &channel, const AnalysisFrame &frame)
+{
+    const DetectionType detectionOrder[] = {
+        DetectionType::IMAGE_BRIGHTNESS_DETECTION, DetectionType::IMAGE_OCCLUSION_DETECTION,
+        DetectionType::IMAGE_BLUR_DETECTION, DetectionType::IMAGE_NOISE_DETECTION,
+        DetectionType::IMAGE_COLOR_CAST_DETECTION, DetectionType::IMAGE_STRIPE_DETECTION,
+        DetectionType::BLACK_SCREEN_DETECTION, DetectionType::SCENE_MUTATION_DETECTION,
+        DetectionType::PTZ_MOVEMENT_DETECTION, DetectionType::VIEW_SHAKE_DETECTION,
+        DetectionType::VIDEO_FREEZE_DETECTION,
+    };
+    bool historyReady = channel.history.size() >= frameListMaxLen_;
+    if ((frame.dueMask & TEMPORAL_DETECTION_MASK) && !historyReady) {
+        LogDebug << "The history size of channel is less than " << frameListMaxLen_ << ", Channel ID = " <<
+            channel.channelId;
+    }
+    for (auto type : detectionOrder) {
+        uint32_t bit = DetectionBit(type);
+        if ((frame.dueMask & bit) == 0 || ((bit & TEMPORAL_DETECTION_MASK) && !historyReady)) {
+            continue;
+        }
+        DetectionWithKey(static_cast<int>(type), channel, frame);
+    }
     return APP_ERR_OK;
 }
 
@@ -950,23 +1096,16 @@ APP_ERROR MxpiQualityDetection::ImageProcessAndDetection(MxpiBuffer &buffer)
         return APP_ERR_COMM_FAILURE;
     }
     shared_ptr<MxpiFrameInfo> mxpiFrameInfo = static_pointer_cast<MxpiFrameInfo>(metadataFrameInfo);
-    frameIdVdec_ = mxpiFrameInfo->frameid();
-    channelIdVdec_ = mxpiFrameInfo->channelid();
+    uint32_t frameIdVdec = mxpiFrameInfo->frameid();
+    uint32_t channelIdVdec = mxpiFrameInfo->channelid();
     shared_ptr<MxpiVisionList> mxpiVisionList = static_pointer_cast<MxpiVisionList>(metadata);
 
     for (int i = 0; i < mxpiVisionList->visionvec_size(); i++) {
-        MxpiVision visionItem = mxpiVisionList->visionvec(i);
-        ret = ImageFormatConversion(visionItem);
+        ret = ImageFormatConversion(mxpiVisionList->visionvec(i), frameIdVdec, channelIdVdec);
         if (ret != APP_ERR_OK) {
             LogError << errorInfo_.str() << GetErrorInfo(ret);
             return ret;
         }
-        ret = DetectionProcess();
-        if (ret != APP_ERR_OK) {
-            errorInfo_ << "Failed to finish detection process." << GetErrorInfo(ret);
-            return APP_ERR_COMM_FAILURE;
-        }
-        frameIdCur_++;
     }
     return ret;
 }
@@ -1026,12 +1165,13 @@ MxpiPortInfo MxpiQualityDetection::DefineOutputPorts()
     return outputPortInfo;
 }
 
-APP_ERROR MxpiQualityDetection::DetectionWithKey(int detectionType)
+APP_ERROR MxpiQualityDetection::DetectionWithKey(int detectionType, ChannelState &channel,
+    const AnalysisFrame &frame)
 {
     using detectionMap = map<int, DoDetection>::const_iterator;
     detectionMap iter = keyToHandle.find(detectionType);
     DoDetection detectionFunc = iter->second;
-    return (this->*detectionFunc)();
+    return (this->*detectionFunc)(channel, frame);
 }
 
 void MxpiQualityDetection::MapKeyToHandle(void)
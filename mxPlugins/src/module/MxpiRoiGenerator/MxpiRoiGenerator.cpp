@@ -105,6 +105,17 @@ APP_ERROR CheckCropRoiAndMergeRoi(std::vector<MxBase::CropRoiBox> &cropRoiVec,
     return APP_ERR_OK;
 }
 
+bool IsHit(const MxBase::CropRoiBox &block, const MxpiObjectList &hintList, float margin)
+{
+    for (const auto &hint : hintList.objectvec()) {
+        if (hint.x0() - margin < block.x1 && hint.x1() + margin > block.x0 &&
+            hint.y0() - margin < block.y1 && hint.y1() + margin > block.y0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 MxpiObjectList RoiVecToObjectList(std::vector<MxBase::CropRoiBox> &roiVec)
 {
     MxpiObjectList mxpiObjectList;
@@ -223,6 +234,18 @@ APP_ERROR MxpiRoiGenerator::Init(std::map<std::string, std::shared_ptr<void>> &c
         return ret;
     }
 
+    std::vector<std::string> hintNamesPtr = {"dataSourceHint", "hintMargin"};
+    ret = CheckConfigParamMapIsValid(hintNamesPtr, configParamMap);
+    if (ret != APP_ERR_OK) {
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    hintDataSource_ = *std::static_pointer_cast<std::string>(configParamMap["dataSourceHint"]);
+    hintMargin_ = *std::static_pointer_cast<int>(configParamMap["hintMargin"]);
+    if (!hintDataSource_.empty()) {
+        LogInfo << "element(" << elementName_ << ") skips the blocks without objects of (" << hintDataSource_
+                << "), hintMargin(" << hintMargin_ << ").";
+    }
     overlapHeight_ = *std::static_pointer_cast<int>(configParamMap["overlapHeight"]);
     overlapWidth_ = *std::static_pointer_cast<int>(configParamMap["overlapWidth"]);
     std::string splitType = (*std::static_pointer_cast<std::string>(configParamMap["splitType"]));
@@ -350,6 +373,48 @@ APP_ERROR MxpiRoiGenerator::CheckRoiWithImageSize()
     return APP_ERR_OK;
 }
 
+void MxpiRoiGenerator::SkipEmptyBlocks(MxpiBuffer &buffer, std::vector<MxBase::CropRoiBox> &cropRoiVec,
+    std::vector<MxBase::CropRoiBox> &mergeRoiVec)
+{
+    if (hintDataSource_.empty()) {
+        return;
+    }
+    MxpiMetadataManager manager(buffer);
+    auto hintMetadata = manager.GetMetadataWithType(hintDataSource_, "MxpiObjectList");
+    if (hintMetadata == nullptr) {
+        LogDebug << "element(" << elementName_ << ") no hint objects of (" << hintDataSource_
+                 << "), all the blocks are kept.";
+        return;
+    }
+    auto hintList = std::static_pointer_cast<MxpiObjectList>(hintMetadata);
+    std::vector<size_t> hitBlocks;
+    for (size_t i = 0; i < cropRoiVec.size(); i++) {
+        if (IsHit(cropRoiVec[i], *hintList, static_cast<float>(hintMargin_))) {
+            hitBlocks.push_back(i);
+        }
+    }
+    // the hint pass may miss objects, an empty roi list would drop the whole frame downstream
+    if (hitBlocks.empty()) {
+        LogDebug << "element(" << elementName_ << ") no block overlaps the hint objects of (" << hintDataSource_
+                 << "), all the blocks are kept.";
+        return;
+    }
+    // the kept blocks are renumbered, crop and merge lists stay parallel
+    size_t keepNum = 0;
+    for (size_t i : hitBlocks) {
+        cropRoiVec[keepNum] = cropRoiVec[i];
+        if (i < mergeRoiVec.size()) {
+            mergeRoiVec[keepNum] = mergeRoiVec[i];
+        }
+        keepNum++;
+    }
+    LogDebug << "element(" << elementName_ << ") keeps " << keepNum << " of " << cropRoiVec.size() << " blocks.";
+    cropRoiVec.resize(keepNum);
+    if (!mergeRoiVec.empty()) {
+        mergeRoiVec.resize(keepNum);
+    }
+}
+
 APP_ERROR MxpiRoiGenerator::CustomProcess(std::vector<MxpiBuffer*> &mxpiBuffer)
 {
     MxpiBuffer* buffer = mxpiBuffer[0];
@@ -368,8 +433,11 @@ APP_ERROR MxpiRoiGenerator::CustomProcess(std::vector<MxpiBuffer*> &mxpiBuffer)
         return ret;
     }
     // set the MxpiObjectList for image crop and merge.
-    MxpiObjectList cropObjectList = RoiVecToObjectList(cropRoiVec_);
-    MxpiObjectList mergeObjectList = RoiVecToObjectList(mergeRoiVec_);
+    std::vector<MxBase::CropRoiBox> cropRoiVec = cropRoiVec_;
+    std::vector<MxBase::CropRoiBox> mergeRoiVec = mergeRoiVec_;
+    SkipEmptyBlocks(*buffer, cropRoiVec, mergeRoiVec);
+    MxpiObjectList cropObjectList = RoiVecToObjectList(cropRoiVec);
+    MxpiObjectList mergeObjectList = RoiVecToObjectList(mergeRoiVec);
     // Add Proto Metadata and Send Buff.
     ret = AddMetadataAndSendBuff(*buffer, cropObjectList, mergeObjectList);
     if (ret != APP_ERR_OK) {
@@ -416,6 +484,7 @@ APP_ERROR MxpiRoiGenerator::Process(std::vector<MxpiBuffer*> &mxpiBuffer)
         SendMxpiErrorInfo(*buffer, elementName_, ret, errorInfo_.str());
         return ret;
     }
+    SkipEmptyBlocks(*buffer, cropRoiVec, mergeRoiVec);
     // set the MxpiObjectList for image crop and merge.
     MxpiObjectList cropObjectList = RoiVecToObjectList(cropRoiVec);
     MxpiObjectList mergeObjectList = RoiVecToObjectList(mergeRoiVec);
@@ -478,9 +547,16 @@ std::vector<std::shared_ptr<void>> MxpiRoiGenerator::DefineProperties()
     auto merge_roi = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
             STRING, "mergeRoi", "merge_roi", "the crop roi for user defined", "", "", ""
     });
+    auto data_source_hint = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+            STRING, "dataSourceHint", "data_source_hint",
+            "objects of a low resolution pass, blocks without them are skipped unless no block has any", "", "", ""
+    });
+    auto hint_margin = std::make_shared<ElementProperty<int>>(ElementProperty<int> {
+        INT, "hintMargin", "hint_margin", "the margin added around the hint objects", 0, 0, 8192
+    });
     std::vector<std::shared_ptr<void>> properties = {
         block_height, block_width, overlap_height, overlap_width,
-        chessboard_height, chessboard_width, split_type, crop_roi, merge_roi
+        chessboard_height, chessboard_width, split_type, crop_roi, merge_roi, data_source_hint, hint_margin
     };
     return properties;
 }
@@ -0,0 +1,120 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Adaptive skip ratio controller shared by the MxpiSkipFrame instances of a group.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxPlugins/MxpiSkipFrame/AdaptiveSkipController.h"
+
+namespace {
+// below this fraction of the target latency the pipeline is considered relaxed
+const float RELAX_LATENCY_RATIO = 0.5f;
+// beyond this multiple of the target latency every channel sheds load regardless of its lag
+const float CRITICAL_LATENCY_RATIO = 2.0f;
+const float FULL_FILL_RATIO = 1.0f;
+}
+
+namespace MxPlugins {
+AdaptiveSkipController& AdaptiveSkipController::GetInstance()
+{
+    static AdaptiveSkipController controller;
+    return controller;
+}
+
+void AdaptiveSkipController::Register(const std::string& group, const std::string& channel, uint32_t skipNum)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    ChannelState& state = groups_[group][channel];
+    state.skipNum = skipNum;
+    state.lag = 0.f;
+}
+
+void AdaptiveSkipController::Unregister(const std::string& group, const std::string& channel)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto iter = groups_.find(group);
+    if (iter == groups_.end()) {
+        return;
+    }
+    iter->second.erase(channel);
+    if (iter->second.empty()) {
+        groups_.erase(iter);
+    }
+}
+
+float AdaptiveSkipController::GetGroupMeanLag(const std::map<std::string, ChannelState>& channels) const
+{
+    if (channels.empty()) {
+        return 0.f;
+    }
+    float sum = 0.f;
+    for (const auto& channel : channels) {
+        sum += channel.second.lag;
+    }
+    return sum / static_cast<float>(channels.size());
+}
+
+uint32_t AdaptiveSkipController::Adjust(const std::string& group, const std::string& channel,
+                                        const AdaptiveSkipConfig& config, const AdaptiveSkipSample& sample)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto& channels = groups_[group];
+    ChannelState& state = channels[channel];
+    state.lag = sample.latency;
+    float meanLag = GetGroupMeanLag(channels);
+
+    bool latencyExceeded = config.targetLatency > 0.f && sample.latency > config.targetLatency;
+    bool overloaded = sample.fillRatio >= config.highWaterMark || latencyExceeded;
+    bool critical = sample.fillRatio >= FULL_FILL_RATIO ||
+        (config.targetLatency > 0.f && sample.latency > config.targetLatency * CRITICAL_LATENCY_RATIO);
+    bool relaxed = sample.fillRatio <= config.lowWaterMark &&
+        (config.targetLatency <= 0.f || sample.latency <= config.targetLatency * RELAX_LATENCY_RATIO);
+
+    if (overloaded && (critical || state.lag >= meanLag)) {
+        if (state.skipNum < config.maxSkipNum) {
+            state.skipNum++;
+        }
+    } else if (relaxed && state.lag <= meanLag) {
+        if (state.skipNum > config.minSkipNum) {
+            state.skipNum--;
+        }
+    }
+    // keep the result inside the configured range even when the range changed at runtime
+    if (state.skipNum < config.minSkipNum) {
+        state.skipNum = config.minSkipNum;
+    } else if (state.skipNum > config.maxSkipNum && config.maxSkipNum >= config.minSkipNum) {
+        state.skipNum = config.maxSkipNum;
+    }
+    return state.skipNum;
+}
+
+float AdaptiveSkipController::GetSkipRatio(const std::string& group, const std::string& channel)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto groupIter = groups_.find(group);
+    if (groupIter == groups_.end()) {
+        return 0.f;
+    }
+    auto iter = groupIter->second.find(channel);
+    if (iter == groupIter->second.end()) {
+        return 0.f;
+    }
+    return static_cast<float>(iter->second.skipNum) / static_cast<float>(iter->second.skipNum + 1);
+}
+}
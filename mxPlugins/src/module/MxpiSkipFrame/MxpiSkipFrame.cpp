@@ -21,13 +21,27 @@
  */
 
 #include "MxPlugins/MxpiSkipFrame/MxpiSkipFrame.h"
+#include <algorithm>
+#include <sys/time.h>
+#include <nlohmann/json.hpp>
 #include "MxBase/Log/Log.h"
 #include "MxPlugins/MxpiPluginsUtils/MxpiPluginsUtils.h"
+#include "MxBase/Utils/StringUtils.h"
+#include "MxTools/PluginToolkit/PerformanceStatistics/PerformanceStatisticsLog.h"
+#include "MxTools/PluginToolkit/PerformanceStatistics/PerformanceStatisticsManager.h"
 
 using namespace MxBase;
 using namespace MxTools;
 using namespace MxPlugins;
 
+namespace {
+const std::string SKIP_MODE_FIXED = "fixed";
+const std::string SKIP_MODE_ADAPTIVE = "adaptive";
+const std::string FRAME_INFO_KEY = "ReservedFrameInfo";
+const float PERCENT = 100.f;
+const float NSEC_PER_MSEC = 1000000.f;
+}
+
 APP_ERROR MxpiSkipFrame::Init(std::map<std::string, std::shared_ptr<void>> &configParamMap)
 {
     LogInfo << "Begin to initialize MxpiSkipFrame(" << pluginName_ << ").";
@@ -39,6 +53,11 @@ APP_ERROR MxpiSkipFrame::Init(std::map<std::string, std::shared_ptr<void>> &conf
         LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
         return ret;
     }
+    ret = InitAdaptiveProps();
+    if (ret != APP_ERR_OK) {
+        LogError << "Init adaptive properties failed." << GetErrorInfo(ret);
+        return ret;
+    }
     LogInfo << "skip frame nunmber(" << skipFrameNum_ << ").";
     LogInfo << "End to initialize MxpiSkipFrame(" << pluginName_ << ").";
     return APP_ERR_OK;
@@ -46,19 +65,161 @@ APP_ERROR MxpiSkipFrame::Init(std::map<std::string, std::shared_ptr<void>> &conf
 
 APP_ERROR MxpiSkipFrame::InitAndRefreshProps()
 {
-    std::vector<std::string> parameterNamesPtr = {"frameNum"};
+    std::vector<std::string> parameterNamesPtr = {"frameNum", "keyFrameInterval"};
     auto ret = CheckConfigParamMapIsValid(parameterNamesPtr, *configParamMap_);
     if (ret != APP_ERR_OK) {
         LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
         return ret;
     }
     skipFrameNum_ = *std::static_pointer_cast<uint>((*configParamMap_)["frameNum"]);
+    adaptiveConfig_.minSkipNum = skipFrameNum_;
+    keyFrameInterval_ = *std::static_pointer_cast<uint>((*configParamMap_)["keyFrameInterval"]);
     return APP_ERR_OK;
 }
 
+APP_ERROR MxpiSkipFrame::InitAdaptiveProps()
+{
+    std::vector<std::string> parameterNamesPtr = {"skipMode", "watchQueues", "maxFrameNum", "targetLatency",
+                                                  "highWaterMark", "lowWaterMark", "adjustInterval", "skipGroup"};
+    auto ret = CheckConfigParamMapIsValid(parameterNamesPtr, *configParamMap_);
+    if (ret != APP_ERR_OK) {
+        LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
+        return ret;
+    }
+    std::string skipMode = *std::static_pointer_cast<std::string>((*configParamMap_)["skipMode"]);
+    if (skipMode != SKIP_MODE_FIXED && skipMode != SKIP_MODE_ADAPTIVE) {
+        LogError << "Unknown skipMode [" << skipMode << "], it should be fixed or adaptive."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    adaptive_ = (skipMode == SKIP_MODE_ADAPTIVE);
+    if (!adaptive_) {
+        return APP_ERR_OK;
+    }
+    std::string watchQueues = *std::static_pointer_cast<std::string>((*configParamMap_)["watchQueues"]);
+    watchQueueNames_ = StringUtils::SplitWithRemoveBlank(watchQueues, ',');
+    if (watchQueueNames_.empty()) {
+        LogError << "Property watchQueues must not be empty in adaptive mode."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    adaptiveConfig_.maxSkipNum = *std::static_pointer_cast<uint>((*configParamMap_)["maxFrameNum"]);
+    adaptiveConfig_.targetLatency = *std::static_pointer_cast<uint>((*configParamMap_)["targetLatency"]);
+    adaptiveConfig_.highWaterMark = *std::static_pointer_cast<uint>((*configParamMap_)["highWaterMark"]) / PERCENT;
+    adaptiveConfig_.lowWaterMark = *std::static_pointer_cast<uint>((*configParamMap_)["lowWaterMark"]) / PERCENT;
+    if (adaptiveConfig_.maxSkipNum < adaptiveConfig_.minSkipNum ||
+        adaptiveConfig_.lowWaterMark >= adaptiveConfig_.highWaterMark) {
+        LogError << "Property maxFrameNum must not be less than frameNum, and lowWaterMark must be less than "
+                 << "highWaterMark." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    adjustInterval_ = *std::static_pointer_cast<uint>((*configParamMap_)["adjustInterval"]);
+    skipGroup_ = *std::static_pointer_cast<std::string>((*configParamMap_)["skipGroup"]);
+    channelKey_ = GetElementNameWithObjectAddr();
+    adaptiveSkipNum_ = adaptiveConfig_.minSkipNum;
+    AdaptiveSkipController::GetInstance().Register(skipGroup_, channelKey_, adaptiveSkipNum_);
+    lastAdjustTime_ = std::chrono::steady_clock::now();
+    LogInfo << "Adaptive skip frame enabled, frame number range [" << adaptiveConfig_.minSkipNum << ", "
+            << adaptiveConfig_.maxSkipNum << "], watch queues(" << watchQueues << ").";
+    return APP_ERR_OK;
+}
+
+void MxpiSkipFrame::ResolveWatchQueues()
+{
+    watchQueuesResolved_ = true;
+    for (const auto& name : watchQueueNames_) {
+        bool found = false;
+        for (const auto& iter : g_streamElementNameMap) {
+            if (iter.second.streamName == streamName_ && iter.second.elementName == name &&
+                iter.second.factory == "queue") {
+                watchQueues_.push_back(reinterpret_cast<void*>(iter.first));
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            LogWarn << "Queue element(" << name << ") is not found in stream(" << streamName_
+                    << "), element(" << pluginName_ << ") will not watch it.";
+        }
+    }
+}
+
+AdaptiveSkipSample MxpiSkipFrame::SampleWatchQueues(float elapsedMs)
+{
+    AdaptiveSkipSample sample;
+    uint32_t queueLevel = 0;
+    for (auto queue : watchQueues_) {
+        guint currentLevel = 0;
+        guint maxSize = 0;
+        guint64 levelTime = 0;
+        g_object_get(G_OBJECT(queue), "current-level-buffers", &currentLevel, "max-size-buffers", &maxSize,
+                     "current-level-time", &levelTime, nullptr);
+        if (maxSize > 0) {
+            sample.fillRatio = std::max(sample.fillRatio, static_cast<float>(currentLevel) / maxSize);
+        }
+        queueLevel = std::max(queueLevel, static_cast<uint32_t>(currentLevel));
+        sample.latency = std::max(sample.latency, static_cast<float>(levelTime) / NSEC_PER_MSEC);
+    }
+    // Frames drained downstream during the window give the service rate, the backlog divided by it gives the
+    // queueing latency. Timestamps are not required, so it also works for streams without pts.
+    float drained = static_cast<float>(sentInWindow_) + static_cast<float>(lastQueueLevel_) -
+        static_cast<float>(queueLevel);
+    if (drained > 0.f) {
+        sample.latency = std::max(sample.latency, queueLevel * elapsedMs / drained);
+    } else if (queueLevel > 0) {
+        sample.latency = std::max(sample.latency, queueLevel * elapsedMs);
+    }
+    lastQueueLevel_ = queueLevel;
+    sentInWindow_ = 0;
+    return sample;
+}
+
+void MxpiSkipFrame::AdjustSkipFrameNum()
+{
+    auto now = std::chrono::steady_clock::now();
+    float elapsedMs = std::chrono::duration<float, std::milli>(now - lastAdjustTime_).count();
+    if (elapsedMs < static_cast<float>(adjustInterval_)) {
+        return;
+    }
+    lastAdjustTime_ = now;
+    if (!watchQueuesResolved_) {
+        ResolveWatchQueues();
+    }
+    AdaptiveSkipSample sample = SampleWatchQueues(elapsedMs);
+    uint32_t skipNum = AdaptiveSkipController::GetInstance().Adjust(skipGroup_, channelKey_, adaptiveConfig_, sample);
+    if (skipNum != adaptiveSkipNum_) {
+        LogDebug << "Element(" << pluginName_ << ") changes skip frame number from " << adaptiveSkipNum_ << " to "
+                 << skipNum << ", queue fill ratio(" << sample.fillRatio << "), latency(" << sample.latency << "ms).";
+        adaptiveSkipNum_ = skipNum;
+        PublishSkipRatio(sample);
+    }
+}
+
+void MxpiSkipFrame::PublishSkipRatio(const AdaptiveSkipSample& sample)
+{
+    if (!PerformanceStatisticsManager::GetInstance()->enablePs_) {
+        return;
+    }
+    timeval updateTime;
+    gettimeofday(&updateTime, nullptr);
+    nlohmann::json detail;
+    detail["type"] = "skipRatio";
+    detail["streamName"] = streamName_;
+    detail["elementName"] = elementName_;
+    detail["frameNum"] = adaptiveSkipNum_;
+    detail["skipRatio"] = AdaptiveSkipController::GetInstance().GetSkipRatio(skipGroup_, channelKey_);
+    detail["fillRatio"] = sample.fillRatio;
+    detail["latency"] = sample.latency;
+    detail["updateTime"] = TimevalToString(updateTime);
+    PSQueueLog << detail.dump() << PSQueueLog.endl;
+}
+
 APP_ERROR MxpiSkipFrame::DeInit()
 {
     LogInfo << "Begin to deinitialize MxpiSkipFrame(" << pluginName_ << ").";
+    if (adaptive_) {
+        AdaptiveSkipController::GetInstance().Unregister(skipGroup_, channelKey_);
+    }
     LogInfo << "End to deinitialize MxpiSkipFrame(" << pluginName_ << ").";
     return APP_ERR_OK;
 }
@@ -80,13 +241,26 @@ APP_ERROR MxpiSkipFrame::Process(std::vector<MxpiBuffer *> &mxpiBuffer)
         SendData(0, *inputMxpiBuffer);
         return APP_ERR_COMM_FAILURE;
     }
+    uint32_t skipFrameNum = skipFrameNum_;
+    if (adaptive_) {
+        AdjustSkipFrameNum();
+        skipFrameNum = adaptiveSkipNum_;
+    }
     // skip frame process
-    if (skipFrameNum_ == 0) {
+    if (skipFrameNum == 0) {
+        sentInWindow_++;
+        SendData(0, *inputMxpiBuffer);
+    } else if (IsKeyFrame(mxpiMetadataManager)) {
+        // key frames are always kept and restart the skip cadence
+        frameCount_ = 0;
+        sentInWindow_++;
         SendData(0, *inputMxpiBuffer);
     } else {
         frameCount_++;
-        if ((frameCount_ % (skipFrameNum_ + 1)) == 0) {
+        // compare instead of modulo so that a lowered skip number takes effect on the next frame
+        if (frameCount_ >= skipFrameNum + 1) {
             frameCount_ = 0;
+            sentInWindow_++;
             SendData(0, *inputMxpiBuffer);
         } else {
             MxpiBufferManager::DestroyBuffer(inputMxpiBuffer);
@@ -95,6 +269,18 @@ APP_ERROR MxpiSkipFrame::Process(std::vector<MxpiBuffer *> &mxpiBuffer)
     return ret;
 }
 
+bool MxpiSkipFrame::IsKeyFrame(MxpiMetadataManager& mxpiMetadataManager)
+{
+    if (keyFrameInterval_ == 0) {
+        return false;
+    }
+    auto frameInfo = std::static_pointer_cast<MxpiFrameInfo>(mxpiMetadataManager.GetMetadata(FRAME_INFO_KEY));
+    if (frameInfo == nullptr) {
+        return false;
+    }
+    return frameInfo->frameid() % keyFrameInterval_ == 0;
+}
+
 std::vector<std::shared_ptr<void>> MxpiSkipFrame::DefineProperties()
 {
     std::vector<std::shared_ptr<void>> properties;
@@ -105,7 +291,52 @@ std::vector<std::shared_ptr<void>> MxpiSkipFrame::DefineProperties()
             "the number of skip frame",
             0, 0, 100
     });
+    auto skipMode = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+            STRING, "skipMode", "skipMode",
+            "fixed: skip frameNum frames, adaptive: adjust skip number by the load of watchQueues", "fixed", "", ""
+    });
+    auto watchQueues = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+            STRING, "watchQueues", "watchQueues",
+            "names of the downstream queue elements watched in adaptive mode, separated by ','", "", "", ""
+    });
+    auto maxFrameNum = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "maxFrameNum", "maxFrameNum", "the max number of skip frame in adaptive mode", 10, 0, 100
+    });
+    auto targetLatency = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "targetLatency", "targetLatency",
+            "target of the downstream queueing latency in ms in adaptive mode, 0 means only watch fill level",
+            0, 0, 100000
+    });
+    auto highWaterMark = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "highWaterMark", "highWaterMark",
+            "queue fill percent which raises the skip number in adaptive mode", 80, 1, 100
+    });
+    auto lowWaterMark = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "lowWaterMark", "lowWaterMark",
+            "queue fill percent below which the skip number is lowered in adaptive mode", 30, 0, 99
+    });
+    auto adjustInterval = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "adjustInterval", "adjustInterval",
+            "interval in ms between two adjustments of the skip number in adaptive mode", 200, 10, 10000
+    });
+    auto skipGroup = std::make_shared<ElementProperty<std::string>>(ElementProperty<std::string> {
+            STRING, "skipGroup", "skipGroup",
+            "adaptive elements in the same group shed load from the channel furthest behind first", "", "", ""
+    });
+    auto keyFrameInterval = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+            UINT, "keyFrameInterval", "keyFrameInterval",
+            "frames whose frame id is a multiple of it are never skipped, 0 means no key frame", 0, 0, 100000
+    });
     properties.push_back(prop1);
+    properties.push_back(keyFrameInterval);
+    properties.push_back(skipMode);
+    properties.push_back(watchQueues);
+    properties.push_back(maxFrameNum);
+    properties.push_back(targetLatency);
+    properties.push_back(highWaterMark);
+    properties.push_back(lowWaterMark);
+    properties.push_back(adjustInterval);
+    properties.push_back(skipGroup);
     return properties;
 }
 
@@ -154,7 +154,8 @@ APP_ERROR MxpiTensorInfer::InitConfig(std::map<std::string, std::shared_ptr<void
     }
 
     std::vector<std::string> parameterNamesPtr = {"outputDeviceId", "waitingTime", "dynamicStrategy", "skipModelCheck",
-                                                  "singleBatchInfer", "outputHasBatchDim", "modelPath"};
+                                                  "singleBatchInfer", "outputHasBatchDim", "modelPath",
+                                                  "shareWeights"};
     ret = CheckConfigParamMapIsValid(parameterNamesPtr, configParamMap);
     if (ret != APP_ERR_OK) {
         LogError << "Config parameter map is invalid." << GetErrorInfo(ret);
@@ -178,8 +179,11 @@ APP_ERROR MxpiTensorInfer::InitConfig(std::map<std::string, std::shared_ptr<void
     // Set outputHasBatchDim
     outputHasBatchDim_ = *std::static_pointer_cast<bool>(configParamMap["outputHasBatchDim"]);
 
+    // Set shareWeights
+    bool shareWeights = *std::static_pointer_cast<bool>(configParamMap["shareWeights"]);
+
     // model init
-    ret = model_.Init(*std::static_pointer_cast<std::string>(configParamMap["modelPath"]));
+    ret = model_.Init(*std::static_pointer_cast<std::string>(configParamMap["modelPath"]), shareWeights);
     if (ret != APP_ERR_OK) {
         LogError << "Failed to init model inference." << GetErrorInfo(ret);
         return ret;
@@ -317,6 +321,10 @@ std::vector<std::shared_ptr<void>> MxpiTensorInfer::DefineProperties()
         UINT, "outputHasBatchDim", "outputHasBatchDim",
         "model output tensor shape has batch dimension, yes:1, no:0", 1, 0, 1
     });
+    std::shared_ptr<void> shareWeights = std::make_shared<ElementProperty<uint>>(ElementProperty<uint> {
+        UINT, "shareWeights", "shareWeights",
+        "share model weights with other elements loading the same model on the device, yes:1, no:0", 0, 0, 1
+    });
     properties.push_back(modelPath);
     properties.push_back(dynamicStrategy);
     properties.push_back(timeTravel);
@@ -324,6 +332,7 @@ std::vector<std::shared_ptr<void>> MxpiTensorInfer::DefineProperties()
     properties.push_back(skipModelCheck);
     properties.push_back(singleBatchInfer);
     properties.push_back(outputHasBatchDim);
+    properties.push_back(shareWeights);
 
     return properties;
 }
@@ -0,0 +1,124 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: MxpiForkJoinTest.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <gtest/gtest.h>
+#include "MxBase/Log/Log.h"
+#include "MxStream/StreamManager/MxStreamManager.h"
+
+using namespace MxStream;
+using namespace MxBase;
+
+namespace {
+const int FRAME_NUM = 4;
+const uint32_t RESULT_TIMEOUT = 3000;
+const std::string INPUT = "mxpi_fork and mxpi_join";
+
+void SendFrames(MxStreamManager& mxStreamManager, const std::string& streamName, int frameNum)
+{
+    MxstDataInput mxstDataInput;
+    mxstDataInput.dataPtr = (uint32_t*) INPUT.c_str();
+    mxstDataInput.dataSize = INPUT.size();
+    for (int i = 0; i < frameNum; i++) {
+        EXPECT_EQ(mxStreamManager.SendData(streamName, 0, mxstDataInput), APP_ERR_OK);
+    }
+}
+
+// the joined frame is the input buffer of the fork, sent on once per frame
+bool GetJoinedFrame(MxStreamManager& mxStreamManager, const std::string& streamName, uint32_t timeoutMs)
+{
+    std::unique_ptr<MxstDataOutput> output(mxStreamManager.GetResult(streamName, 0, timeoutMs));
+    return output != nullptr && output->errorCode == APP_ERR_OK && output->dataSize == (int) INPUT.size();
+}
+
+class MxpiForkJoinTest : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        std::cout << "SetUp()" << std::endl;
+    }
+
+    virtual void TearDown()
+    {
+        std::cout << "TearDown()" << std::endl;
+    }
+};
+
+TEST_F(MxpiForkJoinTest, JoinAllBranches)
+{
+    LogInfo << "********case  MxpiForkJoin(all branches arrive)********";
+    MxStreamManager mxStreamManager;
+    mxStreamManager.InitManager();
+    APP_ERROR ret = mxStreamManager.CreateMultipleStreamsFromFile("./pipeline/fork_join.pipeline");
+    ASSERT_EQ(ret, APP_ERR_OK);
+    SendFrames(mxStreamManager, "fork_join", FRAME_NUM);
+    for (int i = 0; i < FRAME_NUM; i++) {
+        EXPECT_TRUE(GetJoinedFrame(mxStreamManager, "fork_join", RESULT_TIMEOUT));
+    }
+    // one output per input frame, the children are not sent on
+    EXPECT_FALSE(GetJoinedFrame(mxStreamManager, "fork_join", RESULT_TIMEOUT));
+    mxStreamManager.DestroyAllStreams();
+}
+
+TEST_F(MxpiForkJoinTest, JoinWhenBranchDropsFrame)
+{
+    LogInfo << "********case  MxpiForkJoin(one branch skips every other frame, no timeout)********";
+    MxStreamManager mxStreamManager;
+    mxStreamManager.InitManager();
+    APP_ERROR ret = mxStreamManager.CreateMultipleStreamsFromFile("./pipeline/drop_branch.pipeline");
+    ASSERT_EQ(ret, APP_ERR_OK);
+    SendFrames(mxStreamManager, "drop_branch", FRAME_NUM);
+    // the frames skipped by the branch are sent without waiting for it
+    for (int i = 0; i < FRAME_NUM; i++) {
+        EXPECT_TRUE(GetJoinedFrame(mxStreamManager, "drop_branch", RESULT_TIMEOUT));
+    }
+    EXPECT_FALSE(GetJoinedFrame(mxStreamManager, "drop_branch", RESULT_TIMEOUT));
+    mxStreamManager.DestroyAllStreams();
+}
+
+TEST_F(MxpiForkJoinTest, JoinWhenBranchTimesOut)
+{
+    LogInfo << "********case  MxpiForkJoin(one branch is slower than the timeout)********";
+    MxStreamManager mxStreamManager;
+    mxStreamManager.InitManager();
+    APP_ERROR ret = mxStreamManager.CreateMultipleStreamsFromFile("./pipeline/timeout.pipeline");
+    ASSERT_EQ(ret, APP_ERR_OK);
+    auto start = std::chrono::steady_clock::now();
+    SendFrames(mxStreamManager, "timeout", 1);
+    // the slow branch holds the frame for 1000ms, the join sends it after its 100ms timeout
+    const uint32_t timeoutMargin = 500;
+    EXPECT_TRUE(GetJoinedFrame(mxStreamManager, "timeout", timeoutMargin));
+    auto cost = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    EXPECT_LT(cost.count(), timeoutMargin);
+    // the late child is dropped and not sent again
+    EXPECT_FALSE(GetJoinedFrame(mxStreamManager, "timeout", RESULT_TIMEOUT));
+    mxStreamManager.DestroyAllStreams();
+}
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
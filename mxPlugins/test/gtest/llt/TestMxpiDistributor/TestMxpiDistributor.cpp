@@ -0,0 +1,166 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: TestMxpiDistributor.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <map>
+#include <vector>
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include <gst/gst.h>
+#include "MxBase/Log/Log.h"
+#include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+#include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
+#define private public
+#include "MxPlugins/MxpiDistributor/MxpiDistributor.h"
+#undef private
+
+using namespace MxBase;
+using namespace MxTools;
+using namespace MxPlugins;
+
+namespace {
+constexpr int DATA_SIZE = 1;
+constexpr int PORT_NUM = 2;
+const std::string DATA_SOURCE = "mxpi_modelinfer0";
+const std::string ELEMENT_NAME = "mxpi_distributor0";
+std::vector<std::pair<int, MxpiBuffer*>> g_sentBuffers;
+
+APP_ERROR SendDataStub(MxPluginBase*, int index, MxpiBuffer& mxpiBuffer)
+{
+    g_sentBuffers.emplace_back(index, &mxpiBuffer);
+    return APP_ERR_OK;
+}
+
+class TestMxpiDistributor : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        g_sentBuffers.clear();
+        MOCKER_CPP(&MxPluginBase::SendData).stubs().will(invoke(SendDataStub));
+    }
+
+    virtual void TearDown()
+    {
+        for (auto& sentBuffer : g_sentBuffers) {
+            MxpiBufferManager::DestroyBuffer(sentBuffer.second);
+        }
+        g_sentBuffers.clear();
+        // clear mock
+        GlobalMockObject::verify();
+    }
+};
+
+APP_ERROR InitDistributor(MxpiDistributor& distributor, const std::string& classIds)
+{
+    distributor.elementName_ = ELEMENT_NAME;
+    distributor.dataSource_ = DATA_SOURCE;
+    distributor.dataSourceKeys_ = {DATA_SOURCE};
+    distributor.srcPadNum_ = PORT_NUM;
+    std::map<std::string, std::shared_ptr<void>> configParamMap = {
+        {"channelIds", std::make_shared<std::string>("")},
+        {"classIds", std::make_shared<std::string>(classIds)},
+        {"distributeAll", std::make_shared<std::string>("no")},
+    };
+    return distributor.Init(configParamMap);
+}
+
+MxpiBuffer* CreateObjectListBuffer(const std::vector<int32_t>& classIds)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    MxpiBuffer* mxpiBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    if (mxpiBuffer == nullptr) {
+        return nullptr;
+    }
+    auto objectList = std::make_shared<MxpiObjectList>();
+    for (size_t i = 0; i < classIds.size(); i++) {
+        MxpiObject* object = objectList->add_objectvec();
+        object->set_x0(static_cast<float>(i));
+        object->add_classvec()->set_classid(classIds[i]);
+    }
+    MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
+    mxpiMetadataManager.AddProtoMetadata(DATA_SOURCE, std::static_pointer_cast<void>(objectList));
+    return mxpiBuffer;
+}
+
+void CheckObjectList(MxpiBuffer& mxpiBuffer, const std::string& key, const std::vector<int>& memberIds)
+{
+    MxpiMetadataManager mxpiMetadataManager(mxpiBuffer);
+    auto objectList = std::static_pointer_cast<MxpiObjectList>(mxpiMetadataManager.GetMetadata(key));
+    ASSERT_NE(objectList, nullptr);
+    ASSERT_EQ(objectList->objectvec_size(), static_cast<int>(memberIds.size()));
+    for (size_t i = 0; i < memberIds.size(); i++) {
+        const MxpiObject& object = objectList->objectvec(i);
+        EXPECT_FLOAT_EQ(object.x0(), static_cast<float>(memberIds[i]));
+        ASSERT_EQ(object.headervec_size(), 1);
+        EXPECT_EQ(object.headervec(0).datasource(), DATA_SOURCE);
+        EXPECT_EQ(object.headervec(0).memberid(), memberIds[i]);
+    }
+}
+
+TEST_F(TestMxpiDistributor, Process_Should_Send_The_Members_Of_Each_Port_When_ClassIds_Overlap)
+{
+    MxpiDistributor distributor;
+    ASSERT_EQ(InitDistributor(distributor, "1|2,2|3"), APP_ERR_OK);
+    MxpiBuffer* inputBuffer = CreateObjectListBuffer({1, 2, 3, 4});
+    ASSERT_NE(inputBuffer, nullptr);
+    MxpiMetadataManager inputManager(*inputBuffer);
+    auto parent = std::static_pointer_cast<MxpiObjectList>(inputManager.GetMetadata(DATA_SOURCE));
+    std::vector<MxpiBuffer*> bufferVec = {inputBuffer};
+    EXPECT_EQ(distributor.Process(bufferVec), APP_ERR_OK);
+
+    ASSERT_EQ(g_sentBuffers.size(), static_cast<size_t>(PORT_NUM));
+    EXPECT_EQ(g_sentBuffers[0].first, 0);
+    EXPECT_EQ(g_sentBuffers[1].first, 1);
+    // the ports share the input buffer, each with the list of its own members
+    CheckObjectList(*g_sentBuffers[0].second, ELEMENT_NAME + "_0", {0, 1});
+    CheckObjectList(*g_sentBuffers[1].second, ELEMENT_NAME + "_1", {1, 2});
+
+    // a member selected by both ports is copied for each of them and the input list is not changed
+    MxpiMetadataManager firstManager(*g_sentBuffers[0].second);
+    auto firstList = std::static_pointer_cast<MxpiObjectList>(firstManager.GetMetadata(ELEMENT_NAME + "_0"));
+    ASSERT_NE(firstList, nullptr);
+    firstList->mutable_objectvec(1)->set_x0(-1.f);
+    CheckObjectList(*g_sentBuffers[1].second, ELEMENT_NAME + "_1", {1, 2});
+    EXPECT_FLOAT_EQ(parent->objectvec(1).x0(), 1.f);
+    EXPECT_EQ(parent->objectvec(1).headervec_size(), 0);
+    EXPECT_EQ(distributor.DeInit(), APP_ERR_OK);
+}
+
+TEST_F(TestMxpiDistributor, Process_Should_Send_Nothing_When_No_Member_Selected)
+{
+    MxpiDistributor distributor;
+    ASSERT_EQ(InitDistributor(distributor, "5,6"), APP_ERR_OK);
+    MxpiBuffer* inputBuffer = CreateObjectListBuffer({1, 2});
+    ASSERT_NE(inputBuffer, nullptr);
+    std::vector<MxpiBuffer*> bufferVec = {inputBuffer};
+    EXPECT_EQ(distributor.Process(bufferVec), APP_ERR_OK);
+    EXPECT_TRUE(g_sentBuffers.empty());
+    EXPECT_EQ(distributor.DeInit(), APP_ERR_OK);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    gst_init(nullptr, nullptr);
+    return RUN_ALL_TESTS();
+}
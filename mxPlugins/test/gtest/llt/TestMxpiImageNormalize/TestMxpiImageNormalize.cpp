@@ -20,6 +20,7 @@
  * History: NA
  */
 
+#include <cmath>
 #include <map>
 #include <vector>
 #include <gtest/gtest.h>
@@ -27,6 +28,7 @@
 #include "MxBase/Utils/FileUtils.h"
 #include "MxTools/PluginToolkit/base/MxpiBufferDump.h"
 #include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+#include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
 #include "MxpiCommon/DumpDataHelper.h"
 #include "MxpiCommon/PluginTestHelper.h"
 #include "MxPlugins/MxpiImageNormalize/MxpiImageNormalize.h"
@@ -232,6 +234,61 @@ TEST_F(TestMxpiImageNormalize, InputBGR)
     EXPECT_EQ(ret, APP_ERR_OK);
 }
 
+TEST_F(TestMxpiImageNormalize, InputBGR_Should_Return_Success_When_Convert_To_RGB)
+{
+    std::map<std::string, std::string> properties = {
+        {"dataSource", "mxpi_imagedecoder0"},
+        {"alpha", "123.675,116.28,103.53"},
+        {"beta", "58.395,57.12,57.375"},
+        {"dataType", "FLOAT32"},
+        {"format", "RGB888"},
+    };
+    const std::vector<float> alpha = {123.675f, 116.28f, 103.53f};
+    const std::vector<float> beta = {58.395f, 57.12f, 57.375f};
+    auto pluginPtr = PluginTestHelper::GetPluginInstance<MxpiImageNormalize>("mxpi_imagenormalize", properties);
+    ASSERT_NE(pluginPtr, nullptr);
+
+    pluginPtr->elementName_ = "opencv_normalize0";
+    // the coefficients of a BGR input are not swapped in place, so every buffer is normalized the same way
+    for (int i = 0; i < 2; i++) {
+        std::vector<MxpiBuffer*> bufferVec;
+        PluginTestHelper::GetMxpiBufferFromFiles({"./input/convert_fp32.json"}, bufferVec);
+        ASSERT_EQ(bufferVec.size(), 1U);
+        MxpiMetadataManager inputManager(*bufferVec[0]);
+        auto inputList = std::static_pointer_cast<MxpiVisionList>(inputManager.GetMetadata("mxpi_imagedecoder0"));
+        ASSERT_NE(inputList, nullptr);
+        inputList->mutable_visionvec(0)->mutable_visioninfo()->set_format(MXBASE_PIXEL_FORMAT_BGR_888);
+        auto ret = pluginPtr->Process(bufferVec);
+        EXPECT_EQ(ret, APP_ERR_OK);
+
+        MxpiBuffer resultBuffer {PluginTestHelper::gstBufferVec_.back()};
+        MxpiMetadataManager resultManager(resultBuffer);
+        auto srcList = std::static_pointer_cast<MxpiVisionList>(resultManager.GetMetadata("mxpi_imagedecoder0"));
+        auto dstList = std::static_pointer_cast<MxpiVisionList>(resultManager.GetMetadata("opencv_normalize0"));
+        ASSERT_NE(srcList, nullptr);
+        ASSERT_NE(dstList, nullptr);
+        ASSERT_EQ(dstList->visionvec_size(), 1);
+        const auto &srcVision = srcList->visionvec(0);
+        const auto &dstVision = dstList->visionvec(0);
+        EXPECT_EQ(dstVision.visioninfo().format(), MXBASE_PIXEL_FORMAT_RGB_888);
+        size_t pixelNum = static_cast<size_t>(srcVision.visioninfo().width()) * srcVision.visioninfo().height();
+        ASSERT_EQ(dstVision.visiondata().datasize(), pixelNum * alpha.size() * sizeof(float));
+        auto src = reinterpret_cast<const uint8_t*>(srcVision.visiondata().dataptr());
+        auto dst = reinterpret_cast<const float*>(dstVision.visiondata().dataptr());
+        // output channel c is the RGB channel c, read from channel 2 - c of the BGR input
+        size_t mismatchNum = 0;
+        for (size_t pixel = 0; pixel < pixelNum; pixel++) {
+            for (size_t c = 0; c < alpha.size(); c++) {
+                float expected = (src[pixel * alpha.size() + alpha.size() - 1 - c] - alpha[c]) / beta[c];
+                mismatchNum += std::fabs(dst[pixel * alpha.size() + c] - expected) > 1e-4f ? 1 : 0;
+            }
+        }
+        EXPECT_EQ(mismatchNum, 0U);
+    }
+    auto ret = pluginPtr->DeInit();
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
 TEST_F(TestMxpiImageNormalize, testNormalizationUint8)
 {
     std::map<std::string, std::string> properties = {
@@ -33,7 +33,9 @@
 #include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
 #include "MxpiCommon/DumpDataHelper.h"
 #include "MxpiCommon/PluginTestHelper.h"
+#define private public
 #include "MxPlugins/MxpiOpencvOsd/MxpiOpencvOsd.h"
+#undef private
 
 using namespace MxBase;
 using namespace MxTools;
@@ -66,11 +68,12 @@ public:
     }
 };
 
-    APP_ERROR OsdProcess()
+    APP_ERROR OsdProcess(const std::string& osdBackend = "aicpu")
     {
         std::map<std::string, std::string> properties = {
             {"dataSourceOsd", "mxpi_channelosdcoordsconverter0"},
             {"dataSourceImage", "mxpi_channelimagesstitcher0_0"},
+            {"osdBackend", osdBackend},
         };
         auto pluginPtr = PluginTestHelper::GetPluginInstance<MxpiOpencvOsd>("mxpi_opencvosd", properties);
 
@@ -162,6 +165,111 @@ TEST_F(TestMxpiOpencvOsd, Test_MxpiOpencvOsd_Should_Return_Fail_When_AddOutputTe
     EXPECT_NE(ret, APP_ERR_OK);
 }
 
+TEST_F(TestMxpiOpencvOsd, Test_MxpiOpencvOsd_Should_Return_Success_When_Host_Backend_Without_Operator)
+{
+    MOCKER_CPP(&FileUtils::CheckDirectoryExists).stubs().will(returnValue(false));
+    auto ret = OsdProcess("host");
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestMxpiOpencvOsd, Test_HostProcess_Should_Copy_Vision_Data_When_Visions_More_Than_Osd_Instances)
+{
+    MOCKER_CPP(&FileUtils::CheckDirectoryExists).stubs().will(returnValue(false));
+    std::map<std::string, std::string> properties = {
+        {"dataSourceOsd", "mxpi_channelosdcoordsconverter0"},
+        {"dataSourceImage", "mxpi_channelimagesstitcher0_0"},
+        {"osdBackend", "host"},
+    };
+    auto pluginPtr = PluginTestHelper::GetPluginInstance<MxpiOpencvOsd>("mxpi_opencvosd", properties);
+    ASSERT_NE(pluginPtr, nullptr);
+    const uint32_t width = 16;
+    const uint32_t height = 8;
+    const uint8_t pixel = 100;
+    std::vector<uint8_t> image(width * height * 3 / 2, pixel);
+    auto mxpiVisionList = std::make_shared<MxpiVisionList>();
+    const int visionNum = 2;
+    for (int i = 0; i < visionNum; i++) {
+        auto vision = mxpiVisionList->add_visionvec();
+        vision->mutable_visioninfo()->set_format(MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420);
+        vision->mutable_visioninfo()->set_width(width);
+        vision->mutable_visioninfo()->set_height(height);
+        vision->mutable_visioninfo()->set_widthaligned(width);
+        vision->mutable_visioninfo()->set_heightaligned(height);
+        vision->mutable_visiondata()->set_dataptr((uint64_t)image.data());
+        vision->mutable_visiondata()->set_datasize(image.size());
+        vision->mutable_visiondata()->set_memtype(MXPI_MEMORY_HOST);
+    }
+    auto mxpiOsdInstancesList = std::make_shared<MxpiOsdInstancesList>();
+    mxpiOsdInstancesList->add_osdinstancesvec();
+    auto mxpiVisionListDest = std::make_shared<MxpiVisionList>();
+    APP_ERROR ret = pluginPtr->HostProcess(mxpiVisionList, mxpiOsdInstancesList, mxpiVisionListDest);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ASSERT_EQ(mxpiVisionListDest->visionvec_size(), visionNum);
+    // each output owns a copy of the image, so the input and the output lists never free the same memory
+    for (const auto& vision : mxpiVisionListDest->visionvec()) {
+        const auto& data = vision.visiondata();
+        EXPECT_NE(data.dataptr(), (uint64_t)image.data());
+        MemoryData deviceData((void*)data.dataptr(), data.datasize(), MemoryData::MEMORY_DVPP, data.deviceid());
+        MemoryData hostData(data.datasize(), MemoryData::MEMORY_HOST_MALLOC);
+        ret = MemoryHelper::MxbsMallocAndCopy(hostData, deviceData);
+        EXPECT_EQ(ret, APP_ERR_OK);
+        if (ret == APP_ERR_OK) {
+            EXPECT_EQ(static_cast<uint8_t*>(hostData.ptrData)[0], pixel);
+            MemoryHelper::MxbsFree(hostData);
+        }
+        MemoryHelper::MxbsFree(deviceData);
+    }
+    pluginPtr->DeInit();
+}
+
+TEST_F(TestMxpiOpencvOsd, Test_HostOsdRenderer_Should_Draw_Rect_On_Nv12_When_Param_Valid)
+{
+    const uint32_t width = 32;
+    const uint32_t height = 16;
+    const uint8_t background = 0;
+    std::vector<uint8_t> buffer(width * height * 3 / 2, background);
+    OsdImage image;
+    image.data = buffer.data();
+    image.width = width;
+    image.height = height;
+    image.widthStride = width;
+    image.heightStride = height;
+    image.format = MXBASE_PIXEL_FORMAT_YUV_SEMIPLANAR_420;
+    MxpiOsdInstances osdInstances;
+    auto rect = osdInstances.add_osdrectvec();
+    rect->set_x0(4);
+    rect->set_y0(4);
+    rect->set_x1(11);
+    rect->set_y1(11);
+    rect->mutable_osdparams()->set_scalorr(255);
+    rect->mutable_osdparams()->set_scalorg(255);
+    rect->mutable_osdparams()->set_scalorb(255);
+    rect->mutable_osdparams()->set_thickness(1);
+    HostOsdRenderer renderer;
+    EXPECT_EQ(renderer.Render(osdInstances, image), APP_ERR_OK);
+    const uint8_t white = 235;
+    EXPECT_EQ(buffer[4 * width + 4], white);
+    EXPECT_EQ(buffer[11 * width + 8], white);
+    EXPECT_EQ(buffer[8 * width + 11], white);
+    EXPECT_EQ(buffer[8 * width + 8], background);
+    EXPECT_EQ(buffer[0], background);
+}
+
+TEST_F(TestMxpiOpencvOsd, Test_HostOsdRenderer_Should_Return_Fail_When_Format_Not_Supported)
+{
+    std::vector<uint8_t> buffer(16 * 16 * 4);
+    OsdImage image;
+    image.data = buffer.data();
+    image.width = 16;
+    image.height = 16;
+    image.widthStride = 16;
+    image.heightStride = 16;
+    image.format = MXBASE_PIXEL_FORMAT_RGBA_8888;
+    MxpiOsdInstances osdInstances;
+    HostOsdRenderer renderer;
+    EXPECT_EQ(renderer.Render(osdInstances, image), APP_ERR_COMM_INVALID_PARAM);
+}
+
 TEST_F(TestMxpiOpencvOsd, Test_MxpiOpencvOsd_Should_Return_Fail_When_DataSourceImage_InValid)
 {
     std::map<std::string, std::string> properties = {
@@ -0,0 +1,210 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: TestMxpiQualityDetection.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "opencv2/core/core.hpp"
+#include "MxBase/Log/Log.h"
+#include "MxBase/BlockingQueue/BlockingQueue.h"
+#include "MxTools/PluginToolkit/base/MxPluginBase.h"
+#define private public
+#include "MxPlugins/MxpiQualityDetection/MxpiQualityDetection.h"
+#undef private
+
+using namespace MxBase;
+using namespace MxPlugins;
+
+namespace {
+const int FRAME_WIDTH = 64;
+const int FRAME_HEIGHT = 32;
+const int THUMB_SIZE = 8;
+const uint32_t BRIGHTNESS_BIT = 1u << 0;
+const uint32_t BLUR_BIT = 1u << 2;
+
+AnalysisTask MakeTask(const std::shared_ptr<ChannelState> &channel, uchar value)
+{
+    auto frame = std::make_shared<AnalysisFrame>();
+    frame->fullLuma = cv::Mat(FRAME_HEIGHT, FRAME_WIDTH, CV_8UC1, cv::Scalar(value));
+    return {channel, frame};
+}
+
+std::shared_ptr<AnalysisFrame> MakeThumbFrame(uchar value)
+{
+    auto frame = std::make_shared<AnalysisFrame>();
+    frame->thumb = cv::Mat(THUMB_SIZE, THUMB_SIZE, CV_8UC1, cv::Scalar(value));
+    return frame;
+}
+
+cv::Mat SumThumbs(const std::deque<std::shared_ptr<AnalysisFrame>> &history, size_t begin, size_t end)
+{
+    cv::Mat sum = cv::Mat::zeros(THUMB_SIZE, THUMB_SIZE, CV_32FC1);
+    for (size_t i = begin; i < end; i++) {
+        cv::accumulate(history[i]->thumb, sum);
+    }
+    return sum;
+}
+
+class TestMxpiQualityDetection : public testing::Test {
+public:
+    virtual void SetUp()
+    {
+        std::cout << "SetUp()" << std::endl;
+        if (APP_ERR_OK != MxBase::Log::Init()) {
+            LogWarn << "failed to init log.";
+        }
+    }
+
+    virtual void TearDown()
+    {
+        std::cout << "TearDown()" << std::endl;
+    }
+};
+
+TEST_F(TestMxpiQualityDetection, AnalyzeFullResolutionByDefault)
+{
+    MxpiQualityDetection plugin;
+    EXPECT_EQ(plugin.analysisWidth_, 0u);
+    AnalysisFrame frame;
+    frame.fullLuma = cv::Mat(FRAME_HEIGHT, FRAME_WIDTH, CV_8UC1, cv::Scalar(0));
+    plugin.BuildPyramid(frame);
+    EXPECT_EQ(frame.luma.cols, FRAME_WIDTH);
+    EXPECT_EQ(frame.luma.rows, FRAME_HEIGHT);
+    EXPECT_FLOAT_EQ(frame.scale, 1.f);
+}
+
+TEST_F(TestMxpiQualityDetection, DueMaskFollowsCadenceOfEachChannel)
+{
+    MxpiQualityDetection plugin;
+    plugin.switchBrightnessDetection_ = true;
+    plugin.frameIntervalBrightnessDetection_ = 2;
+    plugin.switchBlurDetection_ = true;
+    plugin.frameIntervalBlurDetection_ = 3;
+    auto channel0 = plugin.GetChannelState(0);
+    std::vector<uint32_t> dueMasks;
+    for (int i = 0; i < 6; i++) {
+        dueMasks.push_back(plugin.GetDueMask(*channel0));
+        channel0->frameIdCur++;
+    }
+    std::vector<uint32_t> expectedMasks = {BRIGHTNESS_BIT | BLUR_BIT, 0, BRIGHTNESS_BIT, BLUR_BIT, BRIGHTNESS_BIT, 0};
+    EXPECT_EQ(dueMasks, expectedMasks);
+    // a new channel starts its own cadence
+    auto channel1 = plugin.GetChannelState(1);
+    EXPECT_NE(channel0, channel1);
+    EXPECT_EQ(plugin.GetChannelState(0), channel0);
+    EXPECT_EQ(plugin.GetDueMask(*channel1), BRIGHTNESS_BIT | BLUR_BIT);
+}
+
+TEST_F(TestMxpiQualityDetection, HistoryIsKeptPerChannel)
+{
+    MxpiQualityDetection plugin;
+    plugin.MapKeyToHandle();
+    plugin.switchVideoFreezeDetection_ = true;
+    plugin.frameListMaxLen_ = 3;
+    auto channel0 = plugin.GetChannelState(0);
+    auto channel1 = plugin.GetChannelState(1);
+    for (uchar value = 0; value < 4; value++) {
+        auto task = MakeTask(channel0, value);
+        plugin.AnalyzeFrame(task);
+    }
+    auto task = MakeTask(channel1, 200);
+    plugin.AnalyzeFrame(task);
+    ASSERT_EQ(channel0->history.size(), 3u);
+    ASSERT_EQ(channel1->history.size(), 1u);
+    EXPECT_EQ(channel0->history.back()->thumb.at<uchar>(0, 0), 3);
+    EXPECT_EQ(channel1->history.back()->thumb.at<uchar>(0, 0), 200);
+    // only the thumbnail stays in the history
+    EXPECT_TRUE(channel0->history.back()->luma.empty());
+}
+
+TEST_F(TestMxpiQualityDetection, PTZSlidingSumsMatchTheWindow)
+{
+    MxpiQualityDetection plugin;
+    plugin.switchPTZMovementDetection_ = true;
+    plugin.frameListMaxLen_ = 6;
+    plugin.frameIntervalPTZMovementDetection_ = 2;
+    // the head half of the window is history[3], the tail half is history[4] and history[5]
+    const size_t startFrameIdx = 3;
+    const size_t midFrameIdx = 4;
+    ChannelState channel;
+    for (uchar value = 0; value < 12; value++) {
+        plugin.UpdateHistory(channel, MakeThumbFrame(value * 10));
+        if (channel.history.size() < plugin.frameListMaxLen_) {
+            EXPECT_FALSE(channel.ptzSumValid);
+            continue;
+        }
+        ASSERT_TRUE(channel.ptzSumValid);
+        cv::Mat headSum = SumThumbs(channel.history, startFrameIdx, midFrameIdx);
+        cv::Mat tailSum = SumThumbs(channel.history, midFrameIdx, plugin.frameListMaxLen_);
+        EXPECT_EQ(cv::norm(channel.ptzHeadSum, headSum, cv::NORM_INF), 0);
+        EXPECT_EQ(cv::norm(channel.ptzTailSum, tailSum, cv::NORM_INF), 0);
+    }
+}
+
+TEST_F(TestMxpiQualityDetection, DroppedFrameResetsHistory)
+{
+    MxpiQualityDetection plugin;
+    plugin.MapKeyToHandle();
+    plugin.switchVideoFreezeDetection_ = true;
+    plugin.frameListMaxLen_ = 3;
+    plugin.taskQueues_.push_back(std::make_shared<BlockingQueue<AnalysisTask>>(1));
+    auto channel = plugin.GetChannelState(0);
+    for (uchar value = 0; value < 3; value++) {
+        auto task = MakeTask(channel, value);
+        plugin.AnalyzeFrame(task);
+    }
+    auto queued = MakeTask(channel, 3);
+    plugin.DispatchTask(queued);
+    EXPECT_FALSE(queued.resetHistory);
+    // the queue is full, the frame is dropped
+    auto dropped = MakeTask(channel, 4);
+    plugin.DispatchTask(dropped);
+    EXPECT_TRUE(channel->dropPending);
+    EXPECT_EQ(plugin.droppedTaskCount_, 1u);
+
+    AnalysisTask task;
+    ASSERT_EQ(plugin.taskQueues_[0]->Pop(task), APP_ERR_OK);
+    plugin.AnalyzeFrame(task);
+    EXPECT_EQ(channel->history.size(), 3u);
+    // the next queued frame restarts the history after the gap
+    auto afterDrop = MakeTask(channel, 5);
+    plugin.DispatchTask(afterDrop);
+    EXPECT_FALSE(channel->dropPending);
+    ASSERT_EQ(plugin.taskQueues_[0]->Pop(task), APP_ERR_OK);
+    EXPECT_TRUE(task.resetHistory);
+    plugin.AnalyzeFrame(task);
+    ASSERT_EQ(channel->history.size(), 1u);
+    EXPECT_EQ(channel->history.back()->thumb.at<uchar>(0, 0), 5);
+    plugin.taskQueues_.clear();
+}
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -43,6 +43,29 @@ void Init()
     PluginRegister(mxpi_skipframe);
 }
 
+const std::string FRAME_INFO_KEY = "ReservedFrameInfo";
+
+// process frames with frame id 0 to frameNum - 1 one by one, return the frame ids sent downstream
+std::vector<uint32_t> ProcessFrames(MxpiSkipFrame* pluginPtr, uint32_t frameNum)
+{
+    for (uint32_t frameId = 0; frameId < frameNum; frameId++) {
+        std::vector<MxpiBuffer*> bufferVec;
+        PluginTestHelper::GetMxpiBufferFromFiles({"./input/skipframe0.json"}, bufferVec);
+        MxpiMetadataManager mxpiMetadataManager(*bufferVec[0]);
+        auto frameInfo = std::static_pointer_cast<MxpiFrameInfo>(mxpiMetadataManager.GetMetadata(FRAME_INFO_KEY));
+        frameInfo->set_frameid(frameId);
+        EXPECT_EQ(pluginPtr->Process(bufferVec), APP_ERR_OK);
+    }
+    std::vector<uint32_t> sentFrameIds;
+    for (auto gstBuffer : PluginTestHelper::gstBufferVec_) {
+        MxpiBuffer mxpiBuffer {gstBuffer};
+        MxpiMetadataManager mxpiMetadataManager(mxpiBuffer);
+        auto frameInfo = std::static_pointer_cast<MxpiFrameInfo>(mxpiMetadataManager.GetMetadata(FRAME_INFO_KEY));
+        sentFrameIds.push_back(frameInfo->frameid());
+    }
+    return sentFrameIds;
+}
+
 class TestMxpiSkipFrame : public testing::Test {
 public:
     virtual void SetUp()
@@ -93,6 +116,82 @@ TEST_F(TestMxpiSkipFrame, ProcessFrameNumTwo)
     ret = pluginPtr->DeInit();
     EXPECT_EQ(ret, APP_ERR_OK);
 }
+
+TEST_F(TestMxpiSkipFrame, ProcessAdaptive)
+{
+    std::map<std::string, std::string> properties = {
+        {"frameNum", "1"},
+        {"skipMode", "adaptive"},
+        {"watchQueues", "queue0"},
+        {"maxFrameNum", "4"},
+    };
+    auto pluginPtr = PluginTestHelper::GetPluginInstance<MxpiSkipFrame>("mxpi_skipframe", properties);
+    ASSERT_NE(pluginPtr, nullptr);
+
+    pluginPtr->elementName_ = "mxpi_skipframe0";
+    // the watched queue is not in the stream, so the skip number stays at frameNum
+    std::vector<uint32_t> expectedFrameIds = {1, 3, 5, 7};
+    EXPECT_EQ(ProcessFrames(pluginPtr, 8), expectedFrameIds);
+    auto ret = pluginPtr->DeInit();
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestMxpiSkipFrame, ProcessKeyFrameInterval)
+{
+    std::map<std::string, std::string> properties = {
+        {"frameNum", "2"},
+        {"keyFrameInterval", "4"},
+    };
+    auto pluginPtr = PluginTestHelper::GetPluginInstance<MxpiSkipFrame>("mxpi_skipframe", properties);
+    ASSERT_NE(pluginPtr, nullptr);
+
+    pluginPtr->elementName_ = "mxpi_skipframe0";
+    // key frames 0, 4, 8 are kept and restart the cadence of one frame in three
+    std::vector<uint32_t> expectedFrameIds = {0, 3, 4, 7, 8};
+    EXPECT_EQ(ProcessFrames(pluginPtr, 10), expectedFrameIds);
+    auto ret = pluginPtr->DeInit();
+    EXPECT_EQ(ret, APP_ERR_OK);
+}
+
+TEST_F(TestMxpiSkipFrame, AdaptiveControllerAdjust)
+{
+    AdaptiveSkipConfig config;
+    config.minSkipNum = 0;
+    config.maxSkipNum = 2;
+    config.targetLatency = 100.f;
+    auto& controller = AdaptiveSkipController::GetInstance();
+    controller.Register("test", "channel0", 0);
+    AdaptiveSkipSample busy = {0.9f, 50.f};
+    AdaptiveSkipSample normal = {0.5f, 80.f};
+    AdaptiveSkipSample idle = {0.1f, 10.f};
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, busy), 1u);
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, busy), 2u);
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, busy), 2u);
+    // between the water marks the skip number is kept
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, normal), 2u);
+    EXPECT_FLOAT_EQ(controller.GetSkipRatio("test", "channel0"), 2.f / 3.f);
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, idle), 1u);
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, idle), 0u);
+    EXPECT_EQ(controller.Adjust("test", "channel0", config, idle), 0u);
+    controller.Unregister("test", "channel0");
+    EXPECT_FLOAT_EQ(controller.GetSkipRatio("test", "channel0"), 0.f);
+}
+
+TEST_F(TestMxpiSkipFrame, AdaptiveControllerShedBehindChannelFirst)
+{
+    AdaptiveSkipConfig config;
+    config.maxSkipNum = 3;
+    config.targetLatency = 100.f;
+    auto& controller = AdaptiveSkipController::GetInstance();
+    controller.Register("group", "fast", 0);
+    controller.Register("group", "slow", 0);
+    controller.Adjust("group", "slow", config, {0.5f, 180.f});
+    // over target but less behind than the group average, keep it
+    EXPECT_EQ(controller.Adjust("group", "fast", config, {0.5f, 120.f}), 0u);
+    EXPECT_EQ(controller.Adjust("group", "slow", config, {0.5f, 180.f}), 2u);
+    controller.Unregister("group", "fast");
+    controller.Unregister("group", "slow");
+}
 }
 
 int main(int argc, char *argv[])
@@ -0,0 +1,160 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Loopback load generator comparing the stream server with direct unique id calls.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MxBase/Log/Log.h"
+#include "MxStream/StreamManager/MxStreamManager.h"
+#include "MxStream/StreamManager/MxStreamServer.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+const std::string STREAM_NAME = "loopback";
+// the buffers go from appsrc to appsink untouched, so the numbers are the cost of the serving path alone
+const std::string LOOPBACK_PIPELINE = R"({
+    "loopback": {
+        "appsrc0": {"factory": "appsrc", "next": "appsink0", "props": {"blocksize": "409600"}},
+        "appsink0": {"factory": "appsink"}
+    }
+})";
+const size_t DATA_SIZE = 64 * 1024;
+const double PERCENT_50 = 0.5;
+const double PERCENT_99 = 0.99;
+
+struct BenchResult {
+    std::mutex mutex;
+    std::vector<double> latencyMsVec;
+    size_t failedNum = 0;
+};
+
+void Report(const std::string& name, BenchResult& result, double elapsedMs)
+{
+    std::sort(result.latencyMsVec.begin(), result.latencyMsVec.end());
+    size_t doneNum = result.latencyMsVec.size();
+    std::cout << name << ": " << doneNum << " requests in " << elapsedMs << " ms, "
+              << (elapsedMs > 0 ? doneNum * 1000.0 / elapsedMs : 0) << " requests/s";
+    if (doneNum > 0) {
+        std::cout << ", p50 " << result.latencyMsVec[static_cast<size_t>(doneNum * PERCENT_50)] << " ms, p99 "
+                  << result.latencyMsVec[static_cast<size_t>(doneNum * PERCENT_99)] << " ms";
+    }
+    std::cout << ", failed " << result.failedNum << std::endl;
+}
+
+template <class Request>
+void RunClients(const std::string& name, int clientNum, int requestNum, Request request)
+{
+    BenchResult result;
+    std::vector<std::thread> threads;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < clientNum; i++) {
+        threads.emplace_back([&result, &request, requestNum]() {
+            std::string data(DATA_SIZE, 'x');
+            std::vector<double> latencyMsVec;
+            size_t failedNum = 0;
+            for (int j = 0; j < requestNum; j++) {
+                Clock::time_point sendTime = Clock::now();
+                if (request(data)) {
+                    latencyMsVec.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sendTime).count());
+                } else {
+                    failedNum++;
+                }
+            }
+            std::lock_guard<std::mutex> lock(result.mutex);
+            result.latencyMsVec.insert(result.latencyMsVec.end(), latencyMsVec.begin(), latencyMsVec.end());
+            result.failedNum += failedNum;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Report(name, result, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+}
+}
+
+int main(int argc, char* argv[])
+{
+    const int clientNum = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 8;
+    const int requestNum = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 1000;
+    MxStream::MxstServeOption option;
+    option.maxRequestRate = argc > 3 ? std::max(std::atof(argv[3]), 0.0) : 0;
+    std::cout << "Usage: ./serve_benchmark [clientNum] [requestNum per client] [maxRequestRate, 0 for no limit]"
+              << std::endl;
+
+    MxStream::MxStreamManager mxStreamManager;
+    if (mxStreamManager.InitManager() != APP_ERR_OK) {
+        LogError << "Failed to init Stream manager." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    if (mxStreamManager.CreateMultipleStreams(LOOPBACK_PIPELINE) != APP_ERR_OK) {
+        mxStreamManager.DestroyAllStreams();
+        LogError << "Failed to create Stream." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+
+    // every client sends and gets its own requests on the stream
+    RunClients("direct", clientNum, requestNum, [&mxStreamManager](std::string& data) {
+        std::vector<MxStream::MxstDataInput> dataInputVec(1);
+        dataInputVec[0].dataSize = static_cast<int>(data.size());
+        dataInputVec[0].dataPtr = (uint32_t*)data.c_str();
+        uint64_t uniqueId = 0;
+        if (mxStreamManager.SendMultiDataWithUniqueId(STREAM_NAME, {0}, dataInputVec, uniqueId) != APP_ERR_OK) {
+            return false;
+        }
+        auto outputVec = mxStreamManager.GetMultiResultWithUniqueIdSP(STREAM_NAME, uniqueId);
+        return !outputVec.empty() && outputVec[0] != nullptr && outputVec[0]->errorCode == APP_ERR_OK;
+    });
+
+    // the clients only submit and wait, the server sends and gets for all of them
+    MxStream::MxStreamServer mxStreamServer(mxStreamManager);
+    if (mxStreamServer.AddStream(STREAM_NAME, option) != APP_ERR_OK) {
+        mxStreamManager.DestroyAllStreams();
+        LogError << "Failed to serve Stream." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    RunClients("serve", clientNum, requestNum, [&mxStreamServer](std::string& data) {
+        std::vector<MxStream::MxstServeInput> inputVec(1);
+        inputVec[0].data = data;
+        uint64_t requestId = 0;
+        if (mxStreamServer.Submit(STREAM_NAME, inputVec, requestId) != APP_ERR_OK) {
+            return false;
+        }
+        MxStream::MxstServeResult result;
+        return mxStreamServer.Wait(requestId, result) == APP_ERR_OK && result.errorCode == APP_ERR_OK;
+    });
+    MxStream::MxstServeStatistics statistics;
+    if (mxStreamServer.GetStatistics(STREAM_NAME, statistics) == APP_ERR_OK) {
+        std::cout << "serve statistics: admitted " << statistics.admittedNum << ", rate limited "
+                  << statistics.rateLimitedNum << ", queue full " << statistics.queueFullNum
+                  << ", deadline rejected " << statistics.deadlineRejectedNum << ", expired " << statistics.expiredNum
+                  << std::endl;
+    }
+
+    mxStreamServer.Stop();
+    mxStreamManager.DestroyAllStreams();
+    return 0;
+}
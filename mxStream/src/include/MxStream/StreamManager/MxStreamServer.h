@@ -0,0 +1,128 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: In process serving front end of the streams, with admission control and batching.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MX_STREAM_SERVER_H
+#define MX_STREAM_SERVER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxStream/StreamManager/MxsmDataType.h"
+#include "MxStream/StreamManager/MxStreamManager.h"
+
+namespace MxStream {
+/* *
+ * @description: one input of a request, sent to the input plugin at the same index of the inPluginIdVec
+ */
+struct MxstServeInput {
+    std::string data;
+    MxstServiceInfo serviceInfo;
+};
+
+struct MxstServeOption {
+    std::vector<int> inPluginIdVec = {0};
+    double maxRequestRate = 0;          // requests admitted per second, 0 for no limit
+    uint32_t burstSize = 0;             // capacity of the token bucket, 0 for one second of maxRequestRate
+    uint32_t maxQueueSize = 1000;       // requests admitted and not sent yet
+    uint32_t maxBatchSize = 4;          // requests sent on each wakeup of the dispatcher
+    uint32_t maxInFlightNum = 8;        // requests sent and not got yet, the stream holds 10 unread results
+    uint32_t timeOutMs = DELAY_TIME;    // deadline of the requests submitted without one
+};
+
+struct MxstServeResult {
+    APP_ERROR errorCode = APP_ERR_OK;
+    std::vector<std::shared_ptr<MxstDataOutput>> dataOutputVec;
+};
+
+struct MxstServeStatistics {
+    uint64_t admittedNum = 0;
+    uint64_t rateLimitedNum = 0;
+    uint64_t queueFullNum = 0;
+    uint64_t deadlineRejectedNum = 0;   // rejected on admission since the deadline could not be met
+    uint64_t expiredNum = 0;            // admitted but expired before being sent
+    uint64_t cancelledNum = 0;          // admitted but cancelled before being sent
+    uint64_t completedNum = 0;
+    uint32_t queueSize = 0;
+    uint32_t inFlightNum = 0;
+};
+
+/* *
+ * @description: serves the requests of several threads on the streams of a manager. Each stream has a token
+ * bucket and a bounded queue ordered by priority then deadline, a dispatcher thread sending the queued requests
+ * with SendMultiDataWithUniqueId and a collector thread getting the results by unique id for the waiters.
+ */
+class MxStreamServerDptr;
+class SDK_AVAILABLE_FOR_OUT MxStreamServer {
+public:
+    explicit MxStreamServer(MxStreamManager& mxStreamManager);
+    ~MxStreamServer();
+    /* *
+     * @description: serve a stream created by the manager, whose input plugins are sent the unique id multi data
+     * @param streamName: the name of the target Stream
+     * @param option: admission and batching options
+     * @return: APP_ERROR
+     */
+    APP_ERROR AddStream(const std::string& streamName, const MxstServeOption& option = MxstServeOption());
+    /* *
+     * @description: admit a request, it is rejected at once when the stream is over its rate, the queue is full or
+     * the requests ahead of it would not be done before its deadline. Every admitted request must be waited or
+     * cancelled.
+     * @param inputVec: one input per input plugin, moved into the request when admitted
+     * @param requestId: the id to wait the request with
+     * @param priority: the requests with a higher priority are sent first
+     * @param timeOutMs: deadline of the request from now, 0 for the timeOutMs of the stream option
+     * @return: APP_ERR_COMM_BUSY, APP_ERR_QUEUE_FULL or APP_ERR_STREAM_TIMEOUT when rejected
+     */
+    APP_ERROR Submit(const std::string& streamName, std::vector<MxstServeInput>& inputVec, uint64_t& requestId,
+        int priority = 0, uint32_t timeOutMs = 0);
+    /* *
+     * @description: wait a request to be done and take its result
+     * @return: APP_ERR_COMM_TIMEOUT when the request is not done in timeOutMs, it can be waited again or cancelled
+     */
+    APP_ERROR Wait(uint64_t requestId, MxstServeResult& result, uint32_t timeOutMs = DELAY_TIME);
+    /* *
+     * @description: forget a request which will not be waited, it is not sent if still queued and its result is
+     * dropped when done
+     * @return: APP_ERR_COMM_INVALID_PARAM when the request is not found, or is waited or cancelled already
+     */
+    APP_ERROR Cancel(uint64_t requestId);
+    APP_ERROR GetStatistics(const std::string& streamName, MxstServeStatistics& statistics);
+    /* *
+     * @description: reject the new requests, finish the queued ones with APP_ERR_QUEUE_STOPED, wait the results of
+     * the sent ones and join the threads. Call it before the streams are destroyed.
+     */
+    void Stop();
+
+private:
+    MxStreamServer(const MxStreamServer &) = delete;
+    MxStreamServer(const MxStreamServer &&) = delete;
+    MxStreamServer& operator=(const MxStreamServer &) = delete;
+    MxStreamServer& operator=(const MxStreamServer &&) = delete;
+
+private:
+    std::shared_ptr<MxStream::MxStreamServerDptr> dPtr_ = nullptr;
+};
+}  // end namespace MxStream
+
+#endif
@@ -0,0 +1,522 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: In process serving front end of the streams, with admission control and batching.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxStream/StreamManager/MxStreamServer.h"
+#include <algorithm>
+#include "MxBase/Log/Log.h"
+#include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxBase/Utils/StringUtils.h"
+#include "MxStreamServerDptr.h"
+
+namespace MxStream {
+namespace {
+const double MS_PER_SECOND = 1000.0;
+const double AVERAGE_WEIGHT = 0.125;
+
+double ElapsedMs(ServeClock::time_point from, ServeClock::time_point to)
+{
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+void UpdateAverage(double& average, double sample, bool isFirst)
+{
+    average = isFirst ? sample : average + AVERAGE_WEIGHT * (sample - average);
+}
+}
+
+void TokenBucket::Init(double rate, uint32_t burstSize)
+{
+    rate_ = rate;
+    capacity_ = burstSize > 0 ? static_cast<double>(burstSize) : std::max(rate, 1.0);
+    tokens_ = capacity_;
+    lastTime_ = ServeClock::now();
+}
+
+bool TokenBucket::TryTake(ServeClock::time_point now)
+{
+    if (rate_ <= 0) {
+        return true;
+    }
+    if (now > lastTime_) {
+        tokens_ = std::min(capacity_, tokens_ + ElapsedMs(lastTime_, now) * rate_ / MS_PER_SECOND);
+        lastTime_ = now;
+    }
+    if (tokens_ < 1.0) {
+        return false;
+    }
+    tokens_ -= 1.0;
+    return true;
+}
+
+MxStreamServerDptr::MxStreamServerDptr(MxStreamManager& mxStreamManager) : mxStreamManager_(mxStreamManager)
+{}
+
+APP_ERROR MxStreamServerDptr::CheckOption(const MxstServeOption& option)
+{
+    if (option.inPluginIdVec.empty() || std::any_of(option.inPluginIdVec.begin(), option.inPluginIdVec.end(),
+        [](int inPluginId) { return inPluginId < 0; })) {
+        LogError << "The inPluginIdVec of the serve option is empty or has a negative id."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (option.maxRequestRate < 0 || option.maxQueueSize == 0 || option.maxBatchSize == 0 ||
+        option.maxInFlightNum == 0) {
+        LogError << "The maxRequestRate of the serve option is negative, or the maxQueueSize, maxBatchSize or "
+                 << "maxInFlightNum is 0." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxStreamServerDptr::AddStream(const std::string& streamName, const MxstServeOption& option)
+{
+    if (MxBase::StringUtils::HasInvalidChar(streamName)) {
+        LogError << "AddStream: the streamName contains invalid char, please check."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    APP_ERROR ret = CheckOption(option);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::lock_guard<std::mutex> lock(streamMapMutex_);
+    if (stopped_) {
+        LogError << "The stream server is stopped." << GetErrorInfo(APP_ERR_QUEUE_STOPED);
+        return APP_ERR_QUEUE_STOPED;
+    }
+    if (streamMap_.find(streamName) != streamMap_.end()) {
+        LogError << "Stream(" << streamName << ") is served already." << GetErrorInfo(APP_ERR_STREAM_EXIST);
+        return APP_ERR_STREAM_EXIST;
+    }
+    auto stream = MxBase::MemoryHelper::MakeShared<ServeStream>();
+    if (stream == nullptr) {
+        LogError << "Allocate memory with \"make_shared ServeStream\" failed." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    stream->streamName = streamName;
+    stream->option = option;
+    stream->tokenBucket.Init(option.maxRequestRate, option.burstSize);
+    stream->queue.reserve(option.maxQueueSize);
+    stream->dispatchThread = std::thread(&MxStreamServerDptr::DispatchThread, this, stream);
+    stream->collectThread = std::thread(&MxStreamServerDptr::CollectThread, this, stream);
+    streamMap_[streamName] = stream;
+    LogInfo << "Stream(" << streamName << ") is served, maxRequestRate(" << option.maxRequestRate
+            << "), maxQueueSize(" << option.maxQueueSize << "), maxBatchSize(" << option.maxBatchSize
+            << "), maxInFlightNum(" << option.maxInFlightNum << ").";
+    return APP_ERR_OK;
+}
+
+std::shared_ptr<ServeStream> MxStreamServerDptr::FindStream(const std::string& streamName)
+{
+    std::lock_guard<std::mutex> lock(streamMapMutex_);
+    auto iter = streamMap_.find(streamName);
+    return iter == streamMap_.end() ? nullptr : iter->second;
+}
+
+bool MxStreamServerDptr::IsLessUrgent(const std::shared_ptr<ServeRequest>& left,
+    const std::shared_ptr<ServeRequest>& right)
+{
+    if (left->priority != right->priority) {
+        return left->priority < right->priority;
+    }
+    if (left->deadline != right->deadline) {
+        return left->deadline > right->deadline;
+    }
+    return left->seq > right->seq;
+}
+
+APP_ERROR MxStreamServerDptr::Admit(ServeStream& stream, std::shared_ptr<ServeRequest>& request,
+    ServeClock::time_point now)
+{
+    if (stream.stopped) {
+        return APP_ERR_QUEUE_STOPED;
+    }
+    if (stream.queue.size() >= stream.option.maxQueueSize) {
+        stream.statistics.queueFullNum++;
+        return APP_ERR_QUEUE_FULL;
+    }
+    // the requests sent before this one have to be got first, as the results are got in sending order
+    if (stream.statistics.completedNum > 0) {
+        size_t aheadNum = stream.inFlightNum + static_cast<size_t>(std::count_if(stream.queue.begin(),
+            stream.queue.end(), [&request](const std::shared_ptr<ServeRequest>& queued) {
+                return !IsLessUrgent(queued, request);
+            }));
+        double expectedMs = static_cast<double>(aheadNum) * stream.avgIntervalMs + stream.avgLatencyMs;
+        if (expectedMs > ElapsedMs(now, request->deadline)) {
+            stream.statistics.deadlineRejectedNum++;
+            return APP_ERR_STREAM_TIMEOUT;
+        }
+    }
+    if (!stream.tokenBucket.TryTake(now)) {
+        stream.statistics.rateLimitedNum++;
+        return APP_ERR_COMM_BUSY;
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxStreamServerDptr::Submit(const std::string& streamName, std::vector<MxstServeInput>& inputVec,
+    uint64_t& requestId, int priority, uint32_t timeOutMs)
+{
+    std::shared_ptr<ServeStream> stream = FindStream(streamName);
+    if (stream == nullptr) {
+        LogError << "Stream(" << streamName << ") is not served." << GetErrorInfo(APP_ERR_STREAM_NOT_EXIST);
+        return APP_ERR_STREAM_NOT_EXIST;
+    }
+    if (inputVec.size() != stream->option.inPluginIdVec.size()) {
+        LogError << "The size of inputVec(" << inputVec.size() << ") is not the size of inPluginIdVec("
+                 << stream->option.inPluginIdVec.size() << ")." << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    auto request = MxBase::MemoryHelper::MakeShared<ServeRequest>();
+    if (request == nullptr) {
+        LogError << "Allocate memory with \"make_shared ServeRequest\" failed." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    ServeClock::time_point now = ServeClock::now();
+    request->priority = priority;
+    request->deadline = now + std::chrono::milliseconds(timeOutMs > 0 ? timeOutMs : stream->option.timeOutMs);
+
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    APP_ERROR ret = Admit(*stream, request, now);
+    if (ret != APP_ERR_OK) {
+        LogDebug << "Request to stream(" << streamName << ") is rejected." << GetErrorInfo(ret);
+        return ret;
+    }
+    request->requestId = nextRequestId_++;
+    request->streamName = streamName;
+    request->seq = stream->seq++;
+    request->inputVec = std::move(inputVec);
+    {
+        std::lock_guard<std::mutex> requestLock(requestMapMutex_);
+        requestMap_[request->requestId] = request;
+    }
+    stream->queue.push_back(request);
+    std::push_heap(stream->queue.begin(), stream->queue.end(), IsLessUrgent);
+    stream->statistics.admittedNum++;
+    requestId = request->requestId;
+    lock.unlock();
+    stream->dispatchCond.notify_one();
+    return APP_ERR_OK;
+}
+
+void MxStreamServerDptr::DispatchThread(std::shared_ptr<ServeStream> stream)
+{
+    const MxstServeOption& option = stream->option;
+    std::vector<std::shared_ptr<ServeRequest>> batch;
+    batch.reserve(option.maxBatchSize);
+    while (true) {
+        std::unique_lock<std::mutex> lock(stream->mutex);
+        stream->dispatchCond.wait(lock, [&stream, &option]() {
+            return stream->stopped || (!stream->queue.empty() && stream->inFlightNum < option.maxInFlightNum);
+        });
+        if (stream->stopped) {
+            break;
+        }
+        // drain as many requests as the stream can take on one wakeup, under one lock
+        size_t batchSize = std::min(static_cast<size_t>(std::min(option.maxBatchSize,
+            option.maxInFlightNum - stream->inFlightNum)), stream->queue.size());
+        for (size_t i = 0; i < batchSize; i++) {
+            std::pop_heap(stream->queue.begin(), stream->queue.end(), IsLessUrgent);
+            batch.push_back(std::move(stream->queue.back()));
+            stream->queue.pop_back();
+        }
+        stream->inFlightNum += static_cast<uint32_t>(batchSize);
+        lock.unlock();
+        for (auto& request : batch) {
+            SendRequest(*stream, request);
+        }
+        batch.clear();
+    }
+}
+
+void MxStreamServerDptr::SendRequest(ServeStream& stream, std::shared_ptr<ServeRequest>& request)
+{
+    APP_ERROR ret = APP_ERR_OK;
+    request->sendTime = ServeClock::now();
+    if (request->cancelled) {
+        std::unique_lock<std::mutex> lock(stream.mutex);
+        stream.inFlightNum--;
+        stream.statistics.cancelledNum++;
+        return;
+    }
+    if (request->sendTime >= request->deadline) {
+        ret = APP_ERR_STREAM_TIMEOUT;
+    } else {
+        std::vector<MxstDataInput> dataInputVec(request->inputVec.size());
+        for (size_t i = 0; i < request->inputVec.size(); i++) {
+            dataInputVec[i].serviceInfo = request->inputVec[i].serviceInfo;
+            dataInputVec[i].dataSize = static_cast<int>(request->inputVec[i].data.size());
+            dataInputVec[i].dataPtr = (uint32_t*)request->inputVec[i].data.c_str();
+        }
+        ret = mxStreamManager_.SendMultiDataWithUniqueId(stream.streamName, stream.option.inPluginIdVec,
+            dataInputVec, request->uniqueId);
+    }
+    // the data is copied into the buffers of the stream
+    request->inputVec.clear();
+    std::unique_lock<std::mutex> lock(stream.mutex);
+    if (ret == APP_ERR_OK) {
+        stream.sentQueue.push_back(request);
+        lock.unlock();
+        stream.collectCond.notify_one();
+        return;
+    }
+    stream.inFlightNum--;
+    if (ret == APP_ERR_STREAM_TIMEOUT) {
+        stream.statistics.expiredNum++;
+    }
+    lock.unlock();
+    if (ret != APP_ERR_STREAM_TIMEOUT) {
+        LogError << "Fail to send request(" << request->requestId << ") to stream(" << stream.streamName << ")."
+                 << GetErrorInfo(ret);
+    }
+    Finish(*request, ret);
+}
+
+void MxStreamServerDptr::CollectThread(std::shared_ptr<ServeStream> stream)
+{
+    while (true) {
+        std::unique_lock<std::mutex> lock(stream->mutex);
+        stream->collectCond.wait(lock, [&stream]() {
+            return !stream->sentQueue.empty() || stream->dispatcherDone;
+        });
+        if (stream->sentQueue.empty()) {
+            break;
+        }
+        std::shared_ptr<ServeRequest> request = std::move(stream->sentQueue.front());
+        stream->sentQueue.pop_front();
+        lock.unlock();
+        CollectRequest(*stream, request);
+    }
+}
+
+void MxStreamServerDptr::CollectRequest(ServeStream& stream, std::shared_ptr<ServeRequest>& request)
+{
+    ServeClock::time_point now = ServeClock::now();
+    uint32_t timeOutMs = request->deadline > now ? static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(request->deadline - now).count()) : 0;
+    std::vector<std::shared_ptr<MxstDataOutput>> dataOutputVec =
+        mxStreamManager_.GetMultiResultWithUniqueIdSP(stream.streamName, request->uniqueId, timeOutMs);
+    // an output not got in time is one with APP_ERR_STREAM_TIMEOUT, and the stream drops it when it comes late
+    APP_ERROR ret = dataOutputVec.empty() ? APP_ERR_STREAM_TIMEOUT : APP_ERR_OK;
+    for (const auto& dataOutput : dataOutputVec) {
+        if (dataOutput == nullptr || dataOutput->errorCode != APP_ERR_OK) {
+            ret = dataOutput == nullptr ? APP_ERR_COMM_FAILURE : dataOutput->errorCode;
+            break;
+        }
+    }
+
+    now = ServeClock::now();
+    std::unique_lock<std::mutex> lock(stream.mutex);
+    stream.inFlightNum--;
+    if (ret == APP_ERR_OK) {
+        bool isFirst = stream.statistics.completedNum == 0;
+        UpdateAverage(stream.avgLatencyMs, ElapsedMs(request->sendTime, now), isFirst);
+        // the results of pipelined requests are got one interval apart, an idle stream restarts from sending
+        UpdateAverage(stream.avgIntervalMs, ElapsedMs(std::max(stream.lastDoneTime, request->sendTime), now),
+            isFirst);
+        stream.lastDoneTime = now;
+    }
+    stream.statistics.completedNum++;
+    lock.unlock();
+    stream.dispatchCond.notify_one();
+    Finish(*request, ret, std::move(dataOutputVec));
+}
+
+void MxStreamServerDptr::Finish(ServeRequest& request, APP_ERROR errorCode,
+    std::vector<std::shared_ptr<MxstDataOutput>> dataOutputVec)
+{
+    std::lock_guard<std::mutex> lock(requestMapMutex_);
+    request.result.errorCode = errorCode;
+    request.result.dataOutputVec = std::move(dataOutputVec);
+    request.done = true;
+    request.doneCond.notify_all();
+}
+
+APP_ERROR MxStreamServerDptr::Wait(uint64_t requestId, MxstServeResult& result, uint32_t timeOutMs)
+{
+    std::unique_lock<std::mutex> lock(requestMapMutex_);
+    auto iter = requestMap_.find(requestId);
+    if (iter == requestMap_.end()) {
+        LogError << "Request(" << requestId << ") is not found, or is waited or cancelled already."
+                 << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    std::shared_ptr<ServeRequest> request = iter->second;
+    if (!request->doneCond.wait_for(lock, std::chrono::milliseconds(timeOutMs),
+        [&request]() { return request->done; })) {
+        return APP_ERR_COMM_TIMEOUT;
+    }
+    // another waiter of the same request may have taken the result
+    if (requestMap_.erase(requestId) == 0) {
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    result = std::move(request->result);
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxStreamServerDptr::Cancel(uint64_t requestId)
+{
+    std::shared_ptr<ServeRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(requestMapMutex_);
+        auto iter = requestMap_.find(requestId);
+        if (iter == requestMap_.end()) {
+            LogError << "Request(" << requestId << ") is not found, or is waited or cancelled already."
+                     << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
+            return APP_ERR_COMM_INVALID_PARAM;
+        }
+        request = iter->second;
+        request->cancelled = true;
+        requestMap_.erase(iter);
+    }
+    // a queued request is taken out so that it is no longer counted on admission, a popped one is skipped by the
+    // dispatcher and a sent one has its result dropped by the collector
+    std::shared_ptr<ServeStream> stream = FindStream(request->streamName);
+    if (stream == nullptr) {
+        return APP_ERR_OK;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    auto queued = std::find(stream->queue.begin(), stream->queue.end(), request);
+    if (queued != stream->queue.end()) {
+        stream->queue.erase(queued);
+        std::make_heap(stream->queue.begin(), stream->queue.end(), IsLessUrgent);
+        stream->statistics.cancelledNum++;
+    }
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxStreamServerDptr::GetStatistics(const std::string& streamName, MxstServeStatistics& statistics)
+{
+    std::shared_ptr<ServeStream> stream = FindStream(streamName);
+    if (stream == nullptr) {
+        LogError << "Stream(" << streamName << ") is not served." << GetErrorInfo(APP_ERR_STREAM_NOT_EXIST);
+        return APP_ERR_STREAM_NOT_EXIST;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    statistics = stream->statistics;
+    statistics.queueSize = static_cast<uint32_t>(stream->queue.size());
+    statistics.inFlightNum = stream->inFlightNum;
+    return APP_ERR_OK;
+}
+
+void MxStreamServerDptr::Stop()
+{
+    std::map<std::string, std::shared_ptr<ServeStream>> streamMap;
+    {
+        std::lock_guard<std::mutex> lock(streamMapMutex_);
+        stopped_ = true;
+        streamMap = streamMap_;
+    }
+    for (auto& item : streamMap) {
+        auto& stream = item.second;
+        std::vector<std::shared_ptr<ServeRequest>> queue;
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            stream->stopped = true;
+        }
+        stream->dispatchCond.notify_all();
+        if (stream->dispatchThread.joinable()) {
+            stream->dispatchThread.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(stream->mutex);
+            queue.swap(stream->queue);
+            stream->dispatcherDone = true;
+        }
+        stream->collectCond.notify_all();
+        for (auto& request : queue) {
+            Finish(*request, APP_ERR_QUEUE_STOPED);
+        }
+        // the sent requests are collected before the collector exits
+        if (stream->collectThread.joinable()) {
+            stream->collectThread.join();
+        }
+    }
+}
+
+MxStreamServer::MxStreamServer(MxStreamManager& mxStreamManager)
+{
+    dPtr_ = MxBase::MemoryHelper::MakeShared<MxStreamServerDptr>(mxStreamManager);
+    if (dPtr_ == nullptr) {
+        LogError << "Allocate memory with \"make_shared MxStreamServerDptr\" failed."
+                 << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+    }
+}
+
+MxStreamServer::~MxStreamServer()
+{
+    Stop();
+}
+
+APP_ERROR MxStreamServer::AddStream(const std::string& streamName, const MxstServeOption& option)
+{
+    if (dPtr_ == nullptr) {
+        LogError << "The stream server is not created." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return dPtr_->AddStream(streamName, option);
+}
+
+APP_ERROR MxStreamServer::Submit(const std::string& streamName, std::vector<MxstServeInput>& inputVec,
+    uint64_t& requestId, int priority, uint32_t timeOutMs)
+{
+    if (dPtr_ == nullptr) {
+        LogError << "The stream server is not created." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return dPtr_->Submit(streamName, inputVec, requestId, priority, timeOutMs);
+}
+
+APP_ERROR MxStreamServer::Wait(uint64_t requestId, MxstServeResult& result, uint32_t timeOutMs)
+{
+    if (dPtr_ == nullptr) {
+        LogError << "The stream server is not created." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return dPtr_->Wait(requestId, result, timeOutMs);
+}
+
+APP_ERROR MxStreamServer::Cancel(uint64_t requestId)
+{
+    if (dPtr_ == nullptr) {
+        LogError << "The stream server is not created." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return dPtr_->Cancel(requestId);
+}
+
+APP_ERROR MxStreamServer::GetStatistics(const std::string& streamName, MxstServeStatistics& statistics)
+{
+    if (dPtr_ == nullptr) {
+        LogError << "The stream server is not created." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+        return APP_ERR_COMM_INIT_FAIL;
+    }
+    return dPtr_->GetStatistics(streamName, statistics);
+}
+
+void MxStreamServer::Stop()
+{
+    if (dPtr_ != nullptr) {
+        dPtr_->Stop();
+    }
+}
+}  // end namespace MxStream
@@ -0,0 +1,123 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: MxStreamServer private interface for internal use only.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MX_STREAM_SERVER_DPTR_H
+#define MX_STREAM_SERVER_DPTR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "MxStream/StreamManager/MxStreamServer.h"
+
+namespace MxStream {
+using ServeClock = std::chrono::steady_clock;
+
+struct ServeRequest {
+    uint64_t requestId = 0;
+    std::string streamName;
+    uint64_t seq = 0;
+    int priority = 0;
+    ServeClock::time_point deadline;
+    ServeClock::time_point sendTime;
+    uint64_t uniqueId = 0;
+    std::vector<MxstServeInput> inputVec;
+    std::atomic<bool> cancelled{false};
+    bool done = false;
+    MxstServeResult result;
+    std::condition_variable doneCond;
+};
+
+class TokenBucket {
+public:
+    void Init(double rate, uint32_t burstSize);
+    bool TryTake(ServeClock::time_point now);
+
+private:
+    double rate_ = 0;
+    double capacity_ = 0;
+    double tokens_ = 0;
+    ServeClock::time_point lastTime_;
+};
+
+struct ServeStream {
+    std::string streamName;
+    MxstServeOption option;
+    std::mutex mutex;
+    TokenBucket tokenBucket;
+    std::vector<std::shared_ptr<ServeRequest>> queue;    // heap, the most urgent request on the front
+    std::deque<std::shared_ptr<ServeRequest>> sentQueue;  // sent requests in sending order
+    uint32_t inFlightNum = 0;                             // popped from the queue and not got yet
+    uint64_t seq = 0;
+    double avgIntervalMs = 0;                             // moving average of the time between two results
+    double avgLatencyMs = 0;                              // moving average of the time from sending to result
+    ServeClock::time_point lastDoneTime;
+    bool stopped = false;
+    bool dispatcherDone = false;
+    MxstServeStatistics statistics;
+    std::condition_variable dispatchCond;
+    std::condition_variable collectCond;
+    std::thread dispatchThread;
+    std::thread collectThread;
+};
+
+class SDK_UNAVAILABLE_FOR_OTHER MxStreamServerDptr {
+public:
+    explicit MxStreamServerDptr(MxStreamManager& mxStreamManager);
+
+    ~MxStreamServerDptr() = default;
+
+    APP_ERROR AddStream(const std::string& streamName, const MxstServeOption& option);
+    APP_ERROR Submit(const std::string& streamName, std::vector<MxstServeInput>& inputVec, uint64_t& requestId,
+        int priority, uint32_t timeOutMs);
+    APP_ERROR Wait(uint64_t requestId, MxstServeResult& result, uint32_t timeOutMs);
+    APP_ERROR Cancel(uint64_t requestId);
+    APP_ERROR GetStatistics(const std::string& streamName, MxstServeStatistics& statistics);
+    void Stop();
+
+private:
+    static APP_ERROR CheckOption(const MxstServeOption& option);
+    static bool IsLessUrgent(const std::shared_ptr<ServeRequest>& left, const std::shared_ptr<ServeRequest>& right);
+    std::shared_ptr<ServeStream> FindStream(const std::string& streamName);
+    APP_ERROR Admit(ServeStream& stream, std::shared_ptr<ServeRequest>& request, ServeClock::time_point now);
+    void DispatchThread(std::shared_ptr<ServeStream> stream);
+    void CollectThread(std::shared_ptr<ServeStream> stream);
+    void SendRequest(ServeStream& stream, std::shared_ptr<ServeRequest>& request);
+    void CollectRequest(ServeStream& stream, std::shared_ptr<ServeRequest>& request);
+    void Finish(ServeRequest& request, APP_ERROR errorCode,
+        std::vector<std::shared_ptr<MxstDataOutput>> dataOutputVec = {});
+
+private:
+    MxStreamManager& mxStreamManager_;
+    std::mutex streamMapMutex_;
+    std::map<std::string, std::shared_ptr<ServeStream>> streamMap_;
+    bool stopped_ = false;
+    std::mutex requestMapMutex_;
+    std::map<uint64_t, std::shared_ptr<ServeRequest>> requestMap_;
+    std::atomic<uint64_t> nextRequestId_{0};
+};
+}  // end namespace MxStream
+
+#endif
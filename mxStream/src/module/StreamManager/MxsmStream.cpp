@@ -265,6 +265,9 @@ APP_ERROR MxsmStream::PullSinkSampleCallback(GstElement *sink, void *data)
     }
     MxpiBuffer mxpiBuffer {};
     mxpiBuffer.buffer = (void *)buffer;
+    // the metadata views are built before the map is read without the metadata manager
+    MxpiMetadataManager mxpiMetadataManager(mxpiBuffer);
+    mxpiMetadataManager.MaterializeMetadataViews();
     MxpiMetaData mxpiMetaData {mxpiBuffer.buffer};
     auto metaData = (MxpiAiInfos*) MxpiMetaGet(mxpiMetaData);
     mxstOutput->mxpiProtobufMap = metaData->mxpiProtobufMap;
@@ -1990,8 +1993,14 @@ std::vector<MxstDataOutput*> MxsmStream::GetMultiResultWithUniqueId(uint64_t uni
 
     std::vector<MxstDataOutput*> outputVec;
     std::unique_lock<std::mutex> mapMutex(dataMapMutex_);
-    if (uniqueIdCvMap_.find(uniqueId) != uniqueIdCvMap_.end()) {
-        uniqueIdCvMap_[uniqueId]->wait_for(mapMutex, std::chrono::milliseconds(timeOutMs));
+    // the outputs may have all arrived before the call, and the wakeup may be spurious
+    auto isReady = [this, uniqueId]() {
+        auto outputIter = multiOutputMap_.find(uniqueId);
+        return outputIter != multiOutputMap_.end() && outputIter->second.size() >= multiAppsinkVec_.size();
+    };
+    if (uniqueIdCvMap_.find(uniqueId) != uniqueIdCvMap_.end() && !isReady()) {
+        std::shared_ptr<std::condition_variable> cv = uniqueIdCvMap_[uniqueId];
+        cv->wait_for(mapMutex, std::chrono::milliseconds(timeOutMs), isReady);
     }
     auto iter = uniqueIdCvMap_.find(uniqueId);
     if (iter != uniqueIdCvMap_.end()) {
@@ -2021,6 +2030,10 @@ std::vector<MxstDataOutput*> MxsmStream::GetMultiResultWithUniqueId(uint64_t uni
         LogError << "Failed to find output in multiOutputMap. push_back a nullptr."
                  << GetErrorInfo(APP_ERR_COMM_FAILURE);
     }
+    // the outputs not got in time are nullptr, so a partial result is not taken for a whole one
+    while (outputVec.size() < multiAppsinkVec_.size()) {
+        outputVec.push_back(nullptr);
+    }
 
     return outputVec;
 }
@@ -36,4 +36,7 @@ namespace std {
     %template(OutProtobufVector) vector<PyStreamManager::MxProtobufOut>;
     %template(MetadataInputVector) vector<PyStreamManager::MxMetadataInput>;
     %template(MetadataOutputVector) vector<PyStreamManager::MxMetadataOutput>;
+    %template(IntVector) vector<int>;
+    %template(DataInputVector) vector<PyStreamManager::MxDataInput>;
+    %template(DataOutputVector) vector<PyStreamManager::MxDataOutput>;
 }
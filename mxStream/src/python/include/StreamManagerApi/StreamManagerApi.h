@@ -28,6 +28,7 @@
 #include <memory>
 #include "MxTools/Proto/MxpiDataType.pb.h"
 #include "MxStream/StreamManager/MxStreamManager.h"
+#include "MxStream/StreamManager/MxStreamServer.h"
 
 const unsigned int DELAY_TIME_EX = 3000;
 
@@ -140,6 +141,16 @@ struct MxBufferAndMetadataOutput {
     }
 };
 
+struct MxServeOption {
+    std::vector<int> inPluginIdVec = {0};
+    double maxRequestRate = 0;
+    unsigned int burstSize = 0;
+    unsigned int maxQueueSize = 1000;
+    unsigned int maxBatchSize = 4;
+    unsigned int maxInFlightNum = 8;
+    unsigned int timeOutMs = MxStream::DELAY_TIME;
+};
+
 class StreamManagerApi {
 public:
     StreamManagerApi();
@@ -243,8 +254,44 @@ public:
     MxBufferAndMetadataOutput GetResult(const std::string &streamName, const std::string &elementName,
         const std::vector<std::string> &dataSourceVec, const unsigned int &msTimeOut = MxStream::DELAY_TIME) const;
 
+    /**
+     * @description: serve the Stream with admission control and batching in the sdk, the requests are then sent
+     * with SubmitRequest and got with WaitRequest from any thread. Serving is stopped by DestroyAllStreams.
+     * @param StreamName: the name of the target Stream
+     * @param option: admission and batching options
+     * @return: 0-success, other-failure
+     */
+    int AddServeStream(const std::string &streamName, const MxServeOption &option = MxServeOption());
+
+    /**
+     * @description: submit a request to a served Stream, use with WaitRequest or CancelRequest function
+     * @param StreamName: the name of the target Stream
+     * @param dataInputVec: one inferData per input plugin of the serve option
+     * @param priority: the requests with a higher priority are sent first
+     * @param timeOutInMs: deadline of the request, 0 for the timeOutMs of the serve option
+     * @return: requestId-using in WaitRequest, negative error code-rejected or failure
+     */
+    long SubmitRequest(const std::string &streamName, const std::vector<MxDataInput> &dataInputVec,
+        int priority = 0, unsigned int timeOutInMs = 0) const;
+
+    /**
+     * @description: wait a submitted request to be done, the method is blocked
+     * @param requestId: the id returned by SubmitRequest
+     * @return: one MxDataOutput per output plugin, or one MxDataOutput with the error code
+     */
+    std::vector<MxDataOutput> WaitRequest(unsigned long requestId,
+        unsigned int timeOutInMs = MxStream::DELAY_TIME) const;
+
+    /**
+     * @description: cancel a submitted request which will not be waited, it is not sent if still queued
+     * @param requestId: the id returned by SubmitRequest
+     * @return: 0-success, other-failure
+     */
+    int CancelRequest(unsigned long requestId) const;
+
 private:
     std::unique_ptr<MxStream::MxStreamManager> mxStreamManager_;
+    std::unique_ptr<MxStream::MxStreamServer> mxStreamServer_;
 };
 }  // namespace PyStream
 #endif
@@ -31,7 +31,7 @@
 #include "PyUtils/PyDataHelper.h"
 
 namespace PyStreamManager {
-StreamManagerApi::StreamManagerApi() : mxStreamManager_(nullptr)
+StreamManagerApi::StreamManagerApi() : mxStreamManager_(nullptr), mxStreamServer_(nullptr)
 {}
 
 StreamManagerApi::~StreamManagerApi()
@@ -101,6 +101,9 @@ int StreamManagerApi::DestroyAllStreams() const
         return APP_PYTHON_INIT_ERROR;
     }
     PyThreadState *pyState = PyEval_SaveThread();
+    if (mxStreamServer_ != nullptr) {
+        mxStreamServer_->Stop();
+    }
     APP_ERROR ret = mxStreamManager_->DestroyAllStreams();
     PyEval_RestoreThread(pyState);
     return ret;
@@ -413,4 +416,110 @@ MxDataOutput StreamManagerApi::GetResultWithUniqueId(
     ret = nullptr;
     return output;
 }
+
+int StreamManagerApi::AddServeStream(const std::string &streamName, const MxServeOption &option)
+{
+    if (mxStreamManager_ == nullptr) {
+        LogError << "The initialization is not performed. Call the InitManager method first."
+                 << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        return APP_PYTHON_INIT_ERROR;
+    }
+    PyThreadState *pyState = PyEval_SaveThread();
+    if (mxStreamServer_ == nullptr) {
+        MxStream::MxStreamServer* mxStreamServer = new (std::nothrow) MxStream::MxStreamServer(*mxStreamManager_);
+        if (mxStreamServer == nullptr) {
+            LogError << "The pointer is null." << GetErrorInfo(APP_ERR_COMM_INIT_FAIL);
+            PyEval_RestoreThread(pyState);
+            return APP_ERR_COMM_INIT_FAIL;
+        }
+        mxStreamServer_ = std::unique_ptr<MxStream::MxStreamServer>(mxStreamServer);
+    }
+    MxStream::MxstServeOption serveOption;
+    serveOption.inPluginIdVec = option.inPluginIdVec;
+    serveOption.maxRequestRate = option.maxRequestRate;
+    serveOption.burstSize = option.burstSize;
+    serveOption.maxQueueSize = option.maxQueueSize;
+    serveOption.maxBatchSize = option.maxBatchSize;
+    serveOption.maxInFlightNum = option.maxInFlightNum;
+    serveOption.timeOutMs = option.timeOutMs;
+    APP_ERROR ret = mxStreamServer_->AddStream(streamName, serveOption);
+    PyEval_RestoreThread(pyState);
+    return ret;
+}
+
+long StreamManagerApi::SubmitRequest(const std::string &streamName, const std::vector<MxDataInput> &dataInputVec,
+    int priority, unsigned int timeOutInMs) const
+{
+    if (mxStreamServer_ == nullptr) {
+        LogError << "The serving is not started. Call the AddServeStream method first."
+                 << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        return APP_PYTHON_INIT_ERROR;
+    }
+    PyThreadState *pyState = PyEval_SaveThread();
+    std::vector<MxStream::MxstServeInput> inputVec(dataInputVec.size());
+    for (size_t i = 0; i < dataInputVec.size(); i++) {
+        inputVec[i].data = dataInputVec[i].data;
+        inputVec[i].serviceInfo.fragmentId = dataInputVec[i].fragmentId;
+        inputVec[i].serviceInfo.customParam = dataInputVec[i].customParam;
+        for (const auto &roi : dataInputVec[i].roiBoxs) {
+            inputVec[i].serviceInfo.roiBoxs.push_back(MxStream::CropRoiBox {roi.x0, roi.y0, roi.x1, roi.y1});
+        }
+    }
+    uint64_t requestId = 0;
+    APP_ERROR ret = mxStreamServer_->Submit(streamName, inputVec, requestId, priority, timeOutInMs);
+    PyEval_RestoreThread(pyState);
+    if (ret != APP_ERR_OK) {
+        return -static_cast<long>(ret);
+    }
+    return static_cast<long>(requestId);
+}
+
+std::vector<MxDataOutput> StreamManagerApi::WaitRequest(unsigned long requestId, unsigned int timeOutInMs) const
+{
+    std::vector<MxDataOutput> outputVec;
+    if (mxStreamServer_ == nullptr) {
+        LogError << "The serving is not started. Call the AddServeStream method first."
+                 << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        outputVec.resize(1);
+        outputVec[0].errorCode = APP_PYTHON_INIT_ERROR;
+        return outputVec;
+    }
+    PyThreadState *pyState = PyEval_SaveThread();
+    MxStream::MxstServeResult result;
+    APP_ERROR ret = mxStreamServer_->Wait(requestId, result, timeOutInMs);
+    if (ret != APP_ERR_OK || result.dataOutputVec.empty()) {
+        outputVec.resize(1);
+        outputVec[0].errorCode = ret != APP_ERR_OK ? ret : result.errorCode;
+        outputVec[0].data = GetErrorInfo(outputVec[0].errorCode);
+        PyEval_RestoreThread(pyState);
+        return outputVec;
+    }
+    outputVec.resize(result.dataOutputVec.size());
+    for (size_t i = 0; i < result.dataOutputVec.size(); i++) {
+        const auto &dataOutput = result.dataOutputVec[i];
+        if (dataOutput == nullptr) {
+            outputVec[i].errorCode = APP_ERR_COMM_INNER;
+            outputVec[i].data = GetErrorInfo(APP_ERR_COMM_INNER);
+            continue;
+        }
+        outputVec[i].errorCode = dataOutput->errorCode;
+        if (dataOutput->dataPtr == nullptr || dataOutput->dataSize == 0) {
+            outputVec[i].data = GetErrorInfo(dataOutput->errorCode);
+        } else {
+            outputVec[i].data = std::string((char *)dataOutput->dataPtr, dataOutput->dataSize);
+        }
+    }
+    PyEval_RestoreThread(pyState);
+    return outputVec;
+}
+
+int StreamManagerApi::CancelRequest(unsigned long requestId) const
+{
+    if (mxStreamServer_ == nullptr) {
+        LogError << "The serving is not started. Call the AddServeStream method first."
+                 << GetErrorInfo(APP_ERR_COMM_FAILURE);
+        return APP_PYTHON_INIT_ERROR;
+    }
+    return mxStreamServer_->Cancel(requestId);
+}
 }  // namespace PyStream
\ No newline at end of file
@@ -0,0 +1,379 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: stream server test.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <gtest/gtest.h>
+#include <mockcpp/mockcpp.hpp>
+#include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxStream/StreamManager/MxStreamManager.h"
+#include "MxStream/StreamManager/MxStreamServer.h"
+
+using namespace MxStream;
+
+namespace {
+const std::string STREAM_NAME = "detection";
+const uint32_t WAIT_TIME_MS = 3000;
+
+// a loopback stream, each request is answered with its data
+std::mutex g_loopbackMutex;
+std::condition_variable g_loopbackCond;
+std::map<uint64_t, std::string> g_resultMap;
+std::vector<std::string> g_sentDataVec;
+uint64_t g_uniqueId = 0;
+bool g_isSendBlocked = false;
+bool g_isSendEntered = false;
+bool g_isResultLost = false;
+
+APP_ERROR SendLoopback(MxStreamManager*, const std::string&, std::vector<int>,
+    std::vector<MxstDataInput>& dataBufferVec, uint64_t& uniqueId)
+{
+    std::unique_lock<std::mutex> lock(g_loopbackMutex);
+    g_isSendEntered = true;
+    g_loopbackCond.notify_all();
+    g_loopbackCond.wait(lock, []() { return !g_isSendBlocked; });
+    std::string data((char*)dataBufferVec[0].dataPtr, dataBufferVec[0].dataSize);
+    uniqueId = g_uniqueId++;
+    if (!g_isResultLost) {
+        g_resultMap[uniqueId] = data;
+    }
+    g_sentDataVec.push_back(data);
+    return APP_ERR_OK;
+}
+
+std::vector<std::shared_ptr<MxstDataOutput>> GetLoopback(MxStreamManager*, const std::string&, uint64_t uniqueId,
+    uint32_t)
+{
+    std::lock_guard<std::mutex> lock(g_loopbackMutex);
+    auto iter = g_resultMap.find(uniqueId);
+    auto output = std::make_shared<MxstDataOutput>();
+    // as the manager does, an output not got in time is one with APP_ERR_STREAM_TIMEOUT
+    if (iter == g_resultMap.end()) {
+        output->errorCode = APP_ERR_STREAM_TIMEOUT;
+        return {output};
+    }
+    output->dataSize = static_cast<int>(iter->second.size());
+    output->dataPtr = (uint32_t*)malloc(output->dataSize);
+    std::copy(iter->second.begin(), iter->second.end(), (char*)output->dataPtr);
+    g_resultMap.erase(iter);
+    return {output};
+}
+
+void BlockSend(bool isBlocked)
+{
+    std::lock_guard<std::mutex> lock(g_loopbackMutex);
+    g_isSendBlocked = isBlocked;
+    g_isSendEntered = false;
+    g_loopbackCond.notify_all();
+}
+
+void WaitSendEntered()
+{
+    std::unique_lock<std::mutex> lock(g_loopbackMutex);
+    g_loopbackCond.wait(lock, []() { return g_isSendEntered; });
+}
+
+std::vector<MxstServeInput> MakeInput(const std::string& data)
+{
+    MxstServeInput input;
+    input.data = data;
+    return {input};
+}
+
+std::string GetData(const MxstServeResult& result)
+{
+    if (result.dataOutputVec.empty() || result.dataOutputVec[0] == nullptr) {
+        return "";
+    }
+    return std::string((char*)result.dataOutputVec[0]->dataPtr, result.dataOutputVec[0]->dataSize);
+}
+
+class MxStreamServerTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        g_resultMap.clear();
+        g_sentDataVec.clear();
+        g_isSendBlocked = false;
+        g_isSendEntered = false;
+        g_isResultLost = false;
+        MOCKER_CPP(&MxStreamManager::SendMultiDataWithUniqueId).stubs().will(invoke(SendLoopback));
+        MOCKER_CPP(&MxStreamManager::GetMultiResultWithUniqueIdSP).stubs().will(invoke(GetLoopback));
+    }
+
+    void TearDown() override
+    {
+        GlobalMockObject::verify();
+    }
+};
+
+TEST_F(MxStreamServerTest, Test_AddStream_Should_Return_Fail_When_Option_Is_Invalid)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxBatchSize = 0;
+    EXPECT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_COMM_INVALID_PARAM);
+    option.maxBatchSize = 1;
+    option.inPluginIdVec = {};
+    EXPECT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_COMM_INVALID_PARAM);
+    EXPECT_EQ(mxStreamServer.AddStream(STREAM_NAME), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.AddStream(STREAM_NAME), APP_ERR_STREAM_EXIST);
+
+    uint64_t requestId = 0;
+    std::vector<MxstServeInput> inputVec = MakeInput("frame");
+    EXPECT_EQ(mxStreamServer.Submit("unknown", inputVec, requestId), APP_ERR_STREAM_NOT_EXIST);
+    inputVec.push_back(MxstServeInput());
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_COMM_INVALID_PARAM);
+}
+
+TEST_F(MxStreamServerTest, Test_Wait_Should_Return_The_Result_Of_Each_Request_When_Submitted_From_Threads)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME), APP_ERR_OK);
+    const int threadNum = 4;
+    const int requestNum = 50;
+    std::vector<int> failedNum(threadNum, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadNum; i++) {
+        threads.emplace_back([&mxStreamServer, &failedNum, i]() {
+            for (int j = 0; j < requestNum; j++) {
+                std::string data = std::to_string(i) + "_" + std::to_string(j);
+                std::vector<MxstServeInput> inputVec = MakeInput(data);
+                uint64_t requestId = 0;
+                MxstServeResult result;
+                if (mxStreamServer.Submit(STREAM_NAME, inputVec, requestId) != APP_ERR_OK ||
+                    mxStreamServer.Wait(requestId, result, WAIT_TIME_MS) != APP_ERR_OK ||
+                    result.errorCode != APP_ERR_OK || GetData(result) != data) {
+                    failedNum[i]++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < threadNum; i++) {
+        EXPECT_EQ(failedNum[i], 0);
+    }
+    MxstServeStatistics statistics;
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.completedNum, static_cast<uint64_t>(threadNum * requestNum));
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(0, result, 0), APP_ERR_COMM_INVALID_PARAM);
+}
+
+TEST_F(MxStreamServerTest, Test_Submit_Should_Return_Busy_When_Over_Request_Rate)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxRequestRate = 0.1;
+    option.burstSize = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    uint64_t requestId = 0;
+    std::vector<MxstServeInput> inputVec = MakeInput("first");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_OK);
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestId, result, WAIT_TIME_MS), APP_ERR_OK);
+    uint64_t secondRequestId = 0;
+    inputVec = MakeInput("second");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, secondRequestId), APP_ERR_COMM_BUSY);
+    EXPECT_EQ(inputVec.size(), 1u);
+    MxstServeStatistics statistics;
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.rateLimitedNum, 1u);
+}
+
+TEST_F(MxStreamServerTest, Test_Submit_Should_Send_By_Priority_And_Reject_When_Queue_Is_Full)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxQueueSize = 2;
+    option.maxBatchSize = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    BlockSend(true);
+    std::vector<uint64_t> requestIdVec(3);
+    std::vector<MxstServeInput> inputVec = MakeInput("first");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[0]), APP_ERR_OK);
+    WaitSendEntered();
+    inputVec = MakeInput("low");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[1], 0), APP_ERR_OK);
+    inputVec = MakeInput("high");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[2], 1), APP_ERR_OK);
+    uint64_t requestId = 0;
+    inputVec = MakeInput("full");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_QUEUE_FULL);
+    BlockSend(false);
+
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[1], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(GetData(result), "low");
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[2], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[0], result, WAIT_TIME_MS), APP_ERR_OK);
+    std::vector<std::string> sentDataVec = {"first", "high", "low"};
+    EXPECT_EQ(g_sentDataVec, sentDataVec);
+}
+
+TEST_F(MxStreamServerTest, Test_Stop_Should_Finish_Queued_Requests_With_Queue_Stoped)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxQueueSize = 1;
+    option.maxBatchSize = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    BlockSend(true);
+    std::vector<uint64_t> requestIdVec(2);
+    std::vector<MxstServeInput> inputVec = MakeInput("sent");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[0]), APP_ERR_OK);
+    WaitSendEntered();
+    inputVec = MakeInput("queued");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[1]), APP_ERR_OK);
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[1], result, 0), APP_ERR_COMM_TIMEOUT);
+
+    std::thread stopThread([&mxStreamServer]() { mxStreamServer.Stop(); });
+    // the queue stays full until the server is stopped
+    uint64_t requestId = 0;
+    inputVec = MakeInput("late");
+    while (mxStreamServer.Submit(STREAM_NAME, inputVec, requestId) == APP_ERR_QUEUE_FULL) {
+        std::this_thread::yield();
+    }
+    BlockSend(false);
+    stopThread.join();
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[0], result, 0), APP_ERR_OK);
+    EXPECT_EQ(result.errorCode, APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[1], result, 0), APP_ERR_OK);
+    EXPECT_EQ(result.errorCode, APP_ERR_QUEUE_STOPED);
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_QUEUE_STOPED);
+}
+
+TEST_F(MxStreamServerTest, Test_Wait_Should_Return_Stream_Timeout_When_Result_Is_Not_Got_In_Time)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxInFlightNum = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    g_isResultLost = true;
+    uint64_t requestId = 0;
+    std::vector<MxstServeInput> inputVec = MakeInput("lost");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_OK);
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestId, result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(result.errorCode, APP_ERR_STREAM_TIMEOUT);
+    EXPECT_EQ(mxStreamServer.Wait(requestId, result, 0), APP_ERR_COMM_INVALID_PARAM);
+
+    // the request timed out gives its place back to the next one
+    g_isResultLost = false;
+    inputVec = MakeInput("next");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Wait(requestId, result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(result.errorCode, APP_ERR_OK);
+    EXPECT_EQ(GetData(result), "next");
+    MxstServeStatistics statistics;
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.completedNum, 2u);
+    EXPECT_EQ(statistics.inFlightNum, 0u);
+}
+
+TEST_F(MxStreamServerTest, Test_Cancel_Should_Forget_The_Request_And_Skip_Sending_It_When_Queued)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxBatchSize = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    BlockSend(true);
+    std::vector<uint64_t> requestIdVec(3);
+    std::vector<MxstServeInput> inputVec = MakeInput("sent");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[0]), APP_ERR_OK);
+    WaitSendEntered();
+    inputVec = MakeInput("cancelled");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[1]), APP_ERR_OK);
+    inputVec = MakeInput("after");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[2]), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Cancel(requestIdVec[1]), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Cancel(requestIdVec[1]), APP_ERR_COMM_INVALID_PARAM);
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[1], result, 0), APP_ERR_COMM_INVALID_PARAM);
+    BlockSend(false);
+
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[0], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[2], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(GetData(result), "after");
+    std::vector<std::string> sentDataVec = {"sent", "after"};
+    EXPECT_EQ(g_sentDataVec, sentDataVec);
+    MxstServeStatistics statistics;
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.cancelledNum, 1u);
+    EXPECT_EQ(statistics.inFlightNum, 0u);
+}
+
+TEST_F(MxStreamServerTest, Test_Submit_Should_Take_The_Place_Of_A_Cancelled_Request_When_Queue_Is_Full)
+{
+    MxStreamManager mxStreamManager;
+    MxStreamServer mxStreamServer(mxStreamManager);
+    MxstServeOption option;
+    option.maxQueueSize = 1;
+    option.maxBatchSize = 1;
+    ASSERT_EQ(mxStreamServer.AddStream(STREAM_NAME, option), APP_ERR_OK);
+    BlockSend(true);
+    std::vector<uint64_t> requestIdVec(3);
+    std::vector<MxstServeInput> inputVec = MakeInput("sent");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[0]), APP_ERR_OK);
+    WaitSendEntered();
+    inputVec = MakeInput("cancelled");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[1]), APP_ERR_OK);
+    uint64_t requestId = 0;
+    inputVec = MakeInput("after");
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestId), APP_ERR_QUEUE_FULL);
+    EXPECT_EQ(mxStreamServer.Cancel(requestIdVec[1]), APP_ERR_OK);
+    MxstServeStatistics statistics;
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.queueSize, 0u);
+    EXPECT_EQ(mxStreamServer.Submit(STREAM_NAME, inputVec, requestIdVec[2]), APP_ERR_OK);
+    BlockSend(false);
+
+    MxstServeResult result;
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[0], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(mxStreamServer.Wait(requestIdVec[2], result, WAIT_TIME_MS), APP_ERR_OK);
+    EXPECT_EQ(GetData(result), "after");
+    std::vector<std::string> sentDataVec = {"sent", "after"};
+    EXPECT_EQ(g_sentDataVec, sentDataVec);
+    EXPECT_EQ(mxStreamServer.GetStatistics(STREAM_NAME, statistics), APP_ERR_OK);
+    EXPECT_EQ(statistics.cancelledNum, 1u);
+    EXPECT_EQ(statistics.queueFullNum, 1u);
+}
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
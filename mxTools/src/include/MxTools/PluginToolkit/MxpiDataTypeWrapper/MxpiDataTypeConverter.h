@@ -23,6 +23,7 @@
 #ifndef MXPI_DATATYPECONVERTERV2_H
 #define MXPI_DATATYPECONVERTERV2_H
 
+#include <google/protobuf/arena.h>
 #include "MxBase/Tensor/TensorBase/TensorBase.h"
 #include "MxBase/DvppWrapper/DvppWrapper.h"
 #include "MxBase/PostProcessBases/PostProcessDataType.h"
@@ -32,21 +33,56 @@ namespace MxTools {
 std::shared_ptr<MxpiObjectList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::ObjectInfo>> &objectInfos, std::string dataSource);
 
+/**
+ * The lists are created on the arena when one is given, e.g. the arena of the buffer got from MxpiMetadataManager.
+ */
+std::shared_ptr<MxpiObjectList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::ObjectInfo>> &objectInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena);
+
 std::shared_ptr<MxpiClassList> ConstructProtobuf(const std::vector<std::vector<MxBase::ClassInfo>> &classInfos,
                                                  std::string dataSource);
 
+std::shared_ptr<MxpiClassList> ConstructProtobuf(const std::vector<std::vector<MxBase::ClassInfo>> &classInfos,
+                                                 std::string dataSource,
+                                                 const std::shared_ptr<google::protobuf::Arena> &arena);
+
 std::shared_ptr<MxpiImageMaskList> ConstructProtobuf(
     const std::vector<MxBase::SemanticSegInfo> &semanticSegInfos, std::string dataSource);
 
+enum class MaskEncoding {
+    RAW = 0,        // class id of every pixel, UINT8 up to 255 classes and INT32 above, the same as from the pixels
+    RAW_COMPACT,    // class id of every pixel as stored in the label map, UINT8 up to 256 classes and UINT16 above
+    RLE,            // (class id, run length) UINT32 pairs in row major order, the encoding of the mask is "rle"
+};
+
+/**
+ * Moves the label maps of the results into the masks without copying them when their data type is kept.
+ */
+std::shared_ptr<MxpiImageMaskList> ConstructProtobuf(std::vector<MxBase::SemanticSegInfo> &&semanticSegInfos,
+    std::string dataSource, MaskEncoding encoding = MaskEncoding::RAW);
+
 std::shared_ptr<MxpiTextsInfoList> ConstructProtobuf(const std::vector<MxBase::TextsInfo> &textsInfo,
                                                      std::string dataSource);
 
+std::shared_ptr<MxpiTextsInfoList> ConstructProtobuf(const std::vector<MxBase::TextsInfo> &textsInfo,
+                                                     std::string dataSource,
+                                                     const std::shared_ptr<google::protobuf::Arena> &arena);
+
 std::shared_ptr<MxpiTextObjectList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::TextObjectInfo>> &textObjectInfos, std::string dataSource);
 
+std::shared_ptr<MxpiTextObjectList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::TextObjectInfo>> &textObjectInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena);
+
 std::shared_ptr<MxpiPoseList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::KeyPointDetectionInfo>>& keyPointInfos, std::string dataSource);
 
+std::shared_ptr<MxpiPoseList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::KeyPointDetectionInfo>>& keyPointInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena);
+
 void StackMxpiVisionPreProcess(MxpiVisionInfo &dstMxpiVisionInfo,
                                const MxpiVisionInfo &srcMxpiVisionInfo,
                                const MxBase::CropResizePasteConfig &cropResizePasteConfig,
@@ -35,6 +35,7 @@
 
 namespace MxTools {
 const unsigned int MAX_PAD_NUM = 256;
+class MxGstExecutor;
 G_BEGIN_DECLS
 
 #define GST_TYPE_MXBASE (MxGstBaseGetType())
@@ -59,6 +60,7 @@ struct MxGstBase {
     std::mutex inputMutex_;
     std::mutex eventMutex_;
     std::condition_variable condition_;
+    MxGstExecutor* executor = nullptr;   // runs Process on the work-stealing pool when parallelism is above 1
 };
 
 struct MxGstBaseClass {
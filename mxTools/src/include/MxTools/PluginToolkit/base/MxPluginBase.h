@@ -243,6 +243,10 @@ public:
     std::vector<std::string> outputDataKeys_;
     static std::map<std::string, std::vector<ImageSize>> elementDynamicImageSize_;
     bool useDevice_ = true;
+    // buffers processed at a time by an ASYNC element, only applied to the plugins setting reentrant_ in Init
+    int parallelism_ = 1;
+    // set by the plugins whose Process can run on several threads at once and sends data only from Process
+    bool reentrant_ = false;
 
 protected:
     bool doPreErrorCheck_ = false;
@@ -37,7 +37,8 @@ enum {
     PLUGIN_PROP_0,
     PLUGIN_PROP_DEVICE_ID,
     PLUGIN_SYNC_STATUS,
-    PLUGIN_DATA_SOURCE
+    PLUGIN_DATA_SOURCE,
+    PLUGIN_PARALLELISM
 };
 
 #define MX_PLUGIN_GENERATE(class_name) \
@@ -121,6 +122,8 @@ enum {
         } else if (prop_id == PLUGIN_DATA_SOURCE) {     \
             std::shared_ptr<std::string> temp = std::make_shared<std::string>(g_value_get_string(value)); \
             filter->pluginInstance->dataSource_ = *temp; \
+        } else if (prop_id == PLUGIN_PARALLELISM) {   \
+            filter->pluginInstance->parallelism_ = g_value_get_int(value);   \
         } else if (G_VALUE_HOLDS_STRING(value)) {        \
             std::shared_ptr<std::string> tempValue = std::make_shared<std::string>(g_value_get_string(value)); \
             (*filter->configParam)[paramName] = std::static_pointer_cast<void>(tempValue); \
@@ -158,6 +161,8 @@ enum {
             std::shared_ptr<std::string> valuePtr = \
               std::make_shared<std::string>(filter->pluginInstance->dataSource_);  \
             g_value_set_string(value, valuePtr->c_str());   \
+        } else if (prop_id == PLUGIN_PARALLELISM) {   \
+            g_value_set_int(value, filter->pluginInstance->parallelism_);   \
         } else if (G_VALUE_HOLDS_STRING(value)) {        \
             std::shared_ptr<std::string> valuePtr = std::static_pointer_cast<std::string>(voidPtrValue);  \
             g_value_set_string(value, valuePtr->c_str());     \
@@ -194,6 +199,9 @@ enum {
         g_object_class_install_property(gobjectClass, PLUGIN_DATA_SOURCE, \
             g_param_spec_string("dataSource", "dataSource", "key of the metadata from upstream plugin", \
                 STRING_AUTO.c_str(), G_PARAM_READWRITE)); \
+        g_object_class_install_property(gobjectClass, PLUGIN_PARALLELISM, \
+            g_param_spec_int("parallelism", "parallelism", "buffers processed at a time by a reentrant async plugin", \
+                1, 128, 1, G_PARAM_READWRITE)); \
         std::vector<std::shared_ptr<void>> propertyVec = {}; \
         try { \
             propertyVec = class_name::DefineProperties(); \
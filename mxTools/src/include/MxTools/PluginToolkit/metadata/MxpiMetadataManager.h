@@ -24,7 +24,10 @@
 #define MXPLUGINGENERATOR_MXPIMETADATAMANAGER_H
 
 #include <memory>
+#include <vector>
+#include <google/protobuf/arena.h>
 #include "MxBase/ErrorCode/ErrorCode.h"
+#include "MxBase/MemoryHelper/MemoryHelper.h"
 #include "MxTools/PluginToolkit/base/MxPluginBase.h"
 #include "MxBase/Common/HiddenAttr.h"
 
@@ -76,6 +79,53 @@ public:
      */
     APP_ERROR AddProtoMetadata(const std::string& key, std::shared_ptr<void> metadata);
 
+    /**
+     * @api
+     * @brief Add a protometadata made of some members of the protometadata list held by the buffer with the parent
+     * key, each member with one meta header pointing to its index in the parent list. The parent list is referenced
+     * and the members are copied into a list of their own only when the metadata is got, so the buffers sent to
+     * several ports share the parent list until a branch uses its members. The members are copied without the lock
+     * of the buffer, so the parent list must not be changed while the views of it are not got yet.
+     * @param key
+     * @param parentKey
+     * @param memberIds: indexes of the members in the parent list, in the order of the new list.
+     * @return APP_ERROR
+     */
+    APP_ERROR AddProtoMetadataView(const std::string& key, const std::string& parentKey,
+                                   const std::vector<int>& memberIds);
+
+    /**
+     * @api
+     * @brief Build the values of the protometadata views that were not got yet, before the protometadata maps of
+     * the buffer are read directly.
+     * @return APP_ERROR
+     */
+    APP_ERROR MaterializeMetadataViews();
+
+    /**
+     * @api
+     * @brief Get the protobuf arena of the buffer, taken from a pool the first time. The arena is reset and returned
+     * to the pool when the buffer and all the messages created on it are released.
+     * @return std::shared_ptr<google::protobuf::Arena>, nullptr when the buffer is null.
+     */
+    std::shared_ptr<google::protobuf::Arena> GetArena();
+
+    /**
+     * @api
+     * @brief Create a protometadata on the protobuf arena of the buffer, the message keeps the arena alive. The
+     * message is created on the heap when the buffer has no arena.
+     * @return std::shared_ptr<T>
+     */
+    template<typename T>
+    std::shared_ptr<T> CreateProtoMetadata()
+    {
+        std::shared_ptr<google::protobuf::Arena> arena = GetArena();
+        if (arena == nullptr) {
+            return MxBase::MemoryHelper::MakeShared<T>();
+        }
+        return std::shared_ptr<T>(arena, google::protobuf::Arena::CreateMessage<T>(arena.get()));
+    }
+
     /**
      * @api
      * @brief Get a metadata from the buffer with the key.
@@ -116,6 +166,26 @@ public:
      */
     APP_ERROR CopyMetadata(MxpiBuffer& targetMxpiBuffer);
 
+    /**
+     * @api
+     * @brief Share all metadatas of the buffer with the target buffer, the values are referenced and not copied.
+     * The metadata graph and the error informations are not shared, so the metadatas added to one of the buffers
+     * afterwards stay on that buffer.
+     * @param targetMxpiBuffer
+     * @return APP_ERROR
+     */
+    APP_ERROR ShareMetadata(MxpiBuffer& targetMxpiBuffer);
+
+    /**
+     * @api
+     * @brief Add the metadatas of the source buffer that the buffer does not hold, the values are referenced and not
+     * copied. Proto metadatas are added to the metadata graph after the ones they depend on, error informations
+     * are merged by plugin name. A key held by both buffers with different values keeps the value of the buffer.
+     * @param sourceMxpiBuffer
+     * @return APP_ERROR, APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST when some keys were in conflict.
+     */
+    APP_ERROR MergeMetadata(MxpiBuffer& sourceMxpiBuffer);
+
     /**
      * @api
      * @brief Get metadata graph instance.
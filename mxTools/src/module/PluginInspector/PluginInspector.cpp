@@ -160,7 +160,7 @@ const std::vector<std::string> MEDIA_DATA_HANDLE_PLUGINS = {
 const std::vector<std::string> STREAMING_PLUGINS = {
     "mxpi_parallel2serial", "mxpi_distributor", "mxpi_synchronize", "queue", "tee", "mxpi_datatransfer",
     "mxpi_nmsoverlapedroi", "mxpi_nmsoverlapedroiv2", "mxpi_roigenerator", "mxpi_semanticsegstitcher",
-    "mxpi_objectselector", "mxpi_skipframe",
+    "mxpi_objectselector", "mxpi_skipframe", "mxpi_fork", "mxpi_join",
 };
 
 const std::vector<std::string> OUTPUT_PLUGINS = {
@@ -36,14 +36,149 @@ std::string VVector2String(const std::vector<std::vector<T>> &dataSrc)
     }
     return result;
 }
+
+void SetImageMaskPixels(MxTools::MxpiImageMask &mxpiImageMask, const MxBase::SemanticSegInfo &semanticSegInfo)
+{
+    // if classNum < 255, use uint instead of int32.
+    std::string result;
+    if (semanticSegInfo.labelMap.size() <= UINT8_MAX) {
+        std::vector<std::vector<uint8_t>> pixelsSimplified;
+        for (auto& row : semanticSegInfo.pixels) {
+            std::vector<uint8_t> rowSimplified;
+            rowSimplified.assign(row.begin(), row.end());
+            pixelsSimplified.push_back(rowSimplified);
+        }
+        result = VVector2String(pixelsSimplified);
+        mxpiImageMask.set_datatype(MxBase::TENSOR_DTYPE_UINT8);
+    } else {
+        result = VVector2String(semanticSegInfo.pixels);
+        mxpiImageMask.set_datatype(MxBase::TENSOR_DTYPE_INT32);
+    }
+    mxpiImageMask.add_shape(semanticSegInfo.pixels.size());
+    if (semanticSegInfo.pixels.size() > 0) {
+        mxpiImageMask.add_shape(semanticSegInfo.pixels[0].size());
+    }
+    mxpiImageMask.set_datastr(result);
+}
+
+std::string LabelsToInt32(const MxBase::SegLabelMap &labels)
+{
+    std::vector<int32_t> values;
+    values.reserve(static_cast<size_t>(labels.width) * labels.height);
+    for (uint32_t y = 0; y < labels.height; y++) {
+        for (uint32_t x = 0; x < labels.width; x++) {
+            values.push_back(static_cast<int32_t>(labels.At(x, y)));
+        }
+    }
+    return std::string(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(int32_t));
+}
+
+/**
+ * Sets the shape, data type and encoding of the mask from the label map. The data is set here when it has to be
+ * converted, otherwise it is left to the caller, which moves the label map in when it owns it.
+ * @return whether the caller still has to set the data
+ */
+bool SetImageMaskLabels(MxTools::MxpiImageMask &mxpiImageMask, const MxBase::SegLabelMap &labels, size_t classNum,
+    MxTools::MaskEncoding encoding)
+{
+    const std::string maskEncodingRle = "rle";
+    const uint32_t uint16ElemSize = 2;
+    mxpiImageMask.add_shape(labels.height);
+    mxpiImageMask.add_shape(labels.width);
+    if (encoding == MxTools::MaskEncoding::RLE) {
+        std::vector<uint32_t> runs = labels.EncodeRle();
+        mxpiImageMask.set_datastr(reinterpret_cast<const char *>(runs.data()), runs.size() * sizeof(uint32_t));
+        mxpiImageMask.set_datatype(MxBase::TENSOR_DTYPE_UINT32);
+        mxpiImageMask.set_encoding(maskEncodingRle);
+        return false;
+    }
+    if (encoding == MxTools::MaskEncoding::RAW_COMPACT || (labels.elemSize == 1 && classNum <= UINT8_MAX)) {
+        mxpiImageMask.set_datatype(labels.elemSize == uint16ElemSize ? MxBase::TENSOR_DTYPE_UINT16 :
+            MxBase::TENSOR_DTYPE_UINT8);
+        return true;
+    }
+    // keep the data type of the masks built from the pixels, UINT16 is only written when it is asked for
+    mxpiImageMask.set_datastr(LabelsToInt32(labels));
+    mxpiImageMask.set_datatype(MxBase::TENSOR_DTYPE_INT32);
+    return false;
+}
+
+// the label map is copied from results passed by const reference and moved from the ones passed by rvalue
+void SetImageMaskData(MxTools::MxpiImageMask &mxpiImageMask, const std::string &data)
+{
+    mxpiImageMask.set_datastr(data);
+}
+
+void SetImageMaskData(MxTools::MxpiImageMask &mxpiImageMask, std::string &data)
+{
+    mxpiImageMask.set_datastr(std::move(data));
+}
+
+template<typename SegInfos>
+std::shared_ptr<MxTools::MxpiImageMaskList> ConstructImageMaskList(SegInfos &semanticSegInfos,
+    const std::string &dataSource, MxTools::MaskEncoding encoding)
+{
+    std::shared_ptr<MxTools::MxpiImageMaskList> mxpiImageMaskList =
+        MxBase::MemoryHelper::MakeShared<MxTools::MxpiImageMaskList>();
+    if (mxpiImageMaskList == nullptr) {
+        LogError << "Create MxpiImageMaskList object failed. Failed to allocate memory."
+                 << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return nullptr;
+    }
+    for (size_t i = 0; i < semanticSegInfos.size(); i++) {
+        MxTools::MxpiImageMask *mxpiImageMask = mxpiImageMaskList->add_imagemaskvec();
+        if (mxpiImageMask == nullptr) {
+                LogError << "mxpiImageMask is nullptr. Create MxpiImageMaskList object failed."
+                        << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+                return nullptr;
+        }
+        auto &semanticSegInfo = semanticSegInfos[i];
+        for (size_t k = 0; k < semanticSegInfo.labelMap.size(); k++) {
+            mxpiImageMask->add_classname(semanticSegInfo.labelMap[k]);
+        }
+        if (semanticSegInfo.labels.Empty()) {
+            SetImageMaskPixels(*mxpiImageMask, semanticSegInfo);
+        } else {
+            if (SetImageMaskLabels(*mxpiImageMask, semanticSegInfo.labels, semanticSegInfo.labelMap.size(),
+                encoding)) {
+                SetImageMaskData(*mxpiImageMask, semanticSegInfo.labels.data);
+            }
+        }
+        MxTools::MxpiMetaHeader *mxpiMetaHeader = mxpiImageMask->add_headervec();
+        if (mxpiMetaHeader == nullptr) {
+                LogError << "mxpiMetaHeader is nullptr. Create MxpiImageMaskList object failed."
+                        << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+                return nullptr;
+        }
+        mxpiMetaHeader->set_memberid(i);
+        mxpiMetaHeader->set_datasource(dataSource);
+    }
+    return mxpiImageMaskList;
+}
+
+template<typename T>
+std::shared_ptr<T> CreateProtoList(const std::shared_ptr<google::protobuf::Arena> &arena)
+{
+    if (arena == nullptr) {
+        return MxBase::MemoryHelper::MakeShared<T>();
+    }
+    // the list keeps the arena alive, its members are allocated from the blocks of the arena
+    return std::shared_ptr<T>(arena, google::protobuf::Arena::CreateMessage<T>(arena.get()));
+}
 }
 
 namespace MxTools {
 std::shared_ptr<MxTools::MxpiObjectList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::ObjectInfo>> &objectInfos, std::string dataSource)
 {
-    std::shared_ptr<MxTools::MxpiObjectList> mxpiObjectList =
-        MxBase::MemoryHelper::MakeShared<MxTools::MxpiObjectList>();
+    return ConstructProtobuf(objectInfos, dataSource, nullptr);
+}
+
+std::shared_ptr<MxTools::MxpiObjectList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::ObjectInfo>> &objectInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena)
+{
+    std::shared_ptr<MxTools::MxpiObjectList> mxpiObjectList = CreateProtoList<MxTools::MxpiObjectList>(arena);
     if (mxpiObjectList == nullptr) {
         LogError << "Create MxpiObjectList object failed. Failed to allocate memory."
                  << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
@@ -105,7 +240,14 @@ std::shared_ptr<MxTools::MxpiObjectList> ConstructProtobuf(
 std::shared_ptr<MxTools::MxpiClassList> ConstructProtobuf(const std::vector<std::vector<MxBase::ClassInfo>>& classInfos,
                                                           std::string dataSource)
 {
-    std::shared_ptr<MxTools::MxpiClassList> mxpiClassList = MxBase::MemoryHelper::MakeShared<MxTools::MxpiClassList>();
+    return ConstructProtobuf(classInfos, dataSource, nullptr);
+}
+
+std::shared_ptr<MxTools::MxpiClassList> ConstructProtobuf(const std::vector<std::vector<MxBase::ClassInfo>>& classInfos,
+                                                          std::string dataSource,
+                                                          const std::shared_ptr<google::protobuf::Arena> &arena)
+{
+    std::shared_ptr<MxTools::MxpiClassList> mxpiClassList = CreateProtoList<MxTools::MxpiClassList>(arena);
     if (mxpiClassList == nullptr) {
         LogError << "Create MxpiClassList object failed. Failed to allocate memory."
                  << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
@@ -138,60 +280,27 @@ std::shared_ptr<MxTools::MxpiClassList> ConstructProtobuf(const std::vector<std:
 std::shared_ptr<MxTools::MxpiImageMaskList> ConstructProtobuf(
     const std::vector<MxBase::SemanticSegInfo> &semanticSegInfos, std::string dataSource)
 {
-    std::shared_ptr<MxTools::MxpiImageMaskList> mxpiImageMaskList =
-        MxBase::MemoryHelper::MakeShared<MxTools::MxpiImageMaskList>();
-    if (mxpiImageMaskList == nullptr) {
-        LogError << "Create MxpiImageMaskList object failed. Failed to allocate memory."
-                 << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
-        return nullptr;
-    }
-    for (size_t i = 0; i < semanticSegInfos.size(); i++) {
-        MxTools::MxpiImageMask *mxpiImageMask = mxpiImageMaskList->add_imagemaskvec();
-        if (mxpiImageMask == nullptr) {
-                LogError << "mxpiImageMask is nullptr. Create MxpiImageMaskList object failed."
-                        << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
-                return nullptr;
-        }
-        for (size_t k = 0; k < semanticSegInfos[i].labelMap.size(); k++) {
-            mxpiImageMask->add_classname(semanticSegInfos[i].labelMap[k]);
-        }
-        // if classNum < 255, use uint instead of int32.
-        std::string result;
-        if (semanticSegInfos[i].labelMap.size() <= UINT8_MAX) {
-            std::vector<std::vector<uint8_t>> pixelsSimplified;
-            for (auto& row : semanticSegInfos[i].pixels) {
-                std::vector<uint8_t> rowSimplified;
-                rowSimplified.assign(row.begin(), row.end());
-                pixelsSimplified.push_back(rowSimplified);
-            }
-            result = VVector2String(pixelsSimplified);
-            mxpiImageMask->set_datatype(MxBase::TENSOR_DTYPE_UINT8);
-        } else {
-            result = VVector2String(semanticSegInfos[i].pixels);
-            mxpiImageMask->set_datatype(MxBase::TENSOR_DTYPE_INT32);
-        }
-        mxpiImageMask->add_shape(semanticSegInfos[i].pixels.size());
-        if (semanticSegInfos[i].pixels.size() > 0) {
-            mxpiImageMask->add_shape(semanticSegInfos[i].pixels[0].size());
-        }
-        mxpiImageMask->set_datastr(result);
-        MxTools::MxpiMetaHeader *mxpiMetaHeader = mxpiImageMask->add_headervec();
-        if (mxpiMetaHeader == nullptr) {
-                LogError << "mxpiMetaHeader is nullptr. Create MxpiImageMaskList object failed."
-                        << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
-                return nullptr;
-        }
-        mxpiMetaHeader->set_memberid(i);
-        mxpiMetaHeader->set_datasource(dataSource);
-    }
-    return mxpiImageMaskList;
+    return ConstructImageMaskList(semanticSegInfos, dataSource, MaskEncoding::RAW);
+}
+
+std::shared_ptr<MxTools::MxpiImageMaskList> ConstructProtobuf(std::vector<MxBase::SemanticSegInfo> &&semanticSegInfos,
+    std::string dataSource, MaskEncoding encoding)
+{
+    return ConstructImageMaskList(semanticSegInfos, dataSource, encoding);
 }
 
 std::shared_ptr<MxTools::MxpiTextsInfoList> ConstructProtobuf(const std::vector<MxBase::TextsInfo>& textsInfo,
                                                               std::string dataSource)
+{
+    return ConstructProtobuf(textsInfo, dataSource, nullptr);
+}
+
+std::shared_ptr<MxTools::MxpiTextsInfoList> ConstructProtobuf(const std::vector<MxBase::TextsInfo>& textsInfo,
+                                                              std::string dataSource,
+                                                              const std::shared_ptr<google::protobuf::Arena> &arena)
 {
     std::shared_ptr<MxTools::MxpiTextsInfoList> mxpiTextsInfoList =
-        MxBase::MemoryHelper::MakeShared<MxTools::MxpiTextsInfoList>();
+        CreateProtoList<MxTools::MxpiTextsInfoList>(arena);
     if (mxpiTextsInfoList == nullptr) {
         LogError << "Create MxpiTextsInfoList object failed. Failed to allocate memory."
                  << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
@@ -221,9 +330,16 @@ std::shared_ptr<MxTools::MxpiTextsInfoList> ConstructProtobuf(const std::vector<
 
 std::shared_ptr<MxTools::MxpiTextObjectList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::TextObjectInfo>>& textObjectInfos, std::string dataSource)
+{
+    return ConstructProtobuf(textObjectInfos, dataSource, nullptr);
+}
+
+std::shared_ptr<MxTools::MxpiTextObjectList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::TextObjectInfo>>& textObjectInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena)
 {
     std::shared_ptr<MxTools::MxpiTextObjectList> mxpiTextObjectList =
-        MxBase::MemoryHelper::MakeShared<MxTools::MxpiTextObjectList>();
+        CreateProtoList<MxTools::MxpiTextObjectList>(arena);
     if (mxpiTextObjectList == nullptr) {
         LogError << "Create MxpiTextObjectList object failed. Failed to allocate memory."
                  << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
@@ -265,7 +381,14 @@ std::shared_ptr<MxTools::MxpiTextObjectList> ConstructProtobuf(
 std::shared_ptr<MxTools::MxpiPoseList> ConstructProtobuf(
     const std::vector<std::vector<MxBase::KeyPointDetectionInfo>>& keyPointInfos, std::string dataSource)
 {
-    std::shared_ptr<MxTools::MxpiPoseList> mxpiPoseList = MxBase::MemoryHelper::MakeShared<MxTools::MxpiPoseList>();
+    return ConstructProtobuf(keyPointInfos, dataSource, nullptr);
+}
+
+std::shared_ptr<MxTools::MxpiPoseList> ConstructProtobuf(
+    const std::vector<std::vector<MxBase::KeyPointDetectionInfo>>& keyPointInfos, std::string dataSource,
+    const std::shared_ptr<google::protobuf::Arena> &arena)
+{
+    std::shared_ptr<MxTools::MxpiPoseList> mxpiPoseList = CreateProtoList<MxTools::MxpiPoseList>(arena);
     if (mxpiPoseList == nullptr) {
         LogError << "Create MxpiPoseList object failed. Failed to allocate memory."
                  << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
@@ -26,6 +26,7 @@
 #include "MxBase/Log/Log.h"
 #include "MxBase/Utils/StringUtils.h"
 #include "MxTools/PluginToolkit/PerformanceStatistics/PerformanceStatisticsManager.h"
+#include "MxGstExecutor.hpp"
 
 using namespace MxBase;
 
@@ -101,6 +102,8 @@ GstStateChangeReturn MxGstBaseChangeState(GstElement* element, GstStateChange tr
 void InitProperty(const MxGstBase* filter, const MxGstBaseClass* klass);
 void InitProperty(const MxGstBase* filter, const GParamSpec* param);
 
+void DestroyExecutor(MxGstBase* filter);
+
 /* initialize the template's class */
 void MxGstBaseClassInit(MxGstBaseClass* klass)
 {
@@ -297,6 +300,7 @@ void ClearFilterWhenReadyToNull(MxGstBase* filter)
     }
     gchar *elementName = gst_element_get_name(filter);
     LogInfo << "Element gst_change_state READY_TO_NULL.";
+    DestroyExecutor(filter);
     if (elementName != nullptr) {
         g_free(elementName);
         elementName = nullptr;
@@ -349,6 +353,11 @@ gboolean MxGstBaseDefaultEvent(GstPad* pad, GstObject* parent, GstEvent* event)
     MxGstBase* filter = GST_MXBASE(parent);
     LogDebug << "Element received event("
              << GST_EVENT_TYPE_NAME(event) << ").";
+    // the outputs of the buffers received before a serialized event are sent before it
+    if (filter->executor != nullptr && GST_EVENT_IS_SERIALIZED(event) && GST_EVENT_TYPE(event) != GST_EVENT_FLUSH_STOP
+        && gst_pad_get_direction(pad) == GST_PAD_SINK) {
+        filter->executor->Drain();
+    }
     switch (GST_EVENT_TYPE(event)) {
         case GST_EVENT_CAPS: {
             GstCaps* caps;
@@ -573,9 +582,40 @@ GstFlowReturn SyncBufferProcess(MxGstBase& filter, MxpiBuffer& mxpiBuffer, int i
     return GST_FLOW_OK;
 }
 
+GstFlowReturn AsyncBufferProcess(MxGstBase& filter, std::vector<MxpiBuffer *>& input, MxpiBuffer& mxpiBuffer,
+                                 int index)
+{
+    input[index] = &mxpiBuffer;
+    const gchar *gTypeName = g_type_name(G_OBJECT_TYPE(&filter));
+    // the join merges the error informations of the branches into the frame itself
+    if (filter.pluginInstance->srcPadNum_ == 1 && strcasecmp(gTypeName, "GstMxpiDataSerialize")
+        && strcasecmp(gTypeName, "GstMxpiModelVisionInfer") != 0 && strcasecmp(gTypeName, "GstMxpiJoin") != 0) {
+        MxTools::MxpiMetadataManager mxpiMetadataManager(mxpiBuffer);
+        if (mxpiMetadataManager.GetErrorInfo() != nullptr) {
+            LogDebug << "Input data is invalid,"
+                    << " plugin will not be executed rightly.";
+            filter.pluginInstance->SendData(0, mxpiBuffer);
+            input[index] = nullptr;
+            return GST_FLOW_OK;
+        }
+    }
+    // the start and end times of an element are not recorded when several buffers are processed at once
+    bool recordTime = filter.executor == nullptr;
+    if (recordTime) {
+        PluginStatisticsSetStartTime((uint64_t)&filter);
+    }
+    GstFlowReturn retErr = (GstFlowReturn)filter.pluginInstance->RunProcess(input);
+    if (recordTime) {
+        PluginStatisticsSetEndTime((uint64_t)&filter);
+    }
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = nullptr;
+    }
+    return retErr;
+}
+
 GstFlowReturn BufferProcess(MxGstBase* filter, GstBuffer* gstBuffer, int index)
 {
-    GstFlowReturn retErr = GST_FLOW_OK;
     auto* mxpiBuffer = new (std::nothrow) MxpiBuffer {gstBuffer, nullptr};
     if (mxpiBuffer == nullptr) {
         gst_buffer_unref(gstBuffer);
@@ -585,27 +625,12 @@ GstFlowReturn BufferProcess(MxGstBase* filter, GstBuffer* gstBuffer, int index)
     }
     LogDebug << "sync status:" << filter->pluginInstance->status_;
     if (filter->pluginInstance->status_ == ASYNC) {
-        std::unique_lock<std::mutex> lock(filter->inputMutex_);
-        filter->input[index] = mxpiBuffer;
-        const gchar *gTypeName = g_type_name(G_OBJECT_TYPE(filter));
-        if (filter->pluginInstance->srcPadNum_ == 1 && strcasecmp(gTypeName, "GstMxpiDataSerialize")
-            && strcasecmp(gTypeName, "GstMxpiModelVisionInfer") != 0) {
-            MxTools::MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
-            if (mxpiMetadataManager.GetErrorInfo() != nullptr) {
-                LogDebug << "Input data is invalid,"
-                        << " plugin will not be executed rightly.";
-                filter->pluginInstance->SendData(0, *mxpiBuffer);
-                filter->input[index] = nullptr;
-                return GST_FLOW_OK;
-            }
-        }
-        PluginStatisticsSetStartTime((uint64_t)filter);
-        retErr = (GstFlowReturn)filter->pluginInstance->RunProcess(filter->input);
-        PluginStatisticsSetEndTime((uint64_t)filter);
-        for (size_t i = 0; i < filter->input.size(); i++) {
-            filter->input[i] = nullptr;
+        if (filter->executor != nullptr) {
+            filter->executor->Submit(index, mxpiBuffer);
+            return GST_FLOW_OK;
         }
-        return retErr;
+        std::unique_lock<std::mutex> lock(filter->inputMutex_);
+        return AsyncBufferProcess(*filter, filter->input, *mxpiBuffer, index);
     } else if (filter->pluginInstance->status_ == SYNC) {
         return SyncBufferProcess(*filter, *mxpiBuffer, index);
     }
@@ -689,6 +714,55 @@ gboolean MxGstBaseStart(MxGstBase* filter)
     return TRUE;
 }
 
+gboolean CreateExecutor(MxGstBase* filter)
+{
+    DestroyExecutor(filter);
+    MxPluginBase* plugin = filter->pluginInstance;
+    if (plugin->status_ != ASYNC || plugin->parallelism_ <= 1) {
+        return TRUE;
+    }
+    if (!plugin->reentrant_) {
+        LogWarn << "Element(" << plugin->elementName_ << ") is not reentrant, parallelism " << plugin->parallelism_
+                << " is ignored.";
+        return TRUE;
+    }
+    int deviceId = plugin->useDevice_ ? plugin->deviceId_ : -1;
+    auto process = [filter, deviceId](size_t channel, MxpiBuffer* mxpiBuffer) {
+        if (deviceId >= 0 && SetDevice(deviceId) != APP_ERR_OK) {
+            LogError << "Failed to SetDevice :" << deviceId << GetErrorInfo(APP_ERR_COMM_FAILURE);
+            gst_buffer_unref((GstBuffer*)mxpiBuffer->buffer);
+            delete mxpiBuffer;
+            return;
+        }
+        std::vector<MxpiBuffer *> input(filter->sinkPadVec.size(), nullptr);
+        AsyncBufferProcess(*filter, input, *mxpiBuffer, static_cast<int>(channel));
+    };
+    auto emit = [filter](int index, GstBuffer* gstBuffer) {
+        GstFlowReturn ret = gst_pad_push(filter->srcPadVec[index], gstBuffer);
+        if (ret != GST_FLOW_OK) {
+            LogDebug << "Element(" << filter->pluginInstance->elementName_ << ") push buffer to port(" << index
+                     << ") returns " << gst_flow_get_name(ret) << ".";
+        }
+    };
+    filter->executor = new (std::nothrow) MxGstExecutor(plugin->elementName_, deviceId,
+        static_cast<uint32_t>(plugin->parallelism_), process, emit);
+    if (filter->executor == nullptr) {
+        LogError << "Create executor of element(" << plugin->elementName_ << ") failed."
+                 << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void DestroyExecutor(MxGstBase* filter)
+{
+    if (filter->executor != nullptr) {
+        // waits for the buffers still processed, their outputs are dropped by the inactive pads
+        delete filter->executor;
+        filter->executor = nullptr;
+    }
+}
+
 gboolean MxGstBaseInstanceInit(MxGstBase* filter)
 {
     if (SetDefaultDataSourceKey(filter) == FALSE) {
@@ -708,6 +782,9 @@ gboolean MxGstBaseInstanceInit(MxGstBase* filter)
                  << " Error message: (" << e.what() << ")." << GetErrorInfo(APP_ERR_COMM_INNER);
         return FALSE;
     }
+    if (!CreateExecutor(filter)) {
+        return FALSE;
+    }
     if (!MxGstBasePadsActivate(filter, TRUE)) {
         return FALSE;
     }
@@ -887,6 +964,7 @@ GstStateChangeReturn StateChangeProcess(MxGstBase* filter, GstStateChange transi
             if (!MxGstBasePadsActivate(filter, FALSE)) {
                 result = GST_STATE_CHANGE_FAILURE;
             }
+            DestroyExecutor(filter);
             if (!MxGstBaseStop(filter)) {
                 result = GST_STATE_CHANGE_FAILURE;
             }
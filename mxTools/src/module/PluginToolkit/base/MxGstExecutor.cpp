@@ -0,0 +1,304 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Work-stealing executor of the reentrant ASYNC elements, sends the outputs in input order.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxGstExecutor.hpp"
+#include <algorithm>
+#include <chrono>
+#include "MxBase/DeviceManager/DeviceManager.h"
+#include "MxBase/Log/Log.h"
+
+using namespace MxBase;
+
+namespace {
+    constexpr size_t IN_FLIGHT_PER_TASK = 2;
+    constexpr uint32_t HELP_WAIT_TIME_MS = 10;
+    thread_local MxTools::MxGstWorkStealingPool* g_workerPool = nullptr;
+    thread_local size_t g_workerIndex = 0;
+}
+
+namespace MxTools {
+thread_local const MxGstExecutor* MxGstExecutor::currentExecutor_ = nullptr;
+thread_local std::vector<MxGstExecutor::Output>* MxGstExecutor::currentOutputs_ = nullptr;
+
+MxGstWorkStealingPool& MxGstWorkStealingPool::GetInstance(int deviceId)
+{
+    static std::mutex poolMtx;
+    // never destroyed, the workers may still run tasks while the static objects are destroyed at exit
+    static auto pools = new std::map<int, std::unique_ptr<MxGstWorkStealingPool>>();
+    std::lock_guard<std::mutex> lck(poolMtx);
+    std::unique_ptr<MxGstWorkStealingPool>& pool = (*pools)[deviceId];
+    if (pool == nullptr) {
+        size_t threadNum = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+        pool.reset(new MxGstWorkStealingPool(deviceId, threadNum));
+        LogInfo << "Create work-stealing pool of device(" << deviceId << ") with " << threadNum << " threads.";
+    }
+    return *pool;
+}
+
+MxGstWorkStealingPool::MxGstWorkStealingPool(int deviceId, size_t threadNum) : deviceId_(deviceId)
+{
+    for (size_t i = 0; i < threadNum; i++) {
+        workers_.emplace_back(new Worker());
+    }
+    for (size_t i = 0; i < threadNum; i++) {
+        workers_[i]->thread = std::thread(&MxGstWorkStealingPool::Run, this, i);
+    }
+}
+
+MxGstWorkStealingPool::~MxGstWorkStealingPool()
+{
+    stopped_ = true;
+    {
+        std::lock_guard<std::mutex> lck(sleepMtx_);
+    }
+    sleepCond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void MxGstWorkStealingPool::Submit(Task task)
+{
+    // a worker keeps the tasks it submits, the others spread over the workers
+    size_t index = (g_workerPool == this) ? g_workerIndex : nextWorker_++ % workers_.size();
+    {
+        std::lock_guard<std::mutex> lck(workers_[index]->mtx);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    pendingNum_++;
+    // ordered with the idleNum_ increment of a worker going to sleep, it is either seen here or sees the task
+    if (idleNum_ > 0) {
+        {
+            std::lock_guard<std::mutex> lck(sleepMtx_);
+        }
+        sleepCond_.notify_one();
+    }
+}
+
+bool MxGstWorkStealingPool::TryPop(size_t index, Task& task)
+{
+    // the own tasks oldest first and the stolen ones newest first, so the owner and the thieves rarely meet and the
+    // oldest buffers, which the in-order sending waits for, run first
+    {
+        std::lock_guard<std::mutex> lck(workers_[index]->mtx);
+        if (!workers_[index]->tasks.empty()) {
+            task = std::move(workers_[index]->tasks.front());
+            workers_[index]->tasks.pop_front();
+            pendingNum_--;
+            return true;
+        }
+    }
+    for (size_t i = 1; i < workers_.size(); i++) {
+        Worker& victim = *workers_[(index + i) % workers_.size()];
+        std::lock_guard<std::mutex> lck(victim.mtx);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            pendingNum_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MxGstWorkStealingPool::Run(size_t index)
+{
+    g_workerPool = this;
+    g_workerIndex = index;
+    if (deviceId_ >= 0) {
+        DeviceContext device = {};
+        device.devId = deviceId_;
+        APP_ERROR ret = DeviceManager::GetInstance()->SetDevice(device);
+        if (ret != APP_ERR_OK) {
+            LogError << "Failed to bind worker " << index << " to device(" << deviceId_ << ")." << GetErrorInfo(ret);
+        }
+    }
+    while (true) {
+        Task task;
+        if (TryPop(index, task)) {
+            task();
+            continue;
+        }
+        std::unique_lock<std::mutex> lck(sleepMtx_);
+        idleNum_++;
+        sleepCond_.wait(lck, [this] { return pendingNum_ > 0 || stopped_; });
+        idleNum_--;
+        if (stopped_ && pendingNum_ == 0) {
+            break;
+        }
+    }
+}
+
+bool MxGstWorkStealingPool::RunPendingTask()
+{
+    Task task;
+    if (g_workerPool != this || !TryPop(g_workerIndex, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+bool MxGstWorkStealingPool::IsWorkerThread()
+{
+    return g_workerPool != nullptr;
+}
+
+MxGstExecutor::MxGstExecutor(const std::string& name, int deviceId, uint32_t parallelism, ProcessFunc processFunc,
+                             EmitFunc emitFunc)
+    : name_(name), pool_(MxGstWorkStealingPool::GetInstance(deviceId)), parallelism_(std::max(parallelism, 1u)),
+      maxInFlight_(parallelism_ * IN_FLIGHT_PER_TASK), processFunc_(std::move(processFunc)),
+      emitFunc_(std::move(emitFunc))
+{
+    LogInfo << "Element(" << name_ << ") runs on the work-stealing pool of device(" << deviceId
+            << ") with parallelism " << parallelism_ << ".";
+}
+
+MxGstExecutor::~MxGstExecutor()
+{
+    Drain();
+}
+
+void MxGstExecutor::Submit(size_t channel, MxpiBuffer* buffer)
+{
+    std::unique_lock<std::mutex> lck(mtx_);
+    bool isWorker = MxGstWorkStealingPool::IsWorkerThread();
+    while (inFlightNum_ >= maxInFlight_) {
+        if (!isWorker) {
+            cond_.wait(lck);
+            continue;
+        }
+        // an upstream parallel element sending, its worker runs queued tasks instead of holding a thread idle
+        lck.unlock();
+        bool ran = pool_.RunPendingTask();
+        lck.lock();
+        if (!ran) {
+            cond_.wait_for(lck, std::chrono::milliseconds(HELP_WAIT_TIME_MS));
+        }
+    }
+    while (channel >= channels_.size()) {
+        channels_.emplace_back(new Channel());
+        channels_.back()->index = channels_.size() - 1;
+    }
+    Channel* chn = channels_[channel].get();
+    pendingTasks_.push_back(Task {chn, chn->nextSeq++, buffer});
+    inFlightNum_++;
+    if (runningNum_ >= parallelism_) {
+        return;
+    }
+    runningNum_++;
+    lck.unlock();
+    pool_.Submit([this] { RunNext(); });
+}
+
+void MxGstExecutor::RunNext()
+{
+    Task task = {};
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        if (pendingTasks_.empty()) {
+            runningNum_--;
+            cond_.notify_all();
+            return;
+        }
+        task = pendingTasks_.front();
+        pendingTasks_.pop_front();
+    }
+    std::vector<Output> outputs;
+    // restored for the tasks run by a worker while it waits inside another task
+    const MxGstExecutor* lastExecutor = currentExecutor_;
+    std::vector<Output>* lastOutputs = currentOutputs_;
+    currentExecutor_ = this;
+    currentOutputs_ = &outputs;
+    processFunc_(task.channel->index, task.buffer);
+    currentExecutor_ = lastExecutor;
+    currentOutputs_ = lastOutputs;
+    Finish(*task.channel, task.seq, outputs);
+    {
+        std::lock_guard<std::mutex> lck(mtx_);
+        if (pendingTasks_.empty()) {
+            runningNum_--;
+            cond_.notify_all();
+            return;
+        }
+    }
+    // one buffer per turn, the tasks of the other elements queued meanwhile get the worker first
+    pool_.Submit([this] { RunNext(); });
+}
+
+void MxGstExecutor::Finish(Channel& channel, uint64_t seq, std::vector<Output>& outputs)
+{
+    std::unique_lock<std::mutex> lck(channel.mtx);
+    channel.doneOutputs[seq].swap(outputs);
+    if (channel.emitting) {
+        return;
+    }
+    // a single thread sends the outputs of a channel, the others leave theirs to it
+    channel.emitting = true;
+    while (!channel.doneOutputs.empty() && channel.doneOutputs.begin()->first == channel.emitSeq) {
+        std::vector<Output> readyOutputs;
+        readyOutputs.swap(channel.doneOutputs.begin()->second);
+        channel.doneOutputs.erase(channel.doneOutputs.begin());
+        channel.emitSeq++;
+        lck.unlock();
+        for (auto& output : readyOutputs) {
+            emitFunc_(output.index, output.buffer);
+        }
+        {
+            std::lock_guard<std::mutex> inFlightLck(mtx_);
+            inFlightNum_--;
+            cond_.notify_all();
+        }
+        lck.lock();
+    }
+    channel.emitting = false;
+}
+
+void MxGstExecutor::Drain()
+{
+    std::unique_lock<std::mutex> lck(mtx_);
+    bool isWorker = MxGstWorkStealingPool::IsWorkerThread();
+    while (inFlightNum_ > 0 || runningNum_ > 0) {
+        if (!isWorker) {
+            cond_.wait(lck);
+            continue;
+        }
+        lck.unlock();
+        bool ran = pool_.RunPendingTask();
+        lck.lock();
+        if (!ran) {
+            cond_.wait_for(lck, std::chrono::milliseconds(HELP_WAIT_TIME_MS));
+        }
+    }
+}
+
+bool MxGstExecutor::DeferOutput(const MxGstExecutor* executor, int index, GstBuffer* buffer)
+{
+    if (executor == nullptr || currentExecutor_ != executor) {
+        return false;
+    }
+    currentOutputs_->push_back(Output {index, buffer});
+    return true;
+}
+}
@@ -0,0 +1,175 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Work-stealing executor of the reentrant ASYNC elements, sends the outputs in input order.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MX_GST_EXECUTOR_H
+#define MX_GST_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gst/gst.h"
+#include "MxBase/Common/HiddenAttr.h"
+#include "MxTools/PluginToolkit/base/MxPluginBase.h"
+
+namespace MxTools {
+/**
+ * Thread pool shared by the elements of a device. Each worker owns a task queue, a worker without task steals from
+ * the queues of the others, so the busy elements get all the threads and the idle ones hold none.
+ */
+class SDK_UNAVAILABLE_FOR_OTHER MxGstWorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @description: The pool of the device, created on first use with one worker per cpu. The workers are bound to
+     * the device, deviceId -1 is the pool of the elements not using a device.
+     */
+    static MxGstWorkStealingPool& GetInstance(int deviceId);
+
+    MxGstWorkStealingPool(int deviceId, size_t threadNum);
+
+    ~MxGstWorkStealingPool();
+
+    void Submit(Task task);
+
+    /**
+     * @description: Run one queued task on the calling worker of the pool, for workers waiting on other tasks.
+     * @return: false when the caller is not a worker of the pool or no task is queued.
+     */
+    bool RunPendingTask();
+
+    static bool IsWorkerThread();
+
+    MxGstWorkStealingPool(const MxGstWorkStealingPool&) = delete;
+
+    MxGstWorkStealingPool& operator=(const MxGstWorkStealingPool&) = delete;
+
+private:
+    struct Worker {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void Run(size_t index);
+
+    bool TryPop(size_t index, Task& task);
+
+private:
+    int deviceId_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex sleepMtx_;
+    std::condition_variable sleepCond_;
+    std::atomic<size_t> pendingNum_ = {0};
+    std::atomic<size_t> idleNum_ = {0};
+    std::atomic<size_t> nextWorker_ = {0};
+    std::atomic<bool> stopped_ = {false};
+};
+
+/**
+ * Runs the buffers of an element on the pool of its device, at most parallelism at a time. Each sink pad is a
+ * channel whose buffers get sequence numbers, the outputs sent while processing a buffer are held back and pushed
+ * once the outputs of all earlier buffers of the channel are pushed.
+ */
+class SDK_UNAVAILABLE_FOR_OTHER MxGstExecutor {
+public:
+    using ProcessFunc = std::function<void(size_t channel, MxpiBuffer* buffer)>;
+    using EmitFunc = std::function<void(int index, GstBuffer* buffer)>;
+
+    MxGstExecutor(const std::string& name, int deviceId, uint32_t parallelism, ProcessFunc processFunc,
+                  EmitFunc emitFunc);
+
+    ~MxGstExecutor();
+
+    /**
+     * @description: Queue a buffer of the channel, blocks while 2 * parallelism buffers of the element are not sent.
+     * A worker of the pool runs the queued tasks while it waits, so chained parallel elements cannot starve the pool.
+     */
+    void Submit(size_t channel, MxpiBuffer* buffer);
+
+    /**
+     * @description: Wait until the outputs of all submitted buffers are pushed, before a serialized event is
+     * forwarded or the element is stopped.
+     */
+    void Drain();
+
+    /**
+     * @description: Hold back an output sent by the processing of a buffer of the element.
+     * @return: false when the calling thread is not processing a buffer of the element, the caller pushes it.
+     */
+    static bool DeferOutput(const MxGstExecutor* executor, int index, GstBuffer* buffer);
+
+    MxGstExecutor(const MxGstExecutor&) = delete;
+
+    MxGstExecutor& operator=(const MxGstExecutor&) = delete;
+
+private:
+    struct Output {
+        int index;
+        GstBuffer* buffer;
+    };
+
+    struct Channel {
+        size_t index = 0;
+        uint64_t nextSeq = 0;
+        std::mutex mtx;
+        uint64_t emitSeq = 0;
+        bool emitting = false;
+        std::map<uint64_t, std::vector<Output>> doneOutputs;
+    };
+
+    struct Task {
+        Channel* channel;
+        uint64_t seq;
+        MxpiBuffer* buffer;
+    };
+
+    void RunNext();
+
+    void Finish(Channel& channel, uint64_t seq, std::vector<Output>& outputs);
+
+private:
+    static thread_local const MxGstExecutor* currentExecutor_;
+    static thread_local std::vector<Output>* currentOutputs_;
+
+    std::string name_;
+    MxGstWorkStealingPool& pool_;
+    uint32_t parallelism_;
+    size_t maxInFlight_;
+    ProcessFunc processFunc_;
+    EmitFunc emitFunc_;
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    std::vector<std::unique_ptr<Channel>> channels_;
+    std::deque<Task> pendingTasks_;
+    uint32_t runningNum_ = 0;
+    size_t inFlightNum_ = 0;
+};
+}
+#endif // MX_GST_EXECUTOR_H
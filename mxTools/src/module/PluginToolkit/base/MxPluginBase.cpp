@@ -29,6 +29,7 @@
 #include "MxBase/ModelInfer/ModelInferenceProcessor.h"
 #include "MxTools/PluginToolkit/PerformanceStatistics/PerformanceStatisticsManager.h"
 #include "MxPluginBaseDptr.hpp"
+#include "MxGstExecutor.hpp"
 
 using namespace MxBase;
 
@@ -59,7 +60,10 @@ APP_ERROR MxPluginBase::RunProcess(std::vector<MxpiBuffer*>& mxpiBuffer)
         LogError << "invalid mxpiBuffer input. size must not be equal to 0!" << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
         return APP_ERR_COMM_OUT_OF_RANGE;
     }
-    errorInfo_.str("");
+    // the buffers of a reentrant plugin are processed at once, errorInfo_ is left to Process
+    if (!reentrant_) {
+        errorInfo_.str("");
+    }
     if (status_ == ASYNC) {
         ret = AsyncPreProcessCheck(mxpiBuffer);
         if (ret != APP_ERR_OK) {
@@ -74,8 +78,10 @@ APP_ERROR MxPluginBase::RunProcess(std::vector<MxpiBuffer*>& mxpiBuffer)
     try {
         Process(mxpiBuffer);
     } catch (const std::exception& e) {
-        errorInfo_ << "An Exception occurred. Error message: (" << e.what() << ").";
-        LogError << errorInfo_.str() << GetErrorInfo(APP_ERR_COMM_INNER);
+        std::ostringstream exceptionInfo;
+        std::ostringstream& errorInfo = reentrant_ ? exceptionInfo : errorInfo_;
+        errorInfo << "An Exception occurred. Error message: (" << e.what() << ").";
+        LogError << errorInfo.str() << GetErrorInfo(APP_ERR_COMM_INNER);
         DestroyExtraBuffers(mxpiBuffer, UINT32_MAX);
         InputParam inputParam = {};
         inputParam.key = "";
@@ -86,7 +92,7 @@ APP_ERROR MxPluginBase::RunProcess(std::vector<MxpiBuffer*>& mxpiBuffer)
             LogError << "Create null buffer failed." << GetErrorInfo(APP_ERR_COMM_INVALID_POINTER);
             return APP_ERR_COMM_INVALID_POINTER;
         }
-        SendMxpiErrorInfo(*outputMxpiBuffer, elementName_, APP_ERR_COMM_INNER, errorInfo_.str());
+        SendMxpiErrorInfo(*outputMxpiBuffer, elementName_, APP_ERR_COMM_INNER, errorInfo.str());
     }
     return APP_ERR_OK;
 }
@@ -214,6 +220,10 @@ APP_ERROR MxPluginBase::SendData(int index, MxpiBuffer& mxpiBuffer)
                  << GetErrorInfo(APP_ERR_COMM_INVALID_PARAM);
         return APP_ERR_COMM_INVALID_PARAM;
     }
+    // sent from a buffer processed on the work-stealing pool, pushed after the outputs of the earlier buffers
+    if (MxGstExecutor::DeferOutput(filter->executor, index, outBuffer)) {
+        return APP_ERR_OK;
+    }
 
     bool isExist = IsStreamElementNameExist(reinterpret_cast<uintptr_t>(filter));
     if (isExist) {
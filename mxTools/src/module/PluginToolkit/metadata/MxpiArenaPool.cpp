@@ -0,0 +1,97 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Pool of the protobuf arenas holding the proto metadatas of the buffers.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include "MxpiArenaPool.h"
+#include "MxBase/Log/Log.h"
+
+namespace {
+// an object list of a few tens of objects fits in the initial block
+const size_t INITIAL_BLOCK_SIZE = 16 * 1024;
+const size_t MAX_BLOCK_SIZE = 256 * 1024;
+const size_t MAX_IDLE_ARENA_NUM = 256;
+}
+
+namespace MxTools {
+MxpiArenaPool& MxpiArenaPool::GetInstance()
+{
+    // never destroyed, the buffers released at exit may still return their arenas
+    static MxpiArenaPool* instance = new MxpiArenaPool();
+    return *instance;
+}
+
+std::unique_ptr<MxpiArenaPool::PooledArena> MxpiArenaPool::CreateArena()
+{
+    std::unique_ptr<PooledArena> pooledArena(new (std::nothrow) PooledArena());
+    if (pooledArena == nullptr) {
+        return nullptr;
+    }
+    pooledArena->initialBlock.reset(new (std::nothrow) char[INITIAL_BLOCK_SIZE]);
+    if (pooledArena->initialBlock == nullptr) {
+        return nullptr;
+    }
+    google::protobuf::ArenaOptions options;
+    options.initial_block = pooledArena->initialBlock.get();
+    options.initial_block_size = INITIAL_BLOCK_SIZE;
+    options.max_block_size = MAX_BLOCK_SIZE;
+    pooledArena->arena.reset(new (std::nothrow) google::protobuf::Arena(options));
+    if (pooledArena->arena == nullptr) {
+        return nullptr;
+    }
+    return pooledArena;
+}
+
+std::shared_ptr<google::protobuf::Arena> MxpiArenaPool::Acquire()
+{
+    std::unique_ptr<PooledArena> pooledArena;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idleArenas_.empty()) {
+            pooledArena = std::move(idleArenas_.back());
+            idleArenas_.pop_back();
+        }
+    }
+    if (pooledArena == nullptr) {
+        pooledArena = CreateArena();
+        if (pooledArena == nullptr) {
+            LogError << "Create protobuf arena failed. Failed to allocate memory."
+                     << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+            return nullptr;
+        }
+    }
+    PooledArena* rawArena = pooledArena.get();
+    std::shared_ptr<google::protobuf::Arena> arena(rawArena->arena.get(),
+        [this, rawArena](google::protobuf::Arena*) { Release(rawArena); });
+    pooledArena.release();
+    return arena;
+}
+
+void MxpiArenaPool::Release(PooledArena* pooledArena)
+{
+    std::unique_ptr<PooledArena> releasedArena(pooledArena);
+    // the messages are destroyed together, the blocks besides the initial one are freed
+    releasedArena->arena->Reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idleArenas_.size() < MAX_IDLE_ARENA_NUM) {
+        idleArenas_.push_back(std::move(releasedArena));
+    }
+}
+}
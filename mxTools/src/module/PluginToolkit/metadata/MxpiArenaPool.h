@@ -0,0 +1,62 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Pool of the protobuf arenas holding the proto metadatas of the buffers.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#ifndef MXPI_ARENA_POOL_H
+#define MXPI_ARENA_POOL_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <google/protobuf/arena.h>
+#include "MxBase/Common/HiddenAttr.h"
+
+namespace MxTools {
+/**
+ * Each arena owns an initial block, so an arena taken back from the pool serves the metadatas of a buffer without
+ * allocating. An arena is reset and returned to the pool when the last message created on it is released.
+ */
+class SDK_UNAVAILABLE_FOR_OTHER MxpiArenaPool {
+public:
+    static MxpiArenaPool& GetInstance();
+
+    std::shared_ptr<google::protobuf::Arena> Acquire();
+
+private:
+    struct PooledArena {
+        std::unique_ptr<char[]> initialBlock;
+        std::unique_ptr<google::protobuf::Arena> arena;
+    };
+
+    MxpiArenaPool() = default;
+    ~MxpiArenaPool() = default;
+    MxpiArenaPool(const MxpiArenaPool &) = delete;
+    MxpiArenaPool& operator=(const MxpiArenaPool &) = delete;
+
+    std::unique_ptr<PooledArena> CreateArena();
+    void Release(PooledArena* pooledArena);
+
+private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<PooledArena>> idleArenas_;
+};
+}
+#endif // MXPI_ARENA_POOL_H
@@ -28,6 +28,7 @@
 #include "MxBase/MemoryHelper/MemoryHelper.h"
 #include "MxBase/Utils/StringUtils.h"
 #include "MxpiMetadataManagerDptr.hpp"
+#include "MxpiArenaPool.h"
 #include "MxBase/ErrorCode/ErrorCode.h"
 
 using namespace MxTools;
@@ -39,7 +40,7 @@ const std::string ERROR_INFO_KEY = "ErrorInfo";
 using errorFunc = std::string(*)(const APP_ERROR err, std::string callingFuncName);
 static errorFunc GetErrorInfos = GetErrorInfo;
 const std::vector<std::string> invalidKeys = {
-    "ReserveMetadataGraph", "ReservedVisionList", "ErrorInfo"
+    "ReserveMetadataGraph", "ReservedVisionList", "ErrorInfo", "ReservedMetadataViews"
 };
 static bool HasInvalidKey(std::string key)
 {
@@ -50,6 +51,51 @@ static bool HasInvalidKey(std::string key)
     }
     return false;
 }
+
+// whether the proto metadata is a list whose members have headerVec as first field, as the metadata graph expects
+bool IsProtoNodeList(const google::protobuf::Message& nodeListMessage)
+{
+    const google::protobuf::Descriptor* desc = nodeListMessage.GetDescriptor();
+    if (desc == nullptr || desc->field_count() == 0 || !desc->field(0)->is_repeated() ||
+        desc->field(0)->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+        return false;
+    }
+    const google::protobuf::Descriptor* nodeDesc = desc->field(0)->message_type();
+    return nodeDesc != nullptr && nodeDesc->field_count() != 0 && nodeDesc->field(0)->name() == "headerVec" &&
+        nodeDesc->field(0)->is_repeated() && nodeDesc->field(0)->message_type() == MxpiMetaHeader::descriptor();
+}
+
+// whether a member of the proto metadata list names one of the pending keys as data source in its headerVec
+bool DependsOnPendingKeys(const google::protobuf::Message& nodeListMessage,
+    const std::map<std::string, std::shared_ptr<google::protobuf::Message>>& pendingMap)
+{
+    const google::protobuf::Descriptor* desc = nodeListMessage.GetDescriptor();
+    const google::protobuf::Reflection* refl = nodeListMessage.GetReflection();
+    if (desc == nullptr || refl == nullptr || desc->field_count() == 0 || !desc->field(0)->is_repeated() ||
+        desc->field(0)->cpp_type() != google::protobuf::FieldDescriptor::CPPTYPE_MESSAGE) {
+        return false;
+    }
+    const google::protobuf::FieldDescriptor* field = desc->field(0);
+    for (int i = 0; i < refl->FieldSize(nodeListMessage, field); i++) {
+        const google::protobuf::Message& nodeMessage = refl->GetRepeatedMessage(nodeListMessage, field, i);
+        const google::protobuf::Descriptor* nodeDesc = nodeMessage.GetDescriptor();
+        const google::protobuf::Reflection* nodeRefl = nodeMessage.GetReflection();
+        if (nodeDesc == nullptr || nodeRefl == nullptr || nodeDesc->field_count() == 0 ||
+            nodeDesc->field(0)->name() != "headerVec") {
+            return false;
+        }
+        const google::protobuf::FieldDescriptor* headerField = nodeDesc->field(0);
+        for (int j = 0; j < nodeRefl->FieldSize(nodeMessage, headerField); j++) {
+            auto* metaHeader = (const MxpiMetaHeader*)&nodeRefl->GetRepeatedMessage(nodeMessage, headerField, j);
+            std::string dataSource = metaHeader->datasource().empty() ? metaHeader->parentname() :
+                metaHeader->datasource();
+            if (pendingMap.find(dataSource) != pendingMap.end()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
 }
 
 MxpiMetadataManager::MxpiMetadataManager(MxpiBuffer& mxpiBuffer)
@@ -90,6 +136,26 @@ APP_ERROR MxpiMetadataManager::AddMetadata(const std::string& key, std::shared_p
     return pMxpiMetadataManagerDptr_->AddMetadataInternal(key, metadata, currentMetaInfo);
 }
 
+std::shared_ptr<google::protobuf::Arena> MxpiMetadataManager::GetArena()
+{
+    MxpiAiInfos* currentMetaInfo = nullptr;
+    APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
+    if (ret != APP_ERR_OK) {
+        return nullptr;
+    }
+    // the arena is kept among the metadatas of the buffer, as MxpiAiInfos is a public struct
+    std::unique_lock<std::mutex> lock(*currentMetaInfo->metadataMutex);
+    auto iter = currentMetaInfo->mxpiAiInfoMap.find(RESERVED_METADATA_ARENA_KEY);
+    if (iter != currentMetaInfo->mxpiAiInfoMap.end()) {
+        return std::static_pointer_cast<google::protobuf::Arena>(iter->second);
+    }
+    std::shared_ptr<google::protobuf::Arena> arena = MxpiArenaPool::GetInstance().Acquire();
+    if (arena != nullptr) {
+        currentMetaInfo->mxpiAiInfoMap[RESERVED_METADATA_ARENA_KEY] = arena;
+    }
+    return arena;
+}
+
 APP_ERROR MxpiMetadataManager::AddProtoMetadata(const std::string& key, std::shared_ptr<void> metadata)
 {
     if (MxBase::StringUtils::HasInvalidChar(key)) {
@@ -117,7 +183,7 @@ APP_ERROR MxpiMetadataManager::AddProtoMetadata(const std::string& key, std::sha
     }
     std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
     MxpiAiPMetaData mxpiAiPMetaData {currentMetaInfo};
-    if (HadProtobufKey(mxpiAiPMetaData, key)) {
+    if (HadProtobufKey(mxpiAiPMetaData, key) || pMxpiMetadataManagerDptr_->HasViewInternal(key, currentMetaInfo)) {
         LogWarn << "Already has the metadata key(" << key <<"), can't add it again.";
         return APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST;
     }
@@ -132,6 +198,99 @@ APP_ERROR MxpiMetadataManager::AddProtoMetadata(const std::string& key, std::sha
     return APP_ERR_OK;
 }
 
+APP_ERROR MxpiMetadataManager::AddProtoMetadataView(const std::string& key, const std::string& parentKey,
+    const std::vector<int>& memberIds)
+{
+    if (MxBase::StringUtils::HasInvalidChar(key) || MxBase::StringUtils::HasInvalidChar(parentKey)) {
+        LogError << "Input key or parentKey has invalid char." << GetErrorInfos(APP_ERR_COMM_INVALID_PARAM, "");
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    if (HasInvalidKey(key)) {
+        LogError << "Input key has invalid key." << GetErrorInfos(APP_ERR_COMM_INVALID_PARAM, "");
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    LogDebug << "Begin to add a metadata view(" << key << ") of the metadata(" << parentKey << ") on the buffer.";
+    if (key.empty() || parentKey.empty()) {
+        LogError << "The key cannot be empty." << GetErrorInfos(APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_EMPTY, "");
+        return APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_EMPTY;
+    }
+    MxpiAiInfos* currentMetaInfo = nullptr;
+    APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
+    // a parent which is a view itself is built first, the lock is released meanwhile
+    std::shared_ptr<void> parentView;
+    ret = pMxpiMetadataManagerDptr_->MaterializeViewInternal(parentKey, currentMetaInfo, sendDataLock, parentView);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    auto parent = std::static_pointer_cast<google::protobuf::Message>(parentView);
+    MxpiAiPMetaData mxpiAiPMetaData {currentMetaInfo};
+    if (HadProtobufKey(mxpiAiPMetaData, key) || pMxpiMetadataManagerDptr_->HasViewInternal(key, currentMetaInfo)) {
+        LogWarn << "Already has the metadata key(" << key <<"), can't add it again.";
+        return APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST;
+    }
+    auto iter = currentMetaInfo->mxpiProtobufMap.find(parentKey);
+    if (parent == nullptr && iter != currentMetaInfo->mxpiProtobufMap.end()) {
+        parent = iter->second;
+    }
+    if (parent == nullptr || !IsProtoNodeList(*parent)) {
+        LogError << "The metadata(" << parentKey << ") is not a proto metadata list."
+                 << GetErrorInfos(APP_ERR_COMM_INVALID_PARAM, "");
+        return APP_ERR_COMM_INVALID_PARAM;
+    }
+    int memberNum = parent->GetReflection()->FieldSize(*parent, parent->GetDescriptor()->field(0));
+    for (int memberId : memberIds) {
+        if (memberId < 0 || memberId >= memberNum) {
+            LogError << "The member id(" << memberId << ") is out of the range of the metadata(" << parentKey
+                     << "), which has " << memberNum << " members." << GetErrorInfos(APP_ERR_COMM_OUT_OF_RANGE, "");
+            return APP_ERR_COMM_OUT_OF_RANGE;
+        }
+    }
+    auto view = MxBase::MemoryHelper::MakeShared<MxpiMetadataView>();
+    auto views = pMxpiMetadataManagerDptr_->GetViewMapInternal(currentMetaInfo, true);
+    if (view == nullptr || views == nullptr) {
+        LogError << "Create MxpiMetadataView object failed. Failed to allocate memory."
+                 << GetErrorInfos(APP_ERR_COMM_ALLOC_MEM, "");
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    view->parent = parent;
+    view->parentKey = parentKey;
+    view->memberIds = memberIds;
+    (*views)[key] = view;
+    LogDebug << "End to add a metadata view(" << key << ") on the buffer.";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiMetadataManager::MaterializeMetadataViews()
+{
+    MxpiAiInfos* currentMetaInfo = nullptr;
+    APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
+    if (ret != APP_ERR_OK) {
+        return ret;
+    }
+    std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
+    auto views = pMxpiMetadataManagerDptr_->GetViewMapInternal(currentMetaInfo, false);
+    if (views == nullptr) {
+        return APP_ERR_OK;
+    }
+    std::vector<std::string> keys;
+    for (auto it = views->begin(); it != views->end(); it++) {
+        keys.push_back(it->first);
+    }
+    APP_ERROR result = APP_ERR_OK;
+    for (auto& key : keys) {
+        std::shared_ptr<void> metadata;
+        ret = pMxpiMetadataManagerDptr_->MaterializeViewInternal(key, currentMetaInfo, sendDataLock, metadata);
+        if (ret != APP_ERR_OK) {
+            result = ret;
+        }
+    }
+    return result;
+}
+
 std::shared_ptr<void> MxpiMetadataManager::GetMetadata(const std::string& key)
 {
     if (MxBase::StringUtils::HasInvalidChar(key)) {
@@ -150,7 +309,12 @@ std::shared_ptr<void> MxpiMetadataManager::GetMetadata(const std::string& key)
         return nullptr;
     }
     std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
-    return pMxpiMetadataManagerDptr_->GetMetadataInternal(key, currentMetaInfo);
+    auto metadata = pMxpiMetadataManagerDptr_->GetMetadataInternal(key, currentMetaInfo);
+    if (metadata != nullptr) {
+        return metadata;
+    }
+    pMxpiMetadataManagerDptr_->MaterializeViewInternal(key, currentMetaInfo, sendDataLock, metadata);
+    return metadata;
 }
 
 std::shared_ptr<void> MxpiMetadataManager::GetMetadataWithType(const std::string& key, std::string type)
@@ -218,6 +382,10 @@ APP_ERROR MxpiMetadataManager::RemoveProtoMetadata(const std::string& key)
         return ret;
     }
     std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
+    // a view not got yet was never added to the metadata graph
+    if (pMxpiMetadataManagerDptr_->RemoveViewInternal(key, currentMetaInfo)) {
+        return APP_ERR_OK;
+    }
 
     ret = pMxpiMetadataManagerDptr_->RemoveMetadataInternal(key, currentMetaInfo);
     if (ret != APP_ERR_OK) {
@@ -264,19 +432,186 @@ APP_ERROR MxpiMetadataManager::CopyMetadata(MxpiBuffer& targetMxpiBuffer)
         LogError << "targetMetaData is nullptr." << GetErrorInfos(APP_ERR_COMM_FAILURE, "");
         return APP_ERR_PLUGIN_TOOLKIT_METADATA_IS_NULL;
     }
+    // the target keeps its own arena, the copied messages keep the one they are created on alive
+    metaDataMap.erase(RESERVED_METADATA_ARENA_KEY);
     for (auto it = metaDataMap.begin(); it != metaDataMap.end(); it++) {
         targetMetaData->mxpiAiInfoMap[it->first] = it->second;
     }
     for (auto it = protobufMap.begin(); it != protobufMap.end(); it++) {
         targetMetaData->mxpiProtobufMap[it->first] = it->second;
     }
+    auto views = pMxpiMetadataManagerDptr_->GetViewMapInternal(currentMetaInfo, false);
+    if (views != nullptr) {
+        auto targetViews = MxBase::MemoryHelper::MakeShared<MxpiMetadataViewMap>(*views);
+        if (targetViews == nullptr) {
+            LogError << "Create map of MxpiMetadataView object failed. Failed to allocate memory."
+                     << GetErrorInfos(APP_ERR_COMM_ALLOC_MEM, "");
+            return APP_ERR_COMM_ALLOC_MEM;
+        }
+        targetMetaData->mxpiAiInfoMap[RESERVED_METADATA_VIEWS_KEY] = targetViews;
+    }
     LogDebug << "End to copy metadatas from source buffer to target buffer.";
     return APP_ERR_OK;
 }
 
+APP_ERROR MxpiMetadataManager::ShareMetadata(MxpiBuffer& targetMxpiBuffer)
+{
+    LogDebug << "Begin to share metadatas from source buffer to target buffer.";
+    if (targetMxpiBuffer.buffer == nullptr) {
+        LogError << "targetMxpiBuffer is nullptr." << GetErrorInfos(APP_ERR_COMM_FAILURE, "");
+        return APP_ERR_PLUGIN_TOOLKIT_METADATA_BUFFER_IS_NULL;
+    }
+    if (targetMxpiBuffer.buffer == pMxpiMetadataManagerDptr_->mxpiBuffer_.buffer) {
+        return APP_ERR_OK;
+    }
+    MxpiAiInfos* currentMetaInfo = nullptr;
+    APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
+    if (ret != APP_ERR_OK) {
+        LogError << "GetMxpiMetaInfos failed." << GetErrorInfos(ret, "");
+        return ret;
+    }
+    MxpiMetadataManager targetManager(targetMxpiBuffer);
+    MxpiAiInfos* targetMetaInfo = nullptr;
+    ret = targetManager.pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(targetMetaInfo);
+    if (ret != APP_ERR_OK) {
+        LogError << "GetMxpiMetaInfos of the target buffer failed." << GetErrorInfos(ret, "");
+        return ret;
+    }
+    // the two buffers are never locked together, so sharing in both directions at once can not dead lock
+    std::unique_lock<std::mutex> sourceLock(*currentMetaInfo->metadataMutex);
+    auto metaDataMap = currentMetaInfo->mxpiAiInfoMap;
+    auto protobufMap = currentMetaInfo->mxpiProtobufMap;
+    MxpiMetadataViewMap views;
+    auto viewsPtr = pMxpiMetadataManagerDptr_->GetViewMapInternal(currentMetaInfo, false);
+    if (viewsPtr != nullptr) {
+        views = *viewsPtr;
+    }
+    sourceLock.unlock();
+    metaDataMap.erase(RESERVE_METADATA_GRAPH_KEY);
+    metaDataMap.erase(ERROR_INFO_KEY);
+    metaDataMap.erase(RESERVED_METADATA_VIEWS_KEY);
+    metaDataMap.erase(RESERVED_METADATA_ARENA_KEY);
+
+    std::unique_lock<std::mutex> targetLock(*targetMetaInfo->metadataMutex);
+    targetMetaInfo->mxpiAiInfoMap.insert(metaDataMap.begin(), metaDataMap.end());
+    targetMetaInfo->mxpiProtobufMap.insert(protobufMap.begin(), protobufMap.end());
+    targetManager.pMxpiMetadataManagerDptr_->AddViewsInternal(views, targetMetaInfo);
+    LogDebug << "End to share metadatas from source buffer to target buffer.";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiMetadataManager::MergeMetadata(MxpiBuffer& sourceMxpiBuffer)
+{
+    LogDebug << "Begin to merge metadatas from source buffer.";
+    if (sourceMxpiBuffer.buffer == nullptr) {
+        LogError << "sourceMxpiBuffer is nullptr." << GetErrorInfos(APP_ERR_COMM_FAILURE, "");
+        return APP_ERR_PLUGIN_TOOLKIT_METADATA_BUFFER_IS_NULL;
+    }
+    if (sourceMxpiBuffer.buffer == pMxpiMetadataManagerDptr_->mxpiBuffer_.buffer) {
+        return APP_ERR_OK;
+    }
+    MxpiMetaData sourceMxpiMetaData {sourceMxpiBuffer.buffer};
+    auto sourceMetaInfo = (MxpiAiInfos*) MxpiMetaGet(sourceMxpiMetaData);
+    if (sourceMetaInfo == nullptr) {
+        return APP_ERR_OK;
+    }
+    MxpiAiInfos* currentMetaInfo = nullptr;
+    APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
+    if (ret != APP_ERR_OK) {
+        LogError << "GetMxpiMetaInfos failed." << GetErrorInfos(ret, "");
+        return ret;
+    }
+    std::unique_lock<std::mutex> sourceLock(*sourceMetaInfo->metadataMutex);
+    auto metaDataMap = sourceMetaInfo->mxpiAiInfoMap;
+    auto pendingMap = sourceMetaInfo->mxpiProtobufMap;
+    std::map<std::string, MxpiErrorInfo> errorInfoMap;
+    auto errorInfoIter = metaDataMap.find(ERROR_INFO_KEY);
+    if (errorInfoIter != metaDataMap.end() && errorInfoIter->second != nullptr) {
+        errorInfoMap = *std::static_pointer_cast<std::map<std::string, MxpiErrorInfo>>(errorInfoIter->second);
+    }
+    MxpiMetadataViewMap views;
+    auto viewsIter = metaDataMap.find(RESERVED_METADATA_VIEWS_KEY);
+    if (viewsIter != metaDataMap.end() && viewsIter->second != nullptr) {
+        views = *std::static_pointer_cast<MxpiMetadataViewMap>(viewsIter->second);
+    }
+    sourceLock.unlock();
+    metaDataMap.erase(RESERVE_METADATA_GRAPH_KEY);
+    metaDataMap.erase(ERROR_INFO_KEY);
+    metaDataMap.erase(RESERVED_METADATA_VIEWS_KEY);
+    metaDataMap.erase(RESERVED_METADATA_ARENA_KEY);
+
+    std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
+    APP_ERROR result = APP_ERR_OK;
+    auto isConflict = [&currentMetaInfo, &result](const std::string& key, const std::shared_ptr<void>& value) {
+        auto iter1 = currentMetaInfo->mxpiAiInfoMap.find(key);
+        auto iter2 = currentMetaInfo->mxpiProtobufMap.find(key);
+        if (iter1 == currentMetaInfo->mxpiAiInfoMap.end() && iter2 == currentMetaInfo->mxpiProtobufMap.end()) {
+            return false;
+        }
+        bool sameValue = (iter1 != currentMetaInfo->mxpiAiInfoMap.end() && iter1->second == value) ||
+            (iter2 != currentMetaInfo->mxpiProtobufMap.end() && iter2->second == value);
+        if (!sameValue) {
+            LogWarn << "Both buffers have the metadata key(" << key << ") with different values, keep the old one.";
+            result = APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST;
+        }
+        return true;
+    };
+    for (auto it = metaDataMap.begin(); it != metaDataMap.end(); it++) {
+        if (!isConflict(it->first, it->second)) {
+            currentMetaInfo->mxpiAiInfoMap[it->first] = it->second;
+        }
+    }
+    for (auto it = pendingMap.begin(); it != pendingMap.end();) {
+        it = isConflict(it->first, it->second) ? pendingMap.erase(it) : std::next(it);
+    }
+    if (!pendingMap.empty()) {
+        auto mxpiMetadataGraph = pMxpiMetadataManagerDptr_->GetMetadataGraphInstanceInternal(currentMetaInfo);
+        if (mxpiMetadataGraph == nullptr) {
+            LogError << "mxpiMetadataGraph pointer is nullptr." << GetErrorInfos(APP_ERR_COMM_INVALID_POINTER, "");
+            return APP_ERR_COMM_INVALID_POINTER;
+        }
+        // a proto metadata is linked to its data sources only when they are in the graph already
+        while (!pendingMap.empty()) {
+            auto it = pendingMap.begin();
+            while (it != pendingMap.end() && DependsOnPendingKeys(*it->second, pendingMap)) {
+                it++;
+            }
+            it = (it == pendingMap.end()) ? pendingMap.begin() : it;
+            currentMetaInfo->mxpiProtobufMap[it->first] = it->second;
+            mxpiMetadataGraph->AddNodeList(it->first, it->second);
+            pendingMap.erase(it);
+        }
+    }
+    if (pMxpiMetadataManagerDptr_->AddViewsInternal(views, currentMetaInfo)) {
+        LogWarn << "Both buffers have metadata views with the same key and different values, keep the old ones.";
+        result = APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST;
+    }
+    if (!errorInfoMap.empty()) {
+        auto metadataPtr = pMxpiMetadataManagerDptr_->GetMetadataInternal(ERROR_INFO_KEY, currentMetaInfo);
+        if (metadataPtr == nullptr) {
+            auto mxpiErrorInfoPtr = MxBase::MemoryHelper::MakeShared<std::map<std::string, MxpiErrorInfo>>();
+            if (mxpiErrorInfoPtr == nullptr) {
+                LogError << "Create map of MxpiErrorInfo object failed. Failed to allocate memory."
+                         << GetErrorInfos(APP_ERR_COMM_ALLOC_MEM, "");
+                return APP_ERR_COMM_ALLOC_MEM;
+            }
+            currentMetaInfo->mxpiAiInfoMap[ERROR_INFO_KEY] = mxpiErrorInfoPtr;
+            metadataPtr = mxpiErrorInfoPtr;
+        }
+        std::static_pointer_cast<std::map<std::string, MxpiErrorInfo>>(metadataPtr)->insert(
+            errorInfoMap.begin(), errorInfoMap.end());
+    }
+    LogDebug << "End to merge metadatas from source buffer.";
+    return result;
+}
+
 std::shared_ptr<MxpiMetadataGraph> MxpiMetadataManager::GetMetadataGraphInstance()
 {
     LogDebug << "Begin to get metadata graph instance.";
+    // the graph links every proto metadata of the buffer, so the views are built before it is read
+    if (MaterializeMetadataViews() != APP_ERR_OK) {
+        LogWarn << "Failed to build the metadata views, they are missing in the metadata graph.";
+    }
     MxpiAiInfos* currentMetaInfo = nullptr;
     APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
     if (ret != APP_ERR_OK) {
@@ -349,6 +684,9 @@ std::shared_ptr<std::map<std::string, MxpiErrorInfo>> MxpiMetadataManager::GetEr
 std::map<std::string, std::shared_ptr<void>> MxpiMetadataManager::GetAllMetaData()
 {
     LogDebug << "Begin to get all metadata.";
+    if (MaterializeMetadataViews() != APP_ERR_OK) {
+        LogWarn << "Failed to build the metadata views, they are missing in the metadata.";
+    }
     MxpiAiInfos* currentMetaInfo = nullptr;
     APP_ERROR ret = pMxpiMetadataManagerDptr_->GetMxpiMetaInfos(currentMetaInfo);
     if (ret != APP_ERR_OK) {
@@ -357,6 +695,8 @@ std::map<std::string, std::shared_ptr<void>> MxpiMetadataManager::GetAllMetaData
     std::unique_lock<std::mutex> sendDataLock(*currentMetaInfo->metadataMutex);
     auto allMetaMap = currentMetaInfo->mxpiAiInfoMap;
     allMetaMap.insert(currentMetaInfo->mxpiProtobufMap.begin(), currentMetaInfo->mxpiProtobufMap.end());
+    allMetaMap.erase(RESERVED_METADATA_VIEWS_KEY);
+    allMetaMap.erase(RESERVED_METADATA_ARENA_KEY);
 
     return allMetaMap;
 }
@@ -24,11 +24,26 @@
 
 namespace {
 const std::string RESERVE_METADATA_GRAPH_KEY = "ReserveMetadataGraph";
+const std::string RESERVED_METADATA_VIEWS_KEY = "ReservedMetadataViews";
+const std::string RESERVED_METADATA_ARENA_KEY = "ReservedMetadataArena";
 }
 
 namespace MxTools {
 struct MxpiAiInfos;
 
+// members of a proto metadata list held by reference, copied into a list of their own when first got.
+// The copy reads the parent without the lock of the buffer: the parent list must not be changed while views of it
+// are pending, as the plugins downstream of the one who added it only read it.
+struct MxpiMetadataView {
+    std::shared_ptr<google::protobuf::Message> parent;
+    std::string parentKey;
+    std::vector<int> memberIds;
+    std::mutex buildMutex;
+    std::shared_ptr<google::protobuf::Message> value;
+};
+
+using MxpiMetadataViewMap = std::map<std::string, std::shared_ptr<MxpiMetadataView>>;
+
 class SDK_UNAVAILABLE_FOR_OTHER MxpiMetadataManagerDptr {
 public:
     APP_ERROR GetMxpiMetaInfos(MxpiAiInfos* &currentMetaInfo);
@@ -41,6 +56,19 @@ public:
 
     APP_ERROR RemoveMetadataInternal(const std::string &key, MxpiAiInfos *metaData);
 
+    std::shared_ptr<MxpiMetadataViewMap> GetViewMapInternal(MxpiAiInfos *currentMetaInfo, bool create);
+
+    bool HasViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo);
+
+    bool RemoveViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo);
+
+    bool AddViewsInternal(const MxpiMetadataViewMap &views, MxpiAiInfos *currentMetaInfo);
+
+    APP_ERROR MaterializeViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo,
+        std::unique_lock<std::mutex> &metadataLock, std::shared_ptr<void> &metadata);
+
+    static APP_ERROR BuildView(MxpiMetadataView &view, std::shared_ptr<google::protobuf::Message> &value);
+
     MxpiBuffer mxpiBuffer_;
 };
 
@@ -96,7 +124,7 @@ APP_ERROR MxpiMetadataManagerDptr::AddMetadataInternal(const std::string &key, s
     MxpiAiInfos *currentMetaInfo)
 {
     MxpiAiPMetaData mxpiAiPMetaData {currentMetaInfo};
-    if (HadProtobufKey(mxpiAiPMetaData, key)) {
+    if (HadProtobufKey(mxpiAiPMetaData, key) || HasViewInternal(key, currentMetaInfo)) {
         LogWarn << "Already has the metadata key(" << key <<"), can't add it again.";
         return APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST;
     }
@@ -128,6 +156,10 @@ std::shared_ptr<MxpiMetadataGraph> MxpiMetadataManagerDptr::GetMetadataGraphInst
 
 APP_ERROR MxpiMetadataManagerDptr::RemoveMetadataInternal(const std::string &key, MxpiAiInfos *metaData)
 {
+    if (RemoveViewInternal(key, metaData)) {
+        LogDebug << "End to remove the metadata view(" << key << ") from the buffer.";
+        return APP_ERR_OK;
+    }
     MxpiAiPMetaData mxpiAiPMetaData {metaData};
     if (!HadProtobufKey(mxpiAiPMetaData, key)) {
         return APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_NOEXIST;
@@ -153,6 +185,148 @@ APP_ERROR MxpiMetadataManagerDptr::RemoveMetadataInternal(const std::string &key
     LogDebug << "End to remove the metadata(" << key << ") from the buffer.";
     return APP_ERR_OK;
 }
+
+std::shared_ptr<MxpiMetadataViewMap> MxpiMetadataManagerDptr::GetViewMapInternal(MxpiAiInfos *currentMetaInfo,
+    bool create)
+{
+    auto iter = currentMetaInfo->mxpiAiInfoMap.find(RESERVED_METADATA_VIEWS_KEY);
+    if (iter != currentMetaInfo->mxpiAiInfoMap.end()) {
+        return std::static_pointer_cast<MxpiMetadataViewMap>(iter->second);
+    }
+    if (!create) {
+        return nullptr;
+    }
+    auto views = MxBase::MemoryHelper::MakeShared<MxpiMetadataViewMap>();
+    if (views == nullptr) {
+        LogError << "Create map of MxpiMetadataView object failed. Failed to allocate memory."
+                 << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return nullptr;
+    }
+    currentMetaInfo->mxpiAiInfoMap[RESERVED_METADATA_VIEWS_KEY] = views;
+    return views;
+}
+
+bool MxpiMetadataManagerDptr::HasViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo)
+{
+    auto views = GetViewMapInternal(currentMetaInfo, false);
+    return views != nullptr && views->find(key) != views->end();
+}
+
+bool MxpiMetadataManagerDptr::RemoveViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo)
+{
+    auto views = GetViewMapInternal(currentMetaInfo, false);
+    if (views == nullptr || views->erase(key) == 0) {
+        return false;
+    }
+    if (views->empty()) {
+        currentMetaInfo->mxpiAiInfoMap.erase(RESERVED_METADATA_VIEWS_KEY);
+    }
+    return true;
+}
+
+bool MxpiMetadataManagerDptr::AddViewsInternal(const MxpiMetadataViewMap &views, MxpiAiInfos *currentMetaInfo)
+{
+    // the views are immutable until built and build once, so the buffers can hold the same ones
+    bool isConflict = false;
+    for (auto it = views.begin(); it != views.end(); it++) {
+        MxpiAiPMetaData mxpiAiPMetaData {currentMetaInfo};
+        auto currentViews = GetViewMapInternal(currentMetaInfo, false);
+        if (currentViews != nullptr && currentViews->find(it->first) != currentViews->end()) {
+            isConflict = isConflict || (*currentViews)[it->first] != it->second;
+            continue;
+        }
+        if (HadProtobufKey(mxpiAiPMetaData, it->first)) {
+            auto iter = currentMetaInfo->mxpiProtobufMap.find(it->first);
+            isConflict = isConflict || iter == currentMetaInfo->mxpiProtobufMap.end() ||
+                iter->second != it->second->value;
+            continue;
+        }
+        currentViews = GetViewMapInternal(currentMetaInfo, true);
+        if (currentViews == nullptr) {
+            return isConflict;
+        }
+        (*currentViews)[it->first] = it->second;
+    }
+    return isConflict;
+}
+
+APP_ERROR MxpiMetadataManagerDptr::MaterializeViewInternal(const std::string &key, MxpiAiInfos *currentMetaInfo,
+    std::unique_lock<std::mutex> &metadataLock, std::shared_ptr<void> &metadata)
+{
+    auto views = GetViewMapInternal(currentMetaInfo, false);
+    if (views == nullptr || views->find(key) == views->end()) {
+        return APP_ERR_OK;
+    }
+    std::shared_ptr<MxpiMetadataView> view = (*views)[key];
+    // the copy runs without the lock of the buffer, so the branches sharing the buffer build their views together
+    metadataLock.unlock();
+    std::shared_ptr<google::protobuf::Message> value;
+    APP_ERROR ret = BuildView(*view, value);
+    metadataLock.lock();
+    if (ret != APP_ERR_OK) {
+        LogError << "Build the metadata view(" << key << ") failed." << GetErrorInfo(ret);
+        return ret;
+    }
+    metadata = value;
+    views = GetViewMapInternal(currentMetaInfo, false);
+    if (views == nullptr || views->find(key) == views->end() || (*views)[key] != view) {
+        return APP_ERR_OK;
+    }
+    RemoveViewInternal(key, currentMetaInfo);
+    currentMetaInfo->mxpiProtobufMap[key] = value;
+    auto mxpiMetadataGraph = GetMetadataGraphInstanceInternal(currentMetaInfo);
+    if (mxpiMetadataGraph != nullptr) {
+        mxpiMetadataGraph->AddNodeList(key, value);
+    }
+    LogDebug << "End to build the metadata view(" << key << ") of the buffer.";
+    return APP_ERR_OK;
+}
+
+APP_ERROR MxpiMetadataManagerDptr::BuildView(MxpiMetadataView &view,
+    std::shared_ptr<google::protobuf::Message> &value)
+{
+    std::lock_guard<std::mutex> buildLock(view.buildMutex);
+    if (view.value != nullptr) {
+        value = view.value;
+        return APP_ERR_OK;
+    }
+    // the parent was checked to be a list of members with headerVec as first field when the view was added
+    const google::protobuf::FieldDescriptor* field = view.parent->GetDescriptor()->field(0);
+    const google::protobuf::Reflection* refl = view.parent->GetReflection();
+    // the member ids were checked when the view was added too, a parent changed since then is not copied
+    int memberNum = refl->FieldSize(*view.parent, field);
+    for (int memberId : view.memberIds) {
+        if (memberId < 0 || memberId >= memberNum) {
+            LogError << "The member id(" << memberId << ") is out of the range of the metadata(" << view.parentKey
+                     << "), which has " << memberNum << " members." << GetErrorInfo(APP_ERR_COMM_OUT_OF_RANGE);
+            return APP_ERR_COMM_OUT_OF_RANGE;
+        }
+    }
+    std::shared_ptr<google::protobuf::Message> nodeList;
+    google::protobuf::Arena* arena = view.parent->GetArena();
+    if (arena != nullptr) {
+        // the list lives on the arena of the parent, which the parent keeps alive
+        nodeList = std::shared_ptr<google::protobuf::Message>(view.parent, view.parent->New(arena));
+    } else {
+        nodeList.reset(view.parent->New());
+    }
+    if (nodeList == nullptr) {
+        LogError << "Create metadata view failed. Failed to allocate memory." << GetErrorInfo(APP_ERR_COMM_ALLOC_MEM);
+        return APP_ERR_COMM_ALLOC_MEM;
+    }
+    for (int memberId : view.memberIds) {
+        google::protobuf::Message* member = refl->AddMessage(nodeList.get(), field);
+        member->CopyFrom(refl->GetRepeatedMessage(*view.parent, field, memberId));
+        const google::protobuf::FieldDescriptor* headerField = member->GetDescriptor()->field(0);
+        member->GetReflection()->ClearField(member, headerField);
+        auto* header = (MxpiMetaHeader*)member->GetReflection()->AddMessage(member, headerField);
+        header->set_datasource(view.parentKey);
+        header->set_memberid(memberId);
+    }
+    view.value = nodeList;
+    value = view.value;
+    return APP_ERR_OK;
+}
 } // namespace MxTools
 
 #endif // MXPIMETADATAMANAGER_DPTR_H
\ No newline at end of file
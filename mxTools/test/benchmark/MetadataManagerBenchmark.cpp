@@ -0,0 +1,144 @@
+/*
+* -------------------------------------------------------------------------
+*  This file is part of the Vision SDK project.
+* Copyright (c) 2025 Huawei Technologies Co.,Ltd.
+*
+* Vision SDK is licensed under Mulan PSL v2.
+* You can use this software according to the terms and conditions of the Mulan PSL v2.
+* You may obtain a copy of Mulan PSL v2 at:
+*
+*           http://license.coscl.org.cn/MulanPSL2
+*
+* THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+* EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+* MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+* See the Mulan PSL v2 for more details.
+* -------------------------------------------------------------------------
+ * Description: Microbenchmarks of the metadata manager on host buffers.
+ * Author: MindX SDK
+ * Create: 2025
+ * History: NA
+ */
+
+#include <string>
+#include <vector>
+#include <gst/gst.h>
+#include <benchmark/benchmark.h>
+#include "MxBase/Log/Log.h"
+#include "MxBase/MemoryHelper/MemoryHelper.h"
+#include "MxTools/PluginToolkit/buffer/MxpiBufferManager.h"
+#include "MxTools/PluginToolkit/metadata/MxpiMetadataManager.h"
+
+using namespace MxTools;
+
+namespace {
+const int BUFFER_SIZE = 512;
+const int VISION_WIDTH = 1920;
+const int VISION_HEIGHT = 1080;
+
+std::shared_ptr<MxpiVisionList> CreateVisionList(const std::string& parentName)
+{
+    auto visionList = MxBase::MemoryHelper::MakeShared<MxpiVisionList>();
+    if (visionList == nullptr) {
+        return visionList;
+    }
+    MxpiVision* vision = visionList->add_visionvec();
+    MxpiMetaHeader* header = vision->add_headervec();
+    header->set_datasource(parentName);
+    header->set_memberid(0);
+    vision->mutable_visioninfo()->set_width(VISION_WIDTH);
+    vision->mutable_visioninfo()->set_height(VISION_HEIGHT);
+    return visionList;
+}
+
+/**
+ * Keys as the plugins name them, one per element of a pipeline which attaches its result to the buffer.
+ */
+std::vector<std::string> MakeKeys(size_t num)
+{
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < num; i++) {
+        keys.push_back("mxpi_element" + std::to_string(i));
+    }
+    return keys;
+}
+
+MxpiBuffer* CreateBuffer(const std::string& key)
+{
+    InputParam inputParam = {};
+    inputParam.key = key;
+    inputParam.deviceId = 0;
+    inputParam.dataSize = BUFFER_SIZE;
+    return MxpiBufferManager::CreateHostBuffer(inputParam);
+}
+
+void BM_MetadataAddGetRemove(benchmark::State& state)
+{
+    const auto keys = MakeKeys(static_cast<size_t>(state.range(0)));
+    MxpiBuffer* buffer = CreateBuffer("BM_MetadataAddGetRemove");
+    if (buffer == nullptr) {
+        state.SkipWithError("Create buffer failed.");
+        return;
+    }
+    auto metadata = CreateVisionList("mxpi_imagedecoder0");
+    {
+        MxpiMetadataManager manager(*buffer);
+        for (auto _ : state) {
+            // the life of a frame: every element adds its result and reads the one of its upstream element
+            for (const auto& key : keys) {
+                manager.AddProtoMetadata(key, metadata);
+                benchmark::DoNotOptimize(manager.GetMetadata(key).get());
+            }
+            for (const auto& key : keys) {
+                manager.RemoveProtoMetadata(key);
+            }
+        }
+    }
+    MxpiBufferManager::DestroyBuffer(buffer);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MetadataAddGetRemove)->Arg(4)->Arg(16)->Arg(64);
+
+void BM_MetadataCopy(benchmark::State& state)
+{
+    const auto keys = MakeKeys(static_cast<size_t>(state.range(0)));
+    MxpiBuffer* source = CreateBuffer("BM_MetadataCopySource");
+    MxpiBuffer* target = CreateBuffer("BM_MetadataCopyTarget");
+    if (source == nullptr || target == nullptr) {
+        state.SkipWithError("Create buffer failed.");
+        MxpiBufferManager::DestroyBuffer(source);
+        MxpiBufferManager::DestroyBuffer(target);
+        return;
+    }
+    {
+        MxpiMetadataManager manager(*source);
+        for (const auto& key : keys) {
+            manager.AddProtoMetadata(key, CreateVisionList(key));
+        }
+        for (auto _ : state) {
+            if (manager.CopyMetadata(*target) != APP_ERR_OK) {
+                state.SkipWithError("CopyMetadata failed.");
+                break;
+            }
+        }
+    }
+    MxpiBufferManager::DestroyBuffer(source);
+    MxpiBufferManager::DestroyBuffer(target);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_MetadataCopy)->Arg(4)->Arg(16)->Arg(64);
+}
+
+int main(int argc, char* argv[])
+{
+    MxBase::Log::Init();
+    gst_init(&argc, &argv);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    MxBase::Log::Deinit();
+    return 0;
+}
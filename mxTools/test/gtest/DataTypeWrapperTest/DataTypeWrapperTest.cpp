@@ -97,6 +97,43 @@ TEST_F(DataTypeWrapperTest, Test_ConstructProtobuf_Seg_Should_Success)
     EXPECT_NE(maskList.DebugString(), protobuf->DebugString());
 }
 
+TEST_F(DataTypeWrapperTest, Test_ConstructProtobuf_SegLabels_Should_Keep_Int32_When_Over_255_Classes)
+{
+    const uint32_t classNum = 300;
+    SemanticSegInfo semanticInfo;
+    semanticInfo.labelMap.assign(classNum, "object");
+    semanticInfo.labels.Reset(3, 2, classNum);
+    semanticInfo.labels.Set(2, 1, classNum - 1);
+    std::vector<MxBase::SemanticSegInfo> semanticInfos = {semanticInfo, semanticInfo};
+    auto protobuf = ConstructProtobuf(std::move(semanticInfos), "test");
+    ASSERT_EQ(protobuf->imagemaskvec_size(), 2);
+    const auto &mask = protobuf->imagemaskvec(0);
+    EXPECT_EQ(mask.datatype(), MxBase::TENSOR_DTYPE_INT32);
+    ASSERT_EQ(mask.datastr().size(), 6 * sizeof(int32_t));
+    EXPECT_EQ(reinterpret_cast<const int32_t *>(mask.datastr().data())[5], static_cast<int32_t>(classNum - 1));
+
+    // the compact label map is only written when it is asked for
+    semanticInfos = {semanticInfo};
+    protobuf = ConstructProtobuf(std::move(semanticInfos), "test", MaskEncoding::RAW_COMPACT);
+    const auto &compactMask = protobuf->imagemaskvec(0);
+    EXPECT_EQ(compactMask.datatype(), MxBase::TENSOR_DTYPE_UINT16);
+    ASSERT_EQ(compactMask.datastr().size(), 6 * sizeof(uint16_t));
+    EXPECT_EQ(reinterpret_cast<const uint16_t *>(compactMask.datastr().data())[5], classNum - 1);
+}
+
+TEST_F(DataTypeWrapperTest, Test_ConstructProtobuf_SegLabels_Should_Use_Uint8_When_Under_256_Classes)
+{
+    SemanticSegInfo semanticInfo;
+    semanticInfo.labelMap = {"object1", "object2"};
+    semanticInfo.labels.Reset(3, 2, semanticInfo.labelMap.size());
+    semanticInfo.labels.Set(1, 0, 1);
+    std::vector<MxBase::SemanticSegInfo> semanticInfos = {semanticInfo};
+    auto protobuf = ConstructProtobuf(std::move(semanticInfos), "test");
+    const auto &mask = protobuf->imagemaskvec(0);
+    EXPECT_EQ(mask.datatype(), MxBase::TENSOR_DTYPE_UINT8);
+    EXPECT_EQ(mask.datastr(), std::string("\x00\x01\x00\x00\x00\x00", 6));
+}
+
 TEST_F(DataTypeWrapperTest, Test_ConstructProtobuf_Text_Should_Success)
 {
     MxpiTextsInfoList textInfoList;
@@ -591,6 +591,43 @@ TEST_F(MetaDataManagerTest, AddErrorInfoTest)
     }
 }
 
+TEST_F(MetaDataManagerTest, ShareAndMergeMetadata)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto parentBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    auto childBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager parentManager(*parentBuffer);
+    MxpiMetadataManager childManager(*childBuffer);
+    std::shared_ptr<MxpiVisionList> rootMessage = CreateMetadata("", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    auto ret = parentManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(rootMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = parentManager.ShareMetadata(*childBuffer);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(childManager.GetMetadata("NodeListRoot"), std::static_pointer_cast<void>(rootMessage));
+
+    std::shared_ptr<MxpiVisionList> branchMessage =
+        CreateMetadata("NodeListRoot", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    ret = childManager.AddProtoMetadata("NodeListBranch", std::static_pointer_cast<void>(branchMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(parentManager.GetMetadata("NodeListBranch"), nullptr);
+    ret = parentManager.MergeMetadata(*childBuffer);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(parentManager.GetMetadata("NodeListBranch"), std::static_pointer_cast<void>(branchMessage));
+
+    auto conflictBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager conflictManager(*conflictBuffer);
+    std::shared_ptr<MxpiVisionList> conflictMessage = CreateMetadata("", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    conflictManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(conflictMessage));
+    ret = parentManager.MergeMetadata(*conflictBuffer);
+    EXPECT_EQ(ret, APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST);
+    EXPECT_EQ(parentManager.GetMetadata("NodeListRoot"), std::static_pointer_cast<void>(rootMessage));
+    MxpiBufferManager::DestroyBuffer(parentBuffer);
+    MxpiBufferManager::DestroyBuffer(childBuffer);
+    MxpiBufferManager::DestroyBuffer(conflictBuffer);
+}
+
 TEST_F(MetaDataManagerTest, GetAllMetaDataTest)
 {
     InputParam inputParam;
@@ -624,6 +661,163 @@ TEST_F(MetaDataManagerTest, GetAllMetaDataTest)
     }
     MxpiBufferManager::DestroyBuffer(mxpiBuffer);
 }
+
+TEST_F(MetaDataManagerTest, AddProtoMetadataViewAndGet)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto mxpiBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
+    std::shared_ptr<MxpiVisionList> parentMessage = CreateMetadata("", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    parentMessage->add_visionvec()->mutable_visioninfo()->set_width(WIDTH_TEST_VALUE + 1);
+    auto ret = mxpiMetadataManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(parentMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = mxpiMetadataManager.AddProtoMetadataView("NodeListView", "NodeListRoot", {MEMBER_ID_TEST_VALUE});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = mxpiMetadataManager.AddProtoMetadataView("NodeListView", "NodeListRoot", {0});
+    EXPECT_EQ(ret, APP_ERR_PLUGIN_TOOLKIT_METADATA_KEY_ALREADY_EXIST);
+    ret = mxpiMetadataManager.AddProtoMetadataView("NodeListOutOfRange", "NodeListRoot", {MEMBER_ID_TEST_VALUE + 1});
+    EXPECT_EQ(ret, APP_ERR_COMM_OUT_OF_RANGE);
+
+    auto viewMessage = std::static_pointer_cast<MxpiVisionList>(mxpiMetadataManager.GetMetadata("NodeListView"));
+    ASSERT_NE(viewMessage, nullptr);
+    ASSERT_EQ(viewMessage->visionvec_size(), 1);
+    EXPECT_EQ(viewMessage->visionvec(0).visioninfo().width(), WIDTH_TEST_VALUE + 1);
+    ASSERT_EQ(viewMessage->visionvec(0).headervec_size(), 1);
+    EXPECT_EQ(viewMessage->visionvec(0).headervec(0).datasource(), "NodeListRoot");
+    EXPECT_EQ(viewMessage->visionvec(0).headervec(0).memberid(), MEMBER_ID_TEST_VALUE);
+    EXPECT_EQ(mxpiMetadataManager.GetMetadata("NodeListView"), std::static_pointer_cast<void>(viewMessage));
+    EXPECT_EQ(parentMessage->visionvec(MEMBER_ID_TEST_VALUE).headervec_size(), 0);
+    MxpiBufferManager::DestroyBuffer(mxpiBuffer);
+}
+
+TEST_F(MetaDataManagerTest, ShareAndRemoveProtoMetadataView)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto parentBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    auto childBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager parentManager(*parentBuffer);
+    MxpiMetadataManager childManager(*childBuffer);
+    std::shared_ptr<MxpiVisionList> rootMessage = CreateMetadata("", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    auto ret = parentManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(rootMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = parentManager.AddProtoMetadataView("NodeListView", "NodeListRoot", {0});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = parentManager.ShareMetadata(*childBuffer);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    auto childView = childManager.GetMetadata("NodeListView");
+    EXPECT_NE(childView, nullptr);
+    EXPECT_EQ(parentManager.GetMetadata("NodeListView"), childView);
+
+    ret = childManager.AddProtoMetadataView("NodeListRemoved", "NodeListRoot", {0});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = childManager.RemoveProtoMetadata("NodeListRemoved");
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(childManager.GetMetadata("NodeListRemoved"), nullptr);
+
+    ret = childManager.AddProtoMetadataView("NodeListPending", "NodeListRoot", {0});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    auto metadata = childManager.GetAllMetaData();
+    EXPECT_NE(metadata.find("NodeListPending"), metadata.end());
+    EXPECT_EQ(metadata.find("ReservedMetadataViews"), metadata.end());
+    MxpiBufferManager::DestroyBuffer(parentBuffer);
+    MxpiBufferManager::DestroyBuffer(childBuffer);
+}
+
+TEST_F(MetaDataManagerTest, GetProtoMetadataViewOfShrunkParent)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto mxpiBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
+    std::shared_ptr<MxpiVisionList> parentMessage = CreateMetadata("", 0, WIDTH_TEST_VALUE, HEIGHT_TEST_VALUE);
+    parentMessage->add_visionvec()->mutable_visioninfo()->set_width(WIDTH_TEST_VALUE + 1);
+    auto ret = mxpiMetadataManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(parentMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = mxpiMetadataManager.AddProtoMetadataView("NodeListView", "NodeListRoot", {MEMBER_ID_TEST_VALUE});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    // the parent must not change while its view is pending, a view out of the range of the parent is not built
+    parentMessage->mutable_visionvec()->RemoveLast();
+    EXPECT_EQ(mxpiMetadataManager.GetMetadata("NodeListView"), nullptr);
+    EXPECT_EQ(mxpiMetadataManager.MaterializeMetadataViews(), APP_ERR_COMM_OUT_OF_RANGE);
+    MxpiBufferManager::DestroyBuffer(mxpiBuffer);
+}
+
+TEST_F(MetaDataManagerTest, CreateProtoMetadataOnArena)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto mxpiBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
+    auto arena = mxpiMetadataManager.GetArena();
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(mxpiMetadataManager.GetArena(), arena);
+
+    auto rootMessage = mxpiMetadataManager.CreateProtoMetadata<MxpiVisionList>();
+    ASSERT_NE(rootMessage, nullptr);
+    EXPECT_EQ(rootMessage->GetArena(), arena.get());
+    for (int i = 0; i <= MEMBER_ID_TEST_VALUE; i++) {
+        rootMessage->add_visionvec()->mutable_visioninfo()->set_width(WIDTH_TEST_VALUE + i);
+    }
+    auto ret = mxpiMetadataManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(rootMessage));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    ret = mxpiMetadataManager.AddProtoMetadataView("NodeListView", "NodeListRoot", {MEMBER_ID_TEST_VALUE});
+    EXPECT_EQ(ret, APP_ERR_OK);
+    auto viewMessage = std::static_pointer_cast<MxpiVisionList>(mxpiMetadataManager.GetMetadata("NodeListView"));
+    ASSERT_NE(viewMessage, nullptr);
+    EXPECT_EQ(viewMessage->GetArena(), arena.get());
+    arena.reset();
+
+    // the messages keep the arena alive after the buffer is released
+    MxpiBufferManager::DestroyBuffer(mxpiBuffer);
+    rootMessage->add_visionvec()->mutable_visioninfo()->set_width(WIDTH_TEST_VALUE);
+    ASSERT_EQ(viewMessage->visionvec_size(), 1);
+    EXPECT_EQ(viewMessage->visionvec(0).visioninfo().width(), WIDTH_TEST_VALUE + MEMBER_ID_TEST_VALUE);
+}
+
+TEST_F(MetaDataManagerTest, ReuseArenaOfReleasedBuffer)
+{
+    InputParam inputParam;
+    inputParam.dataSize = DATA_SIZE;
+    inputParam.key = "1";
+    auto mxpiBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager mxpiMetadataManager(*mxpiBuffer);
+    google::protobuf::Arena* arena = mxpiMetadataManager.GetArena().get();
+    ASSERT_NE(arena, nullptr);
+    auto message = mxpiMetadataManager.CreateProtoMetadata<MxpiVisionList>();
+    ASSERT_NE(message, nullptr);
+    // grow the arena over its initial block
+    size_t initialSize = arena->SpaceAllocated();
+    for (int i = 0; arena->SpaceAllocated() == initialSize; i++) {
+        message->add_visionvec()->mutable_visioninfo()->set_width(WIDTH_TEST_VALUE + i);
+    }
+    auto ret = mxpiMetadataManager.AddProtoMetadata("NodeListRoot", std::static_pointer_cast<void>(message));
+    EXPECT_EQ(ret, APP_ERR_OK);
+    EXPECT_EQ(mxpiMetadataManager.GetAllMetaData().count("ReservedMetadataArena"), 0);
+
+    // the arena is neither shared with the target buffer nor returned while a message on it is alive
+    auto otherBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    ret = mxpiMetadataManager.ShareMetadata(*otherBuffer);
+    EXPECT_EQ(ret, APP_ERR_OK);
+    MxpiBufferManager::DestroyBuffer(mxpiBuffer);
+    MxpiMetadataManager otherManager(*otherBuffer);
+    EXPECT_NE(otherManager.GetArena().get(), arena);
+    MxpiBufferManager::DestroyBuffer(otherBuffer);
+
+    // once the last message is released, the arena is reset to its initial block and taken by the next buffer
+    message.reset();
+    auto nextBuffer = MxpiBufferManager::CreateHostBuffer(inputParam);
+    MxpiMetadataManager nextManager(*nextBuffer);
+    EXPECT_EQ(nextManager.GetArena().get(), arena);
+    EXPECT_EQ(arena->SpaceUsed(), 0U);
+    EXPECT_EQ(arena->SpaceAllocated(), initialSize);
+    MxpiBufferManager::DestroyBuffer(nextBuffer);
+}
 }
 
 int main(int argc, char* argv[])
@@ -23,7 +23,9 @@
 #include <gtest/gtest.h>
 #include <mockcpp/mockcpp.hpp>
 #include <gst/gst.h>
+#include <chrono>
 #include <string>
+#include <thread>
 
 #include "MxTools/PluginToolkit/base/MxGstBase.h"
 #include "MxTools/PluginToolkit/base/MxPluginBase.h"
@@ -34,6 +36,7 @@
 #include "MxTools/Proto/MxpiDataType.pb.h"
 #include "MxTools/PluginToolkit/base/MxGstBase.h"
 #include "MxPluginBaseDptr.hpp"
+#include "MxGstExecutor.hpp"
 #include "MxBase/Utils/StringUtils.h"
 #include "MxBase/DeviceManager/DeviceManager.h"
 #include "MxBase/MemoryHelper/MemoryHelper.h"
@@ -64,6 +67,8 @@ extern GstFlowReturn BufferProcess(MxGstBase *filter, GstBuffer *gstBuffer, int
 extern GstFlowReturn MxGstBaseChain(GstPad *pad, GstObject *parent, GstBuffer *gstBuffer);
 extern APP_ERROR SetDevice(const int &deviceId);
 extern gboolean SetDynamicImageSize(MxGstBase *filter);
+extern gboolean CreateExecutor(MxGstBase *filter);
+extern void DestroyExecutor(MxGstBase *filter);
 }  // namespace MxTools
 
 namespace {
@@ -603,6 +608,73 @@ TEST_F(MxGstBaseTest, Test_MxGstBase_SetDynamicImageSize_Should_Success_When_Val
     gboolean ret = SetDynamicImageSize(&base);
     EXPECT_EQ(ret, true);
 }
+
+TEST_F(MxGstBaseTest, Test_MxGstBase_CreateExecutor_Should_Ignore_Parallelism_When_Plugin_Not_Reentrant)
+{
+    MxGstBase base;
+    MxPluginBaseDerived plugin;
+    base.pluginInstance = &plugin;
+    plugin.status_ = ASYNC;
+    plugin.parallelism_ = THREE_TIMES;
+    gboolean ret = CreateExecutor(&base);
+    EXPECT_EQ(ret, true);
+    EXPECT_EQ(base.executor, nullptr);
+}
+
+TEST_F(MxGstBaseTest, Test_MxGstBase_CreateExecutor_Should_Success_When_Plugin_Reentrant)
+{
+    MxGstBase base;
+    MxPluginBaseDerived plugin;
+    base.pluginInstance = &plugin;
+    plugin.status_ = ASYNC;
+    plugin.parallelism_ = THREE_TIMES;
+    plugin.reentrant_ = true;
+    gboolean ret = CreateExecutor(&base);
+    EXPECT_EQ(ret, true);
+    EXPECT_NE(base.executor, nullptr);
+    DestroyExecutor(&base);
+    EXPECT_EQ(base.executor, nullptr);
+}
+
+TEST_F(MxGstBaseTest, Test_MxGstExecutor_DeferOutput_Should_Return_False_Outside_Process)
+{
+    MxGstExecutor executor("test", INIT_DEVICEID, TWICE,
+        [](size_t, MxpiBuffer *) {}, [](int, GstBuffer *) {});
+    GstBuffer gstBuffer;
+    EXPECT_EQ(MxGstExecutor::DeferOutput(&executor, 0, &gstBuffer), false);
+    EXPECT_EQ(MxGstExecutor::DeferOutput(nullptr, 0, &gstBuffer), false);
+}
+
+TEST_F(MxGstBaseTest, Test_MxGstExecutor_Should_Push_Outputs_In_Input_Order_Per_Channel)
+{
+    constexpr size_t channelNum = 2;
+    constexpr size_t bufferNum = 200;
+    std::vector<GstBuffer> gstBuffers(channelNum * bufferNum);
+    MxGstExecutor *executorPtr = nullptr;
+    std::vector<std::vector<GstBuffer *>> pushed(channelNum);
+    MxGstExecutor executor("test", INIT_DEVICEID, THREE_TIMES,
+        [&executorPtr, &gstBuffers](size_t channel, MxpiBuffer *buffer) {
+            size_t index = reinterpret_cast<size_t>(buffer);
+            if (index % THREE_TIMES == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            MxGstExecutor::DeferOutput(executorPtr, static_cast<int>(channel), &gstBuffers[index]);
+        },
+        [&pushed](int index, GstBuffer *buffer) { pushed[index].push_back(buffer); });
+    executorPtr = &executor;
+    for (size_t i = 0; i < bufferNum; i++) {
+        for (size_t channel = 0; channel < channelNum; channel++) {
+            executor.Submit(channel, reinterpret_cast<MxpiBuffer *>(channel * bufferNum + i));
+        }
+    }
+    executor.Drain();
+    for (size_t channel = 0; channel < channelNum; channel++) {
+        ASSERT_EQ(pushed[channel].size(), bufferNum);
+        for (size_t i = 0; i < bufferNum; i++) {
+            EXPECT_EQ(pushed[channel][i], &gstBuffers[channel * bufferNum + i]);
+        }
+    }
+}
 }  // namespace
 
 int main(int argc, char *argv[])